@@ -0,0 +1,97 @@
+//
+//  CVF2Block.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainCVF2Block_hpp
+#define GrainCVF2Block_hpp
+
+#include "Grain.hpp"
+#include "2d/Bounds2.hpp"
+#include "Geometry.hpp"
+
+
+namespace Grain {
+
+class String;
+
+
+/**
+ *  @brief Block packing of version 3 of the CVF2 file format.
+ *
+ *  Version 2 encodes each row as sequences of nibbles, so reading a value
+ *  requires parsing the sequence table of its row, and a row can only be
+ *  decoded nibble by nibble. Version 3 splits the grid into square blocks
+ *  of `block_size` cells. Each block stores its minimum value as base and
+ *  all cells as fixed width differences to the base, bit-packed without
+ *  gaps. The bit width is chosen per block. The highest code of a width,
+ *  all bits set, marks undefined values. A width of 0 means all cells are
+ *  equal to the base, which may be `CVF2::kUndefinedValue`.
+ *
+ *  A block index with the file position of every block gives constant
+ *  time access to any cell and decoding of any window without touching
+ *  unrelated blocks. Unpacking fixed width codes has no data dependency
+ *  between cells, so the loops vectorize.
+ *
+ *  The file layout:
+ *
+ *      "CVF3", endian signature
+ *      uint32 width, uint32 height, int32 srid, 4 x Fix bbox
+ *      int32 undefined values count, int64 min, int64 max, Fix mean
+ *      int32 unit, uint32 block size, uint64 block index position
+ *      uint64 x (block count + 1) block positions, last one is end of data
+ *      blocks, row by row: int64 base, uint8 bit width, packed codes
+ *
+ *  If no cell is defined, min and max are both `CVF2::kUndefinedValue`.
+ *
+ *  Codes are packed LSB first, code `i` of a block occupies bits
+ *  `i * width` to `(i + 1) * width - 1` of the byte stream. Cells of a
+ *  block are stored row by row, blocks at the right and bottom border
+ *  are cut to the grid size.
+ */
+class CVF2Block {
+
+public:
+    enum {
+        kDefaultBlockSize = 64,
+        kMinBlockSize = 8,
+        kMaxBlockSize = 1024,
+        kHeaderSize = 9,        ///< Bytes of base and bit width at the start of each block
+        kPaddingBytes = 8       ///< Bytes required after packed data for `unpack()`
+    };
+
+public:
+    [[nodiscard]] static int32_t bitWidth(int64_t min, int64_t max, bool has_undefined) noexcept;
+    [[nodiscard]] static int64_t packedByteCount(int64_t n, int32_t bit_width) noexcept {
+        return (n * bit_width + 7) / 8;
+    }
+    [[nodiscard]] static uint64_t undefinedCode(int32_t bit_width) noexcept {
+        return bit_width >= 64 ? ~0ULL : (0x1ULL << bit_width) - 1;
+    }
+
+    static void pack(const int64_t* values, int64_t n, int64_t base, int32_t bit_width, uint8_t* out_data) noexcept;
+    static void unpack(const uint8_t* data, int64_t first, int64_t n, int64_t base, int32_t bit_width, int64_t* out_values) noexcept;
+    [[nodiscard]] static int64_t unpackOne(const uint8_t* data, int64_t index, int64_t base, int32_t bit_width) noexcept {
+        return unpackAtBit(data, static_cast<uint64_t>(index) * bit_width, base, bit_width);
+    }
+    [[nodiscard]] static int64_t unpackAtBit(const uint8_t* data, uint64_t bit_pos, int64_t base, int32_t bit_width) noexcept;
+
+    static ErrorCode writeFile(const String& file_path, const int64_t* values, int32_t width, int32_t height, int32_t srid, const Bounds2Fix& bbox, LengthUnit unit, int32_t block_size, int32_t thread_count) noexcept;
+
+    [[nodiscard]] static uint64_t _load64(const uint8_t* data) noexcept {
+        uint64_t v = 0;
+        for (int32_t i = 7; i >= 0; i--) {
+            v = (v << 8) | data[i];
+        }
+        return v;
+    }
+};
+
+
+} // End of namespace Grain
+
+#endif // GrainCVF2Block_hpp
@@ -77,6 +77,16 @@ protected:
     Fix mean_value_ = 0;            ///< Mean of all valid values
     LengthUnit unit_ = LengthUnit::Undefined;
     int64_t row_offsets_pos_ = 0;   ///< Position of row index table in file
+    int32_t version_ = 2;           ///< File format version, 2 for rows of nibble sequences, 3 for blocks, see `CVF2Block`
+
+    int32_t block_size_ = 0;            ///< Edge length of blocks, version 3 only
+    int32_t x_block_count_ = 0;
+    int32_t y_block_count_ = 0;
+    uint64_t* block_offsets_ = nullptr; ///< File position of each block and the end of data, version 3 only
+    uint8_t* block_data_ = nullptr;     ///< Packed data of one block
+    int64_t block_data_size_ = 0;
+    int64_t* block_row_values_ = nullptr;   ///< Decoded values of one row of blocks
+    int32_t block_row_index_ = -1;          ///< Index of the row of blocks in `block_row_values_`
 
     bool cache_flag_ = false;       ///< true, if data is loaded to RAM cash, else false
     void* cache_data_    = nullptr;
@@ -114,10 +124,17 @@ public:
         l << "unit: " << Geometry::lengthUnitName(unit_) << Log::endl;
         l << "undefined_values_count: " << undefined_values_count_ << Log::endl;
         l << "min_value: " << min_value_ << ", max_value: " << max_value_ << ", mean_value: " << mean_value_ << Log::endl;
-        l << "row_offsets_pos: " << row_offsets_pos_ << Log::endl;
+        l << "version: " << version_ << Log::endl;
+        if (version_ >= 3) {
+            l << "block_size: " << block_size_ << ", blocks: " << x_block_count_ << " x " << y_block_count_ << Log::endl;
+        }
+        else {
+            l << "row_offsets_pos: " << row_offsets_pos_ << Log::endl;
+        }
     }
 
 
+    int32_t version() const noexcept { return version_; }
     int32_t srid() const noexcept { return srid_; }
 
     uint32_t width() const noexcept { return width_; }
@@ -146,6 +163,10 @@ public:
 
     int32_t readRow(int32_t y);
 
+    void _readBlockIndex();
+    void _readBlockRow(int32_t block_row_index);
+    int64_t _valueAtPosFromBlock(const Vec2i& pos);
+
     bool hitBbox(const Bounds2d& bbox) const noexcept {
         if (xy_range_.min_x_.asDouble() <= bbox.max_x_ &&
             xy_range_.min_y_.asDouble() <= bbox.max_y_ &&
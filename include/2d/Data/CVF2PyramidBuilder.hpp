@@ -0,0 +1,188 @@
+//
+//  CVF2PyramidBuilder.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainCVF2PyramidBuilder_hpp
+#define GrainCVF2PyramidBuilder_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "String/String.hpp"
+#include "2d/Bounds2.hpp"
+#include "Math/Vec2.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Grain {
+
+    class CVF2TileManager;
+    class File;
+
+
+    /**
+     *  @brief Builds a pyramid of CVF2 meta tiles on multiple threads.
+     *
+     *  Renders the meta tiles of `maxZoom()` from a tile manager and all
+     *  lower zoom levels down to `minZoom()` by downsampling, with the same
+     *  output as `CVF2TileManager::renderMetaTiles()` followed by
+     *  `CVF2TileManager::renderDownsampledMetaTiles()` for each level.
+     *
+     *  The meta tiles are distributed over a pool of worker threads. Each
+     *  worker samples the tile manager through a reader of its own, with
+     *  its own open CVF2 files and tile cache, so workers don't wait for
+     *  each other while rendering. A downsampled meta tile is scheduled as
+     *  soon as its four source meta tiles are written, so lower levels are
+     *  built while the finest level is still rendering, and preferred over
+     *  new tiles of the finest level. The output doesn't depend on the
+     *  number of threads.
+     *
+     *  A manifest file in the base directory records each written meta tile
+     *  with a signature of its sources, for the finest level path, size and
+     *  modification time of the contributing CVF2 files, for lower levels
+     *  the signatures of the source meta tiles. When a build is started
+     *  again after an interruption, or after some source files changed,
+     *  only meta tiles with a missing file or a changed signature are
+     *  rendered.
+     *
+     *  `stats()` and `cancel()` may be called from other threads while
+     *  `build()` is running.
+     */
+    class CVF2PyramidBuilder : public Object {
+    public:
+        enum {
+            kErrZoomOutOfRange = 0,
+            kErrMetaTileRangeFailed,
+            kErrManifestWriteFailed,
+            kErrCancelled
+        };
+
+        struct Stats {
+            int64_t total_tile_count_ = 0;          ///< Meta tiles in all levels
+            int64_t rendered_tile_count_ = 0;       ///< Meta tiles rendered from the tile manager
+            int64_t downsampled_tile_count_ = 0;    ///< Meta tiles rendered by downsampling
+            int64_t skipped_tile_count_ = 0;        ///< Meta tiles up to date from a previous build
+            int64_t failed_tile_count_ = 0;         ///< Meta tiles, which could not be rendered
+            int64_t bytes_written_ = 0;             ///< Size of all written files
+            double elapsed_seconds_ = 0.0;
+
+            [[nodiscard]] int64_t doneTileCount() const noexcept {
+                return rendered_tile_count_ + downsampled_tile_count_ + skipped_tile_count_ + failed_tile_count_;
+            }
+
+            [[nodiscard]] double tilesPerSecond() const noexcept {
+                return elapsed_seconds_ > 0.0 ? static_cast<double>(rendered_tile_count_ + downsampled_tile_count_) / elapsed_seconds_ : 0.0;
+            }
+        };
+
+    protected:
+        struct Node {
+            int32_t zoom_ = 0;
+            Vec2i tile_index_;                  ///< Top left tile of the meta tile
+            uint64_t signature_ = 0;            ///< Signature of all sources
+            int32_t parent_ = -1;               ///< Index of the downsampled meta tile, -1 at `min_zoom_`
+            int32_t pending_child_count_ = 0;   ///< Source meta tiles not yet written
+            bool skip_ = false;                 ///< Up to date from a previous build
+            bool child_failed_ = false;
+            bool done_ = false;                 ///< Written successfully or skipped
+        };
+
+        CVF2TileManager* tile_manager_ = nullptr;
+        String base_path_;
+        Bounds2d bbox_;
+        int32_t max_zoom_ = 0;
+        int32_t min_zoom_ = 0;
+        int32_t antialias_level_ = 1;
+        int32_t thread_count_ = 0;
+        bool resume_flag_ = true;
+        String manifest_path_;
+
+        std::vector<Node> nodes_;
+        std::deque<int32_t> queue_;             ///< Indices of nodes ready to render
+        int64_t unfinished_count_ = 0;
+        std::mutex mutex_;                      ///< Guards `nodes_` scheduling data and `queue_`
+        std::condition_variable cond_;
+
+        std::unordered_map<uint64_t, uint64_t> manifest_;   ///< Signatures of a previous build, by key
+        File* manifest_file_ = nullptr;
+        std::mutex manifest_mutex_;
+
+        std::atomic<bool> cancel_flag_{false};
+        std::atomic<int64_t> rendered_tile_count_{0};
+        std::atomic<int64_t> downsampled_tile_count_{0};
+        std::atomic<int64_t> skipped_tile_count_{0};
+        std::atomic<int64_t> failed_tile_count_{0};
+        std::atomic<int64_t> bytes_written_{0};
+        std::atomic<int64_t> start_ts_{0};
+        std::atomic<int64_t> end_ts_{0};
+        ErrorCode first_err_ = ErrorCode::None;
+
+    public:
+        CVF2PyramidBuilder(CVF2TileManager* tile_manager, const String& base_path, const Bounds2d& bbox, int32_t max_zoom, int32_t min_zoom) noexcept;
+        ~CVF2PyramidBuilder() noexcept override;
+
+        CVF2PyramidBuilder(const CVF2PyramidBuilder&) = delete;
+        CVF2PyramidBuilder& operator = (const CVF2PyramidBuilder&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "CVF2PyramidBuilder"; }
+
+        friend std::ostream& operator << (std::ostream& os, const CVF2PyramidBuilder* o) {
+            o == nullptr ? os << "CVF2PyramidBuilder nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const CVF2PyramidBuilder& o) {
+            auto stats = o.stats();
+            os << "zoom: " << o.min_zoom_ << " to " << o.max_zoom_;
+            os << ", tiles: " << stats.doneTileCount() << " of " << stats.total_tile_count_;
+            os << ", rendered: " << stats.rendered_tile_count_ << ", downsampled: " << stats.downsampled_tile_count_;
+            os << ", skipped: " << stats.skipped_tile_count_ << ", failed: " << stats.failed_tile_count_;
+            os << ", bytes written: " << stats.bytes_written_ << ", tiles/s: " << stats.tilesPerSecond();
+            return os;
+        }
+
+        [[nodiscard]] int32_t maxZoom() const noexcept { return max_zoom_; }
+        [[nodiscard]] int32_t minZoom() const noexcept { return min_zoom_; }
+        [[nodiscard]] int32_t antialiasLevel() const noexcept { return antialias_level_; }
+        [[nodiscard]] int32_t threadCount() const noexcept { return thread_count_; }
+        [[nodiscard]] bool resumes() const noexcept { return resume_flag_; }
+        [[nodiscard]] const String& manifestPath() const noexcept { return manifest_path_; }
+
+        void setAntialiasLevel(int32_t antialias_level) noexcept { antialias_level_ = std::clamp<int32_t>(antialias_level, 1, 16); }
+        void setThreadCount(int32_t thread_count) noexcept { thread_count_ = std::max<int32_t>(thread_count, 0); }
+        void setResume(bool resume) noexcept { resume_flag_ = resume; }
+
+        ErrorCode build() noexcept;
+        void cancel() noexcept;
+
+        [[nodiscard]] Stats stats() const noexcept;
+
+    protected:
+        ErrorCode _setupNodes();
+        void _loadManifest() noexcept;
+        ErrorCode _saveManifest() noexcept;
+        void _appendManifestEntry(const Node& node) noexcept;
+        void _worker() noexcept;
+        void _finishNode(int32_t node_index, bool failed);
+
+        [[nodiscard]] static uint64_t _key(int32_t zoom, const Vec2i& tile_index) noexcept {
+            return (static_cast<uint64_t>(zoom) << 56) |
+                   (static_cast<uint64_t>(tile_index.x_ & 0xFFFFFFF) << 28) |
+                   static_cast<uint64_t>(tile_index.y_ & 0xFFFFFFF);
+        }
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainCVF2PyramidBuilder_hpp
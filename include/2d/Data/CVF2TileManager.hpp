@@ -21,6 +21,9 @@
 #include "Image/Image.hpp"
 #include "ValueGrid.hpp"
 
+#include <mutex>
+#include <vector>
+
 
 namespace Grain {
 
@@ -34,6 +37,7 @@ namespace Grain {
 class CVF2Tile : public Object {
 
     friend class CVF2TileManager;
+    friend class CVF2ManagerReader;
     friend class CVF2File;
 
 protected:
@@ -153,8 +157,56 @@ struct CVF2ManagerFileSlot {
 };
 
 
+/**
+ *  @brief Open CVF2 files of one sampling thread.
+ *
+ *  A reader owns its files and their tile caches, so threads holding
+ *  different readers read without sharing any file state. Readers are leased
+ *  from the `CVF2TileManager` for the duration of one sampling call and are
+ *  kept in a pool afterwards, with their files still open.
+ *
+ *  @note Every reader may keep up to `capacity` files open.
+ */
+class CVF2ManagerReader {
+
+    friend class CVF2TileManager;
+
+protected:
+    struct Slot {
+        CVF2File* file_ = nullptr;
+        int64_t tile_index_ = -1;
+        int64_t last_use_ = 0;      ///< Value of `use_counter_` at the last access
+    };
+
+    std::vector<Slot> slots_;
+    int32_t last_slot_index_ = -1;  ///< Slot of the last access
+    int64_t use_counter_ = 0;
+
+    int64_t open_n_{};              ///< Opened files, since last added to the tile manager statistics
+    int64_t close_n_{};             ///< Closed files, since last added to the tile manager statistics
+    int64_t open_failed_n_{};       ///< Failed opens, since last added to the tile manager statistics
+
+public:
+    explicit CVF2ManagerReader(int32_t capacity);
+    ~CVF2ManagerReader();
+
+    CVF2ManagerReader(const CVF2ManagerReader&) = delete;
+    CVF2ManagerReader& operator = (const CVF2ManagerReader&) = delete;
+
+    [[nodiscard]] CVF2File* fileForTile(const CVF2Tile* tile) noexcept;
+};
+
+
 /**
  *  @brief Tilemanager.
+ *
+ *  Sampling with `valueAtPos()`, `sampleMany()` and `renderToValueGrid()` is
+ *  thread safe. Each call leases a `CVF2ManagerReader` from a pool and reads
+ *  through the files of that reader, so concurrent calls read in parallel.
+ *  The pool mutex is held only to take and return a reader.
+ *
+ *  `cvf2FileForTile()` and `collectImage()` use the shared file slots and are
+ *  meant for single threaded use.
  */
 class CVF2TileManager : public Object {
 
@@ -162,6 +214,12 @@ class CVF2TileManager : public Object {
     friend class CVF2Tile;
 
 public:
+    enum class SampleMode {
+        Nearest = 0,    ///< Value of the cell at the position, same as `valueAtPos()`
+        Bilinear,       ///< Bilinear interpolation of 2 x 2 cells
+        Bicubic         ///< Catmull-Rom interpolation of 4 x 4 cells, falls back to bilinear near undefined cells
+    };
+
     enum {
         kErrNotScanned = 0,
         kErrRangeNotValid,
@@ -249,6 +307,11 @@ protected:
 
     bool cache_tile_flag_ = false;
     int32_t verbose_level_ = 0;
+    double reprojection_max_error_ = 0.0;          ///< Maximum error of approximated reprojection in tile SRID units, 0 for exact reprojection
+
+    std::vector<CVF2ManagerReader*> free_readers_;  ///< Readers not leased by any thread
+    std::mutex reader_mutex_;                       ///< Guards `free_readers_` and the cvf2 file statistics
+    std::mutex proj_mutex_;                         ///< Guards `wgs84_to_tile_proj_` while sampling
 
 
 public:
@@ -307,6 +370,16 @@ public:
     void disableTileCache() noexcept { cache_tile_flag_ = false; }
     [[nodiscard]] bool useTileCache() const noexcept { return cache_tile_flag_; }
 
+    [[nodiscard]] double reprojectionMaxError() const noexcept { return reprojection_max_error_; }
+
+    /**
+     *  @brief Opt in to approximated reprojection in `renderToValueGrid()`.
+     *
+     *  @param max_error Maximum error in tile SRID units, e.g. 0.125. The
+     *                   default 0 keeps the exact reprojection.
+     */
+    void setReprojectionMaxError(double max_error) noexcept { reprojection_max_error_ = std::max(max_error, 0.0); }
+
 
     ErrorCode scan(const Bounds2d& bbox, int32_t bbox_srid) noexcept;
     ErrorCode scan() noexcept;
@@ -330,6 +403,11 @@ public:
         return value == CVF2::kUndefinedValue ? NAN : value;
     }
 
+    ErrorCode sampleMany(const Vec2d* positions, int64_t n, SampleMode mode, double* out_values) noexcept;
+    ErrorCode sampleMany(const Vec2d* positions, int64_t n, int64_t* out_values) noexcept;
+
+    [[nodiscard]] uint64_t sourceSignature(const Bounds2d& bbox) noexcept;
+
 
     [[nodiscard]] bool hasReadError() const noexcept { return last_read_err_ != ErrorCode::None; }
     [[nodiscard]] ErrorCode lastReadError() const noexcept { return last_read_err_; }
@@ -345,8 +423,12 @@ public:
     ErrorCode exportCSV(const String& file_path) noexcept;
 
     ErrorCode renderMetaTiles(const String& dir_path, int32_t zoom, const Bounds2d& bbox, int32_t antialias_level, int64_t start_index = 0, int64_t end_index = std::numeric_limits<int64_t>::max()) noexcept;
+    ErrorCode renderMetaTile(const String& dst_path, int32_t zoom, const Vec2i& tile_index, int32_t antialias_level, ValueGrid<int64_t>* meta_value_grid, String& out_file_path) noexcept;
 
     static ErrorCode renderDownsampledMetaTiles(const String& base_path, int32_t srid, int32_t src_zoom, int32_t meta_tile_size, const Bounds2d& bbox) noexcept;
+    static ErrorCode renderDownsampledMetaTile(const String& base_path, int32_t srid, int32_t src_zoom, const Vec2i& tile_index, ValueGridl* value_grid, ValueGridl** sub_value_grid_ptr, String& out_file_path) noexcept;
+    static void downsampledMetaTileSources(int32_t src_zoom, const Vec2i& tile_index, Vec2i* out_src_tile_indices) noexcept;
+    static void metaTileWGS84Bbox(int32_t zoom, const Vec2i& tile_index, Bounds2d& out_bbox) noexcept;
 
     static ErrorCode imageFromRawFile(const String& raw_file_path, Image* image) noexcept;
 
@@ -356,7 +438,32 @@ public:
     void saveLog(const String& log_file_path) noexcept;
 
 private:
+    /**
+     *  @brief Leases a reader for the lifetime of the object.
+     */
+    class ReaderLease {
+    public:
+        explicit ReaderLease(CVF2TileManager* tile_manager) noexcept : tile_manager_(tile_manager) {
+            reader_ = tile_manager_->_acquireReader();
+        }
+        ~ReaderLease() noexcept { tile_manager_->_releaseReader(reader_); }
+
+        ReaderLease(const ReaderLease&) = delete;
+        ReaderLease& operator = (const ReaderLease&) = delete;
+
+        [[nodiscard]] CVF2ManagerReader* reader() const noexcept { return reader_; }
+
+    private:
+        CVF2TileManager* tile_manager_;
+        CVF2ManagerReader* reader_;
+    };
+
     ErrorCode _projectBbox() noexcept;
+    CVF2ManagerReader* _acquireReader() noexcept;
+    void _releaseReader(CVF2ManagerReader* reader) noexcept;
+    int64_t _valueAtPos(const Vec2d& pos, CVF2ManagerReader* reader) noexcept;
+    ErrorCode _sampleMany(const Vec2d* positions, int64_t n, SampleMode mode, CVF2ManagerReader* reader, double* out_values, int64_t* out_int64_values) noexcept;
+    CVF2Tile* _neighbourCell(CVF2Tile* tile, int32_t x, int32_t y, Vec2i& out_xy) noexcept;
 };
 
 
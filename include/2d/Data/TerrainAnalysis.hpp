@@ -0,0 +1,136 @@
+//
+//  TerrainAnalysis.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainTerrainAnalysis_hpp
+#define GrainTerrainAnalysis_hpp
+
+#include "Grain.hpp"
+#include "2d/Data/ValueGrid.hpp"
+#include "2d/Bounds2.hpp"
+
+#include <functional>
+
+
+namespace Grain {
+
+    class Image;
+    class Polygon;
+    class GraphicCompoundPath;
+    class CVF2TileManager;
+
+
+    /**
+     *  @brief Terrain analysis on elevation grids.
+     *
+     *  Slope, aspect, curvature and hillshade are computed from the 3 x 3
+     *  neighbourhood of each cell, with the gradient after Horn (1981) and
+     *  the curvature after Zevenbergen and Thorne (1987). Rows are split
+     *  into bands, which are processed on multiple threads, and each row is
+     *  computed by a branch-free loop over float values, which the compiler
+     *  can vectorize. Invalid values propagate as NaN and are written as
+     *  invalid values of the output grid.
+     *
+     *  Cells at the border of a grid have no complete neighbourhood. Without
+     *  halo the border values are repeated, which flattens the border cells.
+     *  With `Params::halo_` the source grid has one extra row and column at
+     *  each side, and the output is two cells smaller in each direction.
+     *  `renderWithHalo()` fetches such a grid for a tile through a
+     *  `CVF2TileManager`, so adjacent tiles have no seams.
+     *
+     *  `contours()` extracts iso lines by marching squares.
+     *
+     *  Grids backed by a mapped file are processed on a single thread.
+     */
+    class TerrainAnalysis {
+    public:
+        struct Params {
+            double cell_size_x_ = 1.0;      ///< Distance between columns in the unit of the values
+            double cell_size_y_ = 1.0;      ///< Distance between rows in the unit of the values
+            double z_factor_ = 1.0;         ///< Factor applied to the values
+            bool north_at_top_ = true;      ///< Row 0 is the northern border, false if rows go from south to north
+            bool halo_ = false;             ///< Source has one extra cell at each border
+            int32_t thread_count_ = 0;      ///< Number of threads, 0 for one per hardware thread
+
+            // Hillshade
+            double azimuth_ = 315.0;        ///< Direction of the light, clockwise from north, in degrees
+            double altitude_ = 45.0;        ///< Angle of the light above the horizon, in degrees
+            bool multidirectional_ = false; ///< Combine light from 225, 270, 315 and 360 degrees, weighted by aspect
+        };
+
+        /**
+         *  @brief Receives one contour line, closed for rings. The polygon is
+         *         reused for the next line.
+         */
+        using ContourFunc = std::function<void(Polygon& polygon)>;
+
+    protected:
+        /**
+         *  @brief Computes one output row from three source rows, `r0` is the
+         *         row above. Row pointers are offset, so that `r[x + 1]` is the
+         *         center of output value `x`.
+         */
+        using RowKernel = std::function<void(const float* r0, const float* r1, const float* r2, int32_t n, float* out_values)>;
+        using RowStore = std::function<void(int32_t y, const float* values, int32_t n)>;
+
+    public:
+        template <typename T>
+        static ErrorCode slope(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept;
+
+        template <typename T>
+        static ErrorCode aspect(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept;
+
+        template <typename T>
+        static ErrorCode curvature(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept;
+
+        template <typename T>
+        static ErrorCode hillshade(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept;
+
+        template <typename T>
+        static ErrorCode hillshade(const ValueGrid<T>& grid, const Params& params, Image* out_image) noexcept;
+
+        template <typename T>
+        static ErrorCode contours(const ValueGrid<T>& grid, double level, const ContourFunc& func) noexcept;
+
+        template <typename T>
+        static ErrorCode contours(const ValueGrid<T>& grid, double level, GraphicCompoundPath& out_path) noexcept;
+
+        static ErrorCode renderWithHalo(CVF2TileManager* tile_manager, int32_t srid, const Bounds2d& bbox, int32_t antialias_level, ValueGridl* out_value_grid, Params& out_params) noexcept;
+
+        [[nodiscard]] static int32_t outputWidth(int32_t width, const Params& params) noexcept {
+            return params.halo_ ? width - 2 : width;
+        }
+
+        [[nodiscard]] static int32_t outputHeight(int32_t height, const Params& params) noexcept {
+            return params.halo_ ? height - 2 : height;
+        }
+
+    protected:
+        template <typename T>
+        static void _loadRow(const ValueGrid<T>& grid, int32_t y, float* out_values) noexcept;
+
+        template <typename T>
+        static ErrorCode _process(const ValueGrid<T>& grid, const Params& params, int32_t out_width, int32_t out_height, bool single_thread, const RowKernel& kernel, const RowStore& store) noexcept;
+
+        template <typename T>
+        static ErrorCode _processToGrid(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid, const RowKernel& kernel) noexcept;
+
+        enum {
+            kModeSlope = 0,
+            kModeAspect,
+            kModeCurvature,
+            kModeHillshade
+        };
+
+        static RowKernel _kernel(const Params& params, int32_t mode) noexcept;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainTerrainAnalysis_hpp
@@ -17,6 +17,7 @@
 #include "2d/Bounds2.hpp"
 #include "Type/Flags.hpp"
 #include "File/File.hpp"
+#include "2d/Data/ValueGridTiles.hpp"
 
 
 namespace Grain {
@@ -35,6 +36,7 @@ class Image;
  *  - Uses a specified data type for storing the values.
  *  - Provides methods for accessing the individual values by x and y coordinates.
  *  - Provides methods for writing to a file and reading from a file.
+ *  - Can be backed by a memory mapped, tiled file instead of memory, see `mapFile()`.
  *  - Can contain some feature information, such as data about the grid (e.g., geo information).
  */
 template <class T>
@@ -45,6 +47,7 @@ public:
         kFeature_MinMax = 0,        ///< Min/max feature id
         kFeature_Invalid_Value = 1, ///< Invalid value is used to mark values as invalid
         kFeature_GeoInfo = 2,       ///< Geo information feature id
+        kFeature_Tiles = 30,        ///< Values in the file are stored in tiles, see `ValueGridTiles`
         kFeature_CustomInfo = 31    ///< Custom information feature id
     };
 
@@ -75,6 +78,7 @@ protected:
 
     int32_t value_count_{};         ///< Number of values
     T* values_ = nullptr;           ///< Memory, where values are stored
+    ValueGridTiles* tiles_ = nullptr;   ///< Tiles of a mapped file, used instead of `values_`
     T invalid_value_{};             ///< Value to return, if request is println of range
 
 public:
@@ -95,6 +99,7 @@ public:
 
     ~ValueGrid() noexcept override {
         delete [] values_;
+        delete tiles_;
     }
 
     [[nodiscard]] const char* className() const noexcept override {
@@ -124,6 +129,9 @@ public:
             log << "Geo SRID: " << srid_;
             log << ", bbox: " << bbox_ << std::endl;
         }
+        if (tiles_) {
+            log << "mapped " << tiles_ << std::endl;
+        }
     }
 
 
@@ -131,6 +139,10 @@ public:
 
 
     bool _initMem() {
+        if (tiles_ != nullptr) {
+            delete tiles_;
+            tiles_ = nullptr;
+        }
         if (values_ != nullptr) {
             delete [] values_;
             values_ = nullptr;
@@ -151,7 +163,9 @@ public:
     }
 
 
-    [[nodiscard]] bool hasValues() const noexcept { return values_ != nullptr; }
+    [[nodiscard]] bool hasValues() const noexcept { return values_ != nullptr || tiles_ != nullptr; }
+    [[nodiscard]] bool isMapped() const noexcept { return tiles_ != nullptr; }
+    [[nodiscard]] ValueGridTiles* tiles() const noexcept { return tiles_; }
     [[nodiscard]] int16_t valueDataType() const noexcept;
     [[nodiscard]] int32_t width() const noexcept { return width_; }
     [[nodiscard]] int32_t height() const noexcept { return height_; }
@@ -205,33 +219,31 @@ public:
     }
 
     void updateMinMax() noexcept {
-        if (values_ != nullptr && value_count_ > 0) {
+        if (hasValues() && value_count_ > 0) {
             min_value_ = maxValueForType();
             max_value_ = minValueForType();
             bool check_invalid = hasFeature(kFeature_Invalid_Value);
-            if (check_invalid) {
-                for (int32_t i = 0; i < value_count_; i++) {
-                    T v = values_[i];
-                    if (v != invalid_value_) {
-                        if (v < min_value_) {
-                            min_value_ = v;
-                        }
-                        if (v > max_value_) {
-                            max_value_ = v;
+            try {
+                forEachBlock([&](int32_t, int32_t, int32_t w, int32_t h, const T* values, int32_t stride) {
+                    for (int32_t y = 0; y < h; y++) {
+                        const T* row = values + static_cast<int64_t>(y) * stride;
+                        for (int32_t x = 0; x < w; x++) {
+                            T v = row[x];
+                            if (check_invalid && v == invalid_value_) {
+                                continue;
+                            }
+                            if (v < min_value_) {
+                                min_value_ = v;
+                            }
+                            if (v > max_value_) {
+                                max_value_ = v;
+                            }
                         }
                     }
-                }
+                });
             }
-            else {
-                for (int32_t i = 0; i < value_count_; i++) {
-                    T v = values_[i];
-                    if (v < min_value_) {
-                        min_value_ = v;
-                    }
-                    if (v > max_value_) {
-                        max_value_ = v;
-                    }
-                }
+            catch (...) {
+                // Tiles, which can't be read, are ignored
             }
         }
         setFeature(kFeature_MinMax);
@@ -242,6 +254,8 @@ public:
         feature_flags_.setFlag(kFeature_Invalid_Value);
     }
 
+    [[nodiscard]] T invalidValue() const noexcept { return invalid_value_; }
+
     void setInvalidValueDefault() noexcept {
         invalid_value_ = minValueForType();
         feature_flags_.setFlag(kFeature_Invalid_Value);
@@ -252,10 +266,27 @@ public:
     void setGeoInfo(int32_t srid, const Bounds2Fix& bbox) noexcept;
     void setGeoInfo(int32_t srid, const Bounds2d& bbox) noexcept;
 
-    T valueAtXY(int32_t x, int32_t y) noexcept {
+    /**
+     *  @brief Value at `x`, `y`, or 0 outside the grid.
+     *
+     *  For a compressed mapped grid, the tile is inflated into the cache of
+     *  `ValueGridTiles`, which is guarded by a mutex, so reading from several
+     *  threads is safe.
+     */
+    T valueAtXY(int32_t x, int32_t y) const noexcept {
         if (_canAccessXY(x, y)) {
             return values_[_indexForXY(x, y)];
         }
+        else if (tiles_ != nullptr && _validXY(x, y)) {
+            try {
+                T value;
+                tiles_->readValue(x, y, &value);
+                return value;
+            }
+            catch (...) {
+                return 0;
+            }
+        }
         else {
             return 0;
         }
@@ -268,6 +299,17 @@ public:
             values_[index] = value;
             return value != old_value;
         }
+        else if (tiles_ != nullptr && tiles_->isWritable() && _validXY(x, y)) {
+            try {
+                auto ptr = reinterpret_cast<T*>(tiles_->mutValuePtr(x, y));
+                T old_value = *ptr;
+                *ptr = value;
+                return value != old_value;
+            }
+            catch (...) {
+                return false;
+            }
+        }
         else {
             return false;
         }
@@ -279,16 +321,53 @@ public:
 
     [[nodiscard]] int32_t countInvalidValues() const noexcept {
         int32_t result = 0;
-        if (hasFeature(kFeature_Invalid_Value) && values_ != nullptr) {
-            for (int32_t i = 0; i < value_count_; i++) {
-                if (values_[i] == invalid_value_) {
-                    result++;
-                }
+        if (hasFeature(kFeature_Invalid_Value) && hasValues()) {
+            try {
+                forEachBlock([&](int32_t, int32_t, int32_t w, int32_t h, const T* values, int32_t stride) {
+                    for (int32_t y = 0; y < h; y++) {
+                        const T* row = values + static_cast<int64_t>(y) * stride;
+                        for (int32_t x = 0; x < w; x++) {
+                            if (row[x] == invalid_value_) {
+                                result++;
+                            }
+                        }
+                    }
+                });
+            }
+            catch (...) {
+                // Tiles, which can't be read, are ignored
             }
         }
         return result;
     }
 
+    /**
+     *  @brief Calls `fn(x0, y0, w, h, values, stride)` for all blocks of values.
+     *
+     *  `x0`, `y0` is the grid position of the first value of a block, `w` and
+     *  `h` its size and `stride` the distance between rows. A grid in memory
+     *  is a single block, a mapped grid has one block per tile, so each tile
+     *  is inflated only once per pass. Throws an `Exception` if a tile can't
+     *  be read.
+     */
+    template <typename F>
+    void forEachBlock(F&& fn) const {
+        if (values_ != nullptr) {
+            fn(0, 0, width_, height_, static_cast<const T*>(values_), width_);
+        }
+        else if (tiles_ != nullptr) {
+            int32_t tile_size = tiles_->tileSize();
+            for (int32_t tile_y = 0; tile_y < tiles_->yTileCount(); tile_y++) {
+                for (int32_t tile_x = 0; tile_x < tiles_->xTileCount(); tile_x++) {
+                    int32_t x0 = tile_x * tile_size;
+                    int32_t y0 = tile_y * tile_size;
+                    auto values = reinterpret_cast<const T*>(tiles_->tileData(tile_y * tiles_->xTileCount() + tile_x));
+                    fn(x0, y0, std::min(tile_size, width_ - x0), std::min(tile_size, height_ - y0), values, tile_size);
+                }
+            }
+        }
+    }
+
     // Feature flags
     void setFeature(int32_t index) noexcept { feature_flags_.setFlag(index); }
     void clearFeature(int32_t index) noexcept { feature_flags_.clearFlag(index); }
@@ -313,6 +392,17 @@ public:
                 values_[i] = value;
             }
         }
+        else if (tiles_ != nullptr && tiles_->isWritable()) {
+            auto n = static_cast<int64_t>(tiles_->tileSize()) * tiles_->tileSize();
+            try {
+                for (int32_t i = 0; i < tiles_->tileCount(); i++) {
+                    std::fill_n(reinterpret_cast<T*>(tiles_->mutTileData(i)), n, value);
+                }
+            }
+            catch (...) {
+                // Tiles, which can't be written, are left unchanged
+            }
+        }
     }
 
     /**
@@ -329,10 +419,14 @@ public:
 
     ErrorCode writeFile(const String& file_path) noexcept;
     ErrorCode readFile(const String& file_path) noexcept;
+    ErrorCode writeTiledFile(const String& file_path, int32_t tile_size = ValueGridTiles::kDefaultTileSize, ValueGridTiles::Compression compression = ValueGridTiles::Compression::None) noexcept;
+    ErrorCode mapFile(const String& file_path, bool writable = false, int32_t cache_size = ValueGridTiles::kDefaultCacheSize) noexcept;
 
     virtual void writeCustomInfo() {};      ///< Can be overriden by derivated classes.
     virtual void readCustomInfo() {};       ///< Can be overriden by derivated classes.
 
+    void _writeHeader(File* file, bool tiled);
+    void _readHeader(File* file);
     void _writeDataToFile(File* file);
     void _writeTypeValue(File* file, T value);
 
@@ -341,6 +435,7 @@ public:
     T _readTypeValue(File* file);
 
     ErrorCode writeCVF2File(const String& file_path, LengthUnit length_unit, int32_t min_digits, int32_t max_digits) noexcept;
+    ErrorCode writeCVF2BlockFile(const String& file_path, LengthUnit length_unit, int32_t block_size = 64, int32_t thread_count = 0) noexcept;
 
     [[nodiscard]] Image* buildImage(bool flip_y = false) const noexcept;
     [[nodiscard]] Image* buildImageAlphaWhereUndefined(T undefined_value, bool flip_y = false) const noexcept;
@@ -0,0 +1,182 @@
+//
+//  ValueGridTiles.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainValueGridTiles_hpp
+#define GrainValueGridTiles_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "String/String.hpp"
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace Grain {
+
+class File;
+
+
+/**
+ *  @brief Tile storage of a memory mapped `ValueGrid`.
+ *
+ *  The tile section of a tiled ValueGrid file follows the ValueGrid header.
+ *  The grid is split into square tiles of `tile_size` values, every tile
+ *  holds `tile_size * tile_size` values row by row, tiles at the right and
+ *  bottom border are padded. Tiles are stored uncompressed, aligned to
+ *  `kDataAlignment` bytes, or compressed with zlib.
+ *
+ *  The file is mapped into memory. Uncompressed tiles are accessed directly
+ *  in the mapping, read-only or read-write. Compressed tiles are inflated
+ *  on access into a small cache with least recently used replacement, the
+ *  grid is never fully resident.
+ *
+ *  The tile section layout, little-endian:
+ *
+ *      uint32 tile size, uint16 value size, uint16 compression
+ *      uint64 x (tile count), file position of each tile
+ *      uint64 x (tile count), stored size of each tile in bytes
+ *      tile data
+ *
+ *  For an uncompressed file, pointers returned by `tileData()` and
+ *  `valuePtr()` stay valid as long as the file is mapped. For a compressed
+ *  file they point into the cache and stay valid only until the slot is
+ *  reused, which can happen on the next call from any thread. The cache is
+ *  guarded by a mutex, so `readValue()`, which copies the value while
+ *  holding it, can be called from several threads. Pointers into the cache
+ *  must not be used while other threads access the tiles.
+ */
+class ValueGridTiles : public Object {
+
+public:
+    enum class Compression {
+        None = 0,
+        Zlib = 1
+    };
+
+    enum {
+        kDefaultTileSize = 256,
+        kMinTileSize = 16,
+        kMaxTileSize = 4096,
+        kDefaultCacheSize = 16,     ///< Default number of inflated tiles in the cache
+        kDataAlignment = 64         ///< Alignment of uncompressed tiles in the file
+    };
+
+    /**
+     *  @brief Fills a tile with `tile_size` values per row, `x0` and `y0` are
+     *         the grid position of the top left value, `w` and `h` the part
+     *         of the tile inside the grid.
+     */
+    using TileFiller = std::function<void(int32_t x0, int32_t y0, int32_t w, int32_t h, uint8_t* out_tile)>;
+
+protected:
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    int32_t value_size_ = 0;
+    int32_t tile_size_ = 0;
+    int32_t x_tile_count_ = 0;
+    int32_t y_tile_count_ = 0;
+    Compression compression_ = Compression::None;
+
+    std::vector<uint64_t> tile_pos_;
+    std::vector<uint64_t> tile_stored_size_;
+
+    int32_t fd_ = -1;
+    uint8_t* map_ = nullptr;
+    int64_t map_size_ = 0;
+    bool writable_ = false;
+
+    struct CacheSlot {
+        int32_t tile_index_ = -1;
+        uint64_t last_use_ = 0;
+        std::vector<uint8_t> data_;
+    };
+
+    std::vector<CacheSlot> cache_;
+    int32_t cache_size_ = kDefaultCacheSize;
+    uint64_t use_counter_ = 0;
+    int64_t inflate_count_ = 0;
+    std::mutex cache_mutex_;        ///< Guards the cache of a compressed file
+
+public:
+    ValueGridTiles(int32_t width, int32_t height, int32_t value_size) noexcept;
+    ~ValueGridTiles() noexcept override;
+
+    ValueGridTiles(const ValueGridTiles&) = delete;
+    ValueGridTiles& operator = (const ValueGridTiles&) = delete;
+
+    [[nodiscard]] const char* className() const noexcept override { return "ValueGridTiles"; }
+
+    friend std::ostream& operator << (std::ostream& os, const ValueGridTiles* o) {
+        o == nullptr ? os << "ValueGridTiles nullptr" : os << *o;
+        return os;
+    }
+
+    friend std::ostream& operator << (std::ostream& os, const ValueGridTiles& o) {
+        os << "tile size: " << o.tile_size_ << ", tiles: " << o.x_tile_count_ << " * " << o.y_tile_count_;
+        os << ", compression: " << static_cast<int32_t>(o.compression_);
+        os << ", mapped: " << o.map_size_ << " bytes" << (o.writable_ ? ", writable" : "");
+        os << ", inflated tiles: " << o.inflate_count_;
+        return os;
+    }
+
+    [[nodiscard]] bool isMapped() const noexcept { return map_ != nullptr; }
+    [[nodiscard]] bool isWritable() const noexcept { return writable_; }
+    [[nodiscard]] Compression compression() const noexcept { return compression_; }
+    [[nodiscard]] int32_t tileSize() const noexcept { return tile_size_; }
+    [[nodiscard]] int32_t xTileCount() const noexcept { return x_tile_count_; }
+    [[nodiscard]] int32_t yTileCount() const noexcept { return y_tile_count_; }
+    [[nodiscard]] int32_t tileCount() const noexcept { return x_tile_count_ * y_tile_count_; }
+    [[nodiscard]] int64_t tileByteCount() const noexcept { return static_cast<int64_t>(tile_size_) * tile_size_ * value_size_; }
+    [[nodiscard]] int32_t cacheSize() const noexcept { return cache_size_; }
+    [[nodiscard]] int64_t inflateCount() const noexcept { return inflate_count_; }
+
+    void setCacheSize(int32_t cache_size) noexcept;
+
+    void readIndex(File* file);
+    void map(const String& file_path, bool writable);
+    void unmap() noexcept;
+
+    const uint8_t* tileData(int32_t tile_index);
+    uint8_t* mutTileData(int32_t tile_index);
+    void readValue(int32_t x, int32_t y, void* out_value);
+
+    /**
+     *  @brief Pointer to the value at grid position `x`, `y`.
+     *
+     *  The position must be inside the grid. See the class description for
+     *  the lifetime of the pointer.
+     */
+    const uint8_t* valuePtr(int32_t x, int32_t y) {
+        int32_t tile_index = (y / tile_size_) * x_tile_count_ + x / tile_size_;
+        int64_t offset = static_cast<int64_t>(y % tile_size_) * tile_size_ + x % tile_size_;
+        return tileData(tile_index) + offset * value_size_;
+    }
+
+    uint8_t* mutValuePtr(int32_t x, int32_t y) {
+        int32_t tile_index = (y / tile_size_) * x_tile_count_ + x / tile_size_;
+        int64_t offset = static_cast<int64_t>(y % tile_size_) * tile_size_ + x % tile_size_;
+        return mutTileData(tile_index) + offset * value_size_;
+    }
+
+    static void writeTiles(File* file, int32_t width, int32_t height, int32_t value_size, int32_t tile_size, Compression compression, const TileFiller& filler);
+
+    [[nodiscard]] static bool isValidTileSize(int32_t tile_size) noexcept {
+        return tile_size >= kMinTileSize && tile_size <= kMaxTileSize && tile_size % 2 == 0;
+    }
+
+protected:
+    const uint8_t* _tileData(int32_t tile_index);
+};
+
+
+} // End of namespace Grain
+
+#endif // GrainValueGridTiles_hpp
@@ -14,11 +14,13 @@
 #include "Math/Vec2.hpp"
 #include "Math/Vec3.hpp"
 #include "2d/Bounds2.hpp"
+#include "Math/Random.hpp"
 
 #include <vector>
 #include <random>
 #include <cmath>
 #include <optional>
+#include <algorithm>
 
 
 namespace Grain {
@@ -31,6 +33,15 @@ class ImageAccess;
 typedef double (*PoissonDiscRandomFunc)(void* ref);
 
 
+/**
+ *  @class PoissonDiscDensity
+ *  @brief Controls the distance of the points of a `PoissonDiscSampler`.
+ *
+ *  `densityAtPos()` returns the minimum distance between points at a
+ *  position, between the minimum and maximum radius of the sampler. It is
+ *  evaluated once per texel of a `PoissonDiscRadiusMap` when the sampler is
+ *  created, not per candidate.
+ */
 class PoissonDiscDensity {
 protected:
     PoissonDiscSampler* sampler_ = nullptr;
@@ -64,16 +75,93 @@ public:
 };
 
 
+/**
+ *  @class PoissonDiscRadiusMap
+ *  @brief The radii of a `PoissonDiscDensity`, rasterized for fast lookup.
+ *
+ *  The density is evaluated once at the center of each texel. Lookups
+ *  interpolate bilinearly, need no virtual call and are thread-safe.
+ */
+class PoissonDiscRadiusMap {
+protected:
+    double min_x_ = 0.0;
+    double min_y_ = 0.0;
+    double inv_texel_size_ = 1.0;
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    std::vector<float> radii_;
+
+public:
+    PoissonDiscRadiusMap() = default;
+
+    void build(PoissonDiscDensity* density, const Bounds2d& range, double texel_size, double r_min, double r_max);
+
+    [[nodiscard]] int32_t width() const noexcept { return width_; }
+    [[nodiscard]] int32_t height() const noexcept { return height_; }
+
+    [[nodiscard]] double radiusAtPos(double x, double y) const noexcept {
+        double fx = std::max((x - min_x_) * inv_texel_size_ - 0.5, 0.0);
+        double fy = std::max((y - min_y_) * inv_texel_size_ - 0.5, 0.0);
+        int32_t x0 = std::min(static_cast<int32_t>(fx), width_ - 1);
+        int32_t y0 = std::min(static_cast<int32_t>(fy), height_ - 1);
+        int32_t x1 = std::min(x0 + 1, width_ - 1);
+        int32_t y1 = std::min(y0 + 1, height_ - 1);
+        double tx = std::min(fx - x0, 1.0);
+        double ty = std::min(fy - y0, 1.0);
+        const float* r0 = &radii_[static_cast<size_t>(y0) * width_];
+        const float* r1 = &radii_[static_cast<size_t>(y1) * width_];
+        double a = r0[x0] + (r0[x1] - r0[x0]) * tx;
+        double b = r1[x0] + (r1[x1] - r1[x0]) * tx;
+        return a + (b - a) * ty;
+    }
+};
+
+
+/**
+ *  @class PoissonDiscSampler
+ *  @brief Generates points with a minimum distance, which may vary over the
+ *         area.
+ *
+ *  Uses a background grid with a cell size of `r_min / sqrt(2)`, so each
+ *  cell holds at most one point and a candidate only needs to be checked
+ *  against the points in the cells around it.
+ *
+ *  `next()` returns one point after the other. `generate()` creates all
+ *  points at once, which is much faster: the area is split into tiles,
+ *  which are processed in four passes. The tiles of a pass are at least one
+ *  tile apart, so they cannot conflict and run in parallel. Each tile grows
+ *  from the points already placed along its borders. Every tile has its own
+ *  random sequence derived from the seed, so the result depends only on
+ *  the seed, not on the number of threads.
+ *
+ *  A derived class may replace `random_func_`. `generate()` then processes
+ *  the tiles one after the other in a single thread and draws all random
+ *  numbers from that function.
+ */
 class PoissonDiscSampler {
 protected:
+    struct GridCell {
+        double x_, y_;  ///< Position relative to the minimum of the range, negative if empty
+    };
+
+    enum {
+        kMinTileCells = 32
+    };
+
     double min_x_, min_y_, max_x_, max_y_;
     double min_radius_, max_radius_;
     double cell_size_;
     int32_t k_, grid_width_, grid_height_;
+    int32_t search_range_;          ///< Number of cells around a candidate to cover `max_radius_`
     PoissonDiscDensity* density_;
+    PoissonDiscRadiusMap radius_map_;
     PoissonDiscRandomFunc random_func_;
+    RandomEngine random_engine_;
+    uint64_t seed_ = RandomEngine::kDefaultSeed;
+    uint64_t stream_ = 0;
+    int32_t thread_count_ = 0;
 
-    std::vector<std::optional<Vec2d>> grid_;
+    std::vector<GridCell> grid_;
     std::vector<Vec2d> point_queue_;
     bool first_point_flag_ = true;
 
@@ -88,18 +176,27 @@ public:
     double height() { return max_y_ - min_y_; }
     double minRadius() { return min_radius_; }
     double maxRadius() { return max_radius_; }
+    double radiusAtPos(double x, double y) const { return radius_map_.radiusAtPos(x, y); }
+
+    void setSeed(uint64_t seed, uint64_t stream = 0) { seed_ = seed; stream_ = stream; random_engine_.seed(seed, stream); }
+    void setThreadCount(int32_t thread_count) { thread_count_ = std::max(thread_count, 0); }
+    void rebuildDensityMap(double texel_size = 0.0);
 
     void reset();
     std::optional<Vec2d> next();
     std::vector<Vec2d> all();
+    std::vector<Vec2d> generate();
     bool done() const;
 
 private:
     double distSquared(double x1, double y1, double x2, double y2) const;
     bool isValidPoint(double x, double y) const;
     Vec2d createNewPoint(double x, double y);
+    void insertIntoGrid(double x, double y);
+    void generateTile(int32_t tile_x, int32_t tile_y, int32_t tile_cells, std::vector<Vec2d>& out_points);
+    [[nodiscard]] bool hasCustomRandomFunc() const noexcept { return random_func_ != _randomFunc; }
 
-    static double _randomFunc(void* ref) { return static_cast<double>(rand()) / RAND_MAX; }
+    static double _randomFunc(void* ref) { return static_cast<PoissonDiscSampler*>(ref)->random_engine_.nextDouble(); }
 };
 
 } // End of namespace Grain
@@ -15,6 +15,7 @@
 #include "Type/List.hpp"
 #include "Color/RGB.hpp"
 #include "Color/RGBA.hpp"
+#include "Color/GradientLUT.hpp"
 #include "2d/Rect.hpp"
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -209,6 +210,9 @@ protected:
     RGBLUT1* m_lut = nullptr;               ///< The LUT, will be created, as soon it is needed
     bool m_must_sort = false;               ///< Indicates, if stops must be sorted befor usage
     bool m_lut_must_update = false;         ///< Indicates, if LUT must be updated before usage
+    uint64_t m_revision = 0;                ///< Incremented on every change, used to detect outdated snapshots
+    GradientLUTSnapshot m_lut_snapshot;     ///< Cached snapshot for bulk lookups, see `lutSnapshot()`
+    uint64_t m_lut_snapshot_revision = 0;   ///< Revision of the gradient when `m_lut_snapshot` was built
 
 #if defined(__APPLE__) && defined(__MACH__)
     CGGradientRef m_cg_gradient = nullptr;  ///< CoreGraphics representation for internal use
@@ -238,6 +242,7 @@ public:
     static Gradient* createByPreset(Preset preset, bool flip = false) noexcept;
 
     void set(const Gradient* gradient) noexcept;
+    ColorSpace colorSpace() const noexcept { return m_color_space; }
     void setColorSpace(ColorSpace color_space) noexcept {
         if (color_space != m_color_space) {
             m_color_space = color_space;
@@ -312,6 +317,8 @@ public:
     bool updateLUT() noexcept;
     bool lookupFromLUT(float pos, RGB& out_color) noexcept;
 
+    GradientLUTSnapshot lutSnapshot(const GradientLUT::Options& options = {}) noexcept;
+
     void draw(GraphicContext* gc, const Vec2d& start_pos, const Vec2d& end_pos) noexcept;
     void draw(GraphicContext* gc, const Vec2d& start_pos, const Vec2d& end_pos, bool draw_before, bool draw_after) noexcept;
     void drawInRect(GraphicContext* gc, const Rectd& rect, Direction direction) noexcept;
@@ -0,0 +1,125 @@
+//
+//  GradientLUT.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainGradientLUT_hpp
+#define GrainGradientLUT_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "Color/RGBA.hpp"
+
+#include <memory>
+
+
+namespace Grain {
+
+    class Gradient;
+    class Image;
+
+    template <class T>
+    class ValueGrid;
+
+
+    /**
+     *  @brief Immutable, precomputed color table of a Gradient for bulk lookups.
+     *
+     *  A GradientLUT is a snapshot of a Gradient at the moment of construction.
+     *  It holds the sampled RGBA colors as float and as 8 bit values and never
+     *  changes afterwards, so a single instance can be shared by any number of
+     *  threads without locking.
+     *
+     *  All lookups blend linearly between the two nearest table entries, the
+     *  8 bit lookups round the blended float colors. The entries themselves
+     *  are exact colors of the gradient, see `evaluate()`.
+     *
+     *  The bulk methods map whole arrays of values to colors. They work in
+     *  chunks, first computing table indices and blend factors for the chunk,
+     *  then gathering and blending the table entries. Both loops are free of
+     *  branches and dependencies between elements, so the compiler can
+     *  vectorise them.
+     *
+     *  Use `Gradient::lutSnapshot()` to get a cached instance.
+     */
+    class GradientLUT : public Object {
+    public:
+        enum {
+            kMinResolution = 2,
+            kMaxResolution = 65536,
+            kDefaultResolution = 1024
+        };
+
+        enum class Interpolation {
+            RGB = 0,    ///< Linear blend of the RGBA components, in linear light if the gradient uses `ColorSpace::LinearRGB`
+            Mixbox,     ///< Pigment like blend, same as `Gradient::lookupColor()`
+            OKLab       ///< Perceptual blend in OKLab space
+        };
+
+        struct Options {
+            Interpolation interpolation = Interpolation::Mixbox;
+            bool stepped = true;    ///< Honor the step count of gradient stops
+            int32_t resolution = kDefaultResolution;
+
+            bool operator == (const Options& other) const noexcept {
+                return interpolation == other.interpolation && stepped == other.stepped && resolution == other.resolution;
+            }
+            bool operator != (const Options& other) const noexcept { return !(*this == other); }
+        };
+
+    protected:
+        Options m_options;
+        int32_t m_resolution = 0;
+        int32_t m_max_index = 0;
+        float* m_rgba = nullptr;        ///< `m_resolution + 1` RGBA float entries, the last one duplicates the end color
+        uint8_t* m_rgba8 = nullptr;     ///< `m_resolution` RGBA 8 bit entries
+
+    public:
+        explicit GradientLUT(Gradient& gradient, const Options& options) noexcept;
+        ~GradientLUT() noexcept override;
+
+        GradientLUT(const GradientLUT&) = delete;
+        GradientLUT& operator = (const GradientLUT&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "GradientLUT"; }
+
+        friend std::ostream& operator << (std::ostream& os, const GradientLUT* o) {
+            o == nullptr ? os << "GradientLUT nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const GradientLUT& o) {
+            os << "resolution: " << o.m_resolution << ", interpolation: " << static_cast<int32_t>(o.m_options.interpolation);
+            os << ", stepped: " << o.m_options.stepped;
+            return os;
+        }
+
+        [[nodiscard]] bool isValid() const noexcept { return m_rgba != nullptr && m_rgba8 != nullptr; }
+        [[nodiscard]] const Options& options() const noexcept { return m_options; }
+        [[nodiscard]] int32_t resolution() const noexcept { return m_resolution; }
+        [[nodiscard]] const float* rgbaPtr() const noexcept { return m_rgba; }
+        [[nodiscard]] const uint8_t* rgba8Ptr() const noexcept { return m_rgba8; }
+
+        void lookup(float pos, RGBA& out_color) const noexcept;
+        void lookup(float pos, float* out_rgba) const noexcept;
+
+        void lookup(const float* values, int64_t n, float min, float max, float* out_rgba) const noexcept;
+        void lookup(const float* values, int64_t n, float min, float max, uint8_t* out_rgba8) const noexcept;
+
+        template <typename T>
+        ErrorCode mapValueGrid(const ValueGrid<T>& value_grid, float min, float max, Image* out_image, bool flip_y = false) const noexcept;
+
+        static void evaluate(Gradient& gradient, const Options& options, float pos, RGBA& out_color) noexcept;
+    };
+
+
+    using GradientLUTSnapshot = std::shared_ptr<const GradientLUT>;
+
+
+} // End of namespace Grain
+
+#endif // GrainGradientLUT_hpp
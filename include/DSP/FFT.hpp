@@ -169,6 +169,9 @@ namespace Grain {
         ErrorCode fft(float* samples) noexcept;
         ErrorCode ifft(float* out_samples) noexcept;
 
+        ErrorCode forward(const float* samples, float* out_real, float* out_imag) noexcept;
+        ErrorCode inverse(const float* real, const float* imag, float* out_samples) noexcept;
+
         ErrorCode filter(const Partials* partials) noexcept;
 
         ErrorCode setPartials(const Partials* partials) noexcept;
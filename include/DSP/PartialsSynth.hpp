@@ -0,0 +1,170 @@
+//
+//  PartialsSynth.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainPartialsSynth_hpp
+#define GrainPartialsSynth_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+
+#include <vector>
+
+
+namespace Grain {
+
+    class Partials;
+    class Signal;
+    class FFT;
+
+
+    /**
+     *  @class PartialsSynth
+     *  @brief Additive synthesis of a sequence of `Partials` frames by inverse
+     *         FFT.
+     *
+     *  Partial `i` of a frame is a cosine at `(i + 1) * base_freq` with the
+     *  magnitude and phase stored in the frame, as delivered by
+     *  `FFT::getPartials()` or `SignalWave::partials()`. Frames are
+     *  `frameHop()` samples apart, frame `k` is at sample `k * frameHop()`
+     *  and its phases are the phases at that sample. Between frames,
+     *  magnitudes and frequencies are interpolated linearly.
+     *
+     *  Instead of evaluating every partial per sample, each synthesis frame is
+     *  built in the spectral domain: every partial adds the spectrum of a
+     *  Blackman-Harris windowed sinusoid, a few bins around its frequency,
+     *  taken from a precomputed table. One inverse FFT then gives all partials
+     *  at once. The window is divided out and replaced by a triangle, and the
+     *  frames are overlap-added every `hop()` samples. The cost per frame is
+     *  one inverse FFT plus `kKernelWidth` bins per partial, instead of
+     *  `hop()` samples per partial.
+     *
+     *  Steady partials are reproduced with an error far below -90 dB. Within
+     *  a synthesis frame the frequency of a partial is constant, so fast
+     *  glides of high partials are approximated, a shorter `fftLength()`
+     *  follows them more closely.
+     *
+     *  In `PhaseMode::Free`, the phases of the first frame are used and then
+     *  follow the frequencies. In `PhaseMode::Locked`, the frequencies are
+     *  corrected slightly between two frames, so every partial reaches the
+     *  phase given in the next frame at its frame time.
+     *
+     *  Streaming:
+     *  @code
+     *  PartialsSynth synth(48000, 512);
+     *  for (auto frame : frames) {
+     *      synth.pushFrame(frame, base_freq);
+     *      int64_t n = synth.pull(block, block_len);
+     *  }
+     *  synth.finish();
+     *  while (int64_t n = synth.pull(block, block_len)) { ... }
+     *  @endcode
+     *
+     *  Output sample `t` is available once the frame following `t + hop()`
+     *  has been pushed. After `finish()`, the sound fades out over `hop()`
+     *  samples after the last frame.
+     */
+    class PartialsSynth : public Object {
+    public:
+        enum class PhaseMode {
+            Free = 0,   ///< Phases follow the frequencies, only the phases of the first frame are used
+            Locked      ///< Phases match the phases of every frame
+        };
+
+        enum {
+            kDefaultFFTLength = 1024,
+            kKernelHalfWidth = 4,           ///< Main lobe half width of the Blackman-Harris window in bins
+            kKernelWidth = 2 * kKernelHalfWidth,
+            kKernelOversampling = 256       ///< Table entries per bin
+        };
+
+        static constexpr float kMinMagnitude = 1.0e-7f;    ///< Quieter partials are skipped
+
+    public:
+        PartialsSynth(int32_t sample_rate, int32_t frame_hop, int32_t fft_len = kDefaultFFTLength) noexcept;
+        ~PartialsSynth() noexcept override;
+
+        [[nodiscard]] const char* className() const noexcept override { return "PartialsSynth"; }
+
+        friend std::ostream& operator << (std::ostream& os, const PartialsSynth* o) {
+            o == nullptr ? os << "PartialsSynth nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const PartialsSynth& o) {
+            os << "fft length: " << o.fft_len_ << ", hop: " << o.hop_;
+            os << ", frame hop: " << o.frame_hop_ << ", sample rate: " << o.sample_rate_;
+            return os;
+        }
+
+        [[nodiscard]] bool isValid() const noexcept { return fft_ != nullptr; }
+        [[nodiscard]] int32_t sampleRate() const noexcept { return sample_rate_; }
+        [[nodiscard]] int32_t fftLength() const noexcept { return fft_len_; }
+        [[nodiscard]] int32_t hop() const noexcept { return hop_; }
+        [[nodiscard]] int32_t frameHop() const noexcept { return frame_hop_; }
+        [[nodiscard]] PhaseMode phaseMode() const noexcept { return phase_mode_; }
+        [[nodiscard]] int64_t frameCount() const noexcept { return frame_count_; }
+        [[nodiscard]] int64_t availableCount() const noexcept { return static_cast<int64_t>(ready_.size()) - ready_offs_; }
+
+        void setPhaseMode(PhaseMode mode) noexcept { phase_mode_ = mode; }
+
+        void reset() noexcept;
+        ErrorCode pushFrame(const Partials* partials, float base_freq = 0.0f) noexcept;
+        ErrorCode finish() noexcept;
+        int64_t pull(float* out_samples, int64_t max_count) noexcept;
+
+        ErrorCode render(
+                const std::vector<const Partials*>& frames, const std::vector<float>& base_freqs,
+                Signal* out_signal, int32_t channel, int64_t offs = 0) noexcept;
+
+    protected:
+        void _setNextFrame(const Partials* partials, float base_freq);
+        void _synthesizeInterval(int32_t step_count);
+        void _synthesizeFrame(const float* mags, const float* freqs) noexcept;
+        void _finalize(int64_t end);
+        [[nodiscard]] static double _wrapPhase(double phase) noexcept;
+
+    protected:
+        int32_t sample_rate_ = 0;
+        int32_t fft_len_ = 0;
+        int32_t bin_count_ = 0;                 ///< `fft_len_ / 2 + 1`
+        int32_t hop_ = 0;                       ///< Distance of the synthesis frames
+        int32_t frame_hop_ = 0;                 ///< Distance of the `Partials` frames, a multiple of `hop_`
+        PhaseMode phase_mode_ = PhaseMode::Free;
+
+        FFT* fft_ = nullptr;
+        std::vector<float> kernel_real_;        ///< Spectrum of the window around a sine, `kKernelOversampling` entries per bin
+        std::vector<float> kernel_imag_;
+        std::vector<float> synth_window_;       ///< Triangle divided by the window, `2 * hop_` samples
+        std::vector<float> spec_real_;
+        std::vector<float> spec_imag_;
+        std::vector<float> frame_buffer_;
+
+        int32_t partial_count_ = 0;
+        std::vector<float> prev_mag_;           ///< Frame before the interval being synthesized
+        std::vector<float> prev_freq_;
+        std::vector<float> next_mag_;           ///< Frame after the interval being synthesized
+        std::vector<float> next_freq_;
+        std::vector<float> next_phase_;
+        std::vector<float> mag_;                ///< Interpolated values of the current synthesis frame
+        std::vector<float> freq_;
+        std::vector<double> phase_;             ///< Phase of each partial at the current synthesis frame
+        std::vector<double> phase_step_;        ///< Correction per synthesis frame in `PhaseMode::Locked`
+
+        int64_t frame_count_ = 0;               ///< Frames pushed since `reset()`
+        bool finished_ = false;
+        std::vector<float> ola_;                ///< Overlap-add buffer, `ola_[0]` is at sample `ola_pos_`
+        int64_t ola_pos_ = 0;
+        std::vector<float> ready_;              ///< Final samples, waiting for `pull()`
+        int64_t ready_offs_ = 0;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainPartialsSynth_hpp
@@ -0,0 +1,150 @@
+//
+//  Resampler.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainResampler_hpp
+#define GrainResampler_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "DSP/RingBuffer.hpp"
+
+#include <vector>
+
+
+namespace Grain {
+
+    /**
+     *  @class Resampler
+     *  @brief Band-limited sample rate converter based on a polyphase
+     *         Kaiser-windowed sinc filter.
+     *
+     *  For a conversion from `src_rate` to `dst_rate`, the ratio is reduced to
+     *  `L / M`. If `L` is small enough, one filter phase is precomputed for each
+     *  of the `L` possible output positions between two input samples, so every
+     *  output sample is a single dot product with exact coefficients. For other
+     *  ratios a table of `kTablePhaseCount` phases is used and the output is
+     *  interpolated linearly between the two neighbouring phases.
+     *
+     *  When downsampling, the cutoff frequency is lowered to the new Nyquist
+     *  frequency and the filter is stretched accordingly, so the conversion is
+     *  free of aliasing down to the stopband attenuation of the quality preset.
+     *  The transition band is placed below the Nyquist frequency of the lower
+     *  of both rates.
+     *
+     *  The resampler can be used in two ways:
+     *  - `resample()` converts a complete buffer, samples outside the buffer
+     *    are treated as zero. It does not change the state of the resampler and
+     *    can be called from several threads at the same time, e.g. one per
+     *    channel.
+     *  - `process()` converts a stream block by block and keeps the history
+     *    needed by the filter between calls. Call `flush()` at the end of the
+     *    stream to get the remaining output samples.
+     *
+     *  In both modes, output sample `n` corresponds to the input position
+     *  `n * src_rate / dst_rate`, there is no delay.
+     */
+    class Resampler : public Object {
+    public:
+        enum class Quality {
+            Fast = 0,       ///< 8 zero crossings per side, about 60 dB stopband attenuation
+            Medium,         ///< 16 zero crossings per side, about 80 dB stopband attenuation
+            High,           ///< 32 zero crossings per side, about 100 dB stopband attenuation
+            Best            ///< 64 zero crossings per side, about 120 dB stopband attenuation
+        };
+
+        enum {
+            kMaxPolyphaseCount = 1024,      ///< Larger values of `L` use the interpolated table
+            kTablePhaseCount = 512,         ///< Number of phases in the interpolated table
+            kTapAlignment = 8               ///< Phases are padded to a multiple of this number of taps
+        };
+
+    public:
+        Resampler() noexcept = default;
+        Resampler(int32_t src_rate, int32_t dst_rate, Quality quality = Quality::High) noexcept;
+        ~Resampler() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "Resampler"; }
+
+        friend std::ostream& operator << (std::ostream& os, const Resampler* o) {
+            o == nullptr ? os << "Resampler nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const Resampler& o) {
+            os << o.src_rate_ << " Hz -> " << o.dst_rate_ << " Hz";
+            os << ", taps: " << o.tap_count_;
+            os << ", phases: " << o.phase_count_ << (o.polyphase_ ? " (polyphase)" : " (interpolated)");
+            return os;
+        }
+
+        ErrorCode configure(int32_t src_rate, int32_t dst_rate, Quality quality = Quality::High) noexcept;
+
+        [[nodiscard]] bool isConfigured() const noexcept { return tap_count_ > 0; }
+        [[nodiscard]] int32_t srcRate() const noexcept { return src_rate_; }
+        [[nodiscard]] int32_t dstRate() const noexcept { return dst_rate_; }
+        [[nodiscard]] Quality quality() const noexcept { return quality_; }
+        [[nodiscard]] bool isPolyphase() const noexcept { return polyphase_; }
+        [[nodiscard]] int32_t tapCount() const noexcept { return tap_count_; }
+        [[nodiscard]] int32_t phaseCount() const noexcept { return phase_count_; }
+        [[nodiscard]] double cutoff() const noexcept { return cutoff_; }
+
+        [[nodiscard]] int64_t outputLength(int64_t input_len) const noexcept;
+
+        ErrorCode resample(
+                const float* in, int64_t in_len, int64_t in_stride,
+                float* out, int64_t out_len, int64_t out_stride) const noexcept;
+
+        void reset() noexcept;
+        int64_t process(const float* in, int64_t in_len, float* out, int64_t out_capacity) noexcept;
+        int64_t process(RingBuffer<float>& in, int64_t in_len, float* out, int64_t out_capacity) noexcept;
+        int64_t flush(float* out, int64_t out_capacity) noexcept;
+
+        [[nodiscard]] static double besselI0(double x) noexcept;
+
+    protected:
+        [[nodiscard]] const float* _phasePtr(int32_t phase) const noexcept {
+            return coefs_.data() + static_cast<size_t>(phase) * tap_stride_;
+        }
+
+        [[nodiscard]] float _filter(const float* window, uint64_t frac) const noexcept;
+        void _step(int64_t& index, uint64_t& frac) const noexcept;
+        int64_t _drain(float* out, int64_t out_capacity, int64_t end_pos) noexcept;
+        float* _appendHistory(int64_t n) noexcept;
+
+        [[nodiscard]] static float _dot(const float* a, const float* b, int32_t n) noexcept;
+
+    protected:
+        int32_t src_rate_ = 0;
+        int32_t dst_rate_ = 0;
+        Quality quality_ = Quality::High;
+
+        bool polyphase_ = false;            ///< true, if there is an exact phase for each output position
+        int32_t tap_count_ = 0;             ///< Taps per phase, even
+        int32_t tap_stride_ = 0;            ///< Taps per phase, padded to `kTapAlignment`
+        int32_t phase_count_ = 0;           ///< `L` in polyphase mode, else `kTablePhaseCount`
+        double cutoff_ = 0.0;               ///< Cutoff frequency relative to the input sample rate
+        std::vector<float> coefs_;          ///< `phase_count_` (+1 in table mode) phases of `tap_stride_` taps
+
+        uint64_t step_den_ = 1;             ///< Positions are `index + frac / step_den_`
+        int64_t step_index_ = 0;            ///< Integer part of the step per output sample
+        uint64_t step_frac_ = 0;            ///< Fractional part of the step per output sample
+
+        // Streaming state
+        std::vector<float> history_;        ///< Input samples, `history_[0]` is at `history_base_`
+        int64_t history_len_ = 0;           ///< Valid samples in `history_`
+        int64_t history_base_ = 0;          ///< Stream position of `history_[0]`
+        int64_t input_count_ = 0;           ///< Input samples received since `reset()`
+        int64_t pos_index_ = 0;             ///< Position of the next output in `history_`
+        uint64_t pos_frac_ = 0;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainResampler_hpp
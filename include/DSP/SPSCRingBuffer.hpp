@@ -0,0 +1,298 @@
+//
+//  SPSCRingBuffer.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainSPSCRingBuffer_hpp
+#define GrainSPSCRingBuffer_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Wait-free single producer, single consumer ring buffer.
+     *
+     *  Exchanges blocks of samples between exactly one writing and one
+     *  reading thread, e.g. an audio callback and a streaming or rendering
+     *  thread, without locks. Neither side ever blocks, `write()` and
+     *  `read()` transfer as many frames as currently possible and return
+     *  that count.
+     *
+     *  The buffer holds frames of `channelCount()` interleaved values. The
+     *  `...Deinterleaved()` methods transfer from or to separate channel
+     *  buffers.
+     *
+     *  The capacity is rounded up to a power of two, so positions wrap with
+     *  a mask. Read and write index live on separate cache lines and count
+     *  frames monotonically, which avoids false sharing and distinguishes a
+     *  full from an empty buffer without wasting a slot.
+     *
+     *  Thread safety: `write...()` may only be called by the producer,
+     *  `read...()` and `skip()` only by the consumer. `reset()` requires
+     *  that neither side is active.
+     */
+    template <typename T>
+    class SPSCRingBuffer : public Object {
+        static_assert(std::is_trivially_copyable_v<T>, "SPSCRingBuffer requires a trivially copyable type");
+
+    public:
+        enum {
+            kCacheLineSize = 64,
+            kMaxCapacity = 0x1 << 30
+        };
+
+    protected:
+        T* data_ = nullptr;
+        int64_t capacity_ = 0;      ///< Capacity in frames, a power of two
+        int64_t mask_ = 0;
+        int32_t channel_count_ = 1;
+
+        alignas(kCacheLineSize) std::atomic<int64_t> write_index_{0};
+        int64_t cached_read_index_ = 0;     ///< Producer's last seen read index
+
+        alignas(kCacheLineSize) std::atomic<int64_t> read_index_{0};
+        int64_t cached_write_index_ = 0;    ///< Consumer's last seen write index
+
+    public:
+        /**
+         *  @param capacity Minimum number of frames the buffer can hold, at
+         *                  most `kMaxCapacity`. A larger capacity is not
+         *                  clamped, the buffer is not usable then.
+         *  @param channel_count Number of interleaved values per frame.
+         *
+         *  @note Check `isUsable()` after construction. `capacity()` returns
+         *        the actual capacity, which can be larger than requested.
+         */
+        explicit SPSCRingBuffer(int64_t capacity, int32_t channel_count = 1) noexcept {
+            channel_count_ = channel_count > 0 ? channel_count : 1;
+            if (capacity > kMaxCapacity) {
+                return;
+            }
+
+            capacity_ = 1;
+            while (capacity_ < capacity && capacity_ < kMaxCapacity) {
+                capacity_ <<= 1;
+            }
+            mask_ = capacity_ - 1;
+            data_ = (T*)std::malloc(capacity_ * channel_count_ * sizeof(T));
+            if (!data_) {
+                capacity_ = 0;
+                mask_ = 0;
+            }
+        }
+
+        ~SPSCRingBuffer() noexcept override {
+            std::free(data_);
+        }
+
+        SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+        SPSCRingBuffer& operator = (const SPSCRingBuffer&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SPSCRingBuffer"; }
+
+        friend std::ostream& operator << (std::ostream& os, const SPSCRingBuffer* o) {
+            o == nullptr ? os << "SPSCRingBuffer nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const SPSCRingBuffer& o) {
+            os << "capacity: " << o.capacity_ << ", channels: " << o.channel_count_;
+            os << ", read index: " << o.read_index_.load(std::memory_order_relaxed);
+            os << ", write index: " << o.write_index_.load(std::memory_order_relaxed);
+            return os;
+        }
+
+        /**
+         *  @brief `false` if the memory could not be allocated or the
+         *         requested capacity exceeded `kMaxCapacity`.
+         */
+        [[nodiscard]] bool isUsable() const noexcept { return data_ != nullptr; }
+        [[nodiscard]] int64_t capacity() const noexcept { return capacity_; }
+        [[nodiscard]] int32_t channelCount() const noexcept { return channel_count_; }
+
+        /**
+         *  @brief Number of frames that can be read, approximate if called
+         *         by the producer.
+         */
+        [[nodiscard]] int64_t readAvailable() const noexcept {
+            return write_index_.load(std::memory_order_acquire) - read_index_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         *  @brief Number of frames that can be written, approximate if called
+         *         by the consumer.
+         */
+        [[nodiscard]] int64_t writeAvailable() const noexcept {
+            return capacity_ - (write_index_.load(std::memory_order_relaxed) - read_index_.load(std::memory_order_acquire));
+        }
+
+        /**
+         *  @brief Clear the buffer. Not thread safe.
+         */
+        void reset() noexcept {
+            write_index_.store(0, std::memory_order_relaxed);
+            read_index_.store(0, std::memory_order_relaxed);
+            cached_read_index_ = 0;
+            cached_write_index_ = 0;
+        }
+
+
+        /**
+         *  @brief Write interleaved frames.
+         *
+         *  @return The number of frames written, less than `frame_count` if
+         *          the buffer is full.
+         */
+        int64_t write(const T* values, int64_t frame_count) noexcept {
+            int64_t w = write_index_.load(std::memory_order_relaxed);
+            int64_t n = _writableFrames(w, frame_count);
+            if (n <= 0 || !values) {
+                return 0;
+            }
+
+            int64_t pos = w & mask_;
+            int64_t n1 = std::min(n, capacity_ - pos);
+            std::memcpy(data_ + pos * channel_count_, values, n1 * channel_count_ * sizeof(T));
+            if (n1 < n) {
+                std::memcpy(data_, values + n1 * channel_count_, (n - n1) * channel_count_ * sizeof(T));
+            }
+
+            write_index_.store(w + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         *  @brief Write frames from separate channel buffers.
+         *
+         *  @param channels `channelCount()` pointers to the channel data.
+         *  @return The number of frames written.
+         */
+        int64_t writeDeinterleaved(const T* const* channels, int64_t frame_count) noexcept {
+            int64_t w = write_index_.load(std::memory_order_relaxed);
+            int64_t n = _writableFrames(w, frame_count);
+            if (n <= 0 || !channels) {
+                return 0;
+            }
+
+            int64_t pos = w & mask_;
+            int64_t n1 = std::min(n, capacity_ - pos);
+            for (int32_t c = 0; c < channel_count_; c++) {
+                const T* s = channels[c];
+                T* d = data_ + pos * channel_count_ + c;
+                for (int64_t i = 0; i < n1; i++) {
+                    d[i * channel_count_] = s[i];
+                }
+                d = data_ + c;
+                for (int64_t i = n1; i < n; i++) {
+                    d[(i - n1) * channel_count_] = s[i];
+                }
+            }
+
+            write_index_.store(w + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         *  @brief Read interleaved frames.
+         *
+         *  @return The number of frames read, less than `frame_count` if
+         *          not enough frames are available.
+         */
+        int64_t read(T* out_values, int64_t frame_count) noexcept {
+            int64_t r = read_index_.load(std::memory_order_relaxed);
+            int64_t n = _readableFrames(r, frame_count);
+            if (n <= 0 || !out_values) {
+                return 0;
+            }
+
+            int64_t pos = r & mask_;
+            int64_t n1 = std::min(n, capacity_ - pos);
+            std::memcpy(out_values, data_ + pos * channel_count_, n1 * channel_count_ * sizeof(T));
+            if (n1 < n) {
+                std::memcpy(out_values + n1 * channel_count_, data_, (n - n1) * channel_count_ * sizeof(T));
+            }
+
+            read_index_.store(r + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         *  @brief Read frames into separate channel buffers.
+         *
+         *  @param out_channels `channelCount()` pointers to the channel buffers.
+         *  @return The number of frames read.
+         */
+        int64_t readDeinterleaved(T* const* out_channels, int64_t frame_count) noexcept {
+            int64_t r = read_index_.load(std::memory_order_relaxed);
+            int64_t n = _readableFrames(r, frame_count);
+            if (n <= 0 || !out_channels) {
+                return 0;
+            }
+
+            int64_t pos = r & mask_;
+            int64_t n1 = std::min(n, capacity_ - pos);
+            for (int32_t c = 0; c < channel_count_; c++) {
+                T* d = out_channels[c];
+                const T* s = data_ + pos * channel_count_ + c;
+                for (int64_t i = 0; i < n1; i++) {
+                    d[i] = s[i * channel_count_];
+                }
+                s = data_ + c;
+                for (int64_t i = n1; i < n; i++) {
+                    d[i] = s[(i - n1) * channel_count_];
+                }
+            }
+
+            read_index_.store(r + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         *  @brief Discard up to `frame_count` frames.
+         *
+         *  @return The number of frames discarded.
+         */
+        int64_t skip(int64_t frame_count) noexcept {
+            int64_t r = read_index_.load(std::memory_order_relaxed);
+            int64_t n = _readableFrames(r, frame_count);
+            if (n > 0) {
+                read_index_.store(r + n, std::memory_order_release);
+            }
+            return n > 0 ? n : 0;
+        }
+
+    protected:
+        int64_t _writableFrames(int64_t w, int64_t frame_count) noexcept {
+            int64_t free_count = capacity_ - (w - cached_read_index_);
+            if (free_count < frame_count) {
+                cached_read_index_ = read_index_.load(std::memory_order_acquire);
+                free_count = capacity_ - (w - cached_read_index_);
+            }
+            return std::min(free_count, frame_count);
+        }
+
+        int64_t _readableFrames(int64_t r, int64_t frame_count) noexcept {
+            int64_t used_count = cached_write_index_ - r;
+            if (used_count < frame_count) {
+                cached_write_index_ = write_index_.load(std::memory_order_acquire);
+                used_count = cached_write_index_ - r;
+            }
+            return std::min(used_count, frame_count);
+        }
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSPSCRingBuffer_hpp
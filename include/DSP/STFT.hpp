@@ -0,0 +1,152 @@
+//
+//  STFT.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainSTFT_hpp
+#define GrainSTFT_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "Type/List.hpp"
+#include "DSP/DSP.hpp"
+#include "DSP/FFT.hpp"
+#include "2d/Data/ValueGrid.hpp"
+
+#include <functional>
+#include <vector>
+
+
+namespace Grain {
+
+    class Signal;
+    class Image;
+
+
+    /**
+     *  @class STFT
+     *  @brief Short-time Fourier transform and spectrogram engine.
+     *
+     *  Frame `f` is centered at sample `f * hop`, samples outside the input
+     *  are treated as zero. Each frame of `windowLength()` samples is
+     *  multiplied by the analysis window and zero padded to `fftLength()`,
+     *  which gives `binCount()` bins from DC to Nyquist per frame.
+     *
+     *  Frames are independent of each other and are transformed in parallel.
+     *  One `FFT` instance is kept per thread and reused by all following calls,
+     *  so the plans are only created once. Calls on the same `STFT` must not
+     *  overlap, use one instance per calling thread.
+     *
+     *  `inverse()` reconstructs the signal by weighted overlap-add, using the
+     *  analysis window as synthesis window and normalizing by the summed
+     *  squared windows. With an unmodified spectrum the reconstruction is exact
+     *  apart from rounding, wherever the windows overlap.
+     */
+    class STFT : public Object {
+    public:
+        enum class Scale {
+            Magnitude = 0,  ///< Linear amplitude, a full scale sine gives 1.0
+            Power,          ///< Squared amplitude
+            Decibel,        ///< Amplitude in dB, 20 * log10(magnitude)
+            LogMel          ///< Power of the mel bands in dB, 10 * log10(power)
+        };
+
+        enum {
+            kMinFramesPerThread = 16,
+            kDefaultMelBandCount = 128
+        };
+
+        static constexpr float kMinPower = 1.0e-12f;    ///< Lower limit for logarithmic scales, -120 dB
+
+    public:
+        STFT(int32_t sample_rate, int32_t fft_len, int32_t window_len = 0, int32_t hop = 0, DSP::WindowType window_type = DSP::WindowType::Hanning) noexcept;
+        ~STFT() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "STFT"; }
+
+        friend std::ostream& operator << (std::ostream& os, const STFT* o) {
+            o == nullptr ? os << "STFT nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const STFT& o) {
+            os << "fft length: " << o.fft_len_ << ", window length: " << o.window_len_;
+            os << ", hop: " << o.hop_ << ", sample rate: " << o.sample_rate_;
+            return os;
+        }
+
+        [[nodiscard]] bool isValid() const noexcept { return valid_; }
+        [[nodiscard]] int32_t sampleRate() const noexcept { return sample_rate_; }
+        [[nodiscard]] int32_t fftLength() const noexcept { return fft_len_; }
+        [[nodiscard]] int32_t windowLength() const noexcept { return window_len_; }
+        [[nodiscard]] int32_t hop() const noexcept { return hop_; }
+        [[nodiscard]] int32_t binCount() const noexcept { return bin_count_; }
+        [[nodiscard]] const float* window() const noexcept { return window_.data(); }
+        [[nodiscard]] int32_t threadCount() const noexcept { return thread_count_; }
+        [[nodiscard]] int32_t melBandCount() const noexcept { return mel_band_count_; }
+
+        [[nodiscard]] int64_t frameCount(int64_t sample_count) const noexcept;
+        [[nodiscard]] double binFreq(int32_t bin) const noexcept;
+
+        void setThreadCount(int32_t thread_count) noexcept;
+        ErrorCode setMelBands(int32_t band_count, float min_freq = 0.0f, float max_freq = 0.0f) noexcept;
+
+        ErrorCode forward(
+                const float* samples, int64_t sample_count, int64_t stride,
+                float* out_real, float* out_imag) noexcept;
+        ErrorCode inverse(
+                const float* real, const float* imag, int64_t frame_count,
+                float* out_samples, int64_t sample_count, int64_t stride) noexcept;
+
+        [[nodiscard]] ValueGridf* spectrogram(
+                const float* samples, int64_t sample_count, int64_t stride,
+                Scale scale, ErrorCode& out_err) noexcept;
+        [[nodiscard]] ValueGridf* spectrogram(
+                const Signal* signal, int32_t channel,
+                Scale scale, ErrorCode& out_err) noexcept;
+
+        [[nodiscard]] static Image* spectrogramImage(
+                const ValueGridf* grid, float min_value, float max_value, ErrorCode& out_err) noexcept;
+
+        [[nodiscard]] static double freqToMel(double freq) noexcept;
+        [[nodiscard]] static double melToFreq(double mel) noexcept;
+
+    protected:
+        [[nodiscard]] int32_t _threadCountFor(int64_t frame_count) const noexcept;
+        void _prepareFFTs(int32_t thread_count);
+        void _loadFrame(const float* samples, int64_t sample_count, int64_t stride, int64_t frame, float* out_frame) const noexcept;
+        void _buildMelBands();
+
+        static void _parallelFor(int64_t count, int32_t thread_count, const std::function<void(int32_t, int64_t, int64_t)>& func);
+
+    protected:
+        bool valid_ = false;
+        int32_t sample_rate_ = 0;
+        int32_t fft_len_ = 0;
+        int32_t window_len_ = 0;
+        int32_t hop_ = 0;
+        int32_t bin_count_ = 0;                 ///< `fft_len_ / 2 + 1`
+        DSP::WindowType window_type_ = DSP::WindowType::Hanning;
+        std::vector<float> window_;             ///< `window_len_` coefficients
+        float amplitude_scale_ = 1.0f;          ///< 2 / sum of the window, maps a bin of a sine to its amplitude
+        int32_t thread_count_ = 0;              ///< 0 for one thread per core
+
+        ObjectList<FFT*> ffts_;                 ///< One transform per thread, kept between calls
+
+        int32_t mel_band_count_ = kDefaultMelBandCount;
+        float mel_min_freq_ = 0.0f;
+        float mel_max_freq_ = 0.0f;             ///< 0 for the Nyquist frequency
+        std::vector<int32_t> mel_first_bin_;    ///< First bin of each band
+        std::vector<int32_t> mel_bin_count_;    ///< Number of bins of each band
+        std::vector<int32_t> mel_weight_offs_;  ///< Offset of the first weight of each band in `mel_weights_`
+        std::vector<float> mel_weights_;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSTFT_hpp
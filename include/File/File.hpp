@@ -46,6 +46,7 @@ namespace Grain {
         String path_;           ///< Absolute full path to the file or directory
         String name_;           ///< Name of the file or directory
         uint64_t file_size_;    ///< Size of the file in bytes (0 for directories)
+        int64_t mod_time_ = 0;  ///< Last modification time in ticks of the file system clock (0 for directories)
         bool dir_flag_;         ///< True if the entry is a directory
         bool reg_file_flag_;    ///< True if the entry is a regular file
         bool sym_link_flag_;    ///< True if the entry is a symbolic link
@@ -163,6 +163,7 @@ namespace Grain {
 
         int32_t m_sn;
         bool m_reset_flag = true;
+        bool m_start_flag = false;      ///< `nextTilePos()` returns the tile set by `setStartIndex()` first.
 
         GeoMetaTileAction m_action = nullptr;
         void* m_action_ref = nullptr;
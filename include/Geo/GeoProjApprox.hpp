@@ -0,0 +1,115 @@
+//
+//  GeoProjApprox.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainGeoProjApprox_hpp
+#define GrainGeoProjApprox_hpp
+
+#include "Geo/GeoProj.hpp"
+
+#include <atomic>
+#include <vector>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Approximate, fast transformation between two coordinate systems.
+     *
+     *  Transforming every pixel of a raster with `GeoProj::transform()`
+     *  costs one PROJ call per pixel, and many more with antialiasing. Most
+     *  projections are smooth at the scale of a few pixels, so the result can
+     *  be interpolated from a coarse grid of exact transformations.
+     *
+     *  `setup()` covers a source rectangle with a quadtree of cells. For each
+     *  cell the corners, the edge midpoints and the center are transformed
+     *  exactly, and the cell is split into four as long as bilinear
+     *  interpolation of the corners misses the exact midpoints by more than
+     *  `max_error` destination units, up to `max_depth` levels. `transform()`
+     *  then finds the cell of a position and interpolates bilinearly.
+     *
+     *  Positions outside the source rectangle, and cells where an exact
+     *  transformation failed or the error bound is still missed at
+     *  `max_depth`, use the exact transformation. A cell where no corner and
+     *  no midpoint can be transformed, e.g. outside the domain of the
+     *  projection, is not subdivided further.
+     *
+     *  The error bound is estimated from the midpoints of each cell, it is
+     *  not guaranteed for strongly non-linear projections with coarse
+     *  `max_depth`.
+     */
+    class GeoProjApprox : public Object {
+    public:
+        enum {
+            kDefaultMaxDepth = 10,
+            kMaxDepth = 20
+        };
+
+    protected:
+        struct Cell {
+            double x0_, y0_, x1_, y1_;
+            Vec2d corners_[4];              ///< Exact transformation of (x0, y0), (x1, y0), (x0, y1), (x1, y1)
+            uint8_t valid_mask_ = 0;        ///< One bit per corner, set if its transformation succeeded
+            int32_t first_child_ = -1;      ///< Index of the first of four consecutive children, -1 for leaves
+            bool exact_ = false;            ///< Leaf that could not be approximated within the error bound
+        };
+
+        GeoProj* proj_ = nullptr;
+        GeoProj::Direction direction_ = GeoProj::Direction::Forward;
+        Rectd src_rect_;
+        double max_error_ = 0.0;
+        int32_t max_depth_ = kDefaultMaxDepth;
+        std::vector<Cell> cells_;
+        mutable std::atomic<int64_t> exact_transform_count_{0};    ///< Statistics, updated by `transform()`
+        int32_t leaf_count_ = 0;
+
+    public:
+        explicit GeoProjApprox(GeoProj* proj, GeoProj::Direction direction = GeoProj::Direction::Forward) noexcept;
+        ~GeoProjApprox() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "GeoProjApprox"; }
+
+        friend std::ostream& operator << (std::ostream& os, const GeoProjApprox* o) {
+            o == nullptr ? os << "GeoProjApprox nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const GeoProjApprox& o) {
+            os << "src_rect: " << o.src_rect_ << ", max_error: " << o.max_error_;
+            os << ", cells: " << o.cells_.size() << ", leaves: " << o.leaf_count_;
+            os << ", exact transforms: " << o.exactTransformCount();
+            return os;
+        }
+
+        [[nodiscard]] bool isSetup() const noexcept { return !cells_.empty(); }
+        [[nodiscard]] const Rectd& srcRect() const noexcept { return src_rect_; }
+        [[nodiscard]] double maxError() const noexcept { return max_error_; }
+        [[nodiscard]] int32_t cellCount() const noexcept { return static_cast<int32_t>(cells_.size()); }
+        [[nodiscard]] int32_t leafCount() const noexcept { return leaf_count_; }
+        [[nodiscard]] int64_t exactTransformCount() const noexcept { return exact_transform_count_.load(std::memory_order_relaxed); }
+
+        ErrorCode setup(const Rectd& src_rect, double max_error, int32_t max_depth = kDefaultMaxDepth) noexcept;
+        void clear() noexcept;
+
+        bool transform(const Vec2d& pos, Vec2d& out_pos) const noexcept;
+
+    protected:
+        bool _exactTransform(const Vec2d& pos, Vec2d& out_pos) const noexcept;
+        void _buildCell(int32_t cell_index, int32_t depth);
+
+        static Vec2d _bilinear(const Vec2d* corners, double u, double v) noexcept {
+            return Vec2d(
+                (1.0 - v) * ((1.0 - u) * corners[0].x_ + u * corners[1].x_) + v * ((1.0 - u) * corners[2].x_ + u * corners[3].x_),
+                (1.0 - v) * ((1.0 - u) * corners[0].y_ + u * corners[1].y_) + v * ((1.0 - u) * corners[2].y_ + u * corners[3].y_));
+        }
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainGeoProjApprox_hpp
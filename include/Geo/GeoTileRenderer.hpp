@@ -32,6 +32,7 @@
 #include "Geo/GeoProj.hpp"
 #include "Geo/GeoShape.hpp"
 #include "Image/Image.hpp"
+#include "Image/ImageBufferPool.hpp"
 #include "Graphic/Font.hpp"
 #include "Graphic/GraphicContext.hpp"
 #include "File/PolygonsFile.hpp"
@@ -388,6 +389,8 @@ namespace Grain {
         Dimensioni m_render_image_size = { 0, 0 };
         int32_t m_render_halo_size = 64;            ///< Extra pixels around the image to allow effects like blurring, shadows, or glow to extend beyond the image boundaries without visual artifacts
         Image* m_render_image = nullptr;
+        GraphicContext* m_render_gc = nullptr;      ///< Context drawing into `m_render_image`, reused for all renderings
+        ImageBufferPool m_image_buffer_pool;        ///< Pixel data of render and tile images
         Image* m_render_buffers[3]{nullptr};        ///< Immediate render buffers for rendering different aspects in separate buffers, then composing them into an image
 
         Vec2d m_render_lonlat_top_left;             ///< Top left corner as long/lat
@@ -526,6 +529,7 @@ namespace Grain {
 
         void setRenderBoundsWGS84(const Vec2d& top_left, const Vec2d& bottom_right) noexcept;
         ErrorCode render() noexcept;
+        void _freeRenderImage() noexcept;
         void _updateMeterPerPixel() noexcept;
         void _renderLayers(GraphicContext* gc, RemapRectd& remap_rect);
 
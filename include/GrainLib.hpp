@@ -40,9 +40,13 @@
 #include "2d/Delaunay.hpp"
 
 #include "2d/Data/CVF2.hpp"
+#include "2d/Data/CVF2Block.hpp"
 #include "2d/Data/CVF2File.hpp"
+#include "2d/Data/CVF2PyramidBuilder.hpp"
 #include "2d/Data/CVF2TileManager.hpp"
+#include "2d/Data/TerrainAnalysis.hpp"
 #include "2d/Data/ValueGrid.hpp"
+#include "2d/Data/ValueGridTiles.hpp"
 #include "File/XYZFile.hpp"
 
 #include "3d/Cube.hpp"
@@ -63,6 +67,7 @@
 #include "Color/NamedColor.hpp"
 #include "Color/CDL.hpp"
 #include "Color/Gradient.hpp"
+#include "Color/GradientLUT.hpp"
 #include "Color/RGBLUT1.hpp"
 #include "Color/RGBRamp.hpp"
 
@@ -85,10 +90,14 @@
 #include "DSP/LinearScaler.hpp"
 #include "DSP/LUT1.hpp"
 #include "DSP/Partials.hpp"
+#include "DSP/PartialsSynth.hpp"
 #include "DSP/LevelCurve.hpp"
 #include "DSP/WeightedSamples.hpp"
 #include "DSP/RingBuffer.hpp"
+#include "DSP/SPSCRingBuffer.hpp"
 #include "DSP/EnvelopeFollower.hpp"
+#include "DSP/Resampler.hpp"
+#include "DSP/STFT.hpp"
 
 #include "File/File.hpp"
 #include "File/TiffFile.hpp"
@@ -98,6 +107,7 @@
 #include "Geo/Geo.hpp"
 #include "Geo/GeoMetaTile.hpp"
 #include "Geo/GeoProj.hpp"
+#include "Geo/GeoProjApprox.hpp"
 #include "Geo/GeoShape.hpp"
 #include "Geo/GeoShapeFile.hpp"
 #include "Geo/GeoTileRenderer.hpp"
@@ -131,6 +141,7 @@
 #include "GUI/GUIStyle.hpp"
 
 #include "Image/Image.hpp"
+#include "Image/ImageBufferPool.hpp"
 
 #include "Math/Random.hpp"
 #include "Math/Mat3.hpp"
@@ -150,6 +161,9 @@
 #include "Scripting/Toml.hpp"
 
 #include "Signal/Signal.hpp"
+#include "Signal/SignalStats.hpp"
+#include "Signal/SignalFile.hpp"
+#include "Signal/SignalGraph.hpp"
 #include "Signal/Audio.hpp"
 #include "Signal/SignalFilter.hpp"
 #include "Signal/SignalLowPassFilter.hpp"
@@ -160,8 +174,10 @@
 #include "Signal/SignalFormantFilter.hpp"
 #include "Signal/SignalIR.hpp"
 #include "Signal/SignalWave.hpp"
+#include "Signal/SignalOscillatorBank.hpp"
 
 #include "String/String.hpp"
+#include "String/StringBuilder.hpp"
 #include "String/StringList.hpp"
 #include "String/CSVString.hpp"
 #include "String/CSVData.hpp"
@@ -181,6 +197,8 @@
 #include "SVG/SVGPaintServer.hpp"
 #include "SVG/SVGPaintStyle.hpp"
 #include "SVG/SVGRootElement.hpp"
+#include "SVG/SVGDisplayList.hpp"
+#include "SVG/SVGSymbolCache.hpp"
 
 
 #include "Time/TimeMeasure.hpp"
@@ -23,6 +23,9 @@
 #include "2d/Bounds2.hpp"
 #include "String/String.hpp"
 
+#include <functional>
+#include <vector>
+
 
 namespace Grain {
 
@@ -33,6 +36,7 @@ namespace Grain {
     class GraphicContext;
     class Gradient;
     class ImageAccess;
+    class ImageBufferPool;
     class Quadrilateral;
 
     class cairo_surface_t;
@@ -72,6 +76,65 @@ namespace Grain {
             Float
         };
 
+        /**
+         *  @brief Filter kernels for `resample()`.
+         */
+        enum class ResampleFilter {
+            Area = 0,       ///< Average of the covered source area
+            Bilinear,       ///< Triangle filter, radius 1
+            CatmullRom,     ///< Cubic with B = 0, C = 0.5, radius 2
+            Mitchell,       ///< Cubic with B = C = 1/3, radius 2
+            Lanczos3        ///< Windowed sinc, radius 3
+        };
+
+        /**
+         *  @brief Trade-off between encoding speed and file size for
+         *         `PngSettings`, `JpegSettings` and `WebPSettings`.
+         */
+        enum class EncodePreset {
+            Default = 0,    ///< Balanced
+            TileSpeed,      ///< Fast encoding of many small tiles, slightly larger files
+            Smallest        ///< Smallest files, slow
+        };
+
+        /**
+         *  @brief Row filters libpng may choose from, values as in png.h.
+         */
+        enum {
+            kPngFilterNone = 0x08,
+            kPngFilterSub = 0x10,
+            kPngFilterUp = 0x20,
+            kPngFilterAvg = 0x40,
+            kPngFilterPaeth = 0x80,
+            kPngFilterAll = 0xF8
+        };
+
+        struct PngSettings {
+            int32_t compression_level_ = 6;     ///< zlib level, 0 (none) ... 9 (smallest)
+            int32_t compression_strategy_ = 0;  ///< zlib strategy, 0 default, 1 filtered, 2 Huffman only, 3 RLE
+            int32_t filters_ = kPngFilterAll;   ///< Combination of `kPngFilter...` flags
+            bool use_alpha_ = true;
+
+            [[nodiscard]] static PngSettings preset(EncodePreset preset, bool use_alpha = true) noexcept;
+        };
+
+        struct JpegSettings {
+            float quality_ = 0.9f;              ///< 0 ... 1
+            bool optimize_coding_ = false;      ///< Optimal Huffman tables, smaller and slower
+            bool progressive_ = false;
+            bool fast_dct_ = false;             ///< Integer DCT, faster and slightly less accurate
+
+            [[nodiscard]] static JpegSettings preset(EncodePreset preset, float quality) noexcept;
+        };
+
+        struct WebPSettings {
+            float quality_ = 0.9f;              ///< 0 ... 1, lossless above 0.99
+            int32_t method_ = 4;                ///< 0 (fast) ... 6 (smallest)
+            bool use_alpha_ = true;
+
+            [[nodiscard]] static WebPSettings preset(EncodePreset preset, float quality, bool use_alpha = true) noexcept;
+        };
+
         enum {
             kCFAPatternUnknown = 0,
             // Bayer pattern CFA modes
@@ -129,6 +192,7 @@ namespace Grain {
         uint32_t _m_pixel_data_step = 0;
         uint32_t _m_row_data_step = 0;
         uint64_t* _m_pixel_data = nullptr;
+        ImageBufferPool* _m_buffer_pool = nullptr;  ///< Pool the pixel data is borrowed from, nullptr for own memory
 
         // RAW meta data
         bool m_has_cam_to_xyz_matrix = false;
@@ -155,11 +219,51 @@ namespace Grain {
         CGImageRef _m_cg_image_ref = nullptr;
 #endif
 
+        /**
+         *  @brief Filter of one component plane for `_filterComponents()`.
+         *
+         *  Receives the plane as `width * height` floats and a buffer of the
+         *  same size, the result must be left in `plane`.
+         */
+        using PlaneFilter = std::function<void(float* plane, float* buffer)>;
+
+        ErrorCode _filterComponents(int32_t channel, Image* out_image, const PlaneFilter& filter) noexcept;
+
+        static int32_t _filterThreadCount(int64_t work) noexcept;
+        static void _parallelFor(int32_t n, int32_t thread_count, const std::function<void(int32_t begin, int32_t end)>& func);
+        static bool _separateKernel(const float* kernel_data, int32_t kernel_width, int32_t kernel_height, std::vector<float>& out_row, std::vector<float>& out_column) noexcept;
+        static void _convolveRows(const float* src, float* dst, int32_t width, int32_t height, const float* kernel, int32_t kernel_size, int32_t thread_count);
+        static void _convolveColumns(const float* src, float* dst, int32_t width, int32_t height, const float* kernel, int32_t kernel_size, int32_t thread_count);
+        static void _convolve2d(const float* src, float* dst, int32_t width, int32_t height, const float* kernel, int32_t kernel_width, int32_t kernel_height, int32_t thread_count);
+        static void _boxRows(const float* src, float* dst, int32_t width, int32_t height, int32_t radius, int32_t thread_count);
+        static void _boxColumns(const float* src, float* dst, int32_t width, int32_t height, int32_t radius, int32_t thread_count);
+
+        /**
+         *  @brief Weights of all output pixels along one axis for `resample()`.
+         *
+         *  Output pixel `i` is the sum of `weights_[i * tap_count_ + k]` times
+         *  source pixel `first_[i] + k`, border taps are folded into the
+         *  border pixels, so all source indices are valid.
+         */
+        struct ResampleWeights {
+            int32_t tap_count_ = 0;
+            std::vector<int32_t> first_;
+            std::vector<float> weights_;
+        };
+
+        static void _resampleWeights(int32_t src_size, int32_t dst_size, ResampleFilter filter, ResampleWeights& out_weights);
+        [[nodiscard]] static double _resampleFilterRadius(ResampleFilter filter) noexcept;
+        [[nodiscard]] static double _resampleFilterValue(ResampleFilter filter, double x) noexcept;
+
+        [[nodiscard]] bool _canEncodeRows() const noexcept;
+        void _encodeRow(int32_t y, int32_t out_component_count, bool out_16bit, uint8_t* out_row) const noexcept;
+
     public:
         Image() noexcept = default;
         explicit Image(const Image* image) noexcept;
         explicit Image(Image* image, int32_t width, int32_t height) noexcept;
         explicit Image(Color::Model color_model, int32_t width, int32_t height, PixelType pixel_type) noexcept;
+        explicit Image(ImageBufferPool* buffer_pool, Color::Model color_model, int32_t width, int32_t height, PixelType pixel_type) noexcept;
 
         ~Image() noexcept override;
 
@@ -185,20 +289,20 @@ namespace Grain {
         }
 
 
-        [[nodiscard]] static Image* createLuminaFloat(int32_t width, int32_t height) noexcept {
-            return new (std::nothrow) Image(Color::Model::Lumina, width, height, PixelType::Float);
+        [[nodiscard]] static Image* createLuminaFloat(int32_t width, int32_t height, ImageBufferPool* buffer_pool = nullptr) noexcept {
+            return new (std::nothrow) Image(buffer_pool, Color::Model::Lumina, width, height, PixelType::Float);
         }
 
-        [[nodiscard]] static Image* createLuminaAlphaFloat(int32_t width, int32_t height) noexcept {
-            return new (std::nothrow) Image(Color::Model::LuminaAlpha, width, height, PixelType::Float);
+        [[nodiscard]] static Image* createLuminaAlphaFloat(int32_t width, int32_t height, ImageBufferPool* buffer_pool = nullptr) noexcept {
+            return new (std::nothrow) Image(buffer_pool, Color::Model::LuminaAlpha, width, height, PixelType::Float);
         }
 
-        [[nodiscard]] static Image* createRGBFloat(int32_t width, int32_t height) noexcept {
-            return new (std::nothrow) Image(Color::Model::RGB, width, height, PixelType::Float);
+        [[nodiscard]] static Image* createRGBFloat(int32_t width, int32_t height, ImageBufferPool* buffer_pool = nullptr) noexcept {
+            return new (std::nothrow) Image(buffer_pool, Color::Model::RGB, width, height, PixelType::Float);
         }
 
-        [[nodiscard]] static Image* createRGBAFloat(int32_t width, int32_t height) noexcept {
-            return new (std::nothrow) Image(Color::Model::RGBA, width, height, PixelType::Float);
+        [[nodiscard]] static Image* createRGBAFloat(int32_t width, int32_t height, ImageBufferPool* buffer_pool = nullptr) noexcept {
+            return new (std::nothrow) Image(buffer_pool, Color::Model::RGBA, width, height, PixelType::Float);
         }
 
 
@@ -336,6 +440,7 @@ namespace Grain {
 
         ErrorCode drawImage(Image* image, const Rectd& rect) noexcept;
         ErrorCode drawImage(Image* image) noexcept;
+        ErrorCode compositeImage(const Image* src_image, int32_t x, int32_t y, float alpha = 1.0f) noexcept;
 
         void flipHorizontal() noexcept;
         void flipVertical() noexcept;
@@ -350,11 +455,14 @@ namespace Grain {
         ErrorCode applyFilter() noexcept;
 
         ErrorCode convolution(int32_t channel, const Dimensioni& kernel_size, const float* kernel_data, Image* out_image) noexcept;
+        ErrorCode boxBlur(int32_t channel, int32_t radius, int32_t iterations, Image* out_image) noexcept;
+        ErrorCode gaussianBlur(int32_t channel, float sigma, Image* out_image) noexcept;
         void floodFill(const Vec2i& pos, const RGB& color, Image* out_image) noexcept;
 
 
         [[nodiscard]] Image* extractRegion(const Recti& region) noexcept;
         ErrorCode downscale(Image* dst_image) noexcept;
+        ErrorCode resample(Image* out_image, ResampleFilter filter = ResampleFilter::Lanczos3, bool linear_light = false) noexcept;
 
 #if defined(__APPLE__) && defined(__MACH__)
         bool macos_buildCGImageRef() noexcept;
@@ -367,6 +475,9 @@ namespace Grain {
         ErrorCode writePng(const String& file_path, int32_t compression_level = 0, bool use_alpha = true);
         ErrorCode writeJpg(const String& file_path, float quality);
         ErrorCode writeWebP(const String& file_path, float quality, bool use_alpha);
+        ErrorCode writePng(const String& file_path, const PngSettings& settings) noexcept;
+        ErrorCode writeJpg(const String& file_path, const JpegSettings& settings) noexcept;
+        ErrorCode writeWebP(const String& file_path, const WebPSettings& settings) noexcept;
         ErrorCode writeTypedTiff(const String& file_path, Image::PixelType pixel_type, bool drop_alpha = false) noexcept;
 
         ErrorCode writeCVF2File(const String& cvf2_file_path, int32_t srid, const Bounds2Fix& bbox, LengthUnit length_unit, int32_t z_decimals, int32_t min_digits, int32_t max_digits) noexcept;
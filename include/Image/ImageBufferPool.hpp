@@ -0,0 +1,124 @@
+//
+//  ImageBufferPool.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainImageBufferPool_hpp
+#define GrainImageBufferPool_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Pool of pixel buffers for images, which are created and
+     *         destroyed at a high rate, like the images of a tile renderer.
+     *
+     *  Buffers are rounded up to size classes, four per power of two, so a
+     *  buffer wastes at most a quarter of its size. Released buffers are kept
+     *  per size class and handed out again, which avoids calls to the system
+     *  allocator and page faults for fresh memory. Free lists are split into
+     *  shards, each thread uses the shard selected by its id first and takes
+     *  buffers from other shards only if its own has none of the size class.
+     *
+     *  All methods are thread-safe. The pool must outlive all images using
+     *  it, buffers still in use when the pool is destroyed are not freed.
+     */
+    class ImageBufferPool : public Object {
+
+    public:
+        enum {
+            kAlignment = 64,                ///< Alignment of all buffers
+            kMinClassShift = 12,            ///< Smallest size class, 4 KiB
+            kMaxClassShift = 40,            ///< Larger buffers are not pooled
+            kClassCount = (kMaxClassShift - kMinClassShift) * 4 + 1,
+            kShardCount = 8
+        };
+
+        static constexpr int64_t kDefaultMaxCachedBytes = int64_t(1) << 30;
+
+        struct Stats {
+            int64_t acquire_count_ = 0;         ///< Buffers handed out
+            int64_t reuse_count_ = 0;           ///< Buffers handed out from the pool
+            int64_t alloc_count_ = 0;           ///< Buffers allocated from the system
+            int64_t free_count_ = 0;            ///< Buffers returned to the system
+            int64_t bytes_in_use_ = 0;          ///< Bytes in buffers handed out
+            int64_t bytes_cached_ = 0;          ///< Bytes in buffers kept for reuse
+            int64_t peak_bytes_in_use_ = 0;
+            int64_t peak_bytes_allocated_ = 0;  ///< Peak of bytes in use and cached
+        };
+
+    protected:
+        struct Shard {
+            std::mutex mutex_;
+            std::vector<void*> free_lists_[kClassCount];
+        };
+
+        Shard shards_[kShardCount];
+        int64_t max_cached_bytes_;
+
+        std::atomic<int64_t> acquire_count_{0};
+        std::atomic<int64_t> reuse_count_{0};
+        std::atomic<int64_t> alloc_count_{0};
+        std::atomic<int64_t> free_count_{0};
+        std::atomic<int64_t> bytes_in_use_{0};
+        std::atomic<int64_t> bytes_cached_{0};
+        std::atomic<int64_t> peak_bytes_in_use_{0};
+        std::atomic<int64_t> peak_bytes_allocated_{0};
+
+    public:
+        explicit ImageBufferPool(int64_t max_cached_bytes = kDefaultMaxCachedBytes) noexcept;
+        ~ImageBufferPool() noexcept override;
+
+        ImageBufferPool(const ImageBufferPool&) = delete;
+        ImageBufferPool& operator = (const ImageBufferPool&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "ImageBufferPool"; }
+
+        friend std::ostream& operator << (std::ostream& os, const ImageBufferPool* o) {
+            o == nullptr ? os << "ImageBufferPool nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const ImageBufferPool& o) {
+            auto stats = o.stats();
+            os << "acquired: " << stats.acquire_count_ << ", reused: " << stats.reuse_count_;
+            os << ", allocated: " << stats.alloc_count_ << ", freed: " << stats.free_count_;
+            os << ", in use: " << stats.bytes_in_use_ << " bytes, cached: " << stats.bytes_cached_ << " bytes";
+            os << ", peak: " << stats.peak_bytes_allocated_ << " bytes";
+            return os;
+        }
+
+        [[nodiscard]] void* acquire(size_t size) noexcept;
+        void release(void* ptr, size_t size) noexcept;
+
+        void trim() noexcept;
+
+        [[nodiscard]] int64_t maxCachedBytes() const noexcept { return max_cached_bytes_; }
+        void setMaxCachedBytes(int64_t max_cached_bytes) noexcept { max_cached_bytes_ = std::max<int64_t>(max_cached_bytes, 0); }
+
+        [[nodiscard]] Stats stats() const noexcept;
+        void resetPeaks() noexcept;
+
+        [[nodiscard]] static int32_t sizeClass(size_t size) noexcept;
+        [[nodiscard]] static size_t classSize(int32_t size_class) noexcept;
+
+    protected:
+        [[nodiscard]] static int32_t _shardIndex() noexcept;
+        static void _updatePeak(std::atomic<int64_t>& peak, int64_t value) noexcept;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainImageBufferPool_hpp
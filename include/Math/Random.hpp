@@ -16,28 +16,171 @@
 #include <cmath>
 #include <chrono>
 #include <numbers>
+#include <cstdint>
+#include <limits>
 
 
 namespace Grain {
 
+    /**
+     *  @class RandomEngine
+     *  @brief Fast, seedable pseudo random number generator.
+     *
+     *  Based on xoshiro256++ by David Blackman and Sebastiano Vigna. The
+     *  engine runs `kLaneCount` generators side by side, which are
+     *  `2^128` steps apart in the same sequence. One step produces one value
+     *  per lane, and the loops over the lanes can be vectorized. The values
+     *  are handed out lane by lane, so the sequence depends only on the seed
+     *  and the stream, not on how it is consumed: `fillUniform()` gives the
+     *  same values as the same number of calls to `nextFloat()`.
+     *
+     *  Streams with the same seed are `2^192` steps apart and never
+     *  overlap. Give each thread its own stream to get reproducible results
+     *  independent of scheduling:
+     *  @code
+     *  RandomEngine engine(seed, thread_index);
+     *  @endcode
+     *
+     *  The engine satisfies `std::uniform_random_bit_generator` and can be
+     *  used with the distributions of the standard library. It is not
+     *  suitable for cryptographic purposes.
+     *
+     *  `threadEngine()` is an engine per thread, seeded randomly, which is
+     *  used by `Random`.
+     */
+    class RandomEngine {
+    public:
+        using result_type = uint64_t;
+
+        enum {
+            kLaneCount = 4
+        };
+
+        static constexpr uint64_t kDefaultSeed = 0x853c49e6748fea9bULL;
+
+    public:
+        explicit RandomEngine(uint64_t seed = kDefaultSeed, uint64_t stream = 0) noexcept { this->seed(seed, stream); }
+
+        void seed(uint64_t seed, uint64_t stream = 0) noexcept;
+        [[nodiscard]] uint64_t seedValue() const noexcept { return seed_; }
+        [[nodiscard]] uint64_t stream() const noexcept { return stream_; }
+        [[nodiscard]] RandomEngine split(uint64_t stream) const noexcept { return RandomEngine(seed_, stream); }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator () () noexcept {
+            if (buffer_pos_ >= kLaneCount) {
+                _step(buffer_);
+                buffer_pos_ = 0;
+            }
+            return buffer_[buffer_pos_++];
+        }
+
+        [[nodiscard]] uint32_t nextUInt32() noexcept { return static_cast<uint32_t>((*this)() >> 32); }
+
+        /**
+         *  @brief Returns a random number in [0, 1).
+         */
+        [[nodiscard]] float nextFloat() noexcept { return _toFloat((*this)()); }
+
+        /**
+         *  @brief Returns a random number in [0, 1).
+         */
+        [[nodiscard]] double nextDouble() noexcept { return _toDouble((*this)()); }
+
+        /**
+         *  @brief Returns a random number in [-1, 1).
+         */
+        [[nodiscard]] float nextBipolar() noexcept { return _toBipolar((*this)()); }
+
+        [[nodiscard]] float nextNormal() noexcept;
+        [[nodiscard]] float nextExponential() noexcept;
+
+        void fillUInt64(uint64_t* out_values, int64_t count) noexcept;
+        void fillUniform(float* out_values, int64_t count, float min = 0.0f, float max = 1.0f) noexcept;
+        void fillBipolar(float* out_values, int64_t count, float amount = 1.0f) noexcept;
+        void fillNormal(float* out_values, int64_t count, float mean = 0.0f, float stddev = 1.0f) noexcept;
+        void fillExponential(float* out_values, int64_t count, float lambda = 1.0f) noexcept;
+
+        /**
+         *  @brief The engine of the calling thread, seeded randomly on first use.
+         */
+        static RandomEngine& threadEngine() noexcept {
+            thread_local RandomEngine engine(_randomSeed());
+            return engine;
+        }
+
+    protected:
+        [[nodiscard]] static uint64_t _randomSeed() noexcept;
+
+        /**
+         *  @brief Advance all lanes by one step.
+         */
+        void _step(uint64_t* out_values) noexcept {
+            for (int32_t k = 0; k < kLaneCount; k++) {
+                uint64_t s0 = s_[0][k], s1 = s_[1][k], s2 = s_[2][k], s3 = s_[3][k];
+                out_values[k] = _rotl(s0 + s3, 23) + s0;
+                uint64_t t = s1 << 17;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s_[0][k] = s0;
+                s_[1][k] = s1;
+                s_[2][k] = s2;
+                s_[3][k] = _rotl(s3, 45);
+            }
+        }
+
+        static constexpr uint64_t _rotl(uint64_t x, int32_t k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+        // The upper bits have the best quality
+        static constexpr float _toFloat(uint64_t v) noexcept { return static_cast<float>(v >> 40) * 0x1.0p-24f; }
+        static constexpr double _toDouble(uint64_t v) noexcept { return static_cast<double>(v >> 11) * 0x1.0p-53; }
+        static constexpr float _toBipolar(uint64_t v) noexcept { return static_cast<float>(v >> 40) * 0x1.0p-23f - 1.0f; }
+
+        template <typename Convert>
+        void _fillFloats(float* out_values, int64_t count, Convert convert) noexcept;
+
+        static void _jump(uint64_t* state, const uint64_t* polynomial) noexcept;
+
+    protected:
+        uint64_t s_[4][kLaneCount]{};           ///< State words, one column per lane
+        uint64_t buffer_[kLaneCount]{};         ///< Values of the last step
+        int32_t buffer_pos_ = kLaneCount;
+        uint64_t seed_ = 0;
+        uint64_t stream_ = 0;
+        float spare_normal_ = 0.0f;
+        bool has_spare_normal_ = false;
+    };
+
+
     /**
      *  @class Random
      *  @brief Utility class providing static methods for random number generation.
      *
-     *  This class wraps platform-specific random number generation (`arc4random`)
-     *  to provide a suite of useful random utilities for floats, integers, and
-     *  booleans.
+     *  This class uses the `RandomEngine` of the calling thread to provide a
+     *  suite of useful random utilities for floats, integers, and booleans.
+     *  It is thread-safe, and `seed()` makes the values of a thread
+     *  reproducible.
      *
      *  The methods are all `static`, so no instance of `Random` is needed.
      */
     class Random {
     public:
+        /**
+         *  @brief Seeds the engine of the calling thread.
+         */
+        static void seed(uint64_t seed, uint64_t stream = 0) noexcept { RandomEngine::threadEngine().seed(seed, stream); }
+
         /**
          *  @brief Generates a random floating-point number in [0, 1].
          *  @return Random float in range [0, 1].
          */
         [[nodiscard]] static float next() noexcept {
-            return static_cast<float>(arc4random()) * kUInt32Reciprocal;
+            return static_cast<float>(_nextUInt32()) * kUInt32Reciprocal;
         }
 
         /**
@@ -46,7 +189,7 @@ namespace Grain {
          *  @return Random float in range [0, max].
          */
         [[nodiscard]] static float next(float max) noexcept {
-            return static_cast<float>(arc4random()) * kUInt32Reciprocal * max;
+            return static_cast<float>(_nextUInt32()) * kUInt32Reciprocal * max;
         }
 
         /**
@@ -56,7 +199,7 @@ namespace Grain {
          *  @return Random float in range [min, max].
          */
         [[nodiscard]] static float next(float min, float max) noexcept {
-            return (static_cast<float>(arc4random()) * kUInt32Reciprocal) * (max - min) + min;
+            return (static_cast<float>(_nextUInt32()) * kUInt32Reciprocal) * (max - min) + min;
         }
 
         /**
@@ -64,7 +207,7 @@ namespace Grain {
          *  @return Random float in range [-1.0, 1.0].
          */
         [[nodiscard]] static float nextBipolar() noexcept {
-            return static_cast<float>(arc4random()) * kUint32Reciprocal2 - 1.0f;
+            return static_cast<float>(_nextUInt32()) * kUint32Reciprocal2 - 1.0f;
         }
 
         /**
@@ -73,12 +216,12 @@ namespace Grain {
          *  @return Random float in range [-max, max].
          */
         [[nodiscard]] static float nextBipolar(float max) noexcept {
-            return (static_cast<float>(arc4random()) * kUint32Reciprocal2 - 1.0f) * max;
+            return (static_cast<float>(_nextUInt32()) * kUint32Reciprocal2 - 1.0f) * max;
         }
 
 
         [[nodiscard]] static float nextBipolarPi() noexcept {
-            return (static_cast<float>(arc4random()) * kUint32Reciprocal2 - 1.0f) * std::numbers::pi_v<float>;
+            return (static_cast<float>(_nextUInt32()) * kUint32Reciprocal2 - 1.0f) * std::numbers::pi_v<float>;
         }
 
         /**
@@ -125,6 +268,9 @@ namespace Grain {
     public:
         static constexpr float kUInt32Reciprocal = 1.0f / static_cast<float>(std::numeric_limits<uint32_t>::max());
         static constexpr float kUint32Reciprocal2 = 2.0f / static_cast<float>(std::numeric_limits<uint32_t>::max());
+
+    protected:
+        [[nodiscard]] static uint32_t _nextUInt32() noexcept { return RandomEngine::threadEngine().nextUInt32(); }
     };
 
 
@@ -185,8 +331,8 @@ namespace Grain {
      *  @class IntRand
      *  @brief Utility class for generating random integers.
      *
-     *  This class uses a Mersenne Twister (`std::mt19937`) engine to generate
-     *  uniformly distributed random integers in a given range.
+     *  This class uses a `RandomEngine` to generate uniformly distributed
+     *  random integers in a given range.
      */
     class IntRand {
     public:
@@ -199,7 +345,7 @@ namespace Grain {
         [[nodiscard]] int32_t nextInt() { return m_distribution(m_generator); }
 
     protected:
-        std::mt19937 m_generator;
+        RandomEngine m_generator;
         std::uniform_int_distribution<int32_t> m_distribution;
         int32_t m_min = 0;
         int32_t m_max = 1000;
@@ -229,8 +375,26 @@ namespace Grain {
          */
         virtual float next() noexcept = 0;
 
+        /**
+         *  @brief Fill an array with random numbers.
+         *  @param out_values Destination for `count` values.
+         *  @param count Number of values.
+         */
+        virtual void fill(float* out_values, int64_t count) noexcept {
+            for (int64_t i = 0; i < count; i++) {
+                out_values[i] = next();
+            }
+        }
+
+        /**
+         *  @brief Seed the generator for a reproducible sequence.
+         *  @param seed Seed value.
+         *  @param stream Index of an independent stream, e.g. per thread.
+         */
+        void seed(uint64_t seed, uint64_t stream = 0) noexcept { m_generator.seed(seed, stream); }
+
     protected:
-        std::mt19937 m_generator;
+        RandomEngine m_generator;
     };
 
 
@@ -239,7 +403,7 @@ namespace Grain {
      *  @brief Uniform distribution random number generator for floats.
      *
      *  Inherits from BaseRand to provide a uniform distribution of real numbers
-     *  in a specified range using the Mersenne Twister engine.
+     *  in a specified range.
      */
     class RealRand : public BaseRand {
     public:
@@ -289,6 +453,10 @@ namespace Grain {
             return m_distribution(m_generator);
         }
 
+        void fill(float* out_values, int64_t count) noexcept override {
+            m_generator.fillUniform(out_values, count, m_min, m_max);
+        }
+
     protected:
         std::uniform_real_distribution<float> m_distribution;
         float m_min = 0.0f;
@@ -300,8 +468,8 @@ namespace Grain {
      *  @class WhiteNoiseRand
      *  @brief Generates white noise samples uniformly distributed in the range [-1, 1].
      *
-     *  Inherits from BaseRand and uses a Mersenne Twister engine with a uniform
-     *  real distribution to produce white noise values. Commonly used in audio
+     *  Inherits from BaseRand and uses a uniform real distribution to produce
+     *  white noise values. Commonly used in audio
      *  synthesis, stochastic simulations, or procedural generation.
      */
     class WhiteNoiseRand : public BaseRand {
@@ -328,6 +496,10 @@ namespace Grain {
             return static_cast<float>(m_distribution(m_generator));
         }
 
+        void fill(float* out_values, int64_t count) noexcept override {
+            m_generator.fillBipolar(out_values, count);
+        }
+
     protected:
         std::uniform_real_distribution<float> m_distribution;    ///< Uniform distribution [-1, 1]
     };
@@ -382,6 +554,10 @@ namespace Grain {
             return m_normal_dist(m_generator);
         }
 
+        void fill(float* out_values, int64_t count) noexcept override {
+            m_generator.fillNormal(out_values, count, m_mean, m_stddev);
+        }
+
         [[nodiscard]] float mean() const noexcept { return m_mean; }
         [[nodiscard]] float stddev() const noexcept { return m_stddev; }
 
@@ -13,6 +13,8 @@
 #include "String/String.hpp"
 #include "Movie/Movie.hpp"
 
+#include <vector>
+
 
 namespace Grain {
 
@@ -24,6 +26,19 @@ namespace Grain {
     typedef void (*MovieWriterFrameCallbackFunc)(MovieWriter* movie_writer, int64_t frame_index);
 
 
+    /**
+     *  @brief Pixel format of the frame buffers handed to the frame callback.
+     *
+     *  All formats are RGBA. `UInt8` and `UInt16` frames are passed to the
+     *  color conversion without any intermediate copy.
+     */
+    enum class MovieFrameFormat {
+        Float = 0,
+        UInt8,
+        UInt16
+    };
+
+
     struct MovieWriterConfig {
         int32_t width = 1920;
         int32_t height = 1080;
@@ -32,6 +47,8 @@ namespace Grain {
         int32_t video_quality = 23;
         MovieAudioCodec audio_codec = MovieAudioCodec::AAC;
         int32_t audio_bitrate = 128000;
+        MovieFrameFormat frame_format = MovieFrameFormat::Float;
+        int32_t frame_buffer_count = 3;     ///< Number of frames in the render/encode ring, at least 2
 
         AVCodecID avVideoCodecId() const {
             switch (video_codec) {
@@ -49,6 +66,19 @@ namespace Grain {
         }
     };
 
+    /**
+     *  @brief Writes a movie with audio, using FFmpeg.
+     *
+     *  Frames are rendered and encoded in a pipeline. The frame callback runs
+     *  on the calling thread and draws into `videoFrameBufferPtr()`, which
+     *  is one frame of a ring of `MovieWriterConfig::frame_buffer_count`
+     *  images. A separate encoder thread converts and encodes the filled
+     *  frames, so rendering of frame k + 1 overlaps with encoding of frame k.
+     *
+     *  The callback must only access the image returned by
+     *  `videoFrameBufferPtr()` during its call, as the same image is reused
+     *  for later frames.
+     */
     class MovieWriter {
     public:
         MovieWriter() noexcept = default;
@@ -66,8 +96,12 @@ namespace Grain {
         void* refPtr() { return ref_ptr_; }
 
     protected:
-        Image* video_frame_buffer_{};
+        Image* video_frame_buffer_{};       ///< The frame buffer of the current frame callback
+        std::vector<Image*> frame_buffers_;
         void* ref_ptr_ = nullptr;
+
+        void _freeFrameBuffers() noexcept;
+        ErrorCode _allocFrameBuffers(const MovieWriterConfig& config) noexcept;
     };
     
  } // End of namespace
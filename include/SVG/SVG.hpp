@@ -377,6 +377,9 @@ namespace Grain {
 
         void draw(GraphicContext& gc) noexcept;
 
+        const SVGRootElement* rootElement() const noexcept { return svg_root_; }
+        SVGRootElement* mutRootElement() noexcept { return svg_root_; }
+
         static const char* gradientTypeName(SVGGradientType type) noexcept;
         static const char* gradientInterpolationModeName(SVGGradientInterpolationMode mode) noexcept;
         static const char* gradientUnitsName(SVGGradientUnits units) noexcept;
@@ -0,0 +1,119 @@
+//
+//  SVGDisplayList.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>
+//
+
+#ifndef GrainSVGDisplayList_hpp
+#define GrainSVGDisplayList_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "Math/Mat3.hpp"
+#include "Color/RGBA.hpp"
+#include "Graphic/Graphic.hpp"
+#include "2d/Rect.hpp"
+
+#include <vector>
+
+
+namespace Grain {
+
+    class SVG;
+    class SVGGroupElement;
+    class SVGPaintElement;
+    class GraphicContext;
+
+
+    /**
+     *  @brief A single drawing operation of a compiled SVG.
+     *
+     *  Holds the drawable element together with its accumulated transformation
+     *  and the paint settings resolved from the element and all its ancestors.
+     */
+    struct SVGDisplayItem {
+        enum {
+            kFlag_Alpha = 0x1 << 0,
+            kFlag_FillColor = 0x1 << 1,
+            kFlag_StrokeColor = 0x1 << 2,
+            kFlag_StrokeWidth = 0x1 << 3,
+            kFlag_StrokeCap = 0x1 << 4,
+            kFlag_StrokeJoin = 0x1 << 5,
+            kFlag_StrokeMiterLimit = 0x1 << 6
+        };
+
+        SVGPaintElement* element_ = nullptr;
+        Mat3d matrix_;                      ///< Transformation relative to the SVG root, transposed for `GraphicContext::affineTransform()` once compiled
+        uint32_t flags_ = 0;                ///< Settings resolved along the element chain, see `kFlag_...`
+        float alpha_ = 1.0f;
+        RGB fill_color_;
+        RGB stroke_color_;
+        double stroke_width_ = 1.0;
+        double stroke_miter_limit_ = 10.0;
+        StrokeCapStyle stroke_cap_ = StrokeCapStyle::Butt;
+        StrokeJoinStyle stroke_join_ = StrokeJoinStyle::Miter;
+        bool does_fill_ = false;
+        bool does_stroke_ = false;
+
+        [[nodiscard]] bool hasFlag(uint32_t flag) const noexcept { return (flags_ & flag) != 0; }
+    };
+
+
+    /**
+     *  @brief Flattened, pre-resolved representation of an SVG document.
+     *
+     *  `SVG::draw()` walks the element tree on every call and re-applies the
+     *  paint style and transformations of every group and element. A display
+     *  list does this work once in `compile()` and stores a flat list of
+     *  items, each with its final transformation and paint. Drawing replays
+     *  the items with one save/restore per item.
+     *
+     *  Fill and stroke colors can be overridden while drawing, which is used
+     *  for tinting map symbols.
+     *
+     *  The display list references the elements of the SVG, so the SVG must
+     *  outlive it and must not be re-parsed while the list is in use.
+     */
+    class SVGDisplayList : public Object {
+    protected:
+        SVG* svg_ = nullptr;
+        std::vector<SVGDisplayItem> items_;
+        Rectd view_box_;
+
+    public:
+        SVGDisplayList() noexcept = default;
+        ~SVGDisplayList() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SVGDisplayList"; }
+
+        friend std::ostream& operator << (std::ostream& os, const SVGDisplayList* o) {
+            o == nullptr ? os << "SVGDisplayList nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const SVGDisplayList& o) {
+            os << "items: " << o.items_.size() << ", view box: " << o.view_box_;
+            return os;
+        }
+
+        ErrorCode compile(SVG* svg) noexcept;
+        void clear() noexcept;
+
+        [[nodiscard]] bool isCompiled() const noexcept { return svg_ != nullptr; }
+        [[nodiscard]] int32_t itemCount() const noexcept { return static_cast<int32_t>(items_.size()); }
+        [[nodiscard]] const Rectd& viewBox() const noexcept { return view_box_; }
+        [[nodiscard]] const SVG* svg() const noexcept { return svg_; }
+
+        void draw(GraphicContext& gc, const RGBA* fill_override = nullptr, const RGBA* stroke_override = nullptr) const noexcept;
+
+    protected:
+        void _compileGroup(SVGGroupElement* group, const SVGDisplayItem& state) noexcept;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSVGDisplayList_hpp
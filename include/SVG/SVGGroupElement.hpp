@@ -44,6 +44,9 @@ namespace Grain {
             }
         }
 
+        int32_t elementCount() const noexcept { return static_cast<int32_t>(elements_.size()); }
+        SVGElement* elementAtIndex(int32_t index) const noexcept { return elements_.elementAtIndex(index); }
+
         void validate() noexcept override {
             valid_ = true;
         }
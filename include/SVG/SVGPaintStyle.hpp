@@ -25,6 +25,7 @@ namespace Grain {
 
     class GraphicContext;
     class SVGElement;
+    struct SVGDisplayItem;
 
     typedef struct {
         const char* key_;
@@ -240,6 +241,7 @@ namespace Grain {
 
     public:
         void transformGC(GraphicContext& gc) const noexcept;
+        void transformMatrix(Mat3d& matrix) const noexcept;
     };
 
 
@@ -407,6 +409,7 @@ namespace Grain {
         const RGBA& strokeColor() const noexcept { return attr_stroke_.color_; }
 
         void setGCSettings(GraphicContext& gc) const noexcept;
+        void applyToDisplayItem(SVGDisplayItem& item) const noexcept;
 
         void setByXMLElement(tinyxml2::XMLElement* xml_element) noexcept;;
         void setDefault() noexcept;
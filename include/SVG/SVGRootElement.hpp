@@ -57,6 +57,7 @@ namespace Grain {
 
         void setByXMLElement(tinyxml2::XMLElement* xml_element) noexcept;
         void setViewBox(const char* str) noexcept;
+        Rectd viewBox() const noexcept;
 
         void parse(SVG* svg, tinyxml2::XMLElement* xml_element);
 
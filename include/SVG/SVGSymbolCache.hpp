@@ -0,0 +1,143 @@
+//
+//  SVGSymbolCache.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>
+//
+
+#ifndef GrainSVGSymbolCache_hpp
+#define GrainSVGSymbolCache_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "Color/RGBA.hpp"
+#include "Math/Vec2.hpp"
+#include "SVG/SVGDisplayList.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+namespace Grain {
+
+    class SVG;
+    class Image;
+
+
+    /**
+     *  @brief Cache of rasterized SVG symbols.
+     *
+     *  Map renderers often draw the same symbol thousands of times per tile at
+     *  a handful of scales and colors. The cache rasterizes each combination
+     *  of SVG, scale and color overrides once into a premultiplied RGBA float
+     *  sprite and afterwards only blits the sprite with `Image::compositeImage()`.
+     *
+     *  Each SVG is compiled into an `SVGDisplayList` on first use. Sprites are
+     *  shared as immutable images, so a sprite handed out stays valid even if
+     *  it gets evicted in the meantime. All methods are thread safe.
+     *
+     *  Rasterization runs outside the cache lock, so callers missing
+     *  different SVGs rasterize in parallel. Sprites of the same SVG are
+     *  rasterized one after the other, because drawing an SVG is not
+     *  thread safe.
+     *
+     *  The SVGs must outlive the cache, or be removed with `removeSVG()`.
+     */
+    class SVGSymbolCache : public Object {
+    public:
+        enum {
+            kDefaultCapacity = 64 * 1024 * 1024     ///< Default capacity in bytes
+        };
+
+        using Sprite = std::shared_ptr<const Image>;
+
+        struct Stats {
+            int64_t hit_count_ = 0;
+            int64_t miss_count_ = 0;
+            int64_t eviction_count_ = 0;
+            int64_t sprite_count_ = 0;
+            int64_t byte_count_ = 0;
+        };
+
+    protected:
+        struct Key {
+            const SVG* svg_ = nullptr;
+            int32_t scale_ = 0;             ///< Scale quantized to 1/1024
+            uint32_t fill_ = 0;
+            uint32_t stroke_ = 0;
+            uint8_t override_flags_ = 0;
+
+            bool operator < (const Key& other) const noexcept {
+                if (svg_ != other.svg_) { return svg_ < other.svg_; }
+                if (scale_ != other.scale_) { return scale_ < other.scale_; }
+                if (fill_ != other.fill_) { return fill_ < other.fill_; }
+                if (stroke_ != other.stroke_) { return stroke_ < other.stroke_; }
+                return override_flags_ < other.override_flags_;
+            }
+        };
+
+        struct Entry {
+            Sprite sprite_;
+            int64_t byte_count_ = 0;
+            uint64_t last_use_ = 0;
+        };
+
+        struct CompiledSVG {
+            SVGDisplayList display_list_;
+            std::mutex draw_mutex_;         ///< Serializes drawing of the SVG
+        };
+
+        mutable std::mutex mutex_;
+        std::map<const SVG*, std::shared_ptr<CompiledSVG>> display_lists_;
+        std::map<Key, Entry> entries_;
+        int64_t capacity_ = kDefaultCapacity;
+        uint64_t use_counter_ = 0;
+        Stats stats_;
+
+    public:
+        explicit SVGSymbolCache(int64_t capacity = kDefaultCapacity) noexcept;
+        ~SVGSymbolCache() noexcept override = default;
+
+        SVGSymbolCache(const SVGSymbolCache&) = delete;
+        SVGSymbolCache& operator = (const SVGSymbolCache&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SVGSymbolCache"; }
+
+        friend std::ostream& operator << (std::ostream& os, const SVGSymbolCache* o) {
+            o == nullptr ? os << "SVGSymbolCache nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const SVGSymbolCache& o) {
+            auto stats = o.stats();
+            os << "sprites: " << stats.sprite_count_ << ", bytes: " << stats.byte_count_ << " of " << o.capacity();
+            os << ", hits: " << stats.hit_count_ << ", misses: " << stats.miss_count_;
+            os << ", evictions: " << stats.eviction_count_;
+            return os;
+        }
+
+        [[nodiscard]] int64_t capacity() const noexcept;
+        void setCapacity(int64_t capacity) noexcept;
+        [[nodiscard]] Stats stats() const noexcept;
+
+        void clear() noexcept;
+        void removeSVG(const SVG* svg) noexcept;
+
+        [[nodiscard]] Sprite sprite(SVG* svg, double scale, const RGBA* fill_override = nullptr, const RGBA* stroke_override = nullptr) noexcept;
+
+        ErrorCode drawSymbol(Image* image, SVG* svg, const Vec2d& center, double scale, const RGBA* fill_override = nullptr, const RGBA* stroke_override = nullptr, float alpha = 1.0f) noexcept;
+
+    protected:
+        std::shared_ptr<CompiledSVG> _displayList(SVG* svg) noexcept;
+        void _evict(int64_t needed_byte_count) noexcept;
+
+        static Image* _rasterize(const SVGDisplayList& display_list, double scale, const RGBA* fill_override, const RGBA* stroke_override) noexcept;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSVGSymbolCache_hpp
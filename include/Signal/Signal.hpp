@@ -30,6 +30,8 @@
 #include "DSP/FFT.hpp"
 #include "Type/HiResValue.hpp"
 #include "DSP/RingBuffer.hpp"
+#include "DSP/Resampler.hpp"
+#include "Signal/SignalStats.hpp"
 
 #if defined(__APPLE__) && defined(__MACH__)
 #include <AudioToolbox/AudioToolbox.h>
@@ -189,6 +191,11 @@ namespace Grain {
      *  efficient rendering in visualizations.
      */
     class SimplifiedSignal : public Object {
+    public:
+        enum {
+            kStep = 4096        ///< Samples per value
+        };
+
     public:
         ~SimplifiedSignal() override {
             free(m_values);
@@ -279,7 +286,8 @@ namespace Grain {
         };
 
         enum {
-            kMaxChannelCount = 4096     // Maximum number of channels
+            kMaxChannelCount = 4096,            // Maximum number of channels
+            kMinSamplesPerStatsThread = 1 << 20 // Statistics of shorter ranges are computed in one thread
         };
 
     public:
@@ -417,22 +425,17 @@ namespace Grain {
         ErrorCode forEachSampleOfType(DataType data_type, SignalSampleFunc func, SignalSampleFuncInfo& info, int32_t channel, int64_t offs, int64_t len, int64_t stride) const;
 
         // Information about the signal
-        template <typename T>
-        static void _absMaxFunc(SignalSampleFuncInfo& info_ref);
+        ErrorCode stats(int32_t channel, int64_t offs, int64_t len, SignalStats& out_stats, uint32_t flags = SignalStats::kAll, int64_t stride = 1, int32_t thread_count = 0) const noexcept;
+        ErrorCode stats(const SignalRegion* region, SignalStats& out_stats, uint32_t flags = SignalStats::kAll, int32_t thread_count = 0) const noexcept;
+        ErrorCode histogram(int32_t channel, int64_t offs, int64_t len, double min_value, double max_value, int32_t bin_count, std::vector<int64_t>& out_bins, int32_t thread_count = 0) const noexcept;
+
         [[nodiscard]] double absMax(int32_t channel, int64_t offs = 0, int64_t len = -1, int64_t stride = 1) const noexcept;
         [[nodiscard]] double absMax() const noexcept;
-
-        template <typename T>
-        static void _averageFunc(SignalSampleFuncInfo& info_ref);
         [[nodiscard]] double average(int32_t channel, int64_t offs = 0, int64_t len = -1, int64_t stride = 1) const noexcept;
-
-        template <typename T>
-        static void _absAverageFunc(SignalSampleFuncInfo& info_ref);
         [[nodiscard]] double absAverage(int32_t channel, int64_t offs = 0, int64_t len = -1, int64_t stride = 1) const noexcept;
-
-        template <typename T>
-        static void _rmsFunc(SignalSampleFuncInfo& info_ref);
         [[nodiscard]] double rms(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept;
+        [[nodiscard]] int64_t zeroCrossings(int32_t channel, int64_t offs = 0, int64_t len = -1) const noexcept;
+        [[nodiscard]] double fullScaleValue() const noexcept;
 
 
         template <typename T>
@@ -557,9 +560,10 @@ namespace Grain {
 
 
 
-        ErrorCode resample(int32_t channel, int32_t sample_rate, int64_t offs, int64_t len, float* out_ptr, int64_t step = 1) noexcept;
+        [[nodiscard]] int64_t resampledLength(int32_t sample_rate, int64_t len) const noexcept;
+        ErrorCode resample(int32_t channel, int32_t sample_rate, int64_t offs, int64_t len, float* out_ptr, int64_t step = 1, Resampler::Quality quality = Resampler::Quality::High) noexcept;
 
-        ErrorCode changeSampleRate(int32_t sample_rate) noexcept;
+        ErrorCode changeSampleRate(int32_t sample_rate, Resampler::Quality quality = Resampler::Quality::High) noexcept;
 
         // Ring buffer
         [[nodiscard]] int64_t ringBufferIndex(int64_t index) const noexcept;
@@ -618,6 +622,12 @@ namespace Grain {
                 FileSampleEncoding sample_encoding,
                 int32_t region_index) const noexcept;
 
+        [[nodiscard]] static ErrorCode sndFileFormat(
+                FileContainerFormat container_format,
+                FileSampleEncoding sample_encoding,
+                DataType data_type,
+                int32_t& out_format) noexcept;
+
         [[nodiscard]] static int32_t fileInfo(const String& file_path, SignalInfo& out_info) noexcept;
 
         [[nodiscard]] static Signal* createFromFile(
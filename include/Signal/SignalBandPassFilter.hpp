@@ -39,6 +39,9 @@ public:
 
     void reset() noexcept override;
     float process(float input) noexcept override;
+    void processBlock(const float* in, float* out, int64_t n) noexcept override;
+
+    ErrorCode processInterleaved(const float* in, float* out, int64_t frame_count, int32_t channel_count) noexcept;
 
 protected:
     FilterType m_filter_type;
@@ -46,6 +49,7 @@ protected:
     double m_high_freq;
     double _m_a1, _m_b1, _m_b2;
     double _m_x1, _m_x2, _m_y1, _m_y2;
+    double _m_lane_state[4][kMaxLaneCount]{};   ///< x1, x2, y1, y2 for `processInterleaved()`
 };
 
 
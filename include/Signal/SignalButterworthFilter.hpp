@@ -50,6 +50,9 @@ namespace Grain {
 
         virtual void reset() noexcept override;
         virtual float process(float input) noexcept override;
+        virtual void processBlock(const float* in, float* out, int64_t n) noexcept override;
+
+        ErrorCode processInterleaved(const float* in, float* out, int64_t frame_count, int32_t channel_count) noexcept;
 
     protected:
         FilterType m_filter_type;
@@ -65,6 +68,7 @@ namespace Grain {
         double m_d3{};
         double m_d4{};
         double m_w[5]{};
+        double m_lane_w[5][kMaxLaneCount]{};    ///< Independent states for `processInterleaved()`
     };
 
 
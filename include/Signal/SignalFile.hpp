@@ -0,0 +1,280 @@
+//
+//  SignalFile.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainSignalFileStream_hpp
+#define GrainSignalFileStream_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "String/String.hpp"
+#include "Signal/Signal.hpp"
+#include "DSP/Resampler.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Forward declaration of the libsndfile handle
+typedef struct sf_private_tag SNDFILE;
+
+
+namespace Grain {
+
+    class SignalFilter;
+
+
+    /**
+     *  @class SignalBlock
+     *  @brief A block of consecutive frames with one contiguous float buffer
+     *         per channel.
+     */
+    class SignalBlock {
+    public:
+        void configure(int32_t channel_count, int64_t capacity);
+
+        [[nodiscard]] int32_t channelCount() const noexcept { return channel_count_; }
+        [[nodiscard]] int64_t capacity() const noexcept { return capacity_; }
+        [[nodiscard]] int64_t frameCount() const noexcept { return frame_count_; }
+        [[nodiscard]] int64_t startFrame() const noexcept { return start_frame_; }
+        [[nodiscard]] size_t byteSize() const noexcept { return data_.size() * sizeof(float); }
+
+        [[nodiscard]] const float* channelPtr(int32_t channel) const noexcept {
+            return data_.data() + static_cast<size_t>(channel) * capacity_;
+        }
+
+        [[nodiscard]] float* mutChannelPtr(int32_t channel) noexcept {
+            return data_.data() + static_cast<size_t>(channel) * capacity_;
+        }
+
+        void setFrameCount(int64_t frame_count) noexcept { frame_count_ = std::clamp<int64_t>(frame_count, 0, capacity_); }
+        void setStartFrame(int64_t start_frame) noexcept { start_frame_ = start_frame; }
+
+    protected:
+        int32_t channel_count_ = 0;
+        int64_t capacity_ = 0;          ///< Frames per channel
+        int64_t frame_count_ = 0;       ///< Valid frames
+        int64_t start_frame_ = 0;       ///< Position of the first frame in the stream
+        std::vector<float> data_;       ///< `channel_count_` buffers of `capacity_` floats
+    };
+
+
+    /**
+     *  @class SignalFileReader
+     *  @brief Reads an audio file block by block as deinterleaved float
+     *         samples, so files of any size can be processed in constant
+     *         memory.
+     *
+     *  With a read-ahead of one or more blocks, a background thread decodes
+     *  the following blocks while the caller processes the current one. The
+     *  memory used can be limited with `max_buffered_frames` in `open()`.
+     *
+     *  Usage:
+     *  @code
+     *  SignalFileReader reader;
+     *  if (reader.open(path) == ErrorCode::None) {
+     *      while (auto block = reader.nextBlock()) {
+     *          // block->channelPtr(c)[0 ... block->frameCount() - 1]
+     *      }
+     *  }
+     *  @endcode
+     */
+    class SignalFileReader : public Object {
+    public:
+        enum {
+            kDefaultBlockLength = 65536,
+            kDefaultReadAheadBlocks = 2
+        };
+
+    public:
+        SignalFileReader() noexcept = default;
+        ~SignalFileReader() noexcept override;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalFileReader"; }
+
+        ErrorCode open(const String& file_path, int64_t block_len = kDefaultBlockLength, int32_t read_ahead_blocks = kDefaultReadAheadBlocks, int64_t max_buffered_frames = 0) noexcept;
+        void close() noexcept;
+        ErrorCode rewind() noexcept;
+
+        [[nodiscard]] const SignalBlock* nextBlock() noexcept;
+
+        [[nodiscard]] bool isOpen() const noexcept { return file_ != nullptr; }
+        [[nodiscard]] int32_t channelCount() const noexcept { return channel_count_; }
+        [[nodiscard]] int32_t sampleRate() const noexcept { return sample_rate_; }
+        [[nodiscard]] int64_t frameCount() const noexcept { return frame_count_; }
+        [[nodiscard]] int64_t blockLength() const noexcept { return block_len_; }
+        [[nodiscard]] int32_t readAheadBlocks() const noexcept { return std::max(static_cast<int32_t>(slots_.size()) - 1, 0); }
+        [[nodiscard]] size_t bufferSize() const noexcept;
+        [[nodiscard]] ErrorCode lastError() const noexcept { return error_.load(); }
+
+    protected:
+        void _start();
+        void _stop() noexcept;
+        void _readLoop() noexcept;
+        int64_t _readBlock(SignalBlock& block) noexcept;
+
+    protected:
+        SNDFILE* file_ = nullptr;
+        int32_t channel_count_ = 0;
+        int32_t sample_rate_ = 0;
+        int64_t frame_count_ = 0;
+        int64_t block_len_ = 0;
+        int64_t read_pos_ = 0;              ///< Next frame to decode
+
+        std::vector<float> interleaved_;    ///< Decoding buffer, used by the reading thread only
+        std::vector<SignalBlock> slots_;    ///< Block buffers, one is held by the caller
+        std::deque<int32_t> free_slots_;
+        std::deque<int32_t> ready_slots_;   ///< Decoded blocks in file order
+        int32_t current_slot_ = -1;         ///< Slot returned by the last `nextBlock()`
+
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        bool stop_ = false;
+        bool end_reached_ = false;
+        std::atomic<ErrorCode> error_{ ErrorCode::None };  ///< Set by the reading thread
+    };
+
+
+    /**
+     *  @class SignalFileWriter
+     *  @brief Writes an audio file from blocks of deinterleaved float
+     *         samples, the counterpart of `SignalFileReader`.
+     *
+     *  With a write-behind of one or more blocks, the blocks are copied into a
+     *  queue and encoded and written by a background thread. Errors of the
+     *  background thread are reported by the following `write()` or by
+     *  `close()`. The memory used can be limited with `max_buffered_frames`
+     *  in `open()`.
+     */
+    class SignalFileWriter : public Object {
+    public:
+        enum {
+            kDefaultBlockLength = 65536,
+            kDefaultWriteBehindBlocks = 2
+        };
+
+    public:
+        SignalFileWriter() noexcept = default;
+        ~SignalFileWriter() noexcept override;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalFileWriter"; }
+
+        ErrorCode open(
+                const String& file_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding,
+                int32_t channel_count,
+                int32_t sample_rate,
+                int64_t block_len = kDefaultBlockLength,
+                int32_t write_behind_blocks = kDefaultWriteBehindBlocks,
+                int64_t max_buffered_frames = 0) noexcept;
+        ErrorCode close() noexcept;
+
+        ErrorCode write(const SignalBlock& block) noexcept;
+        ErrorCode write(const float* const* channels, int64_t frame_count) noexcept;
+
+        [[nodiscard]] bool isOpen() const noexcept { return file_ != nullptr; }
+        [[nodiscard]] int32_t channelCount() const noexcept { return channel_count_; }
+        [[nodiscard]] int32_t sampleRate() const noexcept { return sample_rate_; }
+        [[nodiscard]] int64_t framesWritten() const noexcept { return frames_written_; }
+        [[nodiscard]] int64_t blockLength() const noexcept { return block_len_; }
+        [[nodiscard]] size_t bufferSize() const noexcept;
+
+    protected:
+        void _writeLoop() noexcept;
+        ErrorCode _writeBlock(const SignalBlock& block) noexcept;
+
+    protected:
+        SNDFILE* file_ = nullptr;
+        int32_t channel_count_ = 0;
+        int32_t sample_rate_ = 0;
+        int64_t block_len_ = 0;
+        int64_t frames_written_ = 0;        ///< Frames passed to `write()`
+
+        std::vector<float> interleaved_;    ///< Encoding buffer, used by the writing thread only
+        std::vector<SignalBlock> slots_;
+        std::deque<int32_t> free_slots_;
+        std::deque<int32_t> ready_slots_;   ///< Blocks waiting to be written, in stream order
+
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        bool stop_ = false;
+        ErrorCode error_ = ErrorCode::None;
+    };
+
+
+    /**
+     *  @class SignalFileProcessor
+     *  @brief Streaming versions of whole-signal operations, which read one
+     *         file and write the result to another in constant memory.
+     *
+     *  The memory used depends on the block length and the channel count only,
+     *  not on the length of the files. With `max_buffered_frames` greater
+     *  than 0, reading, processing and writing together hold at most this
+     *  number of frames, the block length and the read-ahead are reduced as
+     *  needed.
+     */
+    class SignalFileProcessor {
+    public:
+        enum {
+            kMinBufferedFrames = 16     ///< Smallest accepted `max_buffered_frames`
+        };
+
+    public:
+        static ErrorCode normalize(
+                const String& src_path,
+                const String& dst_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding,
+                float target_level = 1.0f,
+                int64_t block_len = SignalFileReader::kDefaultBlockLength,
+                int64_t max_buffered_frames = 0) noexcept;
+
+        static ErrorCode applyFilter(
+                const String& src_path,
+                const String& dst_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding,
+                const std::vector<SignalFilter*>& filters,
+                int64_t block_len = SignalFileReader::kDefaultBlockLength,
+                int64_t max_buffered_frames = 0) noexcept;
+
+        static ErrorCode resample(
+                const String& src_path,
+                const String& dst_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding,
+                int32_t sample_rate,
+                Resampler::Quality quality = Resampler::Quality::High,
+                int64_t block_len = SignalFileReader::kDefaultBlockLength,
+                int64_t max_buffered_frames = 0) noexcept;
+
+        static ErrorCode envelope(
+                const String& src_path,
+                const String& dst_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding,
+                float attack_sec = 0.005f,
+                float release_sec = 0.05f,
+                int64_t block_len = SignalFileReader::kDefaultBlockLength,
+                int64_t max_buffered_frames = 0) noexcept;
+
+    protected:
+        static ErrorCode _splitBufferLimit(int64_t max_buffered_frames, int64_t& block_len, int64_t& out_io_max_buffered_frames) noexcept;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSignalFileStream_hpp
@@ -35,6 +35,10 @@ namespace Grain {
      *  specific frequencies or frequency ranges.
      */
     class SignalFilter : public Object {
+    public:
+        static constexpr int32_t kBlockSize = 256;  ///< Preferred block length for `processBlock()`
+        static constexpr int32_t kMaxLaneCount = 8; ///< Maximum number of channels in `processInterleaved()` of derived classes
+
     public:
         explicit SignalFilter(int32_t sample_rate) noexcept {
             setSampleRate(sample_rate);
@@ -90,6 +94,19 @@ namespace Grain {
          */
         [[nodiscard]] virtual float process(float input) noexcept { return 0; }
 
+        /**
+         *  @brief Process a block of consecutive samples through the filter.
+         *
+         *  Equivalent to calling `process()` for each sample, but without a
+         *  virtual call per sample. Derived classes override this with a
+         *  tight loop, which keeps the filter state in registers.
+         *
+         *  @param in Input samples.
+         *  @param out Output samples, may be the same as `in`.
+         *  @param n Number of samples.
+         */
+        virtual void processBlock(const float* in, float* out, int64_t n) noexcept;
+
 
         // Utilities
 
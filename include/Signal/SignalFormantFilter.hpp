@@ -51,6 +51,7 @@ public:
 
     void reset() noexcept override;
     float process(float input) noexcept override;
+    void processBlock(const float* in, float* out, int64_t n) noexcept override;
 
 
 protected:
@@ -0,0 +1,392 @@
+//
+//  SignalGraph.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainSignalGraph_hpp
+#define GrainSignalGraph_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "Type/List.hpp"
+#include "String/String.hpp"
+#include "Signal/Signal.hpp"
+#include "Signal/SignalFile.hpp"
+#include "DSP/Resampler.hpp"
+
+#include <vector>
+
+
+namespace Grain {
+
+    class SignalGraph;
+    class SignalFilter;
+    class FFT;
+
+
+    /**
+     *  @class SignalGraphNode
+     *  @brief Base class of the processing nodes of a `SignalGraph`.
+     *
+     *  A node reads one block from the outputs of its input nodes and writes
+     *  one block per channel to its own output buffer. Inputs are set on
+     *  construction, so a graph is acyclic by design.
+     *
+     *  If an input has fewer channels than the node, its channels are repeated,
+     *  e.g. a mono input feeds all channels of a stereo node.
+     *
+     *  `latency()` is the delay in samples the node adds to its input. The
+     *  graph delays inputs with a lower latency than others, so all inputs
+     *  of a node are aligned, and sinks drop the leading samples.
+     */
+    class SignalGraphNode : public Object {
+        friend class SignalGraph;
+
+    public:
+        explicit SignalGraphNode(int32_t channel_count) noexcept;
+        ~SignalGraphNode() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphNode"; }
+
+        [[nodiscard]] int32_t channelCount() const noexcept { return channel_count_; }
+        [[nodiscard]] int32_t inputCount() const noexcept { return static_cast<int32_t>(inputs_.size()); }
+        [[nodiscard]] SignalGraphNode* inputPtr(int32_t index) const noexcept {
+            return index >= 0 && index < inputCount() ? inputs_[index] : nullptr;
+        }
+
+        [[nodiscard]] virtual int32_t latency() const noexcept { return 0; }
+        [[nodiscard]] int32_t pathLatency() const noexcept { return path_latency_; }
+
+        [[nodiscard]] const float* outputPtr(int32_t channel) const noexcept {
+            return output_.data() + static_cast<size_t>(channel) * block_len_;
+        }
+
+        [[nodiscard]] ErrorCode lastError() const noexcept { return error_; }
+
+    protected:
+        void _addInput(SignalGraphNode* node) noexcept;
+
+        virtual ErrorCode _prepare([[maybe_unused]] int64_t frame_count) noexcept { return ErrorCode::None; }
+        virtual void _process(int64_t frame) noexcept = 0;
+        virtual ErrorCode _finish() noexcept { return ErrorCode::None; }
+
+        [[nodiscard]] const float* _inputChannelPtr(int32_t input_index, int32_t channel) const noexcept;
+        [[nodiscard]] float* _mutOutputPtr(int32_t channel) noexcept {
+            return output_.data() + static_cast<size_t>(channel) * block_len_;
+        }
+
+        void _configure(int32_t sample_rate, int32_t block_len);
+        void _alignInputs() noexcept;
+
+    protected:
+        int32_t channel_count_ = 0;
+        std::vector<SignalGraphNode*> inputs_;
+        std::vector<int32_t> input_delays_;             ///< Alignment delay of each input in samples
+        std::vector<std::vector<float>> delay_lines_;   ///< Per input, one buffer of delay + block length per input channel
+        std::vector<float> output_;                     ///< `channel_count_` buffers of `block_len_` samples
+
+        SignalGraph* graph_ = nullptr;
+        int32_t sample_rate_ = 0;
+        int32_t block_len_ = 0;
+        int32_t path_latency_ = 0;                      ///< Latency from the sources to the output of this node
+        int32_t level_ = 0;                             ///< Longest distance from a source
+        ErrorCode error_ = ErrorCode::None;
+    };
+
+
+    /**
+     *  @class SignalGraphSource
+     *  @brief Reads the channels of a `Signal`, samples after the end are
+     *         zero.
+     *
+     *  If the sample rate of the signal differs from the sample rate of the
+     *  graph, the samples are converted with a streaming `Resampler`. The
+     *  signal is not owned and must not change while rendering.
+     */
+    class SignalGraphSource : public SignalGraphNode {
+    public:
+        explicit SignalGraphSource(const Signal* signal, Resampler::Quality quality = Resampler::Quality::High) noexcept;
+        ~SignalGraphSource() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphSource"; }
+
+        [[nodiscard]] const Signal* signal() const noexcept { return signal_; }
+
+    protected:
+        ErrorCode _prepare(int64_t frame_count) noexcept override;
+        void _process(int64_t frame) noexcept override;
+        void _read(int32_t channel, int64_t pos, int64_t len, float* out) const noexcept;
+
+    protected:
+        const Signal* signal_ = nullptr;
+        Resampler::Quality quality_;
+        ObjectList<Resampler*> resamplers_;     ///< One per channel, if the sample rates differ
+        std::vector<float> read_buffer_;
+        std::vector<float> pending_;            ///< Resampled samples per channel, not yet delivered
+        std::vector<int64_t> pending_len_;
+        std::vector<int64_t> read_pos_;         ///< Next sample to read from the signal, per channel
+        int64_t pending_capacity_ = 0;
+    };
+
+
+    /**
+     *  @class SignalGraphFilter
+     *  @brief Applies one `SignalFilter` per channel, e.g. a
+     *         `SignalButterworthFilter` or an `EnvelopeFollower`.
+     *
+     *  The filters are not owned, they must be set up for the sample rate of
+     *  the graph and must outlive it. The filters of this library process
+     *  without delay, so the node adds no latency.
+     */
+    class SignalGraphFilter : public SignalGraphNode {
+    public:
+        SignalGraphFilter(SignalGraphNode* input, const std::vector<SignalFilter*>& filters) noexcept;
+        ~SignalGraphFilter() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphFilter"; }
+
+    protected:
+        ErrorCode _prepare(int64_t frame_count) noexcept override;
+        void _process(int64_t frame) noexcept override;
+
+    protected:
+        std::vector<SignalFilter*> filters_;
+    };
+
+
+    /**
+     *  @class SignalGraphGain
+     *  @brief Multiplies each channel with a gain factor.
+     */
+    class SignalGraphGain : public SignalGraphNode {
+    public:
+        SignalGraphGain(SignalGraphNode* input, float gain) noexcept;
+        ~SignalGraphGain() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphGain"; }
+
+        void setGain(float gain) noexcept { std::fill(gains_.begin(), gains_.end(), gain); }
+        void setChannelGain(int32_t channel, float gain) noexcept;
+
+    protected:
+        void _process(int64_t frame) noexcept override;
+
+    protected:
+        std::vector<float> gains_;
+    };
+
+
+    /**
+     *  @class SignalGraphMixer
+     *  @brief Sums its inputs, each multiplied with a gain factor.
+     */
+    class SignalGraphMixer : public SignalGraphNode {
+    public:
+        SignalGraphMixer(const std::vector<SignalGraphNode*>& inputs, int32_t channel_count = 0) noexcept;
+        ~SignalGraphMixer() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphMixer"; }
+
+        void setInputGain(int32_t input_index, float gain) noexcept;
+
+    protected:
+        void _process(int64_t frame) noexcept override;
+
+    protected:
+        std::vector<float> gains_;
+    };
+
+
+    /**
+     *  @class SignalGraphConvolver
+     *  @brief Convolves each channel with an impulse response.
+     *
+     *  Uses uniformly partitioned convolution in the frequency domain. The
+     *  impulse response is split into partitions of one block, the spectra of
+     *  the past input blocks are kept in a delay line, so there is no latency
+     *  and the cost per block grows linearly with the length of the impulse
+     *  response. Channel `c` uses channel `c % ir channel count` of the
+     *  impulse response.
+     */
+    class SignalGraphConvolver : public SignalGraphNode {
+    public:
+        SignalGraphConvolver(SignalGraphNode* input, const Signal* ir, int64_t ir_offs = 0, int64_t ir_len = -1) noexcept;
+        ~SignalGraphConvolver() noexcept override;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphConvolver"; }
+
+    protected:
+        ErrorCode _prepare(int64_t frame_count) noexcept override;
+        void _process(int64_t frame) noexcept override;
+
+    protected:
+        const Signal* ir_ = nullptr;
+        int64_t ir_offs_ = 0;
+        int64_t ir_len_ = -1;
+
+        FFT* fft_ = nullptr;
+        int32_t bin_count_ = 0;                 ///< `block_len_ + 1`
+        int32_t partition_count_ = 0;
+        int32_t ir_channel_count_ = 0;
+        int32_t head_ = 0;                      ///< Partition of the newest input block in the delay line
+        std::vector<float> ir_real_;            ///< Spectra, partitions of each impulse response channel
+        std::vector<float> ir_imag_;
+        std::vector<float> fdl_real_;           ///< Spectra of the past input blocks, partitions of each channel
+        std::vector<float> fdl_imag_;
+        std::vector<float> frames_;             ///< Previous and current input block of each channel
+        std::vector<float> acc_real_;
+        std::vector<float> acc_imag_;
+        std::vector<float> time_buffer_;
+    };
+
+
+    /**
+     *  @class SignalGraphSink
+     *  @brief Writes its input to a `Signal`, starting at `offs`.
+     *
+     *  The signal is grown if needed. Integer signals are converted sample by
+     *  sample, float signals are written directly.
+     */
+    class SignalGraphSink : public SignalGraphNode {
+    public:
+        SignalGraphSink(SignalGraphNode* input, Signal* signal, int64_t offs = 0) noexcept;
+        ~SignalGraphSink() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphSink"; }
+
+    protected:
+        ErrorCode _prepare(int64_t frame_count) noexcept override;
+        void _process(int64_t frame) noexcept override;
+
+    protected:
+        Signal* signal_ = nullptr;
+        int64_t offs_ = 0;
+        int64_t frame_count_ = 0;
+    };
+
+
+    /**
+     *  @class SignalGraphFileSink
+     *  @brief Writes its input to an audio file with a `SignalFileWriter`.
+     */
+    class SignalGraphFileSink : public SignalGraphNode {
+    public:
+        SignalGraphFileSink(
+                SignalGraphNode* input,
+                const String& file_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding) noexcept;
+        ~SignalGraphFileSink() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraphFileSink"; }
+
+    protected:
+        ErrorCode _prepare(int64_t frame_count) noexcept override;
+        void _process(int64_t frame) noexcept override;
+        ErrorCode _finish() noexcept override;
+
+    protected:
+        String file_path_;
+        Signal::FileContainerFormat container_format_;
+        Signal::FileSampleEncoding sample_encoding_;
+        SignalFileWriter writer_;
+        std::vector<const float*> channel_ptrs_;
+        int64_t frame_count_ = 0;
+    };
+
+
+    /**
+     *  @class SignalGraph
+     *  @brief Offline processing graph, which renders chains of filters,
+     *         gains, convolutions and mixers block by block.
+     *
+     *  Nodes are added with `addNode()` or one of the `add...()` methods, the
+     *  graph takes ownership. No intermediate `Signal` is created, every node
+     *  keeps one block per channel, so the memory does not depend on the
+     *  length of the rendered signals.
+     *
+     *  Nodes are grouped in levels by their distance from the sources. Nodes
+     *  of the same level are independent of each other and are processed in
+     *  parallel, threads synchronize once per level and block. Several sinks
+     *  can be rendered in one pass, e.g. a batch of stems.
+     *
+     *  Usage:
+     *  @code
+     *  SignalGraph graph(48000);
+     *  auto src = graph.addSource(signal);
+     *  auto reverb = graph.addConvolver(src, ir);
+     *  auto mix = graph.addMixer({ src, reverb });
+     *  graph.addFileSink(mix, path, Signal::FileContainerFormat::WAV, Signal::FileSampleEncoding::Float);
+     *  graph.render(signal->sampleCount());
+     *  @endcode
+     */
+    class SignalGraph : public Object {
+    public:
+        enum {
+            kDefaultBlockLength = 4096,
+            kMinLogBlockLength = 6,
+            kMaxLogBlockLength = 16
+        };
+
+    public:
+        explicit SignalGraph(int32_t sample_rate, int32_t block_len = kDefaultBlockLength) noexcept;
+        ~SignalGraph() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalGraph"; }
+
+        friend std::ostream& operator << (std::ostream& os, const SignalGraph* o) {
+            o == nullptr ? os << "SignalGraph nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const SignalGraph& o) {
+            os << "nodes: " << o.nodes_.size() << ", levels: " << o.levels_.size();
+            os << ", block length: " << o.block_len_ << ", sample rate: " << o.sample_rate_;
+            return os;
+        }
+
+        [[nodiscard]] int32_t sampleRate() const noexcept { return sample_rate_; }
+        [[nodiscard]] int32_t blockLength() const noexcept { return block_len_; }
+        [[nodiscard]] int32_t nodeCount() const noexcept { return static_cast<int32_t>(nodes_.size()); }
+        [[nodiscard]] int32_t threadCount() const noexcept { return thread_count_; }
+        [[nodiscard]] int32_t latency() const noexcept { return latency_; }
+
+        void setThreadCount(int32_t thread_count) noexcept { thread_count_ = std::max(thread_count, 0); }
+
+        SignalGraphNode* addNode(SignalGraphNode* node) noexcept;
+
+        SignalGraphSource* addSource(const Signal* signal, Resampler::Quality quality = Resampler::Quality::High) noexcept;
+        SignalGraphFilter* addFilter(SignalGraphNode* input, const std::vector<SignalFilter*>& filters) noexcept;
+        SignalGraphGain* addGain(SignalGraphNode* input, float gain) noexcept;
+        SignalGraphMixer* addMixer(const std::vector<SignalGraphNode*>& inputs, int32_t channel_count = 0) noexcept;
+        SignalGraphConvolver* addConvolver(SignalGraphNode* input, const Signal* ir, int64_t ir_offs = 0, int64_t ir_len = -1) noexcept;
+        SignalGraphSink* addSink(SignalGraphNode* input, Signal* signal, int64_t offs = 0) noexcept;
+        SignalGraphFileSink* addFileSink(
+                SignalGraphNode* input,
+                const String& file_path,
+                Signal::FileContainerFormat container_format,
+                Signal::FileSampleEncoding sample_encoding) noexcept;
+
+        ErrorCode render(int64_t frame_count) noexcept;
+
+    protected:
+        void _prepare();
+        [[nodiscard]] int32_t _threadCount() const noexcept;
+
+    protected:
+        int32_t sample_rate_ = 0;
+        int32_t block_len_ = 0;
+        int32_t thread_count_ = 0;              ///< 0 for one thread per core
+        int32_t latency_ = 0;                   ///< Largest path latency of all nodes
+        ObjectList<SignalGraphNode*> nodes_;    ///< In order of addition, which is a topological order
+        std::vector<std::vector<SignalGraphNode*>> levels_;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSignalGraph_hpp
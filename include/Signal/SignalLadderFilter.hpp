@@ -27,6 +27,7 @@ namespace Grain {
 
         void reset() noexcept override;
         float process(float input) noexcept override;
+        void processBlock(const float* in, float* out, int64_t n) noexcept override;
 
     protected:
         double m_freq = 8000.0;     ///< Cutoff frequency in Hz
@@ -27,6 +27,9 @@ namespace Grain {
 
         void reset() noexcept override;
         float process(float input) noexcept override;
+        void processBlock(const float* in, float* out, int64_t n) noexcept override;
+
+        ErrorCode processInterleaved(const float* in, float* out, int64_t frame_count, int32_t channel_count) noexcept;
 
     protected:
         double m_freq = 8000.0;	       ///< Cutoff frequency in Hz
@@ -36,6 +39,8 @@ namespace Grain {
         double _m_delay[4]{};
         double _m_p{};
         double _m_k{};
+        double _m_lane_stage[4][kMaxLaneCount]{};   ///< Independent states for `processInterleaved()`
+        double _m_lane_delay[4][kMaxLaneCount]{};
     };
 
 
@@ -0,0 +1,104 @@
+//
+//  SignalOscillatorBank.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainSignalOscillatorBank_hpp
+#define GrainSignalOscillatorBank_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+
+#include <vector>
+
+
+namespace Grain {
+
+    class SignalWave;
+
+
+    /**
+     *  @class SignalOscillatorBank
+     *  @brief Renders many wavetable oscillators into blocks of samples.
+     *
+     *  The tables are copied from a `SignalWave` on construction, one level per
+     *  pitch which holds a table. Use `SignalWave::buildMipLevels()` first to
+     *  get band-limited levels. Each voice crossfades between the two levels
+     *  around its pitch, like `SignalWave::lookup()`.
+     *
+     *  Voices are processed in groups of `kLaneCount`, with the state of a
+     *  group held in local arrays while its samples are rendered. Phases are
+     *  32 bit fixed point values, which wrap around at the end of the cycle
+     *  without a branch.
+     *
+     *  Frequency and amplitude changes requested by `rampVoice()` are applied
+     *  linearly over the next call to `render()`, which avoids clicks.
+     */
+    class SignalOscillatorBank : public Object {
+    public:
+        enum {
+            kLaneCount = 8
+        };
+
+    public:
+        SignalOscillatorBank(const SignalWave* wave, int32_t sample_rate) noexcept;
+        ~SignalOscillatorBank() noexcept override = default;
+
+        [[nodiscard]] const char* className() const noexcept override { return "SignalOscillatorBank"; }
+
+        friend std::ostream& operator << (std::ostream& os, const SignalOscillatorBank* o) {
+            o == nullptr ? os << "SignalOscillatorBank nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const SignalOscillatorBank& o) {
+            os << "voices: " << o.voice_count_ << ", levels: " << o.level_pitches_.size();
+            os << ", resolution: " << o.resolution_ << ", sample rate: " << o.sample_rate_;
+            return os;
+        }
+
+        [[nodiscard]] bool isValid() const noexcept { return !level_pitches_.empty(); }
+        [[nodiscard]] int32_t sampleRate() const noexcept { return sample_rate_; }
+        [[nodiscard]] int32_t resolution() const noexcept { return resolution_; }
+        [[nodiscard]] int32_t levelCount() const noexcept { return static_cast<int32_t>(level_pitches_.size()); }
+        [[nodiscard]] int32_t voiceCount() const noexcept { return voice_count_; }
+
+        ErrorCode setVoiceCount(int32_t voice_count) noexcept;
+
+        void setVoice(int32_t voice, float freq, float amplitude, float phase = 0.0f) noexcept;
+        void rampVoice(int32_t voice, float freq, float amplitude) noexcept;
+        void silenceAll() noexcept;
+
+        [[nodiscard]] float voiceFreq(int32_t voice) const noexcept;
+        [[nodiscard]] float voiceAmplitude(int32_t voice) const noexcept;
+
+        void render(float* out_samples, int32_t frame_count, bool add = false) noexcept;
+
+    protected:
+        [[nodiscard]] uint32_t _phaseIncForFreq(float freq) const noexcept;
+        [[nodiscard]] float _freqForPhaseInc(uint32_t inc) const noexcept;
+        void _levelForFreq(float freq, int32_t& out_level, float& out_weight) const noexcept;
+
+    protected:
+        int32_t sample_rate_ = 0;
+        int32_t resolution_ = 0;
+        int32_t log2_resolution_ = 0;
+        std::vector<float> tables_;             ///< All levels, `resolution_ + 1` samples each, the last repeats the first
+        std::vector<int32_t> level_pitches_;    ///< Pitch of each level, ascending
+
+        int32_t voice_count_ = 0;
+        std::vector<uint32_t> phase_;           ///< Fixed point, 2^32 is one cycle
+        std::vector<uint32_t> inc_;
+        std::vector<uint32_t> target_inc_;
+        std::vector<float> amp_;
+        std::vector<float> target_amp_;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSignalOscillatorBank_hpp
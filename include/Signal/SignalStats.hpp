@@ -0,0 +1,118 @@
+//
+//  SignalStats.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainSignalStats_hpp
+#define GrainSignalStats_hpp
+
+#include "Grain.hpp"
+
+#include <cmath>
+#include <limits>
+
+
+namespace Grain {
+
+    /**
+     *  @class SignalStats
+     *  @brief Statistics of a range of samples, computed in a single pass.
+     *
+     *  `accumulate()` is a typed reduction over a strided sample buffer. It
+     *  works on blocks of `kBlockLength` samples with independent partial
+     *  accumulators, which lets the compiler vectorize the loops. Min and max
+     *  are reduced by value first, the block is only scanned for the index if
+     *  it holds a new extreme.
+     *
+     *  Results of consecutive ranges can be combined with `merge()`, so long
+     *  signals can be split across threads. Values are in the units of the
+     *  sample data type, e.g. 32767 is the full scale of Int16 data.
+     *
+     *  Zero crossings are sign changes between consecutive samples, zero is
+     *  counted as positive.
+     */
+    class SignalStats {
+    public:
+        enum {
+            kSum = 0x1,
+            kAbsSum = 0x2,
+            kSquareSum = 0x4,
+            kMinMax = 0x8,
+            kZeroCrossings = 0x10,
+            kAll = 0x1F
+        };
+
+        enum {
+            kBlockLength = 4096,
+            kLaneCount = 8
+        };
+
+    public:
+        SignalStats() noexcept = default;
+
+        friend std::ostream& operator << (std::ostream& os, const SignalStats& o) {
+            os << "count: " << o.count_ << ", average: " << o.average() << ", rms: " << o.rms();
+            os << ", min: " << o.min_ << " at " << o.min_index_;
+            os << ", max: " << o.max_ << " at " << o.max_index_;
+            os << ", zero crossings: " << o.zero_crossings_;
+            return os;
+        }
+
+        void reset() noexcept { *this = SignalStats(); }
+
+        template <typename T>
+        void accumulate(const T* samples, int64_t count, int64_t step, int64_t first_index, uint32_t flags = kAll) noexcept;
+
+        void merge(const SignalStats& other, bool adjacent = true) noexcept;
+        void mapIndices(int64_t offs, int64_t stride) noexcept;
+
+        template <typename T>
+        static void histogram(
+                const T* samples, int64_t count, int64_t step,
+                double min_value, double max_value, int32_t bin_count, int64_t* out_bins) noexcept;
+
+        [[nodiscard]] int64_t count() const noexcept { return count_; }
+        [[nodiscard]] double sum() const noexcept { return sum_; }
+        [[nodiscard]] double absSum() const noexcept { return abs_sum_; }
+        [[nodiscard]] double squareSum() const noexcept { return square_sum_; }
+
+        [[nodiscard]] double average() const noexcept { return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0; }
+        [[nodiscard]] double dcOffset() const noexcept { return average(); }
+        [[nodiscard]] double absAverage() const noexcept { return count_ > 0 ? abs_sum_ / static_cast<double>(count_) : 0.0; }
+        [[nodiscard]] double rms() const noexcept { return count_ > 0 ? std::sqrt(square_sum_ / static_cast<double>(count_)) : 0.0; }
+
+        [[nodiscard]] double min() const noexcept { return min_; }
+        [[nodiscard]] double max() const noexcept { return max_; }
+        [[nodiscard]] int64_t minIndex() const noexcept { return min_index_; }
+        [[nodiscard]] int64_t maxIndex() const noexcept { return max_index_; }
+        [[nodiscard]] double absMax() const noexcept { return std::max(std::fabs(min_), std::fabs(max_)); }
+        [[nodiscard]] int64_t absMaxIndex() const noexcept { return std::fabs(min_) > std::fabs(max_) ? min_index_ : max_index_; }
+
+        [[nodiscard]] int64_t zeroCrossings() const noexcept { return zero_crossings_; }
+
+    protected:
+        template <typename T, bool kUnitStep>
+        void _accumulate(const T* samples, int64_t count, int64_t step, int64_t first_index, uint32_t flags) noexcept;
+
+    protected:
+        int64_t count_ = 0;
+        double sum_ = 0.0;
+        double abs_sum_ = 0.0;
+        double square_sum_ = 0.0;
+        double min_ = 0.0;
+        double max_ = 0.0;
+        int64_t min_index_ = -1;            ///< Index of the first sample with the min value
+        int64_t max_index_ = -1;            ///< Index of the first sample with the max value
+        int64_t zero_crossings_ = 0;
+        bool first_negative_ = false;       ///< Sign of the first sample, used by `merge()`
+        bool last_negative_ = false;        ///< Sign of the last sample
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainSignalStats_hpp
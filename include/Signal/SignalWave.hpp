@@ -67,6 +67,11 @@ namespace Grain {
             kErrUnsupportedPitch,
             kErrNoFFTInstance,
             kErrNoPartialsInstance,
+            kErrResolutionNotPowerOfTwo
+        };
+
+        enum {
+            kDefaultMipPitchStep = 12   ///< One band-limited table per octave
         };
 
     public:
@@ -115,6 +120,7 @@ namespace Grain {
 
         ErrorCode highVersion(int32_t pitch, int32_t src_pitch) noexcept;
         ErrorCode highVersions(int32_t src_pitch, int32_t last_pitch, int32_t pitch_step) noexcept;
+        ErrorCode buildMipLevels(int32_t src_pitch, int32_t pitch_step = kDefaultMipPitchStep) noexcept;
 
         bool finalize() noexcept;
 
@@ -61,6 +61,9 @@ namespace Grain {
      *  @class String
      *  @brief String representation in UTF-8 format, with dynamic memory handling.
      *
+     *  Short strings are stored in an inline buffer of `kLocalBufferSize` bytes.
+     *  Longer strings are moved to heap memory, which grows geometrically.
+     *
      *  A character refers to one variable length encoded UTF-8 character.
      *
      *  A character index refers to a position within the string in terms of characters, not memory addresses.
@@ -78,6 +81,8 @@ namespace Grain {
             kMaxUtf8SeqLength = 4,
             kUtf8SeqBufferSize = 5, ///< UTF-8 sequence plut EOS
             kDefaultByteCapacity = 32,
+            kLocalBufferSize = 40,      ///< Strings up to `kLocalBufferSize - 1` bytes are stored inline, without heap memory
+            kNumberStrBufferSize = 336, ///< Buffer size needed by `formatInt64()`, `formatUInt64()` and `formatDouble()`
             kMaxCharIndex = std::numeric_limits<int64_t>::max() / 5
         };
 
@@ -101,12 +106,12 @@ namespace Grain {
         static constexpr char EOS = '\0';
 
     protected:
-        char* data_ = nullptr;          ///< UTF-8 encoded string data
+        char* data_ = local_data_;      ///< UTF-8 encoded string data, `local_data_` or heap memory
         int64_t character_len_ = 0;     ///< Number of Unicode characters in `data_`
         int64_t byte_len_ = 0;          ///< Number of bytes in `data_`
-        int64_t byte_capacity_ = 32;    ///< Number of possible bytes with the currently allocated memory
-        int64_t extra_grow_bytes_ = 32; ///< When buffer must grow, than grow with this amount of extra bytes
+        int64_t byte_capacity_ = kLocalBufferSize - 1;  ///< Number of possible bytes with the current memory, without EOS
         int32_t grow_count_ = 0;        ///< How often the memory buffer has grown
+        char local_data_[kLocalBufferSize]{};   ///< Inline storage for short strings
 
         static const char* g_empty_data;    ///< Empty string with zero length
         static const String g_empty_string;
@@ -120,6 +125,7 @@ namespace Grain {
         String(const char* str) noexcept;
         explicit String(const char* str, int64_t max_byte_length) noexcept;
         String(const String& string) noexcept;
+        String(String&& string) noexcept;
         explicit String(const String* string) noexcept;
         explicit String(const String& string, int64_t character_index, int64_t character_length) noexcept;
 
@@ -143,6 +149,7 @@ namespace Grain {
         String& operator = (char c);
         String& operator = (const char* str);
         String& operator = (const String& other);
+        String& operator = (String&& other) noexcept;
         String& operator = (const String* other);
         String& operator = (int8_t value);
         String& operator = (int16_t value);
@@ -197,6 +204,8 @@ namespace Grain {
         [[nodiscard]] int64_t byteLength() const noexcept;
         [[nodiscard]] char* mutDataPtr() noexcept;
         [[nodiscard]] const char* utf8() const noexcept;
+        [[nodiscard]] int64_t byteCapacity() const noexcept { return byte_capacity_; }
+        [[nodiscard]] bool usesLocalBuffer() const noexcept { return data_ == local_data_; }
 
 
         [[nodiscard]] bool isValidUtf8(int64_t* out_byte_index = nullptr) const noexcept;
@@ -218,6 +227,7 @@ namespace Grain {
 
         [[nodiscard]] static int32_t utf8SeqLengthByStartByte(uint8_t start_byte) noexcept;
         [[nodiscard]] static int64_t utf8Length(const char* str) noexcept;
+        [[nodiscard]] static int64_t utf8Length(const char* str, int64_t byte_length) noexcept;
 
         [[nodiscard]] static uint32_t unicodeFromUtf8(const char* str) noexcept;
         [[nodiscard]] static bool unicodeIsWordCharacter(uint32_t unicode) noexcept;
@@ -372,6 +382,9 @@ namespace Grain {
         [[nodiscard]] double shannonEntropy(bool bits_mode = false) const noexcept;
 
         [[nodiscard]] static int64_t itoa(int64_t value, char* buffer, int32_t radix) noexcept;
+        static int32_t formatInt64(int64_t value, char* out_str) noexcept;
+        static int32_t formatUInt64(uint64_t value, char* out_str) noexcept;
+        static int32_t formatDouble(double value, int32_t precision, char* out_str) noexcept;
 
         [[nodiscard]] static inline bool isAlpha(char c);
         [[nodiscard]] static inline bool isDigit(char c);
@@ -488,6 +501,8 @@ namespace Grain {
 
     private:
         bool _checkExtraCapacity(int64_t needed) noexcept;
+        bool _appendAscii(const char* str, int64_t byte_length) noexcept;
+        void _freeData() noexcept;
         void _removeData(int64_t byte_index, int64_t byty_length, int64_t character_length) noexcept;
     };
 
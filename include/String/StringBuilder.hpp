@@ -0,0 +1,195 @@
+//
+//  StringBuilder.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainStringBuilder_hpp
+#define GrainStringBuilder_hpp
+
+#include "Grain.hpp"
+#include "Type/Object.hpp"
+#include "String/String.hpp"
+
+#include <vector>
+
+
+namespace Grain {
+
+    /**
+     *  @class StringArena
+     *  @brief Bump allocator for the buffers of `StringBuilder`.
+     *
+     *  Memory is taken from large blocks, which are kept for reuse. When the
+     *  last builder using the arena is destroyed, all memory of the arena is
+     *  free again, without any call to `free()`. Builders created and destroyed
+     *  in a loop therefore allocate no heap memory after the first iterations.
+     *
+     *  Allocation sizes are rounded up to powers of two. Memory given back
+     *  out of order, e.g. while a long-lived builder keeps the arena in use,
+     *  is kept in a free list per size and reused by the next allocation of
+     *  that size. The arena then grows only with the largest number of
+     *  buffers in use at the same time, not with the number of builders
+     *  created. It shrinks only when the last builder detaches.
+     *
+     *  An arena is not thread-safe, `threadArena()` returns a separate arena
+     *  for every thread.
+     */
+    class StringArena : public Object {
+    public:
+        enum {
+            kDefaultBlockSize = 64 * 1024,
+            kMinAllocationSize = 16,
+            kSizeClassCount = 48        ///< Allocation sizes from `kMinAllocationSize` to `kMinAllocationSize << 47`
+        };
+
+    public:
+        explicit StringArena(int64_t block_size = kDefaultBlockSize) noexcept;
+        ~StringArena() noexcept override;
+
+        StringArena(const StringArena&) = delete;
+        StringArena& operator = (const StringArena&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "StringArena"; }
+
+        friend std::ostream& operator << (std::ostream& os, const StringArena* o) {
+            o == nullptr ? os << "StringArena nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const StringArena& o) {
+            os << "block count: " << o.blocks_.size() << ", user count: " << o.user_count_;
+            return os;
+        }
+
+        [[nodiscard]] static StringArena& threadArena() noexcept;
+
+        [[nodiscard]] int64_t blockCount() const noexcept { return static_cast<int64_t>(blocks_.size()); }
+        [[nodiscard]] int32_t userCount() const noexcept { return user_count_; }
+        [[nodiscard]] int64_t freeCount() const noexcept;
+
+        [[nodiscard]] static int64_t allocationSize(int64_t size) noexcept {
+            return static_cast<int64_t>(kMinAllocationSize) << _sizeClass(size);
+        }
+
+        [[nodiscard]] char* allocate(int64_t size) noexcept;
+        [[nodiscard]] bool extend(const char* ptr, int64_t size, int64_t new_size) noexcept;
+        void release(const char* ptr, int64_t size) noexcept;
+
+        void attach() noexcept { user_count_++; }
+        void detach() noexcept;
+        void reset() noexcept;
+
+    protected:
+        [[nodiscard]] static int32_t _sizeClass(int64_t size) noexcept;
+
+    protected:
+        struct Block {
+            char* data_;
+            int64_t size_;
+        };
+
+        int64_t block_size_ = kDefaultBlockSize;
+        std::vector<Block> blocks_;
+        int32_t block_index_ = 0;       ///< Block allocations are taken from
+        int64_t block_used_ = 0;        ///< Used bytes in the current block
+        int32_t user_count_ = 0;        ///< Builders using the arena
+        std::vector<char*> free_lists_[kSizeClassCount];    ///< Released memory per size class
+    };
+
+
+    /**
+     *  @class StringBuilder
+     *  @brief Append-only buffer for building strings in hot loops.
+     *
+     *  Unlike `String`, the builder only tracks bytes. Characters are counted
+     *  once, when the result is transferred by `toString()`. Numbers are
+     *  formatted without `snprintf()`.
+     *
+     *  The buffer is taken from a `StringArena` if one is given, otherwise
+     *  from the heap. Builders using an arena must be destroyed in the thread
+     *  that owns the arena.
+     *
+     *  @code
+     *  StringBuilder sb(256, &StringArena::threadArena());
+     *  sb += dir_path;
+     *  sb += "/_tile_";
+     *  sb += tile_index;
+     *  String file_path = sb.string();
+     *  @endcode
+     */
+    class StringBuilder : public Object {
+    public:
+        enum {
+            kDefaultCapacity = 256
+        };
+
+    public:
+        explicit StringBuilder(int64_t capacity = kDefaultCapacity, StringArena* arena = nullptr) noexcept;
+        ~StringBuilder() noexcept override;
+
+        StringBuilder(const StringBuilder&) = delete;
+        StringBuilder& operator = (const StringBuilder&) = delete;
+
+        [[nodiscard]] const char* className() const noexcept override { return "StringBuilder"; }
+
+        friend std::ostream& operator << (std::ostream& os, const StringBuilder* o) {
+            o == nullptr ? os << "StringBuilder nullptr" : os << *o;
+            return os;
+        }
+
+        friend std::ostream& operator << (std::ostream& os, const StringBuilder& o) {
+            return os << o.utf8();
+        }
+
+        StringBuilder& operator += (char c) { appendChar(c); return *this; }
+        StringBuilder& operator += (const char* str) { append(str); return *this; }
+        StringBuilder& operator += (const String& string) { append(string); return *this; }
+        StringBuilder& operator += (int32_t value) { appendInt64(value); return *this; }
+        StringBuilder& operator += (int64_t value) { appendInt64(value); return *this; }
+        StringBuilder& operator += (uint32_t value) { appendUInt64(value); return *this; }
+        StringBuilder& operator += (uint64_t value) { appendUInt64(value); return *this; }
+        StringBuilder& operator += (double value) { appendDouble(value); return *this; }
+
+        [[nodiscard]] bool isEmpty() const noexcept { return byte_len_ == 0; }
+        [[nodiscard]] int64_t byteLength() const noexcept { return byte_len_; }
+        [[nodiscard]] int64_t byteCapacity() const noexcept { return byte_capacity_; }
+        [[nodiscard]] int64_t length() const noexcept { return String::utf8Length(utf8(), byte_len_); }
+        [[nodiscard]] const char* utf8() const noexcept { return data_ ? data_ : ""; }
+        [[nodiscard]] StringArena* arena() const noexcept { return arena_; }
+
+        void clear() noexcept;
+        bool reserve(int64_t byte_count) noexcept;
+
+        bool appendChar(char c) noexcept;
+        bool appendChars(char c, int64_t n) noexcept;
+        bool append(const char* str) noexcept;
+        bool append(const char* str, int64_t byte_length) noexcept;
+        bool append(const String& string) noexcept;
+        bool appendBool(bool v) noexcept { return appendChar(v ? '1' : '0'); }
+        bool appendInt32(int32_t value) noexcept { return appendInt64(value); }
+        bool appendUInt32(uint32_t value) noexcept { return appendUInt64(value); }
+        bool appendInt64(int64_t value) noexcept;
+        bool appendUInt64(uint64_t value) noexcept;
+        bool appendDouble(double value, int32_t precision = 8) noexcept;
+
+        bool toString(String& out_string) const noexcept;
+        [[nodiscard]] String string() const noexcept;
+
+    protected:
+        bool _grow(int64_t needed) noexcept;
+
+    protected:
+        char* data_ = nullptr;
+        int64_t byte_len_ = 0;
+        int64_t byte_capacity_ = 0;     ///< Usable bytes, without EOS
+        StringArena* arena_ = nullptr;
+    };
+
+
+} // End of namespace Grain
+
+#endif // GrainStringBuilder_hpp
@@ -332,6 +332,12 @@ void CVF2::_encodeRow(const int64_t* values) {
         file_->writeValue<int64_t>(seq_mins_[i]);
     }
 
+    // The last byte is always written, clear it if no nibble was pushed to
+    // it, so equal values give equal files
+    if (high_nibble_flag_) {
+        byte_buffer_[curr_byte_index_] = 0;
+    }
+
     file_->writeData<uint8_t>(byte_buffer_, curr_byte_index_ + 1);
 
 
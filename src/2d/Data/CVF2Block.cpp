@@ -0,0 +1,326 @@
+//
+//  CVF2Block.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "2d/Data/CVF2Block.hpp"
+#include "2d/Data/CVF2.hpp"
+#include "File/File.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+namespace Grain {
+
+/**
+ *  @brief Bit width needed to store all values of a block.
+ *
+ *  @param min Minimum of the defined values.
+ *  @param max Maximum of the defined values.
+ *  @param has_undefined true, if the block contains undefined values.
+ *  @return The bit width, 0 if all values are equal to `min`.
+ */
+int32_t CVF2Block::bitWidth(int64_t min, int64_t max, bool has_undefined) noexcept {
+    auto range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    if (range == 0 && !has_undefined) {
+        return 0;
+    }
+
+    // The highest code is reserved for undefined values
+    uint64_t codes = range + 1;
+    int32_t bit_width = 0;
+    while (bit_width < 64 && (codes >> bit_width) != 0) {
+        bit_width++;
+    }
+    return bit_width;
+}
+
+
+/**
+ *  @brief Pack values as fixed width codes relative to `base`.
+ *
+ *  @param out_data Zero initialized buffer of at least
+ *                  `packedByteCount(n, bit_width)` bytes.
+ */
+void CVF2Block::pack(const int64_t* values, int64_t n, int64_t base, int32_t bit_width, uint8_t* out_data) noexcept {
+    if (bit_width <= 0) {
+        return;
+    }
+
+    uint64_t undefined_code = undefinedCode(bit_width);
+    uint64_t bit_pos = 0;
+
+    for (int64_t i = 0; i < n; i++) {
+        uint64_t code = values[i] == CVF2::kUndefinedValue ? undefined_code : static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(base);
+
+        uint8_t* p = out_data + (bit_pos >> 3);
+        int32_t shift = static_cast<int32_t>(bit_pos & 0x7);
+        p[0] |= static_cast<uint8_t>(code << shift);
+
+        code >>= 8 - shift;
+        for (int32_t bits_written = 8 - shift; bits_written < bit_width; bits_written += 8) {
+            *++p |= static_cast<uint8_t>(code);
+            code >>= 8;
+        }
+
+        bit_pos += bit_width;
+    }
+}
+
+
+/**
+ *  @brief Unpack `n` consecutive values starting at code `first`.
+ *
+ *  @param data Packed codes, followed by at least `kPaddingBytes` readable bytes.
+ *  @param out_values Receives `n` values, undefined codes are converted
+ *                    to `CVF2::kUndefinedValue`.
+ */
+void CVF2Block::unpack(const uint8_t* data, int64_t first, int64_t n, int64_t base, int32_t bit_width, int64_t* out_values) noexcept {
+    if (bit_width <= 0) {
+        for (int64_t i = 0; i < n; i++) {
+            out_values[i] = base;
+        }
+        return;
+    }
+
+    uint64_t undefined_code = undefinedCode(bit_width);
+    uint64_t bit_pos = static_cast<uint64_t>(first) * bit_width;
+
+    if (bit_width <= 56) {
+        // A code never spans more than 8 bytes, one load per value and no
+        // dependency between values
+        for (int64_t i = 0; i < n; i++) {
+            uint64_t p = bit_pos + static_cast<uint64_t>(i) * bit_width;
+            uint64_t code = (_load64(data + (p >> 3)) >> (p & 0x7)) & undefined_code;
+            out_values[i] = code == undefined_code ? CVF2::kUndefinedValue : static_cast<int64_t>(static_cast<uint64_t>(base) + code);
+        }
+    }
+    else {
+        for (int64_t i = 0; i < n; i++) {
+            out_values[i] = unpackAtBit(data, bit_pos + static_cast<uint64_t>(i) * bit_width, base, bit_width);
+        }
+    }
+}
+
+
+/**
+ *  @brief Unpack the value, whose code starts at bit `bit_pos`.
+ *
+ *  Reads 8 bytes starting at byte `bit_pos / 8`, and a ninth byte if the
+ *  code extends into it.
+ */
+int64_t CVF2Block::unpackAtBit(const uint8_t* data, uint64_t bit_pos, int64_t base, int32_t bit_width) noexcept {
+    if (bit_width <= 0) {
+        return base;
+    }
+
+    uint64_t undefined_code = undefinedCode(bit_width);
+    const uint8_t* p = data + (bit_pos >> 3);
+    int32_t shift = static_cast<int32_t>(bit_pos & 0x7);
+
+    uint64_t code = _load64(p) >> shift;
+    if (shift + bit_width > 64) {
+        code |= static_cast<uint64_t>(p[8]) << (64 - shift);
+    }
+    code &= undefined_code;
+
+    return code == undefined_code ? CVF2::kUndefinedValue : static_cast<int64_t>(static_cast<uint64_t>(base) + code);
+}
+
+
+/**
+ *  @brief Write values to a CVF2 file in the block format, version 3.
+ *
+ *  Blocks are encoded independently on `thread_count` threads and written
+ *  in order, so the file does not depend on the number of threads.
+ *
+ *  @param values `width` x `height` values, row by row.
+ *  @param block_size Edge length of the blocks, `kMinBlockSize` to `kMaxBlockSize`.
+ *  @param thread_count Number of encoding threads, 0 for one per hardware thread.
+ *  @return ErrorCode::None on success.
+ */
+ErrorCode CVF2Block::writeFile(const String& file_path, const int64_t* values, int32_t width, int32_t height, int32_t srid, const Bounds2Fix& bbox, LengthUnit unit, int32_t block_size, int32_t thread_count) noexcept {
+
+    struct EncodedBlock {
+        std::vector<uint8_t> data_;
+        int64_t base_ = CVF2::kUndefinedValue;
+        int32_t bit_width_ = 0;
+        int64_t min_ = std::numeric_limits<int64_t>::max();
+        int64_t max_ = std::numeric_limits<int64_t>::min();
+        double sum_ = 0.0;
+        int64_t def_n_ = 0;
+        int64_t undef_n_ = 0;
+    };
+
+    auto result = ErrorCode::None;
+
+    try {
+        if (!values) {
+            throw ErrorCode::NullData;
+        }
+
+        if (width < 1 || height < 1 || block_size < kMinBlockSize || block_size > kMaxBlockSize) {
+            throw ErrorCode::BadArgs;
+        }
+
+        int32_t x_block_n = (width + block_size - 1) / block_size;
+        int32_t y_block_n = (height + block_size - 1) / block_size;
+        int64_t block_n = static_cast<int64_t>(x_block_n) * y_block_n;
+
+        std::vector<EncodedBlock> blocks(block_n);
+        std::atomic<int64_t> next_block_index{0};
+        std::atomic<bool> failed{false};
+
+        auto encode = [&]() {
+            try {
+                std::vector<int64_t> block_values(static_cast<size_t>(block_size) * block_size);
+
+                for (int64_t b = next_block_index++; b < block_n && !failed; b = next_block_index++) {
+                    auto& block = blocks[b];
+                    int32_t x0 = static_cast<int32_t>(b % x_block_n) * block_size;
+                    int32_t y0 = static_cast<int32_t>(b / x_block_n) * block_size;
+                    int32_t bw = std::min(block_size, width - x0);
+                    int32_t bh = std::min(block_size, height - y0);
+
+                    int64_t n = 0;
+                    for (int32_t y = y0; y < y0 + bh; y++) {
+                        const int64_t* src = values + static_cast<int64_t>(y) * width + x0;
+                        for (int32_t x = 0; x < bw; x++) {
+                            int64_t value = src[x];
+                            block_values[n++] = value;
+                            if (value == CVF2::kUndefinedValue) {
+                                block.undef_n_++;
+                            }
+                            else {
+                                block.min_ = std::min(block.min_, value);
+                                block.max_ = std::max(block.max_, value);
+                                block.sum_ += static_cast<double>(value);
+                                block.def_n_++;
+                            }
+                        }
+                    }
+
+                    if (block.def_n_ > 0) {
+                        block.base_ = block.min_;
+                        block.bit_width_ = bitWidth(block.min_, block.max_, block.undef_n_ > 0);
+                    }
+
+                    block.data_.assign(packedByteCount(n, block.bit_width_), 0);
+                    pack(block_values.data(), n, block.base_, block.bit_width_, block.data_.data());
+                }
+            }
+            catch (...) {
+                failed = true;
+            }
+        };
+
+        if (thread_count < 1) {
+            thread_count = static_cast<int32_t>(std::thread::hardware_concurrency());
+        }
+        thread_count = static_cast<int32_t>(std::clamp<int64_t>(thread_count, 1, block_n));
+
+        if (thread_count == 1) {
+            encode();
+        }
+        else {
+            std::vector<std::thread> threads;
+            for (int32_t i = 0; i < thread_count; i++) {
+                threads.emplace_back(encode);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        if (failed) {
+            throw ErrorCode::MemCantAllocate;
+        }
+
+        // Statistics in block order, so the mean does not depend on threading
+        int64_t min_value = std::numeric_limits<int64_t>::max();
+        int64_t max_value = std::numeric_limits<int64_t>::min();
+        double sum = 0.0;
+        int64_t def_n = 0;
+        int64_t undef_n = 0;
+        for (auto& block : blocks) {
+            min_value = std::min(min_value, block.min_);
+            max_value = std::max(max_value, block.max_);
+            sum += block.sum_;
+            def_n += block.def_n_;
+            undef_n += block.undef_n_;
+        }
+
+        Fix mean_value;
+        if (def_n > 0) {
+            mean_value = sum / static_cast<double>(def_n);
+        }
+        else {
+            // No defined value, the range is empty
+            min_value = CVF2::kUndefinedValue;
+            max_value = CVF2::kUndefinedValue;
+        }
+
+        File file(file_path);
+        file.startWriteOverwrite();
+        file.writeStr("CVF3");
+        file.writeEndianSignature();
+
+        file.writeValue<uint32_t>(width);
+        file.writeValue<uint32_t>(height);
+        file.writeValue<int32_t>(srid);
+
+        file.writeFix(bbox.minX());
+        file.writeFix(bbox.minY());
+        file.writeFix(bbox.maxX());
+        file.writeFix(bbox.maxY());
+
+        file.writeValue<int32_t>(static_cast<int32_t>(undef_n));
+        file.writeValue<int64_t>(min_value);
+        file.writeValue<int64_t>(max_value);
+        file.writeFix(mean_value);
+        file.writeValue<int32_t>(static_cast<int32_t>(unit));
+
+        file.writeValue<uint32_t>(static_cast<uint32_t>(block_size));
+
+        // Block index directly follows the header
+        auto block_index_pos = static_cast<uint64_t>(file.pos()) + sizeof(uint64_t);
+        file.writeValue<uint64_t>(block_index_pos);
+
+        uint64_t block_pos = block_index_pos + (block_n + 1) * sizeof(uint64_t);
+        for (auto& block : blocks) {
+            file.writeValue<uint64_t>(block_pos);
+            block_pos += kHeaderSize + block.data_.size();
+        }
+        file.writeValue<uint64_t>(block_pos);
+
+        for (auto& block : blocks) {
+            file.writeValue<int64_t>(block.base_);
+            file.writeValue<uint8_t>(static_cast<uint8_t>(block.bit_width_));
+            if (!block.data_.empty()) {
+                file.write8BitData(block.data_.data(), static_cast<int64_t>(block.data_.size()));
+            }
+        }
+
+        file.close();
+    }
+    catch (ErrorCode err) {
+        result = err;
+    }
+    catch (const Exception& e) {
+        result = e.code();
+    }
+    catch (const std::exception& e) {
+        result = ErrorCode::StdCppException;
+    }
+
+    return result;
+}
+
+
+} // End of namespace Grain
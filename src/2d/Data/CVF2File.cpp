@@ -9,6 +9,7 @@
 
 #include "2d/Data/CVF2File.hpp"
 #include "2d/Data/CVF2TileManager.hpp"
+#include "2d/Data/CVF2Block.hpp"
 #include "Image/Image.hpp"
 #include "File/XYZFile.hpp"
 #include "String/String.hpp"
@@ -27,6 +28,9 @@ CVF2File::~CVF2File() noexcept {
     std::free(cache_data_);
     std::free(row_seq_);
     std::free(row_values_);
+    std::free(block_offsets_);
+    std::free(block_data_);
+    std::free(block_row_values_);
 }
 
 
@@ -89,7 +93,13 @@ void CVF2File::startRead() {
     // Check the header
     setPos(0);
     readStr(4, buffer);
-    checkSignature(buffer, 4, "CVF2");
+    if (std::strncmp(buffer, "CVF3", 4) == 0) {
+        version_ = 3;
+    }
+    else {
+        checkSignature(buffer, 4, "CVF2");
+        version_ = 2;
+    }
 
     // Check endianess
     readStr(2, buffer);
@@ -112,7 +122,130 @@ void CVF2File::startRead() {
     readFix(mean_value_);
     unit_ = (LengthUnit)readValue<int32_t>();
 
-    row_offsets_pos_ = readValue<uint32_t>();
+    if (version_ >= 3) {
+        _readBlockIndex();
+    }
+    else {
+        row_offsets_pos_ = readValue<uint32_t>();
+    }
+}
+
+
+/**
+ *  @brief Read block size and block index of a version 3 file.
+ */
+void CVF2File::_readBlockIndex() {
+    block_size_ = static_cast<int32_t>(readValue<uint32_t>());
+    auto block_index_pos = readValue<uint64_t>();
+
+    if (block_size_ < CVF2Block::kMinBlockSize || block_size_ > CVF2Block::kMaxBlockSize) {
+        Exception::throwStandard(ErrorCode::UnsupportedFileFormat);
+    }
+
+    x_block_count_ = static_cast<int32_t>((width_ + block_size_ - 1) / block_size_);
+    y_block_count_ = static_cast<int32_t>((height_ + block_size_ - 1) / block_size_);
+    auto offset_count = static_cast<int64_t>(x_block_count_) * y_block_count_ + 1;
+
+    std::free(block_offsets_);
+    block_offsets_ = static_cast<uint64_t*>(std::malloc(sizeof(uint64_t) * offset_count));
+    if (!block_offsets_) {
+        Exception::throwStandard(ErrorCode::MemCantAllocate);
+    }
+
+    setPos(static_cast<int64_t>(block_index_pos));
+    for (int64_t i = 0; i < offset_count; i++) {
+        block_offsets_[i] = readValue<uint64_t>();
+    }
+
+    block_row_index_ = -1;
+}
+
+
+/**
+ *  @brief Decode all blocks of a row of blocks into `block_row_values_`.
+ */
+void CVF2File::_readBlockRow(int32_t block_row_index) {
+    if (!block_row_values_) {
+        block_row_values_ = static_cast<int64_t*>(std::malloc(sizeof(int64_t) * width_ * block_size_));
+        if (!block_row_values_) {
+            Exception::throwStandard(ErrorCode::MemCantAllocate);
+        }
+    }
+
+    int32_t y0 = block_row_index * block_size_;
+    int32_t bh = std::min<int32_t>(block_size_, static_cast<int32_t>(height_) - y0);
+
+    for (int32_t block_x = 0; block_x < x_block_count_; block_x++) {
+        int64_t b = static_cast<int64_t>(block_row_index) * x_block_count_ + block_x;
+        int32_t x0 = block_x * block_size_;
+        int32_t bw = std::min<int32_t>(block_size_, static_cast<int32_t>(width_) - x0);
+
+        setPos(static_cast<int64_t>(block_offsets_[b]));
+        auto base = readValue<int64_t>();
+        auto bit_width = static_cast<int32_t>(readValue<uint8_t>());
+        auto byte_count = static_cast<int64_t>(block_offsets_[b + 1] - block_offsets_[b]) - CVF2Block::kHeaderSize;
+
+        if (bit_width > 64 || byte_count < CVF2Block::packedByteCount(static_cast<int64_t>(bw) * bh, bit_width)) {
+            Exception::throwStandard(ErrorCode::UnsupportedFileFormat);
+        }
+
+        if (byte_count + CVF2Block::kPaddingBytes > block_data_size_) {
+            std::free(block_data_);
+            block_data_size_ = 0;
+            block_data_ = static_cast<uint8_t*>(std::malloc(byte_count + CVF2Block::kPaddingBytes));
+            if (!block_data_) {
+                Exception::throwStandard(ErrorCode::MemCantAllocate);
+            }
+            block_data_size_ = byte_count + CVF2Block::kPaddingBytes;
+        }
+
+        if (byte_count > 0) {
+            read(byte_count, block_data_);
+        }
+        std::memset(block_data_ + byte_count, 0, CVF2Block::kPaddingBytes);
+
+        for (int32_t y = 0; y < bh; y++) {
+            CVF2Block::unpack(block_data_, static_cast<int64_t>(y) * bw, bw, base, bit_width, block_row_values_ + static_cast<int64_t>(y) * width_ + x0);
+        }
+    }
+
+    block_row_index_ = block_row_index;
+}
+
+
+/**
+ *  @brief Read a single value of a version 3 file, touches only the block
+ *         header and the bytes of the value.
+ */
+int64_t CVF2File::_valueAtPosFromBlock(const Vec2i& pos) {
+    int32_t block_x = pos.x_ / block_size_;
+    int32_t block_y = pos.y_ / block_size_;
+    int64_t b = static_cast<int64_t>(block_y) * x_block_count_ + block_x;
+    int32_t bw = std::min<int32_t>(block_size_, static_cast<int32_t>(width_) - block_x * block_size_);
+
+    auto block_pos = static_cast<int64_t>(block_offsets_[b]);
+    setPos(block_pos);
+    auto base = readValue<int64_t>();
+    auto bit_width = static_cast<int32_t>(readValue<uint8_t>());
+    if (bit_width == 0) {
+        return base;
+    }
+    if (bit_width > 64) {
+        return CVF2::kUndefinedValue;
+    }
+
+    int64_t index = static_cast<int64_t>(pos.y_ - block_y * block_size_) * bw + (pos.x_ - block_x * block_size_);
+    uint64_t bit_pos = static_cast<uint64_t>(index) * bit_width;
+    auto byte_offset = static_cast<int64_t>(bit_pos >> 3);
+    auto byte_count = static_cast<int64_t>(((bit_pos & 0x7) + bit_width + 7) >> 3);
+    auto data_end = static_cast<int64_t>(block_offsets_[b + 1]);
+    byte_count = std::min(byte_count, data_end - (block_pos + CVF2Block::kHeaderSize + byte_offset));
+
+    uint8_t buffer[16] = {};
+    setPos(block_pos + CVF2Block::kHeaderSize + byte_offset);
+    read(byte_count, buffer);
+
+    return CVF2Block::unpackAtBit(buffer, bit_pos & 0x7, base, bit_width);
 }
 
 
@@ -147,6 +280,15 @@ int64_t CVF2File::valueAtPos(const Vec2i& pos, bool cache_mode) noexcept {
         return (static_cast<int64_t*>(cache_data_))[pos.y_ * width_ + pos.x_];
     }
 
+    if (version_ >= 3) {
+        try {
+            return _valueAtPosFromBlock(pos);
+        }
+        catch (...) {
+            return CVF2::kUndefinedValue;
+        }
+    }
+
     setPos(row_offsets_pos_ + pos.y_ * 4);
     auto row_offset = readValue<uint32_t>();
 
@@ -224,6 +366,17 @@ int32_t CVF2File::readRow(int32_t y) {
         }
     }
 
+    if (version_ >= 3) {
+        // Rows are read in order in most cases, so each row of blocks is
+        // decoded only once
+        int32_t block_row_index = y / block_size_;
+        if (block_row_index != block_row_index_) {
+            _readBlockRow(block_row_index);
+        }
+        std::memcpy(row_values_, block_row_values_ + static_cast<int64_t>(y - block_row_index * block_size_) * width_, sizeof(int64_t) * width_);
+        return width_;
+    }
+
     setPos(row_offsets_pos_ + y * 4);
     auto row_offset = readValue<uint32_t>();
 
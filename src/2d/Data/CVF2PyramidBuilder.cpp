@@ -0,0 +1,480 @@
+//
+//  CVF2PyramidBuilder.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "2d/Data/CVF2PyramidBuilder.hpp"
+#include "2d/Data/CVF2TileManager.hpp"
+#include "Geo/GeoMetaTile.hpp"
+#include "Geo/GeoProj.hpp"
+#include "File/File.hpp"
+#include "Time/Timestamp.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+
+namespace Grain {
+
+    CVF2PyramidBuilder::CVF2PyramidBuilder(CVF2TileManager* tile_manager, const String& base_path, const Bounds2d& bbox, int32_t max_zoom, int32_t min_zoom) noexcept {
+
+        tile_manager_ = tile_manager;
+        base_path_ = base_path;
+        bbox_ = bbox;
+        max_zoom_ = max_zoom;
+        min_zoom_ = min_zoom;
+        manifest_path_ = base_path + "/pyramid.manifest";
+    }
+
+
+    CVF2PyramidBuilder::~CVF2PyramidBuilder() noexcept {
+
+        delete manifest_file_;
+    }
+
+
+    /**
+     *  @brief Build all meta tiles, which are not up to date.
+     *
+     *  Blocks until all meta tiles are written, or until `cancel()` was
+     *  called and the running meta tiles are finished.
+     *
+     *  @return ErrorCode::None on success, otherwise the error of the first
+     *          failed meta tile. Meta tiles depending on a failed one are not
+     *          rendered, all others are.
+     */
+    ErrorCode CVF2PyramidBuilder::build() noexcept {
+
+        auto result = ErrorCode::None;
+
+        std::vector<std::thread> threads;
+
+        cancel_flag_ = false;
+        rendered_tile_count_ = 0;
+        downsampled_tile_count_ = 0;
+        skipped_tile_count_ = 0;
+        failed_tile_count_ = 0;
+        bytes_written_ = 0;
+        first_err_ = ErrorCode::None;
+        start_ts_ = Timestamp::currentMillis();
+        end_ts_ = 0;
+
+        try {
+            if (!tile_manager_) { throw ErrorCode::NullPointer; }
+            if (min_zoom_ < 0 || max_zoom_ > 20 || min_zoom_ > max_zoom_) { throw Error::specific(kErrZoomOutOfRange); }
+
+            if (!File::makeDirs(base_path_)) {
+                throw ErrorCode::FileDirNotFound;
+            }
+
+            manifest_.clear();
+            if (resume_flag_) {
+                _loadManifest();
+            }
+
+            auto err = _setupNodes();
+            if (err != ErrorCode::None) { throw err; }
+
+            // Entries are appended as soon as a meta tile is written, so an
+            // interrupted build keeps its progress
+            manifest_file_ = new (std::nothrow) File(manifest_path_);
+            if (!manifest_file_) { throw ErrorCode::ClassInstantiationFailed; }
+            if (resume_flag_) {
+                manifest_file_->startWriteAsciiAppend();
+            }
+            else {
+                manifest_file_->startWriteAsciiOverwrite();
+            }
+
+            int32_t thread_count = thread_count_;
+            if (thread_count < 1) {
+                thread_count = std::max<int32_t>(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+            }
+
+            for (int32_t i = 0; i < thread_count; i++) {
+                threads.emplace_back(&CVF2PyramidBuilder::_worker, this);
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::exception& e) {
+            result = ErrorCode::StdCppException;
+        }
+
+        if (result != ErrorCode::None) {
+            cancel();
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (manifest_file_) {
+            manifest_file_->close();
+            delete manifest_file_;
+            manifest_file_ = nullptr;
+        }
+
+        if (result == ErrorCode::None) {
+            auto err = _saveManifest();
+            if (first_err_ != ErrorCode::None) {
+                result = first_err_;
+            }
+            else if (cancel_flag_) {
+                result = Error::specific(kErrCancelled);
+            }
+            else {
+                result = err;
+            }
+        }
+
+        end_ts_ = Timestamp::currentMillis();
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Stop the build, meta tiles being rendered are finished.
+     */
+    void CVF2PyramidBuilder::cancel() noexcept {
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancel_flag_ = true;
+        }
+        cond_.notify_all();
+    }
+
+
+    /**
+     *  @brief Progress of the running or the last build.
+     */
+    CVF2PyramidBuilder::Stats CVF2PyramidBuilder::stats() const noexcept {
+
+        Stats stats;
+        stats.total_tile_count_ = static_cast<int64_t>(nodes_.size());
+        stats.rendered_tile_count_ = rendered_tile_count_;
+        stats.downsampled_tile_count_ = downsampled_tile_count_;
+        stats.skipped_tile_count_ = skipped_tile_count_;
+        stats.failed_tile_count_ = failed_tile_count_;
+        stats.bytes_written_ = bytes_written_;
+
+        timestamp_t start_ts = start_ts_;
+        timestamp_t end_ts = end_ts_;
+        if (start_ts > 0) {
+            stats.elapsed_seconds_ = static_cast<double>((end_ts > 0 ? end_ts : Timestamp::currentMillis()) - start_ts) / 1000.0;
+        }
+
+        return stats;
+    }
+
+
+    /**
+     *  @brief Collect the meta tiles of all levels and link them to their
+     *         downsampled meta tiles.
+     *
+     *  Compares the signatures with the manifest of a previous build and
+     *  queues all meta tiles, which need rendering and have no pending
+     *  sources.
+     */
+    ErrorCode CVF2PyramidBuilder::_setupNodes() {
+
+        nodes_.clear();
+        queue_.clear();
+        unfinished_count_ = 0;
+
+        std::unordered_map<uint64_t, int32_t> node_indices;
+
+        // Levels from finest to coarsest, so sources always precede their
+        // downsampled meta tile
+        for (int32_t zoom = max_zoom_; zoom >= min_zoom_; zoom--) {
+            GeoMetaTileRange mtr(zoom, bbox_);
+            if (!mtr.valid()) { return Error::specific(kErrMetaTileRangeFailed); }
+
+            Vec2i tile_index;
+            while (mtr.nextTilePos(tile_index)) {
+                Node node;
+                node.zoom_ = zoom;
+                node.tile_index_ = tile_index;
+                node_indices[_key(zoom, tile_index)] = static_cast<int32_t>(nodes_.size());
+                nodes_.push_back(node);
+            }
+        }
+
+        auto mix = [](uint64_t& signature, uint64_t value) {
+            signature ^= value + 0x9E3779B97F4A7C15ULL + (signature << 6) + (signature >> 2);
+        };
+
+        GeoProj proj(4326, tile_manager_->tileSRID());
+
+        uint64_t settings_signature = 0;
+        uint64_t max_error_bits;
+        double max_error = tile_manager_->reprojectionMaxError();
+        std::memcpy(&max_error_bits, &max_error, sizeof(max_error_bits));
+        mix(settings_signature, static_cast<uint64_t>(antialias_level_));
+        mix(settings_signature, max_error_bits);
+
+        for (int32_t i = 0; i < static_cast<int32_t>(nodes_.size()); i++) {
+            auto& node = nodes_[i];
+            node.signature_ = settings_signature;
+            mix(node.signature_, static_cast<uint64_t>(node.zoom_));
+
+            if (node.zoom_ == max_zoom_) {
+                Bounds2d bbox;
+                Bounds2d bbox_tm;
+                CVF2TileManager::metaTileWGS84Bbox(node.zoom_, node.tile_index_, bbox);
+                proj.transform(bbox, bbox_tm);
+                mix(node.signature_, tile_manager_->sourceSignature(bbox_tm));
+            }
+            else {
+                // Sources are at the next higher zoom level, earlier in `nodes_`
+                Vec2i src_tile_indices[4];
+                CVF2TileManager::downsampledMetaTileSources(node.zoom_ + 1, node.tile_index_, src_tile_indices);
+
+                for (auto& src_tile_index : src_tile_indices) {
+                    Vec2i src_meta_index(src_tile_index.x_ & ~(GeoMetaTileRange::kGridSize - 1), src_tile_index.y_ & ~(GeoMetaTileRange::kGridSize - 1));
+                    auto it = node_indices.find(_key(node.zoom_ + 1, src_meta_index));
+                    if (it != node_indices.end()) {
+                        auto& child = nodes_[it->second];
+                        if (child.parent_ < 0) {
+                            child.parent_ = i;
+                            node.pending_child_count_++;
+                        }
+                        mix(node.signature_, child.signature_);
+                    }
+                    else {
+                        mix(node.signature_, 0);
+                    }
+                }
+            }
+
+            auto it = manifest_.find(_key(node.zoom_, node.tile_index_));
+            if (it != manifest_.end() && it->second == node.signature_) {
+                String file_path;
+                Geo::metaTilePathForTile(base_path_, node.zoom_, node.tile_index_, "cvf", file_path);
+                node.skip_ = File::fileExists(file_path);
+            }
+        }
+
+        for (auto& node : nodes_) {
+            if (node.skip_) {
+                node.done_ = true;
+                skipped_tile_count_++;
+                if (node.parent_ >= 0) {
+                    nodes_[node.parent_].pending_child_count_--;
+                }
+            }
+            else {
+                unfinished_count_++;
+            }
+        }
+
+        for (int32_t i = 0; i < static_cast<int32_t>(nodes_.size()); i++) {
+            if (!nodes_[i].skip_ && nodes_[i].pending_child_count_ == 0) {
+                queue_.push_back(i);
+            }
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    void CVF2PyramidBuilder::_worker() noexcept {
+
+        ValueGridl* value_grid = nullptr;
+        ValueGridl* sub_value_grid = nullptr;
+
+        GeoMetaTileRange mtr(max_zoom_, bbox_);
+        int32_t meta_tile_size = mtr.metaTileSize();
+
+        while (true) {
+
+            int32_t node_index;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] {
+                    return cancel_flag_ || !queue_.empty() || unfinished_count_ == 0;
+                });
+
+                if (cancel_flag_ || queue_.empty()) {
+                    break;
+                }
+
+                node_index = queue_.front();
+                queue_.pop_front();
+            }
+
+            // Only scheduling data of a node is changed by other threads
+            const auto& node = nodes_[node_index];
+            String file_path;
+            auto err = ErrorCode::None;
+
+            if (!value_grid) {
+                value_grid = new (std::nothrow) ValueGridl(meta_tile_size, meta_tile_size);
+            }
+
+            if (!value_grid) {
+                err = ErrorCode::MemCantAllocate;
+            }
+            else if (node.zoom_ == max_zoom_) {
+                value_grid->setInvalidValue(CVF2::kUndefinedValue);
+                err = tile_manager_->renderMetaTile(base_path_, node.zoom_, node.tile_index_, antialias_level_, value_grid, file_path);
+                if (err == ErrorCode::None) {
+                    rendered_tile_count_++;
+                }
+            }
+            else {
+                err = CVF2TileManager::renderDownsampledMetaTile(base_path_, 4326, node.zoom_ + 1, node.tile_index_, value_grid, &sub_value_grid, file_path);
+                if (err == ErrorCode::None) {
+                    downsampled_tile_count_++;
+                }
+            }
+
+            if (err == ErrorCode::None) {
+                FileEntry file_entry;
+                File::fileEntryByPath(file_path, file_entry);
+                bytes_written_ += static_cast<int64_t>(file_entry.file_size_);
+                _appendManifestEntry(node);
+            }
+            else {
+                failed_tile_count_++;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (err != ErrorCode::None && first_err_ == ErrorCode::None) {
+                    first_err_ = err;
+                }
+                _finishNode(node_index, err != ErrorCode::None);
+            }
+            cond_.notify_all();
+        }
+
+        delete value_grid;
+        delete sub_value_grid;
+    }
+
+
+    /**
+     *  @brief Mark a node as finished and queue its downsampled meta tile,
+     *         if it was the last pending source.
+     *
+     *  Must be called with `mutex_` locked.
+     */
+    void CVF2PyramidBuilder::_finishNode(int32_t node_index, bool failed) {
+
+        auto& node = nodes_[node_index];
+        node.done_ = !failed;
+        unfinished_count_--;
+
+        if (node.parent_ < 0) {
+            return;
+        }
+
+        auto& parent = nodes_[node.parent_];
+        if (failed) {
+            parent.child_failed_ = true;
+        }
+
+        if (--parent.pending_child_count_ > 0 || parent.skip_) {
+            return;
+        }
+
+        if (parent.child_failed_) {
+            // Incomplete sources, don't render
+            failed_tile_count_++;
+            _finishNode(node.parent_, true);
+        }
+        else {
+            // Prefer downsampling, so lower levels are completed early
+            queue_.push_front(node.parent_);
+        }
+    }
+
+
+    void CVF2PyramidBuilder::_loadManifest() noexcept {
+
+        if (!File::fileExists(manifest_path_)) {
+            return;
+        }
+
+        try {
+            File file(manifest_path_);
+            file.startReadAscii();
+
+            // Later entries replace earlier ones, malformed lines, e.g. an
+            // incomplete last line of an interrupted build, are ignored
+            String line;
+            while (file.readLine(line)) {
+                int32_t zoom, x, y;
+                unsigned long long signature;
+                char end;
+                if (std::sscanf(line.utf8(), "%d %d %d %llx%c", &zoom, &x, &y, &signature, &end) == 4) {
+                    manifest_[_key(zoom, Vec2i(x, y))] = signature;
+                }
+            }
+
+            file.close();
+        }
+        catch (...) {
+        }
+    }
+
+
+    /**
+     *  @brief Rewrite the manifest with one entry per finished meta tile.
+     */
+    ErrorCode CVF2PyramidBuilder::_saveManifest() noexcept {
+
+        auto result = ErrorCode::None;
+
+        String tmp_path = manifest_path_ + ".tmp";
+
+        try {
+            File file(tmp_path);
+            file.startWriteAsciiOverwrite();
+
+            for (auto& node : nodes_) {
+                if (node.done_) {
+                    file.writeFormatted("%d %d %d %016llx\n", node.zoom_, node.tile_index_.x_, node.tile_index_.y_, static_cast<unsigned long long>(node.signature_));
+                }
+            }
+
+            file.close();
+
+            if (std::rename(tmp_path.utf8(), manifest_path_.utf8()) != 0) {
+                throw Error::specific(kErrManifestWriteFailed);
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (...) {
+            result = Error::specific(kErrManifestWriteFailed);
+        }
+
+        return result;
+    }
+
+
+    void CVF2PyramidBuilder::_appendManifestEntry(const Node& node) noexcept {
+
+        std::lock_guard<std::mutex> lock(manifest_mutex_);
+
+        try {
+            manifest_file_->writeFormatted("%d %d %d %016llx\n", node.zoom_, node.tile_index_.x_, node.tile_index_.y_, static_cast<unsigned long long>(node.signature_));
+            manifest_file_->flush();
+        }
+        catch (...) {
+        }
+    }
+
+
+} // End of namespace Grain
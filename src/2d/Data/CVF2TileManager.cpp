@@ -15,6 +15,7 @@
 #include "Graphic/GraphicContext.hpp"
 #include "Geo/Geo.hpp"
 #include "Geo/GeoMetaTile.hpp"
+#include "Geo/GeoProjApprox.hpp"
 #include "App/App.hpp"
 
 
@@ -173,6 +174,10 @@ namespace Grain {
 
     CVF2TileManager::~CVF2TileManager() {
 
+        for (auto reader : free_readers_) {
+            delete reader;
+        }
+
         if (file_slots_) {
             for (int32_t i = 0; i < file_slot_capacity_; i++) {
                 if (file_slots_[i].file_) {
@@ -553,7 +558,10 @@ namespace Grain {
 
     int64_t CVF2TileManager::valueAtWGS84Pos(const Vec2d& lonlat) noexcept {
         Vec2d pos;
-        wgs84_to_tile_proj_.transform(lonlat, pos);
+        {
+            std::lock_guard<std::mutex> lock(proj_mutex_);
+            wgs84_to_tile_proj_.transform(lonlat, pos);
+        }
         return valueAtPos(pos);
     }
 
@@ -564,39 +572,472 @@ namespace Grain {
      *  @return The value at `pos` or `CVF2::kUndefinedValue`, if no value exists.
      */
     int64_t CVF2TileManager::valueAtPos(const Vec2d& pos) noexcept {
+        ReaderLease lease(this);
+        return lease.reader() ? _valueAtPos(pos, lease.reader()) : CVF2::kUndefinedValue;
+    }
+
+
+    /**
+     *  @brief Take a reader from the pool, or create one if the pool is empty.
+     *
+     *  @return The reader or nullptr, if no reader could be created.
+     */
+    CVF2ManagerReader* CVF2TileManager::_acquireReader() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(reader_mutex_);
+            if (!free_readers_.empty()) {
+                auto reader = free_readers_.back();
+                free_readers_.pop_back();
+                return reader;
+            }
+        }
+
+        try {
+            return new CVF2ManagerReader(file_slot_capacity_);
+        }
+        catch (const std::exception&) {
+            return nullptr;
+        }
+    }
+
+
+    /**
+     *  @brief Return a reader to the pool and add its statistics.
+     */
+    void CVF2TileManager::_releaseReader(CVF2ManagerReader* reader) noexcept {
+        if (!reader) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(reader_mutex_);
+
+        cvf2_file_open_n_ += reader->open_n_;
+        cvf2_file_close_n_ += reader->close_n_;
+        cvf2_file_open_failed_n_ += reader->open_failed_n_;
+        reader->open_n_ = reader->close_n_ = reader->open_failed_n_ = 0;
+
+        try {
+            free_readers_.push_back(reader);
+        }
+        catch (const std::exception&) {
+            delete reader;
+        }
+    }
+
+
+    /**
+     *  @brief Get a value for a position, reading through the files of `reader`.
+     */
+    int64_t CVF2TileManager::_valueAtPos(const Vec2d& pos, CVF2ManagerReader* reader) noexcept {
         Vec2i tile_xy_index;
         int64_t tile_index = tileIndexAtTileManagerPos(pos, tile_xy_index);
         if (tile_index < 0) {
             return CVF2::kUndefinedValue;
         }
-        std::cout << "CVF2TileManager::valueAtPos tile_index: " << tile_index << std::endl;
-        std::cout << "CVF2TileManager::valueAtPos tile_xy_index: " << tile_xy_index << std::endl;
 
         auto tile = tileAtIndex(tile_index);
         if (!tile) {
             return CVF2::kUndefinedValue;
         }
-        std::cout << tile << std::endl;
 
         if (!tile->valid_) {
             return CVF2::kUndefinedValue;
         }
 
-        auto cvf2_file = cvf2FileForTile(tile);
+        auto cvf2_file = reader->fileForTile(tile);
         if (!cvf2_file) {
             return CVF2::kUndefinedValue;
         }
-        std::cout << cvf2_file << std::endl;
 
         Vec2i tile_xy;  // Position in Tile space
         tile->crsPosToTileXY(pos, tile_xy);
-        std::cout << "tile_xy: " << tile_xy << std::endl;
         int64_t value = cvf2_file->valueAtPos(tile_xy, cache_tile_flag_);
 
         return value;
     }
 
 
+    /**
+     *  @brief Find the cell of a neighbouring tile, for a cell outside of `tile`.
+     *
+     *  Interpolation near tile borders reads cells across the border.
+     *
+     *  @param tile The tile, the cell position is relative to.
+     *  @param x, y Cell position relative to `tile`, outside of it.
+     *  @param[out] out_xy Cell position in the returned tile.
+     *  @return The neighbouring tile or nullptr, if no valid tile holds the cell.
+     */
+    CVF2Tile* CVF2TileManager::_neighbourCell(CVF2Tile* tile, int32_t x, int32_t y, Vec2i& out_xy) noexcept {
+
+        if (tile->width_ < 2 || tile->height_ < 2) {
+            return nullptr;
+        }
+
+        // Position of the cell in the tile manager SRID
+        auto& bbox = tile->bbox_dbl_;
+        Vec2d pos(bbox.min_x_ + x * (bbox.width() / (tile->width_ - 1)),
+                  bbox.min_y_ + y * (bbox.height() / (tile->height_ - 1)));
+
+        Vec2i tile_xy_index;
+        auto neighbour = tileAtIndex(tileIndexAtTileManagerPos(pos, tile_xy_index));
+        if (!neighbour || neighbour == tile || !neighbour->valid_ || neighbour->width_ < 2 || neighbour->height_ < 2) {
+            return nullptr;
+        }
+
+        auto& nb_bbox = neighbour->bbox_dbl_;
+        out_xy.x_ = static_cast<int32_t>(std::lround(Math::remap(nb_bbox.min_x_, nb_bbox.max_x_, 0, neighbour->width_ - 1, pos.x_)));
+        out_xy.y_ = static_cast<int32_t>(std::lround(Math::remap(nb_bbox.min_y_, nb_bbox.max_y_, 0, neighbour->height_ - 1, pos.y_)));
+        if (out_xy.x_ < 0 || out_xy.x_ >= static_cast<int32_t>(neighbour->width_) ||
+            out_xy.y_ < 0 || out_xy.y_ >= static_cast<int32_t>(neighbour->height_)) {
+            return nullptr;
+        }
+
+        return neighbour;
+    }
+
+
+    /**
+     *  @brief Sample many positions at once.
+     *
+     *  The queries are grouped by tile. For each group the CVF2 file of the
+     *  tile is resolved once and the cells are read from it directly.
+     *  Cells across a tile border, needed by the interpolating modes, are
+     *  collected per group and read with one file lookup per neighbouring
+     *  tile. For large batches, `enableTileCache()` avoids decoding each
+     *  value separately.
+     *
+     *  `SampleMode::Nearest` selects cells with the same rule as
+     *  `valueAtPos()`, so both give the same values.
+     *
+     *  @param positions Positions in the SRID of the tile manager.
+     *  @param n Number of positions.
+     *  @param mode Sampling mode.
+     *  @param[out] out_values `n` values, NaN where no value exists, or any
+     *              cell contributing to an interpolated value is undefined.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode CVF2TileManager::sampleMany(const Vec2d* positions, int64_t n, SampleMode mode, double* out_values) noexcept {
+
+        if (!positions || !out_values) {
+            return ErrorCode::NullPointer;
+        }
+
+        ReaderLease lease(this);
+        return lease.reader() ? _sampleMany(positions, n, mode, lease.reader(), out_values, nullptr) : ErrorCode::MemCantAllocate;
+    }
+
+
+    /**
+     *  @brief Sample the cells at many positions, same as `valueAtPos()` for
+     *         each position.
+     *
+     *  Unlike the `double` values of the interpolating modes, the values
+     *  are exact over the whole `int64_t` range.
+     *
+     *  @param positions Positions in the SRID of the tile manager.
+     *  @param n Number of positions.
+     *  @param[out] out_values `n` values, `CVF2::kUndefinedValue` where no
+     *              value exists.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode CVF2TileManager::sampleMany(const Vec2d* positions, int64_t n, int64_t* out_values) noexcept {
+
+        if (!positions || !out_values) {
+            return ErrorCode::NullPointer;
+        }
+
+        ReaderLease lease(this);
+        return lease.reader() ? _sampleMany(positions, n, SampleMode::Nearest, lease.reader(), nullptr, out_values) : ErrorCode::MemCantAllocate;
+    }
+
+
+    /**
+     *  @brief Implementation of `sampleMany()`, reading through `reader`.
+     *
+     *  Writes either `out_values` or, for `SampleMode::Nearest` only,
+     *  `out_int64_values`.
+     */
+    ErrorCode CVF2TileManager::_sampleMany(const Vec2d* positions, int64_t n, SampleMode mode, CVF2ManagerReader* reader, double* out_values, int64_t* out_int64_values) noexcept {
+
+        if (n <= 0) {
+            return ErrorCode::None;
+        }
+
+        if (out_int64_values) {
+            mode = SampleMode::Nearest;
+        }
+
+        struct BorderCell {
+            int64_t tile_index_;    ///< Index of the neighbouring tile
+            Vec2i xy_;              ///< Cell position in the neighbouring tile
+            int64_t cell_index_;    ///< Index in `cells`
+
+            bool operator < (const BorderCell& other) const noexcept { return tile_index_ < other.tile_index_; }
+        };
+
+        // Cells per query, 1 x 1, 2 x 2 or 4 x 4
+        const int32_t stencil_size = mode == SampleMode::Nearest ? 1 : (mode == SampleMode::Bilinear ? 2 : 4);
+        const int32_t stencil_cell_count = stencil_size * stencil_size;
+
+        std::vector<std::pair<int64_t, int64_t>> queries;  // Tile index, position index
+        std::vector<Vec2d> fractions;                      // Interpolation weights per query of a group
+        std::vector<int64_t> cells;                        // Stencil cells of all queries of a group
+        std::vector<BorderCell> border_cells;
+
+        try {
+            queries.reserve(n);
+            for (int64_t i = 0; i < n; i++) {
+                Vec2i tile_xy_index;
+                int64_t tile_index = tileIndexAtTileManagerPos(positions[i], tile_xy_index);
+                if (out_int64_values) {
+                    out_int64_values[i] = CVF2::kUndefinedValue;
+                }
+                else {
+                    out_values[i] = NAN;
+                }
+                if (tile_index >= 0) {
+                    queries.emplace_back(tile_index, i);
+                }
+            }
+            std::sort(queries.begin(), queries.end());
+        }
+        catch (const std::exception&) {
+            return ErrorCode::StdCppException;
+        }
+
+        auto cubic_weights = [](double t, double* w) {
+            // Catmull-Rom
+            double t2 = t * t;
+            double t3 = t2 * t;
+            w[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+            w[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+            w[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+            w[3] = 0.5 * (t3 - t2);
+        };
+
+        // Bilinear interpolation of 2 x 2 cells, `c` points to the top left
+        // cell, rows are `stride` cells apart
+        auto bilinear = [](const int64_t* c, int32_t stride, double tx, double ty, double& out_value) {
+            double sum = 0.0;
+            for (int32_t j = 0; j < 2; j++) {
+                double wy = j == 0 ? 1.0 - ty : ty;
+                for (int32_t k = 0; k < 2; k++) {
+                    double w = (k == 0 ? 1.0 - tx : tx) * wy;
+                    if (w <= 0.0) {
+                        continue;   // Cell does not contribute
+                    }
+                    auto value = c[j * stride + k];
+                    if (value == CVF2::kUndefinedValue) {
+                        return false;
+                    }
+                    sum += w * static_cast<double>(value);
+                }
+            }
+            out_value = sum;
+            return true;
+        };
+
+        size_t group_begin = 0;
+        while (group_begin < queries.size()) {
+
+            int64_t tile_index = queries[group_begin].first;
+            size_t group_end = group_begin + 1;
+            while (group_end < queries.size() && queries[group_end].first == tile_index) {
+                group_end++;
+            }
+
+            auto group_size = static_cast<int64_t>(group_end - group_begin);
+            auto tile = tileAtIndex(tile_index);
+
+            if (!tile || !tile->valid_ || tile->width_ < 1 || tile->height_ < 1) {
+                group_begin = group_end;
+                continue;
+            }
+
+            try {
+                fractions.resize(group_size);
+                cells.assign(group_size * stencil_cell_count, CVF2::kUndefinedValue);
+                border_cells.clear();
+            }
+            catch (const std::exception&) {
+                return ErrorCode::StdCppException;
+            }
+
+            auto tile_width = static_cast<int32_t>(tile->width_);
+            auto tile_height = static_cast<int32_t>(tile->height_);
+            auto cvf2_file = reader->fileForTile(tile);
+
+            for (int64_t q = 0; q < group_size; q++) {
+                auto& pos = positions[queries[group_begin + q].second];
+
+                // Top left cell of the stencil
+                Vec2i origin;
+                if (mode == SampleMode::Nearest) {
+                    tile->crsPosToTileXY(pos, origin);
+                }
+                else {
+                    auto& bbox = tile->bbox_dbl_;
+                    double fx = tile_width > 1 ? Math::remap(bbox.min_x_, bbox.max_x_, 0, tile_width - 1, pos.x_) : 0.0;
+                    double fy = tile_height > 1 ? Math::remap(bbox.min_y_, bbox.max_y_, 0, tile_height - 1, pos.y_) : 0.0;
+                    origin.x_ = static_cast<int32_t>(std::floor(fx));
+                    origin.y_ = static_cast<int32_t>(std::floor(fy));
+                    fractions[q].x_ = fx - origin.x_;
+                    fractions[q].y_ = fy - origin.y_;
+                    if (mode == SampleMode::Bicubic) {
+                        origin.x_--;
+                        origin.y_--;
+                    }
+                }
+
+                int64_t cell_index = q * stencil_cell_count;
+                for (int32_t j = 0; j < stencil_size; j++) {
+                    for (int32_t k = 0; k < stencil_size; k++, cell_index++) {
+                        Vec2i xy(origin.x_ + k, origin.y_ + j);
+                        if (xy.x_ >= 0 && xy.x_ < tile_width && xy.y_ >= 0 && xy.y_ < tile_height) {
+                            if (cvf2_file) {
+                                cells[cell_index] = cvf2_file->valueAtPos(xy, cache_tile_flag_);
+                            }
+                        }
+                        else if (mode != SampleMode::Nearest) {
+                            // `valueAtPos()` doesn't look across the border
+                            Vec2i nb_xy;
+                            auto neighbour = _neighbourCell(tile, xy.x_, xy.y_, nb_xy);
+                            if (neighbour) {
+                                try {
+                                    border_cells.push_back({ neighbour->index_, nb_xy, cell_index });
+                                }
+                                catch (const std::exception&) {
+                                    return ErrorCode::StdCppException;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Cells across the border, one file lookup per neighbouring tile
+            std::sort(border_cells.begin(), border_cells.end());
+            CVF2File* nb_file = nullptr;
+            int64_t nb_tile_index = -1;
+            for (auto& border_cell : border_cells) {
+                if (border_cell.tile_index_ != nb_tile_index) {
+                    nb_tile_index = border_cell.tile_index_;
+                    nb_file = reader->fileForTile(tileAtIndex(nb_tile_index));
+                }
+                if (nb_file) {
+                    cells[border_cell.cell_index_] = nb_file->valueAtPos(border_cell.xy_, cache_tile_flag_);
+                }
+            }
+
+            if (out_int64_values) {
+                for (int64_t q = 0; q < group_size; q++) {
+                    out_int64_values[queries[group_begin + q].second] = cells[q];
+                }
+                group_begin = group_end;
+                continue;
+            }
+
+            for (int64_t q = 0; q < group_size; q++) {
+                double& out_value = out_values[queries[group_begin + q].second];
+                const int64_t* c = &cells[q * stencil_cell_count];
+                double tx = fractions[q].x_;
+                double ty = fractions[q].y_;
+
+                if (mode == SampleMode::Nearest) {
+                    if (c[0] != CVF2::kUndefinedValue) {
+                        out_value = static_cast<double>(c[0]);
+                    }
+                }
+                else if (mode == SampleMode::Bilinear) {
+                    bilinear(c, 2, tx, ty, out_value);
+                }
+                else {
+                    double wx[4], wy[4];
+                    cubic_weights(tx, wx);
+                    cubic_weights(ty, wy);
+
+                    double sum = 0.0;
+                    bool defined = true;
+                    for (int32_t j = 0; j < 4 && defined; j++) {
+                        for (int32_t k = 0; k < 4; k++) {
+                            auto value = c[j * 4 + k];
+                            if (value == CVF2::kUndefinedValue) {
+                                defined = false;
+                                break;
+                            }
+                            sum += wx[k] * wy[j] * static_cast<double>(value);
+                        }
+                    }
+
+                    if (defined) {
+                        out_value = sum;
+                    }
+                    else {
+                        // Fall back to bilinear on the inner 2 x 2 cells
+                        bilinear(c + 4 + 1, 4, tx, ty, out_value);
+                    }
+                }
+            }
+
+            group_begin = group_end;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Signature of all source files, which contribute to a region.
+     *
+     *  Combines path, size and modification time of the CVF2 files of all
+     *  valid tiles overlapping `bbox`. The signature changes, when a source
+     *  file is added, removed or modified, and is used to skip up to date
+     *  output when rendering again.
+     *
+     *  @param bbox The region in the SRID of the tile manager.
+     *  @return The signature, 0 if no tile overlaps the region.
+     */
+    uint64_t CVF2TileManager::sourceSignature(const Bounds2d& bbox) noexcept {
+
+        if (tile_width_ < 1 || tile_height_ < 1) {
+            return 0;
+        }
+
+        auto x0 = static_cast<int64_t>(std::floor((bbox.min_x_ - scan_xy_range_dbl_.min_x_) / tile_width_));
+        auto y0 = static_cast<int64_t>(std::floor((bbox.min_y_ - scan_xy_range_dbl_.min_y_) / tile_height_));
+        auto x1 = static_cast<int64_t>(std::floor((bbox.max_x_ - scan_xy_range_dbl_.min_x_) / tile_width_));
+        auto y1 = static_cast<int64_t>(std::floor((bbox.max_y_ - scan_xy_range_dbl_.min_y_) / tile_height_));
+        x0 = std::max<int64_t>(x0, 0);
+        y0 = std::max<int64_t>(y0, 0);
+        x1 = std::min<int64_t>(x1, x_tile_count_ - 1);
+        y1 = std::min<int64_t>(y1, y_tile_count_ - 1);
+
+        uint64_t signature = 0;
+
+        auto mix = [&signature](uint64_t value) {
+            signature ^= value + 0x9E3779B97F4A7C15ULL + (signature << 6) + (signature >> 2);
+        };
+
+        for (int64_t y = y0; y <= y1; y++) {
+            for (int64_t x = x0; x <= x1; x++) {
+                auto tile = tileAtIndex(y * x_tile_count_ + x);
+                if (!tile || !tile->valid_) {
+                    continue;
+                }
+
+                FileEntry file_entry;
+                File::fileEntryByPath(tile->file_path_, file_entry);
+
+                mix(String::fnv1a_hash(tile->file_path_.utf8()));
+                mix(file_entry.file_size_);
+                mix(static_cast<uint64_t>(file_entry.mod_time_));
+            }
+        }
+
+        return signature;
+    }
+
+
     /**
      *  @brief Retrieves the tile index for a given position.
      *
@@ -606,10 +1047,13 @@ namespace Grain {
      */
     int64_t CVF2TileManager::tileIndexAtTileManagerPos(const Vec2d& pos, Vec2i& out_tile_xy_index) noexcept {
 
-        int32_t xi = static_cast<int32_t>((pos.x_ - scan_xy_range_dbl_.min_x_) / tile_width_);
-        int32_t yi = static_cast<int32_t>((pos.y_ - scan_xy_range_dbl_.min_y_) / tile_height_);
+        double fx = (pos.x_ - scan_xy_range_dbl_.min_x_) / tile_width_;
+        double fy = (pos.y_ - scan_xy_range_dbl_.min_y_) / tile_height_;
 
-        if (xi >= 0 && xi < x_tile_count_ && yi >= 0 && yi < y_tile_count_) {
+        // Range checked before the conversion, NaN positions fail here
+        if (fx > -1.0 && fx < x_tile_count_ && fy > -1.0 && fy < y_tile_count_) {
+            auto xi = static_cast<int32_t>(fx);
+            auto yi = static_cast<int32_t>(fy);
             out_tile_xy_index.x_ = xi;
             out_tile_xy_index.y_ = yi;
             return static_cast<int64_t>(yi) * x_tile_count_ + xi;
@@ -650,6 +1094,85 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Constructor.
+     *
+     *  @param capacity Maximum number of open files.
+     */
+    CVF2ManagerReader::CVF2ManagerReader(int32_t capacity) {
+        slots_.resize(std::max(capacity, 1));
+    }
+
+
+    CVF2ManagerReader::~CVF2ManagerReader() {
+        for (auto& slot : slots_) {
+            if (slot.file_) {
+                slot.file_->close();
+                delete slot.file_;
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Get the CVF2 file of a tile, opening it if needed.
+     *
+     *  If all slots are in use, the least recently used file is closed.
+     *
+     *  @return The file or nullptr, if the file could not be opened.
+     */
+    CVF2File* CVF2ManagerReader::fileForTile(const CVF2Tile* tile) noexcept {
+        if (!tile) {
+            return nullptr;
+        }
+
+        use_counter_++;
+
+        if (last_slot_index_ >= 0 && slots_[last_slot_index_].tile_index_ == tile->index_) {
+            slots_[last_slot_index_].last_use_ = use_counter_;
+            return slots_[last_slot_index_].file_;
+        }
+
+        // Find the open file or the least recently used slot
+        int32_t slot_index = 0;
+        for (int32_t i = 0; i < static_cast<int32_t>(slots_.size()); i++) {
+            auto& slot = slots_[i];
+            if (slot.tile_index_ == tile->index_) {
+                slot.last_use_ = use_counter_;
+                last_slot_index_ = i;
+                return slot.file_;
+            }
+            if (slot.last_use_ < slots_[slot_index].last_use_) {
+                slot_index = i;
+            }
+        }
+
+        auto& slot = slots_[slot_index];
+        if (slot.file_) {
+            slot.file_->close();
+            delete slot.file_;
+            slot.file_ = nullptr;
+            slot.tile_index_ = -1;
+            close_n_++;
+        }
+
+        slot.file_ = new (std::nothrow) CVF2File(tile->file_path_);
+        if (!slot.file_) {
+            last_slot_index_ = -1;
+            open_failed_n_++;
+            return nullptr;
+        }
+
+        slot.file_->startRead();
+        slot.tile_index_ = tile->index_;
+        slot.last_use_ = use_counter_;
+        last_slot_index_ = slot_index;
+        open_n_++;
+
+        return slot.file_;
+    }
+
+
     CVF2File* CVF2TileManager::cvf2FileForTile(CVF2Tile* tile) noexcept {
 
         try {
@@ -983,6 +1506,9 @@ namespace Grain {
      *  Projects a geographic region, specified by `bbox`, into a coordinate system
      *  defined by `srid` and renders it to the provided `ValueGrid`.
      *
+     *  Unless `reprojectionMaxError()` is 0, the reprojection into the tile
+     *  SRID is approximated with a `GeoProjApprox` within that error.
+     *
      *  @param srid The SRID for the target projection. For example, use 3857 for Web Mercator.
      *  @param bbox The geographic bounding box of the region in SRID 4326 (WGS 84)
      *         coordinates.
@@ -1008,6 +1534,12 @@ namespace Grain {
 
             antialias_level = std::clamp<int32_t>(antialias_level, 1, 16);
 
+            ReaderLease lease(this);
+            auto reader = lease.reader();
+            if (!reader) {
+                throw ErrorCode::MemCantAllocate;
+            }
+
             GeoProj proj_wgs84_to_dst;
             proj_wgs84_to_dst.setSrcSRID(4326);
             proj_wgs84_to_dst.setDstSRID(srid);
@@ -1033,44 +1565,80 @@ namespace Grain {
             int32_t w = out_value_grid->width();
             int32_t h = out_value_grid->height();
 
+            // Approximated reprojection, covering all sample positions
+            GeoProjApprox proj_approx(&proj_dst_to_tm);
+            if (reprojection_max_error_ > 0.0) {
+                Vec2d corner1, corner2;
+                remap_vg_to_tm.mapVec2(Vec2d(0.0, 0.0), corner1);
+                remap_vg_to_tm.mapVec2(Vec2d(w, h), corner2);
+                Rectd src_rect(std::min(corner1.x_, corner2.x_), std::min(corner1.y_, corner2.y_),
+                               std::fabs(corner2.x_ - corner1.x_), std::fabs(corner2.y_ - corner1.y_));
+                // Cells smaller than about 8 pixels would need more exact transformations than they save
+                int32_t max_depth = 0;
+                while (max_depth < GeoProjApprox::kMaxDepth && (std::max(w, h) >> (max_depth + 1)) >= 8) {
+                    max_depth++;
+                }
+                proj_approx.setup(src_rect, reprojection_max_error_, max_depth);
+            }
+
+            auto transform_to_tm = [&](const Vec2d& pos, Vec2d& out_pos) {
+                return proj_approx.isSetup() ? proj_approx.transform(pos, out_pos) : proj_dst_to_tm.transform(pos, out_pos);
+            };
+
             Vec2d pos_vg;
             Vec2d pos_dst;
-            Vec2d pos_tm;
 
             out_value_grid->invalidate();
 
-            if (antialias_level > 1) {
-                // Antialiasing applied
-                double aa_scale = 1.0 / (antialias_level - 1);
-                double value_scale = 1.0 / (antialias_level * antialias_level);
-                for (int32_t y = 0; y < h; y++) {
+            // Positions of one row are reprojected first and then read in one
+            // go, grouped by tile
+            int32_t aa_n = antialias_level * antialias_level;
+            std::vector<Vec2d> row_positions(static_cast<size_t>(w) * aa_n);
+            std::vector<int64_t> row_values(row_positions.size());
+
+            double aa_scale = antialias_level > 1 ? 1.0 / (antialias_level - 1) : 0.0;
+
+            for (int32_t y = 0; y < h; y++) {
+                size_t i = 0;
+                for (int32_t x = 0; x < w; x++) {
+                    for (int32_t aa_y = 0; aa_y < antialias_level; aa_y++) {
+                        for (int32_t aa_x = 0; aa_x < antialias_level; aa_x++) {
+                            pos_vg.x_ = x + aa_x * aa_scale;
+                            pos_vg.y_ = h - 1 - y + aa_y * aa_scale;
+                            remap_vg_to_tm.mapVec2(pos_vg, pos_dst);
+                            if (!transform_to_tm(pos_dst, row_positions[i])) {
+                                row_positions[i] = Vec2d(NAN, NAN);     // Outside the projection, no value
+                            }
+                            i++;
+                        }
+                    }
+                }
+
+                auto err = _sampleMany(row_positions.data(), static_cast<int64_t>(row_positions.size()), SampleMode::Nearest, reader, nullptr, row_values.data());
+                if (err != ErrorCode::None) {
+                    throw err;
+                }
+
+                if (antialias_level > 1) {
+                    // Antialiasing applied, the mean of the defined samples
+                    const int64_t* values = row_values.data();
                     for (int32_t x = 0; x < w; x++) {
-                        // Antialiasing steps
                         double value = 0.0;
-                        for (int32_t aa_y = 0; aa_y < antialias_level; aa_y++) {
-                            for (int32_t aa_x = 0; aa_x < antialias_level; aa_x++) {
-                                pos_vg.x_ = x + aa_x * aa_scale;
-                                pos_vg.y_ = h - 1 - y +  aa_y * aa_scale;
-                                remap_vg_to_tm.mapVec2(pos_vg, pos_dst);
-                                proj_dst_to_tm.transform(pos_dst, pos_tm);
-                                value += valueAtPos(pos_tm);
-                                out_value_grid->setValueAtXY(x, y, value);
+                        int32_t defined_n = 0;
+                        for (int32_t j = 0; j < aa_n; j++) {
+                            if (values[j] != CVF2::kUndefinedValue) {
+                                value += static_cast<double>(values[j]);
+                                defined_n++;
                             }
                         }
-                        value *= value_scale;
+                        values += aa_n;
+                        out_value_grid->setValueAtXY(x, y, defined_n > 0 ? static_cast<int64_t>(std::round(value / defined_n)) : CVF2::kUndefinedValue);
                     }
                 }
-            }
-            else {
-                // No antialiasing applied
-                for (int32_t y = 0; y < h; y++) {
+                else {
+                    // No antialiasing applied
                     for (int32_t x = 0; x < w; x++) {
-                        pos_vg.x_ = x;
-                        pos_vg.y_ = h - 1 - y;
-                        remap_vg_to_tm.mapVec2(pos_vg, pos_dst);
-                        proj_dst_to_tm.transform(pos_dst, pos_tm);
-                        auto value = valueAtPos(pos_tm);
-                        out_value_grid->setValueAtXY(x, y, value);
+                        out_value_grid->setValueAtXY(x, y, row_values[x]);
                     }
                 }
             }
@@ -1078,6 +1646,9 @@ namespace Grain {
         catch (ErrorCode err) {
             result = err;
         }
+        catch (const std::exception& e) {
+            result = ErrorCode::StdCppException;
+        }
 
         out_value_grid->updateMinMax();
 
@@ -1178,43 +1749,17 @@ namespace Grain {
             meta_value_grid->setInvalidValue(CVF2::kUndefinedValue);
 
 
+            // Single threaded, see `CVF2PyramidBuilder` for rendering on multiple threads
             int64_t index = start_index;
             Vec2i tile_index;
+            String file_path;
             while (mtr.nextTilePos(end_index, tile_index)) {
 
-                // TODO: Implement multithreading!
-
-                // Preparation for rendering a single meta-tile
-                Vec2d top_left;
-                Vec2d bottom_right;
-                Geo::wgs84FromTileIndex(zoom, tile_index, top_left);
-                Geo::wgs84FromTileIndex(zoom, tile_index + Vec2i(mtr.gridSize(), mtr.gridSize()), bottom_right);
-                Bounds2d tile_bbox = { top_left.x_, bottom_right.y_, bottom_right.x_, top_left.y_ };
-
-                Bounds2d tile_bbox_crs;
-                wgs84_to_tile_proj_.transform(tile_bbox, tile_bbox_crs);
-
-
-                // Render to a value grid
-                ErrorCode err = renderToValueGrid(3857, tile_bbox, antialias_level, meta_value_grid);
+                auto err = renderMetaTile(dst_path, zoom, tile_index, antialias_level, meta_value_grid, file_path);
                 if (err != ErrorCode::None) { throw err; }
 
-                meta_value_grid->setGeoInfo(4326, tile_bbox);
-
-                // Save file
-                String meta_dir_path;
-                String meta_file_name;
-                Geo::metaTilePathForTile(dst_path, zoom, tile_index, "cvf", meta_dir_path, meta_file_name);
-
-                if (!File::makeDirs(meta_dir_path)) {
-                    throw ErrorCode::FileDirNotFound;
-                }
-
-                String file_path = meta_dir_path + "/" + meta_file_name;
                 std::cout << index << " of " << mtr.metaTilesNeeded() << ": " << file_path << std::endl;
 
-                meta_value_grid->writeCVF2File(file_path, LengthUnit::GeoDegrees, 2, 4);
-
                 index++;
                 if (index > end_index) {
                     break;
@@ -1236,6 +1781,77 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Renders a single meta tile and writes it to a CVF2 file.
+     *
+     *  Thread safe, as long as each thread uses its own `meta_value_grid`.
+     *
+     *  @param dst_path The base directory path for the meta tiles.
+     *  @param zoom The zoom level.
+     *  @param tile_index Index of the top left tile of the meta tile.
+     *  @param antialias_level The antialiasing level, ranging from 1 to 16.
+     *  @param meta_value_grid Value grid with the size of a meta tile, used for rendering.
+     *  @param[out] out_file_path Path of the written file.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode CVF2TileManager::renderMetaTile(const String& dst_path, int32_t zoom, const Vec2i& tile_index, int32_t antialias_level, ValueGrid<int64_t>* meta_value_grid, String& out_file_path) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!meta_value_grid) { throw ErrorCode::NullData; }
+
+            Bounds2d tile_bbox;
+            metaTileWGS84Bbox(zoom, tile_index, tile_bbox);
+
+            // Render to a value grid
+            ErrorCode err = renderToValueGrid(3857, tile_bbox, antialias_level, meta_value_grid);
+            if (err != ErrorCode::None) { throw err; }
+
+            meta_value_grid->setGeoInfo(4326, tile_bbox);
+
+            // Save file
+            String meta_dir_path;
+            String meta_file_name;
+            Geo::metaTilePathForTile(dst_path, zoom, tile_index, "cvf", meta_dir_path, meta_file_name);
+
+            if (!File::makeDirs(meta_dir_path)) {
+                throw ErrorCode::FileDirNotFound;
+            }
+
+            out_file_path = meta_dir_path + "/" + meta_file_name;
+
+            err = meta_value_grid->writeCVF2File(out_file_path, LengthUnit::GeoDegrees, 2, 4);
+            if (err != ErrorCode::None) { throw err; }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (...) {
+            result = ErrorCode::Unknown;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Bounding box of a meta tile in SRID 4326.
+     *
+     *  @param zoom The zoom level.
+     *  @param tile_index Index of the top left tile of the meta tile.
+     *  @param[out] out_bbox The bounding box.
+     */
+    void CVF2TileManager::metaTileWGS84Bbox(int32_t zoom, const Vec2i& tile_index, Bounds2d& out_bbox) noexcept {
+
+        Vec2d top_left;
+        Vec2d bottom_right;
+        Geo::wgs84FromTileIndex(zoom, tile_index, top_left);
+        Geo::wgs84FromTileIndex(zoom, tile_index + Vec2i(GeoMetaTileRange::kGridSize, GeoMetaTileRange::kGridSize), bottom_right);
+        out_bbox.set(top_left.x_, bottom_right.y_, bottom_right.x_, top_left.y_);
+    }
+
+
     /**
      *  @brief Renders zoom levels below a given source zoom level.
      *
@@ -1251,11 +1867,8 @@ namespace Grain {
     ErrorCode CVF2TileManager::renderDownsampledMetaTiles(const String& base_path, int32_t srid, int32_t src_zoom, int32_t meta_tile_size, const Bounds2d& bbox) noexcept {
 
         // TODO: Logging!
-        // TODO: Multitreading!
         // TODO: Overwrite mode or check existing tile mode!
 
-        const Vec2i tr[4] = { Vec2i(2, 2), Vec2i(6, 2), Vec2i(2, 6), Vec2i(6, 6) };
-
         auto result = ErrorCode::None;
 
         ValueGridl* value_grid = nullptr;
@@ -1273,75 +1886,110 @@ namespace Grain {
             value_grid = new (std::nothrow) ValueGridl(meta_tile_size, meta_tile_size);
             if (!value_grid) { throw ErrorCode::ClassInstantiationFailed; }
 
-            value_grid->setInvalidValue(value_grid->minValueForType());
-
+            // Single threaded, see `CVF2PyramidBuilder` for rendering on multiple threads
             Vec2i tile_index;
+            String file_path;
             int32_t file_index = 0;
             while (mtr.nextTilePos(tile_index)) {
 
                 std::cout << file_index << " of " << mtr.metaTilesNeeded() << std::endl;
 
-                value_grid->invalidate();
+                auto err = renderDownsampledMetaTile(base_path, srid, src_zoom, tile_index, value_grid, &sub_value_grid, file_path);
+                if (err != ErrorCode::None) { throw err; }
+
+                file_index++;
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (...) {
+            result = ErrorCode::Unknown;
+        }
+
+        // Cleanup
+        delete value_grid;
+        delete sub_value_grid;
+
+        return result;
+    }
+
 
-                Vec2d tile_center_dst[4];
-                String file_path;
-                Bounds2Fix tile_bbox;
-                tile_bbox.initForMinMaxSearch();
+    /**
+     *  @brief Renders a single downsampled meta tile from its four source
+     *         meta tiles at the next higher zoom level.
+     *
+     *  Missing source meta tiles leave their quadrant undefined. Thread safe,
+     *  as long as each thread uses its own value grids.
+     *
+     *  @param base_path The base directory path for the tiles.
+     *  @param srid Spatial Reference System Identifier (SRID) of the tiles.
+     *  @param src_zoom The zoom level of the source meta tiles.
+     *  @param tile_index Index of the top left tile of the meta tile at `src_zoom - 1`.
+     *  @param value_grid Value grid with the size of a meta tile, used for rendering.
+     *  @param sub_value_grid_ptr Pointer to a value grid pointer, used for reading the
+     *                            source meta tiles, the value grid is allocated if needed
+     *                            and must be deleted by the caller.
+     *  @param[out] out_file_path Path of the written file.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode CVF2TileManager::renderDownsampledMetaTile(const String& base_path, int32_t srid, int32_t src_zoom, const Vec2i& tile_index, ValueGridl* value_grid, ValueGridl** sub_value_grid_ptr, String& out_file_path) noexcept {
 
-                for (int32_t i = 0; i < 4; i++) {
+        auto result = ErrorCode::None;
 
-                    Geo::wgs84FromTileIndex(dst_zoom, tile_index + tr[i], tile_center_dst[i]);
-                    Vec2i tile_index_src;
-                    Geo::wgs84ToTileIndex(src_zoom, tile_center_dst[i], tile_index_src);
+        try {
+            if (!value_grid || !sub_value_grid_ptr) { throw ErrorCode::NullData; }
+            if (src_zoom < 1) { throw ErrorCode::BadArgs; }
 
-                    Geo::metaTilePathForTile(base_path, src_zoom, tile_index_src, "cvf", file_path);
+            int32_t dst_zoom = src_zoom - 1;
 
-                    if (File::fileExists(file_path)) {
-                        CVF2File cvf2_file(file_path);
-                        cvf2_file.startRead();
+            value_grid->setInvalidValue(value_grid->minValueForType());
+            value_grid->invalidate();
 
-                        if (cvf2_file.srid() == srid) {
-                            tile_bbox += cvf2_file.range();
+            Vec2i src_tile_indices[4];
+            downsampledMetaTileSources(src_zoom, tile_index, src_tile_indices);
 
-                            auto err = cvf2_file.buildValueGrid(&sub_value_grid);
-                            if (err != ErrorCode::None) { throw err; }
+            String file_path;
+            Bounds2Fix tile_bbox;
+            tile_bbox.initForMinMaxSearch();
 
-                            value_grid->fillMipmapQuadrant(sub_value_grid, i);
-                        }
-                    }
-                    else {
-                        // TODO: !!!
-                    }
-                }
+            for (int32_t i = 0; i < 4; i++) {
 
-                value_grid->setGeoInfo(4326, tile_bbox);
-                value_grid->updateMinMax();
+                Geo::metaTilePathForTile(base_path, src_zoom, src_tile_indices[i], "cvf", file_path);
 
-                GeoProj proj(srid, 4326);
-                auto center = tile_bbox.centerAsVec2d();
-                proj.transform(center);
+                if (File::fileExists(file_path)) {
+                    CVF2File cvf2_file(file_path);
+                    cvf2_file.startRead();
 
-                {
-                    String dir_path;
-                    String file_name;
-                    Geo::metaTilePathForTile(base_path, dst_zoom, tile_index, "cvf", dir_path, file_name);
+                    if (cvf2_file.srid() == srid) {
+                        tile_bbox += cvf2_file.range();
 
-                    File::makeDirs(dir_path);
-                    value_grid->writeCVF2File(dir_path + "/" + file_name, LengthUnit::GeoDegrees, 1, 4);
+                        auto err = cvf2_file.buildValueGrid(sub_value_grid_ptr);
+                        if (err != ErrorCode::None) { throw err; }
 
-                    /*
-                    auto img = value_grid->buildImage();
-                    if (img) {
-                        Geo::metaTilePathForTile(base_path, dst_zoom, tile_index, "jpg", dir_path, file_name);
-                        img->normalize();
-                        img->writeJpg(dir_path + "/" + file_name);
-                        delete img;
+                        value_grid->fillMipmapQuadrant(*sub_value_grid_ptr, i);
                     }
-                     */
                 }
+                else {
+                    // TODO: !!!
+                }
+            }
 
-                file_index++;
+            value_grid->setGeoInfo(4326, tile_bbox);
+            value_grid->updateMinMax();
+
+            String dir_path;
+            String file_name;
+            Geo::metaTilePathForTile(base_path, dst_zoom, tile_index, "cvf", dir_path, file_name);
+
+            if (!File::makeDirs(dir_path)) {
+                throw ErrorCode::FileDirNotFound;
             }
+
+            out_file_path = dir_path + "/" + file_name;
+
+            auto err = value_grid->writeCVF2File(out_file_path, LengthUnit::GeoDegrees, 1, 4);
+            if (err != ErrorCode::None) { throw err; }
         }
         catch (ErrorCode err) {
             result = err;
@@ -1350,14 +1998,31 @@ namespace Grain {
             result = ErrorCode::Unknown;
         }
 
-        // Cleanup
-        delete value_grid;
-        delete sub_value_grid;
-
         return result;
     }
 
 
+    /**
+     *  @brief Indices of the four source meta tiles of a downsampled meta tile.
+     *
+     *  @param src_zoom The zoom level of the source meta tiles.
+     *  @param tile_index Index of the top left tile of the meta tile at `src_zoom - 1`.
+     *  @param[out] out_src_tile_indices Four tile indices at `src_zoom`, one in each
+     *              source meta tile, in the quadrant order of
+     *              `ValueGrid::fillMipmapQuadrant()`.
+     */
+    void CVF2TileManager::downsampledMetaTileSources(int32_t src_zoom, const Vec2i& tile_index, Vec2i* out_src_tile_indices) noexcept {
+
+        const Vec2i tr[4] = { Vec2i(2, 2), Vec2i(6, 2), Vec2i(2, 6), Vec2i(6, 6) };
+
+        for (int32_t i = 0; i < 4; i++) {
+            Vec2d tile_center_dst;
+            Geo::wgs84FromTileIndex(src_zoom - 1, tile_index + tr[i], tile_center_dst);
+            Geo::wgs84ToTileIndex(src_zoom, tile_center_dst, out_src_tile_indices[i]);
+        }
+    }
+
+
     void CVF2TileManager::saveLog(const String& log_file_path) noexcept {
 
         try {
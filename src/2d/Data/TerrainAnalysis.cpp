@@ -0,0 +1,714 @@
+//
+//  TerrainAnalysis.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "2d/Data/TerrainAnalysis.hpp"
+#include "2d/Data/CVF2TileManager.hpp"
+#include "2d/Polygon.hpp"
+#include "2d/GraphicCompoundPath.hpp"
+#include "2d/GraphicPath.hpp"
+#include "Image/Image.hpp"
+#include "Geo/GeoProj.hpp"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <numbers>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Load row `y` of `grid` as float values into `out_values`.
+     *
+     *  `out_values` receives `width + 2` values, the first and last value
+     *  repeat the border values. Rows outside the grid are clamped, invalid
+     *  values become NaN.
+     */
+    template <typename T>
+    void TerrainAnalysis::_loadRow(const ValueGrid<T>& grid, int32_t y, float* out_values) noexcept {
+        int32_t width = grid.width();
+        y = std::clamp(y, 0, grid.height() - 1);
+
+        bool check_invalid = grid.hasFeature(ValueGrid<T>::kFeature_Invalid_Value);
+        T invalid_value = grid.invalidValue();
+        float* dst = out_values + 1;
+
+        const T* row = grid.ptrForRow(y);
+        if (row) {
+            for (int32_t x = 0; x < width; x++) {
+                T v = row[x];
+                dst[x] = check_invalid && v == invalid_value ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(v);
+            }
+        }
+        else {
+            for (int32_t x = 0; x < width; x++) {
+                T v = grid.valueAtXY(x, y);
+                dst[x] = check_invalid && v == invalid_value ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(v);
+            }
+        }
+
+        out_values[0] = dst[0];
+        out_values[width + 1] = dst[width - 1];
+    }
+
+
+    /**
+     *  @brief Run `kernel` for all output rows and pass the results to `store`.
+     *
+     *  Each thread processes a band of consecutive rows and keeps the three
+     *  source rows of the current output row, so every source row is
+     *  converted once per band.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::_process(const ValueGrid<T>& grid, const Params& params, int32_t out_width, int32_t out_height, bool single_thread, const RowKernel& kernel, const RowStore& store) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!grid.hasValues()) {
+                throw ErrorCode::NoData;
+            }
+
+            if (out_width < 1 || out_height < 1 ||
+                outputWidth(grid.width(), params) != out_width ||
+                outputHeight(grid.height(), params) != out_height) {
+                throw ErrorCode::UnsupportedDimension;
+            }
+
+            if (params.cell_size_x_ <= 0.0 || params.cell_size_y_ <= 0.0) {
+                throw ErrorCode::BadArgs;
+            }
+
+            int32_t offset = params.halo_ ? 1 : 0;
+            int32_t row_length = grid.width() + 2;
+
+            int32_t thread_count = params.thread_count_;
+            if (thread_count < 1) {
+                thread_count = static_cast<int32_t>(std::thread::hardware_concurrency());
+            }
+            if (single_thread || grid.isMapped()) {
+                // Tiles of mapped grids are not thread-safe
+                thread_count = 1;
+            }
+            thread_count = std::clamp(thread_count, 1, out_height);
+
+            std::atomic<bool> failed{false};
+
+            auto process_band = [&](int32_t y0, int32_t y1) {
+                try {
+                    std::vector<float> buffer(static_cast<size_t>(row_length) * 3);
+                    std::vector<float> out_values(out_width);
+                    float* rows[3] = { buffer.data(), buffer.data() + row_length, buffer.data() + 2 * row_length };
+
+                    _loadRow(grid, y0 + offset - 1, rows[0]);
+                    _loadRow(grid, y0 + offset, rows[1]);
+
+                    for (int32_t y = y0; y < y1 && !failed; y++) {
+                        _loadRow(grid, y + offset + 1, rows[2]);
+                        kernel(rows[0] + offset, rows[1] + offset, rows[2] + offset, out_width, out_values.data());
+                        store(y, out_values.data(), out_width);
+
+                        float* row = rows[0];
+                        rows[0] = rows[1];
+                        rows[1] = rows[2];
+                        rows[2] = row;
+                    }
+                }
+                catch (...) {
+                    failed = true;
+                }
+            };
+
+            if (thread_count == 1) {
+                process_band(0, out_height);
+            }
+            else {
+                std::vector<std::thread> threads;
+                for (int32_t i = 0; i < thread_count; i++) {
+                    int32_t y0 = static_cast<int32_t>(static_cast<int64_t>(out_height) * i / thread_count);
+                    int32_t y1 = static_cast<int32_t>(static_cast<int64_t>(out_height) * (i + 1) / thread_count);
+                    threads.emplace_back(process_band, y0, y1);
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            if (failed) {
+                throw ErrorCode::ComputationFailed;
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::exception& e) {
+            result = ErrorCode::StdCppException;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Run `kernel` and write the results to `out_grid`, NaN results
+     *         become invalid values.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::_processToGrid(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid, const RowKernel& kernel) noexcept {
+
+        if (!out_grid || !out_grid->hasValues()) {
+            return ErrorCode::NullData;
+        }
+
+        if (out_grid->isMapped() && !out_grid->tiles()->isWritable()) {
+            return ErrorCode::UnsupportedSettings;
+        }
+
+        if (!out_grid->hasFeature(ValueGridf::kFeature_Invalid_Value)) {
+            out_grid->setInvalidValueDefault();
+        }
+        float invalid_value = out_grid->invalidValue();
+
+        auto result = _process(grid, params, out_grid->width(), out_grid->height(), out_grid->isMapped(), kernel,
+            [&](int32_t y, const float* values, int32_t n) {
+                float* dst = out_grid->mutPtrForRow(y);
+                if (dst) {
+                    for (int32_t x = 0; x < n; x++) {
+                        dst[x] = std::isnan(values[x]) ? invalid_value : values[x];
+                    }
+                }
+                else {
+                    for (int32_t x = 0; x < n; x++) {
+                        out_grid->setValueAtXY(x, y, std::isnan(values[x]) ? invalid_value : values[x]);
+                    }
+                }
+            });
+
+        if (result == ErrorCode::None) {
+            out_grid->updateMinMax();
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Row kernel for one of the `kMode...` values.
+     *
+     *  With the 3 x 3 neighbourhood
+     *
+     *      a b c
+     *      d e f
+     *      g h i
+     *
+     *  the gradient after Horn is
+     *
+     *      dz/dx = ((c + 2f + i) - (a + 2d + g)) / (8 * cell_size_x)
+     *      dz/dy = ((a + 2b + c) - (g + 2h + i)) / (8 * cell_size_y)
+     *
+     *  with y pointing north. The center `e` is not part of the gradient,
+     *  `e - e` is added to propagate an invalid center.
+     */
+    TerrainAnalysis::RowKernel TerrainAnalysis::_kernel(const Params& params, int32_t mode) noexcept {
+
+        constexpr float kRadToDeg = static_cast<float>(180.0 / std::numbers::pi);
+
+        const float kx = static_cast<float>(params.z_factor_ / (8.0 * params.cell_size_x_));
+        const float ky = static_cast<float>((params.north_at_top_ ? 1.0 : -1.0) * params.z_factor_ / (8.0 * params.cell_size_y_));
+
+        switch (mode) {
+            case kModeSlope:
+                // Slope in degrees
+                return [=](const float* r0, const float* r1, const float* r2, int32_t n, float* out_values) {
+                    for (int32_t x = 0; x < n; x++) {
+                        float p = ((r0[x + 2] + 2.0f * r1[x + 2] + r2[x + 2]) - (r0[x] + 2.0f * r1[x] + r2[x])) * kx;
+                        float q = ((r0[x] + 2.0f * r0[x + 1] + r0[x + 2]) - (r2[x] + 2.0f * r2[x + 1] + r2[x + 2])) * ky;
+                        out_values[x] = std::atan(std::sqrt(p * p + q * q)) * kRadToDeg + (r1[x + 1] - r1[x + 1]);
+                    }
+                };
+
+            case kModeAspect:
+                // Direction of the steepest descent, clockwise from north in degrees, -1 for flat cells
+                return [=](const float* r0, const float* r1, const float* r2, int32_t n, float* out_values) {
+                    for (int32_t x = 0; x < n; x++) {
+                        float p = ((r0[x + 2] + 2.0f * r1[x + 2] + r2[x + 2]) - (r0[x] + 2.0f * r1[x] + r2[x])) * kx;
+                        float q = ((r0[x] + 2.0f * r0[x + 1] + r0[x + 2]) - (r2[x] + 2.0f * r2[x + 1] + r2[x + 2])) * ky;
+                        float a = std::atan2(-p, -q) * kRadToDeg;
+                        a = a < 0.0f ? a + 360.0f : a;
+                        out_values[x] = (p == 0.0f && q == 0.0f ? -1.0f : a) + (r1[x + 1] - r1[x + 1]);
+                    }
+                };
+
+            case kModeCurvature: {
+                // Total curvature after Zevenbergen and Thorne, positive for convex cells
+                const float cx = static_cast<float>(params.z_factor_ / (params.cell_size_x_ * params.cell_size_x_));
+                const float cy = static_cast<float>(params.z_factor_ / (params.cell_size_y_ * params.cell_size_y_));
+                return [=](const float* r0, const float* r1, const float* r2, int32_t n, float* out_values) {
+                    for (int32_t x = 0; x < n; x++) {
+                        float e = r1[x + 1];
+                        float d = ((r1[x] + r1[x + 2]) * 0.5f - e) * cx;
+                        float f = ((r0[x + 1] + r2[x + 1]) * 0.5f - e) * cy;
+                        out_values[x] = -2.0f * (d + f);
+                    }
+                };
+            }
+
+            case kModeHillshade:
+            default: {
+                // Illumination 0 to 1, the dot product of the surface normal
+                // (-p, -q, 1) / sqrt(1 + p^2 + q^2) and the light direction
+                const double zenith = (90.0 - std::clamp(params.altitude_, 0.0, 90.0)) * std::numbers::pi / 180.0;
+                const float light_z = static_cast<float>(std::cos(zenith));
+
+                if (!params.multidirectional_) {
+                    const double azimuth = params.azimuth_ * std::numbers::pi / 180.0;
+                    const float light_x = static_cast<float>(std::sin(zenith) * std::sin(azimuth));
+                    const float light_y = static_cast<float>(std::sin(zenith) * std::cos(azimuth));
+
+                    return [=](const float* r0, const float* r1, const float* r2, int32_t n, float* out_values) {
+                        for (int32_t x = 0; x < n; x++) {
+                            float p = ((r0[x + 2] + 2.0f * r1[x + 2] + r2[x + 2]) - (r0[x] + 2.0f * r1[x] + r2[x])) * kx;
+                            float q = ((r0[x] + 2.0f * r0[x + 1] + r0[x + 2]) - (r2[x] + 2.0f * r2[x + 1] + r2[x + 2])) * ky;
+                            float shade = (light_z - p * light_x - q * light_y) / std::sqrt(1.0f + p * p + q * q);
+                            out_values[x] = std::max(shade, 0.0f) + (r1[x + 1] - r1[x + 1]);
+                        }
+                    };
+                }
+
+                // Four light directions, each weighted by sin^2 of the angle
+                // between aspect and light azimuth. The weights sum up to 2.
+                float light_x[4], light_y[4], azimuth_x[4], azimuth_y[4];
+                for (int32_t i = 0; i < 4; i++) {
+                    double azimuth = (225.0 + i * 45.0) * std::numbers::pi / 180.0;
+                    azimuth_x[i] = static_cast<float>(std::sin(azimuth));
+                    azimuth_y[i] = static_cast<float>(std::cos(azimuth));
+                    light_x[i] = static_cast<float>(std::sin(zenith)) * azimuth_x[i];
+                    light_y[i] = static_cast<float>(std::sin(zenith)) * azimuth_y[i];
+                }
+
+                return [=](const float* r0, const float* r1, const float* r2, int32_t n, float* out_values) {
+                    for (int32_t x = 0; x < n; x++) {
+                        float p = ((r0[x + 2] + 2.0f * r1[x + 2] + r2[x + 2]) - (r0[x] + 2.0f * r1[x] + r2[x])) * kx;
+                        float q = ((r0[x] + 2.0f * r0[x + 1] + r0[x + 2]) - (r2[x] + 2.0f * r2[x + 1] + r2[x + 2])) * ky;
+                        float inv_norm = 1.0f / std::sqrt(1.0f + p * p + q * q);
+                        float gradient = std::sqrt(p * p + q * q);
+
+                        // Downhill direction, flat cells get equal weights
+                        float inv_gradient = gradient > 0.0f ? 1.0f / gradient : 0.0f;
+                        float down_x = -p * inv_gradient;
+                        float down_y = -q * inv_gradient;
+                        float flat_weight = gradient > 0.0f ? 0.0f : 0.5f;
+
+                        float sum = 0.0f;
+                        for (int32_t i = 0; i < 4; i++) {
+                            float shade = std::max((light_z - p * light_x[i] - q * light_y[i]) * inv_norm, 0.0f);
+                            float c = down_x * azimuth_x[i] + down_y * azimuth_y[i];
+                            sum += (1.0f - c * c - flat_weight) * shade;
+                        }
+                        out_values[x] = sum * 0.5f + (r1[x + 1] - r1[x + 1]);
+                    }
+                };
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Slope in degrees, 0 for flat cells.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::slope(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept {
+        return _processToGrid(grid, params, out_grid, _kernel(params, kModeSlope));
+    }
+
+
+    /**
+     *  @brief Aspect, the direction of the steepest descent clockwise from
+     *         north in degrees, -1 for flat cells.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::aspect(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept {
+        return _processToGrid(grid, params, out_grid, _kernel(params, kModeAspect));
+    }
+
+
+    /**
+     *  @brief Total curvature, positive for convex, negative for concave cells.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::curvature(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept {
+        return _processToGrid(grid, params, out_grid, _kernel(params, kModeCurvature));
+    }
+
+
+    /**
+     *  @brief Hillshade, illumination from 0 to 1.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::hillshade(const ValueGrid<T>& grid, const Params& params, ValueGridf* out_grid) noexcept {
+        return _processToGrid(grid, params, out_grid, _kernel(params, kModeHillshade));
+    }
+
+
+    /**
+     *  @brief Hillshade into an image.
+     *
+     *  The illumination is written to all color components of a float or
+     *  8 bit image. The alpha component, if present, is 0 for invalid cells
+     *  and 1 otherwise.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::hillshade(const ValueGrid<T>& grid, const Params& params, Image* out_image) noexcept {
+
+        if (!out_image || !out_image->hasPixel()) {
+            return ErrorCode::NullData;
+        }
+
+        auto pixel_type = out_image->pixelType();
+        if (pixel_type != Image::PixelType::Float && pixel_type != Image::PixelType::UInt8) {
+            return ErrorCode::UnsupportedDataType;
+        }
+
+        int32_t component_count = out_image->componentsPerPixel();
+        int32_t color_count = out_image->hasAlpha() ? component_count - 1 : component_count;
+
+        return _process(grid, params, out_image->width(), out_image->height(), false, _kernel(params, kModeHillshade),
+            [&](int32_t y, const float* values, int32_t n) {
+                uint8_t* row = out_image->pixelDataPtrAtRow(y);
+                if (pixel_type == Image::PixelType::Float) {
+                    auto dst = reinterpret_cast<float*>(row);
+                    for (int32_t x = 0; x < n; x++, dst += component_count) {
+                        bool valid = !std::isnan(values[x]);
+                        for (int32_t c = 0; c < color_count; c++) {
+                            dst[c] = valid ? values[x] : 0.0f;
+                        }
+                        if (color_count < component_count) {
+                            dst[color_count] = valid ? 1.0f : 0.0f;
+                        }
+                    }
+                }
+                else {
+                    uint8_t* dst = row;
+                    for (int32_t x = 0; x < n; x++, dst += component_count) {
+                        bool valid = !std::isnan(values[x]);
+                        auto v = static_cast<uint8_t>(valid ? std::lround(std::clamp(values[x], 0.0f, 1.0f) * 255.0f) : 0);
+                        for (int32_t c = 0; c < color_count; c++) {
+                            dst[c] = v;
+                        }
+                        if (color_count < component_count) {
+                            dst[color_count] = valid ? 255 : 0;
+                        }
+                    }
+                }
+            });
+    }
+
+
+    /**
+     *  @brief Extract the contour lines at `level` by marching squares.
+     *
+     *  Lines are in grid coordinates, value (x, y) is at position (x, y).
+     *  Cells with an invalid corner have no contour, so lines end at invalid
+     *  areas and at the grid border, all other lines are closed rings.
+     *  Ambiguous saddle cells are resolved by the mean of the four corners.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::contours(const ValueGrid<T>& grid, double level, const ContourFunc& func) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!grid.hasValues()) {
+                throw ErrorCode::NoData;
+            }
+
+            int32_t width = grid.width();
+            int32_t height = grid.height();
+
+            // Edge ids, horizontal edge from (x, y) to (x + 1, y) and vertical
+            // edge from (x, y) to (x, y + 1)
+            auto h_edge = [width](int32_t x, int32_t y) { return (static_cast<int64_t>(y) * width + x) * 2; };
+            auto v_edge = [width](int32_t x, int32_t y) { return (static_cast<int64_t>(y) * width + x) * 2 + 1; };
+
+            struct Segment {
+                int64_t edges_[2];
+            };
+
+            std::vector<Segment> segments;
+            std::unordered_map<int64_t, Vec2d> edge_points;
+            std::unordered_map<int64_t, std::array<int32_t, 2>> edge_segments;
+
+            std::vector<float> buffer(static_cast<size_t>(width + 2) * 2);
+            float* rows[2] = { buffer.data(), buffer.data() + width + 2 };
+            _loadRow(grid, 0, rows[1]);
+
+            for (int32_t y = 0; y < height - 1; y++) {
+                std::swap(rows[0], rows[1]);
+                _loadRow(grid, y + 1, rows[1]);
+                const float* top = rows[0] + 1;
+                const float* bottom = rows[1] + 1;
+
+                for (int32_t x = 0; x < width - 1; x++) {
+                    // Corners top left, top right, bottom right, bottom left
+                    double v[4] = { top[x], top[x + 1], bottom[x + 1], bottom[x] };
+                    if (std::isnan(v[0]) || std::isnan(v[1]) || std::isnan(v[2]) || std::isnan(v[3])) {
+                        continue;
+                    }
+
+                    int32_t cell_case = (v[0] >= level ? 1 : 0) | (v[1] >= level ? 2 : 0) | (v[2] >= level ? 4 : 0) | (v[3] >= level ? 8 : 0);
+                    if (cell_case == 0 || cell_case == 15) {
+                        continue;
+                    }
+
+                    int64_t edge_top = h_edge(x, y);
+                    int64_t edge_right = v_edge(x + 1, y);
+                    int64_t edge_bottom = h_edge(x, y + 1);
+                    int64_t edge_left = v_edge(x, y);
+
+                    auto add_point = [&](int64_t edge, double x0, double y0, double v0, double x1, double y1, double v1) {
+                        if (edge_points.find(edge) == edge_points.end()) {
+                            double t = (level - v0) / (v1 - v0);
+                            edge_points.emplace(edge, Vec2d(x0 + t * (x1 - x0), y0 + t * (y1 - y0)));
+                        }
+                    };
+
+                    auto add_segment = [&](int64_t edge_a, int64_t edge_b) {
+                        auto index = static_cast<int32_t>(segments.size());
+                        segments.push_back({ { edge_a, edge_b } });
+                        for (int64_t edge : { edge_a, edge_b }) {
+                            auto [it, inserted] = edge_segments.try_emplace(edge, std::array<int32_t, 2>{ -1, -1 });
+                            it->second[it->second[0] < 0 ? 0 : 1] = index;
+                        }
+                    };
+
+                    // Crossing points on all edges with different sides
+                    if ((cell_case & 1) != ((cell_case >> 1) & 1)) {
+                        add_point(edge_top, x, y, v[0], x + 1, y, v[1]);
+                    }
+                    if (((cell_case >> 1) & 1) != ((cell_case >> 2) & 1)) {
+                        add_point(edge_right, x + 1, y, v[1], x + 1, y + 1, v[2]);
+                    }
+                    if (((cell_case >> 3) & 1) != ((cell_case >> 2) & 1)) {
+                        add_point(edge_bottom, x, y + 1, v[3], x + 1, y + 1, v[2]);
+                    }
+                    if ((cell_case & 1) != ((cell_case >> 3) & 1)) {
+                        add_point(edge_left, x, y, v[0], x, y + 1, v[3]);
+                    }
+
+                    switch (cell_case) {
+                        case 1: case 14: add_segment(edge_left, edge_top); break;
+                        case 2: case 13: add_segment(edge_top, edge_right); break;
+                        case 3: case 12: add_segment(edge_left, edge_right); break;
+                        case 4: case 11: add_segment(edge_right, edge_bottom); break;
+                        case 6: case 9: add_segment(edge_top, edge_bottom); break;
+                        case 7: case 8: add_segment(edge_left, edge_bottom); break;
+                        case 5:
+                        case 10: {
+                            bool center_above = (v[0] + v[1] + v[2] + v[3]) * 0.25 >= level;
+                            if ((cell_case == 5) == center_above) {
+                                // Lines separate the corners below the level
+                                add_segment(edge_top, edge_right);
+                                add_segment(edge_left, edge_bottom);
+                            }
+                            else {
+                                add_segment(edge_left, edge_top);
+                                add_segment(edge_right, edge_bottom);
+                            }
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                }
+            }
+
+            // Link segments sharing an edge into lines
+            std::vector<bool> used(segments.size(), false);
+            std::deque<int64_t> chain;
+            Polygon polygon;
+
+            auto extend = [&](bool at_back) {
+                while (true) {
+                    int64_t edge = at_back ? chain.back() : chain.front();
+                    auto& adjacent = edge_segments[edge];
+                    int32_t next = -1;
+                    for (int32_t index : adjacent) {
+                        if (index >= 0 && !used[index]) {
+                            next = index;
+                            break;
+                        }
+                    }
+                    if (next < 0) {
+                        break;
+                    }
+                    used[next] = true;
+                    auto& segment = segments[next];
+                    int64_t other = segment.edges_[0] == edge ? segment.edges_[1] : segment.edges_[0];
+                    at_back ? chain.push_back(other) : chain.push_front(other);
+                }
+            };
+
+            for (size_t i = 0; i < segments.size(); i++) {
+                if (used[i]) {
+                    continue;
+                }
+                used[i] = true;
+                chain.clear();
+                chain.push_back(segments[i].edges_[0]);
+                chain.push_back(segments[i].edges_[1]);
+
+                extend(true);
+                bool closed = chain.size() > 3 && chain.front() == chain.back();
+                if (closed) {
+                    chain.pop_back();
+                }
+                else {
+                    extend(false);
+                }
+
+                polygon.clear();
+                for (int64_t edge : chain) {
+                    polygon.addPoint(edge_points[edge]);
+                }
+                polygon.setClosed(closed);
+                func(polygon);
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::exception& e) {
+            result = ErrorCode::StdCppException;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Extract the contour lines at `level` as paths of `out_path`.
+     */
+    template <typename T>
+    ErrorCode TerrainAnalysis::contours(const ValueGrid<T>& grid, double level, GraphicCompoundPath& out_path) noexcept {
+
+        auto err = ErrorCode::None;
+
+        auto result = contours(grid, level, [&](Polygon& polygon) {
+            if (err != ErrorCode::None) {
+                return;
+            }
+            err = out_path.addEmptyPath(polygon.pointCount());
+            GraphicPath* path = out_path.lastPathPtr();
+            if (err != ErrorCode::None || !path) {
+                err = ErrorCode::MemCantAllocate;
+                return;
+            }
+            Vec2d point;
+            for (int32_t i = 0; i < polygon.pointCount(); i++) {
+                polygon.pointAtIndex(i, point);
+                path->addPoint(point);
+            }
+            if (polygon.isClosed()) {
+                path->close();
+            }
+        });
+
+        return result != ErrorCode::None ? result : err;
+    }
+
+
+    /**
+     *  @brief Render a tile with one extra cell at each border.
+     *
+     *  `bbox` is the WGS84 bounding box of the tile, `out_value_grid` must be
+     *  two cells larger than the tile in each direction. The bounding box is
+     *  expanded by one cell in the destination SRID, which assumes that the
+     *  tile is axis aligned in both systems, as for Web Mercator tiles.
+     *
+     *  `out_params` is set up for the rendered grid, cell sizes in units of
+     *  the destination SRID, halo enabled and north at top, as rendered by
+     *  `CVF2TileManager::renderToValueGrid()`. The z factor must be set to
+     *  convert values to the same unit.
+     */
+    ErrorCode TerrainAnalysis::renderWithHalo(CVF2TileManager* tile_manager, int32_t srid, const Bounds2d& bbox, int32_t antialias_level, ValueGridl* out_value_grid, Params& out_params) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!tile_manager || !out_value_grid) {
+                throw ErrorCode::NullData;
+            }
+
+            int32_t width = out_value_grid->width() - 2;
+            int32_t height = out_value_grid->height() - 2;
+            if (width < 1 || height < 1) {
+                throw ErrorCode::UnsupportedDimension;
+            }
+
+            GeoProj proj_wgs84_to_dst(4326, srid);
+            GeoProj proj_dst_to_wgs84(srid, 4326);
+            if (!proj_wgs84_to_dst.isValid() || !proj_dst_to_wgs84.isValid()) {
+                throw ErrorCode::InvalidProjection;
+            }
+
+            Bounds2d bbox_dst;
+            if (!proj_wgs84_to_dst.transform(bbox, bbox_dst)) {
+                throw ErrorCode::InvalidProjection;
+            }
+
+            double cell_size_x = bbox_dst.width() / width;
+            double cell_size_y = bbox_dst.height() / height;
+
+            Bounds2d halo_bbox_dst;
+            halo_bbox_dst.set(bbox_dst.min_x_ - cell_size_x, bbox_dst.min_y_ - cell_size_y,
+                              bbox_dst.max_x_ + cell_size_x, bbox_dst.max_y_ + cell_size_y);
+
+            Bounds2d halo_bbox;
+            if (!proj_dst_to_wgs84.transform(halo_bbox_dst, halo_bbox)) {
+                throw ErrorCode::InvalidProjection;
+            }
+
+            result = tile_manager->renderToValueGrid(srid, halo_bbox, antialias_level, out_value_grid);
+
+            out_params.cell_size_x_ = cell_size_x;
+            out_params.cell_size_y_ = cell_size_y;
+            out_params.halo_ = true;
+            out_params.north_at_top_ = true;
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+
+        return result;
+    }
+
+
+    // Instantiate for specific types
+#define GRAIN_TERRAIN_ANALYSIS_INSTANTIATE(T) \
+    template ErrorCode TerrainAnalysis::slope<T>(const ValueGrid<T>&, const Params&, ValueGridf*) noexcept; \
+    template ErrorCode TerrainAnalysis::aspect<T>(const ValueGrid<T>&, const Params&, ValueGridf*) noexcept; \
+    template ErrorCode TerrainAnalysis::curvature<T>(const ValueGrid<T>&, const Params&, ValueGridf*) noexcept; \
+    template ErrorCode TerrainAnalysis::hillshade<T>(const ValueGrid<T>&, const Params&, ValueGridf*) noexcept; \
+    template ErrorCode TerrainAnalysis::hillshade<T>(const ValueGrid<T>&, const Params&, Image*) noexcept; \
+    template ErrorCode TerrainAnalysis::contours<T>(const ValueGrid<T>&, double, const ContourFunc&) noexcept; \
+    template ErrorCode TerrainAnalysis::contours<T>(const ValueGrid<T>&, double, GraphicCompoundPath&) noexcept;
+
+    GRAIN_TERRAIN_ANALYSIS_INSTANTIATE(uint8_t)
+    GRAIN_TERRAIN_ANALYSIS_INSTANTIATE(int32_t)
+    GRAIN_TERRAIN_ANALYSIS_INSTANTIATE(int64_t)
+    GRAIN_TERRAIN_ANALYSIS_INSTANTIATE(float)
+    GRAIN_TERRAIN_ANALYSIS_INSTANTIATE(double)
+
+#undef GRAIN_TERRAIN_ANALYSIS_INSTANTIATE
+
+
+} // End of namespace Grain
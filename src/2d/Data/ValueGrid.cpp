@@ -10,6 +10,9 @@
 #include "2d/Data/ValueGrid.hpp"
 #include "Image/Image.hpp"
 #include "2d/Data/CVF2.hpp"
+#include "2d/Data/CVF2Block.hpp"
+
+#include <memory>
 
 
 namespace Grain {
@@ -51,6 +54,9 @@ namespace Grain {
 
     /**
      *  @brief Downsampling of four value grids into one.
+     *
+     *  Source grids are read block by block, so mapped grids are never fully
+     *  loaded. A mapped destination must be writable.
      */
     template <typename T>
     ErrorCode ValueGrid<T>::fourToOne(ValueGrid<T>* src_grids[4], uint8_t mask) noexcept {
@@ -58,10 +64,14 @@ namespace Grain {
         auto result = ErrorCode::None;
 
         try {
-            if (!values_) {
+            if (!hasValues()) {
                 _initMemThrow();
             }
 
+            if (tiles_ && !tiles_->isWritable()) {
+                throw ErrorCode::UnsupportedSettings;
+            }
+
             if (width_ % 2 != 0 || height_ % 2 != 0) {
                 // Width and height must be a multiple of 2
                 throw ErrorCode::UnsupportedDimension;
@@ -107,45 +117,50 @@ namespace Grain {
                     int32_t dst_y_offset = src_y_index * height_ / 2;
 
                     if (mask & bit) {
-                        auto values = src_grids[grid_index]->values_;
-
-                        for (int32_t y = 0; y < height_; y += 2) {
-
-                            for (int32_t x = 0; x < width_; x += 2) {
-                                T sum{};
-                                T v[4];
-
-                                v[0] = values[_indexForXY(x, y)];
-                                v[1] = values[_indexForXY(x + 1, y)];
-                                v[2] = values[_indexForXY(x, y + 1)];
-                                v[3] = values[_indexForXY(x + 1, y + 1)];
-
-                                int32_t n = 0;
-                                if (check_invalid) {
-
-                                    for (int32_t i = 0; i < 4; i++) {
-                                        if (v[i] != invalid_value_) {
-                                            sum += v[i];
-                                            n++;
+                        // Blocks start at even positions and have even sizes,
+                        // as width, height and tile sizes are even
+                        src_grids[grid_index]->forEachBlock([&](int32_t x0, int32_t y0, int32_t w, int32_t h, const T* values, int32_t stride) {
+
+                            for (int32_t y = 0; y < h; y += 2) {
+                                const T* row0 = values + static_cast<int64_t>(y) * stride;
+                                const T* row1 = row0 + stride;
+
+                                for (int32_t x = 0; x < w; x += 2) {
+                                    T sum{};
+                                    T v[4];
+
+                                    v[0] = row0[x];
+                                    v[1] = row0[x + 1];
+                                    v[2] = row1[x];
+                                    v[3] = row1[x + 1];
+
+                                    int32_t n = 0;
+                                    if (check_invalid) {
+
+                                        for (int32_t i = 0; i < 4; i++) {
+                                            if (v[i] != invalid_value_) {
+                                                sum += v[i];
+                                                n++;
+                                            }
                                         }
                                     }
-                                }
-                                else {
-                                    sum = v[0] + v[1] + v[2] + v[3];
-                                    n = 4;
-                                }
-
-                                if (n == 0) {
-                                    invalidateValueAtXY(dst_x_offset + x / 2, dst_y_offset + y / 2);
-                                }
-                                else {
-                                    if (n > 1) {
-                                        sum /= n;
+                                    else {
+                                        sum = v[0] + v[1] + v[2] + v[3];
+                                        n = 4;
                                     }
-                                    setValueAtXY(dst_x_offset + x / 2, dst_y_offset + y / 2, sum);
-                                }
-                            }  // End of x loop
-                        }   // End of y loop
+
+                                    if (n == 0) {
+                                        invalidateValueAtXY(dst_x_offset + (x0 + x) / 2, dst_y_offset + (y0 + y) / 2);
+                                    }
+                                    else {
+                                        if (n > 1) {
+                                            sum /= n;
+                                        }
+                                        setValueAtXY(dst_x_offset + (x0 + x) / 2, dst_y_offset + (y0 + y) / 2, sum);
+                                    }
+                                }  // End of x loop
+                            }   // End of y loop
+                        });
                     }
                     else {
                         for (int32_t y = 0; y < height_ / 2; y++) {
@@ -162,6 +177,9 @@ namespace Grain {
         catch (ErrorCode err) {
             result = err;
         }
+        catch (const Exception& e) {
+            result = e.code();
+        }
 
         return result;
     }
@@ -186,49 +204,59 @@ namespace Grain {
                 throw ErrorCode::UnsupportedDimension;
             }
 
-            if (!values_) {
+            if (!hasValues()) {
                 _initMemThrow();
             }
 
+            if (tiles_ && !tiles_->isWritable()) {
+                throw ErrorCode::UnsupportedSettings;
+            }
+
             int32_t dst_x_offset = quadrant_index & 0x1 ? width_ / 2 : 0;
             int32_t dst_y_offset = quadrant_index & 0x2 ? height_ / 2 : 0;
 
-            auto values = value_grid->values_;
+            value_grid->forEachBlock([&](int32_t x0, int32_t y0, int32_t w, int32_t h, const T* values, int32_t stride) {
 
-            for (int32_t y = 0; y < height_; y += 2) {
+                for (int32_t y = 0; y < h; y += 2) {
+                    const T* row0 = values + static_cast<int64_t>(y) * stride;
+                    const T* row1 = row0 + stride;
 
-                for (int32_t x = 0; x < width_; x += 2) {
-                    T sum{};
-                    T v[4];
+                    for (int32_t x = 0; x < w; x += 2) {
+                        T sum{};
+                        T v[4];
 
-                    v[0] = values[_indexForXY(x, y)];
-                    v[1] = values[_indexForXY(x + 1, y)];
-                    v[2] = values[_indexForXY(x, y + 1)];
-                    v[3] = values[_indexForXY(x + 1, y + 1)];
+                        v[0] = row0[x];
+                        v[1] = row0[x + 1];
+                        v[2] = row1[x];
+                        v[3] = row1[x + 1];
 
-                    int32_t n = 0;
-                    for (int32_t i = 0; i < 4; i++) {
-                        if (v[i] != invalid_value_) {
-                            sum += v[i];
-                            n++;
+                        int32_t n = 0;
+                        for (int32_t i = 0; i < 4; i++) {
+                            if (v[i] != invalid_value_) {
+                                sum += v[i];
+                                n++;
+                            }
                         }
-                    }
 
-                    if (n == 0) {
-                        invalidateValueAtXY(dst_x_offset + x / 2, dst_y_offset + y / 2);
-                    }
-                    else {
-                        if (n > 1) {
-                            sum = (T)std::round(static_cast<double>(sum) / n);
+                        if (n == 0) {
+                            invalidateValueAtXY(dst_x_offset + (x0 + x) / 2, dst_y_offset + (y0 + y) / 2);
                         }
-                        setValueAtXY(dst_x_offset + x / 2, dst_y_offset + y / 2, sum);
-                    }
-                }  // End of x loop
-            }   // End of y loop
+                        else {
+                            if (n > 1) {
+                                sum = (T)std::round(static_cast<double>(sum) / n);
+                            }
+                            setValueAtXY(dst_x_offset + (x0 + x) / 2, dst_y_offset + (y0 + y) / 2, sum);
+                        }
+                    }  // End of x loop
+                }   // End of y loop
+            });
         }
         catch (ErrorCode err) {
             result = err;
         }
+        catch (const Exception& e) {
+            result = e.code();
+        }
 
         return result;
     }
@@ -256,58 +284,97 @@ namespace Grain {
 
             file->startWriteOverwrite();
 
-            // Header
-            file->writeStr(fileSignature());
-            file->writeEndianSignature();
+            _writeHeader(file, false);
 
-            // Version
-            file->writeValue<uint16_t>(main_version_);
-            file->writeValue<uint16_t>(sub_version_);
+            // Save values
+            if (values_) {
+                _writeDataToFile(file);
+            }
+            else if (tiles_) {
+                // Row by row access to a compressed grid needs one row of tiles in the cache
+                tiles_->setCacheSize(std::max(tiles_->cacheSize(), tiles_->xTileCount()));
+                for (int32_t y = 0; y < height_; y++) {
+                    for (int32_t x = 0; x < width_; x++) {
+                        _writeTypeValue(file, *reinterpret_cast<const T*>(tiles_->valuePtr(x, y)));
+                    }
+                }
+            }
+            else {
+                throw ErrorCode::NoData;
+            }
 
-            // Data type
-            file->writeValue<uint16_t>(valueDataType());
 
-            // Dimension and position inside 2d tile array
-            file->writeValue<int32_t>(width_);
-            file->writeValue<int32_t>(height_);
-            file->writeValue<int32_t>(x_index_);
-            file->writeValue<int32_t>(y_index_);
+            file->close();
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
 
-            // Features
-            file->writeValue<uint32_t>(feature_flags_.bits());
+        // Cleanup
+        delete file;
 
-            // Feature min/max
-            if (hasFeature(kFeature_MinMax)) {
-                _writeTypeValue(file, min_value_);
-                _writeTypeValue(file, max_value_);
-            }
+        return result;
+    }
 
-            // Feature invalid value
-            if (hasFeature(kFeature_Invalid_Value)) {
-                _writeTypeValue(file, invalid_value_);
-            }
 
-            // Feature Geo information
-            if (hasFeature(kFeature_GeoInfo)) {
-                file->writeValue<int32_t>(srid_);
-                file->writeFix(bbox_.minX());
-                file->writeFix(bbox_.minY());
-                file->writeFix(bbox_.maxX());
-                file->writeFix(bbox_.maxY());
+    /**
+     *  @brief Read ValueGrid from a file.
+     *
+     *  @param file_path Path to the file where the ValueGrid should be read from.
+     *  @return `ErrorCode::None` on success, otherwise an error code.
+     */
+    template <typename T>
+    ErrorCode ValueGrid<T>::readFile(const String& file_path) noexcept {
+
+        auto result = ErrorCode::None;
+
+        File* file = nullptr;
+
+        try {
+
+            file = new (std::nothrow) File(file_path);
+            if (!file) {
+                throw ErrorCode::ClassInstantiationFailed;
             }
 
-            // Custom infos
-            writeCustomInfo();
+            file->startRead();
 
-            // Save values
-            _writeDataToFile(file);
+            _readHeader(file);
 
+            // Read values
+            if (hasFeature(kFeature_Tiles)) {
+                auto tiles = std::make_unique<ValueGridTiles>(width_, height_, static_cast<int32_t>(sizeof(T)));
+                tiles->readIndex(file);
+                tiles->map(file_path, false);
+
+                _initMemThrow();
+                for (int32_t y = 0; y < height_; y += tiles->tileSize()) {
+                    for (int32_t x = 0; x < width_; x += tiles->tileSize()) {
+                        auto src = reinterpret_cast<const T*>(tiles->valuePtr(x, y));
+                        int32_t w = std::min(tiles->tileSize(), width_ - x);
+                        int32_t h = std::min(tiles->tileSize(), height_ - y);
+                        for (int32_t i = 0; i < h; i++) {
+                            std::copy_n(src + static_cast<int64_t>(i) * tiles->tileSize(), w, values_ + _indexForXY(x, y + i));
+                        }
+                    }
+                }
+                clearFeature(kFeature_Tiles);
+            }
+            else {
+                _readDataFromFile(file);
+            }
 
             file->close();
         }
         catch (ErrorCode err) {
             result = err;
         }
+        catch (const Exception& e) {
+            result = e.code();
+        }
 
         // Cleanup
         delete file;
@@ -317,88 +384,250 @@ namespace Grain {
 
 
     /**
-     *  @brief Read ValueGrid from a file.
+     *  @brief Write the header and feature information, all but the values.
      *
-     *  @param file_path Path to the file where the ValueGrid should be read from.
+     *  @param tiled true, if the values follow as tile section.
+     */
+    template <typename T>
+    void ValueGrid<T>::_writeHeader(File* file, bool tiled) {
+
+        // Header
+        file->writeStr(fileSignature());
+        file->writeEndianSignature();
+
+        // Version
+        file->writeValue<uint16_t>(main_version_);
+        file->writeValue<uint16_t>(sub_version_);
+
+        // Data type
+        file->writeValue<uint16_t>(valueDataType());
+
+        // Dimension and position inside 2d tile array
+        file->writeValue<int32_t>(width_);
+        file->writeValue<int32_t>(height_);
+        file->writeValue<int32_t>(x_index_);
+        file->writeValue<int32_t>(y_index_);
+
+        // Features
+        auto feature_bits = feature_flags_.bits() & ~(0x1U << kFeature_Tiles);
+        if (tiled) {
+            feature_bits |= 0x1U << kFeature_Tiles;
+        }
+        file->writeValue<uint32_t>(feature_bits);
+
+        // Feature min/max
+        if (hasFeature(kFeature_MinMax)) {
+            _writeTypeValue(file, min_value_);
+            _writeTypeValue(file, max_value_);
+        }
+
+        // Feature invalid value
+        if (hasFeature(kFeature_Invalid_Value)) {
+            _writeTypeValue(file, invalid_value_);
+        }
+
+        // Feature Geo information
+        if (hasFeature(kFeature_GeoInfo)) {
+            file->writeValue<int32_t>(srid_);
+            file->writeFix(bbox_.minX());
+            file->writeFix(bbox_.minY());
+            file->writeFix(bbox_.maxX());
+            file->writeFix(bbox_.maxY());
+        }
+
+        // Custom infos
+        writeCustomInfo();
+    }
+
+
+    /**
+     *  @brief Read the header and feature information written by `_writeHeader()`.
+     */
+    template <typename T>
+    void ValueGrid<T>::_readHeader(File* file) {
+
+        // Header
+        char buffer[kSignatureLength];
+        file->readStr(kSignatureLength, buffer);
+        file->checkSignature(buffer, kSignatureLength, fileSignature());
+
+        file->readStr(2, buffer);
+        file->setEndianBySignature(buffer);
+
+        // Version
+        main_version_ = file->readValue<uint16_t>();
+        sub_version_ = file->readValue<uint16_t>();
+
+        // Data type
+        data_type_ = file->readValue<int16_t>();
+        if (valueDataType() != data_type_) {
+            throw ErrorCode::UnsupportedDataType;
+        }
+
+        // Dimension and position inside 2d tile array
+        width_ = file->readValue<int32_t>();
+        height_ = file->readValue<int32_t>();
+        value_count_ = width_ * height_;
+        x_index_ = file->readValue<int32_t>();
+        y_index_ = file->readValue<int32_t>();
+
+        // Features
+        feature_flags_.set(file->readValue<uint32_t>());
+
+        // Feature min/max
+        if (hasFeature(kFeature_MinMax)) {
+            min_value_ = _readTypeValue(file);
+            max_value_ = _readTypeValue(file);
+        }
+
+        // Feature invalid value
+        if (hasFeature(kFeature_Invalid_Value)) {
+            invalid_value_ = _readTypeValue(file);
+        }
+
+        // Feature Geo information
+        if (hasFeature(kFeature_GeoInfo)) {
+            srid_ = file->readValue<int32_t>();
+            file->readFix(bbox_.min_x_);
+            file->readFix(bbox_.min_y_);
+            file->readFix(bbox_.max_x_);
+            file->readFix(bbox_.max_y_);
+        }
+
+        // Custom infos
+        readCustomInfo();
+    }
+
+
+    /**
+     *  @brief Write ValueGrid to a tiled file, which can be memory mapped.
+     *
+     *  The header is the same as for `writeFile()`, with the feature
+     *  `kFeature_Tiles` set, followed by a tile section, see `ValueGridTiles`.
+     *  `readFile()` reads tiled files, `mapFile()` maps them.
+     *
+     *  @param file_path Path to the file where the ValueGrid should be written.
+     *  @param tile_size Edge length of the tiles, an even number from
+     *                   `ValueGridTiles::kMinTileSize` to `ValueGridTiles::kMaxTileSize`.
+     *  @param compression Compression of the tiles. Compressed files can only
+     *                     be mapped read-only.
      *  @return `ErrorCode::None` on success, otherwise an error code.
      */
     template <typename T>
-    ErrorCode ValueGrid<T>::readFile(const String& file_path) noexcept {
+    ErrorCode ValueGrid<T>::writeTiledFile(const String& file_path, int32_t tile_size, ValueGridTiles::Compression compression) noexcept {
 
         auto result = ErrorCode::None;
 
         File* file = nullptr;
 
         try {
+            if (!hasValues()) {
+                throw ErrorCode::NoData;
+            }
 
             file = new (std::nothrow) File(file_path);
             if (!file) {
                 throw ErrorCode::ClassInstantiationFailed;
             }
 
-            file->startRead();
+            file->startWriteOverwrite();
+            file->setLittleEndian();
 
-            // Header
-            char buffer[kSignatureLength];
-            file->readStr(kSignatureLength, buffer);
-            file->checkSignature(buffer, kSignatureLength, fileSignature());
+            _writeHeader(file, true);
 
-            file->readStr(2, buffer);
-            file->setEndianBySignature(buffer);
+            ValueGridTiles::writeTiles(file, width_, height_, sizeof(T), tile_size, compression,
+                [&](int32_t x0, int32_t y0, int32_t w, int32_t h, uint8_t* out_tile) {
+                    auto dst = reinterpret_cast<T*>(out_tile);
+                    for (int32_t y = 0; y < h; y++) {
+                        T* dst_row = dst + static_cast<int64_t>(y) * tile_size;
+                        if (values_) {
+                            std::copy_n(values_ + _indexForXY(x0, y0 + y), w, dst_row);
+                        }
+                        else {
+                            for (int32_t x = 0; x < w; x++) {
+                                dst_row[x] = *reinterpret_cast<const T*>(tiles_->valuePtr(x0 + x, y0 + y));
+                            }
+                        }
+                    }
+                });
 
-            // Version
-            main_version_ = file->readValue<uint16_t>();
-            sub_version_ = file->readValue<uint16_t>();
+            file->close();
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
 
-            // Data type
-            data_type_ = file->readValue<int16_t>();
-            if (valueDataType() != data_type_) {
-                throw ErrorCode::UnsupportedDataType;
-            }
+        // Cleanup
+        delete file;
 
-            // Dimension and position inside 2d tile array
-            width_ = file->readValue<int32_t>();
-            height_ = file->readValue<int32_t>();
-            value_count_ = width_ * height_;
-            x_index_ = file->readValue<int32_t>();
-            y_index_ = file->readValue<int32_t>();
+        return result;
+    }
 
-            // Features
-            feature_flags_.set(file->readValue<uint32_t>());
 
-            // Feature min/max
-            if (hasFeature(kFeature_MinMax)) {
-                min_value_ = _readTypeValue(file);
-                max_value_ = _readTypeValue(file);
+    /**
+     *  @brief Use a tiled file as storage instead of memory.
+     *
+     *  The file is memory mapped, values are accessed in place or, for
+     *  compressed files, inflated tile by tile into a cache of `cache_size`
+     *  tiles. `ptrForRow()` and `ptrAtXY()` return nullptr for mapped grids,
+     *  all other accessors work as for grids in memory.
+     *
+     *  @param file_path Path to a file written by `writeTiledFile()`.
+     *  @param writable Map read-write, changes are written to the file.
+     *                  Only supported for uncompressed files.
+     *  @param cache_size Number of inflated tiles kept in memory.
+     *  @return `ErrorCode::None` on success, otherwise an error code.
+     */
+    template <typename T>
+    ErrorCode ValueGrid<T>::mapFile(const String& file_path, bool writable, int32_t cache_size) noexcept {
+
+        auto result = ErrorCode::None;
+
+        File* file = nullptr;
+        ValueGridTiles* tiles = nullptr;
+
+        try {
+            file = new (std::nothrow) File(file_path);
+            if (!file) {
+                throw ErrorCode::ClassInstantiationFailed;
             }
 
-            // Feature invalid value
-            if (hasFeature(kFeature_Invalid_Value)) {
-                invalid_value_ = _readTypeValue(file);
+            file->startRead();
+
+            _readHeader(file);
+            if (!hasFeature(kFeature_Tiles) || file->isBigEndian()) {
+                throw ErrorCode::UnsupportedFileFormat;
             }
 
-            // Feature Geo information
-            if (hasFeature(kFeature_GeoInfo)) {
-                srid_ = file->readValue<int32_t>();
-                file->readFix(bbox_.min_x_);
-                file->readFix(bbox_.min_y_);
-                file->readFix(bbox_.max_x_);
-                file->readFix(bbox_.max_y_);
+            tiles = new (std::nothrow) ValueGridTiles(width_, height_, sizeof(T));
+            if (!tiles) {
+                throw ErrorCode::ClassInstantiationFailed;
             }
 
-            // Custom infos
-            readCustomInfo();
+            tiles->readIndex(file);
+            tiles->setCacheSize(cache_size);
+            file->close();
 
-            // Read values
-            _readDataFromFile(file);
+            tiles->map(file_path, writable);
 
-            file->close();
+            delete [] values_;
+            values_ = nullptr;
+            delete tiles_;
+            tiles_ = tiles;
+            tiles = nullptr;
         }
         catch (ErrorCode err) {
             result = err;
         }
+        catch (const Exception& e) {
+            result = e.code();
+        }
 
         // Cleanup
+        delete tiles;
         delete file;
 
         return result;
@@ -505,6 +734,9 @@ namespace Grain {
         CVF2* cvf2 = nullptr;
 
         try {
+            if (!hasValues()) {
+                throw ErrorCode::NullData;
+            }
 
             cvf2 = new (std::nothrow) CVF2(width_, height_, length_unit, min_digits, max_digits);
             if (!cvf2) {
@@ -516,11 +748,13 @@ namespace Grain {
             cvf2->setBbox(bbox_);
             cvf2->openFileToWrite(file_path);
 
-            for (int32_t y = 0; y < height_; y++) {
-                for (int32_t x = 0; x < width_; x++) {
-                    cvf2->pushValueToData(x, y, values_[y * width_ + x]);
+            forEachBlock([&](int32_t x0, int32_t y0, int32_t w, int32_t h, const int64_t* values, int32_t stride) {
+                for (int32_t y = 0; y < h; y++) {
+                    for (int32_t x = 0; x < w; x++) {
+                        cvf2->pushValueToData(x0 + x, y0 + y, values[static_cast<int64_t>(y) * stride + x]);
+                    }
                 }
-            }
+            });
 
             cvf2->encodeData();
             cvf2->finish();
@@ -538,6 +772,51 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Writes the grid values to a CVF2 file in the block format, version 3.
+     *
+     *  Blocks are encoded in parallel. Compared to `writeCVF2File()`, files are
+     *  usually somewhat larger, but single values and windows can be read without
+     *  decoding whole rows. `CVF2File` reads both formats.
+     *
+     *  @param file_path The file path where the CVF2 file will be saved.
+     *  @param length_unit The unit of length for the grid values.
+     *  @param block_size Edge length of the blocks in cells.
+     *  @param thread_count Number of encoding threads, 0 for one per hardware thread.
+     *  @return `ErrorCode` indicating the success or failure of the file write operation.
+     */
+    template <>
+    ErrorCode ValueGrid<int64_t>::writeCVF2BlockFile(const String& file_path, LengthUnit length_unit, int32_t block_size, int32_t thread_count) noexcept {
+
+        if (values_ != nullptr) {
+            return CVF2Block::writeFile(file_path, values_, width_, height_, srid_, bbox_, length_unit, block_size, thread_count);
+        }
+
+        if (tiles_ == nullptr) {
+            return ErrorCode::NullData;
+        }
+
+        // The encoder needs all rows at once, a mapped grid is inflated
+        // tile by tile into a temporary buffer
+        try {
+            std::vector<int64_t> values(static_cast<size_t>(width_) * height_);
+            forEachBlock([&](int32_t x0, int32_t y0, int32_t w, int32_t h, const int64_t* src, int32_t stride) {
+                for (int32_t y = 0; y < h; y++) {
+                    std::copy_n(src + static_cast<int64_t>(y) * stride, w, values.data() + static_cast<int64_t>(y0 + y) * width_ + x0);
+                }
+            });
+
+            return CVF2Block::writeFile(file_path, values.data(), width_, height_, srid_, bbox_, length_unit, block_size, thread_count);
+        }
+        catch (const std::bad_alloc&) {
+            return ErrorCode::MemCantAllocate;
+        }
+        catch (...) {
+            return ErrorCode::FileCantRead;
+        }
+    }
+
+
     /**
      *  @brief Create an image from provided data.
      *
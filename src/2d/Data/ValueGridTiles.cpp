@@ -0,0 +1,326 @@
+//
+//  ValueGridTiles.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "2d/Data/ValueGridTiles.hpp"
+#include "File/File.hpp"
+#include "zlib.h"
+
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace Grain {
+
+    ValueGridTiles::ValueGridTiles(int32_t width, int32_t height, int32_t value_size) noexcept :
+        width_(width), height_(height), value_size_(value_size) {
+    }
+
+
+    ValueGridTiles::~ValueGridTiles() noexcept {
+        unmap();
+    }
+
+
+    /**
+     *  @brief Set the number of inflated tiles kept in memory for compressed files.
+     */
+    void ValueGridTiles::setCacheSize(int32_t cache_size) noexcept {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_size_ = std::max<int32_t>(cache_size, 1);
+        if (static_cast<int32_t>(cache_.size()) > cache_size_) {
+            cache_.resize(cache_size_);
+        }
+    }
+
+
+    /**
+     *  @brief Read the tile section, `file` must be positioned at its start.
+     */
+    void ValueGridTiles::readIndex(File* file) {
+        if (!file) {
+            Exception::throwStandard(ErrorCode::NullPointer);
+        }
+
+        tile_size_ = static_cast<int32_t>(file->readValue<uint32_t>());
+        auto value_size = static_cast<int32_t>(file->readValue<uint16_t>());
+        auto compression = file->readValue<uint16_t>();
+
+        if (!isValidTileSize(tile_size_) || value_size != value_size_ || compression > static_cast<uint16_t>(Compression::Zlib)) {
+            Exception::throwStandard(ErrorCode::UnsupportedFileFormat);
+        }
+        compression_ = static_cast<Compression>(compression);
+
+        x_tile_count_ = (width_ + tile_size_ - 1) / tile_size_;
+        y_tile_count_ = (height_ + tile_size_ - 1) / tile_size_;
+        auto tile_count = static_cast<size_t>(tileCount());
+
+        tile_pos_.resize(tile_count);
+        tile_stored_size_.resize(tile_count);
+        for (auto& pos : tile_pos_) {
+            pos = file->readValue<uint64_t>();
+        }
+        for (auto& size : tile_stored_size_) {
+            size = file->readValue<uint64_t>();
+        }
+    }
+
+
+    /**
+     *  @brief Map the file into memory.
+     *
+     *  @param writable Map read-write, changes are written back to the file.
+     *                  Only supported for uncompressed files.
+     */
+    void ValueGridTiles::map(const String& file_path, bool writable) {
+        unmap();
+
+        if constexpr (std::endian::native != std::endian::little) {
+            // Tile data is accessed in place and stored little-endian
+            Exception::throwStandard(ErrorCode::UnsupportedEndianess);
+        }
+
+        if (writable && compression_ != Compression::None) {
+            Exception::throwStandard(ErrorCode::UnsupportedSettings);
+        }
+
+        fd_ = ::open(file_path.utf8(), writable ? O_RDWR : O_RDONLY);
+        if (fd_ < 0) {
+            Exception::throwStandard(ErrorCode::FileCantOpen);
+        }
+
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0 || st.st_size <= 0) {
+            unmap();
+            Exception::throwStandard(ErrorCode::FileCantRead);
+        }
+
+        // All tiles must be inside the file
+        for (int32_t i = 0; i < tileCount(); i++) {
+            auto expected_size = compression_ == Compression::None ? static_cast<uint64_t>(tileByteCount()) : tile_stored_size_[i];
+            if (tile_stored_size_[i] != expected_size || tile_pos_[i] + tile_stored_size_[i] > static_cast<uint64_t>(st.st_size)) {
+                unmap();
+                Exception::throwStandard(ErrorCode::UnsupportedFileFormat);
+            }
+        }
+
+        void* map = ::mmap(nullptr, st.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            unmap();
+            Exception::throwStandard(ErrorCode::FileCantRead);
+        }
+
+        map_ = static_cast<uint8_t*>(map);
+        map_size_ = st.st_size;
+        writable_ = writable;
+    }
+
+
+    void ValueGridTiles::unmap() noexcept {
+        if (map_) {
+            if (writable_) {
+                ::msync(map_, map_size_, MS_SYNC);
+            }
+            ::munmap(map_, map_size_);
+            map_ = nullptr;
+            map_size_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        writable_ = false;
+        cache_.clear();
+    }
+
+
+    /**
+     *  @brief Values of a tile, `tile_size * tile_size` values row by row.
+     *
+     *  See the class description for the lifetime of the pointer.
+     */
+    const uint8_t* ValueGridTiles::tileData(int32_t tile_index) {
+        if (compression_ == Compression::None) {
+            return _tileData(tile_index);
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        return _tileData(tile_index);
+    }
+
+
+    /**
+     *  @brief Copy the value at grid position `x`, `y` to `out_value`.
+     *
+     *  Can be called from several threads. The position must be inside the
+     *  grid.
+     */
+    void ValueGridTiles::readValue(int32_t x, int32_t y, void* out_value) {
+        int32_t tile_index = (y / tile_size_) * x_tile_count_ + x / tile_size_;
+        int64_t offset = static_cast<int64_t>(y % tile_size_) * tile_size_ + x % tile_size_;
+
+        if (compression_ == Compression::None) {
+            std::memcpy(out_value, _tileData(tile_index) + offset * value_size_, value_size_);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        std::memcpy(out_value, _tileData(tile_index) + offset * value_size_, value_size_);
+    }
+
+
+    /**
+     *  @brief `tileData()` without locking, the caller holds `cache_mutex_`
+     *         for a compressed file.
+     */
+    const uint8_t* ValueGridTiles::_tileData(int32_t tile_index) {
+        if (!map_) {
+            Exception::throwStandard(ErrorCode::NoData);
+        }
+        if (tile_index < 0 || tile_index >= tileCount()) {
+            Exception::throwStandard(ErrorCode::IndexOutOfRange);
+        }
+
+        if (compression_ == Compression::None) {
+            return map_ + tile_pos_[tile_index];
+        }
+
+        use_counter_++;
+
+        // Cached already, or find the least recently used slot
+        CacheSlot* slot = nullptr;
+        for (auto& s : cache_) {
+            if (s.tile_index_ == tile_index) {
+                s.last_use_ = use_counter_;
+                return s.data_.data();
+            }
+            if (!slot || s.last_use_ < slot->last_use_) {
+                slot = &s;
+            }
+        }
+
+        if (static_cast<int32_t>(cache_.size()) < cache_size_) {
+            slot = &cache_.emplace_back();
+        }
+
+        slot->tile_index_ = -1;
+        slot->data_.resize(tileByteCount());
+
+        auto dst_size = static_cast<uLongf>(slot->data_.size());
+        int z_result = ::uncompress(slot->data_.data(), &dst_size, map_ + tile_pos_[tile_index], static_cast<uLong>(tile_stored_size_[tile_index]));
+        if (z_result != Z_OK || dst_size != slot->data_.size()) {
+            Exception::throwStandard(ErrorCode::UnsupportedFileFormat);
+        }
+
+        slot->tile_index_ = tile_index;
+        slot->last_use_ = use_counter_;
+        inflate_count_++;
+
+        return slot->data_.data();
+    }
+
+
+    /**
+     *  @brief Writable values of a tile, only for files mapped read-write.
+     */
+    uint8_t* ValueGridTiles::mutTileData(int32_t tile_index) {
+        if (!writable_) {
+            Exception::throwStandard(ErrorCode::UnsupportedSettings);
+        }
+        return const_cast<uint8_t*>(tileData(tile_index));
+    }
+
+
+    /**
+     *  @brief Write the tile section at the current position of `file`.
+     *
+     *  Tiles are filled one by one by `filler`, so the source does not need
+     *  to be a contiguous grid in memory.
+     */
+    void ValueGridTiles::writeTiles(File* file, int32_t width, int32_t height, int32_t value_size, int32_t tile_size, Compression compression, const TileFiller& filler) {
+        if (!file) {
+            Exception::throwStandard(ErrorCode::NullPointer);
+        }
+
+        if constexpr (std::endian::native != std::endian::little) {
+            Exception::throwStandard(ErrorCode::UnsupportedEndianess);
+        }
+
+        if (!isValidTileSize(tile_size) || width < 1 || height < 1 || value_size < 1) {
+            Exception::throwStandard(ErrorCode::BadArgs);
+        }
+
+        int32_t x_tile_count = (width + tile_size - 1) / tile_size;
+        int32_t y_tile_count = (height + tile_size - 1) / tile_size;
+        auto tile_count = static_cast<size_t>(x_tile_count) * y_tile_count;
+        auto tile_byte_count = static_cast<size_t>(tile_size) * tile_size * value_size;
+
+        file->writeValue<uint32_t>(tile_size);
+        file->writeValue<uint16_t>(value_size);
+        file->writeValue<uint16_t>(static_cast<uint16_t>(compression));
+
+        // Placeholder index, rewritten when all tiles are stored
+        auto index_pos = file->pos();
+        for (size_t i = 0; i < tile_count * 2; i++) {
+            file->writeValue<uint64_t>(0);
+        }
+
+        std::vector<uint64_t> tile_pos(tile_count);
+        std::vector<uint64_t> tile_stored_size(tile_count);
+        std::vector<uint8_t> tile(tile_byte_count);
+        std::vector<uint8_t> compressed;
+        uint8_t zeros[kDataAlignment] = {};
+
+        for (int32_t ty = 0; ty < y_tile_count; ty++) {
+            for (int32_t tx = 0; tx < x_tile_count; tx++) {
+                int32_t x0 = tx * tile_size;
+                int32_t y0 = ty * tile_size;
+                size_t tile_index = static_cast<size_t>(ty) * x_tile_count + tx;
+
+                std::fill(tile.begin(), tile.end(), 0);
+                filler(x0, y0, std::min(tile_size, width - x0), std::min(tile_size, height - y0), tile.data());
+
+                if (compression == Compression::None) {
+                    auto padding = (kDataAlignment - file->pos() % kDataAlignment) % kDataAlignment;
+                    if (padding > 0) {
+                        file->write8BitData(zeros, padding);
+                    }
+                    tile_pos[tile_index] = file->pos();
+                    tile_stored_size[tile_index] = tile_byte_count;
+                    file->write8BitData(tile.data(), static_cast<int64_t>(tile_byte_count));
+                }
+                else {
+                    auto compressed_size = ::compressBound(static_cast<uLong>(tile_byte_count));
+                    compressed.resize(compressed_size);
+                    if (::compress2(compressed.data(), &compressed_size, tile.data(), static_cast<uLong>(tile_byte_count), Z_DEFAULT_COMPRESSION) != Z_OK) {
+                        Exception::throwStandard(ErrorCode::ComputationFailed);
+                    }
+                    tile_pos[tile_index] = file->pos();
+                    tile_stored_size[tile_index] = compressed_size;
+                    file->write8BitData(compressed.data(), static_cast<int64_t>(compressed_size));
+                }
+            }
+        }
+
+        auto end_pos = file->pos();
+        file->setPos(index_pos);
+        for (auto pos : tile_pos) {
+            file->writeValue<uint64_t>(pos);
+        }
+        for (auto size : tile_stored_size) {
+            file->writeValue<uint64_t>(size);
+        }
+        file->setPos(end_pos);
+    }
+
+
+} // End of namespace Grain
@@ -11,6 +11,10 @@
 #include "Image/Image.hpp"
 #include "Color/RGB.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 
 namespace Grain {
 
@@ -75,6 +79,26 @@ double PoissonDiscImageDensity::densityAtPos(const Vec2d& pos) {
 }
 
 
+void PoissonDiscRadiusMap::build(PoissonDiscDensity* density, const Bounds2d& range, double texel_size, double r_min, double r_max) {
+    texel_size = std::max(texel_size, 1e-6);
+    min_x_ = range.min_x_;
+    min_y_ = range.min_y_;
+    inv_texel_size_ = 1.0 / texel_size;
+    width_ = std::max(static_cast<int32_t>(std::ceil((range.max_x_ - range.min_x_) / texel_size)), 1);
+    height_ = std::max(static_cast<int32_t>(std::ceil((range.max_y_ - range.min_y_) / texel_size)), 1);
+    radii_.resize(static_cast<size_t>(width_) * height_);
+
+    for (int32_t y = 0; y < height_; y++) {
+        float* d = &radii_[static_cast<size_t>(y) * width_];
+        double pos_y = min_y_ + (y + 0.5) * texel_size;
+        for (int32_t x = 0; x < width_; x++) {
+            double r = density ? density->densityAtPos(Vec2d(min_x_ + (x + 0.5) * texel_size, pos_y)) : r_min;
+            d[x] = static_cast<float>(std::clamp(r, r_min, r_max));
+        }
+    }
+}
+
+
 PoissonDiscSampler::PoissonDiscSampler(
     const Bounds2d range,
     PoissonDiscDensity* density,
@@ -90,36 +114,43 @@ PoissonDiscSampler::PoissonDiscSampler(
     density_ = density;
 
     min_radius_ = std::max(r_min, 1.0);
-    max_radius_ = r_max;
+    max_radius_ = std::max(r_max, min_radius_);
 
     k_ = std::max(max_tries, 2);
     random_func_ = _randomFunc;
 
+    // A cell is small enough to hold one point at most
     cell_size_ = min_radius_ / std::sqrt(2.0);
     grid_width_ = static_cast<int32_t>(std::ceil((max_x_ - min_x_) / cell_size_));
     grid_height_ = static_cast<int32_t>(std::ceil((max_y_ - min_y_) / cell_size_));
-    grid_.assign(grid_width_ * grid_height_, std::nullopt);
-
-    std::cout << "min_x_: " << min_x_ << std::endl;
-    std::cout << "min_y_: " << min_y_ << std::endl;
-    std::cout << "max_x_: " << max_x_ << std::endl;
-    std::cout << "max_y_: " << max_y_ << std::endl;
-    std::cout << "min_radius_: " << min_radius_ << std::endl;
-    std::cout << "max_radius_: " << max_radius_ << std::endl;
-    std::cout << "k_: " << k_ << std::endl;
-    std::cout << "cell_size_: " << cell_size_ << std::endl;
-    std::cout << "grid_width_: " << grid_width_ << std::endl;
-    std::cout << "grid_height_: " << grid_height_ << std::endl;
+    search_range_ = static_cast<int32_t>(std::ceil(max_radius_ / cell_size_));
 
     reset();
 
-    density->setSampler(this);
+    if (density) {
+        density->setSampler(this);
+    }
+    rebuildDensityMap();
+}
+
+
+/**
+ *  @brief Rasterize the density again, e.g. after the image has changed.
+ *
+ *  @param texel_size Size of a texel of the radius map, the minimum radius
+ *                    if 0.
+ */
+void PoissonDiscSampler::rebuildDensityMap(double texel_size) {
+    if (texel_size <= 0.0) {
+        texel_size = min_radius_;
+    }
+    radius_map_.build(density_, Bounds2d(min_x_, min_y_, max_x_, max_y_), texel_size, min_radius_, max_radius_);
 }
 
 
 void PoissonDiscSampler::reset() {
     point_queue_.clear();
-    grid_.assign(grid_width_ * grid_height_, std::nullopt);
+    grid_.assign(static_cast<size_t>(grid_width_) * grid_height_, GridCell{ -1.0, -1.0 });
     first_point_flag_ = true;
 }
 
@@ -133,14 +164,13 @@ std::optional<Vec2d> PoissonDiscSampler::next() {
         y = min_y_ + (max_y_ - min_y_) * random_func_(this);
         x = std::clamp<double>(x, 0, max_x_ - 1);
         y = std::clamp<double>(y, 0, max_y_ - 1);
-        std::cout << "x: " << x << ", y: " << y << std::endl;
         return createNewPoint(x, y);
     }
 
     while (!point_queue_.empty()) {
-        int idx = static_cast<int>(random_func_(this) * point_queue_.size());
-        const Vec2d& base = point_queue_[idx];
-        double base_radius = density_->densityAtPos(base);
+        auto idx = std::min(static_cast<size_t>(random_func_(this) * point_queue_.size()), point_queue_.size() - 1);
+        Vec2d base = point_queue_[idx];
+        double base_radius = radius_map_.radiusAtPos(base.x_, base.y_);
 
         for (int i = 0; i < k_; ++i) {
             double distance = base_radius * (random_func_(this) + 1.0);
@@ -151,19 +181,106 @@ std::optional<Vec2d> PoissonDiscSampler::next() {
                 return createNewPoint(x, y);
             }
         }
-        point_queue_.erase(point_queue_.begin() + idx);
+
+        // Order doesn't matter, the next base is picked randomly
+        point_queue_[idx] = point_queue_.back();
+        point_queue_.pop_back();
     }
     return std::nullopt;
 }
 
 
 std::vector<Vec2d> PoissonDiscSampler::all() {
+    return generate();
+}
+
+
+/**
+ *  @brief Generate all points, in parallel tiles.
+ *
+ *  The points are ordered by tile. The result is the same for every thread
+ *  count, set the seed with `setSeed()`. With a custom `random_func_`, the
+ *  tiles are generated in a single thread.
+ */
+std::vector<Vec2d> PoissonDiscSampler::generate() {
     reset();
+
+    // Tiles of the same pass must be further apart than the cells read
+    // around a tile, which are the seeds within twice the maximum radius
+    auto border_cells = static_cast<int32_t>(std::ceil(2.0 * max_radius_ / cell_size_));
+    int32_t tile_cells = std::max<int32_t>(kMinTileCells, border_cells + 1);
+    int32_t tiles_x = (grid_width_ + tile_cells - 1) / tile_cells;
+    int32_t tiles_y = (grid_height_ + tile_cells - 1) / tile_cells;
+    std::vector<std::vector<Vec2d>> tile_points(static_cast<size_t>(tiles_x) * tiles_y);
+
+    int32_t thread_count = thread_count_;
+    if (hasCustomRandomFunc()) {
+        thread_count = 1;   // The function may not be thread-safe
+    }
+    else if (thread_count <= 0) {
+        thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+    }
+
+    for (int32_t pass = 0; pass < 4; pass++) {
+        std::vector<int32_t> tiles;
+        for (int32_t ty = pass >> 1; ty < tiles_y; ty += 2) {
+            for (int32_t tx = pass & 1; tx < tiles_x; tx += 2) {
+                tiles.push_back(ty * tiles_x + tx);
+            }
+        }
+
+        auto pass_thread_count = static_cast<int32_t>(std::clamp<size_t>(thread_count, 1, std::max<size_t>(tiles.size(), 1)));
+        if (pass_thread_count == 1) {
+            for (int32_t tile : tiles) {
+                generateTile(tile % tiles_x, tile / tiles_x, tile_cells, tile_points[tile]);
+            }
+            continue;
+        }
+
+        std::atomic<size_t> next_tile{ 0 };
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&]() {
+            try {
+                size_t i;
+                while ((i = next_tile.fetch_add(1)) < tiles.size()) {
+                    int32_t tile = tiles[i];
+                    generateTile(tile % tiles_x, tile / tiles_x, tile_cells, tile_points[tile]);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next_tile = tiles.size();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int32_t i = 0; i < pass_thread_count; i++) {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    size_t point_count = 0;
+    for (auto& points : tile_points) {
+        point_count += points.size();
+    }
+
     std::vector<Vec2d> results;
-    std::optional<Vec2d> pt;
-    while ((pt = next())) {
-        results.push_back(*pt);
+    results.reserve(point_count);
+    for (auto& points : tile_points) {
+        results.insert(results.end(), points.begin(), points.end());
     }
+
+    first_point_flag_ = false;
     return results;
 }
 
@@ -184,18 +301,27 @@ bool PoissonDiscSampler::isValidPoint(double x, double y) const {
         return false;
     }
 
-    double r = density_->densityAtPos(Vec2d(x, y));
-    int col = static_cast<int>((x - min_x_) / cell_size_);
-    int row = static_cast<int>((y - min_y_) / cell_size_);
+    double r = radius_map_.radiusAtPos(x, y);
+    double r2 = r * r;
+    double rel_x = x - min_x_;
+    double rel_y = y - min_y_;
+    int32_t col = static_cast<int32_t>(rel_x / cell_size_);
+    int32_t row = static_cast<int32_t>(rel_y / cell_size_);
+    int32_t range = std::min(search_range_, static_cast<int32_t>(std::ceil(r / cell_size_)));
 
-    for (int dx = -2; dx <= 2; ++dx) {
-        for (int dy = -2; dy <= 2; ++dy) {
-            int nx = col + dx, ny = row + dy;
-            if (nx >= 0 && nx < grid_width_ && ny >= 0 && ny < grid_height_) {
-                auto& cell = grid_[nx + ny * grid_width_];
-                if (cell && distSquared(x, y, cell->x_, cell->y_) <= r * r) {
-                    return false;
-                }
+    // An occupied cell is the most frequent reason for a rejection
+    if (grid_[col + static_cast<size_t>(row) * grid_width_].x_ >= 0.0) {
+        return false;
+    }
+
+    int32_t col_end = std::min(col + range, grid_width_ - 1);
+    int32_t row_end = std::min(row + range, grid_height_ - 1);
+    for (int32_t ny = std::max(row - range, 0); ny <= row_end; ny++) {
+        const GridCell* cells = &grid_[static_cast<size_t>(ny) * grid_width_];
+        for (int32_t nx = std::max(col - range, 0); nx <= col_end; nx++) {
+            const GridCell& cell = cells[nx];
+            if (cell.x_ >= 0.0 && distSquared(rel_x, rel_y, cell.x_, cell.y_) <= r2) {
+                return false;
             }
         }
     }
@@ -206,11 +332,104 @@ bool PoissonDiscSampler::isValidPoint(double x, double y) const {
 
 Vec2d PoissonDiscSampler::createNewPoint(double x, double y) {
     Vec2d p = { x, y };
-    int32_t col = static_cast<int32_t>((x - min_x_) / cell_size_);
-    int32_t row = static_cast<int32_t>((y - min_y_) / cell_size_);
-    grid_[col + row * grid_width_] = p;
+    insertIntoGrid(x, y);
     point_queue_.push_back(p);
     return p;
 }
 
-}  // End of namespace Grain
\ No newline at end of file
+
+void PoissonDiscSampler::insertIntoGrid(double x, double y) {
+    int32_t col = static_cast<int32_t>((x - min_x_) / cell_size_);
+    int32_t row = static_cast<int32_t>((y - min_y_) / cell_size_);
+    grid_[col + static_cast<size_t>(row) * grid_width_] = GridCell{ x - min_x_, y - min_y_ };
+}
+
+
+/**
+ *  @brief Fill one tile, growing from the points around it.
+ *
+ *  Candidates outside the tile are rejected, they belong to the neighbour
+ *  tiles. A tile without points around it starts at a random position.
+ *  Random numbers come from a generator of the tile, or from
+ *  `random_func_` if it has been replaced.
+ */
+void PoissonDiscSampler::generateTile(int32_t tile_x, int32_t tile_y, int32_t tile_cells, std::vector<Vec2d>& out_points) {
+    uint64_t tile_key = (static_cast<uint64_t>(tile_y) << 32) | static_cast<uint32_t>(tile_x);
+    RandomEngine engine(seed_ + 0x9e3779b97f4a7c15ULL * (tile_key + 1), stream_);
+    bool custom_random = hasCustomRandomFunc();
+    auto random = [&]() {
+        return custom_random ? random_func_(this) : engine.nextDouble();
+    };
+
+    int32_t col0 = tile_x * tile_cells;
+    int32_t row0 = tile_y * tile_cells;
+    int32_t col1 = std::min(col0 + tile_cells, grid_width_);
+    int32_t row1 = std::min(row0 + tile_cells, grid_height_);
+
+    std::vector<Vec2d> active;
+    auto border_cells = static_cast<int32_t>(std::ceil(2.0 * max_radius_ / cell_size_));
+    int32_t seed_col_end = std::min(col1 + border_cells, grid_width_);
+    int32_t seed_row_end = std::min(row1 + border_cells, grid_height_);
+    for (int32_t row = std::max(row0 - border_cells, 0); row < seed_row_end; row++) {
+        const GridCell* cells = &grid_[static_cast<size_t>(row) * grid_width_];
+        for (int32_t col = std::max(col0 - border_cells, 0); col < seed_col_end; col++) {
+            if (cells[col].x_ >= 0.0) {
+                active.emplace_back(min_x_ + cells[col].x_, min_y_ + cells[col].y_);
+            }
+        }
+    }
+
+    auto try_point = [&](double x, double y) {
+        if (x < min_x_ || y < min_y_) {
+            return false;
+        }
+        auto col = static_cast<int32_t>((x - min_x_) / cell_size_);
+        auto row = static_cast<int32_t>((y - min_y_) / cell_size_);
+        if (col < col0 || col >= col1 || row < row0 || row >= row1 || !isValidPoint(x, y)) {
+            return false;
+        }
+        insertIntoGrid(x, y);
+        out_points.emplace_back(x, y);
+        active.emplace_back(x, y);
+        return true;
+    };
+
+    if (active.empty()) {
+        double x0 = min_x_ + col0 * cell_size_;
+        double y0 = min_y_ + row0 * cell_size_;
+        double x1 = std::min(min_x_ + col1 * cell_size_, max_x_);
+        double y1 = std::min(min_y_ + row1 * cell_size_, max_y_);
+        double x = x0 + (x1 - x0) * random();
+        try_point(x, y0 + (y1 - y0) * random());
+    }
+
+    double step_x = std::cos(2.0 * M_PI / k_);
+    double step_y = std::sin(2.0 * M_PI / k_);
+
+    while (!active.empty()) {
+        auto idx = std::min(static_cast<size_t>(random() * active.size()), active.size() - 1);
+        Vec2d base = active[idx];
+        double base_radius = radius_map_.radiusAtPos(base.x_, base.y_);
+
+        // The directions of the candidates are evenly spaced from a random
+        // start, which covers the annulus better and saves the trigonometry
+        double angle = 2.0 * M_PI * random();
+        double dir_x = std::cos(angle);
+        double dir_y = std::sin(angle);
+        bool found = false;
+        for (int32_t i = 0; i < k_ && !found; i++) {
+            double distance = base_radius * (random() + 1.0);
+            found = try_point(base.x_ + distance * dir_x, base.y_ + distance * dir_y);
+            double rotated_x = dir_x * step_x - dir_y * step_y;
+            dir_y = dir_x * step_y + dir_y * step_x;
+            dir_x = rotated_x;
+        }
+
+        if (!found) {
+            active[idx] = active.back();
+            active.pop_back();
+        }
+    }
+}
+
+}  // End of namespace Grain
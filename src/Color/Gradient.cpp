@@ -549,29 +549,30 @@ namespace Grain {
             }
         }
 
-        auto l_stop = stopPtrAtIndex(0);
-        for (int32_t i = 1; i < stop_count; i++) {
-            auto r_stop = stopPtrAtIndex(i);
-            if (!r_stop) {
-                return false;
+        // Binary search for the first stop with a position greater than `pos`
+        int32_t lo = 1;
+        int32_t hi = lastStopIndex();
+        while (lo < hi) {
+            int32_t mid = (lo + hi) / 2;
+            if (stopPtrAtIndex(mid)->m_pos > pos) {
+                hi = mid;
             }
-
-            if (pos >= l_stop->m_pos && pos <= r_stop->m_pos) {
-
-                LevelCurve level_curve;
-                level_curve.setByIntArray(l_stop->m_level_curve_values, 10000);
-
-                float d = r_stop->m_pos - l_stop->m_pos;
-                float t = std::fabs(d) > std::numeric_limits<float>::epsilon() ? (pos - l_stop->m_pos) / d : std::numeric_limits<float>::max();
-                // ct.setBlend(c1, c2, t);
-                out_color.mixbox(l_stop->rightColor(), r_stop->leftColor(), t);
-                return true;
+            else {
+                lo = mid + 1;
             }
+        }
 
-            l_stop = r_stop;
+        auto l_stop = stopPtrAtIndex(lo - 1);
+        auto r_stop = stopPtrAtIndex(lo);
+        if (!l_stop || !r_stop) {
+            return false;
         }
 
-        return false;
+        float d = r_stop->m_pos - l_stop->m_pos;
+        float t = std::fabs(d) > std::numeric_limits<float>::epsilon() ? (pos - l_stop->m_pos) / d : 1.0f;
+        out_color.mixbox(l_stop->rightColor(), r_stop->leftColor(), t);
+
+        return true;
     }
 
 
@@ -741,6 +742,7 @@ namespace Grain {
         if (flag) {
             m_must_sort = true;
             m_lut_must_update = true;
+            m_revision++;
 #if defined(__APPLE__) && defined(__MACH__)
             m_cg_gradient_must_update = true;
 #endif
@@ -1109,6 +1111,43 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Get an immutable lookup table snapshot for bulk color mapping.
+     *
+     *  The snapshot is cached and rebuilt only when the gradient or the
+     *  requested options have changed. The returned snapshot can be used from
+     *  any thread, while this method itself must be called from the thread
+     *  owning the gradient.
+     *
+     *  @param options Resolution, interpolation and stepping of the table.
+     *  @return The snapshot or nullptr, if memory allocation failed.
+     */
+    GradientLUTSnapshot Gradient::lutSnapshot(const GradientLUT::Options& options) noexcept {
+
+        sortStops();
+
+        if (m_lut_snapshot &&
+            m_lut_snapshot_revision == m_revision &&
+            m_lut_snapshot->options() == options) {
+            return m_lut_snapshot;
+        }
+
+        try {
+            auto lut = std::make_shared<const GradientLUT>(*this, options);
+            if (!lut->isValid()) {
+                return nullptr;
+            }
+            m_lut_snapshot = lut;
+            m_lut_snapshot_revision = m_revision;
+        }
+        catch (...) {
+            return nullptr;
+        }
+
+        return m_lut_snapshot;
+    }
+
+
     void Gradient::draw(GraphicContext* gc, const Vec2d& start_pos, const Vec2d& end_pos) noexcept {
         gc->drawGradient(this, start_pos, end_pos);
     }
@@ -0,0 +1,392 @@
+//
+//  GradientLUT.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Color/GradientLUT.hpp"
+#include "Color/Gradient.hpp"
+#include "Color/OKColor.hpp"
+#include "2d/Data/ValueGrid.hpp"
+#include "Image/Image.hpp"
+
+
+namespace Grain {
+
+    /**
+     *  @brief Number of values handled by one pass of the bulk kernels.
+     *
+     *  Indices and blend factors for a chunk are kept in small stack arrays,
+     *  which keeps them in L1 cache between the index and the blend pass.
+     */
+    static constexpr int32_t kGradientLUTChunkSize = 256;
+
+
+    GradientLUT::GradientLUT(Gradient& gradient, const Options& options) noexcept {
+
+        m_options = options;
+        m_resolution = std::clamp<int32_t>(options.resolution, kMinResolution, kMaxResolution);
+        m_options.resolution = m_resolution;
+        m_max_index = m_resolution - 1;
+
+        m_rgba = static_cast<float*>(std::malloc(sizeof(float) * 4 * (m_resolution + 1)));
+        m_rgba8 = static_cast<uint8_t*>(std::malloc(sizeof(uint8_t) * 4 * m_resolution));
+
+        if (!m_rgba || !m_rgba8) {
+            std::free(m_rgba);
+            std::free(m_rgba8);
+            m_rgba = nullptr;
+            m_rgba8 = nullptr;
+            return;
+        }
+
+        gradient.sortStops();
+
+        float* d = m_rgba;
+        uint8_t* d8 = m_rgba8;
+        for (int32_t i = 0; i < m_resolution; i++) {
+            RGBA color;
+            evaluate(gradient, m_options, static_cast<float>(i) / static_cast<float>(m_max_index), color);
+            d[0] = color.data_[0];
+            d[1] = color.data_[1];
+            d[2] = color.data_[2];
+            d[3] = color.alpha_;
+            for (int32_t c = 0; c < 4; c++) {
+                d8[c] = static_cast<uint8_t>(std::clamp<float>(d[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+            d += 4;
+            d8 += 4;
+        }
+
+        // Duplicate the last entry, so blending at the upper end never reads past the table
+        for (int32_t c = 0; c < 4; c++) {
+            d[c] = d[c - 4];
+        }
+    }
+
+
+    GradientLUT::~GradientLUT() noexcept {
+
+        std::free(m_rgba);
+        std::free(m_rgba8);
+    }
+
+
+    /**
+     *  @brief Evaluate the color of a gradient at a position.
+     *
+     *  The gradient must be sorted, see `Gradient::sortStops()`. The segment
+     *  containing `pos` is found by binary search.
+     *
+     *  `Interpolation::RGB` honors the color space of the gradient, with
+     *  `Gradient::ColorSpace::LinearRGB` the components are blended in linear
+     *  light. Mixbox and OKLab define their own blend spaces.
+     */
+    void GradientLUT::evaluate(Gradient& gradient, const Options& options, float pos, RGBA& out_color) noexcept {
+
+        int32_t stop_count = gradient.stopCount();
+        if (stop_count < 1) {
+            out_color = RGBA::kBlack;
+            return;
+        }
+
+        auto first_stop = gradient.stopPtrAtIndex(0);
+        if (pos <= first_stop->pos()) {
+            out_color = first_stop->leftColor();
+            return;
+        }
+
+        auto last_stop = gradient.stopPtrAtIndex(stop_count - 1);
+        if (pos >= last_stop->pos()) {
+            out_color = last_stop->rightColor();
+            return;
+        }
+
+        // Find the first stop with a position greater than `pos`
+        int32_t lo = 1;
+        int32_t hi = stop_count - 1;
+        while (lo < hi) {
+            int32_t mid = (lo + hi) / 2;
+            if (gradient.stopPtrAtIndex(mid)->pos() > pos) {
+                hi = mid;
+            }
+            else {
+                lo = mid + 1;
+            }
+        }
+
+        auto l_stop = gradient.stopPtrAtIndex(lo - 1);
+        auto r_stop = gradient.stopPtrAtIndex(lo);
+
+        float d = r_stop->pos() - l_stop->pos();
+        float t = d > std::numeric_limits<float>::epsilon() ? (pos - l_stop->pos()) / d : 1.0f;
+
+        if (options.stepped && l_stop->stepCount() > 0) {
+            auto step_n = static_cast<float>(l_stop->stepCount());
+            t = std::min(std::floor(t * step_n), step_n - 1.0f) / step_n;
+        }
+
+        RGBA c1 = l_stop->rightColor();
+        RGBA c2 = r_stop->leftColor();
+
+        switch (options.interpolation) {
+            case Interpolation::RGB:
+                if (gradient.colorSpace() == Gradient::ColorSpace::LinearRGB) {
+                    // Blend in linear light, like SVG `color-interpolation: linearRGB`
+                    float rgb[3];
+                    for (int32_t i = 0; i < 3; i++) {
+                        float v1 = Color::gamma_to_linear(c1.data_[i]);
+                        float v2 = Color::gamma_to_linear(c2.data_[i]);
+                        rgb[i] = Color::linear_to_gamma(v1 + t * (v2 - v1));
+                    }
+                    out_color.setRGBA(rgb[0], rgb[1], rgb[2], c1.alpha_ + t * (c2.alpha_ - c1.alpha_));
+                }
+                else {
+                    out_color.setLerp(c1, c2, t);
+                }
+                break;
+
+            case Interpolation::OKLab: {
+                OKLab lab1(c1);
+                OKLab lab2(c2);
+                out_color.setRGBA(RGB(lab1.blend(lab2, t)), c1.alpha_ + t * (c2.alpha_ - c1.alpha_));
+                break;
+            }
+
+            case Interpolation::Mixbox:
+            default:
+                out_color.mixbox(c1, c2, t);
+                break;
+        }
+    }
+
+
+    void GradientLUT::lookup(float pos, RGBA& out_color) const noexcept {
+
+        float rgba[4];
+        lookup(pos, rgba);
+        out_color.setRGBA(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+
+    void GradientLUT::lookup(float pos, float* out_rgba) const noexcept {
+
+        if (!m_rgba) {
+            out_rgba[0] = out_rgba[1] = out_rgba[2] = 0.0f;
+            out_rgba[3] = 1.0f;
+            return;
+        }
+
+        float x = std::fmin(std::fmax(pos * static_cast<float>(m_max_index), 0.0f), static_cast<float>(m_max_index));
+        auto index = static_cast<int32_t>(x);
+        float f = x - static_cast<float>(index);
+        const float* c = &m_rgba[index * 4];
+        for (int32_t i = 0; i < 4; i++) {
+            out_rgba[i] = c[i] + f * (c[i + 4] - c[i]);
+        }
+    }
+
+
+    /**
+     *  @brief Map an array of values to RGBA float colors.
+     *
+     *  Values are normalized to the range `min` ... `max`, values outside are
+     *  clamped to the ends of the gradient, NaN maps to the start.
+     *
+     *  @param values Pointer to `n` input values.
+     *  @param n Number of values.
+     *  @param min Value mapped to gradient position 0.
+     *  @param max Value mapped to gradient position 1.
+     *  @param out_rgba Destination for `n * 4` floats.
+     */
+    void GradientLUT::lookup(const float* values, int64_t n, float min, float max, float* out_rgba) const noexcept {
+
+        if (!values || !out_rgba || n < 1 || !m_rgba) {
+            return;
+        }
+
+        float range = max - min;
+        float scale = std::fabs(range) > std::numeric_limits<float>::epsilon() ? static_cast<float>(m_max_index) / range : 0.0f;
+        auto max_x = static_cast<float>(m_max_index);
+
+        int32_t indices[kGradientLUTChunkSize];
+        float fractions[kGradientLUTChunkSize];
+
+        const float* __restrict table = m_rgba;
+
+        for (int64_t offset = 0; offset < n; offset += kGradientLUTChunkSize) {
+            auto count = static_cast<int32_t>(std::min<int64_t>(kGradientLUTChunkSize, n - offset));
+            const float* __restrict src = values + offset;
+            float* __restrict dst = out_rgba + offset * 4;
+
+            // Index pass
+            for (int32_t i = 0; i < count; i++) {
+                float x = std::fmin(std::fmax((src[i] - min) * scale, 0.0f), max_x);
+                auto index = static_cast<int32_t>(x);
+                indices[i] = index * 4;
+                fractions[i] = x - static_cast<float>(index);
+            }
+
+            // Blend pass
+            for (int32_t i = 0; i < count; i++) {
+                const float* c = table + indices[i];
+                float f = fractions[i];
+                dst[0] = c[0] + f * (c[4] - c[0]);
+                dst[1] = c[1] + f * (c[5] - c[1]);
+                dst[2] = c[2] + f * (c[6] - c[2]);
+                dst[3] = c[3] + f * (c[7] - c[3]);
+                dst += 4;
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Map an array of values to RGBA 8 bit colors.
+     *
+     *  Blends the float table like the float lookup and rounds the result, so
+     *  both lookups give the same colors.
+     */
+    void GradientLUT::lookup(const float* values, int64_t n, float min, float max, uint8_t* out_rgba8) const noexcept {
+
+        if (!values || !out_rgba8 || n < 1 || !m_rgba8) {
+            return;
+        }
+
+        float range = max - min;
+        float scale = std::fabs(range) > std::numeric_limits<float>::epsilon() ? static_cast<float>(m_max_index) / range : 0.0f;
+        auto max_x = static_cast<float>(m_max_index);
+
+        int32_t indices[kGradientLUTChunkSize];
+        float fractions[kGradientLUTChunkSize];
+
+        const float* __restrict table = m_rgba;
+
+        for (int64_t offset = 0; offset < n; offset += kGradientLUTChunkSize) {
+            auto count = static_cast<int32_t>(std::min<int64_t>(kGradientLUTChunkSize, n - offset));
+            const float* __restrict src = values + offset;
+            uint8_t* __restrict dst = out_rgba8 + offset * 4;
+
+            // Index pass
+            for (int32_t i = 0; i < count; i++) {
+                float x = std::fmin(std::fmax((src[i] - min) * scale, 0.0f), max_x);
+                auto index = static_cast<int32_t>(x);
+                indices[i] = index * 4;
+                fractions[i] = x - static_cast<float>(index);
+            }
+
+            // Blend pass
+            for (int32_t i = 0; i < count; i++) {
+                const float* c = table + indices[i];
+                float f = fractions[i];
+                for (int32_t j = 0; j < 4; j++) {
+                    float v = c[j] + f * (c[j + 4] - c[j]);
+                    dst[j] = static_cast<uint8_t>(std::fmin(std::fmax(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+                }
+                dst += 4;
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Colorize a value grid into an RGBA image.
+     *
+     *  `out_image` must have the same dimension as `value_grid` and use the
+     *  RGBA color model with `UInt8` or `Float` pixels. If the value grid has
+     *  an invalid value defined, these cells become fully transparent.
+     */
+    template <typename T>
+    ErrorCode GradientLUT::mapValueGrid(const ValueGrid<T>& value_grid, float min, float max, Image* out_image, bool flip_y) const noexcept {
+
+        if (!out_image) {
+            return ErrorCode::NullData;
+        }
+
+        if (!isValid() || !value_grid.hasValues()) {
+            return ErrorCode::NoData;
+        }
+
+        if (out_image->width() != value_grid.width() || out_image->height() != value_grid.height()) {
+            return ErrorCode::UnsupportedDimension;
+        }
+
+        if (out_image->colorModel() != Color::Model::RGBA) {
+            return ErrorCode::UnsupportedColorModel;
+        }
+
+        auto pixel_type = out_image->pixelType();
+        if (pixel_type != Image::PixelType::UInt8 && pixel_type != Image::PixelType::Float) {
+            return ErrorCode::UnsupportedDataType;
+        }
+
+        int32_t width = value_grid.width();
+        int32_t height = value_grid.height();
+        bool check_invalid = value_grid.hasFeature(ValueGrid<T>::kFeature_Invalid_Value);
+        T invalid_value = value_grid.invalidValue();
+
+        float* row_values = nullptr;
+        if constexpr (!std::is_same_v<T, float>) {
+            row_values = static_cast<float*>(std::malloc(sizeof(float) * width));
+            if (!row_values) {
+                return ErrorCode::MemCantAllocate;
+            }
+        }
+
+        for (int32_t y = 0; y < height; y++) {
+            const T* src = value_grid.ptrForRow(flip_y ? height - y - 1 : y);
+            const float* src_values;
+
+            if constexpr (std::is_same_v<T, float>) {
+                src_values = src;
+            }
+            else {
+                for (int32_t x = 0; x < width; x++) {
+                    row_values[x] = static_cast<float>(src[x]);
+                }
+                src_values = row_values;
+            }
+
+            uint8_t* dst = out_image->pixelDataPtrAtRow(y);
+
+            if (pixel_type == Image::PixelType::UInt8) {
+                lookup(src_values, width, min, max, dst);
+                if (check_invalid) {
+                    for (int32_t x = 0; x < width; x++) {
+                        if (src[x] == invalid_value) {
+                            std::memset(&dst[x * 4], 0, 4);
+                        }
+                    }
+                }
+            }
+            else {
+                auto dst_float = reinterpret_cast<float*>(dst);
+                lookup(src_values, width, min, max, dst_float);
+                if (check_invalid) {
+                    for (int32_t x = 0; x < width; x++) {
+                        if (src[x] == invalid_value) {
+                            std::memset(&dst_float[x * 4], 0, sizeof(float) * 4);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::free(row_values);
+
+        return ErrorCode::None;
+    }
+
+
+    // Instantiate for specific types
+    template ErrorCode GradientLUT::mapValueGrid<uint8_t>(const ValueGrid<uint8_t>&, float, float, Image*, bool) const noexcept;
+    template ErrorCode GradientLUT::mapValueGrid<int32_t>(const ValueGrid<int32_t>&, float, float, Image*, bool) const noexcept;
+    template ErrorCode GradientLUT::mapValueGrid<int64_t>(const ValueGrid<int64_t>&, float, float, Image*, bool) const noexcept;
+    template ErrorCode GradientLUT::mapValueGrid<float>(const ValueGrid<float>&, float, float, Image*, bool) const noexcept;
+    template ErrorCode GradientLUT::mapValueGrid<double>(const ValueGrid<double>&, float, float, Image*, bool) const noexcept;
+
+
+} // End of namespace Grain
@@ -212,6 +212,89 @@ namespace Grain {
 #endif
 
 
+    /**
+     *  @brief Forward transform of `len()` real samples.
+     *
+     *  Writes `len() / 2 + 1` bins from DC to Nyquist to `out_real` and
+     *  `out_imag`. The result is the unscaled DFT on all platforms, the
+     *  transform does not change the state used by `fft()` and `ifft()`
+     *  other than the internal buffers.
+     */
+    ErrorCode FFT::forward(const float* samples, float* out_real, float* out_imag) noexcept {
+        if (!samples || !out_real || !out_imag) {
+            return ErrorCode::NullData;
+        }
+
+#if defined(__APPLE__) && defined(__MACH__)
+        vDSP_ctoz(reinterpret_cast<const DSPComplex*>(samples), 2, &m_split_complex, 1, m_half_len);
+        vDSP_fft_zrip(m_fft_setup, &m_split_complex, 1, m_log_n, kFFTDirection_Forward);
+
+        // vDSP returns twice the DFT, with the Nyquist bin packed into imagp[0]
+        out_real[0] = m_split_complex.realp[0] * 0.5f;
+        out_imag[0] = 0.0f;
+        out_real[m_half_len] = m_split_complex.imagp[0] * 0.5f;
+        out_imag[m_half_len] = 0.0f;
+        for (int32_t k = 1; k < m_half_len; k++) {
+            out_real[k] = m_split_complex.realp[k] * 0.5f;
+            out_imag[k] = m_split_complex.imagp[k] * 0.5f;
+        }
+#else
+        std::memcpy(m_io_buffer, samples, sizeof(float) * m_len);
+        fftwf_execute(m_plan);
+
+        for (int32_t k = 0; k <= m_half_len; k++) {
+            out_real[k] = m_out[k][0];
+            out_imag[k] = m_out[k][1];
+        }
+#endif
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Inverse of `forward()`, `len() / 2 + 1` bins to `len()` samples.
+     *
+     *  The result is scaled by 1 / `len()`, so `inverse()` of the output of
+     *  `forward()` returns the original samples.
+     */
+    ErrorCode FFT::inverse(const float* real, const float* imag, float* out_samples) noexcept {
+        if (!real || !imag || !out_samples) {
+            return ErrorCode::NullData;
+        }
+
+        float scale = 1.0f / static_cast<float>(m_len);
+
+#if defined(__APPLE__) && defined(__MACH__)
+        m_split_complex.realp[0] = real[0];
+        m_split_complex.imagp[0] = real[m_half_len];
+        for (int32_t k = 1; k < m_half_len; k++) {
+            m_split_complex.realp[k] = real[k];
+            m_split_complex.imagp[k] = imag[k];
+        }
+
+        // The inverse of the unscaled spectrum returns `m_len` times the signal
+        vDSP_fft_zrip(m_fft_setup, &m_split_complex, 1, m_log_n, kFFTDirection_Inverse);
+        vDSP_vsmul(m_split_complex.realp, 1, &scale, m_split_complex.realp, 1, m_half_len);
+        vDSP_vsmul(m_split_complex.imagp, 1, &scale, m_split_complex.imagp, 1, m_half_len);
+        vDSP_ztoc(&m_split_complex, 1, reinterpret_cast<DSPComplex*>(out_samples), 2, m_half_len);
+#else
+        for (int32_t k = 0; k <= m_half_len; k++) {
+            m_out[k][0] = real[k];
+            m_out[k][1] = imag[k];
+        }
+
+        fftwf_execute(m_plan_inv);
+
+        for (int32_t i = 0; i < m_len; i++) {
+            out_samples[i] = m_io_buffer[i] * scale;
+        }
+#endif
+
+        return ErrorCode::None;
+    }
+
+
     ErrorCode FFT::filter(const Partials* partials) noexcept {
         m_split_complex.realp[0] *= partials->dc();
         m_split_complex.imagp[0] *= partials->mag(partials->resolution() - 1);
@@ -0,0 +1,520 @@
+//
+//  PartialsSynth.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "DSP/PartialsSynth.hpp"
+#include "DSP/Partials.hpp"
+#include "DSP/FFT.hpp"
+#include "Signal/Signal.hpp"
+#include "Signal/Audio.hpp"
+#include "Math/Math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Create a synthesizer for frames `frame_hop` samples apart.
+     *
+     *  The synthesis hop is the largest divisor of `frame_hop` which is not
+     *  above a quarter of `fft_len`. Use a `frame_hop` with small factors,
+     *  e.g. a power of two, otherwise the synthesis hop gets very short.
+     *
+     *  @param sample_rate Sample rate of the output.
+     *  @param frame_hop Distance of the `Partials` frames in samples.
+     *  @param fft_len Length of the synthesis frames, a power of two.
+     */
+    PartialsSynth::PartialsSynth(int32_t sample_rate, int32_t frame_hop, int32_t fft_len) noexcept {
+        sample_rate_ = std::clamp<int32_t>(sample_rate, 1, Audio::kMaxSampleRate);
+
+        int32_t log_n = Math::log2IfPowerOfTwo(fft_len);
+        if (log_n < FFT::kMinLogN || log_n > FFT::kMaxLogN || frame_hop < 1) {
+            return;
+        }
+
+        fft_len_ = fft_len;
+        bin_count_ = fft_len / 2 + 1;
+        frame_hop_ = frame_hop;
+        hop_ = 1;
+        for (int32_t h = std::min(fft_len / 4, frame_hop); h > 1; h--) {
+            if (frame_hop % h == 0) {
+                hop_ = h;
+                break;
+            }
+        }
+
+        try {
+            // Periodic 4-term Blackman-Harris window, centered on sample `n / 2`,
+            // where w = a0 + a1 cos(2 pi m / n) + a2 cos(4 pi m / n) + a3 cos(6 pi m / n)
+            static constexpr double a[4] = { 0.35875, 0.48829, 0.14128, 0.01168 };
+            double n = fft_len;
+
+            // The spectrum of the window is a sum of shifted Dirichlet kernels
+            auto dirichlet = [n](double x, double& out_re, double& out_im) {
+                double d = std::fabs(x) < 1.0e-9 ? n : std::sin(std::numbers::pi * x) / std::sin(std::numbers::pi * x / n);
+                out_re = d * std::cos(std::numbers::pi * x / n);
+                out_im = d * std::sin(std::numbers::pi * x / n);
+            };
+
+            int32_t kernel_len = kKernelWidth * kKernelOversampling + 2;  // One guard entry
+            kernel_real_.resize(kernel_len);
+            kernel_imag_.resize(kernel_len);
+            for (int32_t i = 0; i < kernel_len; i++) {
+                double delta = static_cast<double>(i) / static_cast<double>(kKernelOversampling) - static_cast<double>(kKernelHalfWidth);
+                double re, im;
+                dirichlet(delta, re, im);
+                double g_re = a[0] * re;
+                double g_im = a[0] * im;
+                for (int32_t r = 1; r < 4; r++) {
+                    dirichlet(delta - r, re, im);
+                    g_re += 0.5 * a[r] * re;
+                    g_im += 0.5 * a[r] * im;
+                    dirichlet(delta + r, re, im);
+                    g_re += 0.5 * a[r] * re;
+                    g_im += 0.5 * a[r] * im;
+                }
+                kernel_real_[i] = static_cast<float>(g_re);
+                kernel_imag_[i] = static_cast<float>(g_im);
+            }
+
+            // Divide out the window and apply a triangle, which sums up to 1 at `hop_`
+            synth_window_.resize(2 * hop_);
+            for (int32_t i = 0; i < 2 * hop_; i++) {
+                double m = i - hop_;
+                double w = a[0];
+                for (int32_t r = 1; r < 4; r++) {
+                    w += a[r] * std::cos(2.0 * std::numbers::pi * r * m / n);
+                }
+                synth_window_[i] = static_cast<float>((1.0 - std::fabs(m) / hop_) / w);
+            }
+
+            spec_real_.resize(bin_count_);
+            spec_imag_.resize(bin_count_);
+            frame_buffer_.resize(fft_len_);
+
+            fft_ = new (std::nothrow) FFT(log_n);
+            if (fft_ && fft_->len() != fft_len_) {
+                delete fft_;
+                fft_ = nullptr;
+            }
+        }
+        catch (...) {
+            delete fft_;
+            fft_ = nullptr;
+        }
+
+        reset();
+    }
+
+
+    PartialsSynth::~PartialsSynth() noexcept {
+        delete fft_;
+    }
+
+
+    /**
+     *  @brief Forget all frames and pending output.
+     */
+    void PartialsSynth::reset() noexcept {
+        frame_count_ = 0;
+        finished_ = false;
+        partial_count_ = 0;
+        ola_.clear();
+        ola_pos_ = -hop_;
+        ready_.clear();
+        ready_offs_ = 0;
+    }
+
+
+    /**
+     *  @brief Add the next frame.
+     *
+     *  Synthesizes the interval between the previous frame and this one.
+     *
+     *  @param partials The frame. Frames may differ in resolution, missing
+     *                  partials are silent.
+     *  @param base_freq Frequency of the first partial in Hz. If 0, the
+     *                   frequency of the first bin of an FFT with
+     *                   `2 * partials->resolution()` samples at the sample
+     *                   rate of the synthesizer is used.
+     */
+    ErrorCode PartialsSynth::pushFrame(const Partials* partials, float base_freq) noexcept {
+        auto result = ErrorCode::None;
+
+        try {
+            if (!isValid()) {
+                throw ErrorCode::ClassInstantiationFailed;
+            }
+            if (!partials) {
+                throw ErrorCode::NullData;
+            }
+            if (partials->resolution() < 1) {
+                throw ErrorCode::NoData;
+            }
+            if (finished_) {
+                throw ErrorCode::UnexpectedBehaviour;
+            }
+
+            _setNextFrame(partials, base_freq);
+
+            if (frame_count_ > 0) {
+                _synthesizeInterval(frame_hop_ / hop_);
+                _finalize(frame_count_ * frame_hop_ - hop_);
+            }
+
+            frame_count_++;
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Synthesize the end of the last frame.
+     *
+     *  After this call, all output is available for `pull()`. Call `reset()`
+     *  to start over.
+     */
+    ErrorCode PartialsSynth::finish() noexcept {
+        auto result = ErrorCode::None;
+
+        try {
+            if (!isValid()) {
+                throw ErrorCode::ClassInstantiationFailed;
+            }
+            if (finished_ || frame_count_ < 1) {
+                return ErrorCode::None;
+            }
+
+            // The last frame stays as it is for the final synthesis frame
+            prev_mag_ = next_mag_;
+            prev_freq_ = next_freq_;
+            std::fill(phase_step_.begin(), phase_step_.end(), 0.0);
+            _synthesizeInterval(1);
+
+            _finalize((frame_count_ - 1) * frame_hop_ + hop_);
+            finished_ = true;
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Take up to `max_count` finished samples.
+     *
+     *  @return The number of samples written to `out_samples`.
+     */
+    int64_t PartialsSynth::pull(float* out_samples, int64_t max_count) noexcept {
+        if (!out_samples || max_count < 1) {
+            return 0;
+        }
+
+        int64_t n = std::min(availableCount(), max_count);
+        std::copy(ready_.begin() + ready_offs_, ready_.begin() + ready_offs_ + n, out_samples);
+        ready_offs_ += n;
+        if (ready_offs_ >= static_cast<int64_t>(ready_.size())) {
+            ready_.clear();
+            ready_offs_ = 0;
+        }
+
+        return n;
+    }
+
+
+    /**
+     *  @brief Render a sequence of frames into a channel of a signal.
+     *
+     *  The signal grows if needed. Frame `k` is at sample
+     *  `offs + k * frameHop()`, the output ends `hop()` samples after the
+     *  last frame. The synthesizer is reset before and after rendering.
+     *
+     *  @param frames The frames.
+     *  @param base_freqs Frequency of the first partial for each frame, see
+     *                    `pushFrame()`. May be shorter than `frames`, missing
+     *                    values are 0.
+     */
+    ErrorCode PartialsSynth::render(
+            const std::vector<const Partials*>& frames, const std::vector<float>& base_freqs,
+            Signal* out_signal, int32_t channel, int64_t offs) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!isValid()) {
+                throw ErrorCode::ClassInstantiationFailed;
+            }
+            if (!out_signal) {
+                throw ErrorCode::NullData;
+            }
+            if (!out_signal->hasChannel(channel)) {
+                throw ErrorCode::UnsupportedChannelCount;
+            }
+            if (out_signal->sampleRate() != sample_rate_) {
+                throw ErrorCode::SampleRateMustBeEqual;
+            }
+            if (frames.empty()) {
+                throw ErrorCode::NoData;
+            }
+
+            offs = std::max<int64_t>(offs, 0);
+            int64_t sample_count = static_cast<int64_t>(frames.size() - 1) * frame_hop_ + hop_;
+            auto err = out_signal->growIfNeeded(offs + sample_count);
+            Exception::throwStandard(err);
+
+            reset();
+
+            std::vector<float> block(std::max(frame_hop_, hop_));
+            int64_t pos = offs;
+            for (size_t k = 0; k <= frames.size(); k++) {
+                if (k < frames.size()) {
+                    err = pushFrame(frames[k], k < base_freqs.size() ? base_freqs[k] : 0.0f);
+                }
+                else {
+                    err = finish();
+                }
+                Exception::throwStandard(err);
+
+                while (int64_t n = pull(block.data(), static_cast<int64_t>(block.size()))) {
+                    if (out_signal->isFloatType()) {
+                        out_signal->writeSamples(channel, pos, n, block.data());
+                    }
+                    else {
+                        for (int64_t i = 0; i < n; i++) {
+                            out_signal->writeFloat(channel, pos + i, block[i]);
+                        }
+                    }
+                    pos += n;
+                }
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        reset();
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Store a frame as the end of the next interval.
+     */
+    void PartialsSynth::_setNextFrame(const Partials* partials, float base_freq) {
+        int32_t resolution = partials->resolution();
+
+        if (resolution > partial_count_) {
+            // New partials start with the phase of this frame
+            const float* ph = partials->mutPhasePtr();
+            phase_.resize(resolution);
+            for (int32_t i = partial_count_; i < resolution; i++) {
+                phase_[i] = ph[i];
+            }
+            phase_step_.resize(resolution, 0.0);
+            prev_mag_.resize(resolution, 0.0f);
+            prev_freq_.resize(resolution, 0.0f);
+            next_mag_.resize(resolution, 0.0f);
+            next_freq_.resize(resolution, 0.0f);
+            next_phase_.resize(resolution, 0.0f);
+            mag_.resize(resolution, 0.0f);
+            freq_.resize(resolution, 0.0f);
+            partial_count_ = resolution;
+        }
+
+        if (base_freq <= 0.0f) {
+            base_freq = static_cast<float>(sample_rate_) / static_cast<float>(2 * resolution);
+        }
+
+        std::swap(prev_mag_, next_mag_);
+        std::swap(prev_freq_, next_freq_);
+
+        const float* ma = partials->mutMagPtr();
+        const float* ph = partials->mutPhasePtr();
+        for (int32_t i = 0; i < partial_count_; i++) {
+            next_freq_[i] = static_cast<float>(i + 1) * base_freq;
+            if (i < resolution) {
+                next_mag_[i] = ma[i];
+                next_phase_[i] = ph[i];
+            }
+            else {
+                next_mag_[i] = 0.0f;
+            }
+        }
+
+        if (frame_count_ == 0) {
+            return;
+        }
+
+        if (phase_mode_ == PhaseMode::Locked) {
+            // Spread the difference between the integrated phase and the
+            // phase of the next frame over the interval
+            int32_t step_count = frame_hop_ / hop_;
+            for (int32_t i = 0; i < partial_count_; i++) {
+                double advance = std::numbers::pi * frame_hop_ * (prev_freq_[i] + next_freq_[i]) / sample_rate_;
+                phase_step_[i] = i < resolution ? _wrapPhase(next_phase_[i] - (phase_[i] + advance)) / step_count : 0.0;
+            }
+        }
+        else {
+            std::fill(phase_step_.begin(), phase_step_.end(), 0.0);
+        }
+    }
+
+
+    /**
+     *  @brief Synthesize `step_count` frames from the previous frame on.
+     *
+     *  Magnitudes and frequencies are interpolated linearly towards the next
+     *  frame, the phases are integrated from frame to frame.
+     */
+    void PartialsSynth::_synthesizeInterval(int32_t step_count) {
+        int64_t center = (frame_count_ - 1) * frame_hop_;
+        double phase_scale = std::numbers::pi * hop_ / sample_rate_;
+
+        int64_t end = center + static_cast<int64_t>(step_count) * hop_ + hop_;
+        if (end - ola_pos_ > static_cast<int64_t>(ola_.size())) {
+            ola_.resize(end - ola_pos_, 0.0f);
+        }
+
+        for (int32_t step = 0; step < step_count; step++) {
+            float t = static_cast<float>(step) / static_cast<float>(step_count);
+            float t_next = static_cast<float>(step + 1) / static_cast<float>(step_count);
+            for (int32_t i = 0; i < partial_count_; i++) {
+                mag_[i] = prev_mag_[i] + (next_mag_[i] - prev_mag_[i]) * t;
+                freq_[i] = prev_freq_[i] + (next_freq_[i] - prev_freq_[i]) * t;
+            }
+
+            _synthesizeFrame(mag_.data(), freq_.data());
+
+            float* d = &ola_[center - hop_ - ola_pos_];
+            const float* s = &frame_buffer_[fft_len_ / 2 - hop_];
+            for (int32_t i = 0; i < 2 * hop_; i++) {
+                d[i] += s[i] * synth_window_[i];
+            }
+
+            // Trapezoidal integration of the frequency up to the next synthesis frame
+            for (int32_t i = 0; i < partial_count_; i++) {
+                double freq_next = prev_freq_[i] + (next_freq_[i] - prev_freq_[i]) * t_next;
+                phase_[i] = _wrapPhase(phase_[i] + phase_scale * (freq_[i] + freq_next) + phase_step_[i]);
+            }
+
+            center += hop_;
+        }
+    }
+
+
+    /**
+     *  @brief Build one windowed frame of all partials in `frame_buffer_`.
+     *
+     *  Each partial adds the spectrum of the window, shifted to its
+     *  frequency, to the bins around it. Contributions below bin 0 and above
+     *  the Nyquist bin are mirrored, as they are for a real signal.
+     */
+    void PartialsSynth::_synthesizeFrame(const float* mags, const float* freqs) noexcept {
+        std::fill(spec_real_.begin(), spec_real_.end(), 0.0f);
+        std::fill(spec_imag_.begin(), spec_imag_.end(), 0.0f);
+
+        int32_t half_len = fft_len_ / 2;
+        double bin_scale = static_cast<double>(fft_len_) / sample_rate_;
+        float* re_out = spec_real_.data();
+        float* im_out = spec_imag_.data();
+        auto half_width = static_cast<double>(kKernelHalfWidth);
+        auto oversampling = static_cast<double>(kKernelOversampling);
+
+        for (int32_t i = 0; i < partial_count_; i++) {
+            float amp = mags[i] * 0.5f;
+            double bin = freqs[i] * bin_scale;
+            if (amp < kMinMagnitude || bin <= 0.0 || bin > half_len) {
+                continue;
+            }
+
+            auto phase = static_cast<float>(phase_[i]);
+            float p_re = amp * std::cos(phase);
+            float p_im = amp * std::sin(phase);
+
+            auto first = static_cast<int32_t>(std::ceil(bin - half_width));
+            auto last = static_cast<int32_t>(std::floor(bin + half_width));
+            for (int32_t j = first; j <= last; j++) {
+                // Linear interpolation in the kernel table
+                double x = (j - bin + half_width) * oversampling;
+                auto xi = std::clamp<int32_t>(static_cast<int32_t>(x), 0, kKernelWidth * kKernelOversampling);
+                auto xf = static_cast<float>(x - xi);
+                float g_re = kernel_real_[xi] + (kernel_real_[xi + 1] - kernel_real_[xi]) * xf;
+                float g_im = kernel_imag_[xi] + (kernel_imag_[xi + 1] - kernel_imag_[xi]) * xf;
+
+                // Frames are centered, which alternates the sign of the bins
+                float sign = (j & 1) ? -1.0f : 1.0f;
+                float re = sign * (p_re * g_re - p_im * g_im);
+                float im = sign * (p_re * g_im + p_im * g_re);
+
+                if (j >= 0 && j <= half_len) {
+                    re_out[j] += re;
+                    im_out[j] += im;
+                }
+
+                int32_t mirror = j <= 0 ? -j : (j >= half_len ? fft_len_ - j : -1);
+                if (mirror >= 0 && mirror <= half_len) {
+                    re_out[mirror] += re;
+                    im_out[mirror] -= im;
+                }
+            }
+        }
+
+        fft_->inverse(re_out, im_out, frame_buffer_.data());
+    }
+
+
+    /**
+     *  @brief Move all samples before `end` to the output.
+     */
+    void PartialsSynth::_finalize(int64_t end) {
+        int64_t n = std::min<int64_t>(end - ola_pos_, static_cast<int64_t>(ola_.size()));
+        if (n <= 0) {
+            return;
+        }
+
+        // Samples before 0 belong to the fade in of the first frame
+        int64_t skip = std::clamp<int64_t>(-ola_pos_, 0, n);
+
+        if (ready_offs_ > 0) {
+            ready_.erase(ready_.begin(), ready_.begin() + ready_offs_);
+            ready_offs_ = 0;
+        }
+        ready_.insert(ready_.end(), ola_.begin() + skip, ola_.begin() + n);
+        ola_.erase(ola_.begin(), ola_.begin() + n);
+        ola_pos_ += n;
+    }
+
+
+    double PartialsSynth::_wrapPhase(double phase) noexcept {
+        return phase - 2.0 * std::numbers::pi * std::floor((phase + std::numbers::pi) / (2.0 * std::numbers::pi));
+    }
+
+
+} // End of namespace Grain
@@ -0,0 +1,494 @@
+//
+//  Resampler.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "DSP/Resampler.hpp"
+
+#include <numeric>
+
+
+namespace Grain {
+
+    Resampler::Resampler(int32_t src_rate, int32_t dst_rate, Quality quality) noexcept {
+        configure(src_rate, dst_rate, quality);
+    }
+
+
+    /**
+     *  @brief Prepare the filter bank for a conversion from `src_rate` to
+     *         `dst_rate` and reset the streaming state.
+     *
+     *  @return ErrorCode::None on success, ErrorCode::UnsupportedSampleRate for
+     *          rates below 1, ErrorCode::LimitExceeded if the ratio would need
+     *          an unreasonable long filter and ErrorCode::MemCantAllocate if the
+     *          filter bank could not be allocated.
+     */
+    ErrorCode Resampler::configure(int32_t src_rate, int32_t dst_rate, Quality quality) noexcept {
+        // Zero crossings on each side of the sinc and Kaiser beta per preset
+        static constexpr int32_t kZeroCrossings[] = { 8, 16, 32, 64 };
+        static constexpr double kBeta[] = { 6.0, 8.0, 10.0, 12.5 };
+        static constexpr int32_t kMaxTapCount = 1 << 16;
+
+        if (src_rate < 1 || dst_rate < 1) {
+            return ErrorCode::UnsupportedSampleRate;
+        }
+
+        auto result = ErrorCode::None;
+
+        try {
+            auto preset = static_cast<int32_t>(quality);
+            if (preset < 0 || preset > static_cast<int32_t>(Quality::Best)) {
+                throw ErrorCode::BadArgs;
+            }
+
+            // Reduced ratio, L / M
+            int32_t gcd = std::gcd(src_rate, dst_rate);
+            int64_t l = dst_rate / gcd;
+            int64_t m = src_rate / gcd;
+
+            // Kaiser design formulas: attenuation from beta and the resulting
+            // transition width, which is placed just below the Nyquist frequency
+            // of the lower rate.
+            double beta = kBeta[preset];
+            double attenuation = beta / 0.1102 + 8.7;
+            double transition = (attenuation - 7.95) / (2.285 * 2.0 * std::numbers::pi * 2.0 * kZeroCrossings[preset]);
+            double scale = std::min(1.0, static_cast<double>(dst_rate) / src_rate);
+            double cutoff = (0.5 - transition * 0.5) * scale;
+            double half_width = kZeroCrossings[preset] / scale;
+
+            auto tap_count = static_cast<int64_t>(std::ceil(half_width)) * 2;
+            if (tap_count > kMaxTapCount) {
+                throw ErrorCode::LimitExceeded;
+            }
+
+            bool polyphase = l <= kMaxPolyphaseCount;
+            int32_t phase_count = polyphase ? static_cast<int32_t>(l) : kTablePhaseCount;
+            int32_t row_count = polyphase ? phase_count : phase_count + 1;
+            int32_t tap_stride = static_cast<int32_t>((tap_count + kTapAlignment - 1) / kTapAlignment * kTapAlignment);
+
+            coefs_.assign(static_cast<size_t>(row_count) * tap_stride, 0.0f);
+
+            double i0_beta = besselI0(beta);
+            std::vector<double> row(tap_count);
+
+            for (int32_t phase = 0; phase < row_count; phase++) {
+                double frac = static_cast<double>(phase) / phase_count;
+                double sum = 0.0;
+
+                for (int64_t j = 0; j < tap_count; j++) {
+                    double t = static_cast<double>(j - tap_count / 2 + 1) - frac;
+                    double x = t / half_width;
+                    double value = 0.0;
+                    if (std::fabs(x) < 1.0) {
+                        double y = 2.0 * cutoff * t;
+                        double sinc = y != 0.0 ? std::sin(std::numbers::pi * y) / (std::numbers::pi * y) : 1.0;
+                        value = 2.0 * cutoff * sinc * besselI0(beta * std::sqrt(1.0 - x * x)) / i0_beta;
+                    }
+                    row[j] = value;
+                    sum += value;
+                }
+
+                // Unity gain at DC for every phase
+                float* dst = coefs_.data() + static_cast<size_t>(phase) * tap_stride;
+                for (int64_t j = 0; j < tap_count; j++) {
+                    dst[j] = static_cast<float>(row[j] / sum);
+                }
+            }
+
+            src_rate_ = src_rate;
+            dst_rate_ = dst_rate;
+            quality_ = quality;
+            polyphase_ = polyphase;
+            tap_count_ = static_cast<int32_t>(tap_count);
+            tap_stride_ = tap_stride;
+            phase_count_ = phase_count;
+            cutoff_ = cutoff;
+
+            if (polyphase) {
+                step_den_ = static_cast<uint64_t>(l);
+                step_index_ = m / l;
+                step_frac_ = static_cast<uint64_t>(m % l);
+            }
+            else {
+                // 32 bit fixed point position
+                double step = static_cast<double>(src_rate) / dst_rate;
+                step_den_ = uint64_t(1) << 32;
+                step_index_ = static_cast<int64_t>(step);
+                step_frac_ = static_cast<uint64_t>(std::llround((step - static_cast<double>(step_index_)) * static_cast<double>(step_den_)));
+                if (step_frac_ >= step_den_) {
+                    step_index_++;
+                    step_frac_ -= step_den_;
+                }
+            }
+
+            reset();
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        if (result != ErrorCode::None) {
+            tap_count_ = 0;
+            coefs_.clear();
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Number of output samples for `input_len` input samples, these
+     *         are all outputs at positions before the end of the input.
+     *
+     *  @return The number of output samples, or 0 if it does not fit into
+     *          `int64_t`.
+     */
+    int64_t Resampler::outputLength(int64_t input_len) const noexcept {
+        if (!isConfigured() || input_len <= 0) {
+            return 0;
+        }
+
+        // ceil(input_len * step_den_ / step), split into quotient and remainder,
+        // so the products stay in 64 bits. `step` itself fits, as `step_den_`
+        // is at most 2^32 and `step_index_` at most 2^31.
+        uint64_t step = static_cast<uint64_t>(step_index_) * step_den_ + step_frac_;
+        auto len = static_cast<uint64_t>(input_len);
+        uint64_t q = len / step;
+        uint64_t r = len % step;
+
+        if (q > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) / step_den_) {
+            return 0;
+        }
+
+        uint64_t rest;
+        if (r <= std::numeric_limits<uint64_t>::max() / step_den_) {
+            uint64_t r_den = r * step_den_;
+            rest = r_den / step + (r_den % step != 0 ? 1 : 0);
+        }
+        else {
+            // Only possible in table mode with a large step
+            rest = static_cast<uint64_t>(std::ceil(static_cast<long double>(r) * step_den_ / step));
+        }
+
+        uint64_t n = q * step_den_;
+        if (rest > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - n) {
+            return 0;
+        }
+
+        return static_cast<int64_t>(n + rest);
+    }
+
+
+    /**
+     *  @brief Convert a complete buffer.
+     *
+     *  Samples before and after the input are treated as zero. The resampler
+     *  state is not used, so this method can run concurrently on one instance.
+     *
+     *  @param in Input samples.
+     *  @param in_len Number of input samples.
+     *  @param in_stride Distance between input samples, e.g. the channel count
+     *                   for interleaved data.
+     *  @param out Output samples.
+     *  @param out_len Number of output samples to compute, usually
+     *                 `outputLength(in_len)`.
+     *  @param out_stride Distance between output samples.
+     */
+    ErrorCode Resampler::resample(
+            const float* in, int64_t in_len, int64_t in_stride,
+            float* out, int64_t out_len, int64_t out_stride) const noexcept
+    {
+        if (!isConfigured()) {
+            return ErrorCode::UnsupportedSettings;
+        }
+
+        if (!in || !out) {
+            return ErrorCode::NullData;
+        }
+
+        if (in_len < 0 || out_len < 0) {
+            return ErrorCode::LenOutOfRange;
+        }
+
+        if (in_stride < 1 || out_stride < 1) {
+            return ErrorCode::UnsupportedStepSize;
+        }
+
+        auto result = ErrorCode::None;
+
+        try {
+            // The input is copied block by block into a contiguous, zero padded
+            // buffer, so the filter loop neither needs bounds checks nor strides
+            const int64_t half = tap_count_ / 2;
+            const int64_t buffer_len = std::max<int64_t>(4096, tap_stride_ * 4);
+            std::vector<float> buffer(buffer_len);
+
+            int64_t index = 0;
+            uint64_t frac = 0;
+            int64_t n = 0;
+
+            while (n < out_len) {
+                int64_t first = index - half + 1;
+                int64_t copy_start = std::clamp<int64_t>(first, 0, in_len);
+                int64_t copy_end = std::clamp<int64_t>(first + buffer_len, 0, in_len);
+
+                std::fill(buffer.begin(), buffer.end(), 0.0f);
+                const float* s = in + copy_start * in_stride;
+                float* d = buffer.data() + (copy_start - first);
+                for (int64_t i = copy_start; i < copy_end; i++) {
+                    *d++ = *s;
+                    s += in_stride;
+                }
+
+                while (n < out_len) {
+                    int64_t window = index - half + 1 - first;
+                    if (window + tap_stride_ > buffer_len) {
+                        break;
+                    }
+                    out[n * out_stride] = _filter(buffer.data() + window, frac);
+                    _step(index, frac);
+                    n++;
+                }
+            }
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Restart streaming, all buffered input is discarded.
+     */
+    void Resampler::reset() noexcept {
+        const int64_t half = tap_count_ / 2;
+
+        // Prime the history with zeros, so the first output is centered on
+        // the first input sample
+        history_len_ = 0;
+        history_base_ = 1 - half;
+        input_count_ = 0;
+        pos_index_ = half - 1;
+        pos_frac_ = 0;
+
+        if (isConfigured() && half > 1) {
+            float* dst = _appendHistory(half - 1);
+            if (dst) {
+                std::fill(dst, dst + half - 1, 0.0f);
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Feed the next block of a stream.
+     *
+     *  All input is consumed. Output samples which don't fit into `out` are
+     *  delivered by the next call.
+     *
+     *  @return The number of samples written to `out`, or -1 if the input
+     *          could not be buffered.
+     */
+    int64_t Resampler::process(const float* in, int64_t in_len, float* out, int64_t out_capacity) noexcept {
+        if (!isConfigured() || !in || in_len < 0) {
+            return 0;
+        }
+
+        float* dst = _appendHistory(in_len);
+        if (!dst) {
+            return -1;
+        }
+        std::memcpy(dst, in, static_cast<size_t>(in_len) * sizeof(float));
+        input_count_ += in_len;
+
+        return _drain(out, out_capacity, input_count_);
+    }
+
+
+    /**
+     *  @brief Feed the next `in_len` samples from the read position of a ring
+     *         buffer, the read position is advanced.
+     *
+     *  @return The number of samples written to `out`, or -1 if the input
+     *          could not be buffered.
+     */
+    int64_t Resampler::process(RingBuffer<float>& in, int64_t in_len, float* out, int64_t out_capacity) noexcept {
+        if (!isConfigured() || !in.isUsable() || in_len < 0) {
+            return 0;
+        }
+
+        float* dst = _appendHistory(in_len);
+        if (!dst) {
+            return -1;
+        }
+        in.read(in_len, 1, dst);
+        input_count_ += in_len;
+
+        return _drain(out, out_capacity, input_count_);
+    }
+
+
+    /**
+     *  @brief End the stream and get the output samples, which are waiting for
+     *         input beyond the end of the stream.
+     *
+     *  Can be called repeatedly, if `out` is too small. Call `reset()` before
+     *  feeding a new stream.
+     *
+     *  @return The number of samples written to `out`, or -1 if the history
+     *          could not be extended.
+     */
+    int64_t Resampler::flush(float* out, int64_t out_capacity) noexcept {
+        if (!isConfigured()) {
+            return 0;
+        }
+
+        // Zeros up to the window end of the output at the last input position
+        const int64_t half = tap_count_ / 2;
+        int64_t missing = input_count_ + half - history_base_ - history_len_;
+        if (missing > 0) {
+            float* dst = _appendHistory(missing);
+            if (!dst) {
+                return -1;
+            }
+            std::fill(dst, dst + missing, 0.0f);
+        }
+
+        return _drain(out, out_capacity, input_count_);
+    }
+
+
+    /**
+     *  @brief Modified Bessel function of the first kind and order zero.
+     */
+    double Resampler::besselI0(double x) noexcept {
+        double sum = 1.0;
+        double term = 1.0;
+        double q = x * x * 0.25;
+
+        for (int32_t k = 1; k < 200; k++) {
+            term *= q / (static_cast<double>(k) * k);
+            sum += term;
+            if (term < sum * 1e-17) {
+                break;
+            }
+        }
+
+        return sum;
+    }
+
+
+    float Resampler::_filter(const float* window, uint64_t frac) const noexcept {
+        if (polyphase_) {
+            return _dot(window, _phasePtr(static_cast<int32_t>(frac)), tap_stride_);
+        }
+
+        // Interpolate between the two nearest phases of the table
+        constexpr int32_t kTableShift = 32 - std::countr_zero(static_cast<uint32_t>(kTablePhaseCount));
+        constexpr uint64_t kTableMask = (uint64_t(1) << kTableShift) - 1;
+
+        auto phase = static_cast<int32_t>(frac >> kTableShift);
+        float t = static_cast<float>(frac & kTableMask) / static_cast<float>(uint64_t(1) << kTableShift);
+        float a = _dot(window, _phasePtr(phase), tap_stride_);
+        float b = _dot(window, _phasePtr(phase + 1), tap_stride_);
+
+        return a + (b - a) * t;
+    }
+
+
+    void Resampler::_step(int64_t& index, uint64_t& frac) const noexcept {
+        index += step_index_;
+        frac += step_frac_;
+        if (frac >= step_den_) {
+            frac -= step_den_;
+            index++;
+        }
+    }
+
+
+    /**
+     *  @brief Compute outputs from the history, as long as the filter window is
+     *         covered and the output position is before `end_pos`.
+     */
+    int64_t Resampler::_drain(float* out, int64_t out_capacity, int64_t end_pos) noexcept {
+        const int64_t half = tap_count_ / 2;
+        int64_t n = 0;
+
+        if (out) {
+            while (n < out_capacity &&
+                   history_base_ + pos_index_ < end_pos &&
+                   pos_index_ + half + 1 <= history_len_) {
+                out[n++] = _filter(history_.data() + pos_index_ - half + 1, pos_frac_);
+                _step(pos_index_, pos_frac_);
+            }
+        }
+
+        // Drop samples, which are not needed anymore
+        int64_t drop = std::min(pos_index_ - half + 1, history_len_);
+        if (drop > 0) {
+            std::memmove(history_.data(), history_.data() + drop, static_cast<size_t>(history_len_ - drop + tap_stride_) * sizeof(float));
+            history_len_ -= drop;
+            history_base_ += drop;
+            pos_index_ -= drop;
+        }
+
+        return n;
+    }
+
+
+    /**
+     *  @brief Make room for `n` samples at the end of the history.
+     *
+     *  The `tap_stride_` samples after the new end are set to zero, so padded
+     *  taps never read stale values.
+     *
+     *  @return Pointer to the first new sample or nullptr on failure.
+     */
+    float* Resampler::_appendHistory(int64_t n) noexcept {
+        try {
+            auto needed = static_cast<size_t>(history_len_ + n + tap_stride_);
+            if (history_.size() < needed) {
+                history_.resize(std::max(needed, history_.size() * 2));
+            }
+        }
+        catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+
+        float* dst = history_.data() + history_len_;
+        history_len_ += n;
+        std::fill(dst + n, dst + n + tap_stride_, 0.0f);
+
+        return dst;
+    }
+
+
+    /**
+     *  @brief Dot product of `n` floats, `n` must be a multiple of
+     *         `kTapAlignment`.
+     *
+     *  Independent partial sums let the compiler vectorize the loop.
+     */
+    float Resampler::_dot(const float* a, const float* b, int32_t n) noexcept {
+        float acc[kTapAlignment] = {};
+        for (int32_t i = 0; i < n; i += kTapAlignment) {
+            for (int32_t k = 0; k < kTapAlignment; k++) {
+                acc[k] += a[i + k] * b[i + k];
+            }
+        }
+
+        return ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+    }
+
+
+} // End of namespace Grain
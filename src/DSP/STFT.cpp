@@ -0,0 +1,651 @@
+//
+//  STFT.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "DSP/STFT.hpp"
+#include "Math/Math.hpp"
+#include "Signal/Signal.hpp"
+#include "Image/Image.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Configure a transform.
+     *
+     *  @param sample_rate Sample rate of the analysed signals, used for the
+     *                     bin frequencies and the mel bands.
+     *  @param fft_len Length of the FFT, a power of two from 64 to 524288.
+     *  @param window_len Length of the analysis window, at most `fft_len`.
+     *                    The remaining samples are zero padded. 0 for
+     *                    `fft_len`.
+     *  @param hop Distance between two frames in samples. 0 for a quarter of
+     *             the window length.
+     *  @param window_type Analysis window, Hanning is used in its periodic
+     *                     form, which sums to a constant for hops of 1/2 and
+     *                     1/4 of the window length.
+     */
+    STFT::STFT(int32_t sample_rate, int32_t fft_len, int32_t window_len, int32_t hop, DSP::WindowType window_type) noexcept {
+        if (window_len <= 0) {
+            window_len = fft_len;
+        }
+        if (hop <= 0) {
+            hop = std::max(window_len / 4, 1);
+        }
+
+        sample_rate_ = sample_rate;
+        fft_len_ = fft_len;
+        window_len_ = window_len;
+        hop_ = hop;
+        window_type_ = window_type;
+
+        if (sample_rate <= 0 || !FFT::isValidResolution(fft_len) || Math::log2IfPowerOfTwo(fft_len) > FFT::kMaxLogN) {
+            return;
+        }
+        if (window_len < 2 || window_len > fft_len || hop > window_len) {
+            return;
+        }
+
+        bin_count_ = fft_len / 2 + 1;
+
+        try {
+            window_.resize(window_len);
+            if (window_type == DSP::WindowType::Hanning) {
+                DSP::hanningWindowPeriodic(window_len, window_.data());
+            }
+            else if (DSP::window(window_len, window_type, 0.0f, 0.0f, false, window_.data()) != ErrorCode::None) {
+                return;
+            }
+
+            double window_sum = 0.0;
+            for (float w : window_) {
+                window_sum += w;
+            }
+            if (window_sum <= 0.0) {
+                return;
+            }
+            amplitude_scale_ = static_cast<float>(2.0 / window_sum);
+
+            _buildMelBands();
+        }
+        catch (...) {
+            return;
+        }
+
+        valid_ = true;
+    }
+
+
+    /**
+     *  @brief Number of frames for a signal of `sample_count` samples, the last
+     *         frame is centered at or after the last sample.
+     */
+    int64_t STFT::frameCount(int64_t sample_count) const noexcept {
+        if (!valid_ || sample_count <= 0) {
+            return 0;
+        }
+        return (sample_count - 1) / hop_ + 1;
+    }
+
+
+    double STFT::binFreq(int32_t bin) const noexcept {
+        return fft_len_ > 0 ? static_cast<double>(bin) * sample_rate_ / fft_len_ : 0.0;
+    }
+
+
+    /**
+     *  @brief Set the number of threads used for the frames, 0 for one thread
+     *         per hardware thread.
+     */
+    void STFT::setThreadCount(int32_t thread_count) noexcept {
+        thread_count_ = std::max(thread_count, 0);
+    }
+
+
+    /**
+     *  @brief Configure the triangular mel filter bank used by `Scale::LogMel`.
+     *
+     *  @param band_count Number of bands.
+     *  @param min_freq Lower edge of the first band in Hz.
+     *  @param max_freq Upper edge of the last band in Hz, 0 for the Nyquist
+     *                  frequency.
+     */
+    ErrorCode STFT::setMelBands(int32_t band_count, float min_freq, float max_freq) noexcept {
+        float nyquist = static_cast<float>(sample_rate_) * 0.5f;
+        if (max_freq <= 0.0f) {
+            max_freq = nyquist;
+        }
+        if (band_count < 1 || min_freq < 0.0f || max_freq <= min_freq || max_freq > nyquist) {
+            return ErrorCode::BadArgs;
+        }
+
+        mel_band_count_ = band_count;
+        mel_min_freq_ = min_freq;
+        mel_max_freq_ = max_freq;
+
+        try {
+            _buildMelBands();
+        }
+        catch (const std::bad_alloc&) {
+            return ErrorCode::MemCantAllocate;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Complex spectrum of all frames.
+     *
+     *  @param samples First sample of the signal.
+     *  @param sample_count Number of samples.
+     *  @param stride Distance between two samples, e.g. the channel count of
+     *                interleaved data.
+     *  @param out_real, out_imag Destination for `frameCount(sample_count)`
+     *                  frames of `binCount()` values each, frame by frame.
+     */
+    ErrorCode STFT::forward(
+            const float* samples, int64_t sample_count, int64_t stride,
+            float* out_real, float* out_imag) noexcept {
+
+        if (!valid_) {
+            return ErrorCode::UnsupportedSettings;
+        }
+        if (!samples || !out_real || !out_imag) {
+            return ErrorCode::NullData;
+        }
+        if (sample_count < 1 || stride < 1) {
+            return ErrorCode::BadArgs;
+        }
+
+        auto result = ErrorCode::None;
+
+        try {
+            int64_t frame_count = frameCount(sample_count);
+            int32_t thread_count = _threadCountFor(frame_count);
+            _prepareFFTs(thread_count);
+
+            _parallelFor(frame_count, thread_count, [&](int32_t thread_index, int64_t begin, int64_t end) {
+                FFT* fft = ffts_[thread_index];
+                std::vector<float> frame(fft_len_);
+                for (int64_t f = begin; f < end; f++) {
+                    _loadFrame(samples, sample_count, stride, f, frame.data());
+                    auto offs = f * bin_count_;
+                    fft->forward(frame.data(), out_real + offs, out_imag + offs);
+                }
+            });
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Reconstruct a signal from frames in the layout of `forward()`
+     *         by weighted overlap-add.
+     *
+     *  @param real, imag `frame_count` frames of `binCount()` values.
+     *  @param frame_count Number of frames.
+     *  @param out_samples Destination, all `sample_count` samples are written.
+     *  @param sample_count Number of samples to reconstruct, usually the
+     *                      length of the analysed signal.
+     *  @param stride Distance between two samples in `out_samples`.
+     */
+    ErrorCode STFT::inverse(
+            const float* real, const float* imag, int64_t frame_count,
+            float* out_samples, int64_t sample_count, int64_t stride) noexcept {
+
+        if (!valid_) {
+            return ErrorCode::UnsupportedSettings;
+        }
+        if (!real || !imag || !out_samples) {
+            return ErrorCode::NullData;
+        }
+        if (frame_count < 1 || sample_count < 1 || stride < 1) {
+            return ErrorCode::BadArgs;
+        }
+
+        auto result = ErrorCode::None;
+
+        try {
+            for (int64_t i = 0; i < sample_count; i++) {
+                out_samples[i * stride] = 0.0f;
+            }
+
+            int32_t thread_count = _threadCountFor(frame_count);
+            _prepareFFTs(thread_count);
+
+            // Frames of chunks `c` and `c + 2` never overlap, so all even
+            // chunks and then all odd chunks can be added in parallel
+            int64_t min_chunk_len = (window_len_ + hop_ - 1) / hop_;
+            int64_t chunk_len = std::max(min_chunk_len, (frame_count + thread_count * 2 - 1) / (thread_count * 2));
+            int64_t chunk_count = (frame_count + chunk_len - 1) / chunk_len;
+            int32_t half_window_len = window_len_ / 2;
+
+            for (int64_t parity = 0; parity < 2; parity++) {
+                int64_t parity_chunk_count = (chunk_count - parity + 1) / 2;
+                _parallelFor(parity_chunk_count, thread_count, [&](int32_t thread_index, int64_t begin, int64_t end) {
+                    FFT* fft = ffts_[thread_index];
+                    std::vector<float> frame(fft_len_);
+                    for (int64_t i = begin; i < end; i++) {
+                        int64_t chunk = i * 2 + parity;
+                        int64_t f_end = std::min(frame_count, (chunk + 1) * chunk_len);
+                        for (int64_t f = chunk * chunk_len; f < f_end; f++) {
+                            auto offs = f * bin_count_;
+                            fft->inverse(real + offs, imag + offs, frame.data());
+
+                            int64_t start = f * hop_ - half_window_len;
+                            int64_t j0 = std::max<int64_t>(0, -start);
+                            int64_t j1 = std::min<int64_t>(window_len_, sample_count - start);
+                            for (int64_t j = j0; j < j1; j++) {
+                                out_samples[(start + j) * stride] += frame[j] * window_[j];
+                            }
+                        }
+                    }
+                });
+            }
+
+            // Normalize by the sum of the squared windows at each sample
+            _parallelFor(sample_count, thread_count, [&](int32_t, int64_t begin, int64_t end) {
+                for (int64_t n = begin; n < end; n++) {
+                    float norm = 0.0f;
+                    int64_t pos = n + half_window_len;
+                    int64_t j_end = std::min<int64_t>(window_len_ - 1, pos);
+                    for (int64_t j = pos % hop_; j <= j_end; j += hop_) {
+                        if ((pos - j) / hop_ < frame_count) {
+                            norm += window_[j] * window_[j];
+                        }
+                    }
+                    if (norm > 1.0e-8f) {
+                        out_samples[n * stride] /= norm;
+                    }
+                }
+            });
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Spectrogram of a signal.
+     *
+     *  The grid has one column per frame and one row per bin or mel band,
+     *  row 0 is the lowest frequency. Min and max of the values are set.
+     *
+     *  @return The spectrogram, owned by the caller, or nullptr on failure, in
+     *          which case `out_err` is set.
+     */
+    ValueGridf* STFT::spectrogram(
+            const float* samples, int64_t sample_count, int64_t stride,
+            Scale scale, ErrorCode& out_err) noexcept {
+
+        out_err = ErrorCode::None;
+        ValueGridf* grid = nullptr;
+
+        try {
+            if (!valid_) {
+                throw ErrorCode::UnsupportedSettings;
+            }
+            if (!samples) {
+                throw ErrorCode::NullData;
+            }
+            if (sample_count < 1 || stride < 1) {
+                throw ErrorCode::BadArgs;
+            }
+
+            int64_t frame_count = frameCount(sample_count);
+            int32_t row_count = scale == Scale::LogMel ? mel_band_count_ : bin_count_;
+            if (frame_count > std::numeric_limits<int32_t>::max() ||
+                frame_count * row_count > std::numeric_limits<int32_t>::max()) {
+                throw ErrorCode::LimitExceeded;
+            }
+
+            grid = new (std::nothrow) ValueGridf(static_cast<int32_t>(frame_count), row_count);
+            if (!grid || !grid->mutPtrForRow(0)) {
+                throw ErrorCode::MemCantAllocate;
+            }
+
+            float* values = grid->mutPtrForRow(0);
+            int32_t thread_count = _threadCountFor(frame_count);
+            _prepareFFTs(thread_count);
+
+            std::vector<float> thread_min(thread_count, std::numeric_limits<float>::max());
+            std::vector<float> thread_max(thread_count, std::numeric_limits<float>::lowest());
+
+            _parallelFor(frame_count, thread_count, [&](int32_t thread_index, int64_t begin, int64_t end) {
+                FFT* fft = ffts_[thread_index];
+                std::vector<float> frame(fft_len_);
+                std::vector<float> re(bin_count_);
+                std::vector<float> im(bin_count_);
+                float min = thread_min[thread_index];
+                float max = thread_max[thread_index];
+                float a2 = amplitude_scale_ * amplitude_scale_;
+
+                for (int64_t f = begin; f < end; f++) {
+                    _loadFrame(samples, sample_count, stride, f, frame.data());
+                    fft->forward(frame.data(), re.data(), im.data());
+
+                    // Power of each bin, `re` is reused as destination
+                    for (int32_t k = 0; k < bin_count_; k++) {
+                        re[k] = (re[k] * re[k] + im[k] * im[k]) * a2;
+                    }
+
+                    float* dst = values + f;
+                    for (int32_t y = 0; y < row_count; y++) {
+                        float v;
+                        switch (scale) {
+                            case Scale::Magnitude:
+                                v = std::sqrt(re[y]);
+                                break;
+                            case Scale::Power:
+                                v = re[y];
+                                break;
+                            case Scale::Decibel:
+                                v = 10.0f * std::log10(std::max(re[y], kMinPower));
+                                break;
+                            case Scale::LogMel: {
+                                const float* w = mel_weights_.data() + mel_weight_offs_[y];
+                                const float* p = re.data() + mel_first_bin_[y];
+                                float sum = 0.0f;
+                                for (int32_t i = 0; i < mel_bin_count_[y]; i++) {
+                                    sum += w[i] * p[i];
+                                }
+                                v = 10.0f * std::log10(std::max(sum, kMinPower));
+                                break;
+                            }
+                            default:
+                                v = 0.0f;
+                        }
+                        dst[static_cast<int64_t>(y) * frame_count] = v;
+                        min = std::min(min, v);
+                        max = std::max(max, v);
+                    }
+                }
+
+                thread_min[thread_index] = min;
+                thread_max[thread_index] = max;
+            });
+
+            grid->setMinMax(
+                    *std::min_element(thread_min.begin(), thread_min.end()),
+                    *std::max_element(thread_max.begin(), thread_max.end()));
+        }
+        catch (ErrorCode err) {
+            out_err = err;
+        }
+        catch (const std::bad_alloc&) {
+            out_err = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            out_err = ErrorCode::StdCppException;
+        }
+
+        if (out_err != ErrorCode::None) {
+            delete grid;
+            grid = nullptr;
+        }
+
+        return grid;
+    }
+
+
+    /**
+     *  @brief Spectrogram of one channel of a float signal, see above.
+     */
+    ValueGridf* STFT::spectrogram(const Signal* signal, int32_t channel, Scale scale, ErrorCode& out_err) noexcept {
+        if (!signal) {
+            out_err = ErrorCode::NullData;
+            return nullptr;
+        }
+        if (!signal->canAccessFloatInChannel(channel)) {
+            out_err = ErrorCode::InvalidChannel;
+            return nullptr;
+        }
+
+        auto samples = static_cast<const float*>(signal->dataPtr(channel));
+        return spectrogram(samples, signal->sampleCount(), signal->channelCount(), scale, out_err);
+    }
+
+
+    /**
+     *  @brief Render a spectrogram into a single channel float image.
+     *
+     *  Values are mapped from [`min_value`, `max_value`] to [0, 1] and
+     *  clamped, the lowest frequency is at the bottom of the image. If
+     *  `min_value` equals `max_value`, the min and max of the grid are used.
+     *
+     *  @return The image, owned by the caller, or nullptr on failure, in
+     *          which case `out_err` is set.
+     */
+    Image* STFT::spectrogramImage(const ValueGridf* grid, float min_value, float max_value, ErrorCode& out_err) noexcept {
+        out_err = ErrorCode::None;
+
+        if (!grid || !grid->ptrForRow(0)) {
+            out_err = ErrorCode::NullData;
+            return nullptr;
+        }
+
+        if (min_value == max_value) {
+            min_value = grid->min();
+            max_value = grid->max();
+        }
+        float range = max_value - min_value;
+        float scale = Safe::canSafelyDivideBy(range) ? 1.0f / range : 0.0f;
+
+        int32_t width = grid->width();
+        int32_t height = grid->height();
+        auto image = Image::createLuminaFloat(width, height);
+        if (!image || !image->hasPixel()) {
+            delete image;
+            out_err = ErrorCode::ClassInstantiationFailed;
+            return nullptr;
+        }
+
+        for (int32_t y = 0; y < height; y++) {
+            const float* src = grid->ptrForRow(height - 1 - y);
+            auto dst = reinterpret_cast<float*>(image->pixelDataPtrAtRow(y));
+            for (int32_t x = 0; x < width; x++) {
+                dst[x] = std::clamp((src[x] - min_value) * scale, 0.0f, 1.0f);
+            }
+        }
+
+        return image;
+    }
+
+
+    /**
+     *  @brief Frequency in Hz to mel, HTK formula.
+     */
+    double STFT::freqToMel(double freq) noexcept {
+        return 2595.0 * std::log10(1.0 + freq / 700.0);
+    }
+
+
+    double STFT::melToFreq(double mel) noexcept {
+        return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+    }
+
+
+    int32_t STFT::_threadCountFor(int64_t frame_count) const noexcept {
+        int32_t thread_count = thread_count_;
+        if (thread_count <= 0) {
+            thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+        }
+        return static_cast<int32_t>(std::clamp<int64_t>(frame_count / kMinFramesPerThread, 1, thread_count));
+    }
+
+
+    /**
+     *  @brief Make sure there is one FFT per thread. New transforms are kept
+     *         for all following calls.
+     */
+    void STFT::_prepareFFTs(int32_t thread_count) {
+        int32_t log_n = Math::log2IfPowerOfTwo(fft_len_);
+        while (ffts_.size() < thread_count) {
+            auto fft = new (std::nothrow) FFT(log_n);
+            if (!fft) {
+                throw ErrorCode::MemCantAllocate;
+            }
+            ffts_.push(fft);
+        }
+    }
+
+
+    /**
+     *  @brief Windowed and zero padded samples of frame `frame`.
+     */
+    void STFT::_loadFrame(const float* samples, int64_t sample_count, int64_t stride, int64_t frame, float* out_frame) const noexcept {
+        int64_t start = frame * hop_ - window_len_ / 2;
+        int64_t j0 = std::clamp<int64_t>(-start, 0, window_len_);
+        int64_t j1 = std::clamp<int64_t>(sample_count - start, j0, window_len_);
+
+        std::fill(out_frame, out_frame + j0, 0.0f);
+        for (int64_t j = j0; j < j1; j++) {
+            out_frame[j] = samples[(start + j) * stride] * window_[j];
+        }
+        std::fill(out_frame + j1, out_frame + fft_len_, 0.0f);
+    }
+
+
+    /**
+     *  @brief Triangular filters, equally spaced on the mel scale and
+     *         overlapping by half. Bands which are narrower than a bin use
+     *         the nearest bin.
+     */
+    void STFT::_buildMelBands() {
+        mel_first_bin_.clear();
+        mel_bin_count_.clear();
+        mel_weight_offs_.clear();
+        mel_weights_.clear();
+
+        if (bin_count_ < 2 || sample_rate_ <= 0) {
+            return;
+        }
+
+        double max_freq = mel_max_freq_ > 0.0f ? mel_max_freq_ : sample_rate_ * 0.5;
+        double min_mel = freqToMel(mel_min_freq_);
+        double max_mel = freqToMel(max_freq);
+        double bin_width = static_cast<double>(sample_rate_) / fft_len_;
+
+        for (int32_t band = 0; band < mel_band_count_; band++) {
+            double step = (max_mel - min_mel) / (mel_band_count_ + 1);
+            double lower = melToFreq(min_mel + step * band);
+            double center = melToFreq(min_mel + step * (band + 1));
+            double upper = melToFreq(min_mel + step * (band + 2));
+
+            auto first = std::clamp(static_cast<int32_t>(std::ceil(lower / bin_width)), 0, bin_count_ - 1);
+            auto last = std::clamp(static_cast<int32_t>(std::floor(upper / bin_width)), 0, bin_count_ - 1);
+
+            mel_weight_offs_.push_back(static_cast<int32_t>(mel_weights_.size()));
+
+            int32_t count = 0;
+            double weight_sum = 0.0;
+            for (int32_t k = first; k <= last; k++) {
+                double freq = k * bin_width;
+                double w = freq <= center ? (freq - lower) / (center - lower) : (upper - freq) / (upper - center);
+                w = std::clamp(w, 0.0, 1.0);
+                mel_weights_.push_back(static_cast<float>(w));
+                weight_sum += w;
+                count++;
+            }
+
+            if (weight_sum <= 0.0) {
+                mel_weights_.resize(mel_weight_offs_.back());
+                first = std::clamp(static_cast<int32_t>(std::lround(center / bin_width)), 0, bin_count_ - 1);
+                mel_weights_.push_back(1.0f);
+                count = 1;
+            }
+
+            mel_first_bin_.push_back(first);
+            mel_bin_count_.push_back(count);
+        }
+    }
+
+
+    /**
+     *  @brief Call `func` for ranges of [0, count) on up to `thread_count`
+     *         threads. The first argument of `func` is the index of the
+     *         thread.
+     *
+     *  An exception in a worker thread is caught there, after all threads
+     *  have finished `ErrorCode::ComputationFailed` is thrown. If a thread
+     *  can't be started, the started ones are joined and the exception is
+     *  passed on.
+     */
+    void STFT::_parallelFor(int64_t count, int32_t thread_count, const std::function<void(int32_t, int64_t, int64_t)>& func) {
+        if (count <= 0) {
+            return;
+        }
+
+        thread_count = static_cast<int32_t>(std::clamp<int64_t>(thread_count, 1, count));
+        if (thread_count == 1) {
+            func(0, 0, count);
+            return;
+        }
+
+        std::atomic<bool> failed{false};
+
+        auto run_range = [&](int32_t thread_index, int64_t begin, int64_t end) {
+            try {
+                func(thread_index, begin, end);
+            }
+            catch (...) {
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        try {
+            threads.reserve(thread_count);
+            for (int32_t i = 0; i < thread_count; i++) {
+                int64_t begin = count * i / thread_count;
+                int64_t end = count * (i + 1) / thread_count;
+                threads.emplace_back(run_range, i, begin, end);
+            }
+        }
+        catch (...) {
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            throw;
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (failed) {
+            throw ErrorCode::ComputationFailed;
+        }
+    }
+
+
+} // End of namespace Grain
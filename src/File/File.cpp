@@ -2809,6 +2809,7 @@ NSString *file = [NSString stringWithUTF8String:file_path.utf8()];
         out_file_entry.path_.clear();
         out_file_entry.name_.clear();
         out_file_entry.file_size_ = 0;
+        out_file_entry.mod_time_ = 0;
 
         try {
             if (File::fileExists(file_path)) {
@@ -2821,9 +2822,11 @@ NSString *file = [NSString stringWithUTF8String:file_path.utf8()];
                 if (out_file_entry.reg_file_flag_) {
                     try {
                         out_file_entry.file_size_ = std::filesystem::file_size(path);
+                        out_file_entry.mod_time_ = std::filesystem::last_write_time(path).time_since_epoch().count();
                     }
                     catch (const std::filesystem::filesystem_error&) {
                         out_file_entry.file_size_ = 0; // Handle inaccessible files gracefully
+                        out_file_entry.mod_time_ = 0;
                     }
                 }
             }
@@ -2851,6 +2854,7 @@ NSString *file = [NSString stringWithUTF8String:file_path.utf8()];
                 file_entry.name_ = entry.path().filename().string().c_str();
                 if (file_entry.reg_file_flag_) {
                     file_entry.file_size_ = entry.file_size();
+                    file_entry.mod_time_ = entry.last_write_time().time_since_epoch().count();
                 }
                 else {
                     file_entry.file_size_ = 0;
@@ -2898,6 +2902,7 @@ NSString *file = [NSString stringWithUTF8String:file_path.utf8()];
                 file_entry.name_ = entry->path().filename().string().c_str();
                 if (file_entry.reg_file_flag_) {
                     file_entry.file_size_ = entry->file_size();
+                    file_entry.mod_time_ = entry->last_write_time().time_since_epoch().count();
                 }
                 else {
                     file_entry.file_size_ = 0;
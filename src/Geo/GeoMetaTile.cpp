@@ -369,6 +369,7 @@ namespace Grain {
         m_meta_tiles_needed = m_horizontal_tile_n * m_vertical_tile_n;
 
         m_reset_flag = true;
+        m_start_flag = false;
         m_curr_index = 0;
     }
 
@@ -430,6 +431,7 @@ namespace Grain {
             m_curr_meta_index.set(tile_x_offset, tile_y_offset);
 
             m_reset_flag = false;
+            m_start_flag = true;
 
             return true;
         }
@@ -460,6 +462,10 @@ namespace Grain {
             m_curr_meta_index.set(0, 0);
             m_reset_flag = false;
         }
+        else if (m_start_flag) {
+            // First call after `setStartIndex()`
+            m_start_flag = false;
+        }
         else {
             m_curr_tile.x_ += kGridSize;
             m_curr_meta_index.x_++;
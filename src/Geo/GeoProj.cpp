@@ -59,6 +59,10 @@ namespace Grain {
                 _update();
             }
 
+            // The error number of PROJ is sticky, a failed transformation
+            // would fail all following ones
+            proj_errno_reset((PJ*)m_proj);
+
             PJ_COORD in_coord = proj_coord(pos.x_, pos.y_, 0, 0);
             PJ_COORD out_coord = proj_trans((PJ*)m_proj, pj_direction, in_coord);
 
@@ -0,0 +1,222 @@
+//
+//  GeoProjApprox.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Geo/GeoProjApprox.hpp"
+
+
+namespace Grain {
+
+    GeoProjApprox::GeoProjApprox(GeoProj* proj, GeoProj::Direction direction) noexcept {
+
+        proj_ = proj;
+        direction_ = direction;
+    }
+
+
+    /**
+     *  @brief Build the interpolation grid for a source rectangle.
+     *
+     *  @param src_rect The region in source coordinates, where the
+     *                  approximation will be used.
+     *  @param max_error Maximum deviation from the exact transformation in
+     *                   destination units.
+     *  @param max_depth Maximum number of subdivisions, 0 to `kMaxDepth`.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode GeoProjApprox::setup(const Rectd& src_rect, double max_error, int32_t max_depth) noexcept {
+
+        clear();
+
+        if (!proj_) {
+            return ErrorCode::NullPointer;
+        }
+
+        if (!(src_rect.width_ > 0.0) || !(src_rect.height_ > 0.0) || !(max_error >= 0.0)) {
+            return ErrorCode::BadArgs;
+        }
+
+        src_rect_ = src_rect;
+        max_error_ = max_error;
+        max_depth_ = std::clamp<int32_t>(max_depth, 0, kMaxDepth);
+
+        try {
+            Cell root;
+            root.x0_ = src_rect.x_;
+            root.y0_ = src_rect.y_;
+            root.x1_ = src_rect.x_ + src_rect.width_;
+            root.y1_ = src_rect.y_ + src_rect.height_;
+
+            const Vec2d src_corners[4] = {
+                Vec2d(root.x0_, root.y0_), Vec2d(root.x1_, root.y0_),
+                Vec2d(root.x0_, root.y1_), Vec2d(root.x1_, root.y1_)
+            };
+            for (int32_t i = 0; i < 4; i++) {
+                if (_exactTransform(src_corners[i], root.corners_[i])) {
+                    root.valid_mask_ |= 0x1 << i;
+                }
+            }
+
+            cells_.push_back(root);
+            _buildCell(0, 0);
+        }
+        catch (const std::exception& e) {
+            clear();
+            return ErrorCode::StdCppException;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    void GeoProjApprox::clear() noexcept {
+
+        cells_.clear();
+        leaf_count_ = 0;
+        exact_transform_count_.store(0, std::memory_order_relaxed);
+    }
+
+
+    /**
+     *  @brief Transform a position, approximated inside the source rectangle.
+     *
+     *  @return true on success, false if an exact transformation failed.
+     */
+    bool GeoProjApprox::transform(const Vec2d& pos, Vec2d& out_pos) const noexcept {
+
+        if (cells_.empty() ||
+            pos.x_ < src_rect_.x_ || pos.x_ > src_rect_.x_ + src_rect_.width_ ||
+            pos.y_ < src_rect_.y_ || pos.y_ > src_rect_.y_ + src_rect_.height_) {
+            return _exactTransform(pos, out_pos);
+        }
+
+        const Cell* cell = &cells_[0];
+        while (cell->first_child_ >= 0) {
+            int32_t i = (pos.x_ >= 0.5 * (cell->x0_ + cell->x1_) ? 1 : 0) + (pos.y_ >= 0.5 * (cell->y0_ + cell->y1_) ? 2 : 0);
+            cell = &cells_[cell->first_child_ + i];
+        }
+
+        if (cell->exact_) {
+            return _exactTransform(pos, out_pos);
+        }
+
+        double u = (pos.x_ - cell->x0_) / (cell->x1_ - cell->x0_);
+        double v = (pos.y_ - cell->y0_) / (cell->y1_ - cell->y0_);
+        out_pos = _bilinear(cell->corners_, u, v);
+
+        return true;
+    }
+
+
+    bool GeoProjApprox::_exactTransform(const Vec2d& pos, Vec2d& out_pos) const noexcept {
+
+        exact_transform_count_.fetch_add(1, std::memory_order_relaxed);
+        return proj_->transform(pos, out_pos, direction_);
+    }
+
+
+    /**
+     *  @brief Check a cell against the error bound and subdivide if needed.
+     *
+     *  The cell is tested at the four edge midpoints and the center. These
+     *  five exact positions together with the corners become the corners of
+     *  the four child cells, so each level costs five transformations per
+     *  cell. A cell where none of the nine positions can be transformed is
+     *  not subdivided.
+     */
+    void GeoProjApprox::_buildCell(int32_t cell_index, int32_t depth) {
+
+        Cell cell = cells_[cell_index];     // Copy, `cells_` grows below
+
+        double xm = 0.5 * (cell.x0_ + cell.x1_);
+        double ym = 0.5 * (cell.y0_ + cell.y1_);
+
+        // 3 x 3 grid of positions, index = y * 3 + x
+        Vec2d grid[9];
+        bool grid_valid[9];
+
+        const int32_t corner_grid_index[4] = { 0, 2, 6, 8 };
+        for (int32_t i = 0; i < 4; i++) {
+            grid[corner_grid_index[i]] = cell.corners_[i];
+            grid_valid[corner_grid_index[i]] = (cell.valid_mask_ & (0x1 << i)) != 0;
+        }
+
+        const int32_t mid_grid_index[5] = { 1, 3, 4, 5, 7 };
+        const double mid_u[5] = { 0.5, 0.0, 0.5, 1.0, 0.5 };
+        const double mid_v[5] = { 0.0, 0.5, 0.5, 0.5, 1.0 };
+
+        bool valid = cell.valid_mask_ == 0xF;
+        bool any_valid = cell.valid_mask_ != 0;
+        double error = 0.0;
+
+        for (int32_t i = 0; i < 5; i++) {
+            Vec2d src_pos(cell.x0_ + mid_u[i] * (cell.x1_ - cell.x0_), cell.y0_ + mid_v[i] * (cell.y1_ - cell.y0_));
+            int32_t gi = mid_grid_index[i];
+            grid_valid[gi] = _exactTransform(src_pos, grid[gi]);
+
+            if (grid_valid[gi]) {
+                any_valid = true;
+            }
+
+            if (grid_valid[gi] && valid) {
+                Vec2d approx_pos = _bilinear(cell.corners_, mid_u[i], mid_v[i]);
+                error = std::max(error, approx_pos.distance(grid[gi]));
+            }
+            else {
+                valid = false;
+            }
+        }
+
+        if (valid && error <= max_error_) {
+            leaf_count_++;
+            return;
+        }
+
+        // A cell without any transformable position is most likely outside
+        // the domain of the projection, subdividing it would only repeat the
+        // failing transformations
+        if (!any_valid || depth >= max_depth_) {
+            cells_[cell_index].exact_ = true;
+            leaf_count_++;
+            return;
+        }
+
+        // Subdivide, children in the order (x0, y0), (xm, y0), (x0, ym), (xm, ym)
+        auto first_child = static_cast<int32_t>(cells_.size());
+        cells_[cell_index].first_child_ = first_child;
+
+        const double xs[3] = { cell.x0_, xm, cell.x1_ };
+        const double ys[3] = { cell.y0_, ym, cell.y1_ };
+
+        for (int32_t cy = 0; cy < 2; cy++) {
+            for (int32_t cx = 0; cx < 2; cx++) {
+                Cell child;
+                child.x0_ = xs[cx];
+                child.x1_ = xs[cx + 1];
+                child.y0_ = ys[cy];
+                child.y1_ = ys[cy + 1];
+
+                for (int32_t i = 0; i < 4; i++) {
+                    int32_t gi = (cy + i / 2) * 3 + cx + i % 2;
+                    child.corners_[i] = grid[gi];
+                    if (grid_valid[gi]) {
+                        child.valid_mask_ |= 0x1 << i;
+                    }
+                }
+
+                cells_.push_back(child);
+            }
+        }
+
+        for (int32_t i = 0; i < 4; i++) {
+            _buildCell(first_child + i, depth + 1);
+        }
+    }
+
+
+} // End of namespace Grain
@@ -31,6 +31,7 @@
 #include "2d/GraphicCompoundPath.hpp"
 #include "File/File.hpp"
 #include "String/StringList.hpp"
+#include "String/StringBuilder.hpp"
 #include "Color/Gradient.hpp"
 #include "Type/Type.hpp"
 #include "Geo/GeoMetaTile.hpp"
@@ -101,7 +102,7 @@ namespace Grain {
         m_layers.clear();
 
         delete m_default_render_proj;
-        delete m_render_image;
+        _freeRenderImage();
 
         _freeLua();
 
@@ -796,6 +797,10 @@ namespace Grain {
             l << "total meta tiles: " << m_total_meta_tile_n << l.endl;
         }
 
+        auto pool_stats = m_image_buffer_pool.stats();
+        l << "image buffers acquired: " << pool_stats.acquire_count_ << ", allocated: " << pool_stats.alloc_count_ << l.endl;
+        l << "image buffers peak: " << (pool_stats.peak_bytes_allocated_ / (1024 * 1024)) << " MiB" << l.endl;
+
         l--;
         l << "Layers:" << l.endl;
         l++;
@@ -831,8 +836,7 @@ namespace Grain {
         l << l.endl;
 
         // Cleanup
-        delete m_render_image;
-        m_render_image = nullptr;
+        _freeRenderImage();
 
         m_layers.clear();   // TODO: Release all layers!
 
@@ -865,7 +869,7 @@ namespace Grain {
         try {
             // Allocate image for a single tile, which will be saved to file
 
-            tile_image = Image::createRGBAFloat(m_tile_size, m_tile_size);
+            tile_image = Image::createRGBAFloat(m_tile_size, m_tile_size, &m_image_buffer_pool);
             if (!tile_image) {
                 Exception::throwSpecific(kErrUnableToAllocateTileImage);
             }
@@ -973,6 +977,7 @@ namespace Grain {
                                     String dir_path;
                                     String file_name;
                                     String file_path;
+                                    StringBuilder path_builder(256, &StringArena::threadArena());
 
                                     if (m_render_mode == RenderMode::Tiles) {  // Slippy map
                                         auto err = Geo::slippyTilePathForTile(m_output_path.utf8(), m_current_zoom, sub_tile, m_output_file_ext, dir_path, file_name);
@@ -983,12 +988,20 @@ namespace Grain {
                                             Exception::throwStandard(ErrorCode::FileDirNotFound);
                                         }
 
-                                        file_path = dir_path + "/" + file_name;
+                                        path_builder += dir_path;
+                                        path_builder += '/';
+                                        path_builder += file_name;
                                     }
                                     else if (m_render_mode == RenderMode::MetaTiles) {
-                                        file_path = meta_temp_dir + "/_tile_" + (sx + sy * 8) + "." + m_output_file_ext;
+                                        path_builder += meta_temp_dir;
+                                        path_builder += "/_tile_";
+                                        path_builder += sx + sy * 8;
+                                        path_builder += '.';
+                                        path_builder += m_output_file_ext;
                                     }
 
+                                    path_builder.toString(file_path);
+
 
                                     switch (m_output_file_type) {
                                         case Image::FileType::PNG:
@@ -1221,8 +1234,13 @@ namespace Grain {
 
             _updateMeterPerPixel();
 
+            if (m_render_image &&
+                (m_render_image->width() != m_render_image_size.width() || m_render_image->height() != m_render_image_size.height())) {
+                _freeRenderImage();
+            }
+
             if (!m_render_image) {
-                m_render_image = Image::createRGBAFloat(m_render_image_size.width(), m_render_image_size.height());
+                m_render_image = Image::createRGBAFloat(m_render_image_size.width(), m_render_image_size.height(), &m_image_buffer_pool);
                 if (!m_render_image) {
                     Exception::throwSpecific(kErrUnableToAllocateRenderImage);
                 }
@@ -1230,21 +1248,23 @@ namespace Grain {
 
             if (m_render_image->beginDraw()) {
                 m_render_image->clear(RGBA(m_map_bg_color, m_map_bg_opacity));
-                GraphicContext* gc = nullptr;
-                if (m_renderer_name.compareIgnoreCase("cairo") == 0) {
-                    gc = new CairoContext();
-                }
+                if (!m_render_gc) {
+                    if (m_renderer_name.compareIgnoreCase("cairo") == 0) {
+                        m_render_gc = new (std::nothrow) CairoContext();
+                    }
 #if defined(__APPLE__) && defined(__MACH__)
-                else {
-                    gc = new AppleCGContext();
-                }
+                    else {
+                        m_render_gc = new (std::nothrow) AppleCGContext();
+                    }
 #endif
-                if (!gc) {
+                }
+                if (!m_render_gc) {
                     Exception::throwSpecific(kErrGraphicsContextFailed);
                 }
 
-                gc->setImage(m_render_image);
-                _renderLayers(gc, remap_rect);
+                // Same image as in the previous rendering, the context keeps its resources
+                m_render_gc->setImage(m_render_image);
+                _renderLayers(m_render_gc, remap_rect);
 
                 m_render_image->endDraw();
             }
@@ -1260,6 +1280,17 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Free the render image and the graphic context drawing into it.
+     */
+    void GeoTileRenderer::_freeRenderImage() noexcept {
+        delete m_render_gc;
+        m_render_gc = nullptr;
+        delete m_render_image;
+        m_render_image = nullptr;
+    }
+
+
     /**
      *  @brief Render all layers in the current map context.
      *
@@ -1490,7 +1521,7 @@ namespace Grain {
         // Replace variables in SQL query
         String sql = layer->m_sql_query;
         if (layer->m_sql_query.find("{{") >= 0) {
-            char buffer[32];
+            char buffer[String::kNumberStrBufferSize];
             if (m_psql_layer_verbose_level > 1) {
                 l << "Replace variables in SQL query: " << l.endl;
             }
@@ -1509,10 +1540,10 @@ namespace Grain {
             sql.replace("{{min-y}}", m_render_top_string);
             sql.replace("{{max-y}}", m_render_bottom_string);
 
-            std::snprintf(buffer, 32, "%d", m_dst_srid);
+            String::formatInt64(m_dst_srid, buffer);
             sql.replace("{{destination-srid}}", buffer);
 
-            std::snprintf(buffer, 32, "%d", m_current_zoom);
+            String::formatInt64(m_current_zoom, buffer);
             sql.replace("{{zoom-level}}", buffer);
 
             if (m_psql_layer_verbose_level > 2) {
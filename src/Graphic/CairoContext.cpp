@@ -103,7 +103,29 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Draw into `image`.
+     *
+     *  Setting the same image again keeps the Cairo surface and context and
+     *  only resets the drawing state, so a context can be reused for many
+     *  renderings without allocations.
+     */
     void CairoContext::setImage(Image* image) noexcept {
+        if (!image) {
+            return;
+        }
+
+        if (image == m_image && m_cairo_cr && cairo_image_surface_get_data(m_cairo_surface) == image->mutPixelDataPtr()) {
+            while (m_state_depth > 0) {
+                restore();
+            }
+            // Back to the state saved after creation
+            cairo_restore(m_cairo_cr);
+            cairo_save(m_cairo_cr);
+            cairo_new_path(m_cairo_cr);
+            return;
+        }
+
         GraphicContext::setImage(image);
 
         if (image->colorModel() == Color::Model::RGBA && image->isFloat()) {
@@ -116,6 +138,7 @@ namespace Grain {
                     image->height(),
                     image->bytesPerRow());
             m_cairo_cr = cairo_create((::cairo_surface_t*)m_cairo_surface);
+            cairo_save(m_cairo_cr);
         }
     }
 
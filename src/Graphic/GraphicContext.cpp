@@ -89,7 +89,7 @@ namespace Grain {
     }
 
     void GraphicContext::setImage(Image* image) noexcept {
-        if (!image) {
+        if (!image || image == m_image) {
             return;
         }
         _freeImage();
@@ -9,6 +9,7 @@
 
 #include "Image/Image.hpp"
 #include "Image/ICCProfiles.hpp"
+#include "Image/ImageBufferPool.hpp"
 #include "Color/Gradient.hpp"
 #include "Color/RGB.hpp"
 #include "Color/HSV.hpp"
@@ -22,9 +23,6 @@
 
 #include <libraw/libraw.h>
 #include <tiffio.h>
-#include <webp/encode.h>
-#include <png.h>
-#include <jpeglib.h>
 
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -973,6 +971,21 @@ namespace Grain {
         _malloc();
     }
 
+
+    /**
+     *  @brief Create an image with pixel data borrowed from a buffer pool.
+     *
+     *  The pixel data is returned to the pool when the image is destroyed,
+     *  so the pool must outlive the image.
+     *
+     *  @param buffer_pool The pool, nullptr for memory owned by the image.
+     */
+    Image::Image(ImageBufferPool* buffer_pool, Color::Model color_model, int32_t width, int32_t height, PixelType pixel_type) noexcept : Object() {
+        _set(color_model, width, height, pixel_type);
+        _m_buffer_pool = buffer_pool;
+        _malloc();
+    }
+
 /* TODO !!!!!
 #if defined(__APPLE__) && defined(__MACH__)
     Image::Image(NSImage *ns_image, Image::PixelType data_type) noexcept : Object() {
@@ -1534,6 +1547,89 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Composite an image with premultiplied alpha on top of this image.
+     *
+     *  Fast blit for sprites, such as pre-rendered map symbols. Both images
+     *  must use the RGBA color model with the same pixel type, `UInt8` or
+     *  `Float`, and premultiplied alpha, as produced by the graphic contexts.
+     *  The source is clipped against the bounds of this image.
+     *
+     *  @param src_image The image to composite.
+     *  @param x Horizontal position of the top left corner of `src_image`.
+     *  @param y Vertical position of the top left corner of `src_image`.
+     *  @param alpha Additional opacity applied to `src_image`.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode Image::compositeImage(const Image* src_image, int32_t x, int32_t y, float alpha) noexcept {
+
+        if (!src_image) {
+            return ErrorCode::NullData;
+        }
+
+        if (src_image == this) {
+            return ErrorCode::MemPointsToItself;
+        }
+
+        if (m_color_model != Color::Model::RGBA || src_image->m_color_model != Color::Model::RGBA) {
+            return ErrorCode::UnsupportedColorModel;
+        }
+
+        if (m_pixel_type != src_image->m_pixel_type ||
+            (m_pixel_type != PixelType::UInt8 && m_pixel_type != PixelType::Float)) {
+            return ErrorCode::UnsupportedDataType;
+        }
+
+        int32_t x1 = std::max(x, 0);
+        int32_t y1 = std::max(y, 0);
+        int32_t x2 = std::min(x + src_image->width_, width_);
+        int32_t y2 = std::min(y + src_image->height_, height_);
+
+        if (x1 >= x2 || y1 >= y2 || alpha <= 0.0f) {
+            return ErrorCode::None;  // Nothing to do
+        }
+
+        int32_t n = x2 - x1;
+        auto src_data = reinterpret_cast<const uint8_t*>(src_image->_m_pixel_data);
+        auto dst_data = reinterpret_cast<uint8_t*>(_m_pixel_data);
+
+        for (int32_t dy = y1; dy < y2; dy++) {
+            const uint8_t* src_row = src_data + static_cast<size_t>(dy - y) * src_image->_m_row_data_step + static_cast<size_t>(x1 - x) * src_image->_m_pixel_data_step;
+            uint8_t* dst_row = dst_data + static_cast<size_t>(dy) * _m_row_data_step + static_cast<size_t>(x1) * _m_pixel_data_step;
+
+            if (m_pixel_type == PixelType::Float) {
+                auto s = reinterpret_cast<const float*>(src_row);
+                auto d = reinterpret_cast<float*>(dst_row);
+                for (int32_t i = 0; i < n; i++) {
+                    float inv = 1.0f - s[3] * alpha;
+                    d[0] = s[0] * alpha + d[0] * inv;
+                    d[1] = s[1] * alpha + d[1] * inv;
+                    d[2] = s[2] * alpha + d[2] * inv;
+                    d[3] = s[3] * alpha + d[3] * inv;
+                    s += 4;
+                    d += 4;
+                }
+            }
+            else {
+                auto a = static_cast<uint32_t>(std::clamp<float>(alpha, 0.0f, 1.0f) * 255.0f + 0.5f);
+                const uint8_t* s = src_row;
+                uint8_t* d = dst_row;
+                for (int32_t i = 0; i < n; i++) {
+                    uint32_t sa = (s[3] * a + 127) / 255;
+                    uint32_t inv = 255 - sa;
+                    for (int32_t c = 0; c < 4; c++) {
+                        d[c] = static_cast<uint8_t>((s[c] * a + 127) / 255 + (d[c] * inv + 127) / 255);
+                    }
+                    s += 4;
+                    d += 4;
+                }
+            }
+        }
+
+        return ErrorCode::None;
+    }
+
+
     void Image::flipHorizontal() noexcept {
         if (isUsable()) {
             ImageAccess ia(this);
@@ -1672,12 +1768,6 @@ namespace Grain {
     }
 
 
-    ErrorCode Image::convolution(int32_t channel, const Dimensioni& kernel_size, const float* kernel_data, Image* out_image) noexcept {
-        // TODO: Implement
-        return ErrorCode::Unknown;
-    }
-
-
     /**
      *  @brief Function that returns true if the given pixel is valid.
      */
@@ -2429,76 +2519,7 @@ namespace Grain {
 
 
     ErrorCode Image::writeJpg(const String& file_path, float quality) {
-        auto result = ErrorCode::None;
-
-        if (m_color_model != Color::Model::RGB &&
-            m_color_model != Color::Model::RGBA &&
-            m_color_model != Color::Model::Lumina &&
-            m_color_model != Color::Model::LuminaAlpha) {
-            return ErrorCode::UnsupportedColorModel;
-        }
-
-        if (m_pixel_type != PixelType::UInt8 || m_color_model != Color::Model::RGB) {
-            // Pixel data must be converted to uint8_t RGB
-            Image* temp_image = copyWithNewSettings(Color::Model::RGB, Image::PixelType::UInt8);
-            if (!temp_image) {
-                return Error::specific(10);
-            }
-            result = temp_image->writeJpg(file_path, quality);
-            delete temp_image;
-            return result;
-        }
-
-        FILE* fp = nullptr;
-
-        try {
-            fp = fopen(file_path.utf8(), "wb");
-            if (!fp) {
-                Exception::throwStandard(ErrorCode::FileCantCreate);
-            }
-
-            jpeg_compress_struct cinfo;
-            jpeg_error_mgr jerr;
-
-            cinfo.err = jpeg_std_error(&jerr);
-            jpeg_create_compress(&cinfo);
-
-            jpeg_stdio_dest(&cinfo, fp);
-
-            cinfo.image_width = width();
-            cinfo.image_height = height();
-            cinfo.input_components = 3;
-            cinfo.in_color_space = JCS_RGB;
-
-            jpeg_set_defaults(&cinfo);
-            jpeg_set_quality(&cinfo, static_cast<int32_t>(quality * 100), TRUE);
-
-            jpeg_start_compress(&cinfo, TRUE);
-
-            while (cinfo.next_scanline < cinfo.image_height) {
-                JSAMPROW row_ptr = pixelDataPtrAtRow(cinfo.next_scanline);
-                if (!row_ptr) {
-                    Exception::throwStandard(ErrorCode::FileCantCreate);
-                }
-                jpeg_write_scanlines(&cinfo, &row_ptr, 1);
-            }
-
-            jpeg_finish_compress(&cinfo);
-            jpeg_destroy_compress(&cinfo);
-
-            auto err = File::closeFILE(fp);
-            Exception::throwStandard(err);
-        }
-        catch (const Exception& e) {
-            result = e.code();
-        }
-        catch (...) {
-            result = ErrorCode::Unknown;
-        }
-
-        // Clean up
-
-        return result;
+        return writeJpg(file_path, JpegSettings::preset(EncodePreset::Default, quality));
     }
 
 
@@ -2516,262 +2537,14 @@ namespace Grain {
      *  @return ErrorCode indicating success or failure.
      */
     ErrorCode Image::writePng(const String& file_path, int32_t compression_level, bool use_alpha) {
-        auto result = ErrorCode::None;
-
-        if (m_color_model != Color::Model::RGB &&
-            m_color_model != Color::Model::RGBA &&
-            m_color_model != Color::Model::Lumina &&
-            m_color_model != Color::Model::LuminaAlpha) {
-            return ErrorCode::UnsupportedColorModel;
-        }
-
-        if ((m_pixel_type != PixelType::UInt8 && m_pixel_type != PixelType::UInt16) ||
-            (m_color_model == Color::Model::LuminaAlpha && !use_alpha) ||
-            (m_color_model == Color::Model::RGBA && !use_alpha)) {
-
-            // Pixel data must be converted
-            Color::Model use_color_model = m_color_model;
-            if (m_color_model == Color::Model::LuminaAlpha && !use_alpha) {
-                use_color_model = Color::Model::Lumina;
-            }
-            else if (m_color_model == Color::Model::RGBA && !use_alpha) {
-                use_color_model = Color::Model::RGB;
-            }
-
-            if (use_color_model == m_color_model && m_fallback_pixel_type == m_pixel_type) {
-                // Nothing changed, this is unexpected behaviour!
-                return ErrorCode::UnexpectedBehaviour;
-            }
-
-            Image* temp_image = copyWithNewSettings(use_color_model, m_fallback_pixel_type);
-            if (!temp_image) { return Error::specific(10); }
-
-            result = temp_image->writePng(file_path, compression_level, use_alpha);
-            delete temp_image;
-
-            return result;
-        }
-
-
-        FILE* fp = nullptr;
-        png_structp png_ptr = nullptr;
-        png_infop info_ptr = nullptr;
-        png_bytep *row_pointers = nullptr;
-
-        try {
-            fp = fopen(file_path.utf8(), "wb");
-            if (!fp) {
-                Exception::throwStandard(ErrorCode::FileCantCreate);
-            }
-
-            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-            if (!png_ptr) {
-                Exception::throwSpecific(1);
-            }
-
-            png_set_compression_level(png_ptr, compression_level);
-
-            info_ptr = png_create_info_struct(png_ptr);
-            if (!info_ptr) {
-                Exception::throwSpecific(2);
-            }
-
-            if (setjmp(png_jmpbuf(png_ptr))) {
-                Exception::throwSpecific(3);
-            }
-
-            png_init_io(png_ptr, fp);
-
-            int color_type;
-            switch (m_color_model) {
-                case Color::Model::Lumina:
-                    color_type = PNG_COLOR_TYPE_GRAY;
-                    break;
-                case Color::Model::LuminaAlpha:
-                    color_type = PNG_COLOR_TYPE_GRAY_ALPHA;
-                    break;
-                case Color::Model::RGB:
-                    color_type = PNG_COLOR_TYPE_RGB;
-                    break;
-                case Color::Model::RGBA:
-                    color_type = PNG_COLOR_TYPE_RGBA;
-                    break;
-                default:
-                    throw Error::specific(99);
-            }
-
-            int bit_depth = bitsPerComponent();
-            int width_px = width();
-            int height_px = height();
-            // int32_t channels = componentCount();
-            // int32_t bytes_per_pixel = bytesPerPixel();
-            int bytes_per_row = bytesPerRow();
-
-            png_set_IHDR(
-                    png_ptr, info_ptr,
-                    width_px, height_px,
-                    bit_depth,
-                    color_type,
-                    PNG_INTERLACE_NONE,
-                    PNG_COMPRESSION_TYPE_DEFAULT,
-                    PNG_FILTER_TYPE_DEFAULT
-            );
-
-
-            png_write_info(png_ptr, info_ptr);
-
-
-#if BYTE_ORDER == LITTLE_ENDIAN
-            png_set_swap(png_ptr);
-#endif
-
-            row_pointers = (png_bytep*)malloc(sizeof(png_bytep) * height_px);
-            if (!row_pointers) {
-                Exception::throwSpecific(4);
-            }
-
-            for (int y = 0; y < height_px; y++) {
-                row_pointers[y] = pixelDataPtrAtRow(y);
-            }
-
-            png_write_image(png_ptr, row_pointers);
-            png_write_end(png_ptr, nullptr);
-
-            auto err = File::closeFILE(fp);
-            Exception::throwStandard(err);
-        }
-        catch (const Exception& e) {
-            result = e.code();
-        }
-        catch (...) {
-            result = ErrorCode::Unknown;
-        }
-
-        // Clean up
-        png_destroy_write_struct(&png_ptr, &info_ptr);
-        free(row_pointers);
-
-        return result;
+        auto settings = PngSettings::preset(EncodePreset::Default, use_alpha);
+        settings.compression_level_ = compression_level;
+        return writePng(file_path, settings);
     }
 
 
     ErrorCode Image::writeWebP(const String& file_path, float quality, bool use_alpha) {
-        auto result = ErrorCode::None;
-        size_t webp_size = 0;
-        uint8_t *webp_data = nullptr;
-        uint8_t *byte_data = nullptr;
-        bool lossless = quality > 0.99f;
-        bool has_alpha = false;
-        bool encode_with_alpha = false;
-
-        try {
-            int32_t stride = 0;
-            if (m_color_model == Color::Model::RGB) {
-                stride = 3;
-                byte_data = (uint8_t*)std::malloc(width_ * height_ * stride);
-            }
-            else if (m_color_model == Color::Model::RGBA) {
-                has_alpha = use_alpha;
-                stride = use_alpha ? 4 : 3;
-                encode_with_alpha = use_alpha;
-                byte_data = (uint8_t*)std::malloc(width_ * height_ * stride);
-            }
-            else if (m_color_model == Color::Model::Lumina) {
-                // Pixel data must be converted
-                Image* temp_image = copyWithNewSettings(Color::Model::RGB, PixelType::UInt8);
-                if (!temp_image) {
-                    return Error::specific(10);
-                }
-                result = temp_image->writeWebP(file_path, quality, use_alpha);
-                delete temp_image;
-                return result;
-            }
-            else if (m_color_model == Color::Model::LuminaAlpha) {
-                // Pixel data must be converted
-                Image* temp_image = copyWithNewSettings(Color::Model::RGBA, PixelType::UInt8);
-                if (!temp_image) {
-                    return Error::specific(10);
-                }
-                result = temp_image->writeWebP(file_path, quality, use_alpha);
-                delete temp_image;
-                return result;
-            }
-            else {
-                Exception::throwStandard(ErrorCode::UnsupportedColorModel);
-            }
-
-            if (!byte_data) {
-                Exception::throwSpecific(kErrNoBufferForConversion);
-            }
-
-            float pixel[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
-            ImageAccess ia(this, pixel);
-
-            if (has_alpha && encode_with_alpha) {
-                uint8_t* d = byte_data;
-                while (ia.stepY()) {
-                    while (ia.stepX()) {
-                        ia.read();
-                        *d++ = Type::floatToUInt8(pixel[0]);
-                        *d++ = Type::floatToUInt8(pixel[1]);
-                        *d++ = Type::floatToUInt8(pixel[2]);
-                        *d++ = Type::floatToUInt8(pixel[3]);
-                    }
-                }
-                if (lossless) {
-                    webp_size = WebPEncodeLosslessRGBA(byte_data, width_, height_, width_ * stride, &webp_data);
-                }
-                else {
-                    webp_size = WebPEncodeRGBA(byte_data, width_, height_, width_ * stride, quality * 100, &webp_data);
-                }
-            }
-            else {
-                uint8_t* d = byte_data;
-                while (ia.stepY()) {
-                    while (ia.stepX()) {
-                        ia.read();
-                        *d++ = Type::floatToUInt8(pixel[0]);
-                        *d++ = Type::floatToUInt8(pixel[1]);
-                        *d++ = Type::floatToUInt8(pixel[2]);
-                    }
-                }
-                if (lossless) {
-                    webp_size = WebPEncodeLosslessRGB(byte_data, width_, height_, width_ * stride, &webp_data);
-                }
-                else {
-                    webp_size = WebPEncodeRGB(byte_data, width_, height_, width_ * stride, quality * 100, &webp_data);
-                }
-            }
-
-
-            if (webp_size == 0) {
-                Exception::throwSpecific(kErrWebPEncodingFailed);
-            }
-
-            File::removeFile(file_path);
-            File file(file_path);
-            file.startWriteOverwrite();
-            file.write8BitData(webp_data, webp_size);
-            file.flush();
-            file.close();
-        }
-        catch (const Exception& e) {
-            result = e.code();
-        }
-        catch (...) {
-            result = ErrorCode::Unknown;
-        }
-
-        // Cleanup
-        if (byte_data) {
-            std::free(byte_data);
-        }
-
-        if (webp_data) {
-            WebPFree(webp_data);
-        }
-
-        return result;
+        return writeWebP(file_path, WebPSettings::preset(EncodePreset::Default, quality, use_alpha));
     }
 
 
@@ -4809,12 +4582,22 @@ namespace Grain {
 
 
     void Image::_malloc() {
-        _m_pixel_data = _m_mem_size > 0 ? (uint64_t*)std::malloc(_m_mem_size) : nullptr;
+        if (_m_buffer_pool) {
+            _m_pixel_data = _m_mem_size > 0 ? (uint64_t*)_m_buffer_pool->acquire(_m_mem_size) : nullptr;
+        }
+        else {
+            _m_pixel_data = _m_mem_size > 0 ? (uint64_t*)std::malloc(_m_mem_size) : nullptr;
+        }
     }
 
 
     void Image::_free() {
-        std::free(_m_pixel_data);
+        if (_m_buffer_pool) {
+            _m_buffer_pool->release(_m_pixel_data, _m_mem_size);
+        }
+        else {
+            std::free(_m_pixel_data);
+        }
         _m_pixel_data = nullptr;
         _m_mem_size = 0;
     }
@@ -0,0 +1,208 @@
+//
+//  ImageBufferPool.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Image/ImageBufferPool.hpp"
+
+#include <bit>
+#include <thread>
+
+
+namespace Grain {
+
+    ImageBufferPool::ImageBufferPool(int64_t max_cached_bytes) noexcept :
+        max_cached_bytes_(std::max<int64_t>(max_cached_bytes, 0)) {
+    }
+
+
+    ImageBufferPool::~ImageBufferPool() noexcept {
+        trim();
+    }
+
+
+    /**
+     *  @brief Get a buffer of at least `size` bytes, aligned to `kAlignment`.
+     *
+     *  @return The buffer or nullptr if no memory is available.
+     */
+    void* ImageBufferPool::acquire(size_t size) noexcept {
+        if (size == 0) {
+            return nullptr;
+        }
+
+        int32_t size_class = sizeClass(size);
+        if (size_class < 0) {
+            // Too large for pooling
+            size_t alloc_size = (size + kAlignment - 1) / kAlignment * kAlignment;
+            void* ptr = std::aligned_alloc(kAlignment, alloc_size);
+            if (ptr) {
+                acquire_count_++;
+                alloc_count_++;
+            }
+            return ptr;
+        }
+
+        auto bytes = static_cast<int64_t>(classSize(size_class));
+        void* ptr = nullptr;
+
+        // Own shard first, then the others
+        int32_t first_shard = _shardIndex();
+        for (int32_t i = 0; i < kShardCount && !ptr; i++) {
+            auto& shard = shards_[(first_shard + i) % kShardCount];
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            auto& free_list = shard.free_lists_[size_class];
+            if (!free_list.empty()) {
+                ptr = free_list.back();
+                free_list.pop_back();
+            }
+        }
+
+        if (ptr) {
+            reuse_count_++;
+            bytes_cached_ -= bytes;
+        }
+        else {
+            ptr = std::aligned_alloc(kAlignment, bytes);
+            if (!ptr) {
+                return nullptr;
+            }
+            alloc_count_++;
+        }
+
+        acquire_count_++;
+        _updatePeak(peak_bytes_in_use_, bytes_in_use_ += bytes);
+        _updatePeak(peak_bytes_allocated_, bytes_in_use_.load() + bytes_cached_.load());
+
+        return ptr;
+    }
+
+
+    /**
+     *  @brief Return a buffer from `acquire()`, `size` must be the size
+     *         which was requested.
+     */
+    void ImageBufferPool::release(void* ptr, size_t size) noexcept {
+        if (!ptr) {
+            return;
+        }
+
+        int32_t size_class = sizeClass(size);
+        if (size_class < 0) {
+            std::free(ptr);
+            free_count_++;
+            return;
+        }
+
+        auto bytes = static_cast<int64_t>(classSize(size_class));
+        bytes_in_use_ -= bytes;
+
+        if (bytes_cached_ + bytes > max_cached_bytes_) {
+            std::free(ptr);
+            free_count_++;
+            return;
+        }
+
+        bytes_cached_ += bytes;
+
+        auto& shard = shards_[_shardIndex()];
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        shard.free_lists_[size_class].push_back(ptr);
+    }
+
+
+    /**
+     *  @brief Return all cached buffers to the system.
+     */
+    void ImageBufferPool::trim() noexcept {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            for (int32_t size_class = 0; size_class < kClassCount; size_class++) {
+                auto& free_list = shard.free_lists_[size_class];
+                for (void* ptr : free_list) {
+                    std::free(ptr);
+                    free_count_++;
+                    bytes_cached_ -= static_cast<int64_t>(classSize(size_class));
+                }
+                free_list.clear();
+                free_list.shrink_to_fit();
+            }
+        }
+    }
+
+
+    ImageBufferPool::Stats ImageBufferPool::stats() const noexcept {
+        Stats stats;
+        stats.acquire_count_ = acquire_count_;
+        stats.reuse_count_ = reuse_count_;
+        stats.alloc_count_ = alloc_count_;
+        stats.free_count_ = free_count_;
+        stats.bytes_in_use_ = bytes_in_use_;
+        stats.bytes_cached_ = bytes_cached_;
+        stats.peak_bytes_in_use_ = peak_bytes_in_use_;
+        stats.peak_bytes_allocated_ = peak_bytes_allocated_;
+        return stats;
+    }
+
+
+    /**
+     *  @brief Set the peaks to the current values, e.g. to measure a steady state.
+     */
+    void ImageBufferPool::resetPeaks() noexcept {
+        peak_bytes_in_use_ = bytes_in_use_.load();
+        peak_bytes_allocated_ = bytes_in_use_.load() + bytes_cached_.load();
+    }
+
+
+    /**
+     *  @brief Size class for a buffer of `size` bytes.
+     *
+     *  Class 0 holds up to 4 KiB, the following classes split each power of
+     *  two in four steps.
+     *
+     *  @return The size class or -1 if the size is too large for pooling.
+     */
+    int32_t ImageBufferPool::sizeClass(size_t size) noexcept {
+        if (size <= (size_t(1) << kMinClassShift)) {
+            return 0;
+        }
+
+        size_t s = size - 1;
+        auto shift = static_cast<int32_t>(std::bit_width(s)) - 1;
+        if (shift >= kMaxClassShift) {
+            return -1;
+        }
+
+        auto step = static_cast<int32_t>((s >> (shift - 2)) & 3);
+        return (shift - kMinClassShift) * 4 + step + 1;
+    }
+
+
+    size_t ImageBufferPool::classSize(int32_t size_class) noexcept {
+        if (size_class <= 0) {
+            return size_t(1) << kMinClassShift;
+        }
+
+        int32_t shift = kMinClassShift + (size_class - 1) / 4;
+        int32_t step = (size_class - 1) % 4;
+        return (size_t(1) << shift) + static_cast<size_t>(step + 1) * (size_t(1) << (shift - 2));
+    }
+
+
+    int32_t ImageBufferPool::_shardIndex() noexcept {
+        return static_cast<int32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % kShardCount);
+    }
+
+
+    void ImageBufferPool::_updatePeak(std::atomic<int64_t>& peak, int64_t value) noexcept {
+        int64_t current = peak.load();
+        while (value > current && !peak.compare_exchange_weak(current, value)) {
+        }
+    }
+
+
+} // End of namespace Grain
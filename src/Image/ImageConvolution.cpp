@@ -0,0 +1,557 @@
+//
+//  ImageConvolution.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Image/Image.hpp"
+
+#include <atomic>
+#include <thread>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Convolution of one or all components with a kernel.
+     *
+     *  The kernel is applied as given, not mirrored, so for each pixel the
+     *  result is the sum of `kernel[j * kernel_width + i]` times the pixel at
+     *  offset (i - kernel_width / 2, j - kernel_height / 2). Pixels outside
+     *  the image repeat the border pixels.
+     *
+     *  Kernels of rank 1, like Gaussian or box kernels, are detected and
+     *  applied as a horizontal and a vertical pass. Rows are distributed over
+     *  threads, the inner loops run over contiguous float values and can be
+     *  vectorized by the compiler.
+     *
+     *  @param channel Index of the component to filter, -1 for all components.
+     *                 Other components of `out_image` are not changed.
+     *  @param kernel_size Width and height of the kernel.
+     *  @param kernel_data `kernel_size.width_ * kernel_size.height_` values, row by row.
+     *  @param out_image Image of the same size and format, may be this image.
+     *  @return `ErrorCode::None` on success.
+     */
+    ErrorCode Image::convolution(int32_t channel, const Dimensioni& kernel_size, const float* kernel_data, Image* out_image) noexcept {
+
+        if (!kernel_data) {
+            return ErrorCode::NullData;
+        }
+
+        int32_t kernel_width = kernel_size.width_;
+        int32_t kernel_height = kernel_size.height_;
+        if (kernel_width < 1 || kernel_height < 1) {
+            return ErrorCode::BadArgs;
+        }
+
+        std::vector<float> row_kernel;
+        std::vector<float> column_kernel;
+        bool separable = _separateKernel(kernel_data, kernel_width, kernel_height, row_kernel, column_kernel);
+
+        int32_t width = width_;
+        int32_t height = height_;
+        int32_t thread_count = _filterThreadCount(static_cast<int64_t>(width) * height * (separable ? kernel_width + kernel_height : kernel_width * kernel_height));
+
+        return _filterComponents(channel, out_image, [&](float* plane, float* buffer) {
+            if (separable) {
+                _convolveRows(plane, buffer, width, height, row_kernel.data(), kernel_width, thread_count);
+                _convolveColumns(buffer, plane, width, height, column_kernel.data(), kernel_height, thread_count);
+            }
+            else {
+                _convolve2d(plane, buffer, width, height, kernel_data, kernel_width, kernel_height, thread_count);
+                std::copy_n(buffer, static_cast<size_t>(width) * height, plane);
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Box blur of one or all components.
+     *
+     *  Each iteration averages a square of `2 * radius + 1` pixels. Running
+     *  sums make the cost per pixel independent of the radius. Three
+     *  iterations are close to a Gaussian blur.
+     *
+     *  @param channel Index of the component to filter, -1 for all components.
+     *  @param out_image Image of the same size and format, may be this image.
+     *  @return `ErrorCode::None` on success.
+     */
+    ErrorCode Image::boxBlur(int32_t channel, int32_t radius, int32_t iterations, Image* out_image) noexcept {
+
+        if (radius < 0 || iterations < 1) {
+            return ErrorCode::BadArgs;
+        }
+
+        int32_t width = width_;
+        int32_t height = height_;
+        int32_t thread_count = _filterThreadCount(static_cast<int64_t>(width) * height * iterations * 4);
+
+        return _filterComponents(channel, out_image, [&](float* plane, float* buffer) {
+            if (radius > 0) {
+                for (int32_t i = 0; i < iterations; i++) {
+                    _boxRows(plane, buffer, width, height, radius, thread_count);
+                    _boxColumns(buffer, plane, width, height, radius, thread_count);
+                }
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Gaussian blur of one or all components.
+     *
+     *  Small sigmas use a sampled Gaussian kernel of radius `3 * sigma`,
+     *  larger ones three box blurs with sizes chosen to match the variance
+     *  of the Gaussian, so the cost per pixel does not depend on sigma.
+     *
+     *  @param channel Index of the component to filter, -1 for all components.
+     *  @param sigma Standard deviation in pixels.
+     *  @param out_image Image of the same size and format, may be this image.
+     *  @return `ErrorCode::None` on success.
+     */
+    ErrorCode Image::gaussianBlur(int32_t channel, float sigma, Image* out_image) noexcept {
+
+        // Above this sigma three box blurs are faster than the kernel
+        constexpr float kBoxSigma = 3.0f;
+
+        if (sigma < 0.0f) {
+            return ErrorCode::BadArgs;
+        }
+
+        int32_t width = width_;
+        int32_t height = height_;
+
+        if (sigma < kBoxSigma) {
+            auto radius = static_cast<int32_t>(std::ceil(3.0f * sigma));
+            int32_t kernel_size = radius * 2 + 1;
+            std::vector<float> kernel(kernel_size, 1.0f);
+
+            if (radius > 0) {
+                double sum = 0.0;
+                for (int32_t i = 0; i < kernel_size; i++) {
+                    double d = i - radius;
+                    kernel[i] = static_cast<float>(std::exp(-d * d / (2.0 * sigma * sigma)));
+                    sum += kernel[i];
+                }
+                for (auto& k : kernel) {
+                    k = static_cast<float>(k / sum);
+                }
+            }
+
+            int32_t thread_count = _filterThreadCount(static_cast<int64_t>(width) * height * kernel_size * 2);
+
+            return _filterComponents(channel, out_image, [&](float* plane, float* buffer) {
+                if (radius > 0) {
+                    _convolveRows(plane, buffer, width, height, kernel.data(), kernel_size, thread_count);
+                    _convolveColumns(buffer, plane, width, height, kernel.data(), kernel_size, thread_count);
+                }
+            });
+        }
+
+        // Box sizes after W. Kovesi, "Fast Almost-Gaussian Filtering", 2010
+        constexpr int32_t kBoxCount = 3;
+        double variance12 = 12.0 * sigma * sigma;
+        auto lower_size = static_cast<int32_t>(std::floor(std::sqrt(variance12 / kBoxCount + 1.0)));
+        if (lower_size % 2 == 0) {
+            lower_size--;
+        }
+        auto lower_count = static_cast<int32_t>(std::round(
+            (variance12 - kBoxCount * lower_size * lower_size - 4.0 * kBoxCount * lower_size - 3.0 * kBoxCount) / (-4.0 * lower_size - 4.0)));
+
+        int32_t radii[kBoxCount];
+        for (int32_t i = 0; i < kBoxCount; i++) {
+            radii[i] = ((i < lower_count ? lower_size : lower_size + 2) - 1) / 2;
+        }
+
+        int32_t thread_count = _filterThreadCount(static_cast<int64_t>(width) * height * kBoxCount * 4);
+
+        return _filterComponents(channel, out_image, [&](float* plane, float* buffer) {
+            for (int32_t radius : radii) {
+                _boxRows(plane, buffer, width, height, radius, thread_count);
+                _boxColumns(buffer, plane, width, height, radius, thread_count);
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Apply `filter` to one or all components, each converted to a
+     *         float plane, and write the results to `out_image`.
+     *
+     *  Integer components keep their range, results are rounded and clamped.
+     */
+    ErrorCode Image::_filterComponents(int32_t channel, Image* out_image, const PlaneFilter& filter) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!out_image || !hasPixel() || !out_image->hasPixel()) {
+                throw ErrorCode::NullData;
+            }
+
+            if (!sameFormat(out_image)) {
+                throw ErrorCode::FormatMismatch;
+            }
+
+            if (!sameSize(out_image)) {
+                throw ErrorCode::UnsupportedDimension;
+            }
+
+            int32_t component_count = componentCount();
+            if (channel >= component_count) {
+                throw ErrorCode::InvalidChannel;
+            }
+
+            if (m_pixel_type != PixelType::UInt8 && m_pixel_type != PixelType::UInt16 &&
+                m_pixel_type != PixelType::UInt32 && m_pixel_type != PixelType::Float) {
+                throw ErrorCode::UnsupportedDataType;
+            }
+
+            int32_t width = width_;
+            int32_t height = height_;
+            auto plane_size = static_cast<size_t>(width) * height;
+            std::vector<float> plane(plane_size);
+            std::vector<float> buffer(plane_size);
+
+            int32_t thread_count = _filterThreadCount(static_cast<int64_t>(plane_size));
+            const uint8_t* src_data = pixelDataPtr();
+            uint32_t src_row_step = bytesPerRow();
+            uint8_t* dst_data = out_image->mutPixelDataPtr();
+            uint32_t dst_row_step = out_image->bytesPerRow();
+
+            auto extract = [&](auto type_tag, int32_t c) {
+                using T = decltype(type_tag);
+                _parallelFor(height, thread_count, [&](int32_t y0, int32_t y1) {
+                    for (int32_t y = y0; y < y1; y++) {
+                        auto src = reinterpret_cast<const T*>(src_data + static_cast<size_t>(y) * src_row_step) + c;
+                        float* dst = plane.data() + static_cast<size_t>(y) * width;
+                        for (int32_t x = 0; x < width; x++) {
+                            dst[x] = static_cast<float>(src[x * component_count]);
+                        }
+                    }
+                });
+            };
+
+            auto store = [&](auto type_tag, int32_t c) {
+                using T = decltype(type_tag);
+                _parallelFor(height, thread_count, [&](int32_t y0, int32_t y1) {
+                    for (int32_t y = y0; y < y1; y++) {
+                        const float* src = plane.data() + static_cast<size_t>(y) * width;
+                        auto dst = reinterpret_cast<T*>(dst_data + static_cast<size_t>(y) * dst_row_step) + c;
+                        if constexpr (std::is_floating_point_v<T>) {
+                            for (int32_t x = 0; x < width; x++) {
+                                dst[x * component_count] = src[x];
+                            }
+                        }
+                        else {
+                            constexpr double max = std::numeric_limits<T>::max();
+                            for (int32_t x = 0; x < width; x++) {
+                                dst[x * component_count] = static_cast<T>(std::clamp(src[x] + 0.5, 0.0, max));
+                            }
+                        }
+                    }
+                });
+            };
+
+            int32_t first = channel < 0 ? 0 : channel;
+            int32_t last = channel < 0 ? component_count - 1 : channel;
+
+            for (int32_t c = first; c <= last; c++) {
+                switch (m_pixel_type) {
+                    case PixelType::UInt8: extract(uint8_t{}, c); break;
+                    case PixelType::UInt16: extract(uint16_t{}, c); break;
+                    case PixelType::UInt32: extract(uint32_t{}, c); break;
+                    default: extract(float{}, c); break;
+                }
+
+                filter(plane.data(), buffer.data());
+
+                switch (m_pixel_type) {
+                    case PixelType::UInt8: store(uint8_t{}, c); break;
+                    case PixelType::UInt16: store(uint16_t{}, c); break;
+                    case PixelType::UInt32: store(uint32_t{}, c); break;
+                    default: store(float{}, c); break;
+                }
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::exception& e) {
+            result = ErrorCode::StdCppException;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Number of threads for filtering, one per hardware thread for
+     *         large images, fewer for small amounts of `work`.
+     */
+    int32_t Image::_filterThreadCount(int64_t work) noexcept {
+        constexpr int64_t kMinWorkPerThread = 1 << 18;
+        auto thread_count = static_cast<int64_t>(std::thread::hardware_concurrency());
+        return static_cast<int32_t>(std::clamp<int64_t>(work / kMinWorkPerThread, 1, std::max<int64_t>(thread_count, 1)));
+    }
+
+
+    /**
+     *  @brief Call `func` for ranges of [0, n) on up to `thread_count` threads.
+     *
+     *  Exceptions thrown by `func` on a worker thread are caught there, and
+     *  `ErrorCode::ComputationFailed` is thrown after all threads finished.
+     *  If a thread can't be started, the started ones are joined and the
+     *  exception is passed on.
+     */
+    void Image::_parallelFor(int32_t n, int32_t thread_count, const std::function<void(int32_t begin, int32_t end)>& func) {
+        thread_count = std::clamp(thread_count, 1, std::max(n, 1));
+        if (thread_count == 1) {
+            func(0, n);
+            return;
+        }
+
+        std::atomic<bool> failed{false};
+
+        auto run_range = [&](int32_t begin, int32_t end) {
+            try {
+                func(begin, end);
+            }
+            catch (...) {
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        try {
+            threads.reserve(thread_count);
+            for (int32_t i = 0; i < thread_count; i++) {
+                auto begin = static_cast<int32_t>(static_cast<int64_t>(n) * i / thread_count);
+                auto end = static_cast<int32_t>(static_cast<int64_t>(n) * (i + 1) / thread_count);
+                threads.emplace_back(run_range, begin, end);
+            }
+        }
+        catch (...) {
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            throw;
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (failed) {
+            throw ErrorCode::ComputationFailed;
+        }
+    }
+
+
+    /**
+     *  @brief Split a kernel of rank 1 into a row and a column kernel.
+     *
+     *  @return true, if the kernel equals the outer product of `out_column`
+     *          and `out_row` within float precision.
+     */
+    bool Image::_separateKernel(const float* kernel_data, int32_t kernel_width, int32_t kernel_height, std::vector<float>& out_row, std::vector<float>& out_column) noexcept {
+
+        // Largest element as pivot
+        int32_t pivot_x = 0;
+        int32_t pivot_y = 0;
+        float max_abs = 0.0f;
+        for (int32_t y = 0; y < kernel_height; y++) {
+            for (int32_t x = 0; x < kernel_width; x++) {
+                float a = std::fabs(kernel_data[y * kernel_width + x]);
+                if (a > max_abs) {
+                    max_abs = a;
+                    pivot_x = x;
+                    pivot_y = y;
+                }
+            }
+        }
+
+        if (max_abs == 0.0f) {
+            return false;
+        }
+
+        out_row.resize(kernel_width);
+        out_column.resize(kernel_height);
+
+        float pivot = kernel_data[pivot_y * kernel_width + pivot_x];
+        for (int32_t x = 0; x < kernel_width; x++) {
+            out_row[x] = kernel_data[pivot_y * kernel_width + x] / pivot;
+        }
+        for (int32_t y = 0; y < kernel_height; y++) {
+            out_column[y] = kernel_data[y * kernel_width + pivot_x];
+        }
+
+        float tolerance = max_abs * 1.0e-5f;
+        for (int32_t y = 0; y < kernel_height; y++) {
+            for (int32_t x = 0; x < kernel_width; x++) {
+                if (std::fabs(kernel_data[y * kernel_width + x] - out_column[y] * out_row[x]) > tolerance) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+
+    /**
+     *  @brief Horizontal pass with a 1D kernel centered at `kernel_size / 2`.
+     */
+    void Image::_convolveRows(const float* src, float* dst, int32_t width, int32_t height, const float* kernel, int32_t kernel_size, int32_t thread_count) {
+
+        int32_t center = kernel_size / 2;
+
+        _parallelFor(height, thread_count, [&](int32_t y0, int32_t y1) {
+            // Row with repeated border pixels, so the inner loop needs no bounds checks
+            std::vector<float> padded(static_cast<size_t>(width) + kernel_size - 1);
+
+            for (int32_t y = y0; y < y1; y++) {
+                const float* src_row = src + static_cast<size_t>(y) * width;
+                float* dst_row = dst + static_cast<size_t>(y) * width;
+
+                for (int32_t i = 0; i < static_cast<int32_t>(padded.size()); i++) {
+                    padded[i] = src_row[std::clamp(i - center, 0, width - 1)];
+                }
+
+                std::fill_n(dst_row, width, 0.0f);
+                for (int32_t k = 0; k < kernel_size; k++) {
+                    float weight = kernel[k];
+                    const float* p = padded.data() + k;
+                    for (int32_t x = 0; x < width; x++) {
+                        dst_row[x] += weight * p[x];
+                    }
+                }
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Vertical pass with a 1D kernel centered at `kernel_size / 2`.
+     */
+    void Image::_convolveColumns(const float* src, float* dst, int32_t width, int32_t height, const float* kernel, int32_t kernel_size, int32_t thread_count) {
+
+        int32_t center = kernel_size / 2;
+
+        _parallelFor(height, thread_count, [&](int32_t y0, int32_t y1) {
+            for (int32_t y = y0; y < y1; y++) {
+                float* dst_row = dst + static_cast<size_t>(y) * width;
+
+                std::fill_n(dst_row, width, 0.0f);
+                for (int32_t k = 0; k < kernel_size; k++) {
+                    float weight = kernel[k];
+                    const float* src_row = src + static_cast<size_t>(std::clamp(y + k - center, 0, height - 1)) * width;
+                    for (int32_t x = 0; x < width; x++) {
+                        dst_row[x] += weight * src_row[x];
+                    }
+                }
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Direct 2D convolution for kernels, which are not separable.
+     */
+    void Image::_convolve2d(const float* src, float* dst, int32_t width, int32_t height, const float* kernel, int32_t kernel_width, int32_t kernel_height, int32_t thread_count) {
+
+        int32_t center_x = kernel_width / 2;
+        int32_t center_y = kernel_height / 2;
+
+        _parallelFor(height, thread_count, [&](int32_t y0, int32_t y1) {
+            std::vector<float> padded(static_cast<size_t>(width) + kernel_width - 1);
+
+            for (int32_t y = y0; y < y1; y++) {
+                float* dst_row = dst + static_cast<size_t>(y) * width;
+                std::fill_n(dst_row, width, 0.0f);
+
+                for (int32_t j = 0; j < kernel_height; j++) {
+                    const float* src_row = src + static_cast<size_t>(std::clamp(y + j - center_y, 0, height - 1)) * width;
+                    for (int32_t i = 0; i < static_cast<int32_t>(padded.size()); i++) {
+                        padded[i] = src_row[std::clamp(i - center_x, 0, width - 1)];
+                    }
+
+                    for (int32_t i = 0; i < kernel_width; i++) {
+                        float weight = kernel[j * kernel_width + i];
+                        const float* p = padded.data() + i;
+                        for (int32_t x = 0; x < width; x++) {
+                            dst_row[x] += weight * p[x];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Horizontal box filter of `2 * radius + 1` pixels, with a
+     *         running sum per row.
+     */
+    void Image::_boxRows(const float* src, float* dst, int32_t width, int32_t height, int32_t radius, int32_t thread_count) {
+
+        double scale = 1.0 / (2 * radius + 1);
+
+        _parallelFor(height, thread_count, [&](int32_t y0, int32_t y1) {
+            for (int32_t y = y0; y < y1; y++) {
+                const float* src_row = src + static_cast<size_t>(y) * width;
+                float* dst_row = dst + static_cast<size_t>(y) * width;
+
+                double sum = 0.0;
+                for (int32_t i = -radius; i <= radius; i++) {
+                    sum += src_row[std::clamp(i, 0, width - 1)];
+                }
+
+                for (int32_t x = 0; x < width; x++) {
+                    dst_row[x] = static_cast<float>(sum * scale);
+                    sum += src_row[std::min(x + radius + 1, width - 1)] - src_row[std::max(x - radius, 0)];
+                }
+            }
+        });
+    }
+
+
+    /**
+     *  @brief Vertical box filter of `2 * radius + 1` pixels.
+     *
+     *  Columns are split into stripes, each thread keeps one running sum per
+     *  column of its stripe and updates them row by row, so the inner loops
+     *  run over contiguous memory.
+     */
+    void Image::_boxColumns(const float* src, float* dst, int32_t width, int32_t height, int32_t radius, int32_t thread_count) {
+
+        double scale = 1.0 / (2 * radius + 1);
+
+        _parallelFor(width, thread_count, [&](int32_t x0, int32_t x1) {
+            int32_t n = x1 - x0;
+            std::vector<double> sums(n, 0.0);
+
+            for (int32_t i = -radius; i <= radius; i++) {
+                const float* src_row = src + static_cast<size_t>(std::clamp(i, 0, height - 1)) * width + x0;
+                for (int32_t x = 0; x < n; x++) {
+                    sums[x] += src_row[x];
+                }
+            }
+
+            for (int32_t y = 0; y < height; y++) {
+                float* dst_row = dst + static_cast<size_t>(y) * width + x0;
+                const float* add_row = src + static_cast<size_t>(std::min(y + radius + 1, height - 1)) * width + x0;
+                const float* sub_row = src + static_cast<size_t>(std::max(y - radius, 0)) * width + x0;
+                for (int32_t x = 0; x < n; x++) {
+                    dst_row[x] = static_cast<float>(sums[x] * scale);
+                    sums[x] += add_row[x] - sub_row[x];
+                }
+            }
+        });
+    }
+
+
+} // End of namespace Grain
@@ -0,0 +1,507 @@
+//
+//  ImageEncode.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Image/Image.hpp"
+#include "File/File.hpp"
+
+#include <webp/encode.h>
+#include <png.h>
+#include <jpeglib.h>
+
+
+namespace Grain {
+
+    /**
+     *  @brief PNG settings for a preset.
+     *
+     *  `TileSpeed` restricts the row filters to Sub and Up, so libpng tries
+     *  fewer filters per row, and uses the run-length strategy of zlib.
+     *  Both suit the flat areas and straight edges of map tiles, on such
+     *  tiles it encodes faster than `Default`, at the cost of larger files.
+     */
+    Image::PngSettings Image::PngSettings::preset(EncodePreset preset, bool use_alpha) noexcept {
+        PngSettings settings;
+        settings.use_alpha_ = use_alpha;
+        switch (preset) {
+            case EncodePreset::TileSpeed:
+                settings.compression_strategy_ = 3;    // Z_RLE
+                settings.filters_ = kPngFilterSub | kPngFilterUp;
+                break;
+            case EncodePreset::Smallest:
+                settings.compression_level_ = 9;
+                break;
+            default:
+                break;
+        }
+        return settings;
+    }
+
+
+    Image::JpegSettings Image::JpegSettings::preset(EncodePreset preset, float quality) noexcept {
+        JpegSettings settings;
+        settings.quality_ = quality;
+        switch (preset) {
+            case EncodePreset::TileSpeed:
+                settings.fast_dct_ = true;
+                break;
+            case EncodePreset::Smallest:
+                settings.optimize_coding_ = true;
+                settings.progressive_ = true;
+                break;
+            default:
+                break;
+        }
+        return settings;
+    }
+
+
+    Image::WebPSettings Image::WebPSettings::preset(EncodePreset preset, float quality, bool use_alpha) noexcept {
+        WebPSettings settings;
+        settings.quality_ = quality;
+        settings.use_alpha_ = use_alpha;
+        switch (preset) {
+            case EncodePreset::TileSpeed:
+                settings.method_ = 1;
+                break;
+            case EncodePreset::Smallest:
+                settings.method_ = 6;
+                break;
+            default:
+                break;
+        }
+        return settings;
+    }
+
+
+    /**
+     *  @brief Check if the encoders can convert the rows of this image.
+     */
+    bool Image::_canEncodeRows() const noexcept {
+        return (m_color_model == Color::Model::Lumina || m_color_model == Color::Model::LuminaAlpha ||
+                m_color_model == Color::Model::RGB || m_color_model == Color::Model::RGBA) &&
+               (m_pixel_type == PixelType::UInt8 || m_pixel_type == PixelType::UInt16 ||
+                m_pixel_type == PixelType::UInt32 || m_pixel_type == PixelType::Float);
+    }
+
+
+    /**
+     *  @brief Convert row `y` for an encoder.
+     *
+     *  The output has 1 (gray), 2 (gray, alpha), 3 (RGB) or 4 (RGBA)
+     *  components of 8 or 16 bit in native byte order. Gray is expanded to
+     *  RGB, alpha is dropped or set to opaque as needed. RGB images can only
+     *  be converted to 3 or 4 components.
+     */
+    void Image::_encodeRow(int32_t y, int32_t out_component_count, bool out_16bit, uint8_t* out_row) const noexcept {
+
+        int32_t cn = componentCount();
+        bool src_gray = m_color_model == Color::Model::Lumina || m_color_model == Color::Model::LuminaAlpha;
+        int32_t src_alpha_index = hasAlpha() ? cn - 1 : -1;
+        bool out_gray = out_component_count <= 2;
+        bool out_alpha = out_component_count == 2 || out_component_count == 4;
+        const uint8_t* src_data = pixelDataPtr() + static_cast<size_t>(y) * bytesPerRow();
+        int32_t width = width_;
+
+        auto convert = [&](auto src_tag, auto dst_tag) {
+            using S = decltype(src_tag);
+            using D = decltype(dst_tag);
+
+            auto to = [](S v) -> D {
+                if constexpr (std::is_same_v<S, D>) {
+                    return v;
+                }
+                else if constexpr (std::is_floating_point_v<S>) {
+                    if constexpr (sizeof(D) == 1) {
+                        return Type::floatToUInt8(v);
+                    }
+                    else {
+                        return Type::floatToUInt16(v);
+                    }
+                }
+                else if constexpr (sizeof(S) > sizeof(D)) {
+                    return static_cast<D>(v >> (8 * (sizeof(S) - sizeof(D))));
+                }
+                else {
+                    // 8 to 16 bit, 0xFF becomes 0xFFFF
+                    return static_cast<D>(v * 257);
+                }
+            };
+
+            auto src = reinterpret_cast<const S*>(src_data);
+            auto dst = reinterpret_cast<D*>(out_row);
+            constexpr D opaque = std::numeric_limits<D>::max();
+
+            for (int32_t x = 0; x < width; x++) {
+                const S* p = src + x * cn;
+                D c0 = to(p[0]);
+                if (out_gray) {
+                    *dst++ = c0;
+                }
+                else if (src_gray) {
+                    *dst++ = c0;
+                    *dst++ = c0;
+                    *dst++ = c0;
+                }
+                else {
+                    *dst++ = c0;
+                    *dst++ = to(p[1]);
+                    *dst++ = to(p[2]);
+                }
+                if (out_alpha) {
+                    *dst++ = src_alpha_index >= 0 ? to(p[src_alpha_index]) : opaque;
+                }
+            }
+        };
+
+        auto convert_to = [&](auto src_tag) {
+            if (out_16bit) {
+                convert(src_tag, uint16_t{});
+            }
+            else {
+                convert(src_tag, uint8_t{});
+            }
+        };
+
+        switch (m_pixel_type) {
+            case PixelType::UInt8: convert_to(uint8_t{}); break;
+            case PixelType::UInt16: convert_to(uint16_t{}); break;
+            case PixelType::UInt32: convert_to(uint32_t{}); break;
+            case PixelType::Float: convert_to(float{}); break;
+            default: break;
+        }
+    }
+
+
+    /**
+     *  @brief Write the image to a PNG file.
+     *
+     *  Rows are converted one by one and passed to libpng, no copy of the
+     *  image is made. 8 and 16 bit images with the requested components are
+     *  passed without conversion. 32 bit and float images are written with
+     *  the bit depth of the fallback pixel type.
+     */
+    ErrorCode Image::writePng(const String& file_path, const PngSettings& settings) noexcept {
+
+        // Size of the IDAT chunks, larger chunks reduce the overhead for tiles
+        constexpr size_t kCompressionBufferSize = 1 << 16;
+
+        auto result = ErrorCode::None;
+        FILE* fp = nullptr;
+        png_structp png_ptr = nullptr;
+        png_infop info_ptr = nullptr;
+
+        try {
+            if (!hasPixel()) {
+                throw ErrorCode::NullData;
+            }
+
+            if (!_canEncodeRows()) {
+                throw ErrorCode::UnsupportedColorModel;
+            }
+
+            bool gray = m_color_model == Color::Model::Lumina || m_color_model == Color::Model::LuminaAlpha;
+            bool use_alpha = hasAlpha() && settings.use_alpha_;
+            int32_t out_component_count = (gray ? 1 : 3) + (use_alpha ? 1 : 0);
+            bool out_16bit = m_pixel_type == PixelType::UInt16 ||
+                             (m_pixel_type != PixelType::UInt8 && m_fallback_pixel_type == PixelType::UInt16);
+            bool direct = out_component_count == componentCount() &&
+                          ((m_pixel_type == PixelType::UInt8 && !out_16bit) || (m_pixel_type == PixelType::UInt16 && out_16bit));
+
+            int color_type;
+            if (gray) {
+                color_type = use_alpha ? PNG_COLOR_TYPE_GRAY_ALPHA : PNG_COLOR_TYPE_GRAY;
+            }
+            else {
+                color_type = use_alpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB;
+            }
+
+            std::vector<uint8_t> row(direct ? 0 : static_cast<size_t>(width_) * out_component_count * (out_16bit ? 2 : 1));
+
+            fp = fopen(file_path.utf8(), "wb");
+            if (!fp) {
+                throw ErrorCode::FileCantCreate;
+            }
+
+            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+            if (!png_ptr) {
+                throw ErrorCode::MemCantAllocate;
+            }
+
+            info_ptr = png_create_info_struct(png_ptr);
+            if (!info_ptr) {
+                throw ErrorCode::MemCantAllocate;
+            }
+
+            if (setjmp(png_jmpbuf(png_ptr))) {
+                throw ErrorCode::FileCantWrite;
+            }
+
+            png_init_io(png_ptr, fp);
+
+            int filters = settings.filters_ & kPngFilterAll;
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filters != 0 ? filters : PNG_FILTER_NONE);
+            png_set_compression_level(png_ptr, std::clamp(settings.compression_level_, 0, 9));
+            png_set_compression_strategy(png_ptr, std::clamp(settings.compression_strategy_, 0, 4));
+            png_set_compression_buffer_size(png_ptr, kCompressionBufferSize);
+
+            png_set_IHDR(
+                    png_ptr, info_ptr,
+                    width_, height_,
+                    out_16bit ? 16 : 8,
+                    color_type,
+                    PNG_INTERLACE_NONE,
+                    PNG_COMPRESSION_TYPE_DEFAULT,
+                    PNG_FILTER_TYPE_DEFAULT
+            );
+
+            png_write_info(png_ptr, info_ptr);
+
+#if BYTE_ORDER == LITTLE_ENDIAN
+            if (out_16bit) {
+                png_set_swap(png_ptr);
+            }
+#endif
+
+            for (int32_t y = 0; y < height_; y++) {
+                png_bytep row_ptr;
+                if (direct) {
+                    row_ptr = pixelDataPtrAtRow(y);
+                }
+                else {
+                    _encodeRow(y, out_component_count, out_16bit, row.data());
+                    row_ptr = row.data();
+                }
+                png_write_row(png_ptr, row_ptr);
+            }
+
+            png_write_end(png_ptr, nullptr);
+
+            auto err = File::closeFILE(fp);
+            fp = nullptr;
+            Exception::throwStandard(err);
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
+        catch (...) {
+            result = ErrorCode::Unknown;
+        }
+
+        // Clean up
+        png_destroy_write_struct(&png_ptr, &info_ptr);
+        if (fp) {
+            fclose(fp);
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Write the image to a JPEG file.
+     *
+     *  Rows are converted one by one and passed to libjpeg. Gray images are
+     *  written as grayscale JPEG, alpha is dropped.
+     */
+    ErrorCode Image::writeJpg(const String& file_path, const JpegSettings& settings) noexcept {
+
+        auto result = ErrorCode::None;
+        FILE* fp = nullptr;
+        jpeg_compress_struct cinfo {};
+        jpeg_error_mgr jerr {};
+        bool compress_created = false;
+
+        try {
+            if (!hasPixel()) {
+                throw ErrorCode::NullData;
+            }
+
+            if (!_canEncodeRows()) {
+                throw ErrorCode::UnsupportedColorModel;
+            }
+
+            bool gray = m_color_model == Color::Model::Lumina || m_color_model == Color::Model::LuminaAlpha;
+            int32_t out_component_count = gray ? 1 : 3;
+            bool direct = m_pixel_type == PixelType::UInt8 && componentCount() == out_component_count;
+            std::vector<uint8_t> row(direct ? 0 : static_cast<size_t>(width_) * out_component_count);
+
+            fp = fopen(file_path.utf8(), "wb");
+            if (!fp) {
+                throw ErrorCode::FileCantCreate;
+            }
+
+            cinfo.err = jpeg_std_error(&jerr);
+            jpeg_create_compress(&cinfo);
+            compress_created = true;
+
+            jpeg_stdio_dest(&cinfo, fp);
+
+            cinfo.image_width = width_;
+            cinfo.image_height = height_;
+            cinfo.input_components = out_component_count;
+            cinfo.in_color_space = gray ? JCS_GRAYSCALE : JCS_RGB;
+
+            jpeg_set_defaults(&cinfo);
+            jpeg_set_quality(&cinfo, std::clamp(static_cast<int32_t>(settings.quality_ * 100), 1, 100), TRUE);
+            if (settings.fast_dct_) {
+                cinfo.dct_method = JDCT_IFAST;
+            }
+            if (settings.optimize_coding_) {
+                cinfo.optimize_coding = TRUE;
+            }
+            if (settings.progressive_) {
+                jpeg_simple_progression(&cinfo);
+            }
+
+            jpeg_start_compress(&cinfo, TRUE);
+
+            while (cinfo.next_scanline < cinfo.image_height) {
+                auto y = static_cast<int32_t>(cinfo.next_scanline);
+                JSAMPROW row_ptr;
+                if (direct) {
+                    row_ptr = pixelDataPtrAtRow(y);
+                }
+                else {
+                    _encodeRow(y, out_component_count, false, row.data());
+                    row_ptr = row.data();
+                }
+                jpeg_write_scanlines(&cinfo, &row_ptr, 1);
+            }
+
+            jpeg_finish_compress(&cinfo);
+
+            auto err = File::closeFILE(fp);
+            fp = nullptr;
+            Exception::throwStandard(err);
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
+        catch (...) {
+            result = ErrorCode::Unknown;
+        }
+
+        // Clean up
+        if (compress_created) {
+            jpeg_destroy_compress(&cinfo);
+        }
+        if (fp) {
+            fclose(fp);
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Write the image to a WebP file.
+     *
+     *  libwebp encodes complete pictures only, so rows are converted
+     *  directly into the ARGB buffer of the picture, and the encoded data is
+     *  written to the file while encoding, without further copies.
+     */
+    ErrorCode Image::writeWebP(const String& file_path, const WebPSettings& settings) noexcept {
+
+        auto result = ErrorCode::None;
+        FILE* fp = nullptr;
+        WebPPicture picture;
+        bool picture_allocated = false;
+
+        try {
+            if (!hasPixel()) {
+                throw ErrorCode::NullData;
+            }
+
+            if (!_canEncodeRows()) {
+                throw ErrorCode::UnsupportedColorModel;
+            }
+
+            WebPConfig config;
+            if (!WebPConfigInit(&config) || !WebPPictureInit(&picture)) {
+                Exception::throwSpecific(kErrWebPEncodingFailed);
+            }
+
+            bool lossless = settings.quality_ > 0.99f;
+            int32_t method = std::clamp(settings.method_, 0, 6);
+            config.lossless = lossless ? 1 : 0;
+            config.method = method;
+            // For lossless encoding the quality controls the effort
+            config.quality = lossless ? static_cast<float>(method) * 100.0f / 6.0f : std::clamp(settings.quality_, 0.0f, 1.0f) * 100.0f;
+            if (!WebPValidateConfig(&config)) {
+                Exception::throwSpecific(kErrWebPEncodingFailed);
+            }
+
+            picture.use_argb = 1;
+            picture.width = width_;
+            picture.height = height_;
+            if (!WebPPictureAlloc(&picture)) {
+                throw ErrorCode::MemCantAllocate;
+            }
+            picture_allocated = true;
+
+            bool use_alpha = hasAlpha() && settings.use_alpha_;
+            std::vector<uint8_t> row(static_cast<size_t>(width_) * 4);
+
+            for (int32_t y = 0; y < height_; y++) {
+                _encodeRow(y, 4, false, row.data());
+                uint32_t* argb = picture.argb + static_cast<size_t>(y) * picture.argb_stride;
+                const uint8_t* s = row.data();
+                for (int32_t x = 0; x < width_; x++, s += 4) {
+                    uint32_t alpha = use_alpha ? s[3] : 0xFF;
+                    argb[x] = (alpha << 24) | (static_cast<uint32_t>(s[0]) << 16) | (static_cast<uint32_t>(s[1]) << 8) | s[2];
+                }
+            }
+
+            fp = fopen(file_path.utf8(), "wb");
+            if (!fp) {
+                throw ErrorCode::FileCantCreate;
+            }
+
+            picture.custom_ptr = fp;
+            picture.writer = [](const uint8_t* data, size_t data_size, const WebPPicture* picture) -> int {
+                return std::fwrite(data, 1, data_size, static_cast<FILE*>(picture->custom_ptr)) == data_size ? 1 : 0;
+            };
+
+            if (!WebPEncode(&config, &picture)) {
+                Exception::throwSpecific(kErrWebPEncodingFailed);
+            }
+
+            auto err = File::closeFILE(fp);
+            fp = nullptr;
+            Exception::throwStandard(err);
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
+        catch (...) {
+            result = ErrorCode::Unknown;
+        }
+
+        // Clean up
+        if (picture_allocated) {
+            WebPPictureFree(&picture);
+        }
+        if (fp) {
+            fclose(fp);
+        }
+
+        return result;
+    }
+
+
+} // End of namespace Grain
@@ -0,0 +1,361 @@
+//
+//  ImageResample.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Image/Image.hpp"
+#include "Color/Color.hpp"
+
+#include <numbers>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Resample the image to the size of `out_image`.
+     *
+     *  Works for any ratio, up and down, in a horizontal and a vertical pass
+     *  with weights precomputed per output column and row. For downscaling
+     *  the filter is widened by the ratio, so all source pixels contribute.
+     *  Colors of images with alpha are premultiplied while filtering, so
+     *  transparent pixels do not bleed into their neighbours. Rows are
+     *  distributed over threads.
+     *
+     *  @param out_image Image of the same format and any size, not this image.
+     *  @param filter Filter kernel.
+     *  @param linear_light Filter sRGB encoded colors in linear light, only
+     *                      for Lumina and RGB images with or without alpha.
+     *  @return `ErrorCode::None` on success.
+     */
+    ErrorCode Image::resample(Image* out_image, ResampleFilter filter, bool linear_light) noexcept {
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (!out_image || !hasPixel() || !out_image->hasPixel()) {
+                throw ErrorCode::NullData;
+            }
+
+            if (out_image == this) {
+                throw ErrorCode::MemPointsToItself;
+            }
+
+            if (!sameFormat(out_image)) {
+                throw ErrorCode::FormatMismatch;
+            }
+
+            if (linear_light &&
+                m_color_model != Color::Model::Lumina && m_color_model != Color::Model::LuminaAlpha &&
+                m_color_model != Color::Model::RGB && m_color_model != Color::Model::RGBA) {
+                throw ErrorCode::UnsupportedColorModel;
+            }
+
+            if (m_pixel_type != PixelType::UInt8 && m_pixel_type != PixelType::UInt16 &&
+                m_pixel_type != PixelType::UInt32 && m_pixel_type != PixelType::Float) {
+                throw ErrorCode::UnsupportedDataType;
+            }
+
+            int32_t src_width = width_;
+            int32_t src_height = height_;
+            int32_t dst_width = out_image->width_;
+            int32_t dst_height = out_image->height_;
+            int32_t cn = componentCount();
+            int32_t alpha_index = hasAlpha() ? cn - 1 : -1;
+            int32_t color_count = hasAlpha() ? cn - 1 : cn;
+
+            ResampleWeights x_weights;
+            ResampleWeights y_weights;
+            _resampleWeights(src_width, dst_width, filter, x_weights);
+            _resampleWeights(src_height, dst_height, filter, y_weights);
+
+            // Integer components are normalized to 0 ... 1
+            double max_value = 1.0;
+            switch (m_pixel_type) {
+                case PixelType::UInt8: max_value = std::numeric_limits<uint8_t>::max(); break;
+                case PixelType::UInt16: max_value = std::numeric_limits<uint16_t>::max(); break;
+                case PixelType::UInt32: max_value = std::numeric_limits<uint32_t>::max(); break;
+                default: break;
+            }
+            auto scale = static_cast<float>(1.0 / max_value);
+
+            // Lookup table from 8 or 16 bit values to linear light
+            std::vector<float> to_linear;
+            if (linear_light && (m_pixel_type == PixelType::UInt8 || m_pixel_type == PixelType::UInt16)) {
+                to_linear.resize(static_cast<size_t>(max_value) + 1);
+                for (size_t i = 0; i < to_linear.size(); i++) {
+                    to_linear[i] = Color::gamma_to_linear(static_cast<float>(i) * scale);
+                }
+            }
+
+            const uint8_t* src_data = pixelDataPtr();
+            uint32_t src_row_step = bytesPerRow();
+            uint8_t* dst_data = out_image->mutPixelDataPtr();
+            uint32_t dst_row_step = out_image->bytesPerRow();
+
+            auto src_line_size = static_cast<size_t>(src_width) * cn;
+            auto dst_line_size = static_cast<size_t>(dst_width) * cn;
+
+            // Horizontally resampled rows, premultiplied, in linear light if requested
+            std::vector<float> rows(dst_line_size * src_height);
+
+            auto load_row = [&](auto type_tag, int32_t y, float* out_values) {
+                using T = decltype(type_tag);
+                auto src = reinterpret_cast<const T*>(src_data + static_cast<size_t>(y) * src_row_step);
+                if (!to_linear.empty()) {
+                    for (size_t i = 0; i < src_line_size; i++) {
+                        out_values[i] = to_linear[static_cast<size_t>(src[i])];
+                    }
+                }
+                else {
+                    for (size_t i = 0; i < src_line_size; i++) {
+                        out_values[i] = static_cast<float>(src[i]) * scale;
+                    }
+                    if (linear_light) {
+                        for (int32_t x = 0; x < src_width; x++) {
+                            for (int32_t c = 0; c < color_count; c++) {
+                                float& v = out_values[x * cn + c];
+                                v = Color::gamma_to_linear(v);
+                            }
+                        }
+                    }
+                }
+                if (alpha_index >= 0) {
+                    if (!to_linear.empty()) {
+                        // Alpha is never linearized
+                        for (int32_t x = 0; x < src_width; x++) {
+                            out_values[x * cn + alpha_index] = static_cast<float>(src[x * cn + alpha_index]) * scale;
+                        }
+                    }
+                    for (int32_t x = 0; x < src_width; x++) {
+                        float alpha = out_values[x * cn + alpha_index];
+                        for (int32_t c = 0; c < color_count; c++) {
+                            out_values[x * cn + c] *= alpha;
+                        }
+                    }
+                }
+            };
+
+            auto store_row = [&](auto type_tag, int32_t y, float* values) {
+                using T = decltype(type_tag);
+                if (alpha_index >= 0) {
+                    for (int32_t x = 0; x < dst_width; x++) {
+                        float alpha = values[x * cn + alpha_index];
+                        float f = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+                        for (int32_t c = 0; c < color_count; c++) {
+                            values[x * cn + c] *= f;
+                        }
+                    }
+                }
+                if (linear_light) {
+                    for (int32_t x = 0; x < dst_width; x++) {
+                        for (int32_t c = 0; c < color_count; c++) {
+                            float& v = values[x * cn + c];
+                            v = Color::linear_to_gamma(std::max(v, 0.0f));
+                        }
+                    }
+                }
+                auto dst = reinterpret_cast<T*>(dst_data + static_cast<size_t>(y) * dst_row_step);
+                if constexpr (std::is_floating_point_v<T>) {
+                    std::copy_n(values, dst_line_size, dst);
+                }
+                else {
+                    // Ringing of the cubic and sinc filters leaves the value range
+                    for (size_t i = 0; i < dst_line_size; i++) {
+                        dst[i] = static_cast<T>(std::clamp(values[i] * max_value + 0.5, 0.0, max_value));
+                    }
+                }
+            };
+
+            int64_t work = static_cast<int64_t>(dst_width) * (src_height * x_weights.tap_count_ + dst_height * y_weights.tap_count_) * cn;
+            int32_t thread_count = _filterThreadCount(work);
+
+            // Horizontal pass
+            _parallelFor(src_height, thread_count, [&](int32_t y0, int32_t y1) {
+                std::vector<float> line(src_line_size);
+                int32_t tap_count = x_weights.tap_count_;
+
+                for (int32_t y = y0; y < y1; y++) {
+                    switch (m_pixel_type) {
+                        case PixelType::UInt8: load_row(uint8_t{}, y, line.data()); break;
+                        case PixelType::UInt16: load_row(uint16_t{}, y, line.data()); break;
+                        case PixelType::UInt32: load_row(uint32_t{}, y, line.data()); break;
+                        default: load_row(float{}, y, line.data()); break;
+                    }
+
+                    float* out_row = rows.data() + static_cast<size_t>(y) * dst_line_size;
+                    for (int32_t x = 0; x < dst_width; x++) {
+                        const float* w = x_weights.weights_.data() + static_cast<size_t>(x) * tap_count;
+                        const float* p = line.data() + static_cast<size_t>(x_weights.first_[x]) * cn;
+                        float* out = out_row + static_cast<size_t>(x) * cn;
+                        for (int32_t c = 0; c < cn; c++) {
+                            float sum = 0.0f;
+                            for (int32_t k = 0; k < tap_count; k++) {
+                                sum += w[k] * p[k * cn + c];
+                            }
+                            out[c] = sum;
+                        }
+                    }
+                }
+            });
+
+            // Vertical pass, contiguous rows of the same length
+            _parallelFor(dst_height, thread_count, [&](int32_t y0, int32_t y1) {
+                std::vector<float> line(dst_line_size);
+                int32_t tap_count = y_weights.tap_count_;
+
+                for (int32_t y = y0; y < y1; y++) {
+                    std::fill(line.begin(), line.end(), 0.0f);
+                    const float* w = y_weights.weights_.data() + static_cast<size_t>(y) * tap_count;
+                    for (int32_t k = 0; k < tap_count; k++) {
+                        float weight = w[k];
+                        if (weight != 0.0f) {
+                            const float* src_row = rows.data() + static_cast<size_t>(y_weights.first_[y] + k) * dst_line_size;
+                            for (size_t i = 0; i < dst_line_size; i++) {
+                                line[i] += weight * src_row[i];
+                            }
+                        }
+                    }
+
+                    switch (m_pixel_type) {
+                        case PixelType::UInt8: store_row(uint8_t{}, y, line.data()); break;
+                        case PixelType::UInt16: store_row(uint16_t{}, y, line.data()); break;
+                        case PixelType::UInt32: store_row(uint32_t{}, y, line.data()); break;
+                        default: store_row(float{}, y, line.data()); break;
+                    }
+                }
+            });
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::exception& e) {
+            result = ErrorCode::StdCppException;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Compute the weights for resampling `src_size` to `dst_size`
+     *         pixels along one axis.
+     */
+    void Image::_resampleWeights(int32_t src_size, int32_t dst_size, ResampleFilter filter, ResampleWeights& out_weights) {
+
+        double ratio = static_cast<double>(src_size) / dst_size;
+        double filter_scale = std::max(ratio, 1.0);
+        double support = _resampleFilterRadius(filter) * filter_scale;
+
+        int32_t tap_count = std::min(static_cast<int32_t>(std::ceil(support * 2.0)) + 2, src_size);
+        out_weights.tap_count_ = tap_count;
+        out_weights.first_.assign(dst_size, 0);
+        out_weights.weights_.assign(static_cast<size_t>(dst_size) * tap_count, 0.0f);
+
+        std::vector<double> weights;
+
+        for (int32_t i = 0; i < dst_size; i++) {
+            double center = (i + 0.5) * ratio;     // Continuous source position, pixel j covers [j, j + 1)
+            auto j0 = static_cast<int32_t>(std::floor(center - support));
+            auto j1 = static_cast<int32_t>(std::ceil(center + support));
+
+            // Taps outside of the source are folded into the border pixels
+            int32_t first = std::clamp(j0, 0, src_size - tap_count);
+            weights.assign(tap_count, 0.0);
+
+            double sum = 0.0;
+            for (int32_t j = j0; j <= j1; j++) {
+                double w;
+                if (filter == ResampleFilter::Area) {
+                    double half = filter_scale * 0.5;
+                    w = std::max(0.0, std::min<double>(j + 1, center + half) - std::max<double>(j, center - half));
+                }
+                else {
+                    w = _resampleFilterValue(filter, (j + 0.5 - center) / filter_scale);
+                }
+                if (w != 0.0) {
+                    int32_t index = std::clamp(j, 0, src_size - 1) - first;
+                    index = std::clamp(index, 0, tap_count - 1);
+                    weights[index] += w;
+                    sum += w;
+                }
+            }
+
+            out_weights.first_[i] = first;
+            float* out = out_weights.weights_.data() + static_cast<size_t>(i) * tap_count;
+            if (sum != 0.0) {
+                for (int32_t k = 0; k < tap_count; k++) {
+                    out[k] = static_cast<float>(weights[k] / sum);
+                }
+            }
+            else {
+                out[std::clamp(static_cast<int32_t>(center) - first, 0, tap_count - 1)] = 1.0f;
+            }
+        }
+    }
+
+
+    double Image::_resampleFilterRadius(ResampleFilter filter) noexcept {
+        switch (filter) {
+            case ResampleFilter::Area: return 0.5;
+            case ResampleFilter::Bilinear: return 1.0;
+            case ResampleFilter::CatmullRom:
+            case ResampleFilter::Mitchell: return 2.0;
+            case ResampleFilter::Lanczos3: return 3.0;
+        }
+        return 1.0;
+    }
+
+
+    /**
+     *  @brief Value of the filter kernel at distance `x` from its center.
+     *
+     *  Cubic filters after Mitchell and Netravali, "Reconstruction Filters
+     *  in Computer Graphics", 1988.
+     */
+    double Image::_resampleFilterValue(ResampleFilter filter, double x) noexcept {
+        x = std::fabs(x);
+
+        switch (filter) {
+            case ResampleFilter::Area:
+                return x < 0.5 ? 1.0 : 0.0;
+
+            case ResampleFilter::Bilinear:
+                return x < 1.0 ? 1.0 - x : 0.0;
+
+            case ResampleFilter::CatmullRom:
+            case ResampleFilter::Mitchell: {
+                double b = filter == ResampleFilter::Mitchell ? 1.0 / 3.0 : 0.0;
+                double c = filter == ResampleFilter::Mitchell ? 1.0 / 3.0 : 0.5;
+                double x2 = x * x;
+                double x3 = x2 * x;
+                if (x < 1.0) {
+                    return ((12.0 - 9.0 * b - 6.0 * c) * x3 + (-18.0 + 12.0 * b + 6.0 * c) * x2 + (6.0 - 2.0 * b)) / 6.0;
+                }
+                if (x < 2.0) {
+                    return ((-b - 6.0 * c) * x3 + (6.0 * b + 30.0 * c) * x2 + (-12.0 * b - 48.0 * c) * x + (8.0 * b + 24.0 * c)) / 6.0;
+                }
+                return 0.0;
+            }
+
+            case ResampleFilter::Lanczos3: {
+                constexpr double kRadius = 3.0;
+                if (x < 1.0e-8) {
+                    return 1.0;
+                }
+                if (x >= kRadius) {
+                    return 0.0;
+                }
+                double px = std::numbers::pi * x;
+                return kRadius * std::sin(px) * std::sin(px / kRadius) / (px * px);
+            }
+        }
+
+        return 0.0;
+    }
+
+
+} // End of namespace Grain
@@ -9,9 +9,284 @@
 
 #include "Math/Random.hpp"
 
+#include <atomic>
+
 
 namespace Grain {
 
+    namespace {
+
+        uint64_t _splitMix64(uint64_t& x) noexcept {
+            uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        void _xoshiroStep(uint64_t* s) noexcept {
+            uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = (s[3] << 45) | (s[3] >> 19);
+        }
+
+        // Polynomials for 2^128 and 2^192 steps
+        constexpr uint64_t kJump[4] = {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+        };
+        constexpr uint64_t kLongJump[4] = {
+            0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+        };
+
+        constexpr int32_t kFillChunkSize = 256;
+    }
+
+
+    /**
+     *  @brief Restart the sequence.
+     *
+     *  @param seed Seed value, every value gives a different sequence.
+     *  @param stream Index of an independent stream. Selecting a stream
+     *                costs a jump per index, keep the indices small, e.g.
+     *                one per thread.
+     */
+    void RandomEngine::seed(uint64_t seed, uint64_t stream) noexcept {
+        seed_ = seed;
+        stream_ = stream;
+
+        uint64_t x = seed;
+        uint64_t state[4];
+        for (auto& word : state) {
+            word = _splitMix64(x);
+        }
+
+        for (uint64_t i = 0; i < stream; i++) {
+            _jump(state, kLongJump);
+        }
+
+        for (int32_t k = 0; k < kLaneCount; k++) {
+            for (int32_t w = 0; w < 4; w++) {
+                s_[w][k] = state[w];
+            }
+            _jump(state, kJump);
+        }
+
+        buffer_pos_ = kLaneCount;
+        has_spare_normal_ = false;
+    }
+
+
+    /**
+     *  @brief Returns a normally distributed random number, mean 0, standard
+     *         deviation 1.
+     *
+     *  Uses the Box-Muller transform, which yields two values per pair of
+     *  uniform values, the second one is kept for the next call.
+     */
+    float RandomEngine::nextNormal() noexcept {
+        if (has_spare_normal_) {
+            has_spare_normal_ = false;
+            return spare_normal_;
+        }
+
+        float r = std::sqrt(-2.0f * std::log(1.0f - nextFloat()));
+        float theta = 2.0f * std::numbers::pi_v<float> * nextFloat();
+        spare_normal_ = r * std::sin(theta);
+        has_spare_normal_ = true;
+        return r * std::cos(theta);
+    }
+
+
+    /**
+     *  @brief Returns an exponentially distributed random number with rate 1.
+     */
+    float RandomEngine::nextExponential() noexcept {
+        return -std::log(1.0f - nextFloat());
+    }
+
+
+    /**
+     *  @brief Fill an array with values converted from the sequence.
+     *
+     *  Whole steps are converted directly, without a copy to `buffer_`.
+     */
+    template <typename Convert>
+    void RandomEngine::_fillFloats(float* out_values, int64_t count, Convert convert) noexcept {
+        if (!out_values) {
+            return;
+        }
+
+        while (count > 0 && buffer_pos_ < kLaneCount) {
+            *out_values++ = convert(buffer_[buffer_pos_++]);
+            count--;
+        }
+
+        uint64_t values[kLaneCount];
+        while (count >= kLaneCount) {
+            _step(values);
+            for (int32_t k = 0; k < kLaneCount; k++) {
+                out_values[k] = convert(values[k]);
+            }
+            out_values += kLaneCount;
+            count -= kLaneCount;
+        }
+
+        while (count-- > 0) {
+            *out_values++ = convert((*this)());
+        }
+    }
+
+
+    /**
+     *  @brief Fill an array with raw 64 bit values.
+     *
+     *  Gives the same values as `count` calls to `operator ()`, whole steps
+     *  are written directly to `out_values`.
+     */
+    void RandomEngine::fillUInt64(uint64_t* out_values, int64_t count) noexcept {
+        if (!out_values) {
+            return;
+        }
+
+        while (count > 0 && buffer_pos_ < kLaneCount) {
+            *out_values++ = buffer_[buffer_pos_++];
+            count--;
+        }
+
+        while (count >= kLaneCount) {
+            _step(out_values);
+            out_values += kLaneCount;
+            count -= kLaneCount;
+        }
+
+        if (count > 0) {
+            _step(buffer_);
+            buffer_pos_ = 0;
+            while (count-- > 0) {
+                *out_values++ = buffer_[buffer_pos_++];
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Fill an array with uniformly distributed numbers in [min, max).
+     */
+    void RandomEngine::fillUniform(float* out_values, int64_t count, float min, float max) noexcept {
+        float range = max - min;
+        _fillFloats(out_values, count, [min, range](uint64_t v) { return min + _toFloat(v) * range; });
+    }
+
+
+    /**
+     *  @brief Fill an array with uniformly distributed numbers in
+     *         [-amount, amount).
+     */
+    void RandomEngine::fillBipolar(float* out_values, int64_t count, float amount) noexcept {
+        _fillFloats(out_values, count, [amount](uint64_t v) { return _toBipolar(v) * amount; });
+    }
+
+
+    /**
+     *  @brief Fill an array with normally distributed numbers.
+     *
+     *  Gives the same values as `count` calls to `nextNormal()`, scaled by
+     *  `stddev` and offset by `mean`.
+     */
+    void RandomEngine::fillNormal(float* out_values, int64_t count, float mean, float stddev) noexcept {
+        if (!out_values || count < 1) {
+            return;
+        }
+
+        if (has_spare_normal_) {
+            *out_values++ = mean + spare_normal_ * stddev;
+            has_spare_normal_ = false;
+            count--;
+        }
+
+        uint64_t bits[kFillChunkSize];
+        float r[kFillChunkSize / 2];
+        float theta[kFillChunkSize / 2];
+        while (count > 1) {
+            auto pair_count = static_cast<int32_t>(std::min<int64_t>(count / 2, kFillChunkSize / 2));
+            fillUInt64(bits, pair_count * 2);
+            for (int32_t i = 0; i < pair_count; i++) {
+                r[i] = std::sqrt(-2.0f * std::log(1.0f - _toFloat(bits[i * 2]))) * stddev;
+                theta[i] = 2.0f * std::numbers::pi_v<float> * _toFloat(bits[i * 2 + 1]);
+            }
+            for (int32_t i = 0; i < pair_count; i++) {
+                out_values[i * 2] = mean + r[i] * std::cos(theta[i]);
+                out_values[i * 2 + 1] = mean + r[i] * std::sin(theta[i]);
+            }
+            out_values += pair_count * 2;
+            count -= pair_count * 2;
+        }
+
+        if (count > 0) {
+            *out_values = mean + nextNormal() * stddev;
+        }
+    }
+
+
+    /**
+     *  @brief Fill an array with exponentially distributed numbers.
+     *
+     *  @param lambda Rate of the distribution, the mean is `1 / lambda`.
+     */
+    void RandomEngine::fillExponential(float* out_values, int64_t count, float lambda) noexcept {
+        if (lambda <= 0.0f) {
+            return;
+        }
+
+        float scale = -1.0f / lambda;
+        _fillFloats(out_values, count, [scale](uint64_t v) { return std::log(1.0f - _toFloat(v)) * scale; });
+    }
+
+
+    /**
+     *  @brief Advance a single state by the steps given by `polynomial`.
+     */
+    void RandomEngine::_jump(uint64_t* state, const uint64_t* polynomial) noexcept {
+        uint64_t result[4] = { 0, 0, 0, 0 };
+        for (int32_t i = 0; i < 4; i++) {
+            for (int32_t b = 0; b < 64; b++) {
+                if (polynomial[i] & (1ULL << b)) {
+                    for (int32_t w = 0; w < 4; w++) {
+                        result[w] ^= state[w];
+                    }
+                }
+                _xoshiroStep(state);
+            }
+        }
+        for (int32_t w = 0; w < 4; w++) {
+            state[w] = result[w];
+        }
+    }
+
+
+    /**
+     *  @brief A seed which differs for every call, for engines which need not
+     *         be reproducible.
+     */
+    uint64_t RandomEngine::_randomSeed() noexcept {
+        static std::atomic<uint64_t> counter{ 0 };
+
+        uint64_t x = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        x ^= counter.fetch_add(1, std::memory_order_relaxed) * 0x9e3779b97f4a7c15ULL;
+        try {
+            std::random_device device;
+            x ^= (static_cast<uint64_t>(device()) << 32) | device();
+        }
+        catch (...) {
+            // The clock and the counter are sufficient
+        }
+        return _splitMix64(x);
+    }
+
+
     /**
      *  @brief Returns a random integer in [min, max].
      *  @param min Minimum value (inclusive).
@@ -12,15 +12,63 @@
 #include "Signal/Signal.hpp"
 
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 
 namespace Grain {
 
 MovieWriter::~MovieWriter() noexcept {
-    delete video_frame_buffer_;
+    _freeFrameBuffers();
 };
 
 
+void MovieWriter::_freeFrameBuffers() noexcept {
+    for (auto image : frame_buffers_) {
+        delete image;
+    }
+    frame_buffers_.clear();
+    video_frame_buffer_ = nullptr;
+}
+
+
+/**
+ *  @brief Allocate the ring of frame buffers in the configured pixel format.
+ */
+ErrorCode MovieWriter::_allocFrameBuffers(const MovieWriterConfig& config) noexcept {
+    _freeFrameBuffers();
+
+    Image::PixelType pixel_type = Image::PixelType::Float;
+    switch (config.frame_format) {
+        case MovieFrameFormat::UInt8: pixel_type = Image::PixelType::UInt8; break;
+        case MovieFrameFormat::UInt16: pixel_type = Image::PixelType::UInt16; break;
+        default: break;
+    }
+
+    int32_t count = std::max(config.frame_buffer_count, 2);
+
+    try {
+        for (int32_t i = 0; i < count; i++) {
+            auto image = new (std::nothrow) Image(Color::Model::RGBA, config.width, config.height, pixel_type);
+            if (!image || !image->hasPixel()) {
+                delete image;
+                _freeFrameBuffers();
+                return ErrorCode::MemCantAllocate;
+            }
+            frame_buffers_.push_back(image);
+        }
+    }
+    catch (const std::exception& e) {
+        _freeFrameBuffers();
+        return ErrorCode::StdCppException;
+    }
+
+    return ErrorCode::None;
+}
+
+
 ErrorCode MovieWriter::writeVideoWithAudio(
         const String& file_path,
         int64_t video_frame_count,
@@ -36,7 +84,11 @@ ErrorCode MovieWriter::writeVideoWithAudio(
     const int32_t height = config.height;
 
     ref_ptr_ = ref;
-    video_frame_buffer_ = Image::createRGBAFloat(width, height);
+
+    auto alloc_err = _allocFrameBuffers(config);
+    if (alloc_err != ErrorCode::None) {
+        return alloc_err;
+    }
 
     avformat_network_init();
 
@@ -192,17 +244,32 @@ ErrorCode MovieWriter::writeVideoWithAudio(
         av_frame_get_buffer(frame_yuv_intermediate, 32);
     }
 
-    AVFrame* frame_rgb = av_frame_alloc();
-    frame_rgb->format = AV_PIX_FMT_RGBF32LE;
-    frame_rgb->width  = width;
-    frame_rgb->height = height;
-    av_frame_get_buffer(frame_rgb, 32);
+    // Source format of the color conversion. Float frames are copied into
+    // an RGBF32 frame, 8 and 16 bit frames are read by swscale directly from
+    // the frame buffer.
+    AVPixelFormat src_fmt = AV_PIX_FMT_RGBF32LE;
+    AVFrame* frame_rgb = nullptr;
+    switch (config.frame_format) {
+        case MovieFrameFormat::UInt8:
+            src_fmt = AV_PIX_FMT_RGBA;
+            break;
+        case MovieFrameFormat::UInt16:
+            src_fmt = AV_PIX_FMT_RGBA64;  // Native endianness, as in Image
+            break;
+        default:
+            frame_rgb = av_frame_alloc();
+            frame_rgb->format = AV_PIX_FMT_RGBF32LE;
+            frame_rgb->width  = width;
+            frame_rgb->height = height;
+            av_frame_get_buffer(frame_rgb, 32);
+            break;
+    }
 
 
-    // RGBF32 -> YUV (either final or intermediate)
+    // RGB -> YUV (either final or intermediate)
     SwsContext* sws_rgb_to_yuv = sws_getContext(
         width, height,
-        AV_PIX_FMT_RGBF32LE,
+        src_fmt,
         width, height,
         (intermediate_fmt != AV_PIX_FMT_NONE) ? intermediate_fmt : video_ctx->pix_fmt,
         SWS_LANCZOS | SWS_ACCURATE_RND,
@@ -258,30 +325,36 @@ ErrorCode MovieWriter::writeVideoWithAudio(
 
     AVPacket* pkt = av_packet_alloc();
 
-    // Write Video
-    float pixel[4]{};
-    ImageAccess fia(video_frame_buffer_, pixel);
-
-    for (int64_t frame_index = 0; frame_index < video_frame_count; frame_index++) {
-        frame_callback(this, frame_index);
-
-        while (fia.stepY()) {
-            float* row = reinterpret_cast<float*>(frame_rgb->data[0] + fia.y() * frame_rgb->linesize[0]);
-
-            int32_t x = 0;
-            while (fia.stepX()) {
-                fia.read();
-                row[x + 0] = pixel[0];
-                row[x + 1] = pixel[1];
-                row[x + 2] = pixel[2];
-                x += 3;
+    // Convert and encode one frame, called on the encoder thread only
+    auto encode_frame = [&](Image* image, int64_t frame_index) -> bool {
+        const uint8_t* src_data[4] = { image->pixelDataPtr(), nullptr, nullptr, nullptr };
+        int src_linesize[4] = { static_cast<int>(image->bytesPerRow()), 0, 0, 0 };
+
+        if (frame_rgb) {
+            // RGBA float -> RGBF32, the alpha channel is dropped
+            for (int32_t y = 0; y < height; y++) {
+                const float* src = reinterpret_cast<const float*>(src_data[0] + static_cast<size_t>(y) * src_linesize[0]);
+                float* dst = reinterpret_cast<float*>(frame_rgb->data[0] + static_cast<size_t>(y) * frame_rgb->linesize[0]);
+                for (int32_t x = 0; x < width; x++) {
+                    dst[0] = src[0];
+                    dst[1] = src[1];
+                    dst[2] = src[2];
+                    src += 4;
+                    dst += 3;
+                }
             }
+            src_data[0] = frame_rgb->data[0];
+            src_linesize[0] = frame_rgb->linesize[0];
         }
 
-        // RGBF32 -> YUV444P10 or final YUV
+        if (av_frame_make_writable(frame_yuv) < 0) {
+            return false;
+        }
+
+        // RGB -> YUV444P10 or final YUV
         sws_scale(
             sws_rgb_to_yuv,
-            frame_rgb->data, frame_rgb->linesize,
+            src_data, src_linesize,
             0, height,
             (intermediate_fmt != AV_PIX_FMT_NONE)
                 ? frame_yuv_intermediate->data
@@ -303,13 +376,101 @@ ErrorCode MovieWriter::writeVideoWithAudio(
 
         frame_yuv->pts = frame_index;
 
-        avcodec_send_frame(video_ctx, frame_yuv);
+        if (avcodec_send_frame(video_ctx, frame_yuv) < 0) {
+            return false;
+        }
         while (avcodec_receive_packet(video_ctx, pkt) == 0) {
             av_packet_rescale_ts(pkt, video_ctx->time_base, video_stream->time_base);
             pkt->stream_index = video_stream->index;
             av_interleaved_write_frame(fmt_ctx, pkt);
             av_packet_unref(pkt);
         }
+
+        return true;
+    };
+
+
+    // Write Video
+    // The frame callback renders on this thread into a free buffer of the
+    // ring, while the encoder thread converts and encodes filled buffers in
+    // frame order.
+    ErrorCode result = ErrorCode::None;
+
+    std::mutex pipeline_mutex;
+    std::condition_variable pipeline_cv;
+    std::deque<int32_t> free_buffers;
+    std::deque<std::pair<int32_t, int64_t>> filled_buffers;  // Buffer index, frame index
+    bool render_done = false;
+    bool encode_failed = false;
+
+    for (int32_t i = 0; i < static_cast<int32_t>(frame_buffers_.size()); i++) {
+        free_buffers.push_back(i);
+    }
+
+    std::thread encoder_thread([&]() {
+        while (true) {
+            std::pair<int32_t, int64_t> job;
+            {
+                std::unique_lock<std::mutex> lock(pipeline_mutex);
+                pipeline_cv.wait(lock, [&] { return !filled_buffers.empty() || render_done; });
+                if (filled_buffers.empty()) {
+                    break;
+                }
+                job = filled_buffers.front();
+                filled_buffers.pop_front();
+            }
+
+            bool ok = encode_frame(frame_buffers_[job.first], job.second);
+
+            {
+                std::lock_guard<std::mutex> lock(pipeline_mutex);
+                free_buffers.push_back(job.first);
+                if (!ok) {
+                    encode_failed = true;
+                }
+            }
+            pipeline_cv.notify_all();
+
+            if (!ok) {
+                break;
+            }
+        }
+    });
+
+    for (int64_t frame_index = 0; frame_index < video_frame_count; frame_index++) {
+        int32_t buffer_index;
+        {
+            std::unique_lock<std::mutex> lock(pipeline_mutex);
+            pipeline_cv.wait(lock, [&] { return !free_buffers.empty() || encode_failed; });
+            if (encode_failed) {
+                break;
+            }
+            buffer_index = free_buffers.front();
+            free_buffers.pop_front();
+        }
+
+        video_frame_buffer_ = frame_buffers_[buffer_index];
+        frame_callback(this, frame_index);
+
+        {
+            std::lock_guard<std::mutex> lock(pipeline_mutex);
+            filled_buffers.emplace_back(buffer_index, frame_index);
+        }
+        pipeline_cv.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex);
+        render_done = true;
+    }
+    pipeline_cv.notify_all();
+    encoder_thread.join();
+
+    video_frame_buffer_ = nullptr;
+
+    if (encode_failed) {
+        std::cerr << "Failed to encode video frame\n";
+        result = ErrorCode::Fatal;
     }
 
     // Write Audio (no resampling)
@@ -325,7 +486,7 @@ ErrorCode MovieWriter::writeVideoWithAudio(
     const int channels = audio_ctx->ch_layout.nb_channels;
     const int64_t total_samples = audio_signal->sampleCount();
 
-    while (sample_pos < total_samples) {
+    while (result == ErrorCode::None && sample_pos < total_samples) {
         int nb = std::min<int64_t>(audio_ctx->frame_size,
                                   total_samples - sample_pos);
 
@@ -380,7 +541,7 @@ ErrorCode MovieWriter::writeVideoWithAudio(
     avio_closep(&fmt_ctx->pb);
     avformat_free_context(fmt_ctx);
 
-    return ErrorCode::None;
+    return result;
 }
 
 } // End of namespace
\ No newline at end of file
@@ -0,0 +1,171 @@
+//
+//  SVGDisplayList.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>
+//
+
+#include "SVG/SVGDisplayList.hpp"
+#include "SVG/SVG.hpp"
+#include "SVG/SVGRootElement.hpp"
+#include "SVG/SVGGroupElement.hpp"
+#include "SVG/SVGPaintElement.hpp"
+#include "Graphic/GraphicContext.hpp"
+
+
+namespace Grain {
+
+    /**
+     *  @brief Compile a parsed SVG into a flat list of drawing items.
+     *
+     *  Walks the element tree once, in the same order as `SVG::draw()`, and
+     *  accumulates transformations and paint settings along the way.
+     *
+     *  @param svg The SVG, `SVG::parse()` must have been called before.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode SVGDisplayList::compile(SVG* svg) noexcept {
+
+        clear();
+
+        if (!svg) {
+            return ErrorCode::NullPointer;
+        }
+
+        auto root = svg->mutRootElement();
+        if (!root) {
+            return ErrorCode::NoData;
+        }
+
+        try {
+            svg_ = svg;
+            view_box_ = root->viewBox();
+
+            SVGDisplayItem state;
+            _compileGroup(root, state);
+        }
+        catch (const std::exception&) {
+            clear();
+            return ErrorCode::StdCppException;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    void SVGDisplayList::clear() noexcept {
+
+        svg_ = nullptr;
+        items_.clear();
+        view_box_.zero();
+    }
+
+
+    /**
+     *  @brief Compile all elements of a group.
+     *
+     *  `state` holds the settings inherited from the ancestors. Each element
+     *  gets its own copy, on which the element's paint style is applied,
+     *  mirroring the save/restore pairs in `SVGGroupElement::draw()`.
+     */
+    void SVGDisplayList::_compileGroup(SVGGroupElement* group, const SVGDisplayItem& state) noexcept {
+
+        for (int32_t i = 0; i < group->elementCount(); i++) {
+            auto element = group->elementAtIndex(i);
+            if (!element || !element->canDraw()) {
+                continue;
+            }
+
+            auto paint_element = (SVGPaintElement*)element;
+
+            SVGDisplayItem item = state;
+            paint_element->paintStyle()->applyToDisplayItem(item);
+
+            if (paint_element->isGroup()) {
+                _compileGroup((SVGGroupElement*)paint_element, item);
+            }
+            else {
+                item.element_ = paint_element;
+                item.does_fill_ = paint_element->doesFill();
+                item.does_stroke_ = paint_element->doesStroke();
+
+                if (item.does_fill_ || item.does_stroke_) {
+                    // `Mat3d` keeps the translation in the last column, the
+                    // GraphicContext expects it in the last row
+                    item.matrix_.transpose();
+                    items_.push_back(item);
+                }
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Draw the compiled SVG to a GraphicContext.
+     *
+     *  @param gc The context to draw to. Its current transformation is used
+     *            as the coordinate system of the SVG root.
+     *  @param fill_override If not nullptr, this color replaces all fill colors.
+     *  @param stroke_override If not nullptr, this color replaces all stroke colors.
+     */
+    void SVGDisplayList::draw(GraphicContext& gc, const RGBA* fill_override, const RGBA* stroke_override) const noexcept {
+
+        if (!svg_) {
+            return;
+        }
+
+        for (auto& item : items_) {
+            gc.save();
+
+            gc.affineTransform(item.matrix_);
+
+            if (item.hasFlag(SVGDisplayItem::kFlag_Alpha)) {
+                gc.setAlpha(item.alpha_);
+            }
+
+            if (fill_override) {
+                gc.setFillRGBA(*fill_override);
+            }
+            else if (item.hasFlag(SVGDisplayItem::kFlag_FillColor)) {
+                gc.setFillRGB(item.fill_color_);
+            }
+
+            if (stroke_override) {
+                gc.setStrokeRGBA(*stroke_override);
+            }
+            else if (item.hasFlag(SVGDisplayItem::kFlag_StrokeColor)) {
+                gc.setStrokeRGB(item.stroke_color_);
+            }
+
+            if (item.hasFlag(SVGDisplayItem::kFlag_StrokeWidth)) {
+                gc.setStrokeWidth(item.stroke_width_);
+            }
+
+            if (item.hasFlag(SVGDisplayItem::kFlag_StrokeCap)) {
+                gc.setStrokeCapStyle(item.stroke_cap_);
+            }
+
+            if (item.hasFlag(SVGDisplayItem::kFlag_StrokeJoin)) {
+                gc.setStrokeJoinStyle(item.stroke_join_);
+            }
+
+            if (item.hasFlag(SVGDisplayItem::kFlag_StrokeMiterLimit)) {
+                gc.setStrokeMiterLimit(item.stroke_miter_limit_);
+            }
+
+            if (item.does_fill_) {
+                item.element_->fill(svg_, gc);
+            }
+
+            if (item.does_stroke_) {
+                item.element_->stroke(svg_, gc);
+            }
+
+            gc.restore();
+        }
+    }
+
+
+} // End of namespace Grain
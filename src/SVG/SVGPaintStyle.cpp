@@ -12,6 +12,7 @@
 #include "SVG/SVGElement.hpp"
 #include "CSS/CSS.hpp"
 #include "CSS/CSSColor.hpp"
+#include "SVG/SVGDisplayList.hpp"
 #include "Graphic/GraphicContext.hpp"
 #include "Core/Log.hpp"
 
@@ -307,6 +308,54 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Resolve the style into a display item.
+     *
+     *  Same as `setGCSettings()`, but the settings are accumulated in `item`
+     *  instead of being applied to a GraphicContext.
+     */
+    void SVGPaintStyle::applyToDisplayItem(SVGDisplayItem& item) const noexcept {
+        for (int32_t i = 0; i < transform_count_; i++) {
+            transform_stack_[i].transformMatrix(item.matrix_);
+        }
+
+        if (attr_opacity_.hasValue()) {
+            item.alpha_ = static_cast<float>(attr_opacity_.valueAsDouble());
+            item.flags_ |= SVGDisplayItem::kFlag_Alpha;
+        }
+
+        if (attr_fill_.hasValue()) {
+            item.fill_color_ = attr_fill_.use_current_color_ ? attr_color_.color_ : attr_fill_.color_;
+            item.flags_ |= SVGDisplayItem::kFlag_FillColor;
+        }
+
+        if (attr_stroke_.hasValue()) {
+            item.stroke_color_ = attr_stroke_.use_current_color_ ? attr_color_.color_ : attr_stroke_.color_;
+            item.flags_ |= SVGDisplayItem::kFlag_StrokeColor;
+        }
+
+        if (attr_stroke_width_.hasValue()) {
+            item.stroke_width_ = attr_stroke_width_.css_value_.valueAsDouble();  // TODO: Handle unit.
+            item.flags_ |= SVGDisplayItem::kFlag_StrokeWidth;
+        }
+
+        if (attr_stroke_linecap_.hasValue()) {
+            item.stroke_cap_ = (StrokeCapStyle)attr_stroke_linecap_.css_value_.valueAsInt32();
+            item.flags_ |= SVGDisplayItem::kFlag_StrokeCap;
+        }
+
+        if (attr_stroke_linejoin_.hasValue()) {
+            item.stroke_join_ = (StrokeJoinStyle)attr_stroke_linejoin_.css_value_.valueAsInt32();
+            item.flags_ |= SVGDisplayItem::kFlag_StrokeJoin;
+        }
+
+        if (attr_stroke_miterlimit_.hasValue()) {
+            item.stroke_miter_limit_ = attr_stroke_miterlimit_.css_value_.valueAsDouble();
+            item.flags_ |= SVGDisplayItem::kFlag_StrokeMiterLimit;
+        }
+    }
+
+
     /**
      *  @brief Set all paint style properties with values from `xml_element`.
      */
@@ -490,6 +539,7 @@ namespace Grain {
                     m.setSVGTransform(
                         values_[0].valueAsDouble(), values_[1].valueAsDouble(), values_[2].valueAsDouble(),
                         values_[3].valueAsDouble(), values_[4].valueAsDouble(), values_[5].valueAsDouble());
+                    m.transpose();  // GraphicContext expects the translation in the last row
                     gc.affineTransform(m);
                 }
                 break;
@@ -538,6 +588,62 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Concatenate the transformation to `matrix`.
+     *
+     *  Matrix counterpart of `transformGC()`, used when compiling an SVG into
+     *  an `SVGDisplayList`.
+     */
+    void SVGTransform::transformMatrix(Mat3d& matrix) const noexcept {
+        switch (transform_type_) {
+            case SVGTransformType::Matrix: {
+                if (value_count_ == 6) {
+                    Mat3d m;
+                    m.setSVGTransform(
+                        values_[0].valueAsDouble(), values_[1].valueAsDouble(), values_[2].valueAsDouble(),
+                        values_[3].valueAsDouble(), values_[4].valueAsDouble(), values_[5].valueAsDouble());
+                    matrix.mul(m);
+                }
+                break;
+            }
+            case SVGTransformType::Translate: {
+                if (value_count_ == 1) {
+                    matrix.translateX(values_[0].valueAsDouble());
+                }
+                else if (value_count_ == 2) {
+                    matrix.translate(values_[0].valueAsDouble(), values_[1].valueAsDouble());
+                }
+                break;
+            }
+            case SVGTransformType::Scale: {
+                if (value_count_ == 1) {
+                    matrix.scale(values_[0].valueAsDouble());
+                }
+                else if (value_count_ == 2) {
+                    matrix.scale(values_[0].valueAsDouble(), values_[1].valueAsDouble());
+                }
+                break;
+            }
+            case SVGTransformType::Rotate: {
+                if (value_count_ == 1) {
+                    matrix.rotate(values_[0].valueAsDouble());
+                }
+                else if (value_count_ == 3) {
+                    double px = values_[1].valueAsDouble();
+                    double py = values_[2].valueAsDouble();
+                    matrix.translate(px, py);
+                    matrix.rotate(values_[0].valueAsDouble());
+                    matrix.translate(-px, -py);
+                }
+                break;
+            }
+            default:
+                // TODO: Implement skew and perspective, see `transformGC()`
+                break;
+        }
+    }
+
+
     void SVGPaintStyle::log(std::ostream& os, int32_t indent, const char* label) const {
         Log l(os);
         l.header(label);
@@ -60,6 +60,21 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief The view box of the document.
+     *
+     *  Falls back to `width` and `height`, if no view box is defined.
+     */
+    Rectd SVGRootElement::viewBox() const noexcept {
+        double width = viewport_width_.valueAsDouble();
+        double height = viewport_height_.valueAsDouble();
+        if (width > 0.0 && height > 0.0) {
+            return Rectd(viewport_x_.valueAsDouble(), viewport_y_.valueAsDouble(), width, height);
+        }
+        return Rectd(0.0, 0.0, width_.valueAsDouble(), height_.valueAsDouble());
+    }
+
+
     void SVGRootElement::setViewBox(const char* str) noexcept {
         try {
             if (!str) {
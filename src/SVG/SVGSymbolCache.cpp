@@ -0,0 +1,291 @@
+//
+//  SVGSymbolCache.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>
+//
+
+#include "SVG/SVGSymbolCache.hpp"
+#include "SVG/SVG.hpp"
+#include "Image/Image.hpp"
+#include "Graphic/CairoContext.hpp"
+
+#include <cmath>
+
+
+namespace Grain {
+
+    SVGSymbolCache::SVGSymbolCache(int64_t capacity) noexcept {
+
+        capacity_ = std::max<int64_t>(capacity, 0);
+    }
+
+
+    int64_t SVGSymbolCache::capacity() const noexcept {
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+
+    void SVGSymbolCache::setCapacity(int64_t capacity) noexcept {
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = std::max<int64_t>(capacity, 0);
+        _evict(0);
+    }
+
+
+    SVGSymbolCache::Stats SVGSymbolCache::stats() const noexcept {
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.sprite_count_ = static_cast<int64_t>(entries_.size());
+        return stats;
+    }
+
+
+    void SVGSymbolCache::clear() noexcept {
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        display_lists_.clear();
+        stats_.byte_count_ = 0;
+    }
+
+
+    /**
+     *  @brief Remove all sprites and the display list of an SVG.
+     *
+     *  Must be called before an SVG used with the cache is deleted or parsed
+     *  again.
+     */
+    void SVGSymbolCache::removeSVG(const SVG* svg) noexcept {
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (it->first.svg_ == svg) {
+                stats_.byte_count_ -= it->second.byte_count_;
+                it = entries_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        display_lists_.erase(svg);
+    }
+
+
+    /**
+     *  @brief Get the sprite of an SVG at a given scale and coloring.
+     *
+     *  Rasterizes the sprite on a cache miss. The sprite covers the view box
+     *  of the SVG multiplied by `scale`, rounded up to whole pixels.
+     *
+     *  @param svg The SVG, `SVG::parse()` must have been called before.
+     *  @param scale Scale factor from SVG units to pixels.
+     *  @param fill_override If not nullptr, this color replaces all fill colors.
+     *  @param stroke_override If not nullptr, this color replaces all stroke colors.
+     *  @return The sprite or nullptr, if the SVG could not be rasterized.
+     */
+    SVGSymbolCache::Sprite SVGSymbolCache::sprite(SVG* svg, double scale, const RGBA* fill_override, const RGBA* stroke_override) noexcept {
+
+        if (!svg || !(scale > 0.0)) {
+            return nullptr;
+        }
+
+        Key key;
+        key.svg_ = svg;
+        key.scale_ = static_cast<int32_t>(std::lround(std::min(scale, 1.0e6) * 1024.0));
+        if (fill_override) {
+            key.fill_ = fill_override->rgba32bit();
+            key.override_flags_ |= 0x1;
+        }
+        if (stroke_override) {
+            key.stroke_ = stroke_override->rgba32bit();
+            key.override_flags_ |= 0x2;
+        }
+
+        std::shared_ptr<CompiledSVG> compiled;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            use_counter_++;
+
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                stats_.hit_count_++;
+                it->second.last_use_ = use_counter_;
+                return it->second.sprite_;
+            }
+
+            stats_.miss_count_++;
+
+            compiled = _displayList(svg);
+            if (!compiled) {
+                return nullptr;
+            }
+        }
+
+        // Rasterize with the quantized scale, so that equal keys give equal sprites
+        Image* image;
+        {
+            std::lock_guard<std::mutex> draw_lock(compiled->draw_mutex_);
+            image = _rasterize(compiled->display_list_, key.scale_ / 1024.0, fill_override, stroke_override);
+        }
+
+        if (!image) {
+            return nullptr;
+        }
+
+        try {
+            Sprite sprite(image);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // Another thread may have rasterized the same key in the meantime
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                it->second.last_use_ = use_counter_;
+                return it->second.sprite_;
+            }
+
+            Entry entry;
+            entry.sprite_ = sprite;
+            entry.byte_count_ = static_cast<int64_t>(image->memSize());
+            entry.last_use_ = use_counter_;
+
+            _evict(entry.byte_count_);
+
+            stats_.byte_count_ += entry.byte_count_;
+            entries_[key] = std::move(entry);
+
+            return sprite;
+        }
+        catch (const std::exception&) {
+            return nullptr;
+        }
+    }
+
+
+    /**
+     *  @brief Draw a symbol centered at a position.
+     *
+     *  @param image Destination image, RGBA float with premultiplied alpha.
+     *  @param svg The SVG to draw.
+     *  @param center Position of the symbol center in pixels.
+     *  @param scale Scale factor from SVG units to pixels.
+     *  @param fill_override If not nullptr, this color replaces all fill colors.
+     *  @param stroke_override If not nullptr, this color replaces all stroke colors.
+     *  @param alpha Opacity of the symbol.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode SVGSymbolCache::drawSymbol(Image* image, SVG* svg, const Vec2d& center, double scale, const RGBA* fill_override, const RGBA* stroke_override, float alpha) noexcept {
+
+        if (!image || !svg) {
+            return ErrorCode::NullPointer;
+        }
+
+        auto sprite = this->sprite(svg, scale, fill_override, stroke_override);
+        if (!sprite) {
+            return ErrorCode::NoData;
+        }
+
+        auto x = static_cast<int32_t>(std::lround(center.x_ - 0.5 * sprite->width()));
+        auto y = static_cast<int32_t>(std::lround(center.y_ - 0.5 * sprite->height()));
+
+        return image->compositeImage(sprite.get(), x, y, alpha);
+    }
+
+
+    /**
+     *  @brief Get the display list of an SVG, compile it if necessary.
+     *
+     *  Must be called with the mutex locked. The returned object stays valid
+     *  after unlocking, even if `removeSVG()` is called meanwhile.
+     */
+    std::shared_ptr<SVGSymbolCache::CompiledSVG> SVGSymbolCache::_displayList(SVG* svg) noexcept {
+
+        auto it = display_lists_.find(svg);
+        if (it != display_lists_.end()) {
+            return it->second;
+        }
+
+        try {
+            auto compiled = std::make_shared<CompiledSVG>();
+            if (compiled->display_list_.compile(svg) != ErrorCode::None) {
+                return nullptr;
+            }
+
+            display_lists_[svg] = compiled;
+            return compiled;
+        }
+        catch (const std::exception&) {
+            return nullptr;
+        }
+    }
+
+
+    /**
+     *  @brief Remove least recently used sprites until `needed_byte_count`
+     *         additional bytes fit into the capacity.
+     *
+     *  Must be called with the mutex locked.
+     */
+    void SVGSymbolCache::_evict(int64_t needed_byte_count) noexcept {
+
+        while (!entries_.empty() && stats_.byte_count_ + needed_byte_count > capacity_) {
+            auto oldest = entries_.begin();
+            for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+                if (it->second.last_use_ < oldest->second.last_use_) {
+                    oldest = it;
+                }
+            }
+
+            stats_.byte_count_ -= oldest->second.byte_count_;
+            stats_.eviction_count_++;
+            entries_.erase(oldest);
+        }
+    }
+
+
+    Image* SVGSymbolCache::_rasterize(const SVGDisplayList& display_list, double scale, const RGBA* fill_override, const RGBA* stroke_override) noexcept {
+
+        auto& view_box = display_list.viewBox();
+        if (!(view_box.width_ > 0.0) || !(view_box.height_ > 0.0)) {
+            return nullptr;
+        }
+
+        auto width = static_cast<int32_t>(std::ceil(view_box.width_ * scale));
+        auto height = static_cast<int32_t>(std::ceil(view_box.height_ * scale));
+        if (width < 1 || height < 1) {
+            return nullptr;
+        }
+
+        Image* image = Image::createRGBAFloat(width, height);
+        if (!image) {
+            return nullptr;
+        }
+
+        if (image->beginDraw()) {
+            image->clear(RGBA(0.0f, 0.0f, 0.0f, 0.0f));
+
+            CairoContext gc;
+            gc.setImage(image);
+            gc.scale(scale, scale);
+            gc.translate(-view_box.x_, -view_box.y_);
+            display_list.draw(gc, fill_override, stroke_override);
+
+            image->endDraw();
+        }
+
+        return image;
+    }
+
+
+} // End of namespace Grain
@@ -17,9 +17,12 @@
 #include "DSP/DSP.hpp"
 #include "Math/Random.hpp"
 #include "DSP/RingBuffer.hpp"
+#include "DSP/Resampler.hpp"
 #include "Core/Log.hpp"
 
 #include <sndfile.h>
+#include <numeric>
+#include <thread>
 
 
 namespace Grain {
@@ -30,22 +33,23 @@ namespace Grain {
      *
      *  This method processes a given `Signal` object to generate a simplified
      *  version of the signal's envelope or energy profile, optimized for
-     *  visualization. It downsamples the signal by a fixed factor (4096),
+     *  visualization. It downsamples the signal by a fixed factor (`kStep`),
      *  calculates a smoothed energy value for each segment, and stores it in an
      *  internal buffer.
      *
      *  @details
      *  The simplified signal is computed by dividing the full signal into blocks
-     *  of 4096 samples (fixed), squaring and summing the samples to calculate
-     *  the local energy, taking the square root, and scaling the result to fit
-     *  within a 16-bit signed integer range. This is especially useful for:
+     *  of `kStep` samples, calculating the RMS of each block relative to the
+     *  full scale of the data type with `Signal::stats()`, and scaling the
+     *  result to fit within a 16-bit signed integer range. The last block may
+     *  be shorter. This is especially useful for:
      *
      *  - Audio visualization (e.g., waveform overviews)
      *  - Rough envelope detection
      *  - Signal monitoring or metering
      *
-     *  It ensures minimum time resolution based on the signal's sample rate to
-     *  maintain consistent visual responsiveness across various input sources.
+     *  Long signals are processed by several threads, each on a contiguous
+     *  range of blocks.
      *
      *  Memory for the internal buffer is dynamically allocated or reallocated
      *  if the required length changes.
@@ -62,58 +66,68 @@ namespace Grain {
      *           called judiciously to avoid memory fragmentation or leaks.
      */
     void SimplifiedSignal::update(Signal* signal, int32_t channel) noexcept {
-        int64_t new_len = 0;
-
-        if (!signal) {
+        if (!signal || !signal->hasChannelAndData(channel)) {
             return;
         }
 
-        if (!signal->hasChannel(channel)) {
-            return;
-        }
-
-        // TODO: Implement custom, context specific divisor instead of using hard coded 4096.
-        new_len = signal->sampleCount() / 4096;
+        // TODO: Implement custom, context specific divisor instead of using hard coded kStep.
+        int64_t sample_count = signal->sampleCount();
+        int64_t new_len = (sample_count + kStep - 1) / kStep;
         if (new_len < 1) {
             return;
         }
 
         if (!m_values || new_len != m_len) {
-            m_values = (int16_t*)malloc(sizeof(int16_t) * new_len);
-            if (!m_values) {
+            auto values = static_cast<int16_t*>(realloc(m_values, sizeof(int16_t) * new_len));
+            if (!values) {
+                free(m_values);
+                m_values = nullptr;
                 m_len = 0;
                 return;
             }
+            m_values = values;
         }
 
         m_len = new_len;
-        int32_t sample_rate = signal->sampleRate();
-        int64_t sample_count = signal->sampleCount();
+        m_step = kStep;
+
+        // RMS of each step, relative to full scale
+        double scale = std::numeric_limits<int16_t>::max() / signal->fullScaleValue();
+        auto update_range = [this, signal, channel, scale](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; i++) {
+                SignalStats stats;
+                signal->stats(channel, i * kStep, kStep, stats, SignalStats::kSquareSum, 1, 1);
+                m_values[i] = static_cast<int16_t>(std::min(stats.rms() * scale, static_cast<double>(std::numeric_limits<int16_t>::max())));
+            }
+        };
+
+        auto thread_count = static_cast<int32_t>(std::clamp<int64_t>(
+                sample_count / Signal::kMinSamplesPerStatsThread,
+                1,
+                std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1)));
 
-        auto min_step = static_cast<int64_t>(std::round(static_cast<double>(m_len) / 500 * sample_rate / 44100));
-        auto ms = static_cast<int64_t>(std::round(15.0 * sample_rate / 44100));
-        if (min_step < ms) {
-            min_step = ms;
+        if (thread_count == 1) {
+            update_range(0, m_len);
+            return;
         }
 
-        int64_t step = m_len;
-        if (step < min_step) {
-            step = min_step;
+        std::vector<std::thread> threads;
+        try {
+            threads.reserve(thread_count);
+            for (int32_t i = 0; i < thread_count; i++) {
+                threads.emplace_back(update_range, m_len * i / thread_count, m_len * (i + 1) / thread_count);
+            }
+        }
+        catch (const std::exception&) {
+            // Not all threads could be started, the remaining ranges are
+            // updated on this thread
         }
 
-        m_step = 4096;
+        auto started_count = static_cast<int32_t>(threads.size());
+        update_range(m_len * started_count / thread_count, m_len);
 
-        int16_t* d = m_values;
-        for (int64_t i = 0; i < sample_count; ) {
-            float v = 0.0f;
-            for (int64_t j = 0; j < 4096; j++, i++) {
-                float s = signal->readFloat(channel, i);
-                if (s < 0.0f) {
-                    s = -s;
-                }
-                v += s * s;
-            }
-            *d++ = static_cast<int16_t>(std::sqrt(v / static_cast<float>(step)) * std::numeric_limits<int16_t>::max());
+        for (auto& thread : threads) {
+            thread.join();
         }
     }
 
@@ -648,159 +662,354 @@ namespace Grain {
     }
 
 
-    template <typename T>
-    void Signal::_absMaxFunc(SignalSampleFuncInfo& info) {
-        auto v = static_cast<double>(*reinterpret_cast<T*>(info.m_sample_ptr.raw));
-        if (v < 0.0) { v = -v; }
-        if (v > info.m_value.f64) { info.m_value.f64 = v; }
-    }
+    /**
+     *  @brief Statistics of a range of samples in one pass.
+     *
+     *  Long ranges are split across threads, see `kMinSamplesPerStatsThread`.
+     *
+     *  @param channel The channel index, -1 for all channels. With all
+     *                 channels, zero crossings are counted per channel and
+     *                 summed up.
+     *  @param offs The starting sample index.
+     *  @param len Number of samples, -1 for the rest of the signal.
+     *  @param out_stats Receives the statistics, min and max indices are
+     *                   sample indices.
+     *  @param flags The values to compute, see `SignalStats`.
+     *  @param stride Use every `stride` sample only.
+     *  @param thread_count Maximum number of threads, 0 for one thread per
+     *                      hardware thread.
+     */
+    ErrorCode Signal::stats(
+            int32_t channel,
+            int64_t offs,
+            int64_t len,
+            SignalStats& out_stats,
+            uint32_t flags,
+            int64_t stride,
+            int32_t thread_count) const noexcept
+    {
+        out_stats.reset();
 
+        if (stride < 1) {
+            return ErrorCode::BadArgs;
+        }
 
-    double Signal::absMax(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
-        SignalSampleFuncInfo info{};
-        info.m_value.f64 = 0.0;
+        if (!hasData()) {
+            return ErrorCode::NoData;
+        }
+
+        if (channel < 0) {
+            for (int32_t c = 0; c < m_channel_count; c++) {
+                SignalStats channel_stats;
+                auto err = stats(c, offs, len, channel_stats, flags, stride, thread_count);
+                if (err != ErrorCode::None) {
+                    out_stats.reset();
+                    return err;
+                }
+                out_stats.merge(channel_stats, false);
+            }
+            return ErrorCode::None;
+        }
+
+        if (!hasChannel(channel)) {
+            return ErrorCode::InvalidChannel;
+        }
+
+        if (len < 0) {
+            len = m_sample_count;
+        }
+
+        if (clampOffsAndLen(offs, len) < 1) {
+            return ErrorCode::RegionOutOfRange;
+        }
+
+        const void* data = dataPtr(channel, offs);
+        if (!data) {
+            return ErrorCode::UnexpectedRuntimeError;
+        }
+
+        int64_t count = (len + stride - 1) / stride;
+        int64_t step = stride * m_channel_count;
+
+        auto accumulate = [&](SignalStats& s, int64_t begin, int64_t end) {
+            switch (m_data_type) {
+                case DataType::Int8:
+                    s.accumulate(static_cast<const int8_t*>(data) + begin * step, end - begin, step, begin, flags);
+                    break;
+                case DataType::Int16:
+                    s.accumulate(static_cast<const int16_t*>(data) + begin * step, end - begin, step, begin, flags);
+                    break;
+                case DataType::Int32:
+                    s.accumulate(static_cast<const int32_t*>(data) + begin * step, end - begin, step, begin, flags);
+                    break;
+                case DataType::Float:
+                    s.accumulate(static_cast<const float*>(data) + begin * step, end - begin, step, begin, flags);
+                    break;
+                case DataType::Double:
+                    s.accumulate(static_cast<const double*>(data) + begin * step, end - begin, step, begin, flags);
+                    break;
+                default:
+                    break;
+            }
+        };
 
         switch (m_data_type) {
             case DataType::Int8:
-                forEachSampleOfType(m_data_type, _absMaxFunc<int8_t>, info, channel, offs, len, stride);
-                break;
             case DataType::Int16:
-                forEachSampleOfType(m_data_type, _absMaxFunc<int16_t>, info, channel, offs, len, stride);
-                break;
             case DataType::Int32:
-                forEachSampleOfType(m_data_type, _absMaxFunc<int32_t>, info, channel, offs, len, stride);
-                break;
             case DataType::Float:
-                forEachSampleOfType(m_data_type, _absMaxFunc<float>, info, channel, offs, len, stride);
-                break;
             case DataType::Double:
-                forEachSampleOfType(m_data_type, _absMaxFunc<double>, info, channel, offs, len, stride);
                 break;
             default:
-                break;
+                return ErrorCode::UnsupportedDataType;
         }
 
-        return info.m_value.f64;
-    }
+        auto result = ErrorCode::None;
 
-    double Signal::absMax() const noexcept {
-        double max = 0.0;
+        try {
+            if (thread_count <= 0) {
+                thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+            }
+            thread_count = static_cast<int32_t>(std::clamp<int64_t>(count / kMinSamplesPerStatsThread, 1, thread_count));
 
-        for (int32_t channel = 0; channel < m_channel_count; channel++) {
-            double channel_max = absMax(channel, 0, -1, 1);
-            if (channel_max > max) {
-                max = channel_max;
+            if (thread_count == 1) {
+                accumulate(out_stats, 0, count);
             }
+            else {
+                std::vector<SignalStats> part_stats(thread_count);
+                std::vector<std::thread> threads;
+                try {
+                    threads.reserve(thread_count);
+                    for (int32_t i = 0; i < thread_count; i++) {
+                        int64_t begin = count * i / thread_count;
+                        int64_t end = count * (i + 1) / thread_count;
+                        threads.emplace_back(accumulate, std::ref(part_stats[i]), begin, end);
+                    }
+                }
+                catch (...) {
+                    // The started threads must finish before `part_stats`
+                    // goes away
+                    for (auto& thread : threads) {
+                        thread.join();
+                    }
+                    throw;
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+                for (auto& part : part_stats) {
+                    out_stats.merge(part, true);
+                }
+            }
+
+            out_stats.mapIndices(offs, stride);
+        }
+        catch (const std::exception&) {
+            out_stats.reset();
+            result = ErrorCode::StdCppException;
         }
 
-        return max;
+        return result;
     }
 
 
-    template <typename T>
-    void Signal::_averageFunc(SignalSampleFuncInfo& info) {
-        auto v = static_cast<double>(*reinterpret_cast<T*>(info.m_sample_ptr.raw));
-        info.m_value.f64 += v;
+    /**
+     *  @brief Statistics of the samples in a region, in the channel of the
+     *         region or in all channels.
+     */
+    ErrorCode Signal::stats(const SignalRegion* region, SignalStats& out_stats, uint32_t flags, int32_t thread_count) const noexcept {
+        if (!region) {
+            out_stats.reset();
+            return ErrorCode::NullData;
+        }
+
+        return stats(region->channel(), region->left(), region->len(), out_stats, flags, 1, thread_count);
     }
 
 
-    double Signal::average(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
-        SignalSampleFuncInfo info{};
-        info.m_value.f64 = 0.0;
+    /**
+     *  @brief Histogram of the sample values in a range.
+     *
+     *  @param channel The channel index.
+     *  @param offs The starting sample index.
+     *  @param len Number of samples, -1 for the rest of the signal.
+     *  @param min_value, max_value The range of values covered by the bins, in
+     *                              units of the sample data type. Values
+     *                              outside are counted in the first or last
+     *                              bin.
+     *  @param bin_count Number of bins.
+     *  @param out_bins Receives the number of samples in each bin.
+     *  @param thread_count Maximum number of threads, 0 for one thread per
+     *                      hardware thread.
+     */
+    ErrorCode Signal::histogram(
+            int32_t channel,
+            int64_t offs,
+            int64_t len,
+            double min_value,
+            double max_value,
+            int32_t bin_count,
+            std::vector<int64_t>& out_bins,
+            int32_t thread_count) const noexcept
+    {
+        auto result = ErrorCode::None;
 
-        switch (m_data_type) {
-            case DataType::Int8:
-                forEachSampleOfType(m_data_type, _averageFunc<int8_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Int16:
-                forEachSampleOfType(m_data_type, _averageFunc<int16_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Int32:
-                forEachSampleOfType(m_data_type, _averageFunc<int32_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Float:
-                forEachSampleOfType(m_data_type, _averageFunc<float>, info, channel, offs, len, stride);
-                break;
-            case DataType::Double:
-                forEachSampleOfType(m_data_type, _averageFunc<double>, info, channel, offs, len, stride);
-                break;
-            default:
-                break;
+        try {
+            out_bins.assign(std::max(bin_count, 0), 0);
+
+            if (bin_count < 1 || !(max_value > min_value)) {
+                throw ErrorCode::BadArgs;
+            }
+            if (!hasData()) {
+                throw ErrorCode::NoData;
+            }
+            if (!hasChannel(channel)) {
+                throw ErrorCode::InvalidChannel;
+            }
+            if (len < 0) {
+                len = m_sample_count;
+            }
+            if (clampOffsAndLen(offs, len) < 1) {
+                throw ErrorCode::RegionOutOfRange;
+            }
+            if (m_data_type != DataType::Int8 && m_data_type != DataType::Int16 && m_data_type != DataType::Int32 &&
+                m_data_type != DataType::Float && m_data_type != DataType::Double) {
+                throw ErrorCode::UnsupportedDataType;
+            }
+
+            const void* data = dataPtr(channel, offs);
+            if (!data) {
+                throw ErrorCode::UnexpectedRuntimeError;
+            }
+
+            int64_t step = m_channel_count;
+
+            auto add = [&](int64_t* bins, int64_t begin, int64_t end) {
+                switch (m_data_type) {
+                    case DataType::Int8:
+                        SignalStats::histogram(static_cast<const int8_t*>(data) + begin * step, end - begin, step, min_value, max_value, bin_count, bins);
+                        break;
+                    case DataType::Int16:
+                        SignalStats::histogram(static_cast<const int16_t*>(data) + begin * step, end - begin, step, min_value, max_value, bin_count, bins);
+                        break;
+                    case DataType::Int32:
+                        SignalStats::histogram(static_cast<const int32_t*>(data) + begin * step, end - begin, step, min_value, max_value, bin_count, bins);
+                        break;
+                    case DataType::Float:
+                        SignalStats::histogram(static_cast<const float*>(data) + begin * step, end - begin, step, min_value, max_value, bin_count, bins);
+                        break;
+                    case DataType::Double:
+                        SignalStats::histogram(static_cast<const double*>(data) + begin * step, end - begin, step, min_value, max_value, bin_count, bins);
+                        break;
+                    default:
+                        break;
+                }
+            };
+
+            if (thread_count <= 0) {
+                thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+            }
+            thread_count = static_cast<int32_t>(std::clamp<int64_t>(len / kMinSamplesPerStatsThread, 1, thread_count));
+
+            if (thread_count == 1) {
+                add(out_bins.data(), 0, len);
+            }
+            else {
+                std::vector<int64_t> part_bins(static_cast<size_t>(thread_count) * bin_count, 0);
+                std::vector<std::thread> threads;
+                try {
+                    threads.reserve(thread_count);
+                    for (int32_t i = 0; i < thread_count; i++) {
+                        int64_t begin = len * i / thread_count;
+                        int64_t end = len * (i + 1) / thread_count;
+                        threads.emplace_back(add, part_bins.data() + static_cast<size_t>(i) * bin_count, begin, end);
+                    }
+                }
+                catch (...) {
+                    // The started threads must finish before `part_bins`
+                    // goes away
+                    for (auto& thread : threads) {
+                        thread.join();
+                    }
+                    throw;
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+                for (int32_t i = 0; i < thread_count; i++) {
+                    const int64_t* bins = part_bins.data() + static_cast<size_t>(i) * bin_count;
+                    for (int32_t bin = 0; bin < bin_count; bin++) {
+                        out_bins[bin] += bins[bin];
+                    }
+                }
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
         }
 
-        return info.m_value.f64 / static_cast<double>(info.m_processed_n);
+        return result;
     }
 
 
-    template <typename T>
-    void Signal::_absAverageFunc(SignalSampleFuncInfo& info) {
-        auto v = static_cast<double>(*reinterpret_cast<T*>(info.m_sample_ptr.raw));
-        if (v < 0.0) { v = -v; }
-        info.m_value.f64 += v;
+    double Signal::absMax(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
+        SignalStats stats;
+        this->stats(channel, offs, len, stats, SignalStats::kMinMax, stride);
+        return stats.absMax();
     }
 
+    double Signal::absMax() const noexcept {
+        SignalStats stats;
+        this->stats(-1, 0, -1, stats, SignalStats::kMinMax);
+        return stats.absMax();
+    }
 
-    double Signal::absAverage(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
-        SignalSampleFuncInfo info{};
-        info.m_value.f64 = 0.0;
-
-        switch (m_data_type) {
-            case DataType::Int8:
-                forEachSampleOfType(m_data_type, _absAverageFunc<int8_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Int16:
-                forEachSampleOfType(m_data_type, _absAverageFunc<int16_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Int32:
-                forEachSampleOfType(m_data_type, _absAverageFunc<int32_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Float:
-                forEachSampleOfType(m_data_type, _absAverageFunc<float>, info, channel, offs, len, stride);
-                break;
-            case DataType::Double:
-                forEachSampleOfType(m_data_type, _absAverageFunc<double>, info, channel, offs, len, stride);
-                break;
-            default:
-                break;
-        }
 
-        return info.m_value.f64 / static_cast<double>(info.m_processed_n);
+    double Signal::average(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
+        SignalStats stats;
+        this->stats(channel, offs, len, stats, SignalStats::kSum, stride);
+        return stats.average();
     }
 
 
-    template <typename T>
-    void Signal::_rmsFunc(SignalSampleFuncInfo& info) {
-        auto v = static_cast<double>(*reinterpret_cast<T*>(info.m_sample_ptr.raw));
-        info.m_value.f64 += v * v; // Accumulate square
+    double Signal::absAverage(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
+        SignalStats stats;
+        this->stats(channel, offs, len, stats, SignalStats::kAbsSum, stride);
+        return stats.absAverage();
     }
 
 
     double Signal::rms(int32_t channel, int64_t offs, int64_t len, int64_t stride) const noexcept {
-        SignalSampleFuncInfo info{};
-        info.m_value.f64 = 0.0;
+        SignalStats stats;
+        this->stats(channel, offs, len, stats, SignalStats::kSquareSum, stride);
+        return stats.rms();
+    }
+
+
+    int64_t Signal::zeroCrossings(int32_t channel, int64_t offs, int64_t len) const noexcept {
+        SignalStats stats;
+        this->stats(channel, offs, len, stats, SignalStats::kZeroCrossings);
+        return stats.zeroCrossings();
+    }
+
 
+    /**
+     *  @brief The sample value which corresponds to 1.0 in float data, e.g.
+     *         32768 for Int16 data.
+     */
+    double Signal::fullScaleValue() const noexcept {
         switch (m_data_type) {
-            case DataType::Int8:
-                forEachSampleOfType(m_data_type, _rmsFunc<int8_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Int16:
-                forEachSampleOfType(m_data_type, _rmsFunc<int16_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Int32:
-                forEachSampleOfType(m_data_type, _rmsFunc<int32_t>, info, channel, offs, len, stride);
-                break;
-            case DataType::Float:
-                forEachSampleOfType(m_data_type, _rmsFunc<float>, info, channel, offs, len, stride);
-                break;
-            case DataType::Double:
-                forEachSampleOfType(m_data_type, _rmsFunc<double>, info, channel, offs, len, stride);
-                break;
-            default:
-                return 0.0;
+            case DataType::Int8: return 128.0;
+            case DataType::Int16: return 32768.0;
+            case DataType::Int32: return 2147483648.0;
+            default: return 1.0;
         }
-
-        if (info.m_processed_n < 1) return 0.0;
-        return std::sqrt(info.m_value.f64 / static_cast<double>(info.m_processed_n));
     }
 
 
@@ -2536,7 +2745,50 @@ namespace Grain {
     }
 
 
-    ErrorCode Signal::resample(int32_t channel, int32_t sample_rate, int64_t offs, int64_t len, float* out_ptr, int64_t step) noexcept {
+    /**
+     *  @brief Number of samples, which `resample()` produces for `len` samples
+     *         at `sample_rate`.
+     *
+     *  This is `ceil(len * sample_rate / source sample rate)`, or 0 if the
+     *  arguments are invalid or the result does not fit into `int64_t`.
+     */
+    int64_t Signal::resampledLength(int32_t sample_rate, int64_t len) const noexcept {
+        if (sample_rate < 1 || m_sample_rate < 1 || len <= 0) {
+            return 0;
+        }
+
+        // Reduced ratio, so the remainder product below stays in 64 bits
+        int32_t gcd = std::gcd(m_sample_rate, sample_rate);
+        int64_t l = sample_rate / gcd;
+        int64_t m = m_sample_rate / gcd;
+
+        int64_t q = len / m;
+        int64_t r = len % m;
+        if (q > (std::numeric_limits<int64_t>::max() - l) / l) {
+            return 0;
+        }
+
+        return q * l + (r * l + m - 1) / m;
+    }
+
+
+    /**
+     *  @brief Resamples a range of a channel to another sample rate.
+     *
+     *  Uses a band-limited polyphase resampler, see `Resampler`. Samples
+     *  outside the range are treated as zero.
+     *
+     *  @param channel The channel to read from.
+     *  @param sample_rate The sample rate of the output.
+     *  @param offs Index of the first sample in the range.
+     *  @param len Number of samples in the range.
+     *  @param out_ptr Destination, must have room for
+     *                 `resampledLength(sample_rate, len)` samples at a distance
+     *                 of `step`.
+     *  @param step Distance between output samples.
+     *  @param quality Quality preset of the resampler.
+     */
+    ErrorCode Signal::resample(int32_t channel, int32_t sample_rate, int64_t offs, int64_t len, float* out_ptr, int64_t step, Resampler::Quality quality) noexcept {
         if (!hasChannel(channel)) {
             return ErrorCode::InvalidChannel;
         }
@@ -2569,17 +2821,15 @@ namespace Grain {
             return ErrorCode::UnsupportedStepSize;
         }
 
-        double pos_step = static_cast<double>(sampleRate()) / sample_rate;
-        HiResValue pos(static_cast<int64_t>(step * offs));
-        pos.setStep(pos_step);
-
-        while(pos.pos() < lastSampleIndex()) {
-            *out_ptr = readFloatLerp(channel, pos);
-            out_ptr += step;
-            pos.stepForward();
+        Resampler resampler;
+        auto result = resampler.configure(m_sample_rate, sample_rate, quality);
+        if (result != ErrorCode::None) {
+            return result;
         }
 
-        return ErrorCode::None;
+        return resampler.resample(
+                m_data.f32 + offs * m_channel_count + channel, len, m_channel_count,
+                out_ptr, resampledLength(sample_rate, len), step);
     }
 
 
@@ -2587,11 +2837,16 @@ namespace Grain {
      *  @brief Changes the sample rate of the audio processing.
      *
      *  This function is used to modify the sample rate of the signal. It involves resampling of the sample data.
+     *  The channels are resampled in parallel with a band-limited polyphase resampler, see `Resampler`.
+     *
+     *  @param sample_rate The new sample rate.
+     *  @param quality Quality preset of the resampler.
      *
      *  @return Returns ErrorCode::None if the sample rate change is successful, or an appropriate error code if any error occurs during the process.
      */
-    ErrorCode Signal::changeSampleRate(int32_t sample_rate) noexcept {
+    ErrorCode Signal::changeSampleRate(int32_t sample_rate, Resampler::Quality quality) noexcept {
         auto result = ErrorCode::None;
+        Signal* signal = nullptr;
 
         try {
 
@@ -2608,38 +2863,60 @@ namespace Grain {
             }
 
             if (m_sample_rate != sample_rate) {
-                int64_t sample_count = static_cast<double>(m_sample_count) / m_sample_rate * sample_rate;
+                Resampler resampler;
+                auto err = resampler.configure(m_sample_rate, sample_rate, quality);
+                if (err != ErrorCode::None) {
+                    throw err;
+                }
+
+                int64_t sample_count = resampler.outputLength(m_sample_count);
                 if (sample_count > 1) {
-                    auto signal = new (std::nothrow) Signal(m_channel_count, sample_rate, sample_count, DataType::Float, sample_rate < m_sample_rate);
-                    if (!signal) {
+                    signal = new (std::nothrow) Signal(m_channel_count, sample_rate, sample_count, DataType::Float, m_weights_mode);
+                    if (!signal || !signal->hasData()) {
                         throw ErrorCode::MemCantAllocate;
                     }
 
-                    for (int32_t channel = 0; channel < m_channel_count; channel++) {
-                        HiResValue pos;
-
-                        if (sample_rate > m_sample_rate) {
-
-                            pos.setStep(static_cast<double>(m_sample_rate) / sample_rate);
-
-                            for (int64_t i = 0; i < sample_count; i++) {
-                                float value = readFloatLerp(channel, pos);
-                                signal->writeFloat(channel, i, value);
-                                pos.stepForward();
+                    // One thread per channel, channels are interleaved, so
+                    // every thread reads and writes with a stride
+                    auto thread_count = static_cast<int32_t>(std::thread::hardware_concurrency());
+                    thread_count = std::clamp<int32_t>(thread_count, 1, m_channel_count);
+
+                    std::vector<ErrorCode> errors(m_channel_count, ErrorCode::None);
+                    auto resample_channels = [&](int32_t first_channel) {
+                        for (int32_t channel = first_channel; channel < m_channel_count; channel += thread_count) {
+                            errors[channel] = resampler.resample(
+                                    m_data.f32 + channel, m_sample_count, m_channel_count,
+                                    signal->m_data.f32 + channel, sample_count, m_channel_count);
+                        }
+                    };
+
+                    if (thread_count > 1) {
+                        std::vector<std::thread> threads;
+                        try {
+                            threads.reserve(thread_count);
+                            for (int32_t t = 0; t < thread_count; t++) {
+                                threads.emplace_back(resample_channels, t);
                             }
                         }
-                        else {
-
-                            signal->clearWeights();
-                            pos.setStep(static_cast<double>(sample_rate) / m_sample_rate);
-
-                            for (int64_t i = 0; i < m_sample_count; i++) {
-                                float value = readFloat(channel, i);
-                                signal->addWeightedSample(channel, pos, value);
-                                pos.stepForward();
+                        catch (...) {
+                            // The started threads must finish before `errors`
+                            // and `signal` go away
+                            for (auto& thread : threads) {
+                                thread.join();
                             }
+                            throw;
+                        }
+                        for (auto& thread : threads) {
+                            thread.join();
+                        }
+                    }
+                    else {
+                        resample_channels(0);
+                    }
 
-                            signal->finishWeightedSamples(channel);
+                    for (auto channel_err : errors) {
+                        if (channel_err != ErrorCode::None) {
+                            throw channel_err;
                         }
                     }
 
@@ -2650,6 +2927,7 @@ namespace Grain {
                     if (m_weights_mode) {
                         std::free(m_weights);
                         m_weights = signal->m_weights;
+                        m_weights_size = signal->m_weights_size;
                         signal->m_weights = nullptr;
                     }
 
@@ -2657,14 +2935,17 @@ namespace Grain {
                     m_sample_count = signal->m_sample_count;
                     m_last_sample_index = signal->m_last_sample_index;
                     m_data_byte_size = signal->m_data_byte_size;
-
-                    delete signal;
                 }
             }
         }
         catch (ErrorCode err) {
             result = err;
         }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
+        }
+
+        delete signal;
 
         return result;
     }
@@ -2748,9 +3029,24 @@ namespace Grain {
             auto s = reinterpret_cast<float*>(mutDataPtr(channel, offs));
             int64_t s_step = sampleStep();
 
-            for (int64_t i = 0; i < len; i++) {
-                *s = filter->process(*s);
-                s += s_step;
+            if (s_step == 1) {
+                filter->processBlock(s, s, len);
+            }
+            else {
+                // Interleaved channels, gather and scatter in blocks
+                float block[SignalFilter::kBlockSize];
+                while (len > 0) {
+                    auto n = std::min<int64_t>(len, SignalFilter::kBlockSize);
+                    for (int64_t i = 0; i < n; i++) {
+                        block[i] = s[i * s_step];
+                    }
+                    filter->processBlock(block, block, n);
+                    for (int64_t i = 0; i < n; i++) {
+                        s[i * s_step] = block[i];
+                    }
+                    s += n * s_step;
+                    len -= n;
+                }
             }
         }
 
@@ -3291,21 +3587,33 @@ ErrorCode Signal::convolveChannel(
 
         int64_t n = len;
         if (isFloatType()) {
+            // Noise is generated in blocks, which is much faster than per sample
+            constexpr int64_t kBlockSize = 256;
+            float noise[kBlockSize];
+            float gate[kBlockSize];
+            auto& engine = RandomEngine::threadEngine();
+
             auto s = reinterpret_cast<float*>(mutDataPtr(channel, offs));
             int64_t s_step = sampleStep();
-            if (threshold < 1.0f) {
-                while (n--) {
-                    if (Random::next() > threshold) {
-                        *s += Random::nextBipolar() * amount;
+            while (n > 0) {
+                int64_t block_n = std::min(n, kBlockSize);
+                engine.fillBipolar(noise, block_n, amount);
+                if (threshold < 1.0f) {
+                    engine.fillUniform(gate, block_n);
+                    for (int64_t i = 0; i < block_n; i++) {
+                        if (gate[i] > threshold) {
+                            *s += noise[i];
+                        }
+                        s += s_step;
                     }
-                    s += s_step;
                 }
-            }
-            else {
-                while (n--) {
-                    *s += Random::nextBipolar() * amount;
-                    s += s_step;
+                else {
+                    for (int64_t i = 0; i < block_n; i++) {
+                        *s += noise[i];
+                        s += s_step;
+                    }
                 }
+                n -= block_n;
             }
         }
         else {
@@ -3406,24 +3714,24 @@ ErrorCode Signal::convolveChannel(
     }
 
 
-    ErrorCode Signal::writeToFile(
-            const String &file_path,
+    /**
+     *  @brief Determines the libsndfile format for writing samples of type
+     *         `data_type` with the given container format and encoding.
+     *
+     *  @param container_format The file container format.
+     *  @param sample_encoding The sample encoding, `Original` uses the encoding
+     *                         matching `data_type`.
+     *  @param data_type The data type of the samples to write.
+     *  @param out_format Receives the libsndfile format.
+     */
+    ErrorCode Signal::sndFileFormat(
             FileContainerFormat container_format,
             FileSampleEncoding sample_encoding,
-            int64_t offs,
-            int64_t len)
-            const noexcept
+            DataType data_type,
+            int32_t& out_format) noexcept
     {
-        if (clampOffsAndLen(offs, len) < 1) {
-            return Error::specific(kErr_NothingToWrite);
-        }
-
-        SF_INFO sfinfo;
-        sfinfo.samplerate = m_sample_rate;
-        sfinfo.channels = m_channel_count;
-
         int sf_encoding = 0;
-        switch (m_data_type) {
+        switch (data_type) {
             case DataType::Int16: sf_encoding = SF_FORMAT_PCM_16; break;
             case DataType::Int32: sf_encoding = SF_FORMAT_PCM_32; break;
             case DataType::Float: sf_encoding = SF_FORMAT_FLOAT;  break;
@@ -3455,7 +3763,34 @@ ErrorCode Signal::convolveChannel(
                 return Error::specific(kErr_UnsupportedContainerFormat);
         }
 
-        sfinfo.format = sf_container_format | sf_encoding;
+        out_format = sf_container_format | sf_encoding;
+
+        return ErrorCode::None;
+    }
+
+
+    ErrorCode Signal::writeToFile(
+            const String &file_path,
+            FileContainerFormat container_format,
+            FileSampleEncoding sample_encoding,
+            int64_t offs,
+            int64_t len)
+            const noexcept
+    {
+        if (clampOffsAndLen(offs, len) < 1) {
+            return Error::specific(kErr_NothingToWrite);
+        }
+
+        int32_t sf_format = 0;
+        auto result = sndFileFormat(container_format, sample_encoding, m_data_type, sf_format);
+        if (result != ErrorCode::None) {
+            return result;
+        }
+
+        SF_INFO sfinfo;
+        sfinfo.samplerate = m_sample_rate;
+        sfinfo.channels = m_channel_count;
+        sfinfo.format = sf_format;
         if (!sf_format_check(&sfinfo)) {
             return Error::specific(kErr_InvalidWriteSetting);
         }
@@ -101,4 +101,47 @@ namespace Grain {
     }
 
 
+    void SignalAllPassFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+
+        // Same types and expressions as in `process()`, so that the results
+        // are bit-identical
+        const int32_t stage_count = m_stage_count;
+        const double coef = _m_coef;
+        const double feedback_gain = _m_feedback_gain;
+        const bool feedback_enabled = _m_feedback_enabled;
+        const bool inverted = m_inverted;
+
+        double lx[kMaxStageCount], ly[kMaxStageCount];
+        for (int32_t i = 0; i < kMaxStageCount; i++) {
+            lx[i] = _m_lx[i];
+            ly[i] = _m_ly[i];
+        }
+
+        for (int64_t j = 0; j < n; j++) {
+            float input = in[j];
+            float value = input;
+
+            if (feedback_enabled) {
+                value += feedback_gain * ly[stage_count - 1];
+            }
+
+            for (int32_t i = 1; i < stage_count; ++i) {
+                float x = value;
+                float y = coef * (ly[i] + x) - lx[i];
+                lx[i] = x;
+                ly[i] = y;
+                value = y;
+            }
+
+            float output = inverted ? input - value : input + value;
+            out[j] = std::isnan(output) ? 0.0f : output;
+        }
+
+        for (int32_t i = 0; i < kMaxStageCount; i++) {
+            _m_lx[i] = lx[i];
+            _m_ly[i] = ly[i];
+        }
+    }
+
+
 } // End of namespace Grain
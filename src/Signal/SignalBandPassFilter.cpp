@@ -81,6 +81,7 @@ namespace Grain {
     void SignalBandPassFilter::reset() noexcept {
 
         _m_x1 = _m_x2 = _m_y1 = _m_y2 = 0.0;
+        memset(_m_lane_state, 0, sizeof(_m_lane_state));
     }
 
 
@@ -110,4 +111,104 @@ namespace Grain {
     }
 
 
+    void SignalBandPassFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+
+        const double a1 = _m_a1;
+        const double b1 = _m_b1;
+        const double b2 = _m_b2;
+        const bool inverted = m_inverted;
+
+        double x1 = _m_x1, x2 = _m_x2, y1 = _m_y1, y2 = _m_y2;
+
+        for (int64_t i = 0; i < n; i++) {
+            float x = in[i];
+            double temp = (a1 * x) - (a1 * x2) - (b1 * y1) - (b2 * y2);
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = temp;
+            auto y = static_cast<float>(temp);
+            out[i] = inverted ? x - y : y;
+        }
+
+        _m_x1 = x1;
+        _m_x2 = x2;
+        _m_y1 = y1;
+        _m_y2 = y2;
+    }
+
+
+    /**
+     *  @brief Filter up to `kMaxLaneCount` interleaved channels at once.
+     *
+     *  All channels share the filter settings but have independent states,
+     *  which are separate from the state used by `process()` and
+     *  `processBlock()`. Each channel gives the same result as
+     *  `processBlock()` on a filter of its own.
+     *
+     *  @param in Interleaved input frames.
+     *  @param out Interleaved output frames, may be the same as `in`.
+     *  @param frame_count Number of frames.
+     *  @param channel_count Number of channels per frame, 1 to `kMaxLaneCount`.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode SignalBandPassFilter::processInterleaved(const float* in, float* out, int64_t frame_count, int32_t channel_count) noexcept {
+
+        if (!in || !out) {
+            return ErrorCode::NullPointer;
+        }
+
+        if (channel_count < 1 || channel_count > kMaxLaneCount) {
+            return ErrorCode::BadArgs;
+        }
+
+        const double a1 = _m_a1;
+        const double b1 = _m_b1;
+        const double b2 = _m_b2;
+        const bool inverted = m_inverted;
+
+        double x1[kMaxLaneCount], x2[kMaxLaneCount], y1[kMaxLaneCount], y2[kMaxLaneCount];
+        for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+            x1[lane] = _m_lane_state[0][lane];
+            x2[lane] = _m_lane_state[1][lane];
+            y1[lane] = _m_lane_state[2][lane];
+            y2[lane] = _m_lane_state[3][lane];
+        }
+
+        float x[kMaxLaneCount]{};
+        float y[kMaxLaneCount];
+
+        for (int64_t i = 0; i < frame_count; i++) {
+            const float* src = in + i * channel_count;
+            for (int32_t lane = 0; lane < channel_count; lane++) {
+                x[lane] = src[lane];
+            }
+
+            for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+                double temp = (a1 * x[lane]) - (a1 * x2[lane]) - (b1 * y1[lane]) - (b2 * y2[lane]);
+                x2[lane] = x1[lane];
+                x1[lane] = x[lane];
+                y2[lane] = y1[lane];
+                y1[lane] = temp;
+                auto v = static_cast<float>(temp);
+                y[lane] = inverted ? x[lane] - v : v;
+            }
+
+            float* dst = out + i * channel_count;
+            for (int32_t lane = 0; lane < channel_count; lane++) {
+                dst[lane] = y[lane];
+            }
+        }
+
+        for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+            _m_lane_state[0][lane] = x1[lane];
+            _m_lane_state[1][lane] = x2[lane];
+            _m_lane_state[2][lane] = y1[lane];
+            _m_lane_state[3][lane] = y2[lane];
+        }
+
+        return ErrorCode::None;
+    }
+
+
 } // End of namespace Grain
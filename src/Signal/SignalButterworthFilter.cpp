@@ -140,6 +140,12 @@ namespace Grain {
         m_w[2] = 0.0;
         m_w[3] = 0.0;
         m_w[4] = 0.0;
+
+        for (int32_t i = 0; i < 5; i++) {
+            for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+                m_lane_w[i][lane] = 0.0;
+            }
+        }
     }
 
 
@@ -192,4 +198,163 @@ namespace Grain {
         }
     }
 
+
+    void SignalButterworthFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+        const double a = m_a;
+        const double d1 = m_d1;
+        const double d2 = m_d2;
+        const double d3 = m_d3;
+        const double d4 = m_d4;
+        const double r = m_r;
+        const double s = m_s;
+        const bool inverted = m_inverted;
+
+        double w0 = m_w[0];
+        double w1 = m_w[1];
+        double w2 = m_w[2];
+        double w3 = m_w[3];
+        double w4 = m_w[4];
+
+        switch (m_filter_type) {
+            case FilterType::LowPass:
+                for (int64_t i = 0; i < n; i++) {
+                    float x = in[i];
+                    w0 = d1 * w1 + d2 * w2 + x;
+                    auto y = static_cast<float>(a * (w0 + (w1 + w1) + w2));
+                    w2 = w1;
+                    w1 = w0;
+                    out[i] = inverted ? x - y : y;
+                }
+                break;
+
+            case FilterType::HighPass:
+                for (int64_t i = 0; i < n; i++) {
+                    float x = in[i];
+                    w0 = d1 * w1 + d2 * w2 + x;
+                    auto y = static_cast<float>(a * (w0 - (w1 + w1) + w2));
+                    w2 = w1;
+                    w1 = w0;
+                    out[i] = inverted ? x - y : y;
+                }
+                break;
+
+            case FilterType::BandPass:
+                for (int64_t i = 0; i < n; i++) {
+                    float x = in[i];
+                    w0 = d1 * w1 + d2 * w2 + d3 * w3 + d4 * w4 + x;
+                    auto y = static_cast<float>(a * (w0 - (w2 + w2) + w4));
+                    w4 = w3;
+                    w3 = w2;
+                    w2 = w1;
+                    w1 = w0;
+                    out[i] = inverted ? x - y : y;
+                }
+                break;
+
+            case FilterType::BandStop:
+                for (int64_t i = 0; i < n; i++) {
+                    float x = in[i];
+                    w0 = d1 * w1 + d2 * w2 + d3 * w3 + d4 * w4 + x;
+                    auto y = static_cast<float>(a * (w0 - r * w1 + s * w2 - r * w3 + w4));
+                    w4 = w3;
+                    w3 = w2;
+                    w2 = w1;
+                    w1 = w0;
+                    out[i] = inverted ? x - y : y;
+                }
+                break;
+        }
+
+        m_w[0] = w0;
+        m_w[1] = w1;
+        m_w[2] = w2;
+        m_w[3] = w3;
+        m_w[4] = w4;
+    }
+
+
+    /**
+     *  @brief Filter up to `kMaxLaneCount` interleaved channels at once.
+     *
+     *  All channels share the filter settings but have independent states,
+     *  which are separate from the state used by `process()` and
+     *  `processBlock()`. The channels are computed side by side in fixed size
+     *  lane arrays, so the compiler can map them to SIMD registers. Each
+     *  channel gives the same result as `processBlock()` on a filter of its
+     *  own.
+     *
+     *  @param in Interleaved input frames.
+     *  @param out Interleaved output frames, may be the same as `in`.
+     *  @param frame_count Number of frames.
+     *  @param channel_count Number of channels per frame, 1 to `kMaxLaneCount`.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode SignalButterworthFilter::processInterleaved(const float* in, float* out, int64_t frame_count, int32_t channel_count) noexcept {
+        if (!in || !out) {
+            return ErrorCode::NullPointer;
+        }
+
+        if (channel_count < 1 || channel_count > kMaxLaneCount) {
+            return ErrorCode::BadArgs;
+        }
+
+        // All types in the 4th order form, output = a * (c0*w0 + c1*w1 + c2*w2 + c3*w3 + c4*w4)
+        double d3 = m_d3;
+        double d4 = m_d4;
+        double c1 = 0.0, c2 = 0.0, c3 = 0.0, c4 = 0.0;
+        switch (m_filter_type) {
+            case FilterType::LowPass: c1 = 2.0; c2 = 1.0; d3 = d4 = 0.0; break;
+            case FilterType::HighPass: c1 = -2.0; c2 = 1.0; d3 = d4 = 0.0; break;
+            case FilterType::BandPass: c2 = -2.0; c4 = 1.0; break;
+            case FilterType::BandStop: c1 = -m_r; c2 = m_s; c3 = -m_r; c4 = 1.0; break;
+        }
+
+        const double a = m_a;
+        const double d1 = m_d1;
+        const double d2 = m_d2;
+        const bool inverted = m_inverted;
+
+        double w1[kMaxLaneCount], w2[kMaxLaneCount], w3[kMaxLaneCount], w4[kMaxLaneCount];
+        for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+            w1[lane] = m_lane_w[1][lane];
+            w2[lane] = m_lane_w[2][lane];
+            w3[lane] = m_lane_w[3][lane];
+            w4[lane] = m_lane_w[4][lane];
+        }
+
+        float x[kMaxLaneCount]{};
+        float y[kMaxLaneCount];
+
+        for (int64_t i = 0; i < frame_count; i++) {
+            const float* src = in + i * channel_count;
+            for (int32_t lane = 0; lane < channel_count; lane++) {
+                x[lane] = src[lane];
+            }
+
+            for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+                double w0 = d1 * w1[lane] + d2 * w2[lane] + d3 * w3[lane] + d4 * w4[lane] + x[lane];
+                auto v = static_cast<float>(a * (w0 + c1 * w1[lane] + c2 * w2[lane] + c3 * w3[lane] + c4 * w4[lane]));
+                y[lane] = inverted ? x[lane] - v : v;
+                w4[lane] = w3[lane];
+                w3[lane] = w2[lane];
+                w2[lane] = w1[lane];
+                w1[lane] = w0;
+            }
+
+            float* dst = out + i * channel_count;
+            for (int32_t lane = 0; lane < channel_count; lane++) {
+                dst[lane] = y[lane];
+            }
+        }
+
+        for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+            m_lane_w[1][lane] = w1[lane];
+            m_lane_w[2][lane] = w2[lane];
+            m_lane_w[3][lane] = w3[lane];
+            m_lane_w[4][lane] = w4[lane];
+        }
+
+        return ErrorCode::None;
+    }
+
 } // End of namespace Grain
@@ -0,0 +1,965 @@
+//
+//  SignalFile.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Signal/SignalFile.hpp"
+#include "Signal/SignalFilter.hpp"
+#include "DSP/EnvelopeFollower.hpp"
+#include "Math/Math.hpp"
+
+#include <sndfile.h>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Reduce the queued blocks and then the block length of a reader
+     *         or writer, so its buffers hold at most `max_buffered_frames`.
+     *
+     *  @param max_buffered_frames The limit, 0 for no limit.
+     *  @param fixed_blocks Blocks needed in any case.
+     *  @param block_len Frames per block, reduced if needed.
+     *  @param queued_blocks Blocks in addition to `fixed_blocks`, reduced first.
+     *  @return false, if the limit is too small for blocks of one frame.
+     */
+    static bool _fitBuffers(int64_t max_buffered_frames, int32_t fixed_blocks, int64_t& block_len, int32_t& queued_blocks) noexcept {
+        if (max_buffered_frames <= 0) {
+            return true;
+        }
+
+        if (max_buffered_frames < fixed_blocks) {
+            return false;
+        }
+
+        block_len = std::min(block_len, max_buffered_frames / fixed_blocks);
+        queued_blocks = static_cast<int32_t>(std::min<int64_t>(queued_blocks, max_buffered_frames / block_len - fixed_blocks));
+
+        return true;
+    }
+
+
+    void SignalBlock::configure(int32_t channel_count, int64_t capacity) {
+        channel_count_ = std::max(channel_count, 0);
+        capacity_ = std::max<int64_t>(capacity, 0);
+        frame_count_ = 0;
+        start_frame_ = 0;
+        data_.assign(static_cast<size_t>(channel_count_) * capacity_, 0.0f);
+    }
+
+
+    SignalFileReader::~SignalFileReader() noexcept {
+        close();
+    }
+
+
+    /**
+     *  @brief Opens an audio file for block-wise reading.
+     *
+     *  @param file_path Path to the file, any format supported by libsndfile.
+     *  @param block_len Number of frames per block.
+     *  @param read_ahead_blocks Number of blocks decoded in advance by a
+     *                           background thread, 0 reads synchronously in
+     *                           `nextBlock()`.
+     *  @param max_buffered_frames Maximum number of frames held in the
+     *                             buffers of the reader, 0 for no limit. The
+     *                             read-ahead is reduced first, then the block
+     *                             length. At least 2 frames are needed.
+     */
+    ErrorCode SignalFileReader::open(const String& file_path, int64_t block_len, int32_t read_ahead_blocks, int64_t max_buffered_frames) noexcept {
+        close();
+
+        auto result = ErrorCode::None;
+
+        try {
+            // Decoding buffer and the block held by the caller are always needed
+            if (block_len < 1 || read_ahead_blocks < 0 || !_fitBuffers(max_buffered_frames, 2, block_len, read_ahead_blocks)) {
+                throw ErrorCode::BadArgs;
+            }
+
+            SF_INFO sf_info;
+            sf_info.format = 0; // Required
+            file_ = sf_open(file_path.utf8(), SFM_READ, &sf_info);
+            if (!file_) {
+                throw ErrorCode::FileCantOpen;
+            }
+
+            if (sf_info.channels < 1 || sf_info.channels > Signal::kMaxChannelCount) {
+                throw ErrorCode::UnsupportedChannelCount;
+            }
+
+            channel_count_ = sf_info.channels;
+            sample_rate_ = sf_info.samplerate;
+            frame_count_ = sf_info.frames;
+            block_len_ = block_len;
+
+            interleaved_.resize(static_cast<size_t>(block_len) * channel_count_);
+            slots_.resize(read_ahead_blocks + 1);
+            for (auto& slot : slots_) {
+                slot.configure(channel_count_, block_len);
+            }
+
+            _start();
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
+        }
+
+        if (result != ErrorCode::None) {
+            close();
+        }
+
+        return result;
+    }
+
+
+    void SignalFileReader::close() noexcept {
+        _stop();
+
+        if (file_) {
+            sf_close(file_);
+            file_ = nullptr;
+        }
+
+        interleaved_.clear();
+        interleaved_.shrink_to_fit();
+        slots_.clear();
+        free_slots_.clear();
+        ready_slots_.clear();
+        current_slot_ = -1;
+    }
+
+
+    /**
+     *  @brief Restarts reading at the first frame, e.g. for a second pass.
+     */
+    ErrorCode SignalFileReader::rewind() noexcept {
+        if (!file_) {
+            return ErrorCode::FileNoHandle;
+        }
+
+        _stop();
+
+        if (sf_seek(file_, 0, SEEK_SET) < 0) {
+            return ErrorCode::FileCantSetPos;
+        }
+
+        try {
+            _start();
+        }
+        catch (const std::exception&) {
+            return ErrorCode::StdCppException;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Returns the next block of the file.
+     *
+     *  The block stays valid until the next call of `nextBlock()`, `rewind()`
+     *  or `close()`.
+     *
+     *  @return The block or nullptr at the end of the file or on an error, see
+     *          `lastError()`.
+     */
+    const SignalBlock* SignalFileReader::nextBlock() noexcept {
+        if (!file_ || slots_.empty()) {
+            return nullptr;
+        }
+
+        if (!thread_.joinable()) {
+            // Synchronous mode
+            if (end_reached_) {
+                return nullptr;
+            }
+            if (_readBlock(slots_[0]) < 1) {
+                end_reached_ = true;
+                return nullptr;
+            }
+            return &slots_[0];
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (current_slot_ >= 0) {
+            free_slots_.push_back(current_slot_);
+            current_slot_ = -1;
+            cond_.notify_all();
+        }
+
+        cond_.wait(lock, [this] { return !ready_slots_.empty() || end_reached_; });
+        if (ready_slots_.empty()) {
+            return nullptr;
+        }
+
+        current_slot_ = ready_slots_.front();
+        ready_slots_.pop_front();
+
+        return &slots_[current_slot_];
+    }
+
+
+    /**
+     *  @brief Memory used for buffering blocks in bytes.
+     */
+    size_t SignalFileReader::bufferSize() const noexcept {
+        size_t size = interleaved_.size() * sizeof(float);
+        for (auto& slot : slots_) {
+            size += slot.byteSize();
+        }
+        return size;
+    }
+
+
+    void SignalFileReader::_start() {
+        read_pos_ = 0;
+        stop_ = false;
+        end_reached_ = false;
+        error_.store(ErrorCode::None);
+        current_slot_ = -1;
+        ready_slots_.clear();
+        free_slots_.clear();
+
+        if (slots_.size() > 1) {
+            for (int32_t i = 0; i < static_cast<int32_t>(slots_.size()); i++) {
+                free_slots_.push_back(i);
+            }
+            thread_ = std::thread(&SignalFileReader::_readLoop, this);
+        }
+    }
+
+
+    void SignalFileReader::_stop() noexcept {
+        if (thread_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cond_.notify_all();
+            thread_.join();
+        }
+    }
+
+
+    void SignalFileReader::_readLoop() noexcept {
+        while (true) {
+            int32_t slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return stop_ || !free_slots_.empty(); });
+                if (stop_) {
+                    return;
+                }
+                slot = free_slots_.front();
+                free_slots_.pop_front();
+            }
+
+            int64_t n = _readBlock(slots_[slot]);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (n > 0) {
+                    ready_slots_.push_back(slot);
+                }
+                else {
+                    free_slots_.push_back(slot);
+                    end_reached_ = true;
+                }
+            }
+            cond_.notify_all();
+
+            if (n < 1) {
+                return;
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Decodes the next frames into `block`.
+     *
+     *  @return The number of frames read, 0 at the end of the file or on an
+     *          error.
+     */
+    int64_t SignalFileReader::_readBlock(SignalBlock& block) noexcept {
+        sf_count_t n = sf_readf_float(file_, interleaved_.data(), block_len_);
+        if (n < 1) {
+            if (sf_error(file_) != SF_ERR_NO_ERROR) {
+                error_.store(ErrorCode::FileCantRead);
+            }
+            block.setFrameCount(0);
+            return 0;
+        }
+
+        const float* s = interleaved_.data();
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            const float* src = s + channel;
+            float* dst = block.mutChannelPtr(channel);
+            for (sf_count_t i = 0; i < n; i++) {
+                dst[i] = *src;
+                src += channel_count_;
+            }
+        }
+
+        block.setFrameCount(n);
+        block.setStartFrame(read_pos_);
+        read_pos_ += n;
+
+        return n;
+    }
+
+
+    SignalFileWriter::~SignalFileWriter() noexcept {
+        close();
+    }
+
+
+    /**
+     *  @brief Creates an audio file for block-wise writing.
+     *
+     *  @param file_path Path to the file.
+     *  @param container_format The file container format.
+     *  @param sample_encoding The sample encoding, `Original` writes floats.
+     *  @param channel_count Number of channels.
+     *  @param sample_rate Sample rate in Hz.
+     *  @param block_len Number of frames per queued block.
+     *  @param write_behind_blocks Number of blocks, which can be queued for
+     *                             the background thread, 0 writes
+     *                             synchronously in `write()`.
+     *  @param max_buffered_frames Maximum number of frames held in the
+     *                             buffers of the writer, 0 for no limit. The
+     *                             write-behind is reduced first, then the
+     *                             block length. At least 2 frames are needed.
+     */
+    ErrorCode SignalFileWriter::open(
+            const String& file_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding,
+            int32_t channel_count,
+            int32_t sample_rate,
+            int64_t block_len,
+            int32_t write_behind_blocks,
+            int64_t max_buffered_frames) noexcept
+    {
+        close();
+
+        auto result = ErrorCode::None;
+
+        try {
+            if (block_len < 1 || write_behind_blocks < 0) {
+                throw ErrorCode::BadArgs;
+            }
+
+            // Encoding buffer and one slot are always needed
+            int32_t queued_blocks = std::max(write_behind_blocks - 1, 0);
+            if (!_fitBuffers(max_buffered_frames, 2, block_len, queued_blocks)) {
+                throw ErrorCode::BadArgs;
+            }
+            if (write_behind_blocks > 0) {
+                write_behind_blocks = queued_blocks + 1;
+            }
+
+            if (channel_count < 1 || channel_count > Signal::kMaxChannelCount) {
+                throw ErrorCode::UnsupportedChannelCount;
+            }
+
+            if (sample_rate < 1) {
+                throw ErrorCode::UnsupportedSampleRate;
+            }
+
+            int32_t sf_format = 0;
+            auto err = Signal::sndFileFormat(container_format, sample_encoding, DataType::Float, sf_format);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            SF_INFO sf_info;
+            sf_info.samplerate = sample_rate;
+            sf_info.channels = channel_count;
+            sf_info.format = sf_format;
+            if (!sf_format_check(&sf_info)) {
+                throw Error::specific(Signal::kErr_InvalidWriteSetting);
+            }
+
+            file_ = sf_open(file_path.utf8(), SFM_WRITE, &sf_info);
+            if (!file_) {
+                throw ErrorCode::FileCantOpen;
+            }
+
+            // Clip instead of wrap around, when converting to integer encodings
+            sf_command(file_, SFC_SET_CLIPPING, nullptr, SF_TRUE);
+
+            channel_count_ = channel_count;
+            sample_rate_ = sample_rate;
+            block_len_ = block_len;
+            frames_written_ = 0;
+            stop_ = false;
+            error_ = ErrorCode::None;
+
+            interleaved_.resize(static_cast<size_t>(block_len) * channel_count);
+            slots_.resize(std::max(write_behind_blocks, 1));
+            for (int32_t i = 0; i < static_cast<int32_t>(slots_.size()); i++) {
+                slots_[i].configure(channel_count, block_len);
+                free_slots_.push_back(i);
+            }
+
+            if (write_behind_blocks > 0) {
+                thread_ = std::thread(&SignalFileWriter::_writeLoop, this);
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
+        }
+
+        if (result != ErrorCode::None) {
+            close();
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Writes all queued blocks and closes the file.
+     *
+     *  @return The first error, which occurred while writing.
+     */
+    ErrorCode SignalFileWriter::close() noexcept {
+        if (thread_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cond_.notify_all();
+            thread_.join();
+        }
+
+        auto result = error_;
+
+        if (file_) {
+            if (sf_close(file_) != 0 && result == ErrorCode::None) {
+                result = ErrorCode::FileCloseFailed;
+            }
+            file_ = nullptr;
+        }
+
+        interleaved_.clear();
+        interleaved_.shrink_to_fit();
+        slots_.clear();
+        free_slots_.clear();
+        ready_slots_.clear();
+        error_ = ErrorCode::None;
+
+        return result;
+    }
+
+
+    ErrorCode SignalFileWriter::write(const SignalBlock& block) noexcept {
+        if (block.channelCount() != channel_count_) {
+            return ErrorCode::UnsupportedChannelCount;
+        }
+
+        const float* channels[Signal::kMaxChannelCount];
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            channels[channel] = block.channelPtr(channel);
+        }
+
+        return write(channels, block.frameCount());
+    }
+
+
+    /**
+     *  @brief Appends frames to the file.
+     *
+     *  @param channels One pointer per channel to `frame_count` samples.
+     *  @param frame_count Number of frames, any number is allowed.
+     */
+    ErrorCode SignalFileWriter::write(const float* const* channels, int64_t frame_count) noexcept {
+        if (!file_) {
+            return ErrorCode::FileNoHandle;
+        }
+
+        if (!channels || frame_count < 0) {
+            return ErrorCode::BadArgs;
+        }
+
+        int64_t offs = 0;
+        while (offs < frame_count) {
+            int64_t n = std::min(frame_count - offs, block_len_);
+
+            int32_t slot = 0;
+            if (thread_.joinable()) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return !free_slots_.empty() || error_ != ErrorCode::None; });
+                if (error_ != ErrorCode::None) {
+                    return error_;
+                }
+                slot = free_slots_.front();
+                free_slots_.pop_front();
+            }
+
+            auto& block = slots_[slot];
+            for (int32_t channel = 0; channel < channel_count_; channel++) {
+                std::memcpy(block.mutChannelPtr(channel), channels[channel] + offs, static_cast<size_t>(n) * sizeof(float));
+            }
+            block.setFrameCount(n);
+            block.setStartFrame(frames_written_);
+            frames_written_ += n;
+            offs += n;
+
+            if (thread_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ready_slots_.push_back(slot);
+                }
+                cond_.notify_all();
+            }
+            else {
+                auto err = _writeBlock(block);
+                if (err != ErrorCode::None) {
+                    return err;
+                }
+            }
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Memory used for buffering blocks in bytes.
+     */
+    size_t SignalFileWriter::bufferSize() const noexcept {
+        size_t size = interleaved_.size() * sizeof(float);
+        for (auto& slot : slots_) {
+            size += slot.byteSize();
+        }
+        return size;
+    }
+
+
+    void SignalFileWriter::_writeLoop() noexcept {
+        while (true) {
+            int32_t slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return stop_ || !ready_slots_.empty(); });
+                if (ready_slots_.empty()) {
+                    // Stopped and all blocks written
+                    return;
+                }
+                slot = ready_slots_.front();
+                ready_slots_.pop_front();
+            }
+
+            auto err = _writeBlock(slots_[slot]);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_slots_.push_back(slot);
+                if (err != ErrorCode::None && error_ == ErrorCode::None) {
+                    error_ = err;
+                }
+            }
+            cond_.notify_all();
+        }
+    }
+
+
+    ErrorCode SignalFileWriter::_writeBlock(const SignalBlock& block) noexcept {
+        int64_t n = block.frameCount();
+
+        float* d = interleaved_.data();
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            const float* src = block.channelPtr(channel);
+            float* dst = d + channel;
+            for (int64_t i = 0; i < n; i++) {
+                *dst = src[i];
+                dst += channel_count_;
+            }
+        }
+
+        if (sf_writef_float(file_, d, n) != n) {
+            return ErrorCode::FileCantWrite;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Share `max_buffered_frames` between reader, processing and
+     *         writer.
+     *
+     *  The processing block gets a fifth and `block_len` is reduced to it,
+     *  reader and writer get half of the rest each.
+     */
+    ErrorCode SignalFileProcessor::_splitBufferLimit(int64_t max_buffered_frames, int64_t& block_len, int64_t& out_io_max_buffered_frames) noexcept {
+        out_io_max_buffered_frames = 0;
+
+        if (max_buffered_frames <= 0) {
+            return ErrorCode::None;
+        }
+
+        if (max_buffered_frames < kMinBufferedFrames) {
+            return ErrorCode::BadArgs;
+        }
+
+        block_len = std::clamp<int64_t>(max_buffered_frames / 5, 1, block_len);
+        out_io_max_buffered_frames = (max_buffered_frames - block_len) / 2;
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Scales all channels, so the absolute peak equals `target_level`.
+     *
+     *  Reads the source twice, first to find the peak, then to write the
+     *  scaled samples. Same as `Signal::normalize()`.
+     */
+    ErrorCode SignalFileProcessor::normalize(
+            const String& src_path,
+            const String& dst_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding,
+            float target_level,
+            int64_t block_len,
+            int64_t max_buffered_frames) noexcept
+    {
+        auto result = ErrorCode::None;
+
+        try {
+            int64_t io_max_buffered_frames;
+            auto err = _splitBufferLimit(max_buffered_frames, block_len, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            SignalFileReader reader;
+            err = reader.open(src_path, block_len, SignalFileReader::kDefaultReadAheadBlocks, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            float max = 0.0f;
+            while (auto block = reader.nextBlock()) {
+                for (int32_t channel = 0; channel < block->channelCount(); channel++) {
+                    const float* s = block->channelPtr(channel);
+                    for (int64_t i = 0; i < block->frameCount(); i++) {
+                        max = std::max(max, std::fabs(s[i]));
+                    }
+                }
+            }
+            if (reader.lastError() != ErrorCode::None) {
+                throw reader.lastError();
+            }
+
+            float scale_factor = Safe::canSafelyDivideBy(max) ? target_level / max : 1.0f;
+
+            if ((err = reader.rewind()) != ErrorCode::None) {
+                throw err;
+            }
+
+            SignalFileWriter writer;
+            err = writer.open(dst_path, container_format, sample_encoding, reader.channelCount(), reader.sampleRate(), block_len, SignalFileWriter::kDefaultWriteBehindBlocks, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            SignalBlock out;
+            out.configure(reader.channelCount(), reader.blockLength());
+
+            while (auto block = reader.nextBlock()) {
+                for (int32_t channel = 0; channel < block->channelCount(); channel++) {
+                    const float* s = block->channelPtr(channel);
+                    float* d = out.mutChannelPtr(channel);
+                    for (int64_t i = 0; i < block->frameCount(); i++) {
+                        d[i] = s[i] * scale_factor;
+                    }
+                }
+                out.setFrameCount(block->frameCount());
+                if ((err = writer.write(out)) != ErrorCode::None) {
+                    throw err;
+                }
+            }
+            if (reader.lastError() != ErrorCode::None) {
+                throw reader.lastError();
+            }
+
+            if ((err = writer.close()) != ErrorCode::None) {
+                throw err;
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Filters each channel with its own filter.
+     *
+     *  @param filters One filter per channel. The filters must use the sample
+     *                 rate of the source, they are reset before processing.
+     */
+    ErrorCode SignalFileProcessor::applyFilter(
+            const String& src_path,
+            const String& dst_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding,
+            const std::vector<SignalFilter*>& filters,
+            int64_t block_len,
+            int64_t max_buffered_frames) noexcept
+    {
+        auto result = ErrorCode::None;
+
+        try {
+            int64_t io_max_buffered_frames;
+            auto err = _splitBufferLimit(max_buffered_frames, block_len, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            SignalFileReader reader;
+            err = reader.open(src_path, block_len, SignalFileReader::kDefaultReadAheadBlocks, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            if (static_cast<int32_t>(filters.size()) != reader.channelCount()) {
+                throw ErrorCode::BadArgs;
+            }
+
+            for (auto filter : filters) {
+                if (!filter) {
+                    throw ErrorCode::NullData;
+                }
+                if (!filter->isValid()) {
+                    throw ErrorCode::Unknown;
+                }
+                if (filter->sampleRate() != reader.sampleRate()) {
+                    throw ErrorCode::SampleRateMustBeEqual;
+                }
+                filter->reset();
+            }
+
+            SignalFileWriter writer;
+            err = writer.open(dst_path, container_format, sample_encoding, reader.channelCount(), reader.sampleRate(), block_len, SignalFileWriter::kDefaultWriteBehindBlocks, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            SignalBlock out;
+            out.configure(reader.channelCount(), reader.blockLength());
+
+            while (auto block = reader.nextBlock()) {
+                for (int32_t channel = 0; channel < block->channelCount(); channel++) {
+                    filters[channel]->processBlock(block->channelPtr(channel), out.mutChannelPtr(channel), block->frameCount());
+                }
+                out.setFrameCount(block->frameCount());
+                if ((err = writer.write(out)) != ErrorCode::None) {
+                    throw err;
+                }
+            }
+            if (reader.lastError() != ErrorCode::None) {
+                throw reader.lastError();
+            }
+
+            if ((err = writer.close()) != ErrorCode::None) {
+                throw err;
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Converts the file to another sample rate, see `Resampler`.
+     */
+    ErrorCode SignalFileProcessor::resample(
+            const String& src_path,
+            const String& dst_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding,
+            int32_t sample_rate,
+            Resampler::Quality quality,
+            int64_t block_len,
+            int64_t max_buffered_frames) noexcept
+    {
+        auto result = ErrorCode::None;
+
+        try {
+            if (sample_rate < 1) {
+                throw ErrorCode::UnsupportedSampleRate;
+            }
+
+            int64_t io_max_buffered_frames = 0;
+            int64_t out_block_len = block_len;
+            if (max_buffered_frames > 0) {
+                SignalInfo info{};
+                if (Signal::fileInfo(src_path, info) != 0) {
+                    throw ErrorCode::FileCantOpen;
+                }
+
+                auto err = _splitBufferLimit(max_buffered_frames, out_block_len, io_max_buffered_frames);
+                if (err != ErrorCode::None) {
+                    throw err;
+                }
+
+                // The output of one input block, see `Resampler::outputLength()`,
+                // plus one sample must fit into the processing block
+                block_len = std::clamp<int64_t>((out_block_len - 2) * info.m_sample_rate / sample_rate, 1, block_len);
+            }
+
+            SignalFileReader reader;
+            auto err = reader.open(src_path, block_len, SignalFileReader::kDefaultReadAheadBlocks, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            int32_t channel_count = reader.channelCount();
+            std::vector<Resampler> resamplers(channel_count);
+            for (auto& resampler : resamplers) {
+                if ((err = resampler.configure(reader.sampleRate(), sample_rate, quality)) != ErrorCode::None) {
+                    throw err;
+                }
+            }
+
+            SignalFileWriter writer;
+            err = writer.open(dst_path, container_format, sample_encoding, channel_count, sample_rate, out_block_len, SignalFileWriter::kDefaultWriteBehindBlocks, io_max_buffered_frames);
+            if (err != ErrorCode::None) {
+                throw err;
+            }
+
+            // All channels get the same input, so they produce the same number
+            // of output samples
+            SignalBlock out;
+            out.configure(channel_count, resamplers[0].outputLength(reader.blockLength()) + 1);
+
+            while (auto block = reader.nextBlock()) {
+                int64_t n = 0;
+                for (int32_t channel = 0; channel < channel_count; channel++) {
+                    n = resamplers[channel].process(block->channelPtr(channel), block->frameCount(), out.mutChannelPtr(channel), out.capacity());
+                    if (n < 0) {
+                        throw ErrorCode::MemCantAllocate;
+                    }
+                }
+                out.setFrameCount(n);
+                if ((err = writer.write(out)) != ErrorCode::None) {
+                    throw err;
+                }
+            }
+            if (reader.lastError() != ErrorCode::None) {
+                throw reader.lastError();
+            }
+
+            while (true) {
+                int64_t n = 0;
+                for (int32_t channel = 0; channel < channel_count; channel++) {
+                    n = resamplers[channel].flush(out.mutChannelPtr(channel), out.capacity());
+                    if (n < 0) {
+                        throw ErrorCode::MemCantAllocate;
+                    }
+                }
+                if (n < 1) {
+                    break;
+                }
+                out.setFrameCount(n);
+                if ((err = writer.write(out)) != ErrorCode::None) {
+                    throw err;
+                }
+            }
+
+            if ((err = writer.close()) != ErrorCode::None) {
+                throw err;
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Writes the amplitude envelope of each channel, see
+     *         `EnvelopeFollower`.
+     */
+    ErrorCode SignalFileProcessor::envelope(
+            const String& src_path,
+            const String& dst_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding,
+            float attack_sec,
+            float release_sec,
+            int64_t block_len,
+            int64_t max_buffered_frames) noexcept
+    {
+        SignalInfo info{};
+        if (Signal::fileInfo(src_path, info) != 0) {
+            return ErrorCode::FileCantOpen;
+        }
+
+        auto result = ErrorCode::None;
+
+        try {
+            ObjectList<EnvelopeFollower*> followers;
+            std::vector<SignalFilter*> filters;
+            for (int32_t channel = 0; channel < info.m_channel_count; channel++) {
+                auto follower = new (std::nothrow) EnvelopeFollower(info.m_sample_rate, attack_sec, release_sec);
+                if (!follower) {
+                    throw ErrorCode::ClassInstantiationFailed;
+                }
+                followers.push(follower);
+                filters.push_back(follower);
+            }
+
+            result = applyFilter(src_path, dst_path, container_format, sample_encoding, filters, block_len, max_buffered_frames);
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+} // End of namespace Grain
@@ -1,5 +1,5 @@
 //
-//  SignalFilter.hpp
+//  SignalFilter.cpp
 //
 //  Created by Roald Christesen on 16.09.2015
 //  Copyright (C) 2025 Roald Christesen. All rights reserved.
@@ -13,7 +13,12 @@
 namespace Grain {
 
 
-// ### Code here ...
+    void SignalFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+
+        for (int64_t i = 0; i < n; i++) {
+            out[i] = process(in[i]);
+        }
+    }
 
 
 } // End of namespace Grain
@@ -70,4 +70,34 @@ float SignalFormantFilter::process(float input) noexcept {
 }
 
 
+void SignalFormantFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+    float band[kBlockSize];
+    float sum[kBlockSize];
+
+    while (n > 0) {
+        auto len = std::min<int64_t>(n, kBlockSize);
+
+        for (int64_t j = 0; j < len; j++) {
+            sum[j] = 0.0f;
+        }
+
+        for (int32_t i = 0; i < kMaxFormantCount; i++) {
+            m_filter[i]->processBlock(in, band, len);
+            const double amp = m_amp[i];   // Double, as in `process()`
+            for (int64_t j = 0; j < len; j++) {
+                sum[j] += band[j] * amp;
+            }
+        }
+
+        for (int64_t j = 0; j < len; j++) {
+            out[j] = sum[j];
+        }
+
+        in += len;
+        out += len;
+        n -= len;
+    }
+}
+
+
 } // End of namespace Grain
@@ -0,0 +1,765 @@
+//
+//  SignalGraph.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Signal/SignalGraph.hpp"
+#include "Signal/SignalFilter.hpp"
+#include "DSP/FFT.hpp"
+#include "Math/Math.hpp"
+
+#include <atomic>
+#include <barrier>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+
+namespace Grain {
+
+    SignalGraphNode::SignalGraphNode(int32_t channel_count) noexcept {
+        channel_count_ = std::max(channel_count, 0);
+    }
+
+
+    void SignalGraphNode::_addInput(SignalGraphNode* node) noexcept {
+        try {
+            inputs_.push_back(node);
+        }
+        catch (const std::bad_alloc&) {
+            error_ = ErrorCode::MemCantAllocate;
+        }
+    }
+
+
+    /**
+     *  @brief Allocate the output and the input delay lines. The path latency
+     *         of the inputs must be known.
+     */
+    void SignalGraphNode::_configure(int32_t sample_rate, int32_t block_len) {
+        sample_rate_ = sample_rate;
+        block_len_ = block_len;
+        output_.assign(static_cast<size_t>(channel_count_) * block_len_, 0.0f);
+
+        int32_t input_latency = 0;
+        level_ = 0;
+        for (auto input : inputs_) {
+            input_latency = std::max(input_latency, input->path_latency_);
+            level_ = std::max(level_, input->level_ + 1);
+        }
+        path_latency_ = input_latency + latency();
+
+        input_delays_.resize(inputs_.size());
+        delay_lines_.resize(inputs_.size());
+        for (size_t i = 0; i < inputs_.size(); i++) {
+            int32_t delay = input_latency - inputs_[i]->path_latency_;
+            input_delays_[i] = delay;
+            if (delay > 0) {
+                delay_lines_[i].assign(static_cast<size_t>(inputs_[i]->channel_count_) * (delay + block_len_), 0.0f);
+            }
+            else {
+                delay_lines_[i].clear();
+            }
+        }
+    }
+
+
+    /**
+     *  @brief Delay the current block of inputs with a lower latency than the
+     *         others.
+     */
+    void SignalGraphNode::_alignInputs() noexcept {
+        for (size_t i = 0; i < inputs_.size(); i++) {
+            int32_t delay = input_delays_[i];
+            if (delay < 1) {
+                continue;
+            }
+
+            auto input = inputs_[i];
+            size_t line_len = static_cast<size_t>(delay) + block_len_;
+            for (int32_t channel = 0; channel < input->channel_count_; channel++) {
+                float* line = delay_lines_[i].data() + channel * line_len;
+                std::memmove(line, line + block_len_, sizeof(float) * delay);
+                std::memcpy(line + delay, input->outputPtr(channel), sizeof(float) * block_len_);
+            }
+        }
+    }
+
+
+    const float* SignalGraphNode::_inputChannelPtr(int32_t input_index, int32_t channel) const noexcept {
+        auto input = inputs_[input_index];
+        int32_t input_channel = channel % input->channel_count_;
+        int32_t delay = input_delays_[input_index];
+        if (delay > 0) {
+            return delay_lines_[input_index].data() + static_cast<size_t>(input_channel) * (delay + block_len_);
+        }
+        return input->outputPtr(input_channel);
+    }
+
+
+    SignalGraphSource::SignalGraphSource(const Signal* signal, Resampler::Quality quality) noexcept :
+            SignalGraphNode(signal ? signal->channelCount() : 0) {
+        signal_ = signal;
+        quality_ = quality;
+    }
+
+
+    ErrorCode SignalGraphSource::_prepare(int64_t) noexcept {
+        if (!signal_) {
+            return ErrorCode::NullData;
+        }
+
+        try {
+            resamplers_.clear();
+            read_pos_.assign(channel_count_, 0);
+            pending_len_.assign(channel_count_, 0);
+
+            if (signal_->sampleRate() != sample_rate_) {
+                for (int32_t channel = 0; channel < channel_count_; channel++) {
+                    auto resampler = new(std::nothrow) Resampler();
+                    if (!resampler || !resamplers_.push(resampler)) {
+                        delete resampler;
+                        return ErrorCode::ClassInstantiationFailed;
+                    }
+                    auto err = resampler->configure(signal_->sampleRate(), sample_rate_, quality_);
+                    if (err != ErrorCode::None) {
+                        return err;
+                    }
+                }
+
+                // One block of input gives at most this number of output samples
+                pending_capacity_ = block_len_ + static_cast<int64_t>(std::ceil(static_cast<double>(block_len_) * sample_rate_ / signal_->sampleRate())) + 2;
+                pending_.assign(static_cast<size_t>(channel_count_) * pending_capacity_, 0.0f);
+                read_buffer_.resize(block_len_);
+            }
+        }
+        catch (const std::bad_alloc&) {
+            return ErrorCode::MemCantAllocate;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    void SignalGraphSource::_process(int64_t frame) noexcept {
+        if (resamplers_.size() == 0) {
+            for (int32_t channel = 0; channel < channel_count_; channel++) {
+                _read(channel, frame, block_len_, _mutOutputPtr(channel));
+            }
+            return;
+        }
+
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            auto resampler = resamplers_[channel];
+            float* pending = pending_.data() + static_cast<size_t>(channel) * pending_capacity_;
+            int64_t& pending_len = pending_len_[channel];
+
+            while (pending_len < block_len_) {
+                _read(channel, read_pos_[channel], block_len_, read_buffer_.data());
+                read_pos_[channel] += block_len_;
+                int64_t n = resampler->process(read_buffer_.data(), block_len_, pending + pending_len, pending_capacity_ - pending_len);
+                if (n < 0) {
+                    error_ = ErrorCode::MemCantAllocate;
+                    std::fill(pending + pending_len, pending + block_len_, 0.0f);
+                    pending_len = block_len_;
+                    break;
+                }
+                pending_len += n;
+            }
+
+            std::memcpy(_mutOutputPtr(channel), pending, sizeof(float) * block_len_);
+            pending_len -= block_len_;
+            std::memmove(pending, pending + block_len_, sizeof(float) * pending_len);
+        }
+    }
+
+
+    /**
+     *  @brief Read a range of a channel as float, samples outside the signal
+     *         are zero.
+     */
+    void SignalGraphSource::_read(int32_t channel, int64_t pos, int64_t len, float* out) const noexcept {
+        int64_t start = std::max<int64_t>(pos, 0);
+        int64_t end = std::min<int64_t>(pos + len, signal_->sampleCount());
+        if (end <= start) {
+            std::fill(out, out + len, 0.0f);
+            return;
+        }
+
+        std::fill(out, out + (start - pos), 0.0f);
+        signal_->readSamplesAsFloatWithZeroPadding(channel, start, end - start, out + (start - pos));
+        std::fill(out + (end - pos), out + len, 0.0f);
+    }
+
+
+    SignalGraphFilter::SignalGraphFilter(SignalGraphNode* input, const std::vector<SignalFilter*>& filters) noexcept :
+            SignalGraphNode(static_cast<int32_t>(filters.size())) {
+        _addInput(input);
+        try {
+            filters_ = filters;
+        }
+        catch (const std::bad_alloc&) {
+            error_ = ErrorCode::MemCantAllocate;
+        }
+    }
+
+
+    ErrorCode SignalGraphFilter::_prepare(int64_t) noexcept {
+        for (auto filter : filters_) {
+            if (!filter) {
+                return ErrorCode::NullData;
+            }
+            if (!filter->isValid()) {
+                return ErrorCode::Unknown;
+            }
+            if (filter->sampleRate() != sample_rate_) {
+                return ErrorCode::SampleRateMustBeEqual;
+            }
+            filter->reset();
+        }
+        return ErrorCode::None;
+    }
+
+
+    void SignalGraphFilter::_process(int64_t) noexcept {
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            filters_[channel]->processBlock(_inputChannelPtr(0, channel), _mutOutputPtr(channel), block_len_);
+        }
+    }
+
+
+    SignalGraphGain::SignalGraphGain(SignalGraphNode* input, float gain) noexcept :
+            SignalGraphNode(input ? input->channelCount() : 0) {
+        _addInput(input);
+        try {
+            gains_.assign(channel_count_, gain);
+        }
+        catch (const std::bad_alloc&) {
+            error_ = ErrorCode::MemCantAllocate;
+        }
+    }
+
+
+    void SignalGraphGain::setChannelGain(int32_t channel, float gain) noexcept {
+        if (channel >= 0 && channel < channel_count_) {
+            gains_[channel] = gain;
+        }
+    }
+
+
+    void SignalGraphGain::_process(int64_t) noexcept {
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            const float* s = _inputChannelPtr(0, channel);
+            float* d = _mutOutputPtr(channel);
+            float gain = gains_[channel];
+            for (int32_t i = 0; i < block_len_; i++) {
+                d[i] = s[i] * gain;
+            }
+        }
+    }
+
+
+    /**
+     *  @param inputs Nodes to mix.
+     *  @param channel_count Number of output channels, 0 for the largest
+     *                       channel count of the inputs.
+     */
+    SignalGraphMixer::SignalGraphMixer(const std::vector<SignalGraphNode*>& inputs, int32_t channel_count) noexcept :
+            SignalGraphNode(channel_count) {
+        if (channel_count_ < 1) {
+            for (auto input : inputs) {
+                channel_count_ = std::max(channel_count_, input ? input->channelCount() : 0);
+            }
+        }
+
+        for (auto input : inputs) {
+            _addInput(input);
+        }
+
+        try {
+            gains_.assign(inputs.size(), 1.0f);
+        }
+        catch (const std::bad_alloc&) {
+            error_ = ErrorCode::MemCantAllocate;
+        }
+    }
+
+
+    void SignalGraphMixer::setInputGain(int32_t input_index, float gain) noexcept {
+        if (input_index >= 0 && input_index < inputCount()) {
+            gains_[input_index] = gain;
+        }
+    }
+
+
+    void SignalGraphMixer::_process(int64_t) noexcept {
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            float* d = _mutOutputPtr(channel);
+            std::fill(d, d + block_len_, 0.0f);
+            for (int32_t input_index = 0; input_index < inputCount(); input_index++) {
+                const float* s = _inputChannelPtr(input_index, channel);
+                float gain = gains_[input_index];
+                for (int32_t i = 0; i < block_len_; i++) {
+                    d[i] += s[i] * gain;
+                }
+            }
+        }
+    }
+
+
+    /**
+     *  @param input Node to convolve.
+     *  @param ir Impulse response, is not owned and must not change while
+     *            rendering.
+     *  @param ir_offs First sample of the impulse response.
+     *  @param ir_len Length of the impulse response, -1 for the rest of `ir`.
+     */
+    SignalGraphConvolver::SignalGraphConvolver(SignalGraphNode* input, const Signal* ir, int64_t ir_offs, int64_t ir_len) noexcept :
+            SignalGraphNode(input ? input->channelCount() : 0) {
+        _addInput(input);
+        ir_ = ir;
+        ir_offs_ = ir_offs;
+        ir_len_ = ir_len;
+    }
+
+
+    SignalGraphConvolver::~SignalGraphConvolver() noexcept {
+        delete fft_;
+    }
+
+
+    ErrorCode SignalGraphConvolver::_prepare(int64_t) noexcept {
+        auto result = ErrorCode::None;
+
+        try {
+            if (!ir_ || !ir_->hasData()) {
+                throw ErrorCode::NullData;
+            }
+            if (ir_->sampleRate() != sample_rate_) {
+                throw ErrorCode::SampleRateMustBeEqual;
+            }
+
+            int64_t ir_offs = ir_offs_;
+            int64_t ir_len = ir_len_ < 0 ? ir_->sampleCount() : ir_len_;
+            if (ir_->clampOffsAndLen(ir_offs, ir_len) < 1) {
+                throw ErrorCode::LenOutOfRange;
+            }
+
+            delete fft_;
+            fft_ = new(std::nothrow) FFT(Math::log2IfPowerOfTwo(block_len_) + 1);
+            if (!fft_) {
+                throw ErrorCode::ClassInstantiationFailed;
+            }
+
+            int32_t fft_len = block_len_ * 2;
+            bin_count_ = block_len_ + 1;
+            partition_count_ = static_cast<int32_t>((ir_len + block_len_ - 1) / block_len_);
+            ir_channel_count_ = ir_->channelCount();
+            head_ = 0;
+
+            size_t ir_size = static_cast<size_t>(ir_channel_count_) * partition_count_ * bin_count_;
+            size_t fdl_size = static_cast<size_t>(channel_count_) * partition_count_ * bin_count_;
+            ir_real_.assign(ir_size, 0.0f);
+            ir_imag_.assign(ir_size, 0.0f);
+            fdl_real_.assign(fdl_size, 0.0f);
+            fdl_imag_.assign(fdl_size, 0.0f);
+            frames_.assign(static_cast<size_t>(channel_count_) * fft_len, 0.0f);
+            acc_real_.assign(bin_count_, 0.0f);
+            acc_imag_.assign(bin_count_, 0.0f);
+            time_buffer_.assign(fft_len, 0.0f);
+
+            // Each partition of the impulse response, zero padded to the FFT length
+            for (int32_t ir_channel = 0; ir_channel < ir_channel_count_; ir_channel++) {
+                for (int32_t p = 0; p < partition_count_; p++) {
+                    int64_t pos = static_cast<int64_t>(p) * block_len_;
+                    int64_t n = std::min<int64_t>(block_len_, ir_len - pos);
+                    std::fill(time_buffer_.begin(), time_buffer_.end(), 0.0f);
+                    ir_->readSamplesAsFloatWithZeroPadding(ir_channel, ir_offs + pos, n, time_buffer_.data());
+
+                    size_t offs = (static_cast<size_t>(ir_channel) * partition_count_ + p) * bin_count_;
+                    auto err = fft_->forward(time_buffer_.data(), &ir_real_[offs], &ir_imag_[offs]);
+                    if (err != ErrorCode::None) {
+                        throw err;
+                    }
+                }
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        return result;
+    }
+
+
+    void SignalGraphConvolver::_process(int64_t) noexcept {
+        int32_t fft_len = block_len_ * 2;
+
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            // Overlap-save, the FFT frame holds the previous and the current block
+            float* frame_ptr = frames_.data() + static_cast<size_t>(channel) * fft_len;
+            std::memcpy(frame_ptr, frame_ptr + block_len_, sizeof(float) * block_len_);
+            std::memcpy(frame_ptr + block_len_, _inputChannelPtr(0, channel), sizeof(float) * block_len_);
+
+            size_t fdl_offs = static_cast<size_t>(channel) * partition_count_ * bin_count_;
+            float* fdl_real = &fdl_real_[fdl_offs];
+            float* fdl_imag = &fdl_imag_[fdl_offs];
+            fft_->forward(frame_ptr, fdl_real + static_cast<size_t>(head_) * bin_count_, fdl_imag + static_cast<size_t>(head_) * bin_count_);
+
+            // Partition p of the impulse response meets the input block from p blocks ago
+            size_t ir_offs = static_cast<size_t>(channel % ir_channel_count_) * partition_count_ * bin_count_;
+            std::fill(acc_real_.begin(), acc_real_.end(), 0.0f);
+            std::fill(acc_imag_.begin(), acc_imag_.end(), 0.0f);
+            float* acc_real = acc_real_.data();
+            float* acc_imag = acc_imag_.data();
+            for (int32_t p = 0; p < partition_count_; p++) {
+                int32_t x_index = head_ - p;
+                if (x_index < 0) {
+                    x_index += partition_count_;
+                }
+                const float* xr = fdl_real + static_cast<size_t>(x_index) * bin_count_;
+                const float* xi = fdl_imag + static_cast<size_t>(x_index) * bin_count_;
+                const float* hr = &ir_real_[ir_offs + static_cast<size_t>(p) * bin_count_];
+                const float* hi = &ir_imag_[ir_offs + static_cast<size_t>(p) * bin_count_];
+                for (int32_t k = 0; k < bin_count_; k++) {
+                    acc_real[k] += xr[k] * hr[k] - xi[k] * hi[k];
+                    acc_imag[k] += xr[k] * hi[k] + xi[k] * hr[k];
+                }
+            }
+
+            fft_->inverse(acc_real, acc_imag, time_buffer_.data());
+            std::memcpy(_mutOutputPtr(channel), time_buffer_.data() + block_len_, sizeof(float) * block_len_);
+        }
+
+        head_ = (head_ + 1) % partition_count_;
+    }
+
+
+    SignalGraphSink::SignalGraphSink(SignalGraphNode* input, Signal* signal, int64_t offs) noexcept :
+            SignalGraphNode(signal ? signal->channelCount() : 0) {
+        _addInput(input);
+        signal_ = signal;
+        offs_ = std::max<int64_t>(offs, 0);
+    }
+
+
+    ErrorCode SignalGraphSink::_prepare(int64_t frame_count) noexcept {
+        if (!signal_) {
+            return ErrorCode::NullData;
+        }
+        if (signal_->sampleRate() != sample_rate_) {
+            return ErrorCode::SampleRateMustBeEqual;
+        }
+
+        frame_count_ = frame_count;
+        return signal_->growIfNeeded(offs_ + frame_count);
+    }
+
+
+    void SignalGraphSink::_process(int64_t frame) noexcept {
+        // Skip the samples before the first aligned output sample
+        int64_t pos = frame - path_latency_;
+        int64_t start = std::max<int64_t>(pos, 0);
+        int64_t end = std::min<int64_t>(pos + block_len_, frame_count_);
+        if (end <= start) {
+            return;
+        }
+
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            const float* s = _inputChannelPtr(0, channel) + (start - pos);
+            if (signal_->isFloatType()) {
+                signal_->writeSamples(channel, offs_ + start, end - start, s);
+            }
+            else {
+                for (int64_t i = start; i < end; i++) {
+                    signal_->writeFloat(channel, offs_ + i, *s++);
+                }
+            }
+        }
+    }
+
+
+    SignalGraphFileSink::SignalGraphFileSink(
+            SignalGraphNode* input,
+            const String& file_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding) noexcept :
+            SignalGraphNode(input ? input->channelCount() : 0) {
+        _addInput(input);
+        file_path_ = file_path;
+        container_format_ = container_format;
+        sample_encoding_ = sample_encoding;
+    }
+
+
+    ErrorCode SignalGraphFileSink::_prepare(int64_t frame_count) noexcept {
+        try {
+            channel_ptrs_.resize(channel_count_);
+        }
+        catch (const std::bad_alloc&) {
+            return ErrorCode::MemCantAllocate;
+        }
+
+        frame_count_ = frame_count;
+        return writer_.open(file_path_, container_format_, sample_encoding_, channel_count_, sample_rate_, block_len_);
+    }
+
+
+    void SignalGraphFileSink::_process(int64_t frame) noexcept {
+        if (error_ != ErrorCode::None) {
+            return;
+        }
+
+        int64_t pos = frame - path_latency_;
+        int64_t start = std::max<int64_t>(pos, 0);
+        int64_t end = std::min<int64_t>(pos + block_len_, frame_count_);
+        if (end <= start) {
+            return;
+        }
+
+        for (int32_t channel = 0; channel < channel_count_; channel++) {
+            channel_ptrs_[channel] = _inputChannelPtr(0, channel) + (start - pos);
+        }
+        error_ = writer_.write(channel_ptrs_.data(), end - start);
+    }
+
+
+    ErrorCode SignalGraphFileSink::_finish() noexcept {
+        return writer_.close();
+    }
+
+
+    /**
+     *  @param sample_rate Sample rate of all nodes, sources with other sample
+     *                     rates are resampled.
+     *  @param block_len Number of samples processed per node and step, rounded
+     *                   up to a power of two.
+     */
+    SignalGraph::SignalGraph(int32_t sample_rate, int32_t block_len) noexcept {
+        sample_rate_ = std::max(sample_rate, 1);
+        block_len_ = 1 << std::clamp<int32_t>(Math::nextLog2(block_len), kMinLogBlockLength, kMaxLogBlockLength);
+    }
+
+
+    /**
+     *  @brief Add a node to the graph, which takes ownership.
+     *
+     *  All inputs of the node must have been added before. If the node can't
+     *  be added, it is deleted.
+     *
+     *  @return The node or nullptr.
+     */
+    SignalGraphNode* SignalGraph::addNode(SignalGraphNode* node) noexcept {
+        if (!node) {
+            return nullptr;
+        }
+
+        bool valid = !node->graph_ && node->channel_count_ > 0 && node->error_ == ErrorCode::None;
+        for (auto input : node->inputs_) {
+            if (!input || input->graph_ != this) {
+                valid = false;
+            }
+        }
+
+        if (!valid || !nodes_.push(node)) {
+            delete node;
+            return nullptr;
+        }
+
+        node->graph_ = this;
+        return node;
+    }
+
+
+    SignalGraphSource* SignalGraph::addSource(const Signal* signal, Resampler::Quality quality) noexcept {
+        return static_cast<SignalGraphSource*>(addNode(new(std::nothrow) SignalGraphSource(signal, quality)));
+    }
+
+
+    SignalGraphFilter* SignalGraph::addFilter(SignalGraphNode* input, const std::vector<SignalFilter*>& filters) noexcept {
+        return static_cast<SignalGraphFilter*>(addNode(new(std::nothrow) SignalGraphFilter(input, filters)));
+    }
+
+
+    SignalGraphGain* SignalGraph::addGain(SignalGraphNode* input, float gain) noexcept {
+        return static_cast<SignalGraphGain*>(addNode(new(std::nothrow) SignalGraphGain(input, gain)));
+    }
+
+
+    SignalGraphMixer* SignalGraph::addMixer(const std::vector<SignalGraphNode*>& inputs, int32_t channel_count) noexcept {
+        return static_cast<SignalGraphMixer*>(addNode(new(std::nothrow) SignalGraphMixer(inputs, channel_count)));
+    }
+
+
+    SignalGraphConvolver* SignalGraph::addConvolver(SignalGraphNode* input, const Signal* ir, int64_t ir_offs, int64_t ir_len) noexcept {
+        return static_cast<SignalGraphConvolver*>(addNode(new(std::nothrow) SignalGraphConvolver(input, ir, ir_offs, ir_len)));
+    }
+
+
+    SignalGraphSink* SignalGraph::addSink(SignalGraphNode* input, Signal* signal, int64_t offs) noexcept {
+        return static_cast<SignalGraphSink*>(addNode(new(std::nothrow) SignalGraphSink(input, signal, offs)));
+    }
+
+
+    SignalGraphFileSink* SignalGraph::addFileSink(
+            SignalGraphNode* input,
+            const String& file_path,
+            Signal::FileContainerFormat container_format,
+            Signal::FileSampleEncoding sample_encoding) noexcept {
+        return static_cast<SignalGraphFileSink*>(addNode(new(std::nothrow) SignalGraphFileSink(input, file_path, container_format, sample_encoding)));
+    }
+
+
+    /**
+     *  @brief Render `frame_count` samples through all nodes.
+     *
+     *  All nodes are reset first, so the graph can be rendered again, e.g.
+     *  after the signals of the sources have been replaced. Internally
+     *  `frame_count + latency()` samples are processed, so the sinks receive
+     *  `frame_count` samples aligned with the sources.
+     */
+    ErrorCode SignalGraph::render(int64_t frame_count) noexcept {
+        auto result = ErrorCode::None;
+        int32_t prepared_count = 0;
+
+        try {
+            if (frame_count < 0) {
+                throw ErrorCode::BadArgs;
+            }
+            if (nodes_.size() < 1) {
+                throw ErrorCode::NoData;
+            }
+
+            _prepare();
+            for (int32_t i = 0; i < nodeCount(); i++) {
+                auto err = nodes_[i]->_prepare(frame_count);
+                prepared_count++;
+                if (err != ErrorCode::None) {
+                    throw err;
+                }
+            }
+
+            int64_t block_count = (frame_count + latency_ + block_len_ - 1) / block_len_;
+            int32_t thread_count = _threadCount();
+
+            auto process_node = [&](SignalGraphNode* node, int64_t block) {
+                node->_alignInputs();
+                node->_process(block * block_len_);
+            };
+
+            if (thread_count < 2) {
+                for (int64_t block = 0; block < block_count; block++) {
+                    for (int32_t i = 0; i < nodeCount(); i++) {
+                        process_node(nodes_[i], block);
+                    }
+                }
+            }
+            else {
+                // All threads walk through the same sequence of blocks and
+                // levels, the nodes of a level are taken from a shared counter
+                std::atomic<int32_t> next_node{ 0 };
+                std::barrier sync(thread_count, [&next_node]() noexcept {
+                    next_node.store(0, std::memory_order_relaxed);
+                });
+
+                auto worker = [&]() noexcept {
+                    for (int64_t block = 0; block < block_count; block++) {
+                        for (auto& level : levels_) {
+                            auto n = static_cast<int32_t>(level.size());
+                            int32_t i;
+                            while ((i = next_node.fetch_add(1, std::memory_order_relaxed)) < n) {
+                                process_node(level[i], block);
+                            }
+                            sync.arrive_and_wait();
+                        }
+                    }
+                };
+
+                std::vector<std::thread> threads;
+                threads.reserve(thread_count - 1);
+                try {
+                    for (int32_t i = 1; i < thread_count; i++) {
+                        threads.emplace_back(worker);
+                    }
+                }
+                catch (const std::system_error&) {
+                    // Render with the threads started so far, the missing
+                    // participants leave the barrier, so nobody waits for them
+                    for (auto i = static_cast<int32_t>(threads.size()) + 1; i < thread_count; i++) {
+                        sync.arrive_and_drop();
+                    }
+                }
+                worker();
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+        }
+        catch (ErrorCode err) {
+            result = err;
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+        catch (const std::exception&) {
+            result = ErrorCode::StdCppException;
+        }
+
+        for (int32_t i = 0; i < prepared_count; i++) {
+            auto node = nodes_[i];
+            auto err = node->_finish();
+            if (result == ErrorCode::None) {
+                result = node->error_ != ErrorCode::None ? node->error_ : err;
+            }
+        }
+
+        return result;
+    }
+
+
+    /**
+     *  @brief Compute latencies and levels and allocate the buffers of all
+     *         nodes. Nodes are stored in a topological order, inputs are
+     *         configured before the nodes depending on them.
+     */
+    void SignalGraph::_prepare() {
+        latency_ = 0;
+        levels_.clear();
+
+        for (int32_t i = 0; i < nodeCount(); i++) {
+            auto node = nodes_[i];
+            node->error_ = ErrorCode::None;
+            node->_configure(sample_rate_, block_len_);
+            latency_ = std::max(latency_, node->path_latency_);
+
+            if (node->level_ >= static_cast<int32_t>(levels_.size())) {
+                levels_.resize(node->level_ + 1);
+            }
+            levels_[node->level_].push_back(node);
+        }
+    }
+
+
+    int32_t SignalGraph::_threadCount() const noexcept {
+        int32_t thread_count = thread_count_;
+        if (thread_count < 1) {
+            thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+        }
+
+        // More threads than nodes in the widest level would only wait
+        size_t widest = 0;
+        for (auto& level : levels_) {
+            widest = std::max(widest, level.size());
+        }
+        return std::min(thread_count, static_cast<int32_t>(widest));
+    }
+
+
+} // End of namespace Grain
@@ -104,4 +104,43 @@ namespace Grain {
     }
 
 
+    void SignalLadderFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+
+        // Same expressions as in `process()`, so that the results are bit-identical
+        const double k2vg = _m_k2vg;
+        const double i2v = _m_i2v;
+        const double resonance = m_resonance;
+        const double kacr = _m_kacr;
+
+        double az1 = _m_az1, az2 = _m_az2, az3 = _m_az3, az4 = _m_az4, az5 = _m_az5;
+        double ay1 = _m_ay1, ay2 = _m_ay2, ay3 = _m_ay3, ay4 = _m_ay4;
+        double amf = _m_amf;
+
+        for (int64_t i = 0; i < n; i++) {
+            float input = in[i];
+
+            for (int32_t pass = 0; pass < 2; pass++) {   // Second pass is oversampling
+                ay1 = az1 + k2vg * (std::tanh((input - 4 * resonance * amf * kacr) / i2v) - std::tanh(az1 / i2v));
+                az1 = ay1;
+                ay2 = az2 + k2vg * (std::tanh(ay1 / i2v) - std::tanh(az2 / i2v));
+                az2 = ay2;
+                ay3 = az3 + k2vg * (std::tanh(ay2 / i2v) - std::tanh(az3 / i2v));
+                az3 = ay3;
+                ay4 = az4 + k2vg * (std::tanh(ay3 / i2v) - std::tanh(az4 / i2v));
+                az4 = ay4;
+
+                // 1/2-sample delay for phase compensation
+                amf = (ay4 + az5) * 0.5;
+                az5 = ay4;
+            }
+
+            out[i] = static_cast<float>(amf);
+        }
+
+        _m_az1 = az1; _m_az2 = az2; _m_az3 = az3; _m_az4 = az4; _m_az5 = az5;
+        _m_ay1 = ay1; _m_ay2 = ay2; _m_ay3 = ay3; _m_ay4 = ay4;
+        _m_amf = amf;
+    }
+
+
 }  // End of namespace Grain
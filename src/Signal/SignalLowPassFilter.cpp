@@ -42,6 +42,8 @@ namespace Grain {
 
         memset(_m_stage, 0, sizeof(_m_stage));
         memset(_m_delay, 0, sizeof(_m_delay));
+        memset(_m_lane_stage, 0, sizeof(_m_lane_stage));
+        memset(_m_lane_delay, 0, sizeof(_m_lane_delay));
     }
 
 
@@ -71,4 +73,128 @@ namespace Grain {
         }
     }
 
+
+    void SignalLowPassFilter::processBlock(const float* in, float* out, int64_t n) noexcept {
+
+        const double p = _m_p;
+        const double k = _m_k;
+        const double q = _m_q;
+        const float sign = m_inverted ? -1.0f : 1.0f;
+
+        double s0 = _m_stage[0], s1 = _m_stage[1], s2 = _m_stage[2], s3 = _m_stage[3];
+        double d0 = _m_delay[0], d1 = _m_delay[1], d2 = _m_delay[2], d3 = _m_delay[3];
+
+        for (int64_t i = 0; i < n; i++) {
+            double x = in[i] - q * s3;
+
+            s0 = x * p + d0 * p - k * s0;
+            s1 = s0 * p + d1 * p - k * s1;
+            s2 = s1 * p + d2 * p - k * s2;
+            s3 = s2 * p + d3 * p - k * s3;
+
+            s3 -= (s3 * s3 * s3) / 6.0;
+
+            d0 = x;
+            d1 = s0;
+            d2 = s1;
+            d3 = s2;
+
+            out[i] = sign * static_cast<float>(s3);
+        }
+
+        _m_stage[0] = s0; _m_stage[1] = s1; _m_stage[2] = s2; _m_stage[3] = s3;
+        _m_delay[0] = d0; _m_delay[1] = d1; _m_delay[2] = d2; _m_delay[3] = d3;
+    }
+
+
+    /**
+     *  @brief Filter up to `kMaxLaneCount` interleaved channels at once.
+     *
+     *  All channels share the filter settings but have independent states,
+     *  which are separate from the state used by `process()` and
+     *  `processBlock()`. Each channel gives the same result as
+     *  `processBlock()` on a filter of its own.
+     *
+     *  @param in Interleaved input frames.
+     *  @param out Interleaved output frames, may be the same as `in`.
+     *  @param frame_count Number of frames.
+     *  @param channel_count Number of channels per frame, 1 to `kMaxLaneCount`.
+     *  @return ErrorCode::None on success.
+     */
+    ErrorCode SignalLowPassFilter::processInterleaved(const float* in, float* out, int64_t frame_count, int32_t channel_count) noexcept {
+
+        if (!in || !out) {
+            return ErrorCode::NullPointer;
+        }
+
+        if (channel_count < 1 || channel_count > kMaxLaneCount) {
+            return ErrorCode::BadArgs;
+        }
+
+        const double p = _m_p;
+        const double k = _m_k;
+        const double q = _m_q;
+        const bool inverted = m_inverted;
+
+        double s0[kMaxLaneCount], s1[kMaxLaneCount], s2[kMaxLaneCount], s3[kMaxLaneCount];
+        double d0[kMaxLaneCount], d1[kMaxLaneCount], d2[kMaxLaneCount], d3[kMaxLaneCount];
+        for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+            s0[lane] = _m_lane_stage[0][lane];
+            s1[lane] = _m_lane_stage[1][lane];
+            s2[lane] = _m_lane_stage[2][lane];
+            s3[lane] = _m_lane_stage[3][lane];
+            d0[lane] = _m_lane_delay[0][lane];
+            d1[lane] = _m_lane_delay[1][lane];
+            d2[lane] = _m_lane_delay[2][lane];
+            d3[lane] = _m_lane_delay[3][lane];
+        }
+
+        float in_lane[kMaxLaneCount]{};
+        float y[kMaxLaneCount];
+
+        for (int64_t i = 0; i < frame_count; i++) {
+            const float* src = in + i * channel_count;
+            for (int32_t lane = 0; lane < channel_count; lane++) {
+                in_lane[lane] = src[lane];
+            }
+
+            for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+                double x = in_lane[lane] - q * s3[lane];
+
+                s0[lane] = x * p + d0[lane] * p - k * s0[lane];
+                s1[lane] = s0[lane] * p + d1[lane] * p - k * s1[lane];
+                s2[lane] = s1[lane] * p + d2[lane] * p - k * s2[lane];
+                s3[lane] = s2[lane] * p + d3[lane] * p - k * s3[lane];
+
+                s3[lane] -= (s3[lane] * s3[lane] * s3[lane]) / 6.0;
+
+                d0[lane] = x;
+                d1[lane] = s0[lane];
+                d2[lane] = s1[lane];
+                d3[lane] = s2[lane];
+
+                auto v = static_cast<float>(s3[lane]);
+                y[lane] = inverted ? -v : v;
+            }
+
+            float* dst = out + i * channel_count;
+            for (int32_t lane = 0; lane < channel_count; lane++) {
+                dst[lane] = y[lane];
+            }
+        }
+
+        for (int32_t lane = 0; lane < kMaxLaneCount; lane++) {
+            _m_lane_stage[0][lane] = s0[lane];
+            _m_lane_stage[1][lane] = s1[lane];
+            _m_lane_stage[2][lane] = s2[lane];
+            _m_lane_stage[3][lane] = s3[lane];
+            _m_lane_delay[0][lane] = d0[lane];
+            _m_lane_delay[1][lane] = d1[lane];
+            _m_lane_delay[2][lane] = d2[lane];
+            _m_lane_delay[3][lane] = d3[lane];
+        }
+
+        return ErrorCode::None;
+    }
+
 } // End of namespace Grain
@@ -0,0 +1,291 @@
+//
+//  SignalOscillatorBank.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Signal/SignalOscillatorBank.hpp"
+#include "Signal/SignalWave.hpp"
+#include "Signal/Audio.hpp"
+#include "Math/Math.hpp"
+
+#include <algorithm>
+
+
+namespace Grain {
+
+    /**
+     *  @brief Copy the tables of `wave` into the bank.
+     *
+     *  The resolution of `wave` must be a power of two, otherwise the bank is
+     *  not valid and renders silence.
+     */
+    SignalOscillatorBank::SignalOscillatorBank(const SignalWave* wave, int32_t sample_rate) noexcept {
+        sample_rate_ = std::clamp<int32_t>(sample_rate, 1, Audio::kMaxSampleRate);
+
+        if (!wave) {
+            return;
+        }
+
+        int32_t log2_resolution = Math::log2IfPowerOfTwo(wave->resolution());
+        if (log2_resolution < 1 || log2_resolution > 24) {
+            return;
+        }
+
+        try {
+            resolution_ = wave->resolution();
+            log2_resolution_ = log2_resolution;
+
+            int32_t stride = resolution_ + 1;
+            std::vector<int32_t> pitches;
+            for (int32_t pitch = SignalWave::kMinPitch; pitch <= SignalWave::kMaxPitch; pitch++) {
+                if (wave->hasWave(pitch)) {
+                    pitches.push_back(pitch);
+                }
+            }
+
+            tables_.resize(pitches.size() * stride);
+            for (size_t level = 0; level < pitches.size(); level++) {
+                const float* src = wave->mutSamplePtr(pitches[level]);
+                float* dst = &tables_[level * stride];
+                std::copy(src, src + resolution_, dst);
+                dst[resolution_] = dst[0];  // Guard sample, interpolation never wraps
+            }
+
+            level_pitches_ = std::move(pitches);
+        }
+        catch (...) {
+            tables_.clear();
+            level_pitches_.clear();
+        }
+    }
+
+
+    /**
+     *  @brief Set the number of voices.
+     *
+     *  Existing voices keep their state, new voices are silent.
+     */
+    ErrorCode SignalOscillatorBank::setVoiceCount(int32_t voice_count) noexcept {
+        try {
+            voice_count = std::max<int32_t>(voice_count, 0);
+            size_t lane_count = static_cast<size_t>((voice_count + kLaneCount - 1) / kLaneCount) * kLaneCount;
+
+            phase_.resize(lane_count, 0);
+            inc_.resize(lane_count, 0);
+            target_inc_.resize(lane_count, 0);
+            amp_.resize(lane_count, 0.0f);
+            target_amp_.resize(lane_count, 0.0f);
+
+            // Voices removed now must not sound in unused lanes of the last group
+            for (size_t i = voice_count; i < lane_count; i++) {
+                amp_[i] = target_amp_[i] = 0.0f;
+            }
+
+            voice_count_ = voice_count;
+        }
+        catch (const std::bad_alloc&) {
+            return ErrorCode::MemCantAllocate;
+        }
+
+        return ErrorCode::None;
+    }
+
+
+    /**
+     *  @brief Set frequency, amplitude and phase of a voice immediately.
+     *
+     *  @param voice Index of the voice.
+     *  @param freq Frequency in Hz, limited to the Nyquist frequency.
+     *  @param amplitude Amplitude, 0 for silence.
+     *  @param phase Position in the cycle, 0 to 1.
+     */
+    void SignalOscillatorBank::setVoice(int32_t voice, float freq, float amplitude, float phase) noexcept {
+        if (voice < 0 || voice >= voice_count_) {
+            return;
+        }
+
+        phase -= std::floor(phase);
+        phase_[voice] = static_cast<uint32_t>(static_cast<double>(phase) * 4294967296.0);
+        inc_[voice] = target_inc_[voice] = _phaseIncForFreq(freq);
+        amp_[voice] = target_amp_[voice] = amplitude;
+    }
+
+
+    /**
+     *  @brief Glide frequency and amplitude of a voice to new values.
+     *
+     *  The values are reached at the end of the next call to `render()`.
+     */
+    void SignalOscillatorBank::rampVoice(int32_t voice, float freq, float amplitude) noexcept {
+        if (voice < 0 || voice >= voice_count_) {
+            return;
+        }
+
+        target_inc_[voice] = _phaseIncForFreq(freq);
+        target_amp_[voice] = amplitude;
+    }
+
+
+    void SignalOscillatorBank::silenceAll() noexcept {
+        std::fill(amp_.begin(), amp_.end(), 0.0f);
+        std::fill(target_amp_.begin(), target_amp_.end(), 0.0f);
+    }
+
+
+    float SignalOscillatorBank::voiceFreq(int32_t voice) const noexcept {
+        return voice >= 0 && voice < voice_count_ ? _freqForPhaseInc(target_inc_[voice]) : 0.0f;
+    }
+
+
+    float SignalOscillatorBank::voiceAmplitude(int32_t voice) const noexcept {
+        return voice >= 0 && voice < voice_count_ ? target_amp_[voice] : 0.0f;
+    }
+
+
+    /**
+     *  @brief Render the sum of all voices.
+     *
+     *  @param out_samples Destination for `frame_count` mono samples.
+     *  @param frame_count Number of samples to render.
+     *  @param add If true, the voices are added to the content of
+     *             `out_samples`, otherwise it is overwritten.
+     */
+    void SignalOscillatorBank::render(float* out_samples, int32_t frame_count, bool add) noexcept {
+        if (!out_samples || frame_count < 1) {
+            return;
+        }
+
+        if (!add) {
+            std::fill(out_samples, out_samples + frame_count, 0.0f);
+        }
+
+        if (!isValid()) {
+            return;
+        }
+
+        int32_t stride = resolution_ + 1;
+        int32_t index_shift = 32 - log2_resolution_;
+        uint32_t frac_mask = (1u << index_shift) - 1;
+        float frac_scale = 1.0f / static_cast<float>(1u << index_shift);
+        float frame_scale = 1.0f / static_cast<float>(frame_count);
+
+        for (int32_t group = 0; group < voice_count_; group += kLaneCount) {
+            const float* table0[kLaneCount];
+            const float* table1[kLaneCount];
+            float level_weight[kLaneCount];
+            uint32_t phase[kLaneCount];
+            uint32_t inc[kLaneCount];
+            uint32_t dinc[kLaneCount];
+            float amp[kLaneCount];
+            float damp[kLaneCount];
+            bool silent = true;
+
+            for (int32_t k = 0; k < kLaneCount; k++) {
+                int32_t v = group + k;
+                silent &= amp_[v] == 0.0f && target_amp_[v] == 0.0f;
+
+                // The level must be band-limited for the highest frequency in this block
+                int32_t level;
+                float weight;
+                _levelForFreq(_freqForPhaseInc(std::max(inc_[v], target_inc_[v])), level, weight);
+                int32_t next_level = std::min<int32_t>(level + 1, levelCount() - 1);
+                table0[k] = &tables_[static_cast<size_t>(level) * stride];
+                table1[k] = &tables_[static_cast<size_t>(next_level) * stride];
+                level_weight[k] = weight;
+
+                phase[k] = phase_[v];
+                inc[k] = inc_[v];
+                // Modulo 2^32 arithmetic handles falling frequencies
+                auto inc_delta = static_cast<int64_t>(target_inc_[v]) - static_cast<int64_t>(inc_[v]);
+                dinc[k] = static_cast<uint32_t>(static_cast<int32_t>(inc_delta / frame_count));
+                amp[k] = amp_[v];
+                damp[k] = (target_amp_[v] - amp_[v]) * frame_scale;
+            }
+
+            if (silent) {
+                // Keep the phases running, so voices fade in where they would be
+                for (int32_t k = 0; k < kLaneCount; k++) {
+                    int32_t v = group + k;
+                    phase_[v] += target_inc_[v] * static_cast<uint32_t>(frame_count);
+                    inc_[v] = target_inc_[v];
+                }
+                continue;
+            }
+
+            for (int32_t i = 0; i < frame_count; i++) {
+                float sum = 0.0f;
+                for (int32_t k = 0; k < kLaneCount; k++) {
+                    uint32_t index = phase[k] >> index_shift;
+                    float frac = static_cast<float>(phase[k] & frac_mask) * frac_scale;
+                    float a0 = table0[k][index];
+                    float a1 = table0[k][index + 1];
+                    float b0 = table1[k][index];
+                    float b1 = table1[k][index + 1];
+                    float a = a0 + (a1 - a0) * frac;
+                    float b = b0 + (b1 - b0) * frac;
+                    sum += (a + (b - a) * level_weight[k]) * amp[k];
+                    phase[k] += inc[k];
+                    inc[k] += dinc[k];
+                    amp[k] += damp[k];
+                }
+                out_samples[i] += sum;
+            }
+
+            for (int32_t k = 0; k < kLaneCount; k++) {
+                int32_t v = group + k;
+                phase_[v] = phase[k];
+                inc_[v] = target_inc_[v];
+                amp_[v] = target_amp_[v];
+            }
+        }
+    }
+
+
+    uint32_t SignalOscillatorBank::_phaseIncForFreq(float freq) const noexcept {
+        // Limited to just below Nyquist, so the increment fits into 31 bits
+        double inc = static_cast<double>(std::max(freq, 0.0f)) / sample_rate_ * 4294967296.0;
+        return static_cast<uint32_t>(std::min(inc, 2147483647.0));
+    }
+
+
+    float SignalOscillatorBank::_freqForPhaseInc(uint32_t inc) const noexcept {
+        return static_cast<float>(static_cast<double>(inc) * sample_rate_ / 4294967296.0);
+    }
+
+
+    /**
+     *  @brief Find the levels to use for a frequency.
+     *
+     *  @param out_level Lower level, the upper level is the next one.
+     *  @param out_weight Crossfade weight of the upper level.
+     */
+    void SignalOscillatorBank::_levelForFreq(float freq, int32_t& out_level, float& out_weight) const noexcept {
+        out_level = 0;
+        out_weight = 0.0f;
+
+        if (freq <= 0.0f || level_pitches_.size() < 2) {
+            return;
+        }
+
+        float pitch = Audio::pitchFromFreq(freq);
+        auto it = std::upper_bound(level_pitches_.begin(), level_pitches_.end(), pitch,
+                                   [](float p, int32_t level_pitch) { return p < static_cast<float>(level_pitch); });
+        if (it == level_pitches_.begin()) {
+            return;
+        }
+
+        auto level = static_cast<int32_t>(it - level_pitches_.begin()) - 1;
+        out_level = level;
+        if (level < levelCount() - 1) {
+            auto p0 = static_cast<float>(level_pitches_[level]);
+            auto p1 = static_cast<float>(level_pitches_[level + 1]);
+            out_weight = std::clamp((pitch - p0) / (p1 - p0), 0.0f, 1.0f);
+        }
+    }
+
+
+} // End of namespace Grain
@@ -0,0 +1,260 @@
+//
+//  SignalStats.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "Signal/SignalStats.hpp"
+
+
+namespace Grain {
+
+    /**
+     *  @brief Add `count` samples to the statistics.
+     *
+     *  @param samples First sample.
+     *  @param count Number of samples.
+     *  @param step Distance between two samples, e.g. the channel count of
+     *              interleaved data.
+     *  @param first_index Index reported for the first sample in `minIndex()`
+     *                     and `maxIndex()`.
+     *  @param flags Combination of `kSum`, `kAbsSum`, `kSquareSum`, `kMinMax`
+     *               and `kZeroCrossings`. Values which are not requested are
+     *               left unchanged.
+     */
+    template <typename T>
+    void SignalStats::accumulate(const T* samples, int64_t count, int64_t step, int64_t first_index, uint32_t flags) noexcept {
+        if (!samples || count < 1 || step < 1) {
+            return;
+        }
+
+        if (step == 1) {
+            _accumulate<T, true>(samples, count, 1, first_index, flags);
+        }
+        else {
+            _accumulate<T, false>(samples, count, step, first_index, flags);
+        }
+    }
+
+
+    template <typename T, bool kUnitStep>
+    void SignalStats::_accumulate(const T* samples, int64_t count, int64_t step, int64_t first_index, uint32_t flags) noexcept {
+        if constexpr (kUnitStep) {
+            step = 1;
+        }
+
+        bool first_negative = samples[0] < T(0);
+        if (count_ == 0) {
+            first_negative_ = first_negative;
+            min_ = max_ = static_cast<double>(samples[0]);
+            min_index_ = max_index_ = first_index;
+        }
+        else if ((flags & kZeroCrossings) && first_negative != last_negative_) {
+            zero_crossings_++;
+        }
+
+        for (int64_t block_start = 0; block_start < count; block_start += kBlockLength) {
+            const T* s = samples + block_start * step;
+            int64_t n = std::min<int64_t>(kBlockLength, count - block_start);
+            int64_t lane_end = n - n % kLaneCount;
+
+            if (flags & (kSum | kAbsSum | kSquareSum)) {
+                double sum[kLaneCount] = {};
+                double abs_sum[kLaneCount] = {};
+                double square_sum[kLaneCount] = {};
+                for (int64_t i = 0; i < lane_end; i += kLaneCount) {
+                    for (int32_t k = 0; k < kLaneCount; k++) {
+                        auto v = static_cast<double>(s[(i + k) * step]);
+                        sum[k] += v;
+                        abs_sum[k] += std::fabs(v);
+                        square_sum[k] += v * v;
+                    }
+                }
+                for (int64_t i = lane_end; i < n; i++) {
+                    auto v = static_cast<double>(s[i * step]);
+                    sum[0] += v;
+                    abs_sum[0] += std::fabs(v);
+                    square_sum[0] += v * v;
+                }
+                for (int32_t k = 0; k < kLaneCount; k++) {
+                    sum_ += sum[k];
+                    abs_sum_ += abs_sum[k];
+                    square_sum_ += square_sum[k];
+                }
+            }
+
+            if (flags & kMinMax) {
+                T lane_min[kLaneCount];
+                T lane_max[kLaneCount];
+                for (int32_t k = 0; k < kLaneCount; k++) {
+                    lane_min[k] = lane_max[k] = s[0];
+                }
+                for (int64_t i = 0; i < lane_end; i += kLaneCount) {
+                    for (int32_t k = 0; k < kLaneCount; k++) {
+                        T v = s[(i + k) * step];
+                        lane_min[k] = v < lane_min[k] ? v : lane_min[k];
+                        lane_max[k] = v > lane_max[k] ? v : lane_max[k];
+                    }
+                }
+                for (int64_t i = lane_end; i < n; i++) {
+                    T v = s[i * step];
+                    lane_min[0] = v < lane_min[0] ? v : lane_min[0];
+                    lane_max[0] = v > lane_max[0] ? v : lane_max[0];
+                }
+
+                T block_min = lane_min[0];
+                T block_max = lane_max[0];
+                for (int32_t k = 1; k < kLaneCount; k++) {
+                    block_min = std::min(block_min, lane_min[k]);
+                    block_max = std::max(block_max, lane_max[k]);
+                }
+
+                // Search the index only if the block holds a new extreme
+                if (static_cast<double>(block_min) < min_) {
+                    min_ = static_cast<double>(block_min);
+                    for (int64_t i = 0; i < n; i++) {
+                        if (s[i * step] == block_min) {
+                            min_index_ = first_index + block_start + i;
+                            break;
+                        }
+                    }
+                }
+                if (static_cast<double>(block_max) > max_) {
+                    max_ = static_cast<double>(block_max);
+                    for (int64_t i = 0; i < n; i++) {
+                        if (s[i * step] == block_max) {
+                            max_index_ = first_index + block_start + i;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (flags & kZeroCrossings) {
+                int64_t crossings[kLaneCount] = {};
+                int64_t i = 1;
+                for (; i + kLaneCount <= n; i += kLaneCount) {
+                    for (int32_t k = 0; k < kLaneCount; k++) {
+                        crossings[k] += (s[(i + k - 1) * step] < T(0)) != (s[(i + k) * step] < T(0));
+                    }
+                }
+                for (; i < n; i++) {
+                    crossings[0] += (s[(i - 1) * step] < T(0)) != (s[i * step] < T(0));
+                }
+                for (int32_t k = 0; k < kLaneCount; k++) {
+                    zero_crossings_ += crossings[k];
+                }
+
+                // Crossing to the first sample of the next block
+                if (block_start + n < count) {
+                    zero_crossings_ += (s[(n - 1) * step] < T(0)) != (s[n * step] < T(0));
+                }
+            }
+        }
+
+        last_negative_ = samples[(count - 1) * step] < T(0);
+        count_ += count;
+    }
+
+
+    /**
+     *  @brief Combine with the statistics of another range.
+     *
+     *  @param other Statistics to add.
+     *  @param adjacent true, if the range of `other` directly follows the range
+     *                  of this object in the same channel, so a zero crossing
+     *                  between both ranges is counted. If both contain a sample
+     *                  with the same extreme value, the index of this object is
+     *                  kept.
+     */
+    void SignalStats::merge(const SignalStats& other, bool adjacent) noexcept {
+        if (other.count_ < 1) {
+            return;
+        }
+
+        if (count_ < 1) {
+            *this = other;
+            return;
+        }
+
+        if (adjacent && last_negative_ != other.first_negative_) {
+            zero_crossings_++;
+        }
+
+        sum_ += other.sum_;
+        abs_sum_ += other.abs_sum_;
+        square_sum_ += other.square_sum_;
+        zero_crossings_ += other.zero_crossings_;
+
+        if (other.min_ < min_) {
+            min_ = other.min_;
+            min_index_ = other.min_index_;
+        }
+        if (other.max_ > max_) {
+            max_ = other.max_;
+            max_index_ = other.max_index_;
+        }
+
+        count_ += other.count_;
+        last_negative_ = other.last_negative_;
+    }
+
+
+    /**
+     *  @brief Convert the min and max indices from positions in the
+     *         accumulated samples to positions `offs + index * stride`.
+     */
+    void SignalStats::mapIndices(int64_t offs, int64_t stride) noexcept {
+        if (count_ > 0) {
+            min_index_ = offs + min_index_ * stride;
+            max_index_ = offs + max_index_ * stride;
+        }
+    }
+
+
+    /**
+     *  @brief Add `count` samples to a histogram of `bin_count` bins spanning
+     *         [`min_value`, `max_value`].
+     *
+     *  Samples outside the range are counted in the first or last bin. The
+     *  bins are not cleared, so several ranges can be added to one histogram.
+     */
+    template <typename T>
+    void SignalStats::histogram(
+            const T* samples, int64_t count, int64_t step,
+            double min_value, double max_value, int32_t bin_count, int64_t* out_bins) noexcept {
+
+        if (!samples || !out_bins || count < 1 || step < 1 || bin_count < 1 || !(max_value > min_value)) {
+            return;
+        }
+
+        double scale = static_cast<double>(bin_count) / (max_value - min_value);
+        int32_t last_bin = bin_count - 1;
+        for (int64_t i = 0; i < count; i++) {
+            double v = (static_cast<double>(samples[i * step]) - min_value) * scale;
+            if (std::isnan(v)) {
+                continue;
+            }
+            auto bin = static_cast<int32_t>(std::clamp(v, 0.0, static_cast<double>(last_bin)));
+            out_bins[bin]++;
+        }
+    }
+
+
+    template void SignalStats::accumulate<int8_t>(const int8_t*, int64_t, int64_t, int64_t, uint32_t) noexcept;
+    template void SignalStats::accumulate<int16_t>(const int16_t*, int64_t, int64_t, int64_t, uint32_t) noexcept;
+    template void SignalStats::accumulate<int32_t>(const int32_t*, int64_t, int64_t, int64_t, uint32_t) noexcept;
+    template void SignalStats::accumulate<float>(const float*, int64_t, int64_t, int64_t, uint32_t) noexcept;
+    template void SignalStats::accumulate<double>(const double*, int64_t, int64_t, int64_t, uint32_t) noexcept;
+
+    template void SignalStats::histogram<int8_t>(const int8_t*, int64_t, int64_t, double, double, int32_t, int64_t*) noexcept;
+    template void SignalStats::histogram<int16_t>(const int16_t*, int64_t, int64_t, double, double, int32_t, int64_t*) noexcept;
+    template void SignalStats::histogram<int32_t>(const int32_t*, int64_t, int64_t, double, double, int32_t, int64_t*) noexcept;
+    template void SignalStats::histogram<float>(const float*, int64_t, int64_t, double, double, int32_t, int64_t*) noexcept;
+    template void SignalStats::histogram<double>(const double*, int64_t, int64_t, double, double, int32_t, int64_t*) noexcept;
+
+
+} // End of namespace Grain
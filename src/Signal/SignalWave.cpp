@@ -451,6 +451,102 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Replace the tables from `src_pitch` upwards by band-limited
+     *         versions of the table at `src_pitch`, one every `pitch_step`
+     *         pitches.
+     *
+     *  The spectrum of the source table is computed once. For each level,
+     *  harmonics above the Nyquist frequency of the highest pitch the level is
+     *  used for are removed. As `lookup()` and `SignalOscillatorBank`
+     *  crossfade between neighbouring levels, a level is used up to the pitch
+     *  of the next level, so it is limited for that pitch. Harmonics above
+     *  the roll-off frequency (see `setFreqRollOff()`) are faded out smoothly.
+     *
+     *  Tables at other pitches above `src_pitch` are removed. The resolution
+     *  must be a power of two supported by `FFT`.
+     */
+    ErrorCode SignalWave::buildMipLevels(int32_t src_pitch, int32_t pitch_step) noexcept {
+        auto result = ErrorCode::None;
+        FFT* fft = nullptr;
+
+        try {
+            if (!hasWave(src_pitch)) {
+                Exception::throwSpecific(kErrNoWaveData);
+            }
+
+            int32_t log_n = Math::log2IfPowerOfTwo(m_resolution);
+            if (log_n < FFT::kMinLogN || log_n > FFT::kMaxLogN) {
+                Exception::throwSpecific(kErrResolutionNotPowerOfTwo);
+            }
+
+            pitch_step = std::clamp<int32_t>(pitch_step, 1, kPitchCount);
+
+            fft = new(std::nothrow) FFT(log_n);
+            if (!fft) {
+                Exception::throwStandard(ErrorCode::ClassInstantiationFailed);
+            }
+
+            int32_t bin_count = m_resolution / 2 + 1;
+            std::vector<float> src_real(bin_count);
+            std::vector<float> src_imag(bin_count);
+            std::vector<float> real(bin_count);
+            std::vector<float> imag(bin_count);
+
+            fft->forward(m_wave_data[src_pitch], src_real.data(), src_imag.data());
+
+            for (int32_t pitch = src_pitch + 1; pitch <= kMaxPitch; pitch++) {
+                if ((pitch - src_pitch) % pitch_step != 0) {
+                    std::free(m_wave_data[pitch]);
+                    m_wave_data[pitch] = nullptr;
+                }
+            }
+
+            auto max_freq = static_cast<float>(m_sample_rate) / 2.0f; // Nyquist frequency
+            for (int32_t pitch = src_pitch; pitch <= kMaxPitch; pitch += pitch_step) {
+                if (!checkWave(pitch)) {
+                    Exception::throwSpecific(kErrCheckWaveFailed);
+                }
+
+                // Highest harmonic below Nyquist at the pitch of the next level
+                float top_freq = Audio::freqFromPitch(static_cast<float>(pitch + pitch_step));
+                float max_harmonic = max_freq / top_freq;
+                float rolloff_harmonic = max_harmonic * m_freq_rolloff;
+
+                real[0] = src_real[0];
+                imag[0] = 0.0f;
+                for (int32_t h = 1; h < bin_count; h++) {
+                    auto hf = static_cast<float>(h);
+                    float scale = 1.0f;
+                    if (hf > max_harmonic) {
+                        scale = 0.0f;
+                    }
+                    else if (hf > rolloff_harmonic) {
+                        float t = Math::remapclampedf(rolloff_harmonic, max_harmonic, 0.0f, 1.0f, hf);
+                        scale = 1.0f - static_cast<float>(Math::ease(Math::EaseMode::InOutSine, t));
+                    }
+                    real[h] = src_real[h] * scale;
+                    imag[h] = src_imag[h] * scale;
+                }
+
+                fft->inverse(real.data(), imag.data(), m_wave_data[pitch]);
+            }
+
+            _m_must_finalize = true;
+        }
+        catch (const Exception& e) {
+            result = e.code();
+        }
+        catch (const std::bad_alloc&) {
+            result = ErrorCode::MemCantAllocate;
+        }
+
+        delete fft;
+
+        return result;
+    }
+
+
     /**
      *  @brief Finalizes the waveform generation process.
      *
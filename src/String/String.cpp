@@ -19,6 +19,7 @@
 #include <libgen.h>
 #include <uuid/uuid.h>
 #include <cstdarg>
+#include <charconv>
 
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -154,8 +155,18 @@ namespace Grain {
      *  @param string A reference to the string which should be copied. The original string is not modified.
      */
     String::String(const String& string) noexcept {
-        checkCapacity(string.length(), 32);
-        append(string.utf8());
+        checkCapacity(string.byteLength(), kDefaultByteCapacity);
+        append(string);
+    }
+
+
+    /**
+     *  @brief Constructs a String by taking over the content of another String.
+     *
+     *  @param string The string to move from. It is empty afterwards.
+     */
+    String::String(String&& string) noexcept {
+        *this = std::move(string);
     }
 
 
@@ -166,8 +177,8 @@ namespace Grain {
      */
     String::String(const String* string) noexcept {
         if (string) {
-            checkCapacity(string->length(), 32);
-            append(string->utf8());
+            checkCapacity(string->byteLength(), kDefaultByteCapacity);
+            append(*string);
         }
         else {
             clear();
@@ -188,7 +199,9 @@ namespace Grain {
 
 
     String::~String() noexcept {
-        std::free(data_);
+        if (data_ != local_data_) {
+            std::free(data_);
+        }
     }
 
 
@@ -208,14 +221,7 @@ namespace Grain {
 
 
     void String::_init() noexcept {
-        if (data_) {
-            free(data_);
-        }
-        data_ = nullptr;
-        byte_len_ = 0;
-        character_len_ = 0;
-        byte_capacity_ = 0;
-        extra_grow_bytes_ = 32;
+        _freeData();
         grow_count_ = 0;
     }
 
@@ -223,6 +229,31 @@ namespace Grain {
     String& String::operator = (char c) { this->setChar(c); return *this; }
     String& String::operator = (const char* str) { this->set(str); return *this; }
     String& String::operator = (const String& other) { this->set(other); return *this; }
+
+    String& String::operator = (String&& other) noexcept {
+        if (&other != this) {
+            _freeData();
+
+            if (other.data_ == other.local_data_) {
+                std::memcpy(local_data_, other.local_data_, other.byte_len_ + 1);
+            }
+            else {
+                // Take over the heap memory
+                data_ = other.data_;
+                byte_capacity_ = other.byte_capacity_;
+                other.data_ = other.local_data_;
+                other.byte_capacity_ = kLocalBufferSize - 1;
+            }
+
+            byte_len_ = other.byte_len_;
+            character_len_ = other.character_len_;
+            grow_count_ = other.grow_count_;
+            other.clear();
+        }
+
+        return *this;
+    }
+
     String& String::operator = (const String* other) { this->set(other); return *this; }
     String& String::operator = (int8_t value) { this->clear(); this->appendInt64(value); return *this; }
     String& String::operator = (int16_t value) { this->clear(); this->appendInt64(value); return *this; }
@@ -610,22 +641,48 @@ namespace Grain {
             return -1;
         }
         else {
-            auto n = static_cast<int64_t>(strlen(str));
-            int64_t length = 0;
+            return utf8Length(str, static_cast<int64_t>(strlen(str)));
+        }
+    }
+
+
+    /**
+     *  @brief Count the UTF-8 characters in the first `byte_length` bytes of `str`.
+     *
+     *  @return The number of characters, or -1 if `str` contains an invalid UTF-8
+     *          start byte.
+     */
+    int64_t String::utf8Length(const char* str, int64_t byte_length) noexcept {
+        if (!str) {
+            return -1;
+        }
 
-            for (int64_t byte_index = 0; byte_index < n; ) {
-                int64_t seq_length = utf8SeqLengthByStartByte(str[byte_index]);
+        int64_t length = 0;
+        int64_t byte_index = 0;
 
-                if (seq_length < 1) {
-                    return -1;  // UTF-8 sequence error
+        while (byte_index < byte_length) {
+            // Runs of ASCII characters are counted eight bytes at a time
+            if (byte_index + 8 <= byte_length) {
+                uint64_t word;
+                std::memcpy(&word, &str[byte_index], 8);
+                if ((word & 0x8080808080808080ULL) == 0) {
+                    byte_index += 8;
+                    length += 8;
+                    continue;
                 }
+            }
 
-                byte_index += seq_length;
-                length++;
+            int64_t seq_length = utf8SeqLengthByStartByte(str[byte_index]);
+
+            if (seq_length < 1) {
+                return -1;  // UTF-8 sequence error
             }
 
-            return length;
+            byte_index += seq_length;
+            length++;
         }
+
+        return length;
     }
 
 
@@ -1080,6 +1137,10 @@ namespace Grain {
      *  @return `true` if the method succeeded.
      */
     bool String::set(const String& string) noexcept {
+        if (&string == this) {
+            return true;
+        }
+
         clear();
         return append(string);
     }
@@ -1457,10 +1518,10 @@ namespace Grain {
     bool String::append(const char* str) noexcept {
         if (str) {
             auto byte_length = static_cast<int64_t>(strlen(str));
-            auto character_length = utf8Length(str);
+            auto character_length = utf8Length(str, byte_length);
 
             if (byte_length > 0 && character_length > 0) {
-                if (_checkExtraCapacity(byte_length + 1)) {
+                if (_checkExtraCapacity(byte_length)) {
                     memcpy(&data_[byte_len_], str, byte_length);
                     data_[byte_len_ + byte_length] = String::EOS;
                     byte_len_ += byte_length;
@@ -1483,18 +1544,19 @@ namespace Grain {
      *  @return `true` if the method succeeded, `false` otherwise.
      */
     bool String::append(const char* str, int64_t max_byte_length) noexcept {
-        if (str) {
-            int64_t byte_length = strlen(str);
-            if (byte_length > max_byte_length) {
-                byte_length = max_byte_length;
-            }
+        if (str && max_byte_length > 0) {
+            auto eos = static_cast<const char*>(std::memchr(str, String::EOS, max_byte_length));
+            int64_t byte_length = eos ? eos - str : max_byte_length;
 
             if (byte_length > 0) {
-                if (_checkExtraCapacity(byte_length + 1)) {
+                if (_checkExtraCapacity(byte_length)) {
                     memcpy(&data_[byte_len_], str, byte_length);
                     data_[byte_len_ + byte_length] = String::EOS;
                     byte_len_ += byte_length;
-                    character_len_ = utf8Length(data_);
+
+                    // Only the appended bytes must be counted
+                    int64_t character_length = utf8Length(str, byte_length);
+                    character_len_ = character_length >= 0 ? character_len_ + character_length : utf8Length(data_);
                     return true;
                 }
             }
@@ -1511,7 +1573,24 @@ namespace Grain {
      *  @return `true` if the method succeeded, `false` otherwise.
      */
     bool String::append(const String& string) noexcept {
-        return append(string.utf8());
+        int64_t byte_length = string.byte_len_;
+        int64_t character_length = string.character_len_;
+
+        if (byte_length < 1 || character_length < 1) {
+            return append(string.utf8());
+        }
+
+        // The lengths of `string` are known, nothing must be scanned
+        if (_checkExtraCapacity(byte_length)) {
+            // `string` may be this string, so `string.data_` is read after growing
+            memcpy(&data_[byte_len_], string.data_, byte_length);
+            byte_len_ += byte_length;
+            character_len_ += character_length;
+            data_[byte_len_] = String::EOS;
+            return true;
+        }
+
+        return false;
     }
 
 
@@ -1523,7 +1602,7 @@ namespace Grain {
      */
     bool String::append(const String* string) noexcept {
         if (string) {
-            return append(string->utf8());
+            return append(*string);
         }
         else {
             return false;
@@ -1597,7 +1676,7 @@ namespace Grain {
      *  @return `true` if the value was successfully appended, `false` otherwise.
      */
     bool String::appendInt32(int32_t value) noexcept {
-        return appendFormatted(12, "%d", value) == ErrorCode::None;
+        return appendInt64(value);
     }
 
 
@@ -1608,7 +1687,7 @@ namespace Grain {
      *  @return `true` if the value was successfully appended, `false` otherwise.
      */
     bool String::appendUInt32(uint32_t value) noexcept {
-        return appendFormatted(12, "%d", value) == ErrorCode::None;
+        return appendUInt64(value);
     }
 
 
@@ -1619,7 +1698,8 @@ namespace Grain {
      *  @return `true` if the value was successfully appended, `false` otherwise.
      */
     bool String::appendInt64(int64_t value) noexcept {
-        return appendFormatted(22, "%lld", value) == ErrorCode::None;
+        char buffer[kNumberStrBufferSize];
+        return _appendAscii(buffer, formatInt64(value, buffer));
     }
 
 
@@ -1630,7 +1710,8 @@ namespace Grain {
      *  @return `true` if the value was successfully appended, `false` otherwise.
      */
     bool String::appendUInt64(uint64_t value) noexcept {
-        return appendFormatted(22, "%llu", value) == ErrorCode::None;
+        char buffer[kNumberStrBufferSize];
+        return _appendAscii(buffer, formatUInt64(value, buffer));
     }
 
 
@@ -1643,18 +1724,8 @@ namespace Grain {
      *  @return `true` if the value was successfully appended, `false` otherwise.
      */
     bool String::appendDouble(double value, int32_t precision) noexcept {
-        static const char* format[] = {
-                "%.0f", "%.1f", "%.2f", "%.3f", "%.4f", "%.5f", "%.6f", "%.7f", "%.8f", "%.9f",
-        };
-
-        if (precision < 0) {
-            precision = 0;
-        }
-        else if (precision > 9) {
-            precision = 9;
-        }
-
-        return appendFormatted(128, format[precision], value) == ErrorCode::None;
+        char buffer[kNumberStrBufferSize];
+        return _appendAscii(buffer, formatDouble(value, std::clamp(precision, 0, 9), buffer));
     }
 
 
@@ -3382,6 +3453,62 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Format an integer value as decimal number.
+     *
+     *  @param value The value to format.
+     *  @param out_str Destination, must have room for `kNumberStrBufferSize` bytes.
+     *  @return The byte length of the result, without EOS.
+     */
+    int32_t String::formatInt64(int64_t value, char* out_str) noexcept {
+        auto result = std::to_chars(out_str, out_str + kNumberStrBufferSize - 1, value);
+        *result.ptr = String::EOS;
+        return static_cast<int32_t>(result.ptr - out_str);
+    }
+
+
+    /**
+     *  @brief Format an unsigned integer value as decimal number.
+     *
+     *  @param value The value to format.
+     *  @param out_str Destination, must have room for `kNumberStrBufferSize` bytes.
+     *  @return The byte length of the result, without EOS.
+     */
+    int32_t String::formatUInt64(uint64_t value, char* out_str) noexcept {
+        auto result = std::to_chars(out_str, out_str + kNumberStrBufferSize - 1, value);
+        *result.ptr = String::EOS;
+        return static_cast<int32_t>(result.ptr - out_str);
+    }
+
+
+    /**
+     *  @brief Format a double value with a fixed number of fractional digits.
+     *
+     *  The result equals `printf("%.*f", precision, value)`. Where the standard
+     *  library supports floating point `std::to_chars()`, it is used instead of
+     *  `snprintf()`, which is several times faster.
+     *
+     *  @param value The value to format.
+     *  @param precision Number of fractional digits, clamped to 0 ... 17.
+     *  @param out_str Destination, must have room for `kNumberStrBufferSize` bytes.
+     *  @return The byte length of the result, without EOS.
+     */
+    int32_t String::formatDouble(double value, int32_t precision, char* out_str) noexcept {
+        precision = std::clamp(precision, 0, 17);
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::to_chars(out_str, out_str + kNumberStrBufferSize - 1, value, std::chars_format::fixed, precision);
+        if (result.ec == std::errc()) {
+            *result.ptr = String::EOS;
+            return static_cast<int32_t>(result.ptr - out_str);
+        }
+#endif
+
+        int32_t length = std::snprintf(out_str, kNumberStrBufferSize, "%.*f", precision, value);
+        return std::clamp<int32_t>(length, 0, kNumberStrBufferSize - 1);
+    }
+
+
     inline bool String::isAlpha(char c) {
         return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
     }
@@ -3551,31 +3678,42 @@ namespace Grain {
 
     /**
      *  @brief Check memory capacity.
+     *
+     *  Makes sure, that the buffer has room for `needed` bytes plus EOS. When
+     *  it must grow, the capacity grows by at least the half, so a string built
+     *  by many appends is reallocated only a few times. Strings which outgrow
+     *  the inline buffer move to heap memory.
      */
     bool String::checkCapacity(int64_t needed) noexcept {
-        if (!data_ || byte_capacity_ < 0) {
-            int64_t new_capacity = needed + extra_grow_bytes_;
-            data_ = (char*)calloc(new_capacity + 1, 1);
+        if (needed <= byte_capacity_) {
+            return true;
+        }
+
+        // Allocation sizes are multiples of 16, the last byte is for EOS
+        int64_t new_capacity = std::max(needed, byte_capacity_ + byte_capacity_ / 2);
+        int64_t alloc_size = (new_capacity + 16) & ~static_cast<int64_t>(15);
 
-            if (!data_) {
+        if (data_ == local_data_) {
+            auto new_data = static_cast<char*>(std::malloc(alloc_size));
+            if (!new_data) {
                 return false;
             }
 
-            byte_capacity_ = new_capacity;
+            std::memcpy(new_data, local_data_, kLocalBufferSize);
+            data_ = new_data;
         }
-        else if (needed >= byte_capacity_) {  // Array must grow
-            int64_t new_capacity = needed + extra_grow_bytes_;
-            char* new_data = (char*)std::realloc(data_, new_capacity + 1);
-
+        else {
+            auto new_data = static_cast<char*>(std::realloc(data_, alloc_size));
             if (!new_data) {
                 return false;
             }
 
-            grow_count_++;
             data_ = new_data;
-            byte_capacity_ = new_capacity;
         }
 
+        grow_count_++;
+        byte_capacity_ = alloc_size - 1;
+
         return true;
     }
 
@@ -3606,6 +3744,38 @@ namespace Grain {
     }
 
 
+    /**
+     *  @brief Append bytes, which are known to be 7-bit ASCII characters.
+     */
+    bool String::_appendAscii(const char* str, int64_t byte_length) noexcept {
+        if (byte_length < 1 || !_checkExtraCapacity(byte_length)) {
+            return false;
+        }
+
+        memcpy(&data_[byte_len_], str, byte_length);
+        byte_len_ += byte_length;
+        character_len_ += byte_length;
+        data_[byte_len_] = String::EOS;
+
+        return true;
+    }
+
+
+    /**
+     *  @brief Release heap memory and return to the empty inline buffer.
+     */
+    void String::_freeData() noexcept {
+        if (data_ != local_data_) {
+            std::free(data_);
+            data_ = local_data_;
+        }
+
+        byte_capacity_ = kLocalBufferSize - 1;
+        byte_len_ = character_len_ = 0;
+        local_data_[0] = String::EOS;
+    }
+
+
     /**
      *  @brief Remove from data.
      */
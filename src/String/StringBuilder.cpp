@@ -0,0 +1,407 @@
+//
+//  StringBuilder.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "String/StringBuilder.hpp"
+
+#include <algorithm>
+#include <bit>
+
+
+namespace Grain {
+
+    StringArena::StringArena(int64_t block_size) noexcept {
+        block_size_ = std::max<int64_t>(block_size, 1024);
+    }
+
+
+    StringArena::~StringArena() noexcept {
+        for (auto& block : blocks_) {
+            std::free(block.data_);
+        }
+    }
+
+
+    /**
+     *  @brief The arena of the calling thread.
+     */
+    StringArena& StringArena::threadArena() noexcept {
+        thread_local StringArena arena;
+        return arena;
+    }
+
+
+    /**
+     *  @brief Number of allocations waiting for reuse in the free lists.
+     */
+    int64_t StringArena::freeCount() const noexcept {
+        int64_t result = 0;
+        for (auto& free_list : free_lists_) {
+            result += static_cast<int64_t>(free_list.size());
+        }
+        return result;
+    }
+
+
+    /**
+     *  @brief Allocate memory.
+     *
+     *  @param size Number of bytes, rounded up to `allocationSize(size)`.
+     *  @return Pointer to the memory or nullptr, if no memory could be
+     *          allocated.
+     */
+    char* StringArena::allocate(int64_t size) noexcept {
+        if (size > (static_cast<int64_t>(kMinAllocationSize) << (kSizeClassCount - 1))) {
+            return nullptr;
+        }
+
+        auto& free_list = free_lists_[_sizeClass(size)];
+        if (!free_list.empty()) {
+            char* ptr = free_list.back();
+            free_list.pop_back();
+            return ptr;
+        }
+
+        size = allocationSize(size);
+
+        if (!blocks_.empty() && block_used_ + size <= blocks_[block_index_].size_) {
+            char* ptr = blocks_[block_index_].data_ + block_used_;
+            block_used_ += size;
+            return ptr;
+        }
+
+        // Continue in the next block, a new one is inserted if it is missing or too small
+        size_t next_index = blocks_.empty() ? 0 : static_cast<size_t>(block_index_) + 1;
+
+        try {
+            if (next_index >= blocks_.size() || blocks_[next_index].size_ < size) {
+                Block block{};
+                block.size_ = std::max(block_size_, size);
+                block.data_ = static_cast<char*>(std::malloc(block.size_));
+                if (!block.data_) {
+                    return nullptr;
+                }
+
+                blocks_.insert(blocks_.begin() + static_cast<int64_t>(next_index), block);
+            }
+        }
+        catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+
+        block_index_ = static_cast<int32_t>(next_index);
+        block_used_ = size;
+
+        return blocks_[next_index].data_;
+    }
+
+
+    /**
+     *  @brief Grow an allocation in place.
+     *
+     *  Only the most recent allocation can grow.
+     *
+     *  @param ptr Memory returned by `allocate()`.
+     *  @param size Size given to `allocate()`.
+     *  @param new_size The new size.
+     *  @return `true` if the memory has grown, `false` if a new allocation is
+     *          needed.
+     */
+    bool StringArena::extend(const char* ptr, int64_t size, int64_t new_size) noexcept {
+        if (blocks_.empty() || !ptr) {
+            return false;
+        }
+
+        size = allocationSize(size);
+        new_size = allocationSize(new_size);
+        if (new_size <= size) {
+            return true;
+        }
+
+        const Block& block = blocks_[block_index_];
+        int64_t offs = ptr - block.data_;
+        if (ptr < block.data_ || offs + size != block_used_ || offs + new_size > block.size_) {
+            return false;
+        }
+
+        block_used_ = offs + new_size;
+
+        return true;
+    }
+
+
+    /**
+     *  @brief Give back memory.
+     *
+     *  The most recent allocation is returned to the current block. Other
+     *  memory goes to the free list of its size, for the next allocation of
+     *  that size.
+     *
+     *  @param ptr Memory returned by `allocate()`.
+     *  @param size Size given to `allocate()` or to the last `extend()`.
+     */
+    void StringArena::release(const char* ptr, int64_t size) noexcept {
+        if (blocks_.empty() || !ptr) {
+            return;
+        }
+
+        int32_t size_class = _sizeClass(size);
+        size = allocationSize(size);
+
+        const Block& block = blocks_[block_index_];
+        int64_t offs = ptr - block.data_;
+        if (ptr >= block.data_ && offs + size == block_used_) {
+            block_used_ = offs;
+            return;
+        }
+
+        try {
+            free_lists_[size_class].push_back(const_cast<char*>(ptr));
+        }
+        catch (const std::bad_alloc&) {
+            // The memory is reused after the next reset
+        }
+    }
+
+
+    void StringArena::detach() noexcept {
+        if (--user_count_ <= 0) {
+            user_count_ = 0;
+            reset();
+        }
+    }
+
+
+    /**
+     *  @brief Make all memory available again.
+     *
+     *  The blocks are kept. Memory allocated before is invalid afterwards.
+     */
+    void StringArena::reset() noexcept {
+        block_index_ = 0;
+        block_used_ = 0;
+        for (auto& free_list : free_lists_) {
+            free_list.clear();
+        }
+    }
+
+
+    int32_t StringArena::_sizeClass(int64_t size) noexcept {
+        auto units = static_cast<uint64_t>(std::max<int64_t>(size, 1) - 1) / kMinAllocationSize;
+        return std::min(static_cast<int32_t>(std::bit_width(units)), kSizeClassCount - 1);
+    }
+
+
+    /**
+     *  @brief Constructs an empty builder.
+     *
+     *  @param capacity Initial capacity in bytes.
+     *  @param arena Arena for the buffer, or nullptr to use heap memory.
+     */
+    StringBuilder::StringBuilder(int64_t capacity, StringArena* arena) noexcept {
+        arena_ = arena;
+        if (arena_) {
+            arena_->attach();
+        }
+
+        reserve(std::max<int64_t>(capacity, 16));
+    }
+
+
+    StringBuilder::~StringBuilder() noexcept {
+        if (arena_) {
+            arena_->release(data_, byte_capacity_ + 1);
+            arena_->detach();
+        }
+        else {
+            std::free(data_);
+        }
+    }
+
+
+    /**
+     *  @brief Empty the builder, the memory is kept.
+     */
+    void StringBuilder::clear() noexcept {
+        byte_len_ = 0;
+        if (data_) {
+            data_[0] = String::EOS;
+        }
+    }
+
+
+    /**
+     *  @brief Make sure, that `byte_count` more bytes can be appended without
+     *         growing the buffer.
+     */
+    bool StringBuilder::reserve(int64_t byte_count) noexcept {
+        return byte_len_ + byte_count <= byte_capacity_ || _grow(byte_len_ + byte_count);
+    }
+
+
+    /**
+     *  @brief Append a character.
+     *
+     *  @note Only 7-bit ASCII characters can be appended.
+     */
+    bool StringBuilder::appendChar(char c) noexcept {
+        if (c <= 0) {
+            return false;
+        }
+
+        if (byte_len_ + 1 > byte_capacity_ && !_grow(byte_len_ + 1)) {
+            return false;
+        }
+
+        data_[byte_len_++] = c;
+        data_[byte_len_] = String::EOS;
+
+        return true;
+    }
+
+
+    /**
+     *  @brief Append a character repeatedly.
+     *
+     *  @note Only 7-bit ASCII characters can be appended.
+     */
+    bool StringBuilder::appendChars(char c, int64_t n) noexcept {
+        if (c <= 0 || n < 1) {
+            return false;
+        }
+
+        if (byte_len_ + n > byte_capacity_ && !_grow(byte_len_ + n)) {
+            return false;
+        }
+
+        std::memset(&data_[byte_len_], c, n);
+        byte_len_ += n;
+        data_[byte_len_] = String::EOS;
+
+        return true;
+    }
+
+
+    bool StringBuilder::append(const char* str) noexcept {
+        return str && append(str, static_cast<int64_t>(strlen(str)));
+    }
+
+
+    /**
+     *  @brief Append bytes.
+     *
+     *  @param str UTF-8 encoded data.
+     *  @param byte_length Number of bytes to append, `str` must not contain
+     *                     EOS within this range.
+     */
+    bool StringBuilder::append(const char* str, int64_t byte_length) noexcept {
+        if (!str || byte_length < 1) {
+            return false;
+        }
+
+        if (byte_len_ + byte_length > byte_capacity_ && !_grow(byte_len_ + byte_length)) {
+            return false;
+        }
+
+        std::memcpy(&data_[byte_len_], str, byte_length);
+        byte_len_ += byte_length;
+        data_[byte_len_] = String::EOS;
+
+        return true;
+    }
+
+
+    bool StringBuilder::append(const String& string) noexcept {
+        return append(string.utf8(), string.byteLength());
+    }
+
+
+    bool StringBuilder::appendInt64(int64_t value) noexcept {
+        char buffer[String::kNumberStrBufferSize];
+        return append(buffer, String::formatInt64(value, buffer));
+    }
+
+
+    bool StringBuilder::appendUInt64(uint64_t value) noexcept {
+        char buffer[String::kNumberStrBufferSize];
+        return append(buffer, String::formatUInt64(value, buffer));
+    }
+
+
+    /**
+     *  @brief Append a double value with a fixed number of fractional digits.
+     *
+     *  @param value The value to append.
+     *  @param precision Number of fractional digits, 0 to 17.
+     */
+    bool StringBuilder::appendDouble(double value, int32_t precision) noexcept {
+        char buffer[String::kNumberStrBufferSize];
+        return append(buffer, String::formatDouble(value, precision, buffer));
+    }
+
+
+    /**
+     *  @brief Copy the content to a string.
+     *
+     *  The characters are counted here, once for the whole content.
+     */
+    bool StringBuilder::toString(String& out_string) const noexcept {
+        out_string.clear();
+        return byte_len_ < 1 || out_string.append(data_, byte_len_);
+    }
+
+
+    String StringBuilder::string() const noexcept {
+        String result(byte_len_);
+        toString(result);
+        return result;
+    }
+
+
+    bool StringBuilder::_grow(int64_t needed) noexcept {
+        int64_t new_capacity = std::max(needed, byte_capacity_ * 2);
+        char* new_data;
+
+        // Room for EOS, the arena rounds up to its allocation sizes anyway
+        int64_t alloc_size = arena_ ? StringArena::allocationSize(new_capacity + 1) : (new_capacity + 16) & ~static_cast<int64_t>(15);
+
+        if (arena_) {
+            if (data_ && arena_->extend(data_, byte_capacity_ + 1, alloc_size)) {
+                byte_capacity_ = alloc_size - 1;
+                return true;
+            }
+
+            new_data = arena_->allocate(alloc_size);
+            if (!new_data) {
+                return false;
+            }
+
+            if (data_) {
+                std::memcpy(new_data, data_, byte_len_ + 1);
+                arena_->release(data_, byte_capacity_ + 1);
+            }
+        }
+        else {
+            new_data = static_cast<char*>(std::realloc(data_, alloc_size));
+            if (!new_data) {
+                return false;
+            }
+        }
+
+        if (!data_) {
+            new_data[0] = String::EOS;
+        }
+
+        data_ = new_data;
+        byte_capacity_ = alloc_size - 1;
+
+        return true;
+    }
+
+
+} // End of namespace Grain
@@ -0,0 +1,126 @@
+//
+//  CVF2Benchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "2d/Data/CVF2.hpp"
+#include "2d/Data/CVF2File.hpp"
+#include "2d/Data/ValueGrid.hpp"
+#include "String/String.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Compares the row format of CVF2 version 2 with the block format of
+ *  version 3 on a terrain like grid of 4096 x 4096 values in millimeters.
+ *  Prints the file size, the write time, decoding of the whole grid in GB
+ *  of values per second and the latency of `CVF2File::valueAtPos()` at
+ *  random positions.
+ */
+
+static constexpr int32_t kSize = 4096;
+static constexpr int32_t kDecodeRuns = 3;
+static constexpr int32_t kLookupCount = 200000;
+
+static int64_t g_sink = 0;
+
+
+static void fillTerrain(ValueGridl& grid) {
+    uint32_t seed = 1;
+    for (int32_t y = 0; y < kSize; y++) {
+        for (int32_t x = 0; x < kSize; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            double height = 400.0 + 250.0 * std::sin(x * 0.0021) * std::cos(y * 0.0017) + 40.0 * std::sin(x * 0.013 + y * 0.009);
+            int64_t noise = static_cast<int64_t>(seed >> 28) - 8;
+            bool hole = x > 3000 && x < 3100 && y > 500 && y < 560;
+            grid.setValueAtXY(x, y, hole ? CVF2::kUndefinedValue : static_cast<int64_t>(height * 1000.0) + noise);
+        }
+    }
+}
+
+
+static void run(const char* name, const String& file_path, double write_seconds) {
+    auto file_size = static_cast<int64_t>(std::filesystem::file_size(file_path.utf8()));
+
+    double decode_seconds = 1.0e9;
+    for (int32_t run = 0; run < kDecodeRuns; run++) {
+        CVF2File file(file_path);
+        file.startRead();
+
+        ValueGridl* grid = nullptr;
+        Test::Stopwatch stopwatch;
+        if (file.buildValueGrid(&grid) != ErrorCode::None) {
+            std::printf("%s: decoding failed\n", name);
+            return;
+        }
+        decode_seconds = std::min(decode_seconds, stopwatch.seconds());
+        g_sink += grid->valueAtXY(kSize / 2, kSize / 2);
+        delete grid;
+    }
+
+    CVF2File file(file_path);
+    file.startRead();
+    uint32_t seed = 7;
+    Test::Stopwatch stopwatch;
+    for (int32_t i = 0; i < kLookupCount; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        Vec2i pos(static_cast<int32_t>((seed >> 8) % kSize), static_cast<int32_t>((seed >> 20) % kSize));
+        g_sink += file.valueAtPos(pos, false);
+    }
+    double lookup_seconds = stopwatch.seconds();
+
+    double value_bytes = static_cast<double>(kSize) * kSize * sizeof(int64_t);
+    std::printf("%-10s %10.2f %12.3f %10.2f %12.2f %12.2f\n",
+                name,
+                static_cast<double>(file_size) / (1024.0 * 1024.0),
+                static_cast<double>(file_size) * 8.0 / (static_cast<double>(kSize) * kSize),
+                write_seconds,
+                value_bytes / decode_seconds * 1.0e-9,
+                lookup_seconds * 1.0e9 / kLookupCount);
+}
+
+
+int main() {
+    ValueGridl grid(kSize, kSize);
+    fillTerrain(grid);
+    grid.setGeoInfo(25832, Bounds2d(400000.0, 5700000.0, 400000.0 + kSize - 1, 5700000.0 + kSize - 1));
+
+    auto dir_path = std::filesystem::temp_directory_path() / "grain_cvf2_benchmark";
+    std::filesystem::create_directories(dir_path);
+    String v2_path((dir_path / "v2.cvf").string().c_str());
+    String v3_path((dir_path / "v3.cvf").string().c_str());
+
+    Test::Stopwatch v2_stopwatch;
+    if (grid.writeCVF2File(v2_path, LengthUnit::Millimeter, 2, 4) != ErrorCode::None) {
+        std::printf("Writing version 2 failed\n");
+        return 1;
+    }
+    double v2_write_seconds = v2_stopwatch.seconds();
+
+    Test::Stopwatch v3_stopwatch;
+    if (grid.writeCVF2BlockFile(v3_path, LengthUnit::Millimeter) != ErrorCode::None) {
+        std::printf("Writing version 3 failed\n");
+        return 1;
+    }
+    double v3_write_seconds = v3_stopwatch.seconds();
+
+    std::printf("%-10s %10s %12s %10s %12s %12s\n", "format", "MB", "bits/value", "write s", "decode GB/s", "lookup ns");
+    run("v2 rows", v2_path, v2_write_seconds);
+    run("v3 blocks", v3_path, v3_write_seconds);
+
+    std::filesystem::remove_all(dir_path);
+
+    return g_sink == 12345 ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+//
+//  CVF2PyramidBuilderTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "2d/Data/CVF2.hpp"
+#include "2d/Data/CVF2Block.hpp"
+#include "2d/Data/CVF2PyramidBuilder.hpp"
+#include "2d/Data/CVF2TileManager.hpp"
+#include "Geo/GeoMetaTile.hpp"
+#include "String/String.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  A 4 x 4 grid of Web Mercator tiles is rendered into a pyramid of meta
+ *  tiles, once on the serial path of `CVF2TileManager`, once by the
+ *  pyramid builder on a single thread and once on several threads. All
+ *  three must write the same files with the same bytes.
+ */
+
+static constexpr int32_t kTileSize = 128;
+static constexpr int32_t kTilesX = 4;
+static constexpr int32_t kTilesY = 4;
+static constexpr int32_t kSRID = 3857;
+static constexpr double kCellSize = 500.0;
+static constexpr double kOriginX = 800000.0;
+static constexpr double kOriginY = 6400000.0;
+static constexpr int32_t kMaxZoom = 11;
+static constexpr int32_t kMinZoom = 8;
+
+
+static int64_t cellValue(int32_t gx, int32_t gy) {
+    if ((gx * 7 + gy * 3) % 101 == 0) {
+        return CVF2::kUndefinedValue;
+    }
+    return static_cast<int64_t>(100000.0 * std::sin(gx * 0.05) * std::cos(gy * 0.03)) + gx * 10 + gy;
+}
+
+
+static std::filesystem::path testDirPath() {
+    return std::filesystem::temp_directory_path() / "grain_cvf2_pyramid_builder_test";
+}
+
+
+static String writeTiles() {
+    auto dir_path = testDirPath() / "tiles";
+    std::filesystem::create_directories(dir_path);
+
+    std::vector<int64_t> values(kTileSize * kTileSize);
+    for (int32_t tile_y = 0; tile_y < kTilesY; tile_y++) {
+        for (int32_t tile_x = 0; tile_x < kTilesX; tile_x++) {
+            for (int32_t y = 0; y < kTileSize; y++) {
+                for (int32_t x = 0; x < kTileSize; x++) {
+                    values[y * kTileSize + x] = cellValue(tile_x * kTileSize + x, tile_y * kTileSize + y);
+                }
+            }
+
+            double tile_width = kTileSize * kCellSize;
+            double min_x = kOriginX + tile_x * tile_width;
+            double min_y = kOriginY + tile_y * tile_width;
+            Bounds2Fix bbox(min_x, min_y, min_x + tile_width - kCellSize, min_y + tile_width - kCellSize);
+
+            auto file_name = "tile_" + std::to_string(tile_x) + "_" + std::to_string(tile_y) + ".cvf";
+            String file_path((dir_path / file_name).string().c_str());
+            auto err = CVF2Block::writeFile(file_path, values.data(), kTileSize, kTileSize, kSRID, bbox, LengthUnit::Millimeter, 32, 1);
+            GRAIN_CHECK(err == ErrorCode::None);
+        }
+    }
+
+    return String(dir_path.string().c_str());
+}
+
+
+/**
+ *  Contents of all meta tile files below `dir_path`, by relative path.
+ */
+static std::map<std::string, std::string> readMetaTiles(const std::filesystem::path& dir_path) {
+    std::map<std::string, std::string> files;
+    for (auto& entry : std::filesystem::recursive_directory_iterator(dir_path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".cvf") {
+            std::ifstream stream(entry.path(), std::ios::binary);
+            files[std::filesystem::relative(entry.path(), dir_path).string()] =
+                std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+    }
+    return files;
+}
+
+
+static void checkSameFiles(const std::map<std::string, std::string>& expected, const std::map<std::string, std::string>& files, const char* name) {
+    int32_t mismatch_count = 0;
+    for (auto& [path, content] : expected) {
+        auto it = files.find(path);
+        if (it == files.end() || it->second != content) {
+            std::cerr << name << ": " << path << (it == files.end() ? " missing" : " differs") << std::endl;
+            mismatch_count++;
+        }
+    }
+    GRAIN_CHECK(mismatch_count == 0);
+    GRAIN_CHECK(files.size() == expected.size());
+}
+
+
+static void buildPyramid(CVF2TileManager& manager, const Bounds2d& bbox, const std::filesystem::path& dst_path, int32_t thread_count) {
+    CVF2PyramidBuilder builder(&manager, String(dst_path.string().c_str()), bbox, kMaxZoom, kMinZoom);
+    builder.setThreadCount(thread_count);
+    builder.setResume(false);
+    GRAIN_CHECK(builder.build() == ErrorCode::None);
+
+    auto stats = builder.stats();
+    GRAIN_CHECK(stats.failed_tile_count_ == 0);
+    GRAIN_CHECK(stats.skipped_tile_count_ == 0);
+    GRAIN_CHECK(stats.doneTileCount() == stats.total_tile_count_);
+}
+
+
+int main() {
+    std::filesystem::remove_all(testDirPath());
+    auto tiles_path = writeTiles();
+
+    CVF2TileManager manager(tiles_path, static_cast<int32_t>(kTileSize * kCellSize), static_cast<int32_t>(kTileSize * kCellSize), 4);
+    manager.setTileSRID(kSRID);
+    manager.enableTileCache();
+    GRAIN_CHECK(manager.scan() == ErrorCode::None);
+    GRAIN_CHECK(manager.start() == ErrorCode::None);
+    GRAIN_CHECK(manager.tileCount() == kTilesX * kTilesY);
+
+    // Inside the tiles, spanning several meta tiles at the finest level
+    Bounds2d bbox(7.5, 50.0, 9.0, 51.0);
+
+    // Serial path
+    auto serial_path = testDirPath() / "serial";
+    String serial_path_str(serial_path.string().c_str());
+    GRAIN_CHECK(manager.renderMetaTiles(serial_path_str, kMaxZoom, bbox, 1) == ErrorCode::None);
+    for (int32_t zoom = kMaxZoom; zoom > kMinZoom; zoom--) {
+        GeoMetaTileRange mtr(zoom, bbox);
+        GRAIN_CHECK(CVF2TileManager::renderDownsampledMetaTiles(serial_path_str, 4326, zoom, mtr.metaTileSize(), bbox) == ErrorCode::None);
+    }
+
+    auto expected = readMetaTiles(serial_path);
+    GRAIN_CHECK(GeoMetaTileRange(kMaxZoom, bbox).metaTilesNeeded() > 1);
+    GRAIN_CHECK(expected.size() > kMaxZoom - kMinZoom + 1);
+
+    buildPyramid(manager, bbox, testDirPath() / "single", 1);
+    checkSameFiles(expected, readMetaTiles(testDirPath() / "single"), "single thread");
+
+    buildPyramid(manager, bbox, testDirPath() / "parallel", 4);
+    checkSameFiles(expected, readMetaTiles(testDirPath() / "parallel"), "4 threads");
+
+    std::filesystem::remove_all(testDirPath());
+
+    return Grain::Test::result();
+}
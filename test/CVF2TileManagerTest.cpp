@@ -0,0 +1,201 @@
+//
+//  CVF2TileManagerTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "2d/Data/CVF2.hpp"
+#include "2d/Data/CVF2Block.hpp"
+#include "2d/Data/CVF2TileManager.hpp"
+#include "String/String.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  A 3 x 2 grid of tiles, one missing, with one unit per cell. Tile (1, 0)
+ *  holds values beyond the exact range of `double`.
+ */
+
+static constexpr int32_t kTileSize = 64;
+static constexpr int32_t kTilesX = 3;
+static constexpr int32_t kTilesY = 2;
+static constexpr int32_t kSRID = 25832;
+static constexpr double kOriginX = 400000.0;
+static constexpr double kOriginY = 5700000.0;
+
+
+static int64_t cellValue(int32_t tile_x, int32_t tile_y, int32_t x, int32_t y) {
+    int32_t gx = tile_x * kTileSize + x;
+    int32_t gy = tile_y * kTileSize + y;
+    if ((gx * 7 + gy * 3) % 29 == 0) {
+        return CVF2::kUndefinedValue;
+    }
+    int64_t value = gx * 1000 + gy;
+    return tile_x == 1 && tile_y == 0 ? (0x1LL << 55) + value : value;
+}
+
+
+static String writeTiles() {
+    auto dir_path = std::filesystem::temp_directory_path() / "grain_cvf2_tile_manager_test";
+    std::filesystem::remove_all(dir_path);
+    std::filesystem::create_directories(dir_path);
+
+    std::vector<int64_t> values(kTileSize * kTileSize);
+    for (int32_t tile_y = 0; tile_y < kTilesY; tile_y++) {
+        for (int32_t tile_x = 0; tile_x < kTilesX; tile_x++) {
+            if (tile_x == 2 && tile_y == 1) {
+                continue;   // Missing tile
+            }
+
+            for (int32_t y = 0; y < kTileSize; y++) {
+                for (int32_t x = 0; x < kTileSize; x++) {
+                    values[y * kTileSize + x] = cellValue(tile_x, tile_y, x, y);
+                }
+            }
+
+            double min_x = kOriginX + tile_x * kTileSize;
+            double min_y = kOriginY + tile_y * kTileSize;
+            Bounds2Fix bbox(min_x, min_y, min_x + kTileSize - 1, min_y + kTileSize - 1);
+
+            auto file_name = "tile_" + std::to_string(tile_x) + "_" + std::to_string(tile_y) + ".cvf";
+            String file_path((dir_path / file_name).string().c_str());
+            auto err = CVF2Block::writeFile(file_path, values.data(), kTileSize, kTileSize, kSRID, bbox, LengthUnit::Millimeter, 16, 1);
+            GRAIN_CHECK(err == ErrorCode::None);
+        }
+    }
+
+    return String(dir_path.string().c_str());
+}
+
+
+/**
+ *  Positions all over the tiles, at cell centers, between cells, on tile
+ *  borders and outside.
+ */
+static std::vector<Vec2d> samplePositions() {
+    std::vector<Vec2d> positions;
+    uint32_t seed = 1;
+    for (int32_t i = 0; i < 20000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double u = static_cast<double>(seed >> 8) / 16777216.0;
+        seed = seed * 1664525u + 1013904223u;
+        double v = static_cast<double>(seed >> 8) / 16777216.0;
+        positions.emplace_back(kOriginX - 10.0 + u * (kTilesX * kTileSize + 20.0), kOriginY - 10.0 + v * (kTilesY * kTileSize + 20.0));
+    }
+    for (int32_t x = -1; x <= kTilesX * kTileSize; x++) {
+        positions.emplace_back(kOriginX + x, kOriginY + 63.0);
+        positions.emplace_back(kOriginX + x, kOriginY + 64.0);
+        positions.emplace_back(kOriginX + x + 0.5, kOriginY + 63.5);
+    }
+    positions.emplace_back(NAN, kOriginY);
+    return positions;
+}
+
+
+static void checkNearest(CVF2TileManager& manager, const std::vector<Vec2d>& positions) {
+    auto n = static_cast<int64_t>(positions.size());
+    std::vector<double> values(n);
+    std::vector<int64_t> int64_values(n);
+    GRAIN_CHECK(manager.sampleMany(positions.data(), n, CVF2TileManager::SampleMode::Nearest, values.data()) == ErrorCode::None);
+    GRAIN_CHECK(manager.sampleMany(positions.data(), n, int64_values.data()) == ErrorCode::None);
+
+    int64_t mismatch_count = 0;
+    int64_t defined_count = 0;
+    for (int64_t i = 0; i < n; i++) {
+        int64_t expected = std::isnan(positions[i].x_) ? CVF2::kUndefinedValue : manager.valueAtPos(positions[i]);
+        if (expected == CVF2::kUndefinedValue) {
+            mismatch_count += std::isnan(values[i]) ? 0 : 1;
+        }
+        else {
+            defined_count++;
+            mismatch_count += values[i] == static_cast<double>(expected) ? 0 : 1;
+        }
+        mismatch_count += int64_values[i] == expected ? 0 : 1;
+    }
+
+    GRAIN_CHECK(mismatch_count == 0);
+    GRAIN_CHECK(defined_count > n / 2);
+}
+
+
+/**
+ *  Bilinear interpolation at cell positions returns the cell, between the
+ *  last cell of a tile and the first of its neighbour the mean of both.
+ *  Positions next to undefined cells are left out, as rounding of the
+ *  fractions may let them contribute.
+ */
+static void checkBilinear(CVF2TileManager& manager) {
+    std::vector<Vec2d> positions;
+    std::vector<double> expected;
+
+    auto defined = [](std::initializer_list<int64_t> values) {
+        for (auto value : values) {
+            if (value == CVF2::kUndefinedValue) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (int32_t y = 1; y < kTileSize - 1; y++) {
+        // Cell positions inside tile (0, 0)
+        int64_t a = cellValue(0, 0, 10, y);
+        if (defined({ a, cellValue(0, 0, 11, y), cellValue(0, 0, 10, y + 1), cellValue(0, 0, 11, y + 1) })) {
+            positions.emplace_back(kOriginX + 10.0, kOriginY + y);
+            expected.push_back(static_cast<double>(a));
+        }
+
+        // Between tile (0, 0) and (1, 0)
+        a = cellValue(0, 0, kTileSize - 1, y);
+        int64_t b = cellValue(1, 0, 0, y);
+        if (defined({ a, b, cellValue(0, 0, kTileSize - 1, y + 1), cellValue(1, 0, 0, y + 1) })) {
+            positions.emplace_back(kOriginX + kTileSize - 0.5, kOriginY + y);
+            expected.push_back(0.5 * static_cast<double>(a) + 0.5 * static_cast<double>(b));
+        }
+    }
+    GRAIN_CHECK(positions.size() > kTileSize);
+
+    std::vector<double> values(positions.size());
+    GRAIN_CHECK(manager.sampleMany(positions.data(), static_cast<int64_t>(positions.size()), CVF2TileManager::SampleMode::Bilinear, values.data()) == ErrorCode::None);
+
+    int32_t mismatch_count = 0;
+    for (size_t i = 0; i < positions.size(); i++) {
+        if (!(std::fabs(values[i] - expected[i]) <= std::fabs(expected[i]) * 1.0e-9)) {
+            mismatch_count++;
+        }
+    }
+    GRAIN_CHECK(mismatch_count == 0);
+}
+
+
+int main() {
+    auto dir_path = writeTiles();
+
+    CVF2TileManager manager(dir_path, kTileSize, kTileSize, 4);
+    manager.setTileSRID(kSRID);
+    GRAIN_CHECK(manager.scan() == ErrorCode::None);
+    GRAIN_CHECK(manager.start() == ErrorCode::None);
+    GRAIN_CHECK(manager.tileCount() == kTilesX * kTilesY);
+
+    auto positions = samplePositions();
+    checkNearest(manager, positions);
+    manager.enableTileCache();
+    checkNearest(manager, positions);
+    manager.disableTileCache();
+
+    checkBilinear(manager);
+
+    std::filesystem::remove_all(std::filesystem::path(dir_path.utf8()));
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,127 @@
+//
+//  GeoProjApproxTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Geo/GeoProj.hpp"
+#include "Geo/GeoProjApprox.hpp"
+
+#include <cmath>
+
+using namespace Grain;
+
+
+/**
+ *  The approximation is compared to the exact transformation at positions
+ *  which don't fall onto the grid of exactly transformed cell positions.
+ *
+ *  For smooth projections the bilinear error of a cell is largest at the
+ *  midpoints checked by `setup()`, a small margin covers higher order
+ *  terms.
+ */
+
+static constexpr double kErrorMargin = 1.25;
+
+
+/**
+ *  Simple deterministic generator, values in [0, 1).
+ */
+static double nextRandom() {
+    static uint32_t seed = 1;
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<double>(seed >> 8) / 16777216.0;
+}
+
+
+static void checkErrorBound(int32_t src_srid, int32_t dst_srid, const Rectd& src_rect, double max_error) {
+    GeoProj proj(src_srid, dst_srid);
+    GRAIN_CHECK(proj.isValid());
+
+    GeoProjApprox approx(&proj);
+    GRAIN_CHECK(approx.setup(src_rect, max_error) == ErrorCode::None);
+    GRAIN_CHECK(approx.isSetup());
+    GRAIN_CHECK(approx.leafCount() > 0);
+
+    double max_deviation = 0.0;
+    int32_t failed_count = 0;
+    for (int32_t i = 0; i < 20000; i++) {
+        Vec2d pos(src_rect.x_ + nextRandom() * src_rect.width_, src_rect.y_ + nextRandom() * src_rect.height_);
+        Vec2d exact_pos, approx_pos;
+        if (!proj.transform(pos, exact_pos) || !approx.transform(pos, approx_pos)) {
+            failed_count++;
+            continue;
+        }
+        max_deviation = std::max(max_deviation, exact_pos.distance(approx_pos));
+    }
+
+    if (failed_count > 0 || max_deviation > max_error * kErrorMargin) {
+        std::cerr << src_srid << " -> " << dst_srid << ": max deviation " << max_deviation;
+        std::cerr << ", bound " << max_error << ", failed " << failed_count << ", " << approx << std::endl;
+    }
+    GRAIN_CHECK(failed_count == 0);
+    GRAIN_CHECK(max_deviation <= max_error * kErrorMargin);
+
+    // A looser bound needs fewer cells
+    GeoProjApprox coarse(&proj);
+    GRAIN_CHECK(coarse.setup(src_rect, max_error * 100.0) == ErrorCode::None);
+    GRAIN_CHECK(coarse.leafCount() <= approx.leafCount());
+}
+
+
+/**
+ *  A region outside the domain of the projection must not be subdivided,
+ *  every transformation there fails anyway.
+ */
+static void checkOutsideDomain() {
+    GeoProj proj(4326, 3857);
+    GRAIN_CHECK(proj.isValid());
+
+    Vec2d pos(10.0, 100.0), out_pos;
+    if (proj.transform(pos, out_pos)) {
+        std::cerr << "Latitude 100 transformed, outside domain not checked" << std::endl;
+        return;
+    }
+
+    GeoProjApprox approx(&proj);
+    GRAIN_CHECK(approx.setup(Rectd(0.0, 95.0, 20.0, 20.0), 0.01, 6) == ErrorCode::None);
+    GRAIN_CHECK(approx.cellCount() == 1);
+    GRAIN_CHECK(approx.exactTransformCount() == 9);
+    GRAIN_CHECK(!approx.transform(pos, out_pos));
+
+    // Partly outside, only the valid part is refined below the error bound
+    GRAIN_CHECK(approx.setup(Rectd(0.0, 60.0, 20.0, 60.0), 0.01, 8) == ErrorCode::None);
+    GRAIN_CHECK(approx.cellCount() < 4 * (1 << 16));
+    GRAIN_CHECK(approx.transform(Vec2d(10.0, 70.0), out_pos));
+    GRAIN_CHECK(!approx.transform(pos, out_pos));
+
+    // A failed transformation must not fail the following ones
+    GRAIN_CHECK(proj.transform(Vec2d(10.0, 50.0), out_pos));
+}
+
+
+int main() {
+    // Geographic to Web Mercator, bound in meters
+    checkErrorBound(4326, 3857, Rectd(5.0, 45.0, 10.0, 10.0), 0.1);
+
+    // Web Mercator to geographic, bound in degrees
+    checkErrorBound(3857, 4326, Rectd(500000.0, 5600000.0, 1200000.0, 1800000.0), 1.0e-6);
+
+    // Geographic to UTM zone 32N
+    checkErrorBound(4326, 32632, Rectd(6.0, 47.0, 6.0, 8.0), 0.1);
+
+    // ETRS89 UTM zone 32N to Web Mercator
+    checkErrorBound(25832, 3857, Rectd(280000.0, 5200000.0, 640000.0, 900000.0), 0.1);
+
+    // Geographic to ETRS89 Lambert azimuthal equal area, a continental region
+    checkErrorBound(4326, 3035, Rectd(-10.0, 35.0, 40.0, 35.0), 1.0);
+
+    checkOutsideDomain();
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,63 @@
+//
+//  GrainTest.hpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#ifndef GrainTest_hpp
+#define GrainTest_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+
+namespace Grain::Test {
+
+    /**
+     *  @brief Minimal support for the test and benchmark executables.
+     *
+     *  A test counts failed checks with `GRAIN_CHECK()` and returns
+     *  `result()` from `main()`, so that CTest sees the outcome.
+     */
+    inline int32_t g_failure_count = 0;
+
+    inline void fail(const char* expr, const char* file, int32_t line) {
+        std::cerr << file << ":" << line << ": check failed: " << expr << std::endl;
+        g_failure_count++;
+    }
+
+    inline int result() {
+        if (g_failure_count > 0) {
+            std::cerr << g_failure_count << " check(s) failed" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+
+    /**
+     *  @brief Wall clock time since construction.
+     */
+    class Stopwatch {
+    public:
+        Stopwatch() noexcept : start_(std::chrono::steady_clock::now()) {}
+
+        [[nodiscard]] double seconds() const noexcept {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+
+    protected:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+} // End of namespace Grain::Test
+
+
+#define GRAIN_CHECK(expr) \
+    do { if (!(expr)) { Grain::Test::fail(#expr, __FILE__, __LINE__); } } while (0)
+
+#endif // GrainTest_hpp
@@ -0,0 +1,267 @@
+//
+//  ImageConvolutionTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Image/Image.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  The filters of `Image` are compared to a naive 2D convolution in double
+ *  precision, with border pixels repeated, on odd image sizes.
+ */
+
+static constexpr int32_t kWidth = 97;
+static constexpr int32_t kHeight = 61;
+
+
+/**
+ *  Simple deterministic generator, values in [0, 1).
+ */
+static double nextRandom() {
+    static uint32_t seed = 1;
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<double>(seed >> 8) / 16777216.0;
+}
+
+
+template <typename T>
+static T* componentPtr(Image* image, int32_t x, int32_t y, int32_t c) {
+    return reinterpret_cast<T*>(image->pixelDataPtrAtRow(y)) + x * image->componentCount() + c;
+}
+
+
+template <typename T>
+static void fillRandom(Image* image, double max) {
+    for (int32_t y = 0; y < image->height(); y++) {
+        for (int32_t x = 0; x < image->width(); x++) {
+            for (int32_t c = 0; c < image->componentCount(); c++) {
+                *componentPtr<T>(image, x, y, c) = static_cast<T>(nextRandom() * max);
+            }
+        }
+    }
+}
+
+
+/**
+ *  Component `c` of `image` convolved with `kernel`, as double values.
+ */
+template <typename T>
+static std::vector<double> naiveConvolution(Image* image, int32_t c, const std::vector<float>& kernel, int32_t kernel_width, int32_t kernel_height) {
+    int32_t width = image->width();
+    int32_t height = image->height();
+    std::vector<double> result(static_cast<size_t>(width) * height);
+
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            double sum = 0.0;
+            for (int32_t j = 0; j < kernel_height; j++) {
+                int32_t sy = std::clamp(y + j - kernel_height / 2, 0, height - 1);
+                for (int32_t i = 0; i < kernel_width; i++) {
+                    int32_t sx = std::clamp(x + i - kernel_width / 2, 0, width - 1);
+                    sum += kernel[j * kernel_width + i] * static_cast<double>(*componentPtr<T>(image, sx, sy, c));
+                }
+            }
+            result[static_cast<size_t>(y) * width + x] = sum;
+        }
+    }
+
+    return result;
+}
+
+
+template <typename T>
+static int32_t countMismatches(Image* image, int32_t c, const std::vector<double>& expected, double tolerance) {
+    int32_t mismatch_count = 0;
+    for (int32_t y = 0; y < image->height(); y++) {
+        for (int32_t x = 0; x < image->width(); x++) {
+            double value = *componentPtr<T>(image, x, y, c);
+            if (!(std::fabs(value - expected[static_cast<size_t>(y) * image->width() + x]) <= tolerance)) {
+                mismatch_count++;
+            }
+        }
+    }
+    return mismatch_count;
+}
+
+
+static std::vector<float> gaussianKernel(int32_t radius, float sigma) {
+    std::vector<float> kernel(radius * 2 + 1);
+    double sum = 0.0;
+    for (int32_t i = 0; i < static_cast<int32_t>(kernel.size()); i++) {
+        double d = i - radius;
+        kernel[i] = static_cast<float>(std::exp(-d * d / (2.0 * sigma * sigma)));
+        sum += kernel[i];
+    }
+    for (auto& k : kernel) {
+        k = static_cast<float>(k / sum);
+    }
+    return kernel;
+}
+
+
+static std::vector<float> outerProduct(const std::vector<float>& column, const std::vector<float>& row) {
+    std::vector<float> kernel;
+    for (float a : column) {
+        for (float b : row) {
+            kernel.push_back(a * b);
+        }
+    }
+    return kernel;
+}
+
+
+/**
+ *  A kernel of full rank, applied by the direct 2D path.
+ */
+static void checkNonSeparable() {
+    std::unique_ptr<Image> image(Image::createRGBFloat(kWidth, kHeight));
+    std::unique_ptr<Image> out_image(Image::createRGBFloat(kWidth, kHeight));
+    fillRandom<float>(image.get(), 1.0);
+
+    constexpr int32_t kernel_width = 5;
+    constexpr int32_t kernel_height = 3;
+    std::vector<float> kernel(kernel_width * kernel_height);
+    for (auto& k : kernel) {
+        k = static_cast<float>(nextRandom() - 0.3);
+    }
+
+    GRAIN_CHECK(image->convolution(-1, Dimensioni(kernel_width, kernel_height), kernel.data(), out_image.get()) == ErrorCode::None);
+    for (int32_t c = 0; c < 3; c++) {
+        auto expected = naiveConvolution<float>(image.get(), c, kernel, kernel_width, kernel_height);
+        GRAIN_CHECK(countMismatches<float>(out_image.get(), c, expected, 1.0e-5) == 0);
+    }
+}
+
+
+/**
+ *  A Gaussian kernel of rank 1, applied as two passes. Only channel 1 is
+ *  filtered, the result is written to the image itself.
+ */
+static void checkSeparableInPlace() {
+    std::unique_ptr<Image> image(Image::createRGBFloat(kWidth, kHeight));
+    fillRandom<float>(image.get(), 1.0);
+
+    auto kernel_1d = gaussianKernel(4, 1.7f);
+    auto kernel = outerProduct(kernel_1d, kernel_1d);
+    auto size = static_cast<int32_t>(kernel_1d.size());
+
+    std::vector<double> expected[3];
+    for (int32_t c = 0; c < 3; c++) {
+        expected[c] = c == 1 ? naiveConvolution<float>(image.get(), c, kernel, size, size) : naiveConvolution<float>(image.get(), c, { 1.0f }, 1, 1);
+    }
+
+    GRAIN_CHECK(image->convolution(1, Dimensioni(size, size), kernel.data(), image.get()) == ErrorCode::None);
+    for (int32_t c = 0; c < 3; c++) {
+        GRAIN_CHECK(countMismatches<float>(image.get(), c, expected[c], 1.0e-5) == 0);
+    }
+}
+
+
+/**
+ *  Integer components are rounded and clamped to their range.
+ */
+static void checkUInt8() {
+    std::unique_ptr<Image> image(new Image(Color::Model::RGBA, kWidth, kHeight, Image::PixelType::UInt8));
+    std::unique_ptr<Image> out_image(new Image(Color::Model::RGBA, kWidth, kHeight, Image::PixelType::UInt8));
+    fillRandom<uint8_t>(image.get(), 256.0);
+
+    // Sharpening, results leave the range
+    std::vector<float> kernel = { 0.0f, -1.0f, 0.0f, -1.0f, 5.0f, -1.0f, 0.0f, -1.0f, 0.0f };
+    GRAIN_CHECK(image->convolution(-1, Dimensioni(3, 3), kernel.data(), out_image.get()) == ErrorCode::None);
+
+    for (int32_t c = 0; c < 4; c++) {
+        auto expected = naiveConvolution<uint8_t>(image.get(), c, kernel, 3, 3);
+        for (auto& value : expected) {
+            value = std::clamp(std::floor(value + 0.5), 0.0, 255.0);
+        }
+        GRAIN_CHECK(countMismatches<uint8_t>(out_image.get(), c, expected, 0.0) == 0);
+    }
+}
+
+
+/**
+ *  Box blurs by running sums equal a box kernel, over the image border
+ *  for large radii.
+ */
+static void checkBoxBlur() {
+    std::unique_ptr<Image> image(Image::createLuminaFloat(kWidth, kHeight));
+    std::unique_ptr<Image> out_image(Image::createLuminaFloat(kWidth, kHeight));
+    fillRandom<float>(image.get(), 1.0);
+
+    for (int32_t radius : { 1, 4, 70 }) {
+        int32_t size = radius * 2 + 1;
+        std::vector<float> kernel(static_cast<size_t>(size) * size, 1.0f / static_cast<float>(size * size));
+
+        GRAIN_CHECK(image->boxBlur(0, radius, 1, out_image.get()) == ErrorCode::None);
+        auto expected = naiveConvolution<float>(image.get(), 0, kernel, size, size);
+        GRAIN_CHECK(countMismatches<float>(out_image.get(), 0, expected, 1.0e-4) == 0);
+    }
+}
+
+
+/**
+ *  Small sigmas use a sampled Gaussian kernel of radius `3 * sigma`, large
+ *  ones three box blurs, which keep constant images and the mean.
+ */
+static void checkGaussianBlur() {
+    std::unique_ptr<Image> image(Image::createLuminaFloat(kWidth, kHeight));
+    std::unique_ptr<Image> out_image(Image::createLuminaFloat(kWidth, kHeight));
+    fillRandom<float>(image.get(), 1.0);
+
+    float sigma = 1.5f;
+    auto kernel_1d = gaussianKernel(static_cast<int32_t>(std::ceil(3.0f * sigma)), sigma);
+    auto size = static_cast<int32_t>(kernel_1d.size());
+    GRAIN_CHECK(image->gaussianBlur(0, sigma, out_image.get()) == ErrorCode::None);
+    auto expected = naiveConvolution<float>(image.get(), 0, outerProduct(kernel_1d, kernel_1d), size, size);
+    GRAIN_CHECK(countMismatches<float>(out_image.get(), 0, expected, 1.0e-5) == 0);
+
+    std::vector<double> constant(static_cast<size_t>(kWidth) * kHeight, 0.25);
+    for (int32_t y = 0; y < kHeight; y++) {
+        for (int32_t x = 0; x < kWidth; x++) {
+            *componentPtr<float>(image.get(), x, y, 0) = 0.25f;
+        }
+    }
+    GRAIN_CHECK(image->gaussianBlur(0, 8.0f, out_image.get()) == ErrorCode::None);
+    GRAIN_CHECK(countMismatches<float>(out_image.get(), 0, constant, 1.0e-5) == 0);
+}
+
+
+static void checkErrors() {
+    std::unique_ptr<Image> image(Image::createRGBFloat(kWidth, kHeight));
+    std::unique_ptr<Image> small_image(Image::createRGBFloat(kWidth - 1, kHeight));
+    std::unique_ptr<Image> lumina_image(Image::createLuminaFloat(kWidth, kHeight));
+    float kernel[1] = { 1.0f };
+
+    GRAIN_CHECK(image->convolution(-1, Dimensioni(1, 1), nullptr, image.get()) == ErrorCode::NullData);
+    GRAIN_CHECK(image->convolution(-1, Dimensioni(0, 1), kernel, image.get()) == ErrorCode::BadArgs);
+    GRAIN_CHECK(image->convolution(3, Dimensioni(1, 1), kernel, image.get()) == ErrorCode::InvalidChannel);
+    GRAIN_CHECK(image->convolution(-1, Dimensioni(1, 1), kernel, small_image.get()) == ErrorCode::UnsupportedDimension);
+    GRAIN_CHECK(image->convolution(-1, Dimensioni(1, 1), kernel, lumina_image.get()) == ErrorCode::FormatMismatch);
+    GRAIN_CHECK(image->boxBlur(-1, -1, 1, image.get()) == ErrorCode::BadArgs);
+    GRAIN_CHECK(image->gaussianBlur(-1, -1.0f, image.get()) == ErrorCode::BadArgs);
+}
+
+
+int main() {
+    checkNonSeparable();
+    checkSeparableInPlace();
+    checkUInt8();
+    checkBoxBlur();
+    checkGaussianBlur();
+    checkErrors();
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,142 @@
+//
+//  ImageEncodeBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Image/Image.hpp"
+#include "String/String.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace Grain;
+
+
+/**
+ *  Prints the PNG encoding speed in MB of RGBA pixels per second and the
+ *  average file size for each `Image::EncodePreset`, on map like tiles of
+ *  256 x 256 and 512 x 512 pixels: flat areas, straight roads and a shaded
+ *  terrain, partly textured with noise.
+ */
+
+static constexpr int32_t kTileCount = 64;
+
+static int64_t g_sink = 0;
+
+
+static void fillTile(Image* image, int32_t tile_index) {
+    int32_t size = image->width();
+    int32_t ox = tile_index * 173;
+    int32_t oy = tile_index * 97;
+    uint32_t seed = static_cast<uint32_t>(tile_index) + 1;
+
+    for (int32_t y = 0; y < size; y++) {
+        uint8_t* row = image->mutPixelDataPtr() + static_cast<size_t>(y) * image->bytesPerRow();
+        for (int32_t x = 0; x < size; x++) {
+            int32_t gx = ox + x;
+            int32_t gy = oy + y;
+            seed = seed * 1664525u + 1013904223u;
+
+            // Land use areas with a shaded terrain, woods are textured
+            int32_t area = ((gx / 90) * 7 + (gy / 70) * 3) % 4;
+            double shade = 0.85 + 0.15 * std::sin(gx * 0.021) * std::cos(gy * 0.017);
+            double noise = area == 2 ? static_cast<double>(seed >> 29) - 3.5 : 0.0;
+            uint8_t r = static_cast<uint8_t>(std::clamp((area == 0 ? 242.0 : area == 1 ? 205.0 : area == 2 ? 170.0 : 224.0) * shade + noise, 0.0, 255.0));
+            uint8_t g = static_cast<uint8_t>(std::clamp((area == 0 ? 239.0 : area == 1 ? 230.0 : area == 2 ? 211.0 : 224.0) * shade + noise, 0.0, 255.0));
+            uint8_t b = static_cast<uint8_t>(std::clamp((area == 0 ? 233.0 : area == 1 ? 190.0 : area == 2 ? 240.0 : 224.0) * shade + noise, 0.0, 255.0));
+            uint8_t a = 255;
+
+            // Roads and a transparent border region
+            if (gx % 211 < 6 || gy % 157 < 4) {
+                r = 255; g = 250; b = 200;
+            }
+            if ((gx + gy) % 389 < 3) {
+                r = 120; g = 120; b = 120;
+            }
+            if (gx % 1000 < 40) {
+                a = 0;
+            }
+
+            uint8_t* p = row + x * 4;
+            p[0] = r; p[1] = g; p[2] = b; p[3] = a;
+        }
+    }
+}
+
+
+static void runSize(int32_t size, const std::filesystem::path& dir_path) {
+    std::unique_ptr<Image> tiles[kTileCount];
+    for (int32_t i = 0; i < kTileCount; i++) {
+        tiles[i].reset(new (std::nothrow) Image(Color::Model::RGBA, size, size, Image::PixelType::UInt8));
+        if (!tiles[i] || !tiles[i]->hasPixel()) {
+            std::printf("Can't allocate image\n");
+            return;
+        }
+        fillTile(tiles[i].get(), i);
+    }
+
+    std::printf("\n%d x %d, %d tiles\n", size, size, kTileCount);
+    std::printf("%-12s %10s %10s %10s %10s\n", "preset", "ms/tile", "MB/s", "KB/tile", "ratio");
+
+    struct Preset {
+        const char* name;
+        Image::EncodePreset preset;
+    };
+    const Preset presets[] = {
+        { "Default", Image::EncodePreset::Default },
+        { "TileSpeed", Image::EncodePreset::TileSpeed },
+        { "Smallest", Image::EncodePreset::Smallest }
+    };
+
+    double raw_bytes = static_cast<double>(size) * size * 4.0 * kTileCount;
+
+    for (auto& preset : presets) {
+        auto settings = Image::PngSettings::preset(preset.preset);
+
+        Test::Stopwatch stopwatch;
+        for (int32_t i = 0; i < kTileCount; i++) {
+            String file_path((dir_path / (std::to_string(i) + ".png")).string().c_str());
+            if (tiles[i]->writePng(file_path, settings) != ErrorCode::None) {
+                std::printf("%-12s failed\n", preset.name);
+                return;
+            }
+        }
+        double seconds = stopwatch.seconds();
+
+        int64_t file_bytes = 0;
+        for (int32_t i = 0; i < kTileCount; i++) {
+            file_bytes += static_cast<int64_t>(std::filesystem::file_size(dir_path / (std::to_string(i) + ".png")));
+        }
+        g_sink += file_bytes;
+
+        std::printf("%-12s %10.3f %10.1f %10.1f %10.2f\n",
+                    preset.name,
+                    seconds * 1.0e3 / kTileCount,
+                    raw_bytes / seconds * 1.0e-6,
+                    static_cast<double>(file_bytes) / kTileCount / 1024.0,
+                    raw_bytes / static_cast<double>(file_bytes));
+    }
+}
+
+
+int main() {
+    auto dir_path = std::filesystem::temp_directory_path() / "grain_image_encode_benchmark";
+    std::filesystem::create_directories(dir_path);
+
+    runSize(256, dir_path);
+    runSize(512, dir_path);
+
+    std::filesystem::remove_all(dir_path);
+
+    return g_sink == 12345 ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+//
+//  ImageResampleBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Image/Image.hpp"
+
+#include <cstdio>
+#include <memory>
+
+using namespace Grain;
+
+
+/**
+ *  Prints milliseconds and million source pixels per second of
+ *  `Image::downscale()` and of `Image::resample()` with each filter, for a
+ *  4096 x 4096 image in RGBA UInt8 and in RGB float, scaled down by
+ *  integer and by fractional factors.
+ */
+
+static constexpr int32_t kSrcSize = 4096;
+
+static double g_sink = 0.0;
+
+
+template <typename F>
+static void run(const char* name, int32_t dst_size, F fn) {
+    Test::Stopwatch stopwatch;
+    auto err = fn();
+    double seconds = stopwatch.seconds();
+
+    if (err != ErrorCode::None) {
+        std::printf("%-24s %8d %10s\n", name, dst_size, "failed");
+        return;
+    }
+    std::printf("%-24s %8d %10.2f %10.1f\n", name, dst_size, seconds * 1.0e3, static_cast<double>(kSrcSize) * kSrcSize / seconds * 1.0e-6);
+}
+
+
+static void runFormat(const char* format_name, Color::Model color_model, Image::PixelType pixel_type) {
+    std::unique_ptr<Image> image(new (std::nothrow) Image(color_model, kSrcSize, kSrcSize, pixel_type));
+    if (!image || !image->hasPixel()) {
+        std::printf("Can't allocate image\n");
+        return;
+    }
+
+    // Smooth gradients with fine detail
+    uint8_t* data = image->mutPixelDataPtr();
+    int32_t cn = image->componentCount();
+    for (int32_t y = 0; y < kSrcSize; y++) {
+        uint8_t* row = data + static_cast<size_t>(y) * image->bytesPerRow();
+        for (int32_t x = 0; x < kSrcSize; x++) {
+            for (int32_t c = 0; c < cn; c++) {
+                float v = static_cast<float>(((x * (c + 1) + y * 3) & 255) ^ ((x >> 3) & 15)) / 255.0f;
+                if (pixel_type == Image::PixelType::Float) {
+                    reinterpret_cast<float*>(row)[x * cn + c] = v;
+                }
+                else {
+                    row[x * cn + c] = static_cast<uint8_t>(v * 255.0f);
+                }
+            }
+        }
+    }
+
+    std::printf("\n%s\n", format_name);
+    std::printf("%-24s %8s %10s %10s\n", "method", "dst size", "ms", "M src px/s");
+
+    for (int32_t dst_size : { 2048, 1024, 1000, 683 }) {
+        std::unique_ptr<Image> dst_image(new (std::nothrow) Image(color_model, dst_size, dst_size, pixel_type));
+        if (!dst_image || !dst_image->hasPixel()) {
+            std::printf("Can't allocate image\n");
+            return;
+        }
+
+        run("downscale", dst_size, [&]() {
+            return image->downscale(dst_image.get());
+        });
+        run("resample, area", dst_size, [&]() {
+            return image->resample(dst_image.get(), Image::ResampleFilter::Area);
+        });
+        run("resample, bilinear", dst_size, [&]() {
+            return image->resample(dst_image.get(), Image::ResampleFilter::Bilinear);
+        });
+        run("resample, Catmull-Rom", dst_size, [&]() {
+            return image->resample(dst_image.get(), Image::ResampleFilter::CatmullRom);
+        });
+        run("resample, Lanczos3", dst_size, [&]() {
+            return image->resample(dst_image.get(), Image::ResampleFilter::Lanczos3);
+        });
+        run("resample, Lanczos3 lin.", dst_size, [&]() {
+            return image->resample(dst_image.get(), Image::ResampleFilter::Lanczos3, true);
+        });
+
+        g_sink += dst_image->pixelDataPtr()[0];
+    }
+}
+
+
+int main() {
+    runFormat("RGBA UInt8", Color::Model::RGBA, Image::PixelType::UInt8);
+    runFormat("RGB float", Color::Model::RGB, Image::PixelType::Float);
+
+    return g_sink == 12345.0 ? 1 : 0;
+}
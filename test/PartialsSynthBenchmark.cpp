@@ -0,0 +1,107 @@
+//
+//  PartialsSynthBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "DSP/PartialsSynth.hpp"
+#include "DSP/Partials.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Prints the real time factor of `PartialsSynth` and of a direct sum of
+ *  oscillators with `std::cos()`, for the same frames.
+ */
+
+static constexpr int32_t kSampleRate = 48000;
+static constexpr int32_t kFrameHop = 512;
+static constexpr int32_t kFrameCount = 1000;
+
+static float g_sink = 0.0f;
+
+
+static double synthTime(const std::vector<std::unique_ptr<Partials>>& frames, int32_t fft_len) {
+    PartialsSynth synth(kSampleRate, kFrameHop, fft_len);
+    std::vector<float> block(kFrameHop);
+
+    Test::Stopwatch stopwatch;
+    for (auto& frame : frames) {
+        synth.pushFrame(frame.get());
+        while (int64_t n = synth.pull(block.data(), kFrameHop)) {
+            g_sink += block[n - 1];
+        }
+    }
+    synth.finish();
+    while (int64_t n = synth.pull(block.data(), kFrameHop)) {
+        g_sink += block[n - 1];
+    }
+    return stopwatch.seconds();
+}
+
+
+static double directTime(const std::vector<std::unique_ptr<Partials>>& frames, int32_t resolution) {
+    std::vector<float> out(static_cast<size_t>(kFrameCount - 1) * kFrameHop, 0.0f);
+    float base_freq = static_cast<float>(kSampleRate) / static_cast<float>(2 * resolution);
+
+    Test::Stopwatch stopwatch;
+    for (int32_t i = 0; i < resolution; i++) {
+        float phase = frames[0]->mutPhasePtr()[i];
+        float inc = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i + 1) * base_freq / kSampleRate;
+        for (int32_t k = 0; k < kFrameCount - 1; k++) {
+            float a = frames[k]->mutMagPtr()[i];
+            float da = (frames[k + 1]->mutMagPtr()[i] - a) / kFrameHop;
+            float* d = &out[static_cast<size_t>(k) * kFrameHop];
+            for (int32_t n = 0; n < kFrameHop; n++) {
+                d[n] += a * std::cos(phase);
+                a += da;
+                phase += inc;
+                if (phase > std::numbers::pi_v<float>) {
+                    phase -= 2.0f * std::numbers::pi_v<float>;
+                }
+            }
+        }
+    }
+    double seconds = stopwatch.seconds();
+    g_sink += out[out.size() / 2];
+    return seconds;
+}
+
+
+int main() {
+    double audio_seconds = static_cast<double>(kFrameCount - 1) * kFrameHop / kSampleRate;
+
+    std::printf("%10s %14s %14s %14s\n", "partials", "fft 1024", "fft 256", "direct sum");
+    for (int32_t resolution : { 16, 64, 256, 1024 }) {
+        std::vector<std::unique_ptr<Partials>> frames;
+        uint32_t seed = 1;
+        for (int32_t k = 0; k < kFrameCount; k++) {
+            auto partials = std::make_unique<Partials>(resolution);
+            for (int32_t i = 0; i < resolution; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                partials->mutMagPtr()[i] = static_cast<float>(seed >> 8) / 16777216.0f / static_cast<float>(i + 1);
+                partials->mutPhasePtr()[i] = 0.0f;
+            }
+            frames.push_back(std::move(partials));
+        }
+
+        std::printf("%10d %13.1fx %13.1fx %13.1fx\n", resolution,
+                    audio_seconds / synthTime(frames, 1024),
+                    audio_seconds / synthTime(frames, 256),
+                    audio_seconds / directTime(frames, resolution));
+    }
+
+    return g_sink == 12345.0f ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+//
+//  PartialsSynthTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "DSP/PartialsSynth.hpp"
+#include "DSP/Partials.hpp"
+
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  The synthesized frames are compared to a direct sum of cosines, with
+ *  magnitudes and frequencies interpolated linearly between the frames and
+ *  the phases integrated exactly.
+ */
+
+static constexpr int32_t kSampleRate = 48000;
+static constexpr int32_t kResolution = 256;
+static constexpr int32_t kFrameHop = 512;
+static constexpr int32_t kFrameCount = 40;
+
+using Frames = std::vector<std::unique_ptr<Partials>>;
+
+
+/**
+ *  Simple deterministic generator, values in [0, 1).
+ */
+static float nextRandom() {
+    static uint32_t seed = 1;
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+
+static std::vector<double> directSum(const Frames& frames, const std::vector<float>& base_freqs) {
+    auto interval_count = static_cast<int64_t>(frames.size()) - 1;
+    std::vector<double> result(interval_count * kFrameHop, 0.0);
+
+    for (int32_t i = 0; i < kResolution; i++) {
+        double phase = frames[0]->mutPhasePtr()[i];
+        for (int64_t k = 0; k < interval_count; k++) {
+            double f0 = (i + 1) * static_cast<double>(base_freqs[k]);
+            double f1 = (i + 1) * static_cast<double>(base_freqs[k + 1]);
+            double a0 = frames[k]->mutMagPtr()[i];
+            double a1 = frames[k + 1]->mutMagPtr()[i];
+            for (int32_t n = 0; n < kFrameHop; n++) {
+                double u = static_cast<double>(n) / kFrameHop;
+                double p = phase + 2.0 * std::numbers::pi * (f0 * n + (f1 - f0) * n * u * 0.5) / kSampleRate;
+                result[k * kFrameHop + n] += (a0 + (a1 - a0) * u) * std::cos(p);
+            }
+            phase += std::numbers::pi * kFrameHop * (f0 + f1) / kSampleRate;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ *  Streams all frames through `synth`, pulling blocks of `block_len`.
+ */
+static std::vector<double> synthesize(PartialsSynth& synth, const Frames& frames, const std::vector<float>& base_freqs, int32_t block_len) {
+    std::vector<double> result;
+    std::vector<float> block(block_len);
+
+    for (size_t k = 0; k <= frames.size(); k++) {
+        if (k < frames.size()) {
+            GRAIN_CHECK(synth.pushFrame(frames[k].get(), base_freqs[k]) == ErrorCode::None);
+        }
+        else {
+            GRAIN_CHECK(synth.finish() == ErrorCode::None);
+        }
+        while (int64_t n = synth.pull(block.data(), block_len)) {
+            result.insert(result.end(), block.begin(), block.begin() + n);
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ *  Error relative to the RMS of the reference, in dB.
+ */
+static double errorDB(const std::vector<double>& reference, const std::vector<double>& output) {
+    GRAIN_CHECK(output.size() >= reference.size());
+    if (output.size() < reference.size()) {
+        return 0.0;
+    }
+
+    double ref_sum = 0.0;
+    double err_sum = 0.0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        ref_sum += reference[i] * reference[i];
+        err_sum += (output[i] - reference[i]) * (output[i] - reference[i]);
+    }
+    return 10.0 * std::log10(err_sum / ref_sum + 1.0e-30);
+}
+
+
+static void check(const char* name, int32_t fft_len, double db, double max_db) {
+    if (db > max_db) {
+        std::cerr << name << ", fft length " << fft_len << ": error " << db << " dB" << std::endl;
+    }
+    GRAIN_CHECK(db <= max_db);
+}
+
+
+int main() {
+    std::vector<float> mag0(kResolution);
+    std::vector<float> mag1(kResolution);
+    std::vector<float> phase0(kResolution);
+    for (int32_t i = 0; i < kResolution; i++) {
+        mag0[i] = nextRandom() / static_cast<float>(i + 1);
+        mag1[i] = nextRandom() / static_cast<float>(i + 1);
+        phase0[i] = (nextRandom() * 2.0f - 1.0f) * std::numbers::pi_v<float>;
+    }
+
+    // Steady partials, base frequency 0 spreads them up to Nyquist
+    {
+        Frames frames;
+        for (int32_t k = 0; k < kFrameCount; k++) {
+            auto partials = std::make_unique<Partials>(kResolution);
+            std::copy(mag0.begin(), mag0.end(), partials->mutMagPtr());
+            std::copy(phase0.begin(), phase0.end(), partials->mutPhasePtr());
+            frames.push_back(std::move(partials));
+        }
+
+        std::vector<float> base_freqs(kFrameCount, 0.0f);
+        auto reference = directSum(frames, std::vector<float>(kFrameCount, static_cast<float>(kSampleRate) / (2 * kResolution)));
+
+        for (int32_t fft_len : { 256, 1024, 4096 }) {
+            PartialsSynth synth(kSampleRate, kFrameHop, fft_len);
+            GRAIN_CHECK(synth.isValid());
+            check("Steady", fft_len, errorDB(reference, synthesize(synth, frames, base_freqs, 300)), fft_len < 1024 ? -90.0 : -120.0);
+        }
+    }
+
+    // Gliding magnitudes and frequencies, constant within each synthesis frame
+    {
+        Frames frames;
+        std::vector<float> base_freqs;
+        for (int32_t k = 0; k < kFrameCount; k++) {
+            auto partials = std::make_unique<Partials>(kResolution);
+            float t = static_cast<float>(k) / (kFrameCount - 1);
+            for (int32_t i = 0; i < kResolution; i++) {
+                partials->mutMagPtr()[i] = mag0[i] + (mag1[i] - mag0[i]) * t;
+                partials->mutPhasePtr()[i] = phase0[i];
+            }
+            frames.push_back(std::move(partials));
+            base_freqs.push_back(90.0f + 10.0f * t);
+        }
+
+        auto reference = directSum(frames, base_freqs);
+
+        for (int32_t fft_len : { 512, 1024 }) {
+            PartialsSynth synth(kSampleRate, kFrameHop, fft_len);
+            check("Glide", fft_len, errorDB(reference, synthesize(synth, frames, base_freqs, 512)), -35.0);
+        }
+    }
+
+    // Locked phases, a single partial must reach the phase of every frame
+    {
+        Frames frames;
+        std::vector<float> phases;
+        for (int32_t k = 0; k < kFrameCount; k++) {
+            auto partials = std::make_unique<Partials>(kResolution);
+            float phase = (nextRandom() * 2.0f - 1.0f) * std::numbers::pi_v<float>;
+            partials->mutMagPtr()[10] = 1.0f;
+            partials->mutPhasePtr()[10] = phase;
+            phases.push_back(phase);
+            frames.push_back(std::move(partials));
+        }
+
+        PartialsSynth synth(kSampleRate, kFrameHop);
+        synth.setPhaseMode(PartialsSynth::PhaseMode::Locked);
+        auto output = synthesize(synth, frames, std::vector<float>(kFrameCount, 0.0f), 512);
+        GRAIN_CHECK(static_cast<int64_t>(output.size()) >= static_cast<int64_t>(kFrameCount - 1) * kFrameHop);
+
+        double max_error = 0.0;
+        for (int32_t k = 1; k < kFrameCount - 1; k++) {
+            max_error = std::max(max_error, std::fabs(output[static_cast<size_t>(k) * kFrameHop] - std::cos(phases[k])));
+        }
+        if (max_error > 1.0e-4) {
+            std::cerr << "Locked phases: error " << max_error << std::endl;
+        }
+        GRAIN_CHECK(max_error <= 1.0e-4);
+    }
+
+    return Grain::Test::result();
+}
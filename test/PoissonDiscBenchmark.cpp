@@ -0,0 +1,83 @@
+//
+//  PoissonDiscBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "2d/PoissonDisc.hpp"
+
+#include <cstdio>
+#include <thread>
+
+using namespace Grain;
+
+
+/**
+ *  Prints million points per second of `PoissonDiscSampler::generate()` for
+ *  about 10 million points, with one thread and with all threads, and of
+ *  `next()` on a tenth of the area.
+ */
+
+static constexpr double kSize = 3800.0;       // About 10M points with a radius of 1
+static constexpr double kMinRadius = 1.0;
+static constexpr double kMaxRadius = 2.0;
+
+
+/**
+ *  Radius growing from left to right.
+ */
+class GradientDensity : public PoissonDiscDensity {
+public:
+    double densityAtPos(const Vec2d& pos) override {
+        return min_radius_ + radius_delta_ * pos.x_ / sampler_->width();
+    }
+};
+
+
+static void runGenerate(const char* name, double max_radius, PoissonDiscDensity* density, int32_t thread_count) {
+    PoissonDiscSampler sampler(Bounds2d(0.0, 0.0, kSize, kSize), density, kMinRadius, max_radius);
+    sampler.setThreadCount(thread_count);
+
+    Test::Stopwatch stopwatch;
+    auto points = sampler.generate();
+    double seconds = stopwatch.seconds();
+
+    std::printf("%-24s %8d %12zu %10.2f %10.2f\n", name, thread_count, points.size(), seconds, static_cast<double>(points.size()) / seconds * 1.0e-6);
+}
+
+
+static void runNext() {
+    PoissonDiscSampler sampler(Bounds2d(0.0, 0.0, kSize, kSize / 10.0), nullptr, kMinRadius, kMinRadius);
+
+    Test::Stopwatch stopwatch;
+    size_t point_count = 0;
+    while (sampler.next()) {
+        point_count++;
+    }
+    double seconds = stopwatch.seconds();
+
+    std::printf("%-24s %8d %12zu %10.2f %10.2f\n", "next(), uniform", 1, point_count, seconds, static_cast<double>(point_count) / seconds * 1.0e-6);
+}
+
+
+int main() {
+    auto thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+
+    std::printf("%-24s %8s %12s %10s %10s\n", "sampler", "threads", "points", "seconds", "M pts/s");
+
+    runGenerate("generate(), uniform", kMinRadius, nullptr, 1);
+    runGenerate("generate(), uniform", kMinRadius, nullptr, thread_count);
+
+    GradientDensity density;
+    runGenerate("generate(), gradient", kMaxRadius, &density, 1);
+    runGenerate("generate(), gradient", kMaxRadius, &density, thread_count);
+
+    runNext();
+
+    return 0;
+}
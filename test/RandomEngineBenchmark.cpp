@@ -0,0 +1,104 @@
+//
+//  RandomEngineBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Math/Random.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Prints million values per second of the bulk fills of `RandomEngine`,
+ *  of single calls to the engine and to `Random::next()`, and of
+ *  `std::mt19937` with and without the distributions of the standard
+ *  library, each filling an array of 16 million floats, or 8 million 64 bit
+ *  values.
+ */
+
+static constexpr int64_t kCount = 1 << 24;
+
+static double g_sink = 0.0;
+
+
+template <typename F>
+static void run(const char* name, std::vector<float>& values, F fn, int64_t value_count = kCount) {
+    Test::Stopwatch stopwatch;
+    fn(values.data());
+    double seconds = stopwatch.seconds();
+    g_sink += values[kCount / 2];
+    std::printf("%-28s %10.2f %12.1f\n", name, seconds * 1.0e3, static_cast<double>(value_count) / seconds * 1.0e-6);
+}
+
+
+int main() {
+    std::vector<float> values(kCount);
+    RandomEngine engine(1);
+    Random::seed(1);
+    std::mt19937 mt(1);
+
+    std::printf("%-28s %10s %12s\n", "generator", "ms", "M values/s");
+
+    run("fillUniform", values, [&](float* v) {
+        engine.fillUniform(v, kCount);
+    });
+    run("fillBipolar", values, [&](float* v) {
+        engine.fillBipolar(v, kCount);
+    });
+    run("fillNormal", values, [&](float* v) {
+        engine.fillNormal(v, kCount);
+    });
+    run("fillExponential", values, [&](float* v) {
+        engine.fillExponential(v, kCount);
+    });
+    run("fillUInt64", values, [&](float* v) {
+        engine.fillUInt64(reinterpret_cast<uint64_t*>(v), kCount / 2);
+        g_sink += static_cast<double>(reinterpret_cast<uint64_t*>(v)[0] & 1);
+    }, kCount / 2);
+
+    run("RandomEngine::nextFloat", values, [&](float* v) {
+        for (int64_t i = 0; i < kCount; i++) {
+            v[i] = engine.nextFloat();
+        }
+    });
+    run("RandomEngine::nextNormal", values, [&](float* v) {
+        for (int64_t i = 0; i < kCount; i++) {
+            v[i] = engine.nextNormal();
+        }
+    });
+    run("Random::next", values, [&](float* v) {
+        for (int64_t i = 0; i < kCount; i++) {
+            v[i] = Random::next();
+        }
+    });
+
+    run("std::mt19937", values, [&](float* v) {
+        for (int64_t i = 0; i < kCount; i++) {
+            v[i] = static_cast<float>(mt() >> 8) * 0x1.0p-24f;
+        }
+    });
+    run("std::mt19937, uniform dist.", values, [&](float* v) {
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+        for (int64_t i = 0; i < kCount; i++) {
+            v[i] = distribution(mt);
+        }
+    });
+    run("std::mt19937, normal dist.", values, [&](float* v) {
+        std::normal_distribution<float> distribution(0.0f, 1.0f);
+        for (int64_t i = 0; i < kCount; i++) {
+            v[i] = distribution(mt);
+        }
+    });
+
+    return g_sink == 12345.0 ? 1 : 0;
+}
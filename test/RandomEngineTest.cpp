@@ -0,0 +1,357 @@
+//
+//  RandomEngineTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Math/Random.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  `RandomEngine` is compared to the reference implementation of
+ *  xoshiro256++ with its jump functions, the bulk fills to the single value
+ *  methods, and the distributions are checked by their moments and by
+ *  chi-square tests.
+ */
+
+static constexpr int64_t kSampleCount = 1 << 20;
+
+
+/**
+ *  xoshiro256++ as published by David Blackman and Sebastiano Vigna, with
+ *  a state seeded by SplitMix64.
+ */
+struct ReferenceXoshiro {
+    uint64_t s[4];
+
+    explicit ReferenceXoshiro(uint64_t seed) {
+        for (auto& word : s) {
+            uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void jump(const uint64_t* polynomial) {
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (polynomial[i] & (UINT64_C(1) << b)) {
+                    s0 ^= s[0];
+                    s1 ^= s[1];
+                    s2 ^= s[2];
+                    s3 ^= s[3];
+                }
+                next();
+            }
+        }
+        s[0] = s0;
+        s[1] = s1;
+        s[2] = s2;
+        s[3] = s3;
+    }
+
+    // 2^128 steps
+    void jump() {
+        static const uint64_t polynomial[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        jump(polynomial);
+    }
+
+    // 2^192 steps
+    void longJump() {
+        static const uint64_t polynomial[] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+        jump(polynomial);
+    }
+};
+
+
+/**
+ *  The first `count` values of the engine with `seed` and `stream`, computed
+ *  with the reference: lane `k` starts `k` jumps after the stream, the lanes
+ *  are handed out in turn.
+ */
+static std::vector<uint64_t> referenceValues(uint64_t seed, uint64_t stream, int32_t count) {
+    ReferenceXoshiro generator(seed);
+    for (uint64_t i = 0; i < stream; i++) {
+        generator.longJump();
+    }
+
+    std::vector<ReferenceXoshiro> lanes;
+    for (int32_t k = 0; k < RandomEngine::kLaneCount; k++) {
+        lanes.push_back(generator);
+        generator.jump();
+    }
+
+    std::vector<uint64_t> result(count);
+    for (int32_t i = 0; i < count; i++) {
+        result[i] = lanes[i % RandomEngine::kLaneCount].next();
+    }
+    return result;
+}
+
+
+static void checkReference() {
+    // Published output for the state { 1, 2, 3, 4 }
+    ReferenceXoshiro known(0);
+    known.s[0] = 1;
+    known.s[1] = 2;
+    known.s[2] = 3;
+    known.s[3] = 4;
+    const uint64_t known_values[] = { 41943041ULL, 58720359ULL, 3588806011781223ULL, 3591011842654386ULL, 9228616714210784205ULL };
+    for (uint64_t value : known_values) {
+        GRAIN_CHECK(known.next() == value);
+    }
+
+    // A jump by the polynomial 1 is no step, by x one step
+    ReferenceXoshiro a(7), b(7);
+    const uint64_t identity[4] = { 1, 0, 0, 0 };
+    const uint64_t one_step[4] = { 2, 0, 0, 0 };
+    a.jump(identity);
+    GRAIN_CHECK(a.next() == b.next());
+    a.jump(one_step);
+    b.next();
+    GRAIN_CHECK(a.next() == b.next());
+
+    for (uint64_t seed : { 0ULL, 1ULL, 0x853c49e6748fea9bULL, 0xffffffffffffffffULL }) {
+        for (uint64_t stream : { 0ULL, 1ULL, 3ULL }) {
+            auto expected = referenceValues(seed, stream, 64);
+            RandomEngine engine(seed, stream);
+            int32_t mismatch_count = 0;
+            for (uint64_t value : expected) {
+                mismatch_count += engine() != value;
+            }
+            GRAIN_CHECK(mismatch_count == 0);
+        }
+    }
+
+    RandomEngine engine(12345);
+    RandomEngine split = engine.split(2);
+    RandomEngine stream(12345, 2);
+    GRAIN_CHECK(split.stream() == 2 && split.seedValue() == 12345);
+    GRAIN_CHECK(split() == stream());
+}
+
+
+static bool isClose(float a, float b) {
+    return std::fabs(a - b) <= 1.0e-5f * std::max(1.0f, std::fabs(b));
+}
+
+
+/**
+ *  A bulk fill gives the same values as single calls, whatever the position
+ *  in the buffered step and the count, and the sequence continues after it.
+ */
+template <typename Fill, typename Next>
+static int32_t countBulkMismatches(Fill fill, Next next) {
+    int32_t mismatch_count = 0;
+
+    for (int32_t skip = 0; skip < 6; skip++) {
+        for (int64_t count : { 1, 2, 3, 4, 5, 255, 256, 257, 1000 }) {
+            RandomEngine bulk_engine(99, 1);
+            RandomEngine scalar_engine(99, 1);
+            for (int32_t i = 0; i < skip; i++) {
+                bulk_engine();
+                scalar_engine();
+            }
+
+            std::vector<float> values(count + 1);
+            fill(bulk_engine, values.data(), count);
+            values[count] = next(bulk_engine);
+
+            for (auto value : values) {
+                mismatch_count += !isClose(value, next(scalar_engine));
+            }
+        }
+    }
+
+    return mismatch_count;
+}
+
+
+static void checkBulk() {
+    int32_t mismatch_count = 0;
+    for (int32_t skip = 0; skip < 6; skip++) {
+        for (int64_t count : { 1, 3, 4, 5, 1001 }) {
+            RandomEngine bulk_engine(5);
+            RandomEngine scalar_engine(5);
+            for (int32_t i = 0; i < skip; i++) {
+                bulk_engine();
+                scalar_engine();
+            }
+            std::vector<uint64_t> values(count);
+            bulk_engine.fillUInt64(values.data(), count);
+            values.push_back(bulk_engine());
+            for (auto value : values) {
+                mismatch_count += value != scalar_engine();
+            }
+        }
+    }
+    GRAIN_CHECK(mismatch_count == 0);
+
+    GRAIN_CHECK(countBulkMismatches(
+        [](RandomEngine& e, float* v, int64_t n) { e.fillUniform(v, n, -2.0f, 3.0f); },
+        [](RandomEngine& e) { return -2.0f + e.nextFloat() * 5.0f; }) == 0);
+    GRAIN_CHECK(countBulkMismatches(
+        [](RandomEngine& e, float* v, int64_t n) { e.fillBipolar(v, n, 0.5f); },
+        [](RandomEngine& e) { return e.nextBipolar() * 0.5f; }) == 0);
+    GRAIN_CHECK(countBulkMismatches(
+        [](RandomEngine& e, float* v, int64_t n) { e.fillNormal(v, n, 1.0f, 2.0f); },
+        [](RandomEngine& e) { return 1.0f + e.nextNormal() * 2.0f; }) == 0);
+    GRAIN_CHECK(countBulkMismatches(
+        [](RandomEngine& e, float* v, int64_t n) { e.fillExponential(v, n, 4.0f); },
+        [](RandomEngine& e) { return e.nextExponential() / 4.0f; }) == 0);
+}
+
+
+struct Moments {
+    double mean = 0.0;
+    double variance = 0.0;
+    double skewness = 0.0;
+    float min = 0.0f;
+    float max = 0.0f;
+};
+
+
+static Moments moments(const std::vector<float>& values) {
+    Moments result;
+    result.min = result.max = values[0];
+    for (float v : values) {
+        result.mean += v;
+        result.min = std::min(result.min, v);
+        result.max = std::max(result.max, v);
+    }
+    result.mean /= static_cast<double>(values.size());
+
+    double m3 = 0.0;
+    for (float v : values) {
+        double d = v - result.mean;
+        result.variance += d * d;
+        m3 += d * d * d;
+    }
+    result.variance /= static_cast<double>(values.size());
+    result.skewness = m3 / static_cast<double>(values.size()) / std::pow(result.variance, 1.5);
+    return result;
+}
+
+
+/**
+ *  Bounds of about five standard errors for `kSampleCount` values.
+ */
+static void checkMoments() {
+    RandomEngine engine(2024);
+    std::vector<float> values(kSampleCount);
+
+    engine.fillUniform(values.data(), kSampleCount);
+    auto uniform = moments(values);
+    GRAIN_CHECK(std::fabs(uniform.mean - 0.5) < 1.5e-3);
+    GRAIN_CHECK(std::fabs(uniform.variance - 1.0 / 12.0) < 1.0e-3);
+    GRAIN_CHECK(std::fabs(uniform.skewness) < 1.0e-2);
+    GRAIN_CHECK(uniform.min >= 0.0f && uniform.max < 1.0f);
+
+    engine.fillBipolar(values.data(), kSampleCount);
+    auto bipolar = moments(values);
+    GRAIN_CHECK(std::fabs(bipolar.mean) < 3.0e-3);
+    GRAIN_CHECK(std::fabs(bipolar.variance - 1.0 / 3.0) < 4.0e-3);
+    GRAIN_CHECK(bipolar.min >= -1.0f && bipolar.max < 1.0f);
+
+    engine.fillNormal(values.data(), kSampleCount, 3.0f, 2.0f);
+    auto normal = moments(values);
+    GRAIN_CHECK(std::fabs(normal.mean - 3.0) < 1.0e-2);
+    GRAIN_CHECK(std::fabs(normal.variance - 4.0) < 3.0e-2);
+    GRAIN_CHECK(std::fabs(normal.skewness) < 1.2e-2);
+
+    engine.fillExponential(values.data(), kSampleCount, 2.0f);
+    auto exponential = moments(values);
+    GRAIN_CHECK(std::fabs(exponential.mean - 0.5) < 2.5e-3);
+    GRAIN_CHECK(std::fabs(exponential.variance - 0.25) < 5.0e-3);
+    GRAIN_CHECK(std::fabs(exponential.skewness - 2.0) < 0.15);
+    GRAIN_CHECK(exponential.min >= 0.0f);
+}
+
+
+/**
+ *  Chi-square statistic of `bin_count` bins. With 255 degrees of freedom
+ *  the mean is 255 and the standard deviation about 22.6.
+ */
+static double chiSquare(const std::vector<int64_t>& bins, int64_t count) {
+    double expected = static_cast<double>(count) / static_cast<double>(bins.size());
+    double chi_square = 0.0;
+    for (auto n : bins) {
+        double d = static_cast<double>(n) - expected;
+        chi_square += d * d / expected;
+    }
+    return chi_square;
+}
+
+
+static bool isPlausibleChiSquare(double chi_square) {
+    return chi_square > 255.0 - 6.0 * 22.6 && chi_square < 255.0 + 6.0 * 22.6;
+}
+
+
+static void checkChiSquare() {
+    RandomEngine engine(77, 5);
+
+    std::vector<float> values(kSampleCount);
+    engine.fillUniform(values.data(), kSampleCount);
+    std::vector<int64_t> bins(256, 0);
+    for (float v : values) {
+        bins[static_cast<int32_t>(v * 256.0f)]++;
+    }
+    GRAIN_CHECK(isPlausibleChiSquare(chiSquare(bins, kSampleCount)));
+
+    // Low and high bytes of the raw values
+    std::vector<uint64_t> raw(kSampleCount);
+    engine.fillUInt64(raw.data(), kSampleCount);
+    for (int32_t shift : { 0, 28, 56 }) {
+        std::fill(bins.begin(), bins.end(), 0);
+        for (auto v : raw) {
+            bins[(v >> shift) & 0xFF]++;
+        }
+        GRAIN_CHECK(isPlausibleChiSquare(chiSquare(bins, kSampleCount)));
+    }
+
+    // Pairs of consecutive values, 16 x 16 cells
+    std::fill(bins.begin(), bins.end(), 0);
+    for (int64_t i = 0; i + 1 < kSampleCount; i += 2) {
+        bins[((raw[i] >> 60) << 4) | (raw[i + 1] >> 60)]++;
+    }
+    GRAIN_CHECK(isPlausibleChiSquare(chiSquare(bins, kSampleCount / 2)));
+}
+
+
+int main() {
+    checkReference();
+    checkBulk();
+    checkMoments();
+    checkChiSquare();
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,114 @@
+//
+//  ResamplerBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "DSP/Resampler.hpp"
+#include "Signal/Signal.hpp"
+#include "Type/HiResValue.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Prints million output samples per second of `Resampler::resample()` for
+ *  each quality preset and of linear interpolation with
+ *  `Signal::readFloatLerp()`, the path `Signal::resample()` used before the
+ *  resampler, for common conversions of a mono signal and for a ratio,
+ *  which needs the interpolated phase table.
+ */
+
+static constexpr int64_t kSampleCount = 1 << 22;
+
+static double g_sink = 0.0;
+
+
+static void print(const char* name, int64_t out_len, double seconds) {
+    std::printf("%-16s %10.2f %12.1f\n", name, seconds * 1.0e3, static_cast<double>(out_len) / seconds * 1.0e-6);
+}
+
+
+static void runLerp(const Signal& signal, int32_t dst_rate, std::vector<float>& output) {
+    double step = static_cast<double>(signal.sampleRate()) / dst_rate;
+    auto out_len = static_cast<int64_t>(output.size());
+
+    Test::Stopwatch stopwatch;
+    HiResValue pos;
+    pos.setStep(static_cast<int64_t>(step), step - std::floor(step));
+    for (int64_t i = 0; i < out_len; i++) {
+        output[i] = signal.readFloatLerp(0, pos);
+        pos.stepForward();
+    }
+    double seconds = stopwatch.seconds();
+
+    g_sink += output[out_len / 2];
+    print("lerp (old)", out_len, seconds);
+}
+
+
+static void runResampler(const char* name, const Signal& signal, int32_t dst_rate, Resampler::Quality quality, std::vector<float>& output) {
+    Resampler resampler;
+    if (resampler.configure(signal.sampleRate(), dst_rate, quality) != ErrorCode::None) {
+        std::printf("%-16s failed\n", name);
+        return;
+    }
+    auto out_len = static_cast<int64_t>(output.size());
+
+    Test::Stopwatch stopwatch;
+    auto err = resampler.resample(static_cast<const float*>(signal.dataPtr()), kSampleCount, 1, output.data(), out_len, 1);
+    double seconds = stopwatch.seconds();
+    if (err != ErrorCode::None) {
+        std::printf("%-16s failed\n", name);
+        return;
+    }
+
+    g_sink += output[out_len / 2];
+    print(name, out_len, seconds);
+}
+
+
+static void runConversion(int32_t src_rate, int32_t dst_rate) {
+    Signal signal(1, src_rate, kSampleCount);
+    if (!signal.hasData()) {
+        std::printf("Can't allocate signal\n");
+        return;
+    }
+    for (int64_t i = 0; i < kSampleCount; i++) {
+        double t = static_cast<double>(i) / src_rate;
+        signal.writeFloat(0, i, static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * 440.0 * t) + 0.25 * std::sin(2.0 * std::numbers::pi * 9100.0 * t)));
+    }
+
+    Resampler resampler(src_rate, dst_rate, Resampler::Quality::Fast);
+    std::vector<float> output(resampler.outputLength(kSampleCount));
+
+    std::printf("\n%d Hz -> %d Hz, %s\n", src_rate, dst_rate, resampler.isPolyphase() ? "polyphase" : "interpolated table");
+    std::printf("%-16s %10s %12s\n", "method", "ms", "M samples/s");
+
+    runLerp(signal, dst_rate, output);
+    runResampler("Fast", signal, dst_rate, Resampler::Quality::Fast, output);
+    runResampler("Medium", signal, dst_rate, Resampler::Quality::Medium, output);
+    runResampler("High", signal, dst_rate, Resampler::Quality::High, output);
+    runResampler("Best", signal, dst_rate, Resampler::Quality::Best, output);
+}
+
+
+int main() {
+    runConversion(44100, 48000);
+    runConversion(48000, 44100);
+    runConversion(48000, 96000);
+    runConversion(96000, 48000);
+    runConversion(44100, 44101);
+
+    return g_sink == 12345.0 ? 1 : 0;
+}
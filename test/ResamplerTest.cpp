@@ -0,0 +1,156 @@
+//
+//  ResamplerTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "DSP/Resampler.hpp"
+#include "Signal/Signal.hpp"
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+using namespace Grain;
+
+
+static std::vector<float> sine(int64_t n, double freq, int32_t sample_rate) {
+    std::vector<float> result(n);
+    for (int64_t i = 0; i < n; i++) {
+        result[i] = static_cast<float>(std::sin(2.0 * std::numbers::pi * freq * static_cast<double>(i) / sample_rate));
+    }
+    return result;
+}
+
+
+static std::vector<float> resample(const Resampler& resampler, const std::vector<float>& input) {
+    std::vector<float> output(resampler.outputLength(static_cast<int64_t>(input.size())));
+    auto err = resampler.resample(input.data(), static_cast<int64_t>(input.size()), 1, output.data(), static_cast<int64_t>(output.size()), 1);
+    GRAIN_CHECK(err == ErrorCode::None);
+    return output;
+}
+
+
+/**
+ *  Output lengths must be `ceil(len * dst_rate / src_rate)`, also for
+ *  lengths, where `len * dst_rate` does not fit into 64 bits.
+ */
+static void checkOutputLength() {
+    const int32_t rates[][2] = {
+        { 48000, 44100 }, { 44100, 48000 }, { 44100, 96000 }, { 96000, 8000 }, { 8000, 192000 }, { 44100, 48001 }
+    };
+    const int64_t lengths[] = { 1, 2, 147, 160, 44100, 48000, 1000003, int64_t(1) << 40, int64_t(1) << 56, std::numeric_limits<int64_t>::max() / 8 };
+
+    for (auto& rate : rates) {
+        Resampler resampler;
+        GRAIN_CHECK(resampler.configure(rate[0], rate[1], Resampler::Quality::Fast) == ErrorCode::None);
+
+        Signal signal(1, rate[0], 16);
+
+        for (auto len : lengths) {
+            auto n = signal.resampledLength(rate[1], len);
+#if defined(__SIZEOF_INT128__)
+            auto expected = (static_cast<__int128>(len) * rate[1] + rate[0] - 1) / rate[0];
+            if (expected > std::numeric_limits<int64_t>::max()) {
+                // Too long, reported as 0
+                GRAIN_CHECK(n == 0);
+                GRAIN_CHECK(resampler.outputLength(len) == 0);
+                continue;
+            }
+            GRAIN_CHECK(n == static_cast<int64_t>(expected));
+#else
+            if (static_cast<long double>(len) * rate[1] / rate[0] >= static_cast<long double>(std::numeric_limits<int64_t>::max())) {
+                continue;
+            }
+#endif
+            GRAIN_CHECK(n > 0);
+
+            // Exact ratios, the resampler agrees with the signal
+            if (resampler.isPolyphase()) {
+                GRAIN_CHECK(resampler.outputLength(len) == n);
+            }
+            else {
+                GRAIN_CHECK(std::llabs(resampler.outputLength(len) - n) <= std::max<int64_t>(1, len >> 30));
+            }
+        }
+    }
+}
+
+
+/**
+ *  A sine well below both Nyquist frequencies must pass with unity gain and
+ *  without delay.
+ */
+static void checkPassband(int32_t src_rate, int32_t dst_rate, Resampler::Quality quality, double freq, double max_error) {
+    Resampler resampler;
+    GRAIN_CHECK(resampler.configure(src_rate, dst_rate, quality) == ErrorCode::None);
+
+    auto input = sine(src_rate, freq, src_rate);
+    auto output = resample(resampler, input);
+    GRAIN_CHECK(static_cast<int64_t>(output.size()) == (static_cast<int64_t>(src_rate) * dst_rate + src_rate - 1) / src_rate);
+
+    // Skip the borders, where the zero padding outside the input is in reach of the filter
+    auto skip = static_cast<int64_t>(output.size()) / 10;
+    double error = 0.0;
+    for (int64_t i = skip; i < static_cast<int64_t>(output.size()) - skip; i++) {
+        double expected = std::sin(2.0 * std::numbers::pi * freq * static_cast<double>(i) / dst_rate);
+        error = std::max(error, std::fabs(output[i] - expected));
+    }
+
+    if (error > max_error) {
+        std::cerr << src_rate << " -> " << dst_rate << " Hz, " << freq << " Hz: passband error " << error << std::endl;
+    }
+    GRAIN_CHECK(error <= max_error);
+}
+
+
+/**
+ *  When downsampling, a sine above the new Nyquist frequency must be
+ *  attenuated by at least `min_attenuation_db`.
+ */
+static void checkStopband(int32_t src_rate, int32_t dst_rate, Resampler::Quality quality, double freq, double min_attenuation_db) {
+    Resampler resampler;
+    GRAIN_CHECK(resampler.configure(src_rate, dst_rate, quality) == ErrorCode::None);
+
+    auto input = sine(src_rate, freq, src_rate);
+    auto output = resample(resampler, input);
+
+    auto skip = static_cast<int64_t>(output.size()) / 10;
+    double sum = 0.0;
+    int64_t n = 0;
+    for (int64_t i = skip; i < static_cast<int64_t>(output.size()) - skip; i++, n++) {
+        sum += static_cast<double>(output[i]) * output[i];
+    }
+
+    // Relative to the RMS of the input sine
+    double attenuation_db = -10.0 * std::log10(sum / static_cast<double>(n) / 0.5);
+
+    if (attenuation_db < min_attenuation_db) {
+        std::cerr << src_rate << " -> " << dst_rate << " Hz, " << freq << " Hz: stopband attenuation " << attenuation_db << " dB" << std::endl;
+    }
+    GRAIN_CHECK(attenuation_db >= min_attenuation_db);
+}
+
+
+int main() {
+    checkOutputLength();
+
+    // Polyphase and interpolated table mode
+    checkPassband(48000, 44100, Resampler::Quality::High, 1000.0, 1e-3);
+    checkPassband(44100, 48000, Resampler::Quality::High, 5000.0, 1e-3);
+    checkPassband(44100, 48001, Resampler::Quality::High, 1000.0, 1e-3);
+    checkPassband(96000, 8000, Resampler::Quality::Medium, 440.0, 1e-3);
+
+    checkStopband(48000, 16000, Resampler::Quality::Fast, 12000.0, 55.0);
+    checkStopband(48000, 16000, Resampler::Quality::High, 12000.0, 90.0);
+    checkStopband(96000, 44100, Resampler::Quality::Best, 30000.0, 100.0);
+    checkStopband(48001, 22050, Resampler::Quality::High, 15000.0, 90.0);
+
+    return Grain::Test::result();
+}
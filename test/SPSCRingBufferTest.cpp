@@ -0,0 +1,171 @@
+//
+//  SPSCRingBufferTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "DSP/SPSCRingBuffer.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Frames carry a running counter in channel 0 and its negation in
+ *  channel 1, so any lost, repeated or swapped value is detected.
+ */
+
+
+static void checkCapacity() {
+    SPSCRingBuffer<float> buffer(10, 2);
+    GRAIN_CHECK(buffer.isUsable());
+    GRAIN_CHECK(buffer.capacity() == 16);
+    GRAIN_CHECK(buffer.channelCount() == 2);
+    GRAIN_CHECK(buffer.writeAvailable() == 16);
+    GRAIN_CHECK(buffer.readAvailable() == 0);
+
+    SPSCRingBuffer<float> too_large(static_cast<int64_t>(SPSCRingBuffer<float>::kMaxCapacity) + 1);
+    GRAIN_CHECK(!too_large.isUsable());
+    GRAIN_CHECK(too_large.capacity() == 0);
+
+    float values[2] = { 1.0f, -1.0f };
+    GRAIN_CHECK(too_large.write(values, 1) == 0);
+    GRAIN_CHECK(too_large.read(values, 1) == 0);
+}
+
+
+/**
+ *  Blocks of changing length, so reads and writes wrap at every position.
+ *  Interleaved and deinterleaved transfers alternate on both sides.
+ */
+static void checkWraparound() {
+    SPSCRingBuffer<int64_t> buffer(16, 2);
+
+    int64_t next_write = 0;
+    int64_t next_read = 0;
+    std::vector<int64_t> interleaved(2 * 32);
+    std::vector<int64_t> left(32);
+    std::vector<int64_t> right(32);
+    int64_t* channels[2] = { left.data(), right.data() };
+
+    for (int32_t round = 0; round < 1000; round++) {
+        int64_t write_len = 1 + (round * 7) % 19;
+        int64_t expected = std::min(write_len, buffer.writeAvailable());
+        int64_t n;
+        if (round % 2 == 0) {
+            for (int64_t i = 0; i < write_len; i++) {
+                interleaved[i * 2] = next_write + i;
+                interleaved[i * 2 + 1] = -(next_write + i);
+            }
+            n = buffer.write(interleaved.data(), write_len);
+        }
+        else {
+            for (int64_t i = 0; i < write_len; i++) {
+                left[i] = next_write + i;
+                right[i] = -(next_write + i);
+            }
+            n = buffer.writeDeinterleaved(channels, write_len);
+        }
+        GRAIN_CHECK(n == expected);
+        next_write += n;
+        GRAIN_CHECK(buffer.readAvailable() == next_write - next_read);
+
+        int64_t read_len = 1 + (round * 5) % 17;
+        expected = std::min(read_len, next_write - next_read);
+        if (round % 3 == 0) {
+            n = buffer.read(interleaved.data(), read_len);
+            GRAIN_CHECK(n == expected);
+            for (int64_t i = 0; i < n; i++) {
+                GRAIN_CHECK(interleaved[i * 2] == next_read + i);
+                GRAIN_CHECK(interleaved[i * 2 + 1] == -(next_read + i));
+            }
+        }
+        else if (round % 3 == 1) {
+            n = buffer.readDeinterleaved(channels, read_len);
+            GRAIN_CHECK(n == expected);
+            for (int64_t i = 0; i < n; i++) {
+                GRAIN_CHECK(left[i] == next_read + i);
+                GRAIN_CHECK(right[i] == -(next_read + i));
+            }
+        }
+        else {
+            n = buffer.skip(read_len);
+            GRAIN_CHECK(n == expected);
+        }
+        next_read += n;
+    }
+
+    GRAIN_CHECK(next_write > 16 * 100);
+    GRAIN_CHECK(buffer.readAvailable() == next_write - next_read);
+
+    buffer.reset();
+    GRAIN_CHECK(buffer.readAvailable() == 0);
+    GRAIN_CHECK(buffer.writeAvailable() == 16);
+}
+
+
+/**
+ *  One producer and one consumer thread, both spinning on a small buffer.
+ */
+static void checkProducerConsumer() {
+    constexpr int64_t kFrameCount = 4000000;
+    SPSCRingBuffer<int64_t> buffer(64, 2);
+
+    std::thread producer([&buffer]() {
+        int64_t values[2 * 37];
+        int64_t next = 0;
+        int64_t block_len = 1;
+        while (next < kFrameCount) {
+            int64_t len = std::min(block_len, kFrameCount - next);
+            for (int64_t i = 0; i < len; i++) {
+                values[i * 2] = next + i;
+                values[i * 2 + 1] = -(next + i);
+            }
+            int64_t n = buffer.write(values, len);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            next += n;
+            block_len = block_len % 37 + 1;
+        }
+    });
+
+    int64_t values[2 * 29];
+    int64_t next = 0;
+    int64_t error_count = 0;
+    int64_t block_len = 1;
+    while (next < kFrameCount) {
+        int64_t n = buffer.read(values, block_len);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (int64_t i = 0; i < n; i++) {
+            if (values[i * 2] != next + i || values[i * 2 + 1] != -(next + i)) {
+                error_count++;
+            }
+        }
+        next += n;
+        block_len = block_len % 29 + 1;
+    }
+
+    producer.join();
+    GRAIN_CHECK(error_count == 0);
+    GRAIN_CHECK(next == kFrameCount);
+    GRAIN_CHECK(buffer.readAvailable() == 0);
+}
+
+
+int main() {
+    checkCapacity();
+    checkWraparound();
+    checkProducerConsumer();
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,118 @@
+//
+//  STFTBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "DSP/STFT.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Prints frames per second of `STFT::forward()`, `inverse()` and
+ *  `spectrogram()` in dB and log mel scale, for FFT lengths of 1024 and
+ *  4096 with a hop of a quarter of the length, on one minute of a mono
+ *  signal at 48 kHz, with one thread and with all threads.
+ */
+
+static constexpr int32_t kSampleRate = 48000;
+static constexpr int64_t kSampleCount = kSampleRate * 60;
+
+static double g_sink = 0.0;
+
+
+template <typename F>
+static void run(const char* name, int32_t thread_count, int64_t frame_count, F fn) {
+    Test::Stopwatch stopwatch;
+    if (fn() != ErrorCode::None) {
+        std::printf("%-20s %8d %10s\n", name, thread_count, "failed");
+        return;
+    }
+    double seconds = stopwatch.seconds();
+    std::printf("%-20s %8d %10.2f %12.0f\n", name, thread_count, seconds * 1.0e3, static_cast<double>(frame_count) / seconds);
+}
+
+
+static void runFFTLength(int32_t fft_len, const std::vector<float>& samples) {
+    STFT stft(kSampleRate, fft_len);
+    if (!stft.isValid()) {
+        std::printf("Can't configure STFT\n");
+        return;
+    }
+
+    int64_t frame_count = stft.frameCount(kSampleCount);
+    std::vector<float> real(frame_count * stft.binCount());
+    std::vector<float> imag(frame_count * stft.binCount());
+    std::vector<float> output(kSampleCount);
+
+    std::printf("\nFFT length %d, hop %d, %lld frames\n", fft_len, stft.hop(), static_cast<long long>(frame_count));
+    std::printf("%-20s %8s %10s %12s\n", "operation", "threads", "ms", "frames/s");
+
+    auto max_thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+
+    for (int32_t thread_count : { 1, max_thread_count }) {
+        stft.setThreadCount(thread_count);
+
+        run("forward", thread_count, frame_count, [&]() {
+            return stft.forward(samples.data(), kSampleCount, 1, real.data(), imag.data());
+        });
+        g_sink += real[frame_count / 2 * stft.binCount() + 10];
+
+        run("inverse", thread_count, frame_count, [&]() {
+            return stft.inverse(real.data(), imag.data(), frame_count, output.data(), kSampleCount, 1);
+        });
+        g_sink += output[kSampleCount / 2];
+
+        run("spectrogram, dB", thread_count, frame_count, [&]() {
+            ErrorCode err;
+            std::unique_ptr<ValueGridf> grid(stft.spectrogram(samples.data(), kSampleCount, 1, STFT::Scale::Decibel, err));
+            if (grid) {
+                g_sink += grid->valueAtXY(0, 0);
+            }
+            return err;
+        });
+
+        run("spectrogram, log mel", thread_count, frame_count, [&]() {
+            ErrorCode err;
+            std::unique_ptr<ValueGridf> grid(stft.spectrogram(samples.data(), kSampleCount, 1, STFT::Scale::LogMel, err));
+            if (grid) {
+                g_sink += grid->valueAtXY(0, 0);
+            }
+            return err;
+        });
+
+        if (thread_count == max_thread_count) {
+            break;
+        }
+    }
+}
+
+
+int main() {
+    std::vector<float> samples(kSampleCount);
+    uint32_t seed = 1;
+    for (int64_t i = 0; i < kSampleCount; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double t = static_cast<double>(i) / kSampleRate;
+        double noise = static_cast<double>(seed >> 8) / 16777216.0 - 0.5;
+        samples[i] = static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * (220.0 + 40.0 * t) * t) + 0.1 * noise);
+    }
+
+    runFFTLength(1024, samples);
+    runFFTLength(4096, samples);
+
+    return g_sink == 12345.0 ? 1 : 0;
+}
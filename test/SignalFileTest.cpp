@@ -0,0 +1,194 @@
+//
+//  SignalFileTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Signal/SignalFile.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+using namespace Grain;
+
+
+static const int32_t kChannelCount = 2;
+static const int32_t kSampleRate = 48000;
+static const int64_t kFrameCount = 200000;
+static const int64_t kMaxBufferedFrames = 5000;   // Far less than the file length
+
+
+static String tempPath(const char* name) {
+    return String((std::filesystem::temp_directory_path() / name).string().c_str());
+}
+
+
+static float sampleValue(int32_t channel, int64_t frame) {
+    return static_cast<float>(std::sin(static_cast<double>(frame) * 0.001 * (channel + 1)) * 0.8);
+}
+
+
+/**
+ *  Writes the test file through a writer, which must stay within the limit.
+ */
+static void writeSourceFile(const String& path) {
+    SignalFileWriter writer;
+    auto err = writer.open(path, Signal::FileContainerFormat::WAV, Signal::FileSampleEncoding::Float,
+                           kChannelCount, kSampleRate, 65536, 4, kMaxBufferedFrames);
+    GRAIN_CHECK(err == ErrorCode::None);
+    GRAIN_CHECK(writer.bufferSize() <= kMaxBufferedFrames * kChannelCount * sizeof(float));
+
+    std::vector<float> data[kChannelCount];
+    const float* channels[kChannelCount];
+    for (int32_t channel = 0; channel < kChannelCount; channel++) {
+        data[channel].resize(kFrameCount);
+        for (int64_t i = 0; i < kFrameCount; i++) {
+            data[channel][i] = sampleValue(channel, i);
+        }
+        channels[channel] = data[channel].data();
+    }
+
+    // Uneven chunks, larger than the blocks of the writer
+    int64_t pos = 0;
+    while (pos < kFrameCount && err == ErrorCode::None) {
+        int64_t n = std::min<int64_t>(7919, kFrameCount - pos);
+        const float* chunk[kChannelCount];
+        for (int32_t channel = 0; channel < kChannelCount; channel++) {
+            chunk[channel] = channels[channel] + pos;
+        }
+        err = writer.write(chunk, n);
+        pos += n;
+    }
+    GRAIN_CHECK(err == ErrorCode::None);
+    GRAIN_CHECK(writer.close() == ErrorCode::None);
+}
+
+
+/**
+ *  Reads a file larger than the limit, with and without read-ahead.
+ */
+static void checkReader(const String& path, int32_t read_ahead_blocks) {
+    SignalFileReader reader;
+    GRAIN_CHECK(reader.open(path, 65536, read_ahead_blocks, kMaxBufferedFrames) == ErrorCode::None);
+    GRAIN_CHECK(reader.frameCount() == kFrameCount);
+    GRAIN_CHECK(reader.bufferSize() <= kMaxBufferedFrames * kChannelCount * sizeof(float));
+    GRAIN_CHECK(reader.blockLength() < kFrameCount);
+
+    int64_t frame = 0;
+    bool identical = true;
+    while (auto block = reader.nextBlock()) {
+        GRAIN_CHECK(block->startFrame() == frame);
+        for (int32_t channel = 0; channel < kChannelCount; channel++) {
+            const float* s = block->channelPtr(channel);
+            for (int64_t i = 0; i < block->frameCount(); i++) {
+                identical &= s[i] == sampleValue(channel, frame + i);
+            }
+        }
+        frame += block->frameCount();
+    }
+
+    GRAIN_CHECK(reader.lastError() == ErrorCode::None);
+    GRAIN_CHECK(frame == kFrameCount);
+    GRAIN_CHECK(identical);
+}
+
+
+static void checkNormalize(const String& src_path, const String& dst_path) {
+    auto err = SignalFileProcessor::normalize(src_path, dst_path, Signal::FileContainerFormat::WAV, Signal::FileSampleEncoding::Float,
+                                              0.5f, SignalFileReader::kDefaultBlockLength, kMaxBufferedFrames);
+    GRAIN_CHECK(err == ErrorCode::None);
+
+    float peak = 0.0f;
+    for (int32_t channel = 0; channel < kChannelCount; channel++) {
+        for (int64_t i = 0; i < kFrameCount; i++) {
+            peak = std::max(peak, std::fabs(sampleValue(channel, i)));
+        }
+    }
+
+    SignalFileReader reader;
+    GRAIN_CHECK(reader.open(dst_path) == ErrorCode::None);
+    GRAIN_CHECK(reader.frameCount() == kFrameCount);
+
+    float max_error = 0.0f;
+    int64_t frame = 0;
+    while (auto block = reader.nextBlock()) {
+        for (int32_t channel = 0; channel < kChannelCount; channel++) {
+            const float* s = block->channelPtr(channel);
+            for (int64_t i = 0; i < block->frameCount(); i++) {
+                max_error = std::max(max_error, std::fabs(s[i] - sampleValue(channel, frame + i) * (0.5f / peak)));
+            }
+        }
+        frame += block->frameCount();
+    }
+    GRAIN_CHECK(frame == kFrameCount);
+    GRAIN_CHECK(max_error < 1e-6f);
+}
+
+
+/**
+ *  Streaming must give the same samples as resampling the whole buffer.
+ */
+static void checkResample(const String& src_path, const String& dst_path, int32_t sample_rate) {
+    auto err = SignalFileProcessor::resample(src_path, dst_path, Signal::FileContainerFormat::WAV, Signal::FileSampleEncoding::Float,
+                                             sample_rate, Resampler::Quality::Medium, SignalFileReader::kDefaultBlockLength, kMaxBufferedFrames);
+    GRAIN_CHECK(err == ErrorCode::None);
+
+    Resampler resampler(kSampleRate, sample_rate, Resampler::Quality::Medium);
+    int64_t expected_len = resampler.outputLength(kFrameCount);
+
+    std::vector<float> input(kFrameCount);
+    std::vector<float> expected(expected_len);
+    for (int64_t i = 0; i < kFrameCount; i++) {
+        input[i] = sampleValue(1, i);
+    }
+    GRAIN_CHECK(resampler.resample(input.data(), kFrameCount, 1, expected.data(), expected_len, 1) == ErrorCode::None);
+
+    SignalFileReader reader;
+    GRAIN_CHECK(reader.open(dst_path) == ErrorCode::None);
+    GRAIN_CHECK(reader.sampleRate() == sample_rate);
+    GRAIN_CHECK(reader.frameCount() == expected_len);
+
+    float max_error = 0.0f;
+    int64_t frame = 0;
+    while (auto block = reader.nextBlock()) {
+        const float* s = block->channelPtr(1);
+        for (int64_t i = 0; i < block->frameCount() && frame + i < expected_len; i++) {
+            max_error = std::max(max_error, std::fabs(s[i] - expected[frame + i]));
+        }
+        frame += block->frameCount();
+    }
+    GRAIN_CHECK(frame == expected_len);
+    GRAIN_CHECK(max_error < 1e-5f);
+}
+
+
+int main() {
+    auto src_path = tempPath("grain_signal_file_test_src.wav");
+    auto dst_path = tempPath("grain_signal_file_test_dst.wav");
+
+    writeSourceFile(src_path);
+
+    checkReader(src_path, 0);
+    checkReader(src_path, 4);
+
+    checkNormalize(src_path, dst_path);
+    checkResample(src_path, dst_path, 44100);
+    checkResample(src_path, dst_path, 96000);
+
+    // Too small limits are rejected
+    SignalFileReader reader;
+    GRAIN_CHECK(reader.open(src_path, 1024, 2, 1) == ErrorCode::BadArgs);
+    GRAIN_CHECK(SignalFileProcessor::normalize(src_path, dst_path, Signal::FileContainerFormat::WAV, Signal::FileSampleEncoding::Float,
+                                               1.0f, 1024, SignalFileProcessor::kMinBufferedFrames - 1) == ErrorCode::BadArgs);
+
+    std::filesystem::remove(src_path.utf8());
+    std::filesystem::remove(dst_path.utf8());
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,131 @@
+//
+//  SignalFilterBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Signal/SignalButterworthFilter.hpp"
+#include "Signal/SignalBandPassFilter.hpp"
+#include "Signal/SignalLowPassFilter.hpp"
+#include "Signal/SignalAllPassFilter.hpp"
+#include "Signal/SignalLadderFilter.hpp"
+#include "Signal/SignalFormantFilter.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Prints samples per second of `process()`, `processBlock()` and, where
+ *  available, `processInterleaved()` with 8 channels, per filter type.
+ */
+
+static constexpr int64_t kSampleCount = 1 << 22;
+static constexpr int32_t kSampleRate = 48000;
+
+static std::vector<float> g_input;
+static std::vector<float> g_output;
+static float g_sink = 0.0f;
+
+
+static double perSample(SignalFilter& filter) {
+    Test::Stopwatch stopwatch;
+    for (int64_t i = 0; i < kSampleCount; i++) {
+        g_output[i] = filter.process(g_input[i]);
+    }
+    g_sink += g_output[kSampleCount - 1];
+    return kSampleCount / stopwatch.seconds();
+}
+
+
+static double perBlock(SignalFilter& filter) {
+    Test::Stopwatch stopwatch;
+    for (int64_t i = 0; i < kSampleCount; i += SignalFilter::kBlockSize) {
+        filter.processBlock(&g_input[i], &g_output[i], SignalFilter::kBlockSize);
+    }
+    g_sink += g_output[kSampleCount - 1];
+    return kSampleCount / stopwatch.seconds();
+}
+
+
+template <typename T>
+static double interleaved(T& filter) {
+    const int32_t channel_count = SignalFilter::kMaxLaneCount;
+    Test::Stopwatch stopwatch;
+    filter.processInterleaved(g_input.data(), g_output.data(), kSampleCount / channel_count, channel_count);
+    g_sink += g_output[kSampleCount - 1];
+    return kSampleCount / stopwatch.seconds();
+}
+
+
+static void report(const char* name, double process_rate, double block_rate, double interleaved_rate = 0.0) {
+    std::printf("%-28s %10.1f %10.1f", name, process_rate * 1.0e-6, block_rate * 1.0e-6);
+    if (interleaved_rate > 0.0) {
+        std::printf(" %10.1f", interleaved_rate * 1.0e-6);
+    }
+    std::printf("\n");
+}
+
+
+template <typename T>
+static void run(const char* name, T& filter) {
+    double process_rate = perSample(filter);
+    filter.reset();
+    double block_rate = perBlock(filter);
+    if constexpr (requires { filter.processInterleaved(nullptr, nullptr, 0, 0); }) {
+        report(name, process_rate, block_rate, interleaved(filter));
+    }
+    else {
+        report(name, process_rate, block_rate);
+    }
+}
+
+
+int main() {
+    g_input.resize(kSampleCount);
+    g_output.resize(kSampleCount);
+    uint32_t seed = 1;
+    for (auto& v : g_input) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+    }
+
+    std::printf("Million samples per second\n");
+    std::printf("%-28s %10s %10s %10s\n", "filter", "process", "block", "8 lanes");
+
+    SignalButterworthFilter butterworth_lp(kSampleRate, SignalButterworthFilter::FilterType::LowPass, 1000.0f);
+    run("Butterworth low pass", butterworth_lp);
+
+    SignalButterworthFilter butterworth_bp(kSampleRate, SignalButterworthFilter::FilterType::BandPass, 1000.0f);
+    butterworth_bp.setFreqRange(500.0f, 2000.0f);
+    run("Butterworth band pass", butterworth_bp);
+
+    SignalBandPassFilter band_pass(kSampleRate, SignalBandPassFilter::FilterType::BandPass1, 300.0f, 3000.0f);
+    run("Band pass", band_pass);
+
+    SignalLowPassFilter low_pass(kSampleRate);
+    low_pass.setFreq(2000.0f, 0.5f);
+    run("Low pass", low_pass);
+
+    SignalAllPassFilter all_pass(kSampleRate);
+    all_pass.setStageCount(6);
+    run("All pass, 6 stages", all_pass);
+
+    SignalLadderFilter ladder(kSampleRate);
+    ladder.setFreq(1500.0f, 0.5f);
+    run("Ladder", ladder);
+
+    float formants[] = { 700.0f, 0.0f, 80.0f, 1200.0f, -6.0f, 90.0f, 2600.0f, -12.0f, 120.0f, 3300.0f, -18.0f, 130.0f, 4200.0f, -24.0f, 140.0f };
+    SignalFormantFilter formant(kSampleRate);
+    formant.setByData(5, formants);
+    run("Formant, 5 bands", formant);
+
+    return g_sink == 12345.0f ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+//
+//  SignalFilterTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Signal/SignalButterworthFilter.hpp"
+#include "Signal/SignalBandPassFilter.hpp"
+#include "Signal/SignalLowPassFilter.hpp"
+#include "Signal/SignalAllPassFilter.hpp"
+#include "Signal/SignalLadderFilter.hpp"
+#include "Signal/SignalFormantFilter.hpp"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace Grain;
+
+
+static std::vector<float> noise(int64_t n, uint32_t seed) {
+    std::vector<float> result(n);
+    for (auto& v : result) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+    }
+    return result;
+}
+
+
+/**
+ *  `processBlock()`, in blocks of varying length, must give bit-identical
+ *  results to `process()` per sample.
+ */
+static void checkBlockMatchesProcess(const char* name, const std::function<std::unique_ptr<SignalFilter>()>& make) {
+    const int64_t n = 10000;
+    auto input = noise(n, 1234);
+
+    auto a = make();
+    auto b = make();
+
+    std::vector<float> expected(n), actual(n);
+    for (int64_t i = 0; i < n; i++) {
+        expected[i] = a->process(input[i]);
+    }
+
+    int64_t pos = 0, len = 1;
+    while (pos < n) {
+        auto count = std::min(len, n - pos);
+        b->processBlock(&input[pos], &actual[pos], count);
+        pos += count;
+        len = len * 3 % 1021 + 1;
+    }
+
+    bool identical = std::memcmp(expected.data(), actual.data(), n * sizeof(float)) == 0;
+    if (!identical) {
+        std::cerr << name << ": processBlock() differs from process()" << std::endl;
+    }
+    GRAIN_CHECK(identical);
+}
+
+
+/**
+ *  Each channel of `processInterleaved()` must give the same result as
+ *  `processBlock()` on a filter of its own.
+ */
+template <typename T>
+static void checkInterleavedMatchesBlock(const char* name, const std::function<std::unique_ptr<T>()>& make) {
+    const int64_t frame_count = 4000;
+
+    for (int32_t channel_count = 1; channel_count <= SignalFilter::kMaxLaneCount; channel_count++) {
+        auto input = noise(frame_count * channel_count, 99 + channel_count);
+        std::vector<float> output(input.size());
+
+        auto filter = make();
+        GRAIN_CHECK(filter->processInterleaved(input.data(), output.data(), frame_count, channel_count) == ErrorCode::None);
+
+        for (int32_t c = 0; c < channel_count; c++) {
+            std::vector<float> channel(frame_count), expected(frame_count);
+            for (int64_t i = 0; i < frame_count; i++) {
+                channel[i] = input[i * channel_count + c];
+            }
+
+            auto reference = make();
+            reference->processBlock(channel.data(), expected.data(), frame_count);
+
+            bool equal = true;
+            for (int64_t i = 0; i < frame_count; i++) {
+                equal = equal && output[i * channel_count + c] == expected[i];
+            }
+            if (!equal) {
+                std::cerr << name << ": processInterleaved() channel " << c << " of " << channel_count << " differs" << std::endl;
+            }
+            GRAIN_CHECK(equal);
+        }
+    }
+
+    auto filter = make();
+    float dummy[SignalFilter::kMaxLaneCount + 1]{};
+    GRAIN_CHECK(filter->processInterleaved(dummy, dummy, 1, SignalFilter::kMaxLaneCount + 1) == ErrorCode::BadArgs);
+}
+
+
+int main() {
+    const int32_t sample_rate = 48000;
+
+    using BW = SignalButterworthFilter;
+    for (auto type : { BW::FilterType::LowPass, BW::FilterType::HighPass, BW::FilterType::BandPass, BW::FilterType::BandStop }) {
+        for (bool inverted : { false, true }) {
+            auto make = [=]() {
+                auto f = std::make_unique<BW>(sample_rate, type, 1000.0f);
+                f->setFreqRange(500.0f, 2000.0f);
+                f->setInverted(inverted);
+                return f;
+            };
+            checkBlockMatchesProcess("SignalButterworthFilter", make);
+            checkInterleavedMatchesBlock<BW>("SignalButterworthFilter", make);
+        }
+    }
+
+    for (bool inverted : { false, true }) {
+        auto make_band_pass = [=]() {
+            auto f = std::make_unique<SignalBandPassFilter>(sample_rate, SignalBandPassFilter::FilterType::BandPass1, 300.0f, 3000.0f);
+            f->setInverted(inverted);
+            return f;
+        };
+        checkBlockMatchesProcess("SignalBandPassFilter", make_band_pass);
+        checkInterleavedMatchesBlock<SignalBandPassFilter>("SignalBandPassFilter", make_band_pass);
+
+        auto make_low_pass = [=]() {
+            auto f = std::make_unique<SignalLowPassFilter>(sample_rate);
+            f->setFreq(2000.0f, 0.7f);
+            f->setInverted(inverted);
+            return f;
+        };
+        checkBlockMatchesProcess("SignalLowPassFilter", make_low_pass);
+        checkInterleavedMatchesBlock<SignalLowPassFilter>("SignalLowPassFilter", make_low_pass);
+
+        for (float feedback : { 0.0f, 0.6f }) {
+            checkBlockMatchesProcess("SignalAllPassFilter", [=]() {
+                auto f = std::make_unique<SignalAllPassFilter>(sample_rate);
+                f->setFreq(1200.0f);
+                f->setStageCount(6);
+                f->setFeedback(feedback, inverted);
+                f->setInverted(inverted);
+                return f;
+            });
+        }
+    }
+
+    checkBlockMatchesProcess("SignalLadderFilter", [=]() {
+        auto f = std::make_unique<SignalLadderFilter>(sample_rate);
+        f->setFreq(1500.0f, 0.6f);
+        return f;
+    });
+
+    checkBlockMatchesProcess("SignalFormantFilter", [=]() {
+        float data[] = { 700.0f, 0.0f, 80.0f, 1200.0f, -6.0f, 90.0f, 2600.0f, -12.0f, 120.0f, 3300.0f, -18.0f, 130.0f, 4200.0f, -24.0f, 140.0f };
+        auto f = std::make_unique<SignalFormantFilter>(sample_rate);
+        f->setByData(5, data);
+        return f;
+    });
+
+    return Test::result();
+}
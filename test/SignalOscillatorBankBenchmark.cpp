@@ -0,0 +1,75 @@
+//
+//  SignalOscillatorBankBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Signal/SignalWave.hpp"
+#include "Signal/SignalOscillatorBank.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  Prints million voice samples per second and the real time factor of
+ *  `SignalOscillatorBank::render()` for different voice counts, with the
+ *  frequencies of all voices ramped in every block.
+ */
+
+static constexpr int32_t kSampleRate = 48000;
+static constexpr int32_t kBlockLength = 256;
+static constexpr int32_t kSeconds = 4;
+
+static float g_sink = 0.0f;
+
+
+static void run(const SignalWave* wave, int32_t voice_count) {
+    SignalOscillatorBank bank(wave, kSampleRate);
+    bank.setVoiceCount(voice_count);
+    for (int32_t v = 0; v < voice_count; v++) {
+        bank.setVoice(v, 55.0f + static_cast<float>(v) * 7.3f, 1.0f / static_cast<float>(voice_count));
+    }
+
+    std::vector<float> out(kBlockLength);
+    int64_t block_count = static_cast<int64_t>(kSeconds) * kSampleRate / kBlockLength;
+
+    Test::Stopwatch stopwatch;
+    for (int64_t block = 0; block < block_count; block++) {
+        float detune = (block & 1) ? 1.001f : 0.999f;
+        for (int32_t v = 0; v < voice_count; v++) {
+            bank.rampVoice(v, bank.voiceFreq(v) * detune, bank.voiceAmplitude(v));
+        }
+        bank.render(out.data(), kBlockLength);
+        g_sink += out[kBlockLength - 1];
+    }
+    double seconds = stopwatch.seconds();
+
+    double voice_samples = static_cast<double>(block_count) * kBlockLength * voice_count;
+    std::printf("%8d %14.1f %12.2f\n", voice_count, voice_samples / seconds * 1.0e-6, kSeconds / seconds);
+}
+
+
+int main() {
+    SignalWave wave(2048, kSampleRate);
+    wave.setPitch(0);
+    wave.addSaw();
+    if (wave.buildMipLevels(0) != ErrorCode::None) {
+        std::printf("buildMipLevels() failed\n");
+        return 1;
+    }
+
+    std::printf("%8s %14s %12s\n", "voices", "M samples/s", "x real time");
+    for (int32_t voice_count : { 1, 8, 64, 512, 2048 }) {
+        run(&wave, voice_count);
+    }
+
+    return g_sink == 12345.0f ? 1 : 0;
+}
@@ -0,0 +1,311 @@
+//
+//  SignalStatsTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Signal/Signal.hpp"
+#include "Signal/SignalStats.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  `SignalStats` and `Signal::stats()` are compared to a naive scalar loop,
+ *  on lengths around the block length, on ranges split into parts and on
+ *  signals long enough to be split across threads.
+ */
+
+struct NaiveStats {
+    int64_t count = 0;
+    double sum = 0.0;
+    double abs_sum = 0.0;
+    double square_sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    int64_t min_index = -1;
+    int64_t max_index = -1;
+    int64_t zero_crossings = 0;
+};
+
+
+/**
+ *  Simple deterministic generator, values in [0, 1).
+ */
+static double nextRandom() {
+    static uint32_t seed = 1;
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<double>(seed >> 8) / 16777216.0;
+}
+
+
+/**
+ *  Statistics of `count` samples at a distance of `step`. Sample `i` is
+ *  reported at index `first_index + i * index_stride`.
+ */
+template <typename T>
+static NaiveStats naiveStats(const T* samples, int64_t count, int64_t step, int64_t first_index, int64_t index_stride) {
+    NaiveStats result;
+    for (int64_t i = 0; i < count; i++) {
+        auto v = static_cast<double>(samples[i * step]);
+        result.sum += v;
+        result.abs_sum += std::fabs(v);
+        result.square_sum += v * v;
+        if (i == 0 || v < result.min) {
+            result.min = v;
+            result.min_index = first_index + i * index_stride;
+        }
+        if (i == 0 || v > result.max) {
+            result.max = v;
+            result.max_index = first_index + i * index_stride;
+        }
+        if (i > 0 && (samples[(i - 1) * step] < T(0)) != (samples[i * step] < T(0))) {
+            result.zero_crossings++;
+        }
+    }
+    result.count = count;
+    return result;
+}
+
+
+static bool isClose(double a, double b) {
+    return std::fabs(a - b) <= 1.0e-9 * std::max(1.0, std::max(std::fabs(a), std::fabs(b)));
+}
+
+
+static bool equals(const SignalStats& stats, const NaiveStats& expected) {
+    return stats.count() == expected.count &&
+           isClose(stats.sum(), expected.sum) &&
+           isClose(stats.absSum(), expected.abs_sum) &&
+           isClose(stats.squareSum(), expected.square_sum) &&
+           stats.min() == expected.min &&
+           stats.max() == expected.max &&
+           stats.minIndex() == expected.min_index &&
+           stats.maxIndex() == expected.max_index &&
+           stats.zeroCrossings() == expected.zero_crossings;
+}
+
+
+/**
+ *  Lengths around the block and lane sizes, unit and larger steps. The
+ *  extremes occur twice, the first index must be reported.
+ */
+template <typename T>
+static void checkAccumulate(double amplitude) {
+    const int64_t block = SignalStats::kBlockLength;
+
+    for (int64_t count : std::vector<int64_t>{ 1, 2, 7, 8, 9, block - 1, block, block + 1, block * 3 + 5 }) {
+        for (int64_t step : { 1, 3 }) {
+            std::vector<T> samples(count * step);
+            for (auto& sample : samples) {
+                sample = static_cast<T>((nextRandom() * 2.0 - 1.0) * amplitude * 0.9);
+            }
+            if (count > 4) {
+                samples[(count / 3) * step] = samples[(count - 1) * step] = static_cast<T>(amplitude);
+                samples[(count / 4) * step] = samples[(count / 2) * step] = static_cast<T>(-amplitude);
+            }
+
+            SignalStats stats;
+            stats.accumulate(samples.data(), count, step, 100, SignalStats::kAll);
+            GRAIN_CHECK(equals(stats, naiveStats(samples.data(), count, step, 100, 1)));
+        }
+    }
+}
+
+
+/**
+ *  Parts merged in order equal the whole range, including zero crossings
+ *  at the part borders.
+ */
+static void checkMerge() {
+    const int64_t count = 20000;
+    std::vector<float> samples(count);
+    for (auto& sample : samples) {
+        sample = static_cast<float>(nextRandom() * 2.0 - 1.0);
+    }
+
+    const std::vector<std::vector<int64_t>> split_lists = {
+        { 1 }, { 4096 }, { 4097, 9000 }, { 1234, 1235, 15000 }, { 8192, 12288, 16384, 19999 }
+    };
+
+    for (auto& splits : split_lists) {
+        for (int64_t split : splits) {
+            samples[split - 1] = -0.5f;
+            samples[split] = 0.5f;
+        }
+
+        SignalStats stats;
+        int64_t begin = 0;
+        for (size_t i = 0; i <= splits.size(); i++) {
+            int64_t end = i < splits.size() ? splits[i] : count;
+            SignalStats part;
+            part.accumulate(samples.data() + begin, end - begin, 1, begin, SignalStats::kAll);
+            stats.merge(part, true);
+            begin = end;
+        }
+        GRAIN_CHECK(equals(stats, naiveStats(samples.data(), count, 1, 0, 1)));
+    }
+}
+
+
+/**
+ *  A stereo float signal long enough for four threads. Signs change at the
+ *  borders of the thread ranges, the max value occurs in two ranges.
+ */
+static void checkSignalThreads() {
+    const int64_t count = Signal::kMinSamplesPerStatsThread * 4 + 12345;
+    Signal signal(2, 48000, count);
+    GRAIN_CHECK(signal.hasData());
+    if (!signal.hasData()) {
+        return;
+    }
+
+    for (int64_t i = 0; i < count; i++) {
+        signal.writeFloat(0, i, static_cast<float>(0.8 * std::sin(i * 0.0007) + 0.1 * (nextRandom() - 0.5)));
+        signal.writeFloat(1, i, static_cast<float>(0.5 * (nextRandom() - 0.5)));
+    }
+    for (int32_t thread_count : { 2, 3, 4 }) {
+        for (int32_t i = 1; i < thread_count; i++) {
+            int64_t border = count * i / thread_count;
+            signal.writeFloat(0, border - 1, -0.25f);
+            signal.writeFloat(0, border, 0.25f);
+        }
+    }
+    signal.writeFloat(0, count / 8, 0.95f);
+    signal.writeFloat(0, count - 3, 0.95f);
+
+    auto data = static_cast<const float*>(signal.dataPtr(0, 0));
+    NaiveStats expected[2] = {
+        naiveStats(data, count, 2, 0, 1),
+        naiveStats(data + 1, count, 2, 0, 1)
+    };
+
+    for (int32_t thread_count : { 1, 2, 3, 4 }) {
+        for (int32_t channel = 0; channel < 2; channel++) {
+            SignalStats stats;
+            GRAIN_CHECK(signal.stats(channel, 0, -1, stats, SignalStats::kAll, 1, thread_count) == ErrorCode::None);
+            GRAIN_CHECK(equals(stats, expected[channel]));
+        }
+
+        // All channels, zero crossings are summed up per channel
+        SignalStats stats;
+        GRAIN_CHECK(signal.stats(-1, 0, -1, stats, SignalStats::kAll, 1, thread_count) == ErrorCode::None);
+        GRAIN_CHECK(stats.count() == count * 2);
+        GRAIN_CHECK(stats.zeroCrossings() == expected[0].zero_crossings + expected[1].zero_crossings);
+        GRAIN_CHECK(stats.max() == expected[0].max && stats.maxIndex() == expected[0].max_index);
+    }
+}
+
+
+/**
+ *  With an offset and a stride, the indices are sample indices of the
+ *  signal. Int16 data, long enough for four threads.
+ */
+static void checkSignalStride() {
+    const int64_t stride = 3;
+    const int64_t offs = 777;
+    const int64_t len = Signal::kMinSamplesPerStatsThread * 4 * stride + 1000;
+    const int64_t count = offs + len + 500;
+
+    Signal signal(1, 48000, count, DataType::Int16);
+    GRAIN_CHECK(signal.hasData());
+    if (!signal.hasData()) {
+        return;
+    }
+
+    for (int64_t i = 0; i < count; i++) {
+        signal.writeInt16(0, i, static_cast<int16_t>((nextRandom() * 2.0 - 1.0) * 20000.0));
+    }
+
+    // Extremes outside the range, between the strided samples and on them
+    signal.writeInt16(0, offs - 1, 32767);
+    signal.writeInt16(0, offs + 1, 32767);
+    signal.writeInt16(0, offs + len, -32768);
+    signal.writeInt16(0, offs + stride * 1000000, 32000);
+    signal.writeInt16(0, offs + stride * 3000000, -32000);
+
+    auto data = static_cast<const int16_t*>(signal.dataPtr(0, offs));
+    auto expected = naiveStats(data, (len + stride - 1) / stride, stride, offs, stride);
+    GRAIN_CHECK(expected.max_index == offs + stride * 1000000);
+    GRAIN_CHECK(expected.min_index == offs + stride * 3000000);
+
+    for (int32_t thread_count : { 1, 4 }) {
+        SignalStats stats;
+        GRAIN_CHECK(signal.stats(0, offs, len, stats, SignalStats::kAll, stride, thread_count) == ErrorCode::None);
+        GRAIN_CHECK(equals(stats, expected));
+    }
+}
+
+
+static void checkHistogram() {
+    const int64_t count = Signal::kMinSamplesPerStatsThread * 4 + 99;
+    Signal signal(1, 48000, count);
+    for (int64_t i = 0; i < count; i++) {
+        signal.writeFloat(0, i, static_cast<float>(nextRandom() * 2.4 - 1.2));
+    }
+
+    const int32_t bin_count = 16;
+    std::vector<int64_t> expected(bin_count, 0);
+    auto data = static_cast<const float*>(signal.dataPtr(0, 0));
+    for (int64_t i = 0; i < count; i++) {
+        auto bin = static_cast<int32_t>(std::floor((data[i] + 1.0) * bin_count / 2.0));
+        expected[std::clamp(bin, 0, bin_count - 1)]++;
+    }
+
+    for (int32_t thread_count : { 1, 4 }) {
+        std::vector<int64_t> bins;
+        GRAIN_CHECK(signal.histogram(0, 0, -1, -1.0, 1.0, bin_count, bins, thread_count) == ErrorCode::None);
+        GRAIN_CHECK(bins == expected);
+    }
+}
+
+
+/**
+ *  Each value of a simplified signal is the RMS of one step.
+ */
+static void checkSimplifiedSignal() {
+    const int64_t count = Signal::kMinSamplesPerStatsThread * 2 + 1000;
+    Signal signal(1, 48000, count);
+    for (int64_t i = 0; i < count; i++) {
+        signal.writeFloat(0, i, static_cast<float>(std::sin(i * 0.001) * (static_cast<double>(i) / count)));
+    }
+
+    SimplifiedSignal simplified;
+    simplified.update(&signal, 0);
+    GRAIN_CHECK(simplified.len() == (count + SimplifiedSignal::kStep - 1) / SimplifiedSignal::kStep);
+
+    double scale = 32767.0 / signal.fullScaleValue();
+    auto data = static_cast<const float*>(signal.dataPtr(0, 0));
+    int32_t mismatch_count = 0;
+    for (int64_t i = 0; i < simplified.len(); i++) {
+        int64_t n = std::min<int64_t>(SimplifiedSignal::kStep, count - i * SimplifiedSignal::kStep);
+        auto expected = naiveStats(data + i * SimplifiedSignal::kStep, n, 1, 0, 1);
+        double rms = std::sqrt(expected.square_sum / static_cast<double>(n));
+        if (std::abs(simplified.valuesPtr()[i] - static_cast<int16_t>(std::min(rms * scale, 32767.0))) > 1) {
+            mismatch_count++;
+        }
+    }
+    GRAIN_CHECK(mismatch_count == 0);
+}
+
+
+int main() {
+    checkAccumulate<int16_t>(32767.0);
+    checkAccumulate<float>(1.0);
+    checkAccumulate<double>(1.0);
+    checkMerge();
+    checkSignalThreads();
+    checkSignalStride();
+    checkHistogram();
+    checkSimplifiedSignal();
+
+    return Grain::Test::result();
+}
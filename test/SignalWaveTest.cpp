@@ -0,0 +1,126 @@
+//
+//  SignalWaveTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "Signal/SignalWave.hpp"
+#include "Signal/SignalOscillatorBank.hpp"
+#include "DSP/FFT.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  A saw is rendered for exactly `cycles` cycles of the analysis length. As
+ *  `kFFTLength` is a power of two and `cycles` is prime, every harmonic lies
+ *  exactly on a multiple of `cycles`, while every alias of a harmonic above
+ *  Nyquist lies on another bin. The energy outside the harmonic bins
+ *  relative to the total energy is the alias energy.
+ */
+
+static constexpr int32_t kSampleRate = 48000;
+static constexpr int32_t kLogN = 16;
+static constexpr int32_t kFFTLength = 1 << kLogN;
+static constexpr int32_t kResolution = 4096;
+
+
+static float testFreq(int32_t cycles) {
+    return static_cast<float>(static_cast<double>(cycles) * kSampleRate / kFFTLength);
+}
+
+
+static double aliasEnergyDB(const std::vector<float>& samples, int32_t cycles) {
+    FFT fft(kLogN);
+    std::vector<float> real(kFFTLength / 2 + 1);
+    std::vector<float> imag(kFFTLength / 2 + 1);
+    GRAIN_CHECK(fft.forward(samples.data(), real.data(), imag.data()) == ErrorCode::None);
+
+    double harmonic_energy = 0.0;
+    double alias_energy = 0.0;
+    for (int32_t bin = 1; bin <= kFFTLength / 2; bin++) {
+        double e = static_cast<double>(real[bin]) * real[bin] + static_cast<double>(imag[bin]) * imag[bin];
+        if (bin % cycles == 0) {
+            harmonic_energy += e;
+        }
+        else {
+            alias_energy += e;
+        }
+    }
+
+    return 10.0 * std::log10(alias_energy / (harmonic_energy + alias_energy) + 1.0e-30);
+}
+
+
+static SignalWave* sawWave(bool mip_levels) {
+    auto wave = new SignalWave(kResolution, kSampleRate);
+    wave->setPitch(0);
+    wave->addSaw();
+    if (mip_levels) {
+        GRAIN_CHECK(wave->buildMipLevels(0) == ErrorCode::None);
+    }
+    return wave;
+}
+
+
+static double bankAliasEnergyDB(const SignalWave* wave, int32_t cycles) {
+    SignalOscillatorBank bank(wave, kSampleRate);
+    GRAIN_CHECK(bank.isValid());
+    GRAIN_CHECK(bank.setVoiceCount(1) == ErrorCode::None);
+    bank.setVoice(0, testFreq(cycles), 0.5f);
+
+    std::vector<float> samples(kFFTLength);
+    bank.render(samples.data(), kFFTLength);
+    return aliasEnergyDB(samples, cycles);
+}
+
+
+static double lookupAliasEnergyDB(SignalWave* wave, int32_t cycles) {
+    SignalWaveLookUpInfo info(kSampleRate);
+    info.setFreq(testFreq(cycles));
+
+    std::vector<float> samples(kFFTLength);
+    for (auto& s : samples) {
+        s = wave->lookup(info) * 0.5f;
+        info.stepForward();
+    }
+    return aliasEnergyDB(samples, cycles);
+}
+
+
+static void check(const char* name, int32_t cycles, double db, double max_db) {
+    if (db > max_db) {
+        std::cerr << name << ", " << testFreq(cycles) << " Hz: alias energy " << db << " dB" << std::endl;
+    }
+    GRAIN_CHECK(db <= max_db);
+}
+
+
+int main() {
+    auto plain_saw = sawWave(false);
+    auto mip_saw = sawWave(true);
+
+    // The plain table aliases strongly, the mip levels must remove it for
+    // the bank and for `lookup()`
+    for (int32_t cycles : { 1409, 7919 }) {    // About 1032 and 5800 Hz
+        GRAIN_CHECK(bankAliasEnergyDB(plain_saw, cycles) > -40.0);
+        check("SignalOscillatorBank, mip levels", cycles, bankAliasEnergyDB(mip_saw, cycles), -100.0);
+        check("SignalWave::lookup(), mip levels", cycles, lookupAliasEnergyDB(mip_saw, cycles), -100.0);
+    }
+
+    // One table per octave from pitch 0
+    GRAIN_CHECK(SignalOscillatorBank(mip_saw, kSampleRate).levelCount() > 1);
+
+    delete plain_saw;
+    delete mip_saw;
+
+    return Grain::Test::result();
+}
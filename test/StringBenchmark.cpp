@@ -0,0 +1,182 @@
+//
+//  StringBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "String/String.hpp"
+#include "String/StringBuilder.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Grain;
+
+
+/**
+ *  Prints ns per operation and heap allocations per operation for typical
+ *  string building workloads, with `String`, with a heap `StringBuilder` and
+ *  with a `StringBuilder` using the arena of the thread.
+ *
+ *  Allocations are counted with glibc, by replacing `malloc()`, `calloc()`
+ *  and `realloc()`. On other platforms only the times are printed.
+ */
+
+#if defined(__GLIBC__)
+static std::atomic<int64_t> g_alloc_count{ 0 };
+
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+
+    void* malloc(size_t size) {
+        g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) {
+        g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) {
+        g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+}
+
+static int64_t allocCount() { return g_alloc_count.load(std::memory_order_relaxed); }
+#else
+static int64_t allocCount() { return -1; }
+#endif
+
+
+static int64_t g_sink = 0;
+
+
+template <typename F>
+static void run(const char* name, int32_t op_count, F op) {
+    op(0);  // Warm up, e.g. the blocks of the arena
+
+    int64_t alloc_count = allocCount();
+    Test::Stopwatch stopwatch;
+    for (int32_t i = 0; i < op_count; i++) {
+        op(i);
+    }
+    double seconds = stopwatch.seconds();
+    alloc_count = allocCount() - alloc_count;
+
+    std::printf("%-28s %10.1f", name, seconds * 1.0e9 / op_count);
+    if (alloc_count >= 0) {
+        std::printf(" %10.2f", static_cast<double>(alloc_count) / op_count);
+    }
+    std::printf("\n");
+}
+
+
+template <typename Builder>
+static void tilePath(Builder& b, const String& dir, const String& ext, int32_t i) {
+    b += dir;
+    b += "/_tile_";
+    b += i & 63;
+    b += '.';
+    b += ext;
+}
+
+
+template <typename Builder>
+static void logLine(Builder& b, int32_t i) {
+    b += "Tile ";
+    b += i & 15;
+    b += "/";
+    b += i;
+    b += " rendered in ";
+    b.appendDouble(i * 0.001, 3);
+    b += " ms";
+}
+
+
+template <typename Builder>
+static void csvRow(Builder& b, int32_t i) {
+    for (int32_t k = 0; k < 12; k++) {
+        if (k > 0) {
+            b.appendChar(',');
+        }
+        b.appendDouble(i * 0.37 + k * 1234.5678, 6);
+    }
+}
+
+
+template <typename Builder>
+static void sqlQuery(Builder& b, int32_t i) {
+    b += "SELECT geom, name FROM roads WHERE ST_Intersects(geom, ST_MakeEnvelope(";
+    b.appendDouble(i * 0.5, 6);
+    b += ", ";
+    b.appendDouble(i * 0.25, 6);
+    b += ", ";
+    b.appendDouble(i * 0.5 + 10.0, 6);
+    b += ", ";
+    b.appendDouble(i * 0.25 + 10.0, 6);
+    b += ", 3857)) AND zoom <= ";
+    b += i & 31;
+    b += ";";
+}
+
+
+int main() {
+    String dir("/tmp/render/meta_tmp_0001");
+    String ext("png");
+    StringArena* arena = &StringArena::threadArena();
+
+    std::printf("%-28s %10s %10s\n", "workload", "ns/op", "allocs/op");
+
+    run("tile path, operator +", 1000000, [&](int32_t i) {
+        String path = dir + "/_tile_" + (i & 63) + "." + ext;
+        g_sink += path.byteLength();
+    });
+    run("tile path, String", 1000000, [&](int32_t i) {
+        String s; tilePath(s, dir, ext, i); g_sink += s.byteLength();
+    });
+    run("tile path, builder", 1000000, [&](int32_t i) {
+        StringBuilder b(128); tilePath(b, dir, ext, i); g_sink += b.byteLength();
+    });
+    run("tile path, arena builder", 1000000, [&](int32_t i) {
+        StringBuilder b(128, arena); tilePath(b, dir, ext, i); g_sink += b.byteLength();
+    });
+
+    run("log line, String", 1000000, [&](int32_t i) {
+        String s; logLine(s, i); g_sink += s.byteLength();
+    });
+    run("log line, arena builder", 1000000, [&](int32_t i) {
+        StringBuilder b(128, arena); logLine(b, i); g_sink += b.byteLength();
+    });
+
+    run("csv row, String", 300000, [&](int32_t i) {
+        String s; csvRow(s, i); g_sink += s.byteLength();
+    });
+    run("csv row, arena builder", 300000, [&](int32_t i) {
+        StringBuilder b(256, arena); csvRow(b, i); g_sink += b.byteLength();
+    });
+
+    run("sql query, String", 300000, [&](int32_t i) {
+        String s; sqlQuery(s, i); g_sink += s.byteLength();
+    });
+    run("sql query, arena builder", 300000, [&](int32_t i) {
+        StringBuilder b(256, arena); sqlQuery(b, i); g_sink += b.byteLength();
+    });
+
+    run("short string copy", 3000000, [&](int32_t) {
+        String a("layer");
+        String b(a);
+        g_sink += b.byteLength();
+    });
+
+    return g_sink == 12345 ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+//
+//  StringBuilderTest.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "String/String.hpp"
+#include "String/StringBuilder.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Grain;
+
+
+/**
+ *  The inline buffer holds `kLocalBufferSize - 1` bytes, a string of exactly
+ *  the capacity must not grow.
+ */
+static void checkStringCapacity() {
+    std::string text(String::kLocalBufferSize - 1, 'x');
+    String string(text.c_str());
+    GRAIN_CHECK(string.usesLocalBuffer());
+    GRAIN_CHECK(string.byteLength() == String::kLocalBufferSize - 1);
+
+    string.appendChar('y');
+    GRAIN_CHECK(!string.usesLocalBuffer());
+
+    int64_t capacity = string.byteCapacity();
+    GRAIN_CHECK(string.checkCapacity(capacity));
+    GRAIN_CHECK(string.byteCapacity() == capacity);
+}
+
+
+/**
+ *  `reserve()` counts from the current length.
+ */
+static void checkReserve(StringArena* arena) {
+    StringBuilder builder(16, arena);
+    builder.appendChars('a', 100);
+    GRAIN_CHECK(builder.reserve(200));
+    GRAIN_CHECK(builder.byteCapacity() >= 300);
+
+    int64_t capacity = builder.byteCapacity();
+    builder.appendChars('b', capacity - builder.byteLength());
+    GRAIN_CHECK(builder.byteCapacity() == capacity);
+    GRAIN_CHECK(builder.byteLength() == capacity);
+}
+
+
+/**
+ *  A builder living across many short-lived builders keeps the arena in
+ *  use. Buffers given back out of order must be reused instead of taking
+ *  new blocks.
+ */
+static void checkLongLivedBuilder() {
+    StringArena arena(4096);
+    StringBuilder log(16, &arena);
+
+    for (int32_t i = 0; i < 100000; i++) {
+        StringBuilder path(16, &arena);
+        path += "/tmp/render/_tile_";
+        path += i;
+        path += ".png";
+        if (i % 1000 == 0) {
+            log += path.utf8();
+            log += '\n';
+        }
+        GRAIN_CHECK(path.byteLength() == static_cast<int64_t>(std::to_string(i).size()) + 22);
+    }
+
+    GRAIN_CHECK(arena.blockCount() <= 2);
+    GRAIN_CHECK(log.byteLength() > 2000);
+    GRAIN_CHECK(arena.userCount() == 1);
+}
+
+
+/**
+ *  Builders destroyed in any order keep their content.
+ */
+static void checkNonLifo() {
+    StringArena arena(1024);
+
+    for (int32_t round = 0; round < 50; round++) {
+        std::vector<std::unique_ptr<StringBuilder>> builders;
+        std::vector<std::string> expected(8);
+        for (int32_t i = 0; i < 8; i++) {
+            builders.push_back(std::make_unique<StringBuilder>(16, &arena));
+        }
+
+        for (int32_t k = 0; k < 300; k++) {
+            for (int32_t i = 0; i < 8; i++) {
+                int32_t b = (i * 5 + k + round) % 8;
+                builders[b]->appendInt32(i);
+                expected[b] += std::to_string(i);
+            }
+            if (k % 50 == 0) {
+                int32_t b = (k + round) % 8;
+                builders[b] = std::make_unique<StringBuilder>(16, &arena);
+                expected[b].clear();
+            }
+        }
+
+        for (int32_t i = 0; i < 8; i++) {
+            GRAIN_CHECK(expected[i] == builders[i]->utf8());
+        }
+    }
+
+    GRAIN_CHECK(arena.userCount() == 0);
+    GRAIN_CHECK(arena.freeCount() == 0);
+}
+
+
+int main() {
+    checkStringCapacity();
+
+    StringArena arena;
+    checkReserve(nullptr);
+    checkReserve(&arena);
+
+    checkLongLivedBuilder();
+    checkNonLifo();
+
+    return Grain::Test::result();
+}
@@ -0,0 +1,114 @@
+//
+//  TerrainAnalysisBenchmark.cpp
+//
+//  Created by Roald Christesen on 18.10.2025
+//  Copyright (C) 2025 Roald Christesen. All rights reserved.
+//
+//  This file is part of GrainLib, see <https://grain.one>.
+//
+
+#include "GrainTest.hpp"
+
+#include "2d/Data/TerrainAnalysis.hpp"
+#include "2d/Data/ValueGrid.hpp"
+#include "2d/Polygon.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace Grain;
+
+
+/**
+ *  Prints million cells per second of the `TerrainAnalysis` products on a
+ *  terrain like grid of 10000 x 10000 float values, with one thread and
+ *  with all threads, and of `contours()` at one level.
+ */
+
+static constexpr int32_t kSize = 10000;
+
+static double g_sink = 0.0;
+
+
+static void fillTerrain(ValueGridf& grid) {
+    for (int32_t y = 0; y < kSize; y++) {
+        float* row = grid.mutPtrForRow(y);
+        for (int32_t x = 0; x < kSize; x++) {
+            row[x] = static_cast<float>(400.0 + 250.0 * std::sin(x * 0.0011) * std::cos(y * 0.0009) + 30.0 * std::sin(x * 0.017 + y * 0.013));
+        }
+    }
+}
+
+
+template <typename F>
+static void run(const char* name, int32_t thread_count, ValueGridf& out_grid, F fn) {
+    Test::Stopwatch stopwatch;
+    if (fn() != ErrorCode::None) {
+        std::printf("%-24s failed\n", name);
+        return;
+    }
+    double seconds = stopwatch.seconds();
+    g_sink += out_grid.valueAtXY(kSize / 2, kSize / 2);
+
+    std::printf("%-24s %8d %10.2f %10.1f\n", name, thread_count, seconds, static_cast<double>(kSize) * kSize / seconds * 1.0e-6);
+}
+
+
+int main() {
+    ValueGridf grid(kSize, kSize);
+    ValueGridf out_grid(kSize, kSize);
+    if (!grid.hasValues() || !out_grid.hasValues()) {
+        std::printf("Can't allocate grids\n");
+        return 1;
+    }
+    fillTerrain(grid);
+
+    TerrainAnalysis::Params params;
+    params.cell_size_x_ = 2.0;
+    params.cell_size_y_ = 2.0;
+
+    auto max_thread_count = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+
+    std::printf("%-24s %8s %10s %10s\n", "product", "threads", "seconds", "M cells/s");
+
+    for (int32_t thread_count : { 1, max_thread_count }) {
+        params.thread_count_ = thread_count;
+
+        run("slope", thread_count, out_grid, [&]() {
+            return TerrainAnalysis::slope(grid, params, &out_grid);
+        });
+        run("aspect", thread_count, out_grid, [&]() {
+            return TerrainAnalysis::aspect(grid, params, &out_grid);
+        });
+        run("curvature", thread_count, out_grid, [&]() {
+            return TerrainAnalysis::curvature(grid, params, &out_grid);
+        });
+        run("hillshade", thread_count, out_grid, [&]() {
+            return TerrainAnalysis::hillshade(grid, params, &out_grid);
+        });
+
+        params.multidirectional_ = true;
+        run("hillshade, multidir.", thread_count, out_grid, [&]() {
+            return TerrainAnalysis::hillshade(grid, params, &out_grid);
+        });
+        params.multidirectional_ = false;
+
+        if (thread_count == max_thread_count) {
+            break;
+        }
+    }
+
+    int64_t line_count = 0;
+    Test::Stopwatch stopwatch;
+    auto err = TerrainAnalysis::contours(grid, 400.0, [&](Polygon& polygon) {
+        line_count++;
+        g_sink += polygon.pointCount();
+    });
+    double seconds = stopwatch.seconds();
+    if (err == ErrorCode::None) {
+        std::printf("%-24s %8d %10.2f %10.1f, %lld lines\n", "contours", 1, seconds, static_cast<double>(kSize) * kSize / seconds * 1.0e-6, static_cast<long long>(line_count));
+    }
+
+    return g_sink == 12345.0 ? 1 : 0;
+}